@@ -0,0 +1,522 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/threaded_writer.h"
+#include "jls/ec.h"
+#include "jls/reader.h"
+#include "jls/time.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+
+#define ARRAY_SIZE(x) ( sizeof(x) / sizeof((x)[0]) )
+#define TMP_FILENAME "jls_bench_tmp.jls"
+#define SEQ_READ_SAMPLES (65536)
+#define RANDOM_READ_SAMPLES (1000)
+#define RANDOM_READ_OPS (500)
+#define STATISTICS_INCREMENT (1000)
+#define STATISTICS_LENGTH (100)
+#define STATISTICS_OPS (500)
+#define COMPARE_RESULTS_MAX (256)
+
+
+static const char usage_str[] =
+"JLS benchmark suite with machine-readable output.\n"
+"usage: jls_bench <command>\n"
+"\n"
+"Run the benchmark sweep and write the results as JSON.\n"
+"  run [--<opt1> <value> ...]\n"
+"    --output <path>                The JSON output path [jls_bench.json].\n"
+"    --length <samples>             The samples per generated file [10000000].\n"
+"    --quick                        Reduce length for a fast smoke run.\n"
+"\n"
+"Compare two benchmark result files (A = baseline, B = candidate).\n"
+"  compare <a.json> <b.json>\n"
+"\n"
+"The sweep covers datatype (f32, u4, u1) x samples_per_data x summary\n"
+"factors x read pattern (write, sequential, random, statistics).  Each\n"
+"case reports ops/s, MB/s, and latency percentiles.\n"
+"\n"
+"Copyright 2026 Jetperch LLC, Apache 2.0 license\n"
+"\n";
+
+
+#define RPE(x)  do {                        \
+    int32_t rc__ = (x);                     \
+    if (rc__) {                             \
+        printf("error %d: " #x "\n", rc__); \
+        return rc__;                        \
+    }                                       \
+} while (0)
+
+static const struct jls_source_def_s SOURCE_1 = {
+        .source_id = 1,
+        .name = "jls_bench",
+        .vendor = "jls",
+        .model = "",
+        .version = "",
+        .serial_number = "",
+};
+
+struct shape_s {
+    const char * name;
+    uint32_t samples_per_data;
+    uint32_t sample_decimate_factor;
+    uint32_t entries_per_summary;
+    uint32_t summary_decimate_factor;
+};
+
+static const struct shape_s SHAPES[] = {
+        {"spd1k",   1000,   100,  200,   100},
+        {"spd10k",  10000,  100,  2000,  100},
+        {"spd100k", 100000, 1000, 20000, 100},
+};
+
+struct datatype_s {
+    const char * name;
+    uint32_t data_type;
+    uint32_t entry_size_bits;
+};
+
+static const struct datatype_s DATATYPES[] = {
+        {"f32", JLS_DATATYPE_F32, 32},
+        {"u4",  JLS_DATATYPE_U4,  4},
+        {"u1",  JLS_DATATYPE_U1,  1},
+};
+
+// Latency samples for one benchmark case.
+struct latency_s {
+    double * samples;  // seconds per operation
+    size_t length;
+    size_t alloc_length;
+};
+
+static void latency_clear(struct latency_s * self) {
+    free(self->samples);
+    self->samples = NULL;
+    self->length = 0;
+    self->alloc_length = 0;
+}
+
+static void latency_add(struct latency_s * self, double duration) {
+    if (self->length >= self->alloc_length) {
+        size_t sz = self->alloc_length ? (self->alloc_length * 2) : 1024;
+        double * samples = realloc(self->samples, sz * sizeof(double));
+        if (NULL == samples) {
+            return;  // drop the sample, percentiles degrade gracefully
+        }
+        self->samples = samples;
+        self->alloc_length = sz;
+    }
+    self->samples[self->length++] = duration;
+}
+
+static int latency_cmp(const void * a, const void * b) {
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+static double latency_percentile(struct latency_s * self, unsigned int pct) {
+    if (0 == self->length) {
+        return 0.0;
+    }
+    return self->samples[((self->length - 1) * pct) / 100];
+}
+
+struct result_s {
+    const char * datatype;
+    const char * shape;
+    const char * pattern;
+    int64_t ops;
+    int64_t bytes;
+    double seconds;
+    struct latency_s latency;
+};
+
+static void result_emit(FILE * json, struct result_s * r, int * result_count) {
+    double ops_per_second = r->seconds > 0.0 ? r->ops / r->seconds : 0.0;
+    double mb_per_second = r->seconds > 0.0 ? (r->bytes / r->seconds) / 1e6 : 0.0;
+    qsort(r->latency.samples, r->latency.length, sizeof(double), latency_cmp);
+    if (*result_count) {
+        fprintf(json, ",");
+    }
+    // one record per line, so "compare" can scan line by line
+    fprintf(json, "\n    {\"id\": \"%s/%s/%s\", "
+                  "\"ops\": %" PRIi64 ", \"bytes\": %" PRIi64 ", \"seconds\": %.6g, "
+                  "\"ops_per_second\": %.6g, \"mb_per_second\": %.6g, "
+                  "\"latency_us\": {\"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f}}",
+            r->datatype, r->shape, r->pattern,
+            r->ops, r->bytes, r->seconds,
+            ops_per_second, mb_per_second,
+            latency_percentile(&r->latency, 50) * 1e6,
+            latency_percentile(&r->latency, 90) * 1e6,
+            latency_percentile(&r->latency, 99) * 1e6);
+    fflush(json);
+    printf("%s/%s/%s: %.3g ops/s, %.1f MB/s, p50=%.1f us, p99=%.1f us\n",
+           r->datatype, r->shape, r->pattern,
+           ops_per_second, mb_per_second,
+           latency_percentile(&r->latency, 50) * 1e6,
+           latency_percentile(&r->latency, 99) * 1e6);
+    fflush(stdout);
+    ++(*result_count);
+    latency_clear(&r->latency);
+}
+
+// xorshift64: reproducible random offsets across runs and machines
+static uint64_t rand_next(uint64_t * state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+static void gen_triangle(uint32_t period, float * data, int64_t data_length) {
+    int64_t v_max = (period + 1) / 2;
+    float offset = v_max / 2.0f;
+    float gain = 2.0f / v_max;
+    int64_t v = v_max / 2;
+    int64_t incr = 1;
+    for (int64_t i = 0; i < data_length; ++i) {
+        data[i] = gain * (v - offset);
+        if (v <= 0) {
+            incr = 1;
+        } else if (v >= v_max) {
+            incr = -1;
+        }
+        v += incr;
+    }
+}
+
+static void gen_pattern_u8(uint8_t * data, int64_t byte_length) {
+    for (int64_t i = 0; i < byte_length; ++i) {
+        data[i] = (uint8_t) (i ^ (i >> 7));
+    }
+}
+
+static int32_t bench_write(const struct datatype_s * datatype, const struct shape_s * shape,
+                           int64_t length, uint32_t sample_rate, struct result_s * r) {
+    struct jls_twr_s * wr = NULL;
+    struct jls_signal_def_s signal = {
+            .signal_id = 1,
+            .source_id = 1,
+            .signal_type = JLS_SIGNAL_TYPE_FSR,
+            .data_type = datatype->data_type,
+            .sample_rate = sample_rate,
+            .samples_per_data = shape->samples_per_data,
+            .sample_decimate_factor = shape->sample_decimate_factor,
+            .entries_per_summary = shape->entries_per_summary,
+            .summary_decimate_factor = shape->summary_decimate_factor,
+            .annotation_decimate_factor = 100,
+            .utc_decimate_factor = 100,
+            .name = "bench",
+            .units = "",
+    };
+    int64_t block_length = shape->samples_per_data;
+    int64_t block_bytes = (block_length * datatype->entry_size_bits + 7) / 8;
+    uint8_t * data = malloc((size_t) block_bytes);
+    if (NULL == data) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    if (JLS_DATATYPE_F32 == datatype->data_type) {
+        gen_triangle(1000, (float *) data, block_length);
+    } else {
+        gen_pattern_u8(data, block_bytes);
+    }
+
+    RPE(jls_twr_open(&wr, TMP_FILENAME));
+    RPE(jls_twr_source_def(wr, &SOURCE_1));
+    RPE(jls_twr_signal_def(wr, &signal));
+    int64_t t_start = jls_time_rel();
+    for (int64_t sample_id = 0; sample_id < length; sample_id += block_length) {
+        int64_t t0 = jls_time_rel();
+        RPE(jls_twr_fsr(wr, 1, sample_id, data, (uint32_t) block_length));
+        latency_add(&r->latency, JLS_TIME_TO_F64(jls_time_rel() - t0));
+        r->ops += 1;
+        r->bytes += block_bytes;
+    }
+    RPE(jls_twr_close(wr));  // includes queue drain and summaries
+    r->seconds = JLS_TIME_TO_F64(jls_time_rel() - t_start);
+    free(data);
+    return 0;
+}
+
+static int32_t bench_read_seq(struct jls_rd_s * rd, const struct datatype_s * datatype,
+                              int64_t length, struct result_s * r) {
+    int64_t read_length = SEQ_READ_SAMPLES;
+    int64_t read_bytes = (read_length * datatype->entry_size_bits + 7) / 8;
+    uint8_t * data = malloc((size_t) read_bytes);
+    if (NULL == data) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    int64_t t_start = jls_time_rel();
+    for (int64_t sample_id = 0; (sample_id + read_length) <= length; sample_id += read_length) {
+        int64_t t0 = jls_time_rel();
+        RPE(jls_rd_fsr(rd, 1, sample_id, data, (uint32_t) read_length));
+        latency_add(&r->latency, JLS_TIME_TO_F64(jls_time_rel() - t0));
+        r->ops += 1;
+        r->bytes += read_bytes;
+    }
+    r->seconds = JLS_TIME_TO_F64(jls_time_rel() - t_start);
+    free(data);
+    return 0;
+}
+
+static int32_t bench_read_random(struct jls_rd_s * rd, const struct datatype_s * datatype,
+                                 int64_t length, struct result_s * r) {
+    int64_t read_length = RANDOM_READ_SAMPLES;
+    int64_t read_bytes = (read_length * datatype->entry_size_bits + 7) / 8;
+    uint8_t * data = malloc((size_t) read_bytes);
+    if (NULL == data) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    uint64_t rand_state = 0x123456789abcdef1ULL;
+    int64_t span = length - read_length;
+    int64_t t_start = jls_time_rel();
+    for (int i = 0; i < RANDOM_READ_OPS; ++i) {
+        int64_t sample_id = (int64_t) (rand_next(&rand_state) % (uint64_t) span);
+        int64_t t0 = jls_time_rel();
+        RPE(jls_rd_fsr(rd, 1, sample_id, data, (uint32_t) read_length));
+        latency_add(&r->latency, JLS_TIME_TO_F64(jls_time_rel() - t0));
+        r->ops += 1;
+        r->bytes += read_bytes;
+    }
+    r->seconds = JLS_TIME_TO_F64(jls_time_rel() - t_start);
+    free(data);
+    return 0;
+}
+
+static int32_t bench_statistics(struct jls_rd_s * rd, int64_t length, struct result_s * r) {
+    static double data[STATISTICS_LENGTH * JLS_SUMMARY_FSR_COUNT];
+    uint64_t rand_state = 0xfedcba9876543211ULL;
+    int64_t window = STATISTICS_INCREMENT * (int64_t) STATISTICS_LENGTH;
+    int64_t span = length - window;
+    if (span <= 0) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    int64_t t_start = jls_time_rel();
+    for (int i = 0; i < STATISTICS_OPS; ++i) {
+        int64_t sample_id = (int64_t) (rand_next(&rand_state) % (uint64_t) span);
+        int64_t t0 = jls_time_rel();
+        RPE(jls_rd_fsr_statistics(rd, 1, sample_id, STATISTICS_INCREMENT, data, STATISTICS_LENGTH));
+        latency_add(&r->latency, JLS_TIME_TO_F64(jls_time_rel() - t0));
+        r->ops += 1;
+        r->bytes += sizeof(data);
+    }
+    r->seconds = JLS_TIME_TO_F64(jls_time_rel() - t_start);
+    return 0;
+}
+
+static int32_t bench_case(const struct datatype_s * datatype, const struct shape_s * shape,
+                          int64_t length, FILE * json, int * result_count) {
+    struct result_s r;
+    memset(&r, 0, sizeof(r));
+    r.datatype = datatype->name;
+    r.shape = shape->name;
+
+    r.pattern = "write";
+    RPE(bench_write(datatype, shape, length, 1000000, &r));
+    result_emit(json, &r, result_count);
+
+    struct jls_rd_s * rd = NULL;
+    RPE(jls_rd_open(&rd, TMP_FILENAME));
+
+    memset(&r, 0, sizeof(r));
+    r.datatype = datatype->name;
+    r.shape = shape->name;
+    r.pattern = "read_seq";
+    RPE(bench_read_seq(rd, datatype, length, &r));
+    result_emit(json, &r, result_count);
+
+    memset(&r, 0, sizeof(r));
+    r.datatype = datatype->name;
+    r.shape = shape->name;
+    r.pattern = "read_random";
+    RPE(bench_read_random(rd, datatype, length, &r));
+    result_emit(json, &r, result_count);
+
+    memset(&r, 0, sizeof(r));
+    r.datatype = datatype->name;
+    r.shape = shape->name;
+    r.pattern = "statistics";
+    RPE(bench_statistics(rd, length, &r));
+    result_emit(json, &r, result_count);
+
+    jls_rd_close(rd);
+    remove(TMP_FILENAME);
+    return 0;
+}
+
+static int32_t run(const char * output, int64_t length) {
+    FILE * json = fopen(output, "wt");
+    if (NULL == json) {
+        printf("Could not open JSON output file: %s\n", output);
+        return 1;
+    }
+    int result_count = 0;
+    fprintf(json, "{\n  \"version\": 1,\n  \"length\": %" PRIi64 ",\n  \"results\": [", length);
+    int32_t rc = 0;
+    for (size_t dt = 0; (0 == rc) && (dt < ARRAY_SIZE(DATATYPES)); ++dt) {
+        for (size_t sh = 0; (0 == rc) && (sh < ARRAY_SIZE(SHAPES)); ++sh) {
+            rc = bench_case(&DATATYPES[dt], &SHAPES[sh], length, json, &result_count);
+        }
+    }
+    fprintf(json, "\n  ]\n}\n");
+    fclose(json);
+    if (rc) {
+        printf("Benchmark failed: %d\n", (int) rc);
+        return rc;
+    }
+    printf("Wrote %d results to %s\n", result_count, output);
+    return 0;
+}
+
+struct compare_entry_s {
+    char id[128];
+    double ops_per_second;
+    double mb_per_second;
+    double p50_us;
+    double p99_us;
+};
+
+static double field_f64(const char * line, const char * name) {
+    const char * p = strstr(line, name);
+    if (NULL == p) {
+        return 0.0;
+    }
+    p += strlen(name);
+    return strtod(p, NULL);
+}
+
+static int compare_load(const char * path, struct compare_entry_s * entries) {
+    FILE * f = fopen(path, "rt");
+    if (NULL == f) {
+        printf("Could not open results file: %s\n", path);
+        return -1;
+    }
+    char line[4096];
+    int count = 0;
+    while ((count < COMPARE_RESULTS_MAX) && fgets(line, sizeof(line), f)) {
+        const char * p = strstr(line, "\"id\": \"");
+        if (NULL == p) {
+            continue;
+        }
+        p += 7;
+        const char * p_end = strchr(p, '"');
+        if ((NULL == p_end) || ((size_t) (p_end - p) >= sizeof(entries[count].id))) {
+            continue;
+        }
+        memcpy(entries[count].id, p, p_end - p);
+        entries[count].id[p_end - p] = 0;
+        entries[count].ops_per_second = field_f64(line, "\"ops_per_second\": ");
+        entries[count].mb_per_second = field_f64(line, "\"mb_per_second\": ");
+        entries[count].p50_us = field_f64(line, "\"p50\": ");
+        entries[count].p99_us = field_f64(line, "\"p99\": ");
+        ++count;
+    }
+    fclose(f);
+    return count;
+}
+
+static int32_t compare(const char * path_a, const char * path_b) {
+    static struct compare_entry_s a[COMPARE_RESULTS_MAX];
+    static struct compare_entry_s b[COMPARE_RESULTS_MAX];
+    int count_a = compare_load(path_a, a);
+    int count_b = compare_load(path_b, b);
+    if ((count_a <= 0) || (count_b <= 0)) {
+        return 1;
+    }
+    printf("%-28s %12s %12s %8s %10s %10s\n",
+           "id", "A ops/s", "B ops/s", "B/A", "A p99 us", "B p99 us");
+    for (int i = 0; i < count_a; ++i) {
+        struct compare_entry_s * eb = NULL;
+        for (int k = 0; k < count_b; ++k) {
+            if (0 == strcmp(a[i].id, b[k].id)) {
+                eb = &b[k];
+                break;
+            }
+        }
+        if (NULL == eb) {
+            printf("%-28s %12.4g %12s\n", a[i].id, a[i].ops_per_second, "missing");
+            continue;
+        }
+        double ratio = (a[i].ops_per_second > 0.0) ? (eb->ops_per_second / a[i].ops_per_second) : 0.0;
+        printf("%-28s %12.4g %12.4g %7.2fx %10.1f %10.1f\n",
+               a[i].id, a[i].ops_per_second, eb->ops_per_second, ratio,
+               a[i].p99_us, eb->p99_us);
+    }
+    return 0;
+}
+
+static int usage(void) {
+    printf("%s", usage_str);
+    return 1;
+}
+
+static int cstr_to_i64(const char * src, int64_t * value) {
+    char * end = NULL;
+    if ((NULL == src) || (NULL == value)) {
+        return 1;
+    }
+    int64_t v = strtoll(src, &end, 10);
+    if ((NULL == end) || (*end) || (end == src) || (v < 0)) {
+        return 1;
+    }
+    *value = v;
+    return 0;
+}
+
+int main(int argc, char * argv[]) {
+    if (argc < 2) {
+        return usage();
+    }
+    if (0 == strcmp(argv[1], "run")) {
+        const char * output = "jls_bench.json";
+        int64_t length = 10000000;
+        for (int i = 2; i < argc; ++i) {
+            if ((0 == strcmp("--output", argv[i])) && ((i + 1) < argc)) {
+                output = argv[++i];
+            } else if ((0 == strcmp("--length", argv[i])) && ((i + 1) < argc)) {
+                RPE(cstr_to_i64(argv[++i], &length));
+            } else if (0 == strcmp("--quick", argv[i])) {
+                length = 1000000;
+            } else {
+                printf("Unsupported argument: %s\n", argv[i]);
+                return usage();
+            }
+        }
+        if (length < (STATISTICS_INCREMENT * (int64_t) STATISTICS_LENGTH * 2)) {
+            printf("--length too small\n");
+            return usage();
+        }
+        return run(output, length);
+    } else if (0 == strcmp(argv[1], "compare")) {
+        if (argc != 4) {
+            return usage();
+        }
+        return compare(argv[2], argv[3]);
+    } else if ((0 == strcmp(argv[1], "help")) || (0 == strcmp(argv[1], "--help"))) {
+        usage();
+        return 0;
+    }
+    printf("Unsupported command: %s\n", argv[1]);
+    return usage();
+}
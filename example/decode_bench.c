@@ -0,0 +1,266 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/ec.h"
+#include "jls/format.h"
+#include "jls/raw.h"
+#include "jls/reader.h"
+#include "jls/time.h"
+#include "jls/writer.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+
+#define ARRAY_SIZE(x) ( sizeof(x) / sizeof((x)[0]) )
+#define TMP_FILENAME "jls_decode_bench_tmp.jls"
+#define PAYLOAD_MAX (4 * 1024 * 1024)
+#define READ_BLOCK_SAMPLES (65536)
+
+
+static const char usage_str[] =
+"JLS decode-path CPU microbenchmark.\n"
+"usage: jls_decode_bench [--<opt> <value> ...]\n"
+"    --length <samples>   The samples per generated file [10000000].\n"
+"    --repeat <count>     The timed passes per case [5].\n"
+"    --keep               Keep the generated files for inspection.\n"
+"\n"
+"Generates files with valid but adversarial geometry: minimum chunk\n"
+"sizes, maximum summary depth, and sub-byte datatypes read at odd\n"
+"sample offsets to force bit shifting.  Each file is walked once\n"
+"untimed to warm the OS page cache, then decoded repeatedly from\n"
+"cache so the reported rates isolate parser CPU from disk time:\n"
+"  raw      chunk walk via jls_raw_rd(): header validation, CRC,\n"
+"           and decompression only.\n"
+"  samples  sequential jls_rd_fsr() reads at an odd sample offset:\n"
+"           adds chunk routing, delta decode, and bit shifting.\n"
+"\n"
+"Copyright 2026 Jetperch LLC, Apache 2.0 license\n"
+"\n";
+
+
+#define RPE(x)  do {                        \
+    int32_t rc__ = (x);                     \
+    if (rc__) {                             \
+        printf("error %d: " #x "\n", rc__); \
+        return rc__;                        \
+    }                                       \
+} while (0)
+
+static const struct jls_source_def_s SOURCE_1 = {
+        .source_id = 1,
+        .name = "jls_decode_bench",
+        .vendor = "jls",
+        .model = "",
+        .version = "",
+        .serial_number = "",
+};
+
+// All geometries request the aligned minimums, see
+// jls_core_signal_def_align(): the smallest data chunks maximize the
+// per-chunk header and CRC overhead, and summary_decimate_factor 10
+// maximizes the summary level depth for a given length.
+struct scenario_s {
+    const char * name;
+    uint32_t data_type;
+    uint32_t entry_size_bits;
+    uint32_t samples_per_data;
+    uint32_t sample_decimate_factor;
+    uint32_t entries_per_summary;
+    uint32_t summary_decimate_factor;
+};
+
+static const struct scenario_s SCENARIOS[] = {
+        // f32: 16-sample chunks = 64-byte payloads, summaries every 160 samples
+        {"f32_min_chunk", JLS_DATATYPE_F32, 32, 16, 16, 10, 10},
+        // u4: 64-sample chunks = 32-byte payloads, odd-offset reads shift nibbles
+        {"u4_shift", JLS_DATATYPE_U4, 4, 64, 64, 10, 10},
+        // u1: 256-sample chunks = 32-byte payloads, odd-offset reads shift bits
+        {"u1_shift", JLS_DATATYPE_U1, 1, 256, 256, 10, 10},
+};
+
+static int32_t scenario_generate(const struct scenario_s * s, int64_t length) {
+    struct jls_wr_s * wr = NULL;
+    struct jls_signal_def_s signal = {
+            .signal_id = 1,
+            .source_id = 1,
+            .signal_type = JLS_SIGNAL_TYPE_FSR,
+            .data_type = s->data_type,
+            .sample_rate = 1000000,
+            .samples_per_data = s->samples_per_data,
+            .sample_decimate_factor = s->sample_decimate_factor,
+            .entries_per_summary = s->entries_per_summary,
+            .summary_decimate_factor = s->summary_decimate_factor,
+            .annotation_decimate_factor = 100,
+            .utc_decimate_factor = 100,
+            .name = "bench",
+            .units = "",
+    };
+    int64_t block_length = s->samples_per_data;
+    int64_t block_bytes = (block_length * s->entry_size_bits + 7) / 8;
+    uint8_t * data = malloc((size_t) block_bytes);
+    if (NULL == data) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+
+    remove(TMP_FILENAME);
+    RPE(jls_wr_open(&wr, TMP_FILENAME));
+    RPE(jls_wr_source_def(wr, &SOURCE_1));
+    RPE(jls_wr_signal_def(wr, &signal));
+    for (int64_t sample_id = 0; sample_id < length; sample_id += block_length) {
+        if (JLS_DATATYPE_F32 == s->data_type) {
+            float * f32 = (float *) data;
+            for (int64_t i = 0; i < block_length; ++i) {
+                f32[i] = (float) (((sample_id + i) % 1000) * 0.001);
+            }
+        } else {
+            // incompressible bit patterns so delta/const encodes do not
+            // collapse the payloads the parser must chew through
+            for (int64_t i = 0; i < block_bytes; ++i) {
+                int64_t v = sample_id / block_length + i;
+                data[i] = (uint8_t) (v ^ (v >> 7) ^ 0x5a);
+            }
+        }
+        RPE(jls_wr_fsr(wr, 1, sample_id, data, (uint32_t) block_length));
+    }
+    RPE(jls_wr_close(wr));
+    free(data);
+    return 0;
+}
+
+/**
+ * @brief Walk every chunk through jls_raw_rd().
+ *
+ * @param chunks[out] The chunks decoded.
+ * @param bytes[out] The decoded payload bytes.
+ * @return 0 or error code.
+ */
+static int32_t raw_pass(uint8_t * payload, int64_t * chunks, int64_t * bytes) {
+    struct jls_raw_s * raw = NULL;
+    struct jls_chunk_header_s hdr;
+    RPE(jls_raw_open(&raw, TMP_FILENAME, "r"));
+    while (1) {
+        int32_t rc = jls_raw_rd(raw, &hdr, PAYLOAD_MAX, payload);
+        if (JLS_ERROR_EMPTY == rc) {
+            break;
+        }
+        if (rc) {
+            jls_raw_close(raw);
+            return rc;
+        }
+        ++(*chunks);
+        *bytes += jls_raw_payload_decoded_length(raw);
+        if (JLS_TAG_END == hdr.tag) {
+            break;
+        }
+    }
+    jls_raw_close(raw);
+    return 0;
+}
+
+static int32_t samples_pass(const struct scenario_s * s, int64_t length,
+                            uint8_t * buffer, int64_t * samples, int64_t * bytes) {
+    struct jls_rd_s * rd = NULL;
+    RPE(jls_rd_open(&rd, TMP_FILENAME));
+    // start at sample 1: sub-byte datatypes shift every chunk payload
+    for (int64_t sample_id = 1; (sample_id + READ_BLOCK_SAMPLES) <= length;
+            sample_id += READ_BLOCK_SAMPLES) {
+        int32_t rc = jls_rd_fsr(rd, 1, sample_id, buffer, READ_BLOCK_SAMPLES);
+        if (rc) {
+            jls_rd_close(rd);
+            return rc;
+        }
+        *samples += READ_BLOCK_SAMPLES;
+        *bytes += ((int64_t) READ_BLOCK_SAMPLES * s->entry_size_bits) / 8;
+    }
+    jls_rd_close(rd);
+    return 0;
+}
+
+static int32_t scenario_run(const struct scenario_s * s, int64_t length, int repeat, int keep) {
+    uint8_t * payload = malloc(PAYLOAD_MAX);
+    uint8_t * buffer = malloc((READ_BLOCK_SAMPLES * 32) / 8);
+    if ((NULL == payload) || (NULL == buffer)) {
+        free(payload);
+        free(buffer);
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    printf("== %s ==\n", s->name);
+    RPE(scenario_generate(s, length));
+
+    int64_t chunks = 0;
+    int64_t bytes = 0;
+    RPE(raw_pass(payload, &chunks, &bytes));  // warm the page cache, untimed
+    printf("  file: %" PRIi64 " chunks, %.1f MB decoded payload\n",
+           chunks, bytes / 1e6);
+
+    chunks = 0;
+    bytes = 0;
+    int64_t t0 = jls_time_rel();
+    for (int i = 0; i < repeat; ++i) {
+        RPE(raw_pass(payload, &chunks, &bytes));
+    }
+    double duration = JLS_TIME_TO_F64(jls_time_rel() - t0);
+    printf("  raw: %.3g chunks/s, %.1f MB/s\n",
+           chunks / duration, (bytes / duration) / 1e6);
+
+    int64_t samples = 0;
+    bytes = 0;
+    t0 = jls_time_rel();
+    for (int i = 0; i < repeat; ++i) {
+        RPE(samples_pass(s, length, buffer, &samples, &bytes));
+    }
+    duration = JLS_TIME_TO_F64(jls_time_rel() - t0);
+    printf("  samples: %.3f Msps, %.1f MB/s\n",
+           (samples / duration) / 1e6, (bytes / duration) / 1e6);
+
+    if (!keep) {
+        remove(TMP_FILENAME);
+    }
+    free(payload);
+    free(buffer);
+    return 0;
+}
+
+int main(int argc, char * argv[]) {
+    int64_t length = 10000000;
+    int repeat = 5;
+    int keep = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if ((0 == strcmp("--length", argv[i])) && ((i + 1) < argc)) {
+            length = strtoll(argv[++i], NULL, 0);
+        } else if ((0 == strcmp("--repeat", argv[i])) && ((i + 1) < argc)) {
+            repeat = (int) strtol(argv[++i], NULL, 0);
+        } else if (0 == strcmp("--keep", argv[i])) {
+            keep = 1;
+        } else {
+            printf("%s", usage_str);
+            return 1;
+        }
+    }
+    if ((length <= 0) || (repeat <= 0)) {
+        printf("%s", usage_str);
+        return 1;
+    }
+
+    for (size_t i = 0; i < ARRAY_SIZE(SCENARIOS); ++i) {
+        RPE(scenario_run(&SCENARIOS[i], length, repeat, keep));
+    }
+    return 0;
+}
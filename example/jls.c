@@ -67,10 +67,16 @@ static void on_log_recv(const char * msg) {
 const struct command_s COMMANDS[] = {
 //        {"dev",  on_dev,  "Developer tools"},
         {"copy", on_copy, "Copy and rebuild a JLS file"},
+        {"erase", on_erase, "Erase an FSR sample range in place"},
+        {"export", on_export, "Export FSR signal data to CSV or binary"},
         {"fsr_statistics", on_fsr_statistics, "Extract FSR statistics for a signal"},
         {"info", on_info, "Display JLS file information"},
         {"inspect", on_inspect, "Inspect JLS files"},
+        {"open-profile", on_open_profile, "Report time and I/O per jls_rd_open() phase"},
         {"read_fuzzer", on_read_fuzzer, "Perform JLS read fuzz testing"},
+        {"repair", on_repair, "Repair a JLS file in place"},
+        {"resummarize", on_resummarize, "Rebuild FSR summaries from level 0 data in place"},
+        {"verify", on_verify, "Verify JLS file integrity"},
         {"version", on_version, "Display version and platform information"},
         {"help", on_help, "Display help"},
         {NULL, NULL, NULL}
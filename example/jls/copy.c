@@ -27,7 +27,7 @@
 
 
 static int usage(void) {
-    printf("usage: jls copy <src> <dst> [--no-progress]\n");
+    printf("usage: jls copy <src> <dst> [--no-progress] [--downsample]\n");
     return 1;
 }
 
@@ -56,6 +56,7 @@ int on_copy(struct app_s * self, int argc, char * argv[]) {
     int pos_arg = 0;
     (void) self;
     bool no_progress = false;
+    bool downsample = false;
 
     while (argc) {
         if (argv[0][0] != '-') {
@@ -71,6 +72,9 @@ int on_copy(struct app_s * self, int argc, char * argv[]) {
         } else if (0 == strcmp("--no-progress", argv[0])) {
             no_progress = true;
             ARG_CONSUME();
+        } else if (0 == strcmp("--downsample", argv[0])) {
+            downsample = true;
+            ARG_CONSUME();
         } else {
             return usage();
         }
@@ -79,9 +83,16 @@ int on_copy(struct app_s * self, int argc, char * argv[]) {
         return usage();
     }
 
-    int32_t rc = jls_copy(src, dst,
-                          msg_fn, NULL,
-                          no_progress ? NULL : progress_fn, NULL);
+    int32_t rc;
+    if (downsample) {
+        rc = jls_copy_downsample(src, dst,
+                                 msg_fn, NULL,
+                                 no_progress ? NULL : progress_fn, NULL);
+    } else {
+        rc = jls_copy(src, dst,
+                      msg_fn, NULL,
+                      no_progress ? NULL : progress_fn, NULL);
+    }
     printf("\n");
     if (rc) {
         printf("ERROR: %d %s : %s\n", rc, jls_error_code_name(rc), jls_error_code_description(rc));
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2023 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls.h"
+#include "jls/copy.h"
+#include "jls_util_prv.h"
+#include "cstr.h"
+#include <stdio.h>
+#include <string.h>
+
+
+static int usage(void) {
+    printf("usage: jls erase <path> <signal_id> <start_sample_id> <end_sample_id>\n");
+    return 1;
+}
+
+static int32_t msg_fn(void * user_data, const char * msg) {
+    (void) user_data;
+    printf("%s\n", msg);
+    return 0;
+}
+
+int on_erase(struct app_s * self, int argc, char * argv[]) {
+    char * path = NULL;
+    uint16_t signal_id = 0;
+    int64_t sample_id[2] = {0, 0};
+    int pos_arg = 0;
+    (void) self;
+
+    while (argc) {
+        if (argv[0][0] != '-') {
+            switch (pos_arg) {
+                case 0:
+                    path = argv[0];
+                    break;
+                case 1:
+                    if (jls_cstr_to_u16(argv[0], &signal_id)) {
+                        return usage();
+                    }
+                    break;
+                case 2:  // intentional fall-through
+                case 3:
+                    if (jls_cstr_to_i64(argv[0], &sample_id[pos_arg - 2])) {
+                        return usage();
+                    }
+                    break;
+                default:
+                    return usage();
+            }
+            ARG_CONSUME();
+            ++pos_arg;
+        } else {
+            return usage();
+        }
+    }
+    if (pos_arg != 4) {
+        return usage();
+    }
+
+    int32_t rc = jls_fsr_erase(path, signal_id, sample_id[0], sample_id[1], msg_fn, NULL);
+    if (rc) {
+        printf("ERROR: %d %s : %s\n", rc, jls_error_code_name(rc), jls_error_code_description(rc));
+    }
+    return rc;
+}
@@ -0,0 +1,402 @@
+/*
+ * Copyright 2023 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls.h"
+#include "jls/backend.h"
+#include "jls_util_prv.h"
+#include "cstr.h"
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+
+#define FORMAT_CSV  (0)
+#define FORMAT_BIN  (1)
+
+
+static int usage(void) {
+    printf("usage: jls export <jls_path> <signal_id> <out_path>\n"
+           "  jls_path        The path to the JLS input file.\n"
+           "  signal_id       The signal_id to export, or 'all' for every FSR signal.\n"
+           "  out_path        The output path.  When exporting multiple signals,\n"
+           "                  the signal_id is inserted before the extension.\n"
+           "\n"
+           "Options:\n"
+           "  --start <sample_id>     The starting sample id.  Default 0.\n"
+           "  --length <samples>      The number of samples.  Default: all remaining.\n"
+           "  --format <csv|bin>      The output format.  Default: csv when out_path\n"
+           "                          ends in '.csv', bin otherwise.  bin writes the\n"
+           "                          raw samples in the signal data type.\n"
+           "  --threads <count>       The number of export threads, up to %d.\n"
+           "                          Signals split across threads, each with its own\n"
+           "                          reader, see jls_rd_fork().  Default 1.\n"
+           "  --batch_size <samples>  The samples per read batch.  Default 0 (auto).\n"
+           "\n", JLS_RD_FSR_BATCH_WORKERS_MAX);
+    return 1;
+}
+
+struct export_ctx_s {
+    FILE * f;
+    uint8_t format;
+    uint32_t data_type;
+    int64_t start;          // requested start, for sub-byte lead-in trim (csv)
+    int64_t end;            // requested end, exclusive
+};
+
+/**
+ * @brief Extract one sample as a double, applying the fixed-point q.
+ *
+ * Handles the sub-byte (u1, u4, i4) and 24-bit packings that cannot
+ * be read with a simple pointer cast.
+ */
+static double sample_as_f64(const uint8_t * data, int64_t k, uint32_t data_type) {
+    uint8_t basetype = jls_datatype_parse_basetype(data_type);
+    uint8_t size = jls_datatype_parse_size(data_type);
+    uint8_t q = jls_datatype_parse_q(data_type);
+    double v = 0.0;
+    if (JLS_DATATYPE_BASETYPE_FLOAT == basetype) {
+        if (32 == size) {
+            v = ((const float *) data)[k];
+        } else {
+            v = ((const double *) data)[k];
+        }
+        return v;
+    }
+    int64_t i64 = 0;
+    uint64_t u64 = 0;
+    switch (size) {
+        case 1: u64 = (data[k >> 3] >> (k & 7)) & 1; break;
+        case 4: u64 = (data[k >> 1] >> ((k & 1) * 4)) & 0x0f; break;
+        case 8: u64 = data[k]; break;
+        case 16: u64 = ((const uint16_t *) data)[k]; break;
+        case 24:
+            u64 = ((uint64_t) data[k * 3])
+                  | (((uint64_t) data[k * 3 + 1]) << 8)
+                  | (((uint64_t) data[k * 3 + 2]) << 16);
+            break;
+        case 32: u64 = ((const uint32_t *) data)[k]; break;
+        case 64: u64 = ((const uint64_t *) data)[k]; break;
+        default: break;
+    }
+    if ((basetype & JLS_DATATYPE_BASETYPE_UNSIGNED) == 0) {
+        if ((size < 64) && (u64 & (((uint64_t) 1) << (size - 1)))) {
+            u64 |= ~((((uint64_t) 1) << size) - 1);  // sign extend
+        }
+        i64 = (int64_t) u64;
+        v = (double) i64;
+    } else {
+        v = (double) u64;
+    }
+    if (q) {
+        v /= (double) (((uint64_t) 1) << q);
+    }
+    return v;
+}
+
+static int32_t export_batch_fn(void * user_data, const void * data,
+                               int64_t sample_id, int64_t sample_count) {
+    struct export_ctx_s * ctx = (struct export_ctx_s *) user_data;
+    const uint8_t * d = (const uint8_t *) data;
+    if (quit_) {
+        return JLS_ERROR_ABORTED;
+    }
+    if (FORMAT_BIN == ctx->format) {
+        // raw samples, including any sub-byte boundary lead-in
+        size_t sz = (size_t) ((sample_count * jls_datatype_parse_size(ctx->data_type)) / 8);
+        if (fwrite(d, 1, sz, ctx->f) != sz) {
+            return JLS_ERROR_IO;
+        }
+        return 0;
+    }
+    int64_t k = 0;
+    if (sample_id < ctx->start) {  // sub-byte boundary lead-in
+        k = ctx->start - sample_id;
+    }
+    int64_t k_end = sample_count;
+    if ((sample_id + sample_count) > ctx->end) {
+        k_end = ctx->end - sample_id;
+    }
+    uint8_t basetype = jls_datatype_parse_basetype(ctx->data_type);
+    uint8_t size = jls_datatype_parse_size(ctx->data_type);
+    uint8_t q = jls_datatype_parse_q(ctx->data_type);
+    if ((JLS_DATATYPE_BASETYPE_FLOAT != basetype) && (0 == q) && (size >= 8)) {
+        // print integers exactly: double would round above 2**53
+        for (; k < k_end; ++k) {
+            if (basetype & JLS_DATATYPE_BASETYPE_UNSIGNED) {
+                fprintf(ctx->f, "%" PRIu64 "\n", (uint64_t) sample_as_f64(d, k, ctx->data_type));
+            } else {
+                fprintf(ctx->f, "%" PRIi64 "\n", (int64_t) sample_as_f64(d, k, ctx->data_type));
+            }
+        }
+    } else {
+        for (; k < k_end; ++k) {
+            fprintf(ctx->f, "%g\n", sample_as_f64(d, k, ctx->data_type));
+        }
+    }
+    return 0;
+}
+
+static void signal_out_path(char * dst, size_t dst_size, const char * out_path,
+                            uint16_t signal_id, int multi) {
+    if (!multi) {
+        snprintf(dst, dst_size, "%s", out_path);
+        return;
+    }
+    const char * ext = strrchr(out_path, '.');
+    if (ext && (ext != out_path)) {
+        snprintf(dst, dst_size, "%.*s_%u%s", (int) (ext - out_path), out_path,
+                 (unsigned int) signal_id, ext);
+    } else {
+        snprintf(dst, dst_size, "%s_%u", out_path, (unsigned int) signal_id);
+    }
+}
+
+struct export_worker_s {
+    struct jls_rd_s * rd;                   // this worker's reader
+    struct jls_signal_def_s ** signals;     // the selected signals
+    uint16_t signal_count;
+    uint16_t idx;                           // this worker's first signal
+    uint16_t stride;                        // the number of workers
+    int64_t start;
+    int64_t length;                         // or -1 for all remaining
+    int64_t batch_size;
+    uint8_t format;
+    const char * out_path;
+    int multi;
+    int32_t return_code;
+};
+
+static void export_worker(void * user_data) {
+    struct export_worker_s * w = (struct export_worker_s *) user_data;
+    char path[1024];
+    for (uint16_t i = w->idx; i < w->signal_count; i += w->stride) {
+        struct jls_signal_def_s * signal_def = w->signals[i];
+        int64_t samples = 0;
+        int32_t rc = jls_rd_fsr_length(w->rd, signal_def->signal_id, &samples);
+        if (rc) {
+            w->return_code = rc;
+            return;
+        }
+        int64_t length = w->length;
+        if ((length < 0) || ((w->start + length) > samples)) {
+            length = samples - w->start;
+        }
+        if (length <= 0) {
+            continue;
+        }
+        signal_out_path(path, sizeof(path), w->out_path, signal_def->signal_id, w->multi);
+        struct export_ctx_s ctx = {
+                .f = fopen(path, "wb"),
+                .format = w->format,
+                .data_type = signal_def->data_type,
+                .start = w->start,
+                .end = w->start + length,
+        };
+        if (NULL == ctx.f) {
+            printf("could not open %s\n", path);
+            w->return_code = JLS_ERROR_IO;
+            return;
+        }
+        rc = jls_rd_fsr_export(w->rd, signal_def->signal_id, w->start, length,
+                               w->batch_size, 0, export_batch_fn, &ctx);
+        fclose(ctx.f);
+        if (rc) {
+            w->return_code = rc;
+            return;
+        }
+        printf("signal %d %s: %" PRIi64 " samples -> %s\n",
+               (int) signal_def->signal_id, signal_def->name, length, path);
+    }
+}
+
+int on_export(struct app_s * self, int argc, char * argv[]) {
+    struct jls_rd_s * rd = NULL;
+    char * jls_path = NULL;
+    char * signal_str = NULL;
+    char * out_path = NULL;
+    int64_t start = 0;
+    int64_t length = -1;
+    int64_t batch_size = 0;
+    uint16_t threads = 1;
+    int format = -1;
+    int pos_arg = 0;
+    (void) self;
+
+    while (argc) {
+        if (argv[0][0] != '-') {
+            switch (pos_arg) {
+                case 0: jls_path = argv[0]; break;
+                case 1: signal_str = argv[0]; break;
+                case 2: out_path = argv[0]; break;
+                default:
+                    printf("Too many positional arguments\n");
+                    return usage();
+            }
+            ARG_CONSUME();
+            ++pos_arg;
+        } else if (0 == strcmp(argv[0], "--start")) {
+            ARG_CONSUME();
+            ARG_REQUIRE();
+            if (jls_cstr_to_i64(argv[0], &start)) {
+                return usage();
+            }
+            ARG_CONSUME();
+        } else if (0 == strcmp(argv[0], "--length")) {
+            ARG_CONSUME();
+            ARG_REQUIRE();
+            if (jls_cstr_to_i64(argv[0], &length)) {
+                return usage();
+            }
+            ARG_CONSUME();
+        } else if (0 == strcmp(argv[0], "--batch_size")) {
+            ARG_CONSUME();
+            ARG_REQUIRE();
+            if (jls_cstr_to_i64(argv[0], &batch_size)) {
+                return usage();
+            }
+            ARG_CONSUME();
+        } else if (0 == strcmp(argv[0], "--threads")) {
+            ARG_CONSUME();
+            ARG_REQUIRE();
+            if (jls_cstr_to_u16(argv[0], &threads)) {
+                return usage();
+            }
+            ARG_CONSUME();
+        } else if (0 == strcmp(argv[0], "--format")) {
+            ARG_CONSUME();
+            ARG_REQUIRE();
+            if (0 == strcmp(argv[0], "csv")) {
+                format = FORMAT_CSV;
+            } else if (0 == strcmp(argv[0], "bin")) {
+                format = FORMAT_BIN;
+            } else {
+                printf("Invalid format: %s\n", argv[0]);
+                return usage();
+            }
+            ARG_CONSUME();
+        } else {
+            return usage();
+        }
+    }
+    if (pos_arg != 3) {
+        return usage();
+    }
+    if (format < 0) {
+        const char * ext = strrchr(out_path, '.');
+        format = (ext && (0 == strcmp(ext, ".csv"))) ? FORMAT_CSV : FORMAT_BIN;
+    }
+    if (threads < 1) {
+        threads = 1;
+    } else if (threads > JLS_RD_FSR_BATCH_WORKERS_MAX) {
+        threads = JLS_RD_FSR_BATCH_WORKERS_MAX;
+    }
+
+    ROE(jls_rd_open(&rd, jls_path));
+    struct jls_signal_def_s * signals = NULL;
+    struct jls_signal_def_s * selected[JLS_SIGNAL_COUNT];
+    uint16_t signal_count = 0;
+    uint16_t selected_count = 0;
+    int32_t rc = jls_rd_signals(rd, &signals, &signal_count);
+    if (rc) {
+        jls_rd_close(rd);
+        return rc;
+    }
+    if (0 == strcmp(signal_str, "all")) {
+        for (uint16_t i = 0; i < signal_count; ++i) {
+            if (JLS_SIGNAL_TYPE_FSR == signals[i].signal_type) {
+                selected[selected_count++] = &signals[i];
+            }
+        }
+    } else {
+        uint16_t signal_id = 0;
+        if (jls_cstr_to_u16(signal_str, &signal_id)) {
+            printf("Invalid signal_id\n");
+            jls_rd_close(rd);
+            return usage();
+        }
+        for (uint16_t i = 0; i < signal_count; ++i) {
+            if ((signals[i].signal_id == signal_id)
+                    && (JLS_SIGNAL_TYPE_FSR == signals[i].signal_type)) {
+                selected[selected_count++] = &signals[i];
+                break;
+            }
+        }
+        if (0 == selected_count) {
+            printf("FSR signal %d not found\n", (int) signal_id);
+            jls_rd_close(rd);
+            return JLS_ERROR_NOT_FOUND;
+        }
+    }
+    if (0 == selected_count) {
+        printf("No FSR signals to export\n");
+        jls_rd_close(rd);
+        return 0;
+    }
+    if (threads > selected_count) {
+        threads = selected_count;
+    }
+
+    struct export_worker_s w[JLS_RD_FSR_BATCH_WORKERS_MAX];
+    struct jls_bk_thread_s * thread[JLS_RD_FSR_BATCH_WORKERS_MAX];
+    for (uint16_t k = 0; k < threads; ++k) {
+        w[k].rd = rd;  // worker 0 uses the main reader
+        w[k].signals = selected;
+        w[k].signal_count = selected_count;
+        w[k].idx = k;
+        w[k].stride = threads;
+        w[k].start = start;
+        w[k].length = length;
+        w[k].batch_size = batch_size;
+        w[k].format = (uint8_t) format;
+        w[k].out_path = out_path;
+        w[k].multi = (selected_count > 1);
+        w[k].return_code = 0;
+        thread[k] = NULL;
+    }
+    for (uint16_t k = 1; k < threads; ++k) {
+        if (jls_rd_fork(rd, &w[k].rd)) {
+            w[k].rd = NULL;  // run this worker's slice on the calling thread below
+        } else if (jls_bk_thread_run(&thread[k], export_worker, &w[k])) {
+            thread[k] = NULL;
+            export_worker(&w[k]);
+        }
+    }
+    export_worker(&w[0]);
+    for (uint16_t k = 1; k < threads; ++k) {
+        if (NULL == w[k].rd) {  // fork failed: run the slice serially on the main reader
+            w[k].rd = rd;
+            export_worker(&w[k]);
+            w[k].rd = NULL;
+        }
+    }
+    for (uint16_t k = 1; k < threads; ++k) {
+        if (thread[k]) {
+            jls_bk_thread_join(thread[k]);
+        }
+        if (w[k].rd) {
+            jls_rd_close(w[k].rd);
+        }
+        if (w[k].return_code && !rc) {
+            rc = w[k].return_code;
+        }
+    }
+    if (w[0].return_code && !rc) {
+        rc = w[0].return_code;
+    }
+    jls_rd_close(rd);
+    return rc;
+}
@@ -27,10 +27,42 @@
 
 
 static int usage(void) {
-    printf("usage: jls inspect <path> [--chunk <offset>] \n");
+    printf("usage: jls inspect <path> [--chunk <offset>] [--census]\n");
     return 1;
 }
 
+struct census_s {
+    int64_t count[256];         // chunks per tag
+    int64_t payload[256];       // payload bytes per tag
+    int64_t chunks;
+    int64_t payload_bytes;
+};
+
+static int32_t census_fn(void * user_data, int64_t offset, const struct jls_chunk_header_s * hdr) {
+    (void) offset;
+    struct census_s * c = (struct census_s *) user_data;
+    c->count[hdr->tag] += 1;
+    c->payload[hdr->tag] += hdr->payload_length;
+    c->chunks += 1;
+    c->payload_bytes += hdr->payload_length;
+    return 0;
+}
+
+static int32_t census_printf(struct jls_raw_s * raw) {
+    struct census_s c;
+    memset(&c, 0, sizeof(c));
+    ROE(jls_raw_chunk_walk(raw, 0, census_fn, &c));
+    printf("%-28s %12s %16s\n", "tag", "chunks", "payload_bytes");
+    for (int tag = 0; tag < 256; ++tag) {
+        if (c.count[tag]) {
+            printf("%-28s %12" PRIi64 " %16" PRIi64 "\n",
+                   jls_tag_to_name((uint8_t) tag), c.count[tag], c.payload[tag]);
+        }
+    }
+    printf("%-28s %12" PRIi64 " %16" PRIi64 "\n", "total", c.chunks, c.payload_bytes);
+    return 0;
+}
+
 static void offset_display(const char * name, int64_t value) {
     printf("%s=0x%08" PRIx32 "_%08" PRIx32 "\n", name,
            (uint32_t) (value >> 32), (uint32_t) (value & 0xffffffff));
@@ -133,6 +165,9 @@ int on_inspect(struct app_s * self, int argc, char * argv[]) {
             ROE(jls_cstr_to_i64(argv[0], &offset));
             ARG_CONSUME();
             ROE(chunk_printf(raw, offset));
+        } else if (0 == strcmp(argv[0], "--census")) {
+            ARG_CONSUME();
+            ROE(census_printf(raw));
         } else {
             return usage();
         }
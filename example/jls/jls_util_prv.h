@@ -53,8 +53,14 @@ typedef int (*command_fn)(struct app_s * self, int argc, char * argv[]);
 
 int on_help(struct app_s * self, int argc, char * argv[]);
 int on_copy(struct app_s * self, int argc, char * argv[]);
+int on_erase(struct app_s * self, int argc, char * argv[]);
+int on_export(struct app_s * self, int argc, char * argv[]);
 int on_fsr_statistics(struct app_s * self, int argc, char * argv[]);
 int on_info(struct app_s * self, int argc, char * argv[]);
 int on_inspect(struct app_s * self, int argc, char * argv[]);
+int on_open_profile(struct app_s * self, int argc, char * argv[]);
 int on_read_fuzzer(struct app_s * self, int argc, char * argv[]);
+int on_repair(struct app_s * self, int argc, char * argv[]);
+int on_resummarize(struct app_s * self, int argc, char * argv[]);
+int on_verify(struct app_s * self, int argc, char * argv[]);
 int on_version(struct app_s * self, int argc, char * argv[]);
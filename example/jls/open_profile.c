@@ -0,0 +1,78 @@
+/*
+ * Copyright 2025 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls.h"
+#include "jls_util_prv.h"
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+
+
+static const char * PHASE_NAMES[JLS_RD_OPEN_PHASE_COUNT] = {
+        "sidecar",         // seek index, UTC time map, footer directory
+        "scan_sources",
+        "scan_signals",
+        "repair",
+        "fsr_open",
+        "scan_sample_id",
+};
+
+static int usage(void) {
+    printf("usage: jls open-profile <path> [path ...]\n");
+    return 1;
+}
+
+static int32_t profile_one(const char * path) {
+    struct jls_rd_s * rd = NULL;
+    struct jls_rd_open_profile_s profile;
+
+    int64_t t_start = jls_now();
+    ROE(jls_rd_open(&rd, path));
+    int64_t duration = jls_now() - t_start;
+    int32_t rc = jls_rd_open_profile_get(rd, &profile);
+    if (rc) {
+        jls_rd_close(rd);
+        return rc;
+    }
+
+    printf("%s:\n", path);
+    printf("  total: %.3f ms\n", (double) duration / JLS_TIME_MILLISECOND);
+    printf("  %-16s %12s %14s %8s\n", "phase", "time_ms", "bytes_read", "seeks");
+    for (uint32_t idx = 0; idx < JLS_RD_OPEN_PHASE_COUNT; ++idx) {
+        printf("  %-16s %12.3f %14" PRIu64 " %8" PRIu64 "\n",
+               PHASE_NAMES[idx],
+               (double) profile.duration_us[idx] / 1000.0,
+               profile.bytes_read[idx],
+               profile.seeks[idx]);
+    }
+    jls_rd_close(rd);
+    return 0;
+}
+
+int on_open_profile(struct app_s * self, int argc, char * argv[]) {
+    (void) self;
+    if (argc < 1) {
+        return usage();
+    }
+    while (argc) {
+        if (argv[0][0] == '-') {
+            return usage();
+        }
+        ROE(profile_one(argv[0]));
+        ARG_CONSUME();
+    }
+    return 0;
+}
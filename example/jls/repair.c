@@ -0,0 +1,62 @@
+/*
+ * Copyright 2023 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls.h"
+#include "jls/copy.h"
+#include "jls_util_prv.h"
+#include <stdio.h>
+#include <string.h>
+
+
+static int usage(void) {
+    printf("usage: jls repair <path>\n");
+    return 1;
+}
+
+static int32_t msg_fn(void * user_data, const char * msg) {
+    (void) user_data;
+    printf("%s\n", msg);
+    return 0;
+}
+
+int on_repair(struct app_s * self, int argc, char * argv[]) {
+    char * path = NULL;
+    int pos_arg = 0;
+    (void) self;
+
+    while (argc) {
+        if (argv[0][0] != '-') {
+            if (pos_arg == 0) {
+                path = argv[0];
+            } else {
+                return usage();
+            }
+            ARG_CONSUME();
+            ++pos_arg;
+        } else {
+            return usage();
+        }
+    }
+    if (pos_arg != 1) {
+        return usage();
+    }
+
+    int32_t rc = jls_repair(path, msg_fn, NULL);
+    if (rc) {
+        printf("ERROR: %d %s : %s\n", rc, jls_error_code_name(rc), jls_error_code_description(rc));
+    }
+    return rc;
+}
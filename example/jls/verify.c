@@ -0,0 +1,71 @@
+/*
+ * Copyright 2023 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls.h"
+#include "jls/verify.h"
+#include "jls_util_prv.h"
+#include "cstr.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+
+static int usage(void) {
+    printf("usage: jls verify <path> [--threads <n>]\n");
+    return 1;
+}
+
+static void verify_fn(void * user_data, int64_t offset, uint8_t tag, int32_t error) {
+    (void) user_data;
+    printf("%" PRIi64 ": tag %d | %d %s : %s\n",
+           offset, (int) tag,
+           error, jls_error_code_name(error), jls_error_code_description(error));
+}
+
+int on_verify(struct app_s * self, int argc, char * argv[]) {
+    char * path = NULL;
+    uint32_t threads = 0;
+    (void) self;
+
+    while (argc) {
+        if (argv[0][0] != '-') {
+            if (NULL != path) {
+                return usage();
+            }
+            path = argv[0];
+            ARG_CONSUME();
+        } else if (0 == strcmp("--threads", argv[0])) {
+            ARG_CONSUME();
+            if (!argc || jls_cstr_to_u32(argv[0], &threads)) {
+                return usage();
+            }
+            ARG_CONSUME();
+        } else {
+            return usage();
+        }
+    }
+    if (NULL == path) {
+        return usage();
+    }
+
+    int32_t rc = jls_verify(path, threads, verify_fn, NULL);
+    if (rc) {
+        printf("ERROR: %d %s : %s\n", rc, jls_error_code_name(rc), jls_error_code_description(rc));
+    } else {
+        printf("OK\n");
+    }
+    return rc;
+}
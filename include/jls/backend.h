@@ -44,6 +44,134 @@ JLS_CPP_GUARD_START
 #define JLS_BK_FLUSH_TIMEOUT_MS (20000)
 #define JLS_BK_CLOSE_TIMEOUT_MS (1000)
 
+/// The opaque io_uring write queue, Linux only.  See backend_linux_uring.c.
+struct jls_uring_s;
+
+/// The opaque OVERLAPPED write queue, Windows only.  See backend_win_overlapped.c.
+struct jls_winol_s;
+
+/// The opaque O_DIRECT write stage, POSIX only.  See backend_posix.c.
+struct jls_direct_s;
+
+// forward declaration, see below
+struct jls_bkf_s;
+
+/**
+ * @brief User-provided I/O operations for a registered backend.
+ *
+ * Register with jls_bk_register() to serve paths matching prefix,
+ * such as object storage ranged reads or an in-memory store.
+ * All operations transfer data at the current position
+ * jls_bkf_s.fpos, which the dispatch layer maintains along with
+ * jls_bkf_s.fend and the performance counters.  Implementations
+ * may store arbitrary state in jls_bkf_s.user_data.
+ */
+struct jls_bk_ops_s {
+    /// The path prefix served by this backend, such as "s3://".
+    const char * prefix;
+
+    /**
+     * @brief Open the path.
+     *
+     * @param self The backend instance with ops and fd=-1 already assigned.
+     * @param path The full path including the prefix.
+     * @param mode The open mode: "w", "r", or "a".
+     * @return 0 or error code.
+     *
+     * On success, must set jls_bkf_s.fend to the current size in bytes.
+     */
+    int32_t (*open)(struct jls_bkf_s * self, const char * path, const char * mode);
+
+    /// Close and free backend state, or NULL when not needed.
+    int32_t (*close)(struct jls_bkf_s * self);
+
+    /// Read count bytes at fpos into buffer, all-or-error.
+    int32_t (*read)(struct jls_bkf_s * self, void * buffer, unsigned int count);
+
+    /// Write count bytes from buffer at fpos, or NULL for read-only backends.
+    int32_t (*write)(struct jls_bkf_s * self, const void * buffer, unsigned int count);
+
+    /// Make prior writes durable, or NULL when not needed.
+    int32_t (*flush)(struct jls_bkf_s * self);
+
+    /// Truncate to fpos bytes, or NULL when unsupported.
+    int32_t (*truncate)(struct jls_bkf_s * self);
+
+    /// Hint that [offset, offset + length) will be read soon, or NULL.
+    int32_t (*readahead)(struct jls_bkf_s * self, int64_t offset, int64_t length);
+};
+
+/**
+ * @brief The opaque growable memory arena for the in-memory backend.
+ *
+ * Use jls_mem_alloc() to create and jls_mem_free() to free.
+ * Open with jls_raw_open_mem(), which writes chunks into the arena
+ * and lets a reader open the same arena without touching a
+ * filesystem.
+ */
+struct jls_mem_s;
+
+/**
+ * @brief Allocate a new, empty memory arena.
+ *
+ * @param[out] mem The new arena on success or NULL.
+ * @return 0 or error code.
+ */
+JLS_API int32_t jls_mem_alloc(struct jls_mem_s ** mem);
+
+/**
+ * @brief Free a memory arena and its contents.
+ *
+ * @param mem The arena, which must have no open instances.
+ */
+JLS_API void jls_mem_free(struct jls_mem_s * mem);
+
+/**
+ * @brief Get the arena contents.
+ *
+ * @param mem The arena.
+ * @param[out] size The content size in bytes, NULL to skip.
+ * @return The contents, valid until the next write or jls_mem_free().
+ */
+JLS_API const uint8_t * jls_mem_data(struct jls_mem_s * mem, int64_t * size);
+
+/// The built-in memory backend operations, see jls_raw_open_mem().
+extern const struct jls_bk_ops_s jls_bk_mem_ops;
+
+/**
+ * @brief Register I/O operations for a path prefix.
+ *
+ * @param ops The operations, which must remain valid until
+ *      jls_bk_unregister().  ops->prefix selects this backend
+ *      when it matches the start of the path given to
+ *      jls_raw_open() / jls_rd_open() / jls_wr_open().
+ * @return 0 or error code.
+ *
+ * Non-matching paths continue to use the native file backend.
+ * Registration is process-wide and not thread-safe with
+ * respect to concurrent opens.
+ */
+JLS_API int32_t jls_bk_register(const struct jls_bk_ops_s * ops);
+
+/**
+ * @brief Unregister I/O operations previously registered.
+ *
+ * @param ops The operations passed to jls_bk_register().
+ * @return 0 or error code.
+ *
+ * The caller must close all files opened through ops first.
+ */
+JLS_API int32_t jls_bk_unregister(const struct jls_bk_ops_s * ops);
+
+/**
+ * @brief Find the registered operations for a path.
+ *
+ * @param path The path to match.
+ * @return The operations with the longest matching prefix or
+ *      NULL for the native file backend.
+ */
+const struct jls_bk_ops_s * jls_bk_ops_match(const char * path);
+
 /**
  * @brief The backend instance.
  */
@@ -51,17 +179,165 @@ struct jls_bkf_s {
     int64_t fpos;    ///< the current file position, to reduce ftell calls.
     int64_t fend;    ///< the file end offset.
     int fd;          ///< The file descriptor.
+    uint8_t * mmap_ptr;  ///< The read-only memory map or NULL when not mapped.
+    int64_t mmap_size;   ///< The memory map size in bytes.
+    struct jls_uring_s * uring;  ///< The asynchronous write queue or NULL for synchronous writes.
+    struct jls_winol_s * winol;  ///< The OVERLAPPED write queue or NULL for synchronous writes.
+    struct jls_direct_s * direct;  ///< The O_DIRECT write stage or NULL for buffered writes.
+    int64_t prealloc;    ///< the reserved allocation end in bytes, 0 when preallocation is disabled.
+    int64_t prealloc_step;  ///< the reservation step size in bytes.
+    int64_t cache_drop;  ///< the write-behind page cache eviction position in bytes.
+    int64_t cache_drop_step;  ///< the eviction chunk size in bytes, 0 when disabled.
+    const struct jls_bk_ops_s * ops;  ///< The registered operations or NULL for the native backend.
+    void * user_data;    ///< Arbitrary data for ops implementations, unused by the native backend.
+
+    // hot-path performance counters, see jls_rd_counters() / jls_twr_counters().
+    // Worker threads update while profile queries read: access only
+    // through jls_bk_counter_add() / jls_bk_counter_load().
+    uint64_t seek_count;     ///< file repositioning operations that changed the position
+    uint64_t bytes_read;     ///< bytes read from the file, including memory-mapped reads
+    uint64_t bytes_written;  ///< bytes written to the file
+    uint64_t write_duration; ///< cumulative jls_bk_fwrite() / jls_bk_fwritev() time, jls_now() units
+    uint64_t flush_duration; ///< cumulative jls_bk_fflush() time, jls_now() units
 };
 
+/**
+ * @brief Atomically add to a jls_bkf_s performance counter.
+ *
+ * @param counter The counter to update.
+ * @param value The value to add.
+ *
+ * Each counter has a single writer, but profile queries read it from
+ * other threads while I/O is in flight, so updates and loads use
+ * relaxed atomics to stay tear-free without ordering cost.
+ */
+void jls_bk_counter_add(volatile uint64_t * counter, uint64_t value);
+
+/**
+ * @brief Atomically load a jls_bkf_s performance counter.
+ *
+ * @param counter The counter to load.
+ * @return The counter value.
+ */
+uint64_t jls_bk_counter_load(volatile uint64_t * counter);
+
 int32_t jls_bk_fopen(struct jls_bkf_s * self, const char * filename, const char * mode);
 int32_t jls_bk_fclose(struct jls_bkf_s * self);
+
+/**
+ * @brief Map the open file read-only into memory.
+ *
+ * @param self The backend instance opened for read.
+ * @return 0 or error code.
+ *
+ * When mapped, jls_bk_fread() serves data directly from the
+ * operating system page cache which skips the read() system call
+ * and kernel-to-user copy on warm files.
+ * jls_bk_fclose() automatically unmaps.
+ */
+int32_t jls_bk_mmap(struct jls_bkf_s * self);
+
+/**
+ * @brief Unmap a file previously mapped with jls_bk_mmap().
+ *
+ * @param self The backend instance.
+ * @return 0 or error code.
+ */
+int32_t jls_bk_munmap(struct jls_bkf_s * self);
+
+/**
+ * @brief Hint that a file region will be read soon.
+ *
+ * @param self The backend instance opened for read.
+ * @param offset The starting file offset for the region.
+ * @param length The region length in bytes.
+ * @return 0 or error code.
+ *
+ * The operating system may start asynchronous readahead for the
+ * region so that upcoming jls_bk_fread() calls do not block on
+ * storage.  This call never blocks and platforms without readahead
+ * support treat it as a no-op.
+ */
+int32_t jls_bk_readahead(struct jls_bkf_s * self, int64_t offset, int64_t length);
 int32_t jls_bk_fwrite(struct jls_bkf_s * self, const void * buffer, unsigned int count);
+
+/// The maximum number of segments for jls_bk_fwritev().
+#define JLS_BK_IOVEC_MAX (4)
+
+/// A contiguous segment for jls_bk_fwritev().
+struct jls_bk_iovec_s {
+    const void * base;      ///< The segment data.
+    unsigned int length;    ///< The segment length in bytes.
+};
+
+/**
+ * @brief Write multiple segments with a single operation.
+ *
+ * @param self The backend instance.
+ * @param iov The segments to write, in order.
+ * @param count The number of segments in iov.
+ * @return 0 or error code.
+ *
+ * Equivalent to calling jls_bk_fwrite() once per segment, but
+ * platforms with scatter-gather support (writev) issue a single
+ * system call.  count must not exceed JLS_BK_IOVEC_MAX.
+ */
+int32_t jls_bk_fwritev(struct jls_bkf_s * self, const struct jls_bk_iovec_s * iov, int count);
 int32_t jls_bk_fread(struct jls_bkf_s * self, void * const buffer, unsigned const buffer_size);
 int32_t jls_bk_fseek(struct jls_bkf_s * self, int64_t offset, int origin);
 int64_t jls_bk_ftell(struct jls_bkf_s * self);
 int32_t jls_bk_fflush(struct jls_bkf_s * self);
 int32_t jls_bk_truncate(struct jls_bkf_s * self);
 
+/**
+ * @brief Deallocate the storage for a file region that reads as zeros.
+ *
+ * @param self The backend instance opened for write or append.
+ * @param offset The starting file offset for the region.
+ * @param length The region length in bytes.
+ * @return 0, JLS_ERROR_NOT_SUPPORTED when the platform, filesystem,
+ *      or backend configuration cannot punch holes, or error code.
+ *
+ * The logical file contents do not change: the caller must only pass
+ * regions that already contain zeros, and reads of a hole return
+ * zeros.  The file size is unchanged; only the underlying blocks are
+ * released, so the on-disk footprint shrinks for erased or omitted
+ * sample regions.  Callers should treat failure as best effort and
+ * leave the zeros stored.
+ */
+int32_t jls_bk_punch_hole(struct jls_bkf_s * self, int64_t offset, int64_t length);
+
+/// A named shared memory mapping, see jls_bk_shm_open().
+struct jls_bk_shm_s {
+    void * ptr;         ///< The mapped memory.
+    int64_t size;       ///< The mapped size in bytes.
+    intptr_t handle;    ///< The platform handle.
+};
+
+/**
+ * @brief Open (or create) a named shared memory mapping.
+ *
+ * @param self The mapping instance to populate.
+ * @param name The host-wide mapping name, [a-zA-Z0-9_.-] recommended.
+ * @param size The mapping size in bytes.
+ * @return 0 or error code.
+ *
+ * The mapping is created zero-filled when it does not already exist
+ * and is shared read-write by every process that opens the same name.
+ * All participants must agree on size.  The mapping persists until
+ * the platform reclaims it: on Windows when the last handle closes,
+ * on POSIX until reboot or explicit unlink.
+ */
+int32_t jls_bk_shm_open(struct jls_bk_shm_s * self, const char * name, int64_t size);
+
+/**
+ * @brief Close a shared memory mapping.
+ *
+ * @param self The mapping instance from jls_bk_shm_open().
+ * @return 0 or error code.
+ */
+int32_t jls_bk_shm_close(struct jls_bk_shm_s * self);
+
 // forward declaration for "threaded_writer.h"
 struct jls_twr_s;
 struct jls_bkt_s * jls_bkt_initialize(struct jls_twr_s * wr);
@@ -72,8 +348,45 @@ int jls_bkt_process_lock(struct jls_bkt_s * self);      // 0 on success or error
 int jls_bkt_process_unlock(struct jls_bkt_s * self);    // 0 on success or error code
 void jls_bkt_msg_wait(struct jls_bkt_s * self);
 void jls_bkt_msg_signal(struct jls_bkt_s * self);
+// ack event: signaled by the writer thread as it consumes messages,
+// awaited by producers blocked on ring space or a flush barrier.
+void jls_bkt_ack_wait(struct jls_bkt_s * self, uint32_t timeout_ms);
+void jls_bkt_ack_signal(struct jls_bkt_s * self);
 void jls_bkt_sleep_ms(uint32_t duration_ms);
 
+// standalone mutex, shared between writer instances (see jls_twr_sched)
+struct jls_bkm_s * jls_bkm_initialize(void);            // NULL on failure
+void jls_bkm_finalize(struct jls_bkm_s * self);
+int jls_bkm_lock(struct jls_bkm_s * self);              // 0 on success or error code
+int jls_bkm_unlock(struct jls_bkm_s * self);            // 0 on success or error code
+
+/// The opaque thread instance for jls_bk_thread_run().
+struct jls_bk_thread_s;
+
+/// The function called from the thread started by jls_bk_thread_run().
+typedef void (*jls_bk_thread_fn)(void * user_data);
+
+/**
+ * @brief Run a function on a new thread.
+ *
+ * @param[out] thread The new thread instance.
+ * @param fn The function to run on the new thread.
+ * @param user_data The arbitrary data for fn.
+ * @return 0 or error code.
+ *
+ * Call jls_bk_thread_join() to wait for fn to return and
+ * free the thread resources.
+ */
+int32_t jls_bk_thread_run(struct jls_bk_thread_s ** thread, jls_bk_thread_fn fn, void * user_data);
+
+/**
+ * @brief Wait for a thread started by jls_bk_thread_run() to complete.
+ *
+ * @param self The thread instance, which is freed by this call.
+ * @return 0 or error code.
+ */
+int32_t jls_bk_thread_join(struct jls_bk_thread_s * self);
+
 
 JLS_API int64_t jls_now(void);
 JLS_API struct jls_time_counter_s jls_time_counter(void);
@@ -75,6 +75,144 @@ JLS_API int32_t jls_copy(const char * src, const char * dst,
                          jls_copy_msg_fn msg_fn, void * msg_user_data,
                          jls_copy_progress_fn progress_fn, void * progress_user_data);
 
+/**
+ * @brief Copy a JLS file, dropping the level 0 FSR sample data.
+ *
+ * @param src The source path.
+ * @param dst The destination path.
+ * @param msg_fn The function to call for messages.
+ * @param msg_user_data The arbitrary data provided to msg_fn.
+ * @param progress_fn The function to call for progress indication.
+ * @param progress_user_data The arbitrary data for progress_fn.
+ * @return 0 or error code.
+ *
+ * The destination retains the summaries but omits the level 0 data
+ * chunks, which typically shrinks the file by the sample decimate
+ * factor.  Reads reconstruct sample data from the summaries, see
+ * jls_wr_fsr_omit_data().  Use for long-term archives where the
+ * waveform envelope suffices.  Annotations, UTC entries, and user
+ * data are retained.
+ */
+JLS_API int32_t jls_copy_downsample(const char * src, const char * dst,
+                                    jls_copy_msg_fn msg_fn, void * msg_user_data,
+                                    jls_copy_progress_fn progress_fn, void * progress_user_data);
+
+/**
+ * @brief Copy a JLS file, rewriting the FSR signals to a new datatype.
+ *
+ * @param src The source path.
+ * @param dst The destination path.
+ * @param data_type The target JLS_DATATYPE_* for every FSR signal:
+ *      JLS_DATATYPE_F32, JLS_DATATYPE_F64, or a signed integer of
+ *      8, 16, or 32 bits with the q field 0.
+ * @param msg_fn The function to call for messages.
+ * @param msg_user_data The arbitrary data provided to msg_fn.
+ * @param progress_fn The function to call for progress indication.
+ * @param progress_user_data The arbitrary data for progress_fn.
+ * @return 0 or error code.
+ *
+ * For integer targets, the fixed-point q is computed per signal from
+ * the source amplitude, read cheaply from the summaries: the largest
+ * q where max|x| * 2**q still fits the integer range.  Samples are
+ * rounded to the nearest step and saturated, so an f32 archive with
+ * 12 effective bits transcodes to i16 with no meaningful loss at
+ * half the storage.  Summaries for the destination are rebuilt from
+ * the converted samples.  Annotations, UTC entries, and user data
+ * copy unchanged.  Like jls_copy(), the work runs as a three-stage
+ * pipeline with the source read, the datatype conversion, and the
+ * summarization/write each on their own thread.
+ */
+JLS_API int32_t jls_transcode(const char * src, const char * dst, uint32_t data_type,
+                              jls_copy_msg_fn msg_fn, void * msg_user_data,
+                              jls_copy_progress_fn progress_fn, void * progress_user_data);
+
+/**
+ * @brief Repair a JLS file in place.
+ *
+ * @param path The JLS file path.
+ * @param msg_fn The function to call for messages.
+ * @param msg_user_data The arbitrary data provided to msg_fn.
+ * @return 0 or error code.
+ *
+ * Unlike jls_copy(), which rewrites every chunk to a new file, this
+ * repair modifies path directly: it scans backward from the end of
+ * the file for the last valid chunk, truncates the remainder, and
+ * rebuilds only the missing head pointers, summaries, and END chunk.
+ * Files that were closed properly are left unmodified.
+ */
+JLS_API int32_t jls_repair(const char * path, jls_copy_msg_fn msg_fn, void * msg_user_data);
+
+/**
+ * @brief Erase an FSR sample range from a JLS file in place.
+ *
+ * @param path The JLS file path.
+ * @param signal_id The signal id to erase.
+ * @param start_sample_id The first sample id to erase, inclusive.
+ * @param end_sample_id The last sample id to erase, exclusive.
+ * @param msg_fn The function to call for messages.
+ * @param msg_user_data The arbitrary data provided to msg_fn.
+ * @return 0 or error code.
+ *
+ * Unlike jls_copy(), which rewrites every chunk to a new file, this
+ * erase modifies path directly and only touches the chunks covering
+ * [start_sample_id, end_sample_id):
+ * - Level 0 data chunk samples in the range are overwritten with
+ *   zeros.  Fully covered data chunks are additionally marked as
+ *   omitted in the level 1 index, see jls_wr_fsr_omit_data().
+ * - Summary entries fully inside the range become zero.  Entries
+ *   straddling a range edge keep their standard deviation, widen
+ *   min/max to include zero, and scale the mean by the retained
+ *   fraction, which approximates the statistics of the retained
+ *   samples plus zeros.
+ * The rest of the file, including annotations, UTC entries, and
+ * other signals, is not modified.
+ *
+ * For data types smaller than 8 bits, the erase extends outward to
+ * the enclosing byte boundaries.  Data or summary chunks stored
+ * compressed (see JLS_COMPRESSION) or delta-encoded cannot change
+ * payload length in place: compressed chunks partially inside the
+ * range and compressed summary or index chunks overlapping the range
+ * return JLS_ERROR_NOT_SUPPORTED before the file is modified.
+ */
+JLS_API int32_t jls_fsr_erase(const char * path, uint16_t signal_id,
+                              int64_t start_sample_id, int64_t end_sample_id,
+                              jls_copy_msg_fn msg_fn, void * msg_user_data);
+
+/**
+ * @brief Recompute all FSR summaries from the level 0 data in place.
+ *
+ * @param path The JLS file path.
+ * @param msg_fn The function to call for messages.
+ * @param msg_user_data The arbitrary data provided to msg_fn.
+ * @param progress_fn The function to call with progress updates.
+ * @param progress_user_data The arbitrary data provided to progress_fn.
+ * @return 0 or error code.
+ *
+ * Unlike jls_copy(), which rewrites every chunk to a new file, this
+ * operation modifies path directly.  Each FSR signal is processed on
+ * its own thread (up to 8 signals concurrently) with a single
+ * sequential file pass: the level 0 data chunks are streamed in file
+ * order and every summary chunk is overwritten at its original offset
+ * with recomputed statistics.  Data chunks, indexes, annotations, and
+ * UTC entries are not modified.
+ *
+ * The recompute matches the writer's summarization semantics, so the
+ * chunk geometry is unchanged and a consistent file keeps its
+ * statistics.  Use this to fix summaries that no longer match the
+ * data, such as after external tools patch sample values without
+ * updating the summaries.
+ *
+ * Summary chunks stored compressed (see JLS_COMPRESSION) cannot change
+ * payload length in place and cause JLS_ERROR_NOT_SUPPORTED for that
+ * signal.  Signals with omitted data chunks (see jls_wr_fsr_omit_data())
+ * are also skipped with JLS_ERROR_NOT_SUPPORTED since the level 0
+ * samples no longer exist.  Other signals are still processed; the
+ * first per-signal error is returned.
+ */
+JLS_API int32_t jls_fsr_resummarize(const char * path,
+                                    jls_copy_msg_fn msg_fn, void * msg_user_data,
+                                    jls_copy_progress_fn progress_fn, void * progress_user_data);
+
 JLS_CPP_GUARD_END
 
 /** @} */
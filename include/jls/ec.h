@@ -72,7 +72,8 @@ JLS_CPP_GUARD_START
     X(ABORTED,                  "The requested operation was previously aborted.") \
     X(SYNCHRONIZATION,          "The target is not synchronized with the originator.")\
     X(UNSUPPORTED_FILE,         "The target file is not supported.")             \
-    X(TRUNCATED,                "The target file was not closed correctly or was truncated.")
+    X(TRUNCATED,                "The target file was not closed correctly or was truncated.") \
+    X(BUDGET,                   "The operation stopped at the I/O byte budget with partial results.")
 
 /// The macro used to define the error code enum.
 #define JLS_ERROR_ENUM(NAME, TEXT) JLS_ERROR_ ## NAME,
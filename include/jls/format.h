@@ -25,6 +25,7 @@
 #define JLS_FORMAT_H__
 
 #include "jls/cmacro.h"
+#include <stddef.h>
 #include <stdint.h>
 
 /**
@@ -316,9 +317,101 @@ enum jls_tag_e {
 
     // other tags
     JLS_TAG_USER_DATA                   = 0x40, // own doubly-linked list
+    JLS_TAG_SEEK_INDEX                  = 0x41, // per-signal seek index, written immediately before END
+    JLS_TAG_UTC_TMAP                    = 0x42, // per-signal UTC time map, written immediately before END
+    JLS_TAG_PADDING                     = 0x43, // zero-filled chunk for aligned placement, readers skip
+    JLS_TAG_DIRECTORY                   = 0x44, // consolidated defs + track heads, written immediately before END
+    JLS_TAG_CHECKPOINT                  = 0x45, // periodic directory snapshot, bounds crash recovery
+    JLS_TAG_LINK_TABLE                  = 0x46, // deferred item_next links, written immediately before END
+    JLS_TAG_SUMMARY_PREVIEW             = 0x47, // partial summary snapshot for live readers, never linked
+    JLS_TAG_CHUNK_CLOCK                 = 0x48, // wall-clock persist times for data chunks, never linked
+    JLS_TAG_DATA_MAP                    = 0x49, // per-signal (timestamp, entry_count) per FSR data chunk, written immediately before END
     JLS_TAG_END                         = 0xFF, // present if file closed properly
 };
 
+/**
+ * @brief The chunk payload compression methods.
+ *
+ * Compression is optional and applies per chunk: each chunk header
+ * declares its own method, and uncompressed chunks remain readable
+ * in a compressed file.  When compressed, the chunk payload is the
+ * uncompressed length as a little-endian uint32 followed by the
+ * compressed bytes, and the header payload_length and the payload
+ * CRC32 cover the compressed representation on disk.
+ */
+enum jls_compression_e {
+    /// No compression: the payload is stored verbatim.
+    JLS_COMPRESSION_NONE = 0,
+    /// Zstandard, available when built with libzstd.
+    JLS_COMPRESSION_ZSTD = 1,
+    /// LZ4 block format, available when built with liblz4.
+    JLS_COMPRESSION_LZ4 = 2,
+    /// Byte run-length encoding, always available.
+    JLS_COMPRESSION_RLE = 3,
+};
+
+/// The jls_chunk_header_s compression bits holding the jls_compression_e method.
+#define JLS_COMPRESSION_METHOD_MASK (0x0f)
+
+/// The jls_chunk_header_s compression bit shift for the jls_checksum_e method.
+#define JLS_CHECKSUM_SHIFT (4)
+
+/**
+ * @brief The payload check value methods.
+ *
+ * Selected per chunk in the jls_chunk_header_s compression field
+ * bits [7:4], so each chunk is self-describing and files written
+ * before this option existed read as JLS_CHECKSUM_CRC32C.  The chunk
+ * header CRC32 always uses CRC-32C since the header must validate
+ * before the method is known.
+ */
+enum jls_checksum_e {
+    /// CRC-32C (Castagnoli) over the payload, the default.
+    JLS_CHECKSUM_CRC32C = 0,
+    /**
+     * @brief XXH64 with seed 0, truncated to the low 32 bits.
+     *
+     * Computes an order of magnitude faster than the software
+     * CRC-32C fallback on platforms without hardware CRC
+     * instructions.  Enable with the JLS_CHECKSUM_XXH environment
+     * variable.
+     */
+    JLS_CHECKSUM_XXH64 = 1,
+};
+
+/**
+ * @brief The FSR level 0 data entry encodings.
+ *
+ * Selected per signal with jls_signal_def_s data_encoding and recorded
+ * per chunk in the payload header rsv16 field, so a file may mix
+ * encoded and verbatim data chunks and old files (0) remain valid.
+ */
+enum jls_fsr_data_encoding_e {
+    /// Entries are stored verbatim at entry_size_bits each.
+    JLS_FSR_DATA_ENCODING_RAW = 0,
+
+    /**
+     * @brief Delta + bit-packing for slowly varying integer signals.
+     *
+     * The first entry is stored at entry_size_bits.  The remaining
+     * entries are zigzag-encoded deltas in blocks of 64, each block
+     * prefixed by one byte giving the packed bit width for the block.
+     * Chunks that do not shrink fall back to RAW per chunk.
+     */
+    JLS_FSR_DATA_ENCODING_DELTA = 1,
+
+    /**
+     * @brief A constant-value run, stored as one sample plus the count.
+     *
+     * The payload stores a single entry at entry_size_bits, padded to
+     * a whole byte, and entry_count gives the run length.  The writer
+     * uses this automatically when every staged entry holds the same
+     * value and the chunk cannot be omitted outright, which collapses
+     * idle channels to a few bytes per data chunk.
+     */
+    JLS_FSR_DATA_ENCODING_CONST = 2,
+};
+
 #define JLS_DATATYPE_BASETYPE_INT        (0x01)
 #define JLS_DATATYPE_BASETYPE_UNSIGNED   (0x02)
 #define JLS_DATATYPE_BASETYPE_UINT       (JLS_DATATYPE_BASETYPE_INT | JLS_DATATYPE_BASETYPE_UNSIGNED)
@@ -394,6 +487,11 @@ struct jls_source_def_s {
     const char * serial_number; ///< The serial number string.
 };
 
+/**
+ * @brief Request automatic chunk geometry, see jls_signal_def_s.samples_per_data.
+ */
+#define JLS_SIGNAL_DEF_AUTO ((uint32_t) 0xffffffffU)
+
 /**
  * @brief The signal definition.
  */
@@ -407,10 +505,29 @@ struct jls_signal_def_s {       // 0 reserved for VSR annotations
     uint16_t signal_id;
     uint16_t source_id;                 ///< The source identifier, must match a source_def.
     uint8_t signal_type;                ///< The jls_signal_type_e signal type.
-    uint16_t rsv16_0;                   //
+
+    /**
+     * @brief The jls_fsr_data_encoding_e for level 0 data chunks.
+     *
+     * Only valid for FSR signals with an INT or UINT data type.
+     * 0 (RAW) otherwise.
+     */
+    uint8_t data_encoding;
+    uint8_t rsv8_0;                     //
     uint32_t data_type;                 ///< The JLS_DATATYPE_* data type for this signal.
     uint32_t sample_rate;               ///< TThe sample rate per second (Hz).  0 for VSR.
-    uint32_t samples_per_data;          ///< The number of samples per data chunk.  (write suggestion)
+
+    /**
+     * @brief The number of samples per data chunk.  (write suggestion)
+     *
+     * 0 uses the static per-datatype defaults.  JLS_SIGNAL_DEF_AUTO
+     * computes the chunk geometry from the sample rate and data type:
+     * data chunks target 32 kB of payload, capped at 10 seconds of
+     * samples so low-rate signals remain seekable, with 64 summary
+     * entries per data chunk and summary chunks also targeting 32 kB.
+     * The writer rounds the result to satisfy the alignment rules.
+     */
+    uint32_t samples_per_data;
     uint32_t sample_decimate_factor;    ///< The number of samples per summary level 1 entry.
     uint32_t entries_per_summary;       ///< The number of entries per summary chunk.  (write suggestion)
     uint32_t summary_decimate_factor;   ///< The number of summaries per summary, level >= 2.
@@ -546,8 +663,17 @@ struct jls_chunk_header_s {
      */
     uint8_t tag;
     
-    /// Reserved for future use.  (compression?)
-    uint8_t rsv0_u8;
+    /**
+     * @brief The payload compression method and checksum selection.
+     *
+     * Bits [3:0] hold the jls_compression_e value for the payload.
+     * When not JLS_COMPRESSION_NONE, payload_length is the compressed
+     * size on disk and the payload starts with the uncompressed length
+     * as a little-endian uint32.  Bits [7:4] hold the jls_checksum_e
+     * method for the payload check value.  Files written before this
+     * field existed contain 0: uncompressed with CRC-32C.
+     */
+    uint8_t compression;
 
     /**
      * @brief The metadata associated with this chunk.
@@ -594,7 +720,14 @@ struct jls_payload_header_s {
     int64_t timestamp;          ///< The sample_id for the first entry.
     uint32_t entry_count;       ///< The total number of entries.
     uint16_t entry_size_bits;   ///< The size of each entry, in bits.
-    uint16_t rsv16;             ///< Reserved.
+
+    /**
+     * @brief The entry encoding.
+     *
+     * The jls_fsr_data_encoding_e for FSR DATA chunks.
+     * Reserved (0) for all other chunk types.
+     */
+    uint16_t rsv16;
 };
 
 /// The FSR data chunk format.
@@ -638,12 +771,39 @@ struct jls_fsr_f32_summary_s {
  * @brief The FSR summary chunk format with f64 values.
  *
  * This summary format is used by u64, i64, f64.
+ *
+ * JLS_TAG_SUMMARY_PREVIEW chunks reuse the f32 and f64 summary payload
+ * formats with the same chunk_meta encoding as the summary they
+ * preview.  A preview snapshots the completed entries still
+ * accumulating in the writer's summary buffer, which only reach a
+ * JLS_TAG_TRACK_FSR_SUMMARY chunk when the buffer fills or the file
+ * closes.  Preview chunks are never linked into the track chains or
+ * referenced by any index, so readers of closed files skip them; live
+ * followers keep the most recent preview per signal and level, see
+ * jls_rd_fsr_summary_preview().
  */
 struct jls_fsr_f64_summary_s {
     struct jls_payload_header_s header;   ///< The payload
     double data[][JLS_SUMMARY_FSR_COUNT]; ///< The summary data, each entry is 4 x f64: mean, std, min, max.
 };
 
+/**
+ * @brief The payload for JLS_TAG_SEEK_INDEX chunks.
+ *
+ * The writer emits one SEEK_INDEX chunk per FSR signal immediately
+ * before JLS_TAG_END when the file closes normally.  The offsets
+ * reference every level-1 INDEX chunk for the signal, spaced by
+ * sample_decimate_factor * entries_per_summary samples starting at
+ * header.timestamp.  The reader uses this table to seek directly to
+ * the enclosing level-1 INDEX chunk rather than walking down the
+ * summary level hierarchy.  Files written before this chunk existed
+ * simply omit it, and readers fall back to the hierarchy walk.
+ */
+struct jls_fsr_seek_index_s {
+    struct jls_payload_header_s header;
+    uint64_t offsets[];         ///< The level-1 INDEX chunk file offsets.
+};
+
 /**
  * @brief The entry format for JLS_TRACK_CHUNK_INDEX payloads.
  * @see jls_index_s
@@ -671,6 +831,12 @@ struct jls_index_s {
  * @brief Hold a single annotation record.
  *
  * This structure is used by both the API and JLS_TAG_TRACK_ANNOTATION_DATA.
+ *
+ * A DATA chunk may hold multiple records back to back.  The first
+ * record's timestamp and rsv64_1 fields overlay jls_payload_header_s,
+ * and the header's entry_count gives the record count for the chunk.
+ * Writers before the coalescing support always wrote one record per
+ * chunk with entry_count 1, which readers ignored.
  */
 struct jls_annotation_s {
     int64_t timestamp;          ///< The timestamp for this annotation.  sample_id for FSR, UTC for VSR.
@@ -684,6 +850,18 @@ struct jls_annotation_s {
     uint8_t data[];             ///< The annotation data.
 };
 
+/**
+ * @brief The size of one annotation record within a DATA chunk payload.
+ *
+ * @param data_size The jls_annotation_s.data_size value.
+ * @return The record size in bytes.
+ *
+ * Multi-record DATA chunks zero-pad each record so that the next
+ * record starts on an 8-byte boundary for in-place access.
+ */
+#define JLS_ANNOTATION_RECORD_SIZE(data_size) \
+    ((offsetof(struct jls_annotation_s, data) + (data_size) + 7) & ~((size_t) 7))
+
 /**
  * @brief The entry format for JLS_TAG_TRACK_ANNOTATION_SUMMARY.
  * @see jls_annotation_summary_s
@@ -741,6 +919,157 @@ struct jls_utc_summary_s {
     struct jls_utc_summary_entry_s entries[];
 };
 
+/**
+ * @brief The payload for JLS_TAG_UTC_TMAP chunks.
+ *
+ * The writer emits one UTC_TMAP chunk per FSR signal with UTC entries
+ * immediately before JLS_TAG_END when the file closes normally.  The
+ * entries duplicate every UTC track entry for the signal, in file
+ * sample_id units, so the reader constructs the sample_id / UTC
+ * time map from a single chunk rather than walking the UTC track.
+ * Files written before this chunk existed or not closed properly
+ * simply omit it, and readers fall back to the UTC track walk.
+ */
+struct jls_utc_tmap_s {
+    struct jls_payload_header_s header;
+    struct jls_utc_summary_entry_s entries[];   ///< The (sample_id, UTC) pairs.
+};
+
+/**
+ * @brief The entry format for JLS_TAG_LINK_TABLE payloads.
+ * @see jls_link_table_s
+ */
+struct jls_link_entry_s {
+    int64_t offset;             ///< The chunk file offset whose stored item_next is 0.
+    int64_t item_next;          ///< The item_next value for that chunk.
+};
+
+/**
+ * @brief The payload for JLS_TAG_LINK_TABLE chunks.
+ *
+ * The strict append-only mode (JLS_APPEND_ONLY=2) never rewrites a
+ * chunk header once written: the track data, index, and summary chunks
+ * keep item_next 0 on disk.  At close, the writer emits this chunk
+ * immediately before JLS_TAG_END holding the (offset, item_next) pair
+ * for every such chunk, sorted by offset.  The reader loads the table
+ * with the other trailing sidecar chunks and substitutes the stored
+ * item_next whenever it reads a chunk header whose on-disk value is 0,
+ * so forward chain iteration and indexed seeks behave exactly as for
+ * a conventionally written file.  Files not closed properly omit the
+ * table, and repair rebuilds the links by forward scan as it already
+ * does for JLS_APPEND_ONLY=1.
+ */
+struct jls_link_table_s {
+    struct jls_payload_header_s header;     ///< entry_count links, entry_size_bits 128.
+    struct jls_link_entry_s entries[];      ///< The links, sorted by ascending offset.
+};
+
+/**
+ * @brief The entry format for JLS_TAG_CHUNK_CLOCK payloads.
+ * @see jls_chunk_clock_s
+ */
+struct jls_chunk_clock_entry_s {
+    int64_t offset;             ///< The FSR data chunk file offset.
+    int64_t timestamp;          ///< The jls_time wall clock when the chunk write was issued.
+};
+
+/**
+ * @brief The payload for JLS_TAG_CHUNK_CLOCK chunks.
+ *
+ * When enabled with jls_wr_chunk_clock_en(), the writer records the
+ * wall-clock time each FSR data chunk write was issued, so a post-run
+ * tool can reconstruct when every chunk persisted and quantify
+ * buffering delay across a capture.  The entries accumulate in memory
+ * and write out as CHUNK_CLOCK chunks mid-stream, plus a final chunk
+ * with the other trailing sidecars at close.  The chunks are never
+ * linked or indexed, so readers that do not know the tag skip them.
+ * header.timestamp holds the file offset of the previous CHUNK_CLOCK
+ * chunk, or 0 for the first, forming a backward chain that the reader
+ * follows from the trailing chunk.  Files not closed properly lose
+ * the entries recorded after the last mid-stream chunk, and the chain
+ * anchor with them.
+ */
+struct jls_chunk_clock_s {
+    struct jls_payload_header_s header;         ///< entry_count entries, entry_size_bits 128.
+    struct jls_chunk_clock_entry_s entries[];   ///< The entries, in write order.
+};
+
+/**
+ * @brief The entry format for JLS_TAG_DATA_MAP payloads.
+ * @see jls_fsr_data_map_s
+ */
+struct jls_fsr_data_map_entry_s {
+    int64_t timestamp;          ///< The starting sample id of the data chunk.
+    uint32_t entry_count;       ///< The number of samples in the data chunk.
+    uint32_t rsv32;             ///< Reserved, write to 0.
+};
+
+/**
+ * @brief The payload for JLS_TAG_DATA_MAP chunks.
+ *
+ * The writer emits one DATA_MAP chunk per FSR signal immediately
+ * before JLS_TAG_END when the file closes normally, with one entry
+ * per level 0 data chunk in chunk index order.  The entries duplicate
+ * the (timestamp, entry_count) payload header fields that otherwise
+ * require reading every data chunk, so tools that only need the
+ * sample coverage, such as a sample_id continuity audit, read 16
+ * bytes per chunk from one trailing chunk instead of the whole file.
+ * chunk_meta holds the signal_id.  Files written before this chunk
+ * existed or not closed properly simply omit it, and readers fall
+ * back to the data chunk walk.
+ */
+struct jls_fsr_data_map_s {
+    struct jls_payload_header_s header;             ///< entry_count entries, entry_size_bits 128.
+    struct jls_fsr_data_map_entry_s entries[];      ///< The entries, in chunk index order.
+};
+
+/**
+ * @brief The payload for JLS_TAG_DIRECTORY chunks.
+ *
+ * The writer emits one DIRECTORY chunk immediately before JLS_TAG_END
+ * when the file closes normally.  The payload duplicates everything the
+ * reader otherwise gathers by scanning the definition chains at open:
+ * the source and signal definitions, the track head offsets, and the
+ * first FSR data chunk timestamp per signal.  With the directory, open
+ * needs only the fixed file header and the trailing chunks, which
+ * matters on storage where every seek is a round trip.  Files written
+ * before this chunk existed or not closed properly simply omit it, and
+ * readers fall back to the definition scan.
+ *
+ * The payload is serialized little-endian, starting with this fixed
+ * header, then the first user data chunk, the iteration anchor, as
+ * (offset i64, chunk header 32 bytes).  Next
+ * follow source_count source records:
+ *     u16 source_id, i64 def offset, def chunk header (32 bytes),
+ *     str name, vendor, model, version, serial_number.
+ * Then signal_count signal records:
+ *     u16 signal_id, i64 def offset, def chunk header (32 bytes),
+ *     u16 source_id, u8 signal_type, u8 data_encoding, u32 data_type,
+ *     u32 sample_rate, u32 samples_per_data, u32 sample_decimate_factor,
+ *     u32 entries_per_summary, u32 summary_decimate_factor,
+ *     u32 annotation_decimate_factor, u32 utc_decimate_factor,
+ *     i64 sample_id_offset, str name, str units, then one entry per
+ *     track type: i64 head offset (0 when absent) followed, when
+ *     present, by the head chunk header (32 bytes) and
+ *     JLS_SUMMARY_LEVEL_COUNT i64 head offsets.
+ * Strings use the normal JLS encoding, NULL terminated with the 0x1f
+ * unit separator.
+ *
+ * JLS_TAG_CHECKPOINT chunks use the same payload.  The writer emits
+ * them periodically, see jls_wr_checkpoint_interval(), to snapshot the
+ * in-memory track head state mid-stream.  After a crash, repair loads
+ * the most recent checkpoint and replays only the chunks written after
+ * it, instead of rebuilding the chain pointers by scanning the whole
+ * file.  Readers of properly closed files ignore checkpoint chunks.
+ */
+struct jls_directory_s {
+    uint8_t version;            ///< The directory format version, 1.
+    uint8_t rsv8_1;             ///< Reserved, write to 0.
+    uint16_t source_count;      ///< The number of source records.
+    uint16_t signal_count;      ///< The number of signal records.
+    uint16_t rsv16_1;           ///< Reserved, write to 0.
+};
+
 JLS_CPP_GUARD_END
 
 /** @} */
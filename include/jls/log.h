@@ -61,6 +61,10 @@ JLS_CPP_GUARD_START
  *
  *      #define JLS_LOG_LEVEL JLS_LOG_LEVEL_WARNING
  *      #include "log.h"
+ *
+ * Log invocations above this level (or JLS_LOG_GLOBAL_LEVEL) compile
+ * out entirely: the level check is a compile-time constant, so the
+ * arguments are never evaluated and no formatting code remains.
  */
 #ifndef JLS_LOG_LEVEL
 #define JLS_LOG_LEVEL JLS_LOG_LEVEL_WARNING
@@ -111,6 +115,11 @@ JLS_CPP_GUARD_START
  * If your application calls the LOG* macros from multiple threads, then
  * the jls_log_printf implementation must be thread-safe and reentrant.
  *
+ * When no handler is registered, this function returns immediately
+ * without formatting, so stray log calls cost only the call overhead.
+ * This path never allocates: synchronous dispatch formats into a stack
+ * buffer and asynchronous dispatch formats into a static ring.
+ *
  * This function is exposed to allow for unit testing.
  */
 JLS_API void jls_log_printf(const char * format, ...) JLS_LOG_PRINTF_FORMAT;
@@ -143,6 +152,37 @@ JLS_API void jls_log_register(jls_log_cbk handler);
  */
 JLS_API void jls_log_unregister(void);
 
+/**
+ * @brief Register an asynchronous logging handler.
+ *
+ * @param handler The log handler, called from a dedicated logging thread.
+ * @return 0 or error code.
+ *
+ * Unlike jls_log_register(), which dispatches each message
+ * synchronously on the calling thread, this formats the message into a
+ * fixed-size ring buffer and returns immediately, so a slow handler or
+ * a debug-level burst cannot stall the writer thread.  Each call site
+ * is also rate limited to JLS_LOG_RATE_LIMIT_PER_SECOND messages per
+ * second; excess messages are counted and reported when the window
+ * rolls over.  Messages that arrive while the ring buffer is full are
+ * dropped and counted.
+ *
+ * While registered, the jls_log_register() handler is not called.
+ * Call jls_log_async_unregister() to drain the ring buffer, stop the
+ * logging thread, and restore synchronous dispatch.
+ */
+JLS_API int32_t jls_log_async_register(jls_log_cbk handler);
+
+/**
+ * @brief Stop asynchronous logging and restore synchronous dispatch.
+ *
+ * Drains all queued messages to the handler before returning.
+ */
+JLS_API void jls_log_async_unregister(void);
+
+/// The per-site message limit per second for jls_log_async_register().
+#define JLS_LOG_RATE_LIMIT_PER_SECOND (100)
+
 /**
  * @def JLS_LOG_PRINTF
  * @brief The printf function including log formatting.
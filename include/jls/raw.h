@@ -60,6 +60,27 @@ struct jls_raw_s;
  */
 int32_t jls_raw_open(struct jls_raw_s ** instance, const char * path, const char * mode);
 
+// forward declaration from "jls/backend.h"
+struct jls_mem_s;
+
+/**
+ * @brief Open a memory arena and create a new JLS raw instance.
+ *
+ * @param[out] instance The new instance on success or NULL.
+ * @param mem The memory arena from jls_mem_alloc(), which must
+ *      remain valid until jls_raw_close().
+ * @param mode The open mode, which is one of "w", "r", "a".
+ * @return 0 or error code.
+ *
+ * Chunks are written to a growable in-memory arena instead of a
+ * file, and a reader can open the same arena without serialization
+ * to disk.  This eliminates the syscall and filesystem overhead for
+ * write-then-read round trips, such as test rigs and streaming
+ * relays.  The caller frees the arena with jls_mem_free() after
+ * closing all instances that use it.
+ */
+int32_t jls_raw_open_mem(struct jls_raw_s ** instance, struct jls_mem_s * mem, const char * mode);
+
 /**
  * @brief Close a file and free resources.
  *
@@ -68,6 +89,20 @@ int32_t jls_raw_open(struct jls_raw_s ** instance, const char * path, const char
  */
 int32_t jls_raw_close(struct jls_raw_s * self);
 
+/**
+ * @brief Enable memory-mapped reads for this instance.
+ *
+ * @param self The JLS raw instance, opened with mode "r".
+ * @return 0 or error code.
+ *
+ * When enabled, chunk reads are served directly from the operating
+ * system page cache, which eliminates the per-read system call and
+ * kernel-to-user copy.  This significantly speeds repeated reads of
+ * the same file regions, such as interactive waveform panning.
+ * The mapping remains active until jls_raw_close().
+ */
+int32_t jls_raw_mmap_enable(struct jls_raw_s * self);
+
 /**
  * @brief Get the JLS file format version.
  *
@@ -85,6 +120,30 @@ union jls_version_u jls_raw_version(struct jls_raw_s * self);
  */
 struct jls_bkf_s * jls_raw_backend(struct jls_raw_s * self);
 
+/**
+ * @brief Get the cumulative bytes processed by CRC32C compute and verify.
+ *
+ * @param self The JLS raw instance.
+ * @return The byte count.
+ */
+uint64_t jls_raw_crc_bytes(struct jls_raw_s * self);
+
+/**
+ * @brief Get the cumulative chunks written with jls_raw_wr().
+ *
+ * @param self The JLS raw instance.
+ * @return The chunk count.
+ */
+uint64_t jls_raw_chunk_wr_count(struct jls_raw_s * self);
+
+/**
+ * @brief Get the payload compression method for appended data chunks.
+ *
+ * @param self The JLS raw instance.
+ * @return The jls_compression_e method, JLS_COMPRESSION_NONE when disabled.
+ */
+uint8_t jls_raw_compression_get(struct jls_raw_s * self);
+
 /**
  * @brief Write a chunk to the file at the current location and advance on success.
  *
@@ -95,6 +154,21 @@ struct jls_bkf_s * jls_raw_backend(struct jls_raw_s * self);
  */
 int32_t jls_raw_wr(struct jls_raw_s * self, struct jls_chunk_header_s * hdr, const uint8_t * payload);
 
+/**
+ * @brief Pad the file so the next chunk starts on an aligned boundary.
+ *
+ * @param self The JLS raw instance.
+ * @return 0 or error code.
+ *
+ * Only applies when aligned chunk placement is enabled by the
+ * JLS_CHUNK_ALIGN environment variable and the instance is appending;
+ * otherwise this function does nothing.  The gap fills with a zeroed
+ * JLS_TAG_PADDING chunk so that chunk navigation remains intact.
+ * Call before jls_raw_chunk_tell() when recording the offset of the
+ * chunk about to be written.
+ */
+int32_t jls_raw_align(struct jls_raw_s * self);
+
 /**
  * @brief Write a chunk header to the file at the current location.
  *
@@ -108,6 +182,22 @@ int32_t jls_raw_wr(struct jls_raw_s * self, struct jls_chunk_header_s * hdr, con
  */
 int32_t jls_raw_wr_header(struct jls_raw_s * self, struct jls_chunk_header_s * hdr);
 
+/**
+ * @brief Write a chunk header whose CRC32 the caller already computed.
+ *
+ * @param self The JLS raw instance.
+ * @param hdr The header with all fields populated, including CRC32.
+ * @return 0 or error code.
+ *
+ * Callers that queue many header rewrites can CRC the whole batch in
+ * one pass with jls_crc32c_hdr() before issuing the writes, which
+ * keeps the CRC kernel hot instead of interleaving it with the seek
+ * and write calls.  When the write lands at the append position, the
+ * header is modified in place and the CRC recomputed as in
+ * jls_raw_wr_header().
+ */
+int32_t jls_raw_wr_header_prechecked(struct jls_raw_s * self, struct jls_chunk_header_s * hdr);
+
 /**
  * @brief Write a chunk payload to the file at the current location.
  *
@@ -148,6 +238,35 @@ int32_t jls_raw_rd_header(struct jls_raw_s * self, struct jls_chunk_header_s * h
  */
 int32_t jls_raw_rd_payload(struct jls_raw_s * self, uint32_t payload_length_max, uint8_t * payload);
 
+/**
+ * @brief Get the delivered payload length for the current chunk.
+ *
+ * @param self The JLS raw instance.
+ * @return The payload length in bytes as delivered by
+ *      jls_raw_rd_payload(), after any transparent decompression.
+ *      This matches the chunk header payload_length except for
+ *      compressed chunks.  Also valid after JLS_ERROR_TOO_BIG to
+ *      size the payload buffer for the retry.
+ */
+uint32_t jls_raw_payload_decoded_length(struct jls_raw_s * self);
+
+/**
+ * @brief Enable or disable payload CRC verification on read.
+ *
+ * @param self The JLS raw instance.
+ * @param enable 1 (default) to verify the payload CRC32C on every
+ *      jls_raw_rd_payload(), 0 to skip the check.
+ * @return 0 or error code.
+ *
+ * The chunk header CRC is always verified: it is cheap and required
+ * for safe chunk navigation.  Disabling payload verification removes
+ * the CRC computation from the read path, which matters for large
+ * interactive reads.  Integrity can then be checked separately, see
+ * jls_rd_crc_defer().  Compressed payloads retain the decompressor's
+ * own consistency checks regardless of this setting.
+ */
+int32_t jls_raw_crc_verify_set(struct jls_raw_s * self, uint8_t enable);
+
 /**
  * @brief Seek to a chunk.
  *
@@ -215,6 +334,41 @@ int32_t jls_raw_chunk_next(struct jls_raw_s * self);
  */
 int32_t jls_raw_chunk_prev(struct jls_raw_s * self);
 
+/**
+ * @brief The callback for each chunk header visited by jls_raw_chunk_walk().
+ *
+ * @param user_data The arbitrary user data.
+ * @param offset The chunk's file offset.
+ * @param hdr The validated chunk header, only valid during this call.
+ * @return 0 to continue the walk or any other value to stop, which
+ *      jls_raw_chunk_walk() then returns.
+ */
+typedef int32_t (*jls_raw_chunk_walk_fn)(void * user_data, int64_t offset,
+                                         const struct jls_chunk_header_s * hdr);
+
+/**
+ * @brief Visit every chunk header from offset to the file end.
+ *
+ * @param self The JLS raw instance.
+ * @param offset The starting chunk offset, or 0 for the first chunk.
+ * @param fn The function called for each CRC-validated header in
+ *      file order.
+ * @param user_data The arbitrary data provided to fn.
+ * @return 0, the first nonzero fn return value, or error code.
+ *
+ * Walking with jls_raw_chunk_next() and jls_raw_rd_header() costs a
+ * seek and a 32-byte read per chunk.  This walk reads large file
+ * extents and parses all headers found in each, which amortizes the
+ * per-chunk I/O for tools that traverse every chunk, such as chunk
+ * census and integrity scans.  Only headers are visited: to read a
+ * chunk's payload, seek to its offset after the walk completes.
+ *
+ * On return, the current chunk position is unspecified; use
+ * jls_raw_chunk_seek() before the next read.
+ */
+int32_t jls_raw_chunk_walk(struct jls_raw_s * self, int64_t offset,
+                           jls_raw_chunk_walk_fn fn, void * user_data);
+
 /**
  * @brief Navigate to the next item in the doubly-linked list.
  *
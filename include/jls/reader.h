@@ -24,6 +24,7 @@
 #ifndef JLS_READER_H__
 #define JLS_READER_H__
 
+#include <stddef.h>
 #include <stdint.h>
 #include "jls/cmacro.h"
 #include "jls/format.h"
@@ -53,6 +54,414 @@ struct jls_rd_s;
  */
 JLS_API int32_t jls_rd_open(struct jls_rd_s ** instance, const char * path);
 
+/**
+ * @brief Open a JLS file to read contents using memory-mapped I/O.
+ *
+ * @param[out] instance The new JLS read instance.
+ * @param path The JLS file path.
+ * @return 0 or error code.
+ *
+ * This variant behaves identically to jls_rd_open() but serves chunk
+ * reads directly from the operating system page cache.  This avoids
+ * the per-read system call and kernel-to-user copy, which speeds
+ * workloads that repeatedly read the same regions, such as
+ * interactive waveform display.  If the platform cannot map the
+ * file, this function falls back to normal reads.
+ *
+ * Call jls_rd_close() when done.
+ */
+JLS_API int32_t jls_rd_open_mmap(struct jls_rd_s ** instance, const char * path);
+
+/**
+ * @brief Open a JLS file that is still being written.
+ *
+ * @param[out] instance The new JLS read instance.
+ * @param path The JLS file path.
+ * @return 0 or error code.
+ *
+ * Unlike jls_rd_open(), a missing end chunk does not trigger the
+ * repair pass: the file is opened read-only as-is so a live capture
+ * can be viewed while the writer still owns it.  Call
+ * jls_rd_refresh() to discover newly appended data; between calls,
+ * jls_rd_fsr_length() and the FSR read functions see a consistent
+ * snapshot.  Summaries and statistics for the newest samples may lag
+ * until the writer emits the corresponding summary chunks.
+ *
+ * Call jls_rd_close() when done.
+ */
+JLS_API int32_t jls_rd_open_follow(struct jls_rd_s ** instance, const char * path);
+
+/**
+ * @brief Update a follow-mode reader with newly appended data.
+ *
+ * @param self The reader instance from jls_rd_open_follow().
+ * @return 0 or error code.
+ *
+ * Re-reads only the updated track head pointers and the chunks
+ * appended since the previous call, so the cost is proportional to
+ * the new data, not the file size.  A chunk that the writer has only
+ * partially flushed is ignored until a later call.  Safe to call
+ * after the writer closes the file; on readers not opened with
+ * jls_rd_open_follow(), this function does nothing and returns 0.
+ */
+JLS_API int32_t jls_rd_refresh(struct jls_rd_s * self);
+
+/**
+ * @brief Open a JLS file to read signal definitions and lengths only.
+ *
+ * @param[out] instance The new JLS read instance.
+ * @param path The JLS file path.
+ * @return 0 or error code.
+ *
+ * This variant serves cataloging workloads that index many files and
+ * need only jls_rd_sources(), jls_rd_signals(), and
+ * jls_rd_fsr_length().  The file is opened read-only and never
+ * modified: when the end chunk is missing, both the repair pass of
+ * jls_rd_open() and the follow-mode indexes of jls_rd_open_follow()
+ * are skipped, so an unclosed file reports the reachable state, which
+ * may end before the last samples written.  The other reader
+ * functions remain available over that same state.
+ *
+ * Call jls_rd_close() when done.
+ */
+JLS_API int32_t jls_rd_open_metadata(struct jls_rd_s ** instance, const char * path);
+
+/// The reader operation phases reported to jls_rd_progress_fn.
+enum jls_rd_phase_e {
+    JLS_RD_PHASE_IDLE = 0,      ///< No long operation in progress.
+    JLS_RD_PHASE_OPEN = 1,      ///< The jls_rd_open() scan, including any repair.
+    JLS_RD_PHASE_QUERY = 2,     ///< A statistics or envelope query.
+};
+
+/**
+ * @brief The callback for reader progress instrumentation.
+ *
+ * @param user_data The arbitrary user data.
+ * @param phase The current jls_rd_phase_e.
+ * @param bytes The cumulative header and payload bytes read by this handle.
+ * @param chunks The cumulative chunks visited by this handle.
+ * @return 0 to continue or any other value to abort the current
+ *      operation with JLS_ERROR_ABORTED.
+ *
+ * The callback is invoked from the thread performing the operation,
+ * on the first chunk read after registration and then at most once
+ * per MiB read.  Keep it fast.
+ */
+typedef int32_t (*jls_rd_progress_fn)(void * user_data, uint8_t phase, int64_t bytes, int64_t chunks);
+
+/**
+ * @brief Open a JLS file to read contents with progress instrumentation.
+ *
+ * @param[out] instance The new JLS read instance.
+ * @param path The JLS file path.
+ * @param fn The progress callback, active for the open scan and all
+ *      later operations on this handle.
+ * @param user_data The arbitrary data for fn.
+ * @return 0 or error code.
+ *
+ * This variant behaves identically to jls_rd_open() but reports
+ * progress during the initial scan, which can take seconds on large
+ * or unclosed files.  If fn aborts during the repair of an unclosed
+ * file, the repair is left incomplete and retried on the next open.
+ *
+ * Call jls_rd_close() when done.
+ */
+JLS_API int32_t jls_rd_open_progress(struct jls_rd_s ** instance, const char * path,
+                                     jls_rd_progress_fn fn, void * user_data);
+
+/**
+ * @brief The completion callback for jls_rd_open_async().
+ *
+ * @param user_data The arbitrary user data.
+ * @param rc 0 on success or the error code the open failed with.
+ *
+ * The callback is invoked exactly once from the background open thread.
+ */
+typedef void (*jls_rd_open_async_fn)(void * user_data, int32_t rc);
+
+/**
+ * @brief Open a JLS file to read contents without blocking on the scan.
+ *
+ * @param[out] instance The new JLS read instance, valid immediately.
+ * @param path The JLS file path.
+ * @param fn The optional completion callback.  Provide NULL to poll
+ *      through any query function instead.
+ * @param user_data The arbitrary data for fn.
+ * @return 0 or error code.
+ *
+ * This function returns after the file header validates, and performs
+ * the scan, repair, and track state load of jls_rd_open() on a
+ * background thread.  jls_rd_sources(), jls_rd_signals(), and
+ * jls_rd_signal() block only until the definitions are loaded, which
+ * happens early in the scan, so metadata displays populate before the
+ * full open completes.  All other query functions block until the
+ * background open finishes and return its error code when it failed.
+ *
+ * The instance is not thread-safe: issue all queries from a single
+ * thread.  If the open fails, the instance remains valid for
+ * jls_rd_close() only.  Call jls_rd_close() when done; it joins the
+ * background thread first.
+ */
+JLS_API int32_t jls_rd_open_async(struct jls_rd_s ** instance, const char * path,
+                                  jls_rd_open_async_fn fn, void * user_data);
+
+/// The jls_rd_open() phases profiled by jls_rd_open_profile_get().
+enum jls_rd_open_phase_e {
+    /// Trailing sidecar chunks: seek index, UTC time map, footer directory.
+    JLS_RD_OPEN_PHASE_SIDECAR = 0,
+    /// The source definition chain scan, when no footer directory exists.
+    JLS_RD_OPEN_PHASE_SCAN_SOURCES = 1,
+    /// The signal definition chain scan, when no footer directory exists.
+    JLS_RD_OPEN_PHASE_SCAN_SIGNALS = 2,
+    /// The repair or read-only recovery of an unclosed file.
+    JLS_RD_OPEN_PHASE_REPAIR = 3,
+    /// The per-signal FSR track state load.
+    JLS_RD_OPEN_PHASE_FSR_OPEN = 4,
+    /// The per-signal sample id and length scan.
+    JLS_RD_OPEN_PHASE_SCAN_SAMPLE_ID = 5,
+    /// The number of profiled phases.
+    JLS_RD_OPEN_PHASE_COUNT = 6,
+};
+
+/// The jls_rd_open() cost breakdown, see jls_rd_open_profile_get().
+struct jls_rd_open_profile_s {
+    uint64_t duration_us[JLS_RD_OPEN_PHASE_COUNT];  ///< Wall time per phase in microseconds.
+    uint64_t bytes_read[JLS_RD_OPEN_PHASE_COUNT];   ///< File bytes read per phase.
+    uint64_t seeks[JLS_RD_OPEN_PHASE_COUNT];        ///< File seeks per phase.
+};
+
+/**
+ * @brief Get the jls_rd_open() cost breakdown for this handle.
+ *
+ * @param self The reader instance.
+ * @param[out] profile The per-phase time and I/O recorded during open.
+ * @return 0 or error code.
+ *
+ * Profiling is always on: recording is a handful of timestamps and
+ * counter snapshots per open.  A dominant scan or repair phase
+ * indicates a file without the trailing sidecar chunks, typically from
+ * an unclosed recording; a dominant sidecar phase with few seeks
+ * indicates the open cost is the file itself, not the layout.
+ */
+JLS_API int32_t jls_rd_open_profile_get(struct jls_rd_s * self, struct jls_rd_open_profile_s * profile);
+
+/**
+ * @brief Open an ordered set of segment files as one continuous timeline.
+ *
+ * @param[out] instance The new JLS read instance.
+ * @param paths The segment file paths, in timeline order, such as the
+ *      segments from jls_twr_rollover() or manual captures.
+ * @param count The number of paths, at least 1.
+ * @return 0 or error code.
+ *
+ * The segments present as a single virtual dataset: sample ids
+ * concatenate across segments in path order, and jls_rd_fsr_length(),
+ * jls_rd_fsr(), jls_rd_fsr_f32(), and jls_rd_fsr_statistics() span
+ * segment boundaries transparently.  Statistics entries that straddle
+ * a boundary combine exactly from the per-segment statistics.
+ *
+ * Only paths[0] opens immediately and provides the source and signal
+ * definitions, which every segment must share.  The remaining segment
+ * handles open lazily on first access, or in parallel when a query
+ * needs the full dataset extent, and each keeps its own reader caches
+ * so boundary crossings stay cheap.
+ *
+ * The remaining reader functions, such as annotations, UTC, and user
+ * data, apply to the first segment only.  jls_rd_close() closes all
+ * segment handles.
+ */
+JLS_API int32_t jls_rd_open_multi(struct jls_rd_s ** instance, const char * const * paths,
+                                  uint16_t count);
+
+/**
+ * @brief Register a progress callback on an open reader.
+ *
+ * @param self The reader instance.
+ * @param fn The progress callback, or NULL to unregister.
+ * @param user_data The arbitrary data for fn.
+ * @return 0 or error code.
+ *
+ * The callback reports long-running operations, such as statistics
+ * queries that walk many chunks, and allows the caller to abort them.
+ * The callback applies per reader handle: register jls_rd_fork()
+ * copies separately.
+ */
+JLS_API int32_t jls_rd_progress_register(struct jls_rd_s * self, jls_rd_progress_fn fn, void * user_data);
+
+/**
+ * @brief Cancel the reader operation in flight.
+ *
+ * @param self The reader instance.
+ * @return 0 or error code.
+ *
+ * Safe to call from another thread while this handle performs a long
+ * operation, such as a statistics query or the jls_rd_open() scan.
+ * The operation stops at the next chunk read and returns
+ * JLS_ERROR_ABORTED; any output buffers hold partial results.  The
+ * token is consumed by the operation it stops, so later operations on
+ * the handle proceed normally.  Unlike the jls_rd_progress_register()
+ * callback, cancellation takes effect on every chunk read, not once
+ * per MiB, and needs no callback plumbing.
+ */
+JLS_API int32_t jls_rd_cancel(struct jls_rd_s * self);
+
+/**
+ * @brief Limit the I/O bytes that reader operations may consume.
+ *
+ * @param self The reader instance.
+ * @param bytes The byte budget shared by all later operations on this
+ *      handle, or 0 to remove the budget.
+ * @return 0 or error code.
+ *
+ * Each chunk read decrements the budget by the header and payload
+ * size, including chunk cache hits.  When the budget runs out, the
+ * operation in flight and all later operations return
+ * JLS_ERROR_BUDGET with partial results until the budget is set
+ * again.  This lets a query service enforce I/O fairness across
+ * tenants without killing the worker: top up the budget per
+ * scheduling quantum and reissue queries that return
+ * JLS_ERROR_BUDGET.  Set the budget between operations; it is not
+ * synchronized against an operation running on another thread.
+ */
+JLS_API int32_t jls_rd_budget(struct jls_rd_s * self, int64_t bytes);
+
+/// The reader performance counters, see jls_rd_counters().
+struct jls_rd_counters_s {
+    uint64_t seeks;          ///< File repositioning operations that changed the position.
+    uint64_t bytes_read;     ///< Bytes read from the file, including memory-mapped reads.
+    uint64_t chunks;         ///< Chunks parsed, including chunk cache hits.
+    uint64_t crc_bytes;      ///< Bytes processed by CRC32C verification.
+    uint64_t cache_hits;     ///< Chunk cache hits.
+    uint64_t cache_misses;   ///< Chunk cache lookups that missed.
+};
+
+/**
+ * @brief Get the cumulative performance counters for this handle.
+ *
+ * @param self The reader instance.
+ * @param[out] counters The counter values since open.
+ * @return 0 or error code.
+ *
+ * The counters cover this handle only: jls_rd_fork() copies and the
+ * deferred CRC scan thread count separately.  A high seek or
+ * cache-miss rate relative to chunks indicates a fragmented file or
+ * a poorly matched samples_per_data for the access pattern.
+ */
+JLS_API int32_t jls_rd_counters(struct jls_rd_s * self, struct jls_rd_counters_s * counters);
+
+/// The per-query read amplification, see jls_rd_query_profile_get().
+struct jls_rd_query_profile_s {
+    uint64_t logical_bytes;   ///< Bytes returned to the caller by the query.
+    uint64_t physical_bytes;  ///< File bytes read to satisfy the query.
+    uint64_t seeks;           ///< File repositioning operations during the query.
+};
+
+/**
+ * @brief Get the read amplification for the most recent query.
+ *
+ * @param self The reader instance.
+ * @param[out] profile The logical and physical bytes for the most
+ *      recent jls_rd_fsr(), jls_rd_fsr_f32(), or
+ *      jls_rd_fsr_statistics() call on this handle.
+ * @return 0 or error code.
+ *
+ * Recording is always on: each query snapshots the backend counters,
+ * including any worker and segment handles the query fanned out to.
+ * Physical bytes count file and memory-mapped reads only, so a query
+ * served from the chunk cache can report fewer physical bytes than
+ * logical bytes.  A large physical-to-logical ratio at a given zoom
+ * level indicates the chunk geometry (samples_per_data and the summary
+ * decimation factors) is mismatched to the access pattern.
+ */
+JLS_API int32_t jls_rd_query_profile_get(struct jls_rd_s * self, struct jls_rd_query_profile_s * profile);
+
+/**
+ * @brief Create an additional reader handle for an already open file.
+ *
+ * @param self The open reader instance to fork.
+ * @param[out] copy The new reader instance, closed with jls_rd_close().
+ * @return 0 or error code.
+ *
+ * A reader handle is not thread-safe: it carries the file cursor and
+ * read scratch state.  This function creates an independent handle for
+ * the same file by copying the open-scan results (source and signal
+ * definitions, track head offsets, seek index, and loaded time maps)
+ * from self, so only the file open itself is repeated.  Use one handle
+ * per thread.  The returned handle is fully independent and may be
+ * closed before or after self.
+ */
+JLS_API int32_t jls_rd_fork(struct jls_rd_s * self, struct jls_rd_s ** copy);
+
+/**
+ * @brief Configure the memory budget for this reader's internal buffers.
+ *
+ * @param self The reader instance.
+ * @param budget The total byte budget shared by the internal read
+ *      buffers, or 0 (default) for unlimited.
+ * @return 0 or error code.
+ *
+ * The reader allocates working buffers on demand and grows them to fit
+ * the largest read performed so far.  With a nonzero budget, any read
+ * that would grow the buffers past the budget fails with
+ * JLS_ERROR_NOT_ENOUGH_MEMORY, and the working sample buffer is
+ * pre-sized for the file's FSR signals when the budget allows so that
+ * steady-state reads do not allocate.  The budget applies per reader
+ * handle: configure jls_rd_fork() copies separately.
+ */
+JLS_API int32_t jls_rd_mem_config(struct jls_rd_s * self, size_t budget);
+
+/**
+ * @brief Release working buffers retained at their high-water size.
+ *
+ * @param self The reader instance.
+ * @return 0 or error code.
+ *
+ * The working buffers for sample and statistics queries grow to fit
+ * the largest query performed so far and are retained between queries
+ * to avoid reallocation.  Call after a large query when the handle
+ * will stay open but mostly idle, such as after an interactive zoom
+ * out.  The next query reallocates at the size it actually needs.
+ */
+JLS_API int32_t jls_rd_mem_trim(struct jls_rd_s * self);
+
+/**
+ * @brief The callback for deferred CRC verification results.
+ *
+ * @param user_data The arbitrary user data provided to jls_rd_crc_defer().
+ * @param offset The file offset of the chunk that failed verification,
+ *      or -1 to indicate that the scan completed.
+ * @param tag The jls_tag_e for the chunk, or JLS_TAG_INVALID on completion.
+ * @param error The error code, normally JLS_ERROR_MESSAGE_INTEGRITY,
+ *      or 0 on completion.
+ *
+ * The callback is invoked from the background scan thread, not from
+ * the thread that calls the reader API.
+ */
+typedef void (*jls_rd_integrity_fn)(void * user_data, int64_t offset, uint8_t tag, int32_t error);
+
+/**
+ * @brief Defer CRC verification to an opportunistic background scan.
+ *
+ * @param self The reader instance.
+ * @param fn The callback for verification failures and scan completion,
+ *      or NULL to skip CRC verification entirely.
+ * @param user_data The arbitrary data for fn.
+ * @return 0 or error code.
+ *
+ * By default, every chunk read verifies the payload CRC32C inline,
+ * which adds measurable latency to large interactive reads.  This
+ * function disables the inline check for this reader.  When fn is
+ * not NULL, a background thread opens a second handle to the same
+ * file and walks every chunk, verifying each payload and reporting
+ * failures through fn.  The scan runs once; fn is called a final
+ * time with offset -1 and error 0 when it completes.  The scan
+ * stops early at jls_rd_close().
+ *
+ * Chunk header CRCs remain verified inline: they are cheap and
+ * required for safe navigation.  Call at most once per reader.
+ */
+JLS_API int32_t jls_rd_crc_defer(struct jls_rd_s * self, jls_rd_integrity_fn fn, void * user_data);
+
 /**
  * @brief Close a JLS file opened with jls_rd_open().
  * @param self The JLS read instance.
@@ -134,6 +543,350 @@ JLS_API int32_t jls_rd_fsr(struct jls_rd_s * self, uint16_t signal_id, int64_t s
 JLS_API int32_t jls_rd_fsr_f32(struct jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
                                float * data, int64_t data_length);
 
+/**
+ * @brief Read fixed sample rate (FSR) float64 data.
+ *
+ * @param self The reader instance.
+ * @param signal_id The signal id, which must use the f64 data type.
+ *      The first recorded sample is always 0.  To get the first
+ *      recorded sample_id, see jls_signal_def_s.sample_id_offset.
+ * @param start_sample_id The starting sample id to read.
+ * @param[out] data The samples read.
+ * @param data_length The number of samples to read.  data is
+ *      also at least this many entries (8 * data_length bytes).
+ * @return 0 or error code
+ *
+ * f64 samples are stored natively, so this reads directly into data
+ * with no intermediate conversion, the same as jls_rd_fsr_f32() for
+ * f32 signals.
+ */
+JLS_API int32_t jls_rd_fsr_f64(struct jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
+                               double * data, int64_t data_length);
+
+/**
+ * @brief Configure the chunk cache for this reader.
+ *
+ * @param self The reader instance.
+ * @param size The maximum cache size in bytes, or 0 to disable.
+ * @return 0 or error code.
+ *
+ * The reader normally keeps only the chunks for the most recent read.
+ * With a cache, chunks are kept in memory after the CRC-validated
+ * read and evicted least recently used, so interactions that revisit
+ * nearby regions, such as waveform pan and zoom, become memory
+ * operations instead of file reads.  Sizes of 64 to 256 MB work well
+ * for interactive display.  Reconfiguring discards all cached chunks.
+ */
+JLS_API int32_t jls_rd_cache(struct jls_rd_s * self, int64_t size);
+
+/**
+ * @brief Attach this reader to a host-wide shared chunk cache.
+ *
+ * @param self The reader instance.
+ * @param name The cache name.  Readers in every cooperating process
+ *      pass the same name to share one cache.
+ * @param size The shared memory segment size in bytes, on which all
+ *      attached processes must agree.  0 detaches.
+ * @return 0 or error code.
+ *
+ * Co-resident processes (UI, exporter, alerting) reading the same file
+ * normally each redo the CRC check and payload staging even when the
+ * OS page cache holds the raw bytes.  This cache places validated
+ * chunk payloads in a named shared memory segment, so one physical
+ * read and CRC check serves every attached reader on the host.  The
+ * coordination is lock-free (per-slot seqlocks): a contended entry
+ * reads as a miss and falls back to the file, so a stuck or killed
+ * process never blocks the others.
+ *
+ * Entries are keyed by the file path string as passed to
+ * jls_rd_open(), so cooperating processes must open the file with the
+ * same path.  The cache does not detect file replacement: after
+ * rewriting a file in place, use a new cache name.  Combine with
+ * jls_rd_cache() for a private in-process LRU layer in front of the
+ * shared cache.  Not supported for multi-file readers.
+ */
+JLS_API int32_t jls_rd_cache_shared(struct jls_rd_s * self, const char * name, int64_t size);
+
+/**
+ * @brief Prefetch a range into the chunk cache in the background.
+ *
+ * @param self The reader instance.
+ * @param signal_id The signal id for an FSR signal.
+ * @param start_sample_id The starting sample id to prefetch.
+ * @param sample_count The number of samples to prefetch.
+ * @param level The summary level: 0 for sample data, 1 and up for
+ *      the summary chunks that serve jls_rd_fsr_statistics() at the
+ *      corresponding increment.
+ * @return 0, JLS_ERROR_FULL when too many prefetches are already
+ *      queued, or other error code.
+ *
+ * Applications often know the next read before issuing it: the region
+ * adjacent to the current waveform view during a pan, or the upcoming
+ * window of a streaming export.  This call queues the range for a
+ * background worker thread that reads and decodes the chunks into the
+ * cache configured by jls_rd_cache(), which must be configured first.
+ * The call never blocks on file I/O, and foreground reads proceed
+ * concurrently, hitting the cache for whatever the worker has already
+ * staged.
+ *
+ * Prefetch is best effort: errors while reading are ignored, and a
+ * range evicted before use simply reads from the file as usual.
+ * The worker thread starts lazily on the first call and persists
+ * until jls_rd_close().  Not supported for multi-file readers.
+ */
+JLS_API int32_t jls_rd_prefetch(struct jls_rd_s * self, uint16_t signal_id,
+                                int64_t start_sample_id, int64_t sample_count, uint8_t level);
+
+/**
+ * @brief Cancel all outstanding prefetch requests.
+ *
+ * @param self The reader instance.
+ * @return 0 or error code.
+ *
+ * Drops every queued range and aborts the range in progress at the
+ * next chunk boundary.  Call when the anticipated access no longer
+ * applies, such as when the user reverses pan direction.  Chunks
+ * already staged remain cached.
+ */
+JLS_API int32_t jls_rd_prefetch_cancel(struct jls_rd_s * self);
+
+/**
+ * @brief Configure the persistent statistics cache for this reader.
+ *
+ * @param self The reader instance.
+ * @param path The sidecar file path, or NULL to derive
+ *      "<jls_path>.stats" from the JLS file path.
+ * @return 0 or error code.
+ *
+ * The sidecar stores the jls_rd_fsr_statistics() results computed
+ * during this session, keyed by (signal_id, start_sample_id,
+ * increment, length).  On the next open of the same unmodified file,
+ * identical queries are served from the sidecar without touching the
+ * JLS file, which takes the first plot render of a large file from
+ * seconds of summary reads to milliseconds.  The sidecar records an
+ * identity hash of the JLS file, so results for a modified file are
+ * recomputed, never served stale.
+ *
+ * The cache is written back when the reader closes.  It is a pure
+ * accelerator: deleting the sidecar is always safe.  Not supported
+ * for multi-file readers, see jls_rd_open_multi().
+ */
+JLS_API int32_t jls_rd_stat_cache(struct jls_rd_s * self, const char * path);
+
+/**
+ * @brief The reconstruction modes for omitted sample data.
+ *
+ * Files recorded with jls_wr_fsr_omit_data() store only summaries for
+ * the omitted regions.  Sample reads over these regions reconstruct
+ * synthetic samples from the summary statistics.
+ */
+enum jls_rd_omit_mode_e {
+    /**
+     * @brief Synthesize Gaussian noise matching the summary mean and
+     *      standard deviation (default).
+     */
+    JLS_RD_OMIT_MODE_GAUSSIAN = 0,
+
+    /**
+     * @brief Fill with the summary mean only.
+     *
+     * Skips the per-sample noise synthesis, which is significantly
+     * faster for display scrubbing over long omitted regions.
+     */
+    JLS_RD_OMIT_MODE_MEAN = 1,
+};
+
+/**
+ * @brief Configure the omitted data reconstruction mode for this reader.
+ *
+ * @param self The reader instance.
+ * @param mode The jls_rd_omit_mode_e reconstruction mode.
+ * @return 0 or error code.
+ *
+ * When a chunk cache is configured with jls_rd_cache(), reconstructed
+ * chunks are cached so repeated reads over an omitted region reuse the
+ * synthesized samples instead of regenerating them.
+ */
+JLS_API int32_t jls_rd_omit_mode(struct jls_rd_s * self, enum jls_rd_omit_mode_e mode);
+
+/// The maximum number of concurrent workers for jls_rd_fsr_batch().
+#define JLS_RD_FSR_BATCH_WORKERS_MAX (8)
+
+/**
+ * @brief A single read request for jls_rd_fsr_batch().
+ */
+struct jls_rd_fsr_req_s {
+    uint16_t signal_id;         ///< The signal id to read.
+    int64_t start_sample_id;    ///< The starting sample id to read.
+    int64_t data_length;        ///< The number of samples to read.
+    void * data;                ///< The caller-provided buffer, sized as for jls_rd_fsr().
+    int32_t return_code;        ///< 0 or error code, populated by jls_rd_fsr_batch().
+};
+
+/**
+ * @brief Read fixed sample rate (FSR) data for multiple requests concurrently.
+ *
+ * @param self The reader instance.
+ * @param requests The array of read requests.  This function populates
+ *      each request's data buffer and return_code.
+ * @param count The number of requests.
+ * @return 0 or the first request error code.
+ *
+ * The reader instance is not thread-safe, so reading multiple signals
+ * previously required serial jls_rd_fsr() calls.  This function
+ * services the requests concurrently on up to
+ * JLS_RD_FSR_BATCH_WORKERS_MAX workers, each with its own reader on
+ * the same file, see jls_rd_fork().  The workers fork lazily on first use and persist
+ * until jls_rd_close(), so repeated batch calls do not pay the file
+ * open cost.  When workers cannot be created, the requests complete
+ * serially with identical results.
+ *
+ * The requests are issued in file offset order (elevator scheduling)
+ * regardless of their order in the array: the reader sorts the pending
+ * reads by the offset of the first chunk each touches, then assigns
+ * each worker one contiguous span of that sweep.  Each worker thus
+ * decodes one contiguous file region moving forward, which avoids
+ * seek-thrashing on spinning media, keeps readahead effective and, on
+ * multi-socket machines, keeps each worker's decode buffers and chunks
+ * local to the NUMA node it runs on.  Results and return codes land in
+ * the caller's request entries, so callers need not pre-sort.
+ */
+JLS_API int32_t jls_rd_fsr_batch(struct jls_rd_s * self, struct jls_rd_fsr_req_s * requests, uint32_t count);
+
+/**
+ * @brief The completion callback for jls_rd_fsr_async().
+ *
+ * @param user_data The arbitrary user data.
+ * @param return_code 0 on success, JLS_ERROR_ABORTED when the reader
+ *      closed with the request outstanding, or another error code.
+ *
+ * The callback runs on the async worker thread, or on the closing
+ * thread for requests aborted by jls_rd_close().  Keep it short and
+ * never call back into this reader instance from it.
+ */
+typedef void (*jls_rd_fsr_async_cbk_fn)(void * user_data, int32_t return_code);
+
+/**
+ * @brief Read fixed sample rate (FSR) data without blocking the caller.
+ *
+ * @param self The reader instance.
+ * @param signal_id The signal id to read.
+ * @param start_sample_id The starting sample id to read.
+ * @param[out] data The caller-owned buffer, sized as for jls_rd_fsr().
+ *      The buffer must remain valid until the callback runs.
+ * @param data_length The number of samples to read.
+ * @param cbk_fn The completion callback.
+ * @param cbk_user_data The arbitrary data provided to cbk_fn.
+ * @return 0 when queued, JLS_ERROR_FULL when too many requests are
+ *      outstanding, or another error code.  The callback runs exactly
+ *      once if and only if this call returns 0.
+ *
+ * Event-loop servers cannot call the blocking jls_rd_fsr() directly
+ * and normally push it onto an external thread pool instead.  This
+ * call queues the read for a dedicated worker thread, forked lazily
+ * from this reader on first use, see jls_rd_fork(), which performs
+ * the read into data and then invokes the callback.  Requests
+ * complete in submission order.  jls_rd_close() completes any
+ * outstanding requests with JLS_ERROR_ABORTED before returning,
+ * without touching data.
+ */
+JLS_API int32_t jls_rd_fsr_async(struct jls_rd_s * self, uint16_t signal_id,
+        int64_t start_sample_id, void * data, int64_t data_length,
+        jls_rd_fsr_async_cbk_fn cbk_fn, void * cbk_user_data);
+
+/// The opaque FSR sample iterator object.  See jls_rd_fsr_iter_open().
+struct jls_rd_fsr_iter_s;
+
+/**
+ * @brief Open a streaming iterator over fixed sample rate (FSR) data.
+ *
+ * @param self The reader instance.
+ * @param signal_id The signal id.
+ * @param start_sample_id The starting sample id.  The first
+ *      recorded sample is always 0.  To get the first recorded sample_id,
+ *      see jls_signal_def_s.sample_id_offset.
+ * @param sample_count The number of samples to iterate over.
+ * @param[out] iter The new iterator, provide to jls_rd_fsr_iter_next()
+ *      and close with jls_rd_fsr_iter_close().
+ * @return 0 or error code.
+ *
+ * The iterator yields pointers directly into the reader's internal
+ * decoded chunk buffer, one data chunk at a time, which avoids the
+ * per-sample memcpy that jls_rd_fsr() performs into the caller's
+ * buffer.  Use for sequential whole-signal consumers such as export
+ * and checksum computations.
+ */
+JLS_API int32_t jls_rd_fsr_iter_open(struct jls_rd_s * self, uint16_t signal_id,
+                                     int64_t start_sample_id, int64_t sample_count,
+                                     struct jls_rd_fsr_iter_s ** iter);
+
+/**
+ * @brief Get the next block of samples from an FSR iterator.
+ *
+ * @param iter The iterator instance.
+ * @param[out] data The sample data, valid only until the next call to
+ *      this function or any other read on the same reader instance.
+ * @param[out] sample_id The sample id of data[0].  For data types
+ *      smaller than 8 bits, the block starts on the containing byte
+ *      boundary, so sample_id may precede the requested start.
+ * @param[out] sample_count The number of samples in data.
+ * @return 0, JLS_ERROR_EMPTY when the iteration completed, or error code.
+ */
+JLS_API int32_t jls_rd_fsr_iter_next(struct jls_rd_fsr_iter_s * iter,
+                                     const void ** data, int64_t * sample_id,
+                                     int64_t * sample_count);
+
+/**
+ * @brief Close an FSR iterator and free all resources.
+ *
+ * @param iter The iterator instance.
+ */
+JLS_API void jls_rd_fsr_iter_close(struct jls_rd_fsr_iter_s * iter);
+
+/**
+ * @brief The callback for each jls_rd_fsr_export() batch.
+ *
+ * @param user_data The arbitrary user data.
+ * @param data The sample data, in the signal data type, valid only for
+ *      the duration of the callback.
+ * @param sample_id The sample id of data[0].
+ * @param sample_count The number of samples in data.
+ * @return 0 to continue or any other value to abort the export.
+ */
+typedef int32_t (*jls_rd_fsr_export_fn)(void * user_data, const void * data,
+                                        int64_t sample_id, int64_t sample_count);
+
+/**
+ * @brief Stream a sample range to a callback in fixed-size batches.
+ *
+ * @param self The reader instance.
+ * @param signal_id The signal id.
+ * @param start_sample_id The starting sample id.  The first
+ *      recorded sample is always 0.  For data types smaller than
+ *      8 bits, the export starts on the containing byte boundary,
+ *      so the first batch may precede the requested start.
+ * @param sample_count The number of samples to export.
+ * @param batch_size The samples per callback, or 0 for the default.
+ *      Data types smaller than 8 bits round up to a whole byte.
+ * @param prefetch_chunks The data chunks of readahead to request
+ *      while the callback runs, or 0 for the default.
+ * @param fn The callback for each batch.
+ * @param user_data The arbitrary data for fn.
+ * @return 0, JLS_ERROR_ABORTED when fn returned nonzero, or error code.
+ *
+ * Memory stays bounded at one batch buffer plus the reader's decoded
+ * chunk buffer regardless of sample_count, unlike a single large
+ * jls_rd_fsr() call which materializes the full range.  Between
+ * batches, jls_bk_readahead() hints the upcoming chunks so the
+ * operating system fetches them while the callback processes the
+ * current batch, which avoids the per-call seek cost of issuing many
+ * small jls_rd_fsr() reads.
+ */
+JLS_API int32_t jls_rd_fsr_export(struct jls_rd_s * self, uint16_t signal_id,
+                                  int64_t start_sample_id, int64_t sample_count,
+                                  int64_t batch_size, uint32_t prefetch_chunks,
+                                  jls_rd_fsr_export_fn fn, void * user_data);
+
 /**
  * @brief Read the statistics data for a fixed sampling rate signal.
  *
@@ -161,11 +914,246 @@ JLS_API int32_t jls_rd_fsr_f32(struct jls_rd_s * self, uint16_t signal_id, int64
  * perfect for waveform display, but perhaps not suitable for other use
  * cases.  If you need sample accurate statistics over multiple
  * increments, call this function repeatedly with data_length 1.
+ *
+ * For data_length 1 over many millions of samples, this function
+ * splits the interval across up to JLS_RD_FSR_BATCH_WORKERS_MAX
+ * concurrent workers, see jls_rd_fsr_batch(), and merges the partial
+ * statistics.  The merge math is associative, so the result matches
+ * the serial computation up to floating-point rounding.
  */
 JLS_API int32_t jls_rd_fsr_statistics(struct jls_rd_s * self, uint16_t signal_id,
                                       int64_t start_sample_id, int64_t increment,
                                       double * data, int64_t data_length);
 
+/**
+ * @brief Get the most recent summary preview for a signal level.
+ *
+ * @param self The reader instance, opened with jls_rd_open_follow().
+ * @param signal_id The signal id.
+ * @param level The summary level, 1 to JLS_SUMMARY_LEVEL_COUNT - 1.
+ * @param[out] sample_id The starting sample id of the first entry.
+ * @param[out] data The summary entries as
+ *      [mean, standard deviation, minimum, maximum] x *entries.
+ * @param[inout] entries On input, the capacity of data in entries.
+ *      On output, the number of entries copied.
+ * @return 0, JLS_ERROR_NOT_FOUND when no preview was seen yet,
+ *      or another error code.
+ *
+ * Returns the entries from the newest JLS_TAG_SUMMARY_PREVIEW chunk
+ * discovered by jls_rd_refresh(), which the writer emits under
+ * jls_wr_fsr_summary_watermark().  Each entry spans the same samples
+ * as a regular level summary entry, so a live display can render the
+ * trailing window from this preview instead of reading level 0 data.
+ * Entries may overlap summaries already reachable through
+ * jls_rd_fsr_statistics(); use sample_id to align them.
+ */
+JLS_API int32_t jls_rd_fsr_summary_preview(struct jls_rd_s * self, uint16_t signal_id, uint8_t level,
+                                           int64_t * sample_id, double * data, int64_t * entries);
+
+/**
+ * @brief Get aligned statistics for multiple signals in one pass.
+ *
+ * @param self The reader instance.
+ * @param signal_ids The FSR signals, which must share a sample clock:
+ *      start_sample_id and increment apply to every signal directly.
+ * @param signal_count The number of signals in signal_ids, at least 1.
+ * @param start_sample_id The starting sample id, inclusive.
+ * @param increment The number of samples per output entry.
+ * @param[out] data The statistics information, in the shape of
+ *      data[data_length][signal_count][JLS_SUMMARY_FSR_COUNT]: the
+ *      entries for one time interval are adjacent, in signal_ids order.
+ * @param data_length The number of output entries per signal.
+ * @return 0 or error code.
+ *
+ * Each entry matches jls_rd_fsr_statistics() for the same signal and
+ * interval up to floating-point rounding when the entry boundaries
+ * align with sample_decimate_factor.  Unaligned boundaries are
+ * attributed at summary granularity, as for the per-signal query, and
+ * the attribution restarts at internal block seams, so those entries
+ * can differ slightly from one full-length query.
+ * The signals advance through time in
+ * blocks, so the chunks backing one region are read while still warm
+ * instead of after a full pass over the other signals, which matters
+ * for queries larger than the cache.  Analyses that combine signals,
+ * such as power from voltage and current, get aligned entries without
+ * issuing one full query per signal and merging afterward.
+ */
+JLS_API int32_t jls_rd_fsr_statistics_multi(struct jls_rd_s * self,
+                                            const uint16_t * signal_ids, uint16_t signal_count,
+                                            int64_t start_sample_id, int64_t increment,
+                                            double * data, int64_t data_length);
+
+/**
+ * @brief Resample statistics to exactly data_length entries over a range.
+ *
+ * @param self The reader instance.
+ * @param signal_id The FSR signal.
+ * @param start_sample_id The starting sample id, inclusive.  The first
+ *      recorded sample is always 0.
+ * @param end_sample_id The ending sample id, exclusive, which must not
+ *      exceed the signal length.
+ * @param[out] data The statistics information, in the shape of
+ *      data[data_length][JLS_SUMMARY_FSR_COUNT], as for
+ *      jls_rd_fsr_statistics().
+ * @param data_length The number of output entries, such as the display
+ *      width in pixels.  Must not exceed end - start.
+ * @return 0 or error code.
+ *
+ * Unlike jls_rd_fsr_statistics(), which needs an integer increment and
+ * covers increment * data_length samples, this function divides
+ * [start, end) into exactly data_length entries for any data_length.
+ * When each output entry spans at least one level-1 summary entry, the
+ * result is composed entirely from the coarsest suitable stored
+ * summary level: summary entries that straddle an output boundary are
+ * split proportionally, an approximation suitable for display, and
+ * level-0 sample data is never read.  For finer output entries, each
+ * entry is computed exactly.
+ */
+JLS_API int32_t jls_rd_fsr_statistics_resample(struct jls_rd_s * self, uint16_t signal_id,
+                                               int64_t start_sample_id, int64_t end_sample_id,
+                                               double * data, int64_t data_length);
+
+/**
+ * @brief Read the min/max envelope for a fixed sampling rate signal.
+ *
+ * @param self The reader instance.
+ * @param signal_id The FSR signal.
+ * @param start_sample_id The starting sample id to read.  The first
+ *      recorded sample is always 0.  To get the first recorded sample_id,
+ *      see jls_signal_def_s.sample_id_offset.
+ * @param increment The number of samples that form a single output pair.
+ * @param[out] data The envelope, in the shape of data[data_length][2]
+ *      with each entry as (min, max).
+ * @param data_length The number of envelope pairs to populate.
+ * @return 0 or error code.
+ *
+ * Waveform rendering only needs min/max, but jls_rd_fsr_statistics()
+ * computes and copies mean and standard deviation doubles for every
+ * output entry.  This function reads min/max straight from the stored
+ * summary payload (or the sample data when increment is small) into a
+ * compact float32 envelope.  Boundary handling matches
+ * jls_rd_fsr_statistics(): exact external boundaries, approximated
+ * internal boundaries.
+ */
+JLS_API int32_t jls_rd_fsr_envelope(struct jls_rd_s * self, uint16_t signal_id,
+                                    int64_t start_sample_id, int64_t increment,
+                                    float * data, int64_t data_length);
+
+/// A matching sample range found by jls_rd_fsr_find().
+struct jls_rd_fsr_find_range_s {
+    int64_t start;          ///< The first matching sample id, inclusive.
+    int64_t end;            ///< The last matching sample id + 1, exclusive.
+};
+
+/**
+ * @brief Find the sample ranges whose values fall within [value_min, value_max].
+ *
+ * @param self The reader instance.
+ * @param signal_id The FSR signal.
+ * @param start_sample_id The first sample id to search, inclusive.
+ * @param end_sample_id The end sample id, exclusive.
+ * @param value_min The minimum matching value, inclusive.
+ *      Use -INFINITY for "any value below value_max".
+ * @param value_max The maximum matching value, inclusive.
+ *      Use INFINITY for "any value above value_min".
+ * @param[out] ranges The matching ranges, sorted ascending with
+ *      adjacent matches coalesced.
+ * @param ranges_alloc The number of entries allocated in ranges.
+ * @param[out] ranges_count The total number of matching ranges, which
+ *      may exceed ranges_alloc.  Only the first ranges_alloc ranges
+ *      are stored; resume a truncated search at ranges[ranges_alloc - 1].end.
+ * @return 0 or error code.
+ *
+ * Every stored FSR summary entry holds the min/max over its span, so
+ * this search descends the summary levels like a segment tree and
+ * prunes every subtree whose min/max excludes [value_min, value_max].
+ * Level 0 sample data is only read for the spans that may match, which
+ * makes sparse value-range queries O(log + matches) rather than a full
+ * scan.  NaN samples never match.
+ */
+JLS_API int32_t jls_rd_fsr_find(struct jls_rd_s * self, uint16_t signal_id,
+                                int64_t start_sample_id, int64_t end_sample_id,
+                                double value_min, double value_max,
+                                struct jls_rd_fsr_find_range_s * ranges, int64_t ranges_alloc,
+                                int64_t * ranges_count);
+
+/**
+ * @brief Extract a sample window of selected signals into a new JLS file.
+ *
+ * @param self The reader instance.
+ * @param path The path for the new JLS file.
+ * @param signal_ids The FSR signal ids to extract, or NULL for all.
+ * @param signal_count The number of entries in signal_ids, 0 for all.
+ * @param start_sample_id The first sample to copy for each signal.
+ * @param end_sample_id The end sample, exclusive, clamped to each
+ *      signal's length.
+ * @return 0 or error code.
+ *
+ * The source and signal definitions copy to the new file, and the
+ * samples keep their absolute sample ids, so extracted trigger windows
+ * stay aligned with the original capture.  When start_sample_id falls
+ * on a level 1 summary boundary (a sample_decimate_factor multiple),
+ * the existing level 1 summaries are reused through
+ * jls_wr_fsr_summary_inject() instead of recomputed, which is the
+ * dominant cost of a copy; otherwise, or when the summary read fails,
+ * the writer recomputes them from the copied samples.  Annotations,
+ * UTC entries, and user data do not copy.
+ */
+JLS_API int32_t jls_rd_extract(struct jls_rd_s * self, const char * path,
+                               const uint16_t * signal_ids, uint16_t signal_count,
+                               int64_t start_sample_id, int64_t end_sample_id);
+
+/// The opaque rolling statistics cursor.  See jls_rd_fsr_statistics_cursor_open().
+struct jls_rd_fsr_stats_cursor_s;
+
+/**
+ * @brief Open a rolling statistics cursor for a fixed sampling rate signal.
+ *
+ * @param self The reader instance, which must remain open while the
+ *      cursor is in use.
+ * @param signal_id The FSR signal.
+ * @param[out] cursor The new cursor, provide to
+ *      jls_rd_fsr_statistics_cursor_query() and close with
+ *      jls_rd_fsr_statistics_cursor_close().
+ * @return 0 or error code.
+ *
+ * Repeatedly computing jls_rd_fsr_statistics() over a sliding window,
+ * as live displays do, re-reads mostly the same chunks on every
+ * update.  The cursor caches per-block partial statistics from the
+ * previous query and only reads the samples that entered the window,
+ * so an advancing window costs O(delta) instead of O(window).
+ */
+JLS_API int32_t jls_rd_fsr_statistics_cursor_open(struct jls_rd_s * self, uint16_t signal_id,
+                                                  struct jls_rd_fsr_stats_cursor_s ** cursor);
+
+/**
+ * @brief Compute the statistics over a window, reusing cached partials.
+ *
+ * @param cursor The cursor instance.
+ * @param start_sample_id The starting sample id, as for
+ *      jls_rd_fsr_statistics().
+ * @param window_length The number of samples in the window.
+ * @param[out] data The JLS_SUMMARY_FSR_COUNT statistics values, as for
+ *      jls_rd_fsr_statistics() with data_length 1.
+ * @return 0 or error code.
+ *
+ * The result is sample-accurate and matches jls_rd_fsr_statistics()
+ * up to floating-point rounding.  Caching is most effective when
+ * window_length stays constant and start_sample_id advances, since a
+ * window_length change discards the cached partials.  The cursor uses
+ * the reader instance, so it shares the reader's thread constraints.
+ */
+JLS_API int32_t jls_rd_fsr_statistics_cursor_query(struct jls_rd_fsr_stats_cursor_s * cursor,
+                                                   int64_t start_sample_id, int64_t window_length,
+                                                   double * data);
+
+/**
+ * @brief Close a rolling statistics cursor and free all resources.
+ *
+ * @param cursor The cursor instance.
+ */
+JLS_API void jls_rd_fsr_statistics_cursor_close(struct jls_rd_fsr_stats_cursor_s * cursor);
+
 /**
  * @brief The function called for each annotation.
  *
@@ -192,6 +1180,76 @@ typedef int32_t (*jls_rd_annotation_cbk_fn)(void * user_data, const struct jls_a
 JLS_API int32_t jls_rd_annotations(struct jls_rd_s * self, uint16_t signal_id, int64_t timestamp,
                                    jls_rd_annotation_cbk_fn cbk_fn, void * cbk_user_data);
 
+/**
+ * @brief Iterate over the annotations within a timestamp range.
+ *
+ * @param self The reader instance.
+ * @param signal_id The signal id.
+ * @param start_timestamp The starting timestamp, inclusive.
+ * @param end_timestamp The ending timestamp, exclusive.
+ * @param cbk_fn The callback function, called once for each annotation
+ *      in the range.  Return 0 to continue to the next annotation or
+ *      a non-zero value to stop iteration.
+ * @param cbk_user_data The arbitrary data provided to cbk_fn.
+ * @return 0 or error code.
+ *
+ * The first call for a signal builds a binary-searchable timestamp
+ * index over the signal's annotations, which later calls reuse.
+ * The range start then resolves in O(log n), unlike
+ * jls_rd_annotations() which descends the on-disk index levels with
+ * a linear scan per level on every call.
+ */
+JLS_API int32_t jls_rd_annotations_range(struct jls_rd_s * self, uint16_t signal_id,
+                                         int64_t start_timestamp, int64_t end_timestamp,
+                                         jls_rd_annotation_cbk_fn cbk_fn, void * cbk_user_data);
+
+/**
+ * @brief Count the annotations within a timestamp range.
+ *
+ * @param self The reader instance.
+ * @param signal_id The signal id.
+ * @param start_timestamp The starting timestamp, inclusive.
+ * @param end_timestamp The ending timestamp, exclusive.
+ * @param[out] count The number of annotations in the range.
+ * @return 0 or error code.
+ *
+ * After the first call builds the annotation index, this function
+ * answers from the index alone with no chunk reads, so it suits
+ * issuing many queries per display update, such as for annotation
+ * density bars.  See jls_rd_annotations_range().
+ */
+JLS_API int32_t jls_rd_annotations_count(struct jls_rd_s * self, uint16_t signal_id,
+                                         int64_t start_timestamp, int64_t end_timestamp,
+                                         int64_t * count);
+
+/**
+ * @brief Iterate over the annotations within a range whose payload contains a byte sequence.
+ *
+ * @param self The reader instance.
+ * @param signal_id The signal id.
+ * @param start_timestamp The starting timestamp, inclusive.
+ * @param end_timestamp The ending timestamp, exclusive.
+ * @param data The byte sequence to search for within jls_annotation_s.data.
+ *      For string and JSON annotations, pass the text without the
+ *      NUL terminator to match substrings.
+ * @param data_size The size of data in bytes.  0 matches every annotation.
+ * @param cbk_fn The callback function, called once for each matching
+ *      annotation.  Return 0 to continue or a non-zero value to stop iteration.
+ * @param cbk_user_data The arbitrary data provided to cbk_fn.
+ * @return 0 or error code.
+ *
+ * The annotation index (see jls_rd_annotations_range()) keeps a 64-bit
+ * content digest per record, computed over the payload's 3-byte windows.
+ * Chunks whose digests cannot contain the query are skipped without
+ * reading them, so searching for a rare term touches only a small
+ * fraction of the annotation data.  Queries shorter than 3 bytes
+ * cannot use the digest and scan every chunk in the range.
+ */
+JLS_API int32_t jls_rd_annotations_find(struct jls_rd_s * self, uint16_t signal_id,
+                                        int64_t start_timestamp, int64_t end_timestamp,
+                                        const uint8_t * data, uint32_t data_size,
+                                        jls_rd_annotation_cbk_fn cbk_fn, void * cbk_user_data);
+
 /**
  * @brief The function called for each user data entry.
  *
@@ -246,6 +1304,83 @@ typedef int32_t (*jls_rd_utc_cbk_fn)(void * user_data,
 JLS_API int32_t jls_rd_utc(struct jls_rd_s * self, uint16_t signal_id, int64_t sample_id,
                            jls_rd_utc_cbk_fn cbk_fn, void * cbk_user_data);
 
+/**
+ * @brief Get the UTC entries for a FSR signal sample range in one call.
+ *
+ * @param self The reader instance.
+ * @param signal_id The signal id.
+ * @param start_sample_id The starting sample_id, inclusive.
+ * @param end_sample_id The ending sample_id, exclusive.
+ * @param[out] entries The caller-provided array of UTC entries.
+ * @param entries_max The maximum number of entries to store.
+ * @param[out] count The number of entries stored, which may be less than
+ *      entries_max when the range contains fewer entries.  When count
+ *      equals entries_max, the range may contain additional entries.
+ *      Resume with start_sample_id = entries[count - 1].sample_id + 1.
+ * @return 0 or error code.
+ *
+ * This function fills the entire array in a single pass, which avoids
+ * the per-entry callback overhead of jls_rd_utc() when building a full
+ * sample-to-UTC mapping, especially through language bindings.
+ */
+JLS_API int32_t jls_rd_utc_range(struct jls_rd_s * self, uint16_t signal_id,
+                                 int64_t start_sample_id, int64_t end_sample_id,
+                                 struct jls_utc_summary_entry_s * entries, int64_t entries_max,
+                                 int64_t * count);
+
+/**
+ * @brief The function called for each chunk clock batch.
+ *
+ * @param user_data The arbitrary user data.
+ * @param entries The (offset, wall-clock time) entries, ordered by
+ *      increasing file offset.
+ * @param count The number of entries.
+ * @return 0 to continue iteration or any other value to stop.
+ *
+ * @see jls_rd_chunk_clock
+ */
+typedef int32_t (*jls_rd_chunk_clock_cbk_fn)(void * user_data,
+        const struct jls_chunk_clock_entry_s * entries, uint32_t count);
+
+/**
+ * @brief Iterate over the wall-clock persist times for data chunks.
+ *
+ * @param self The reader instance.
+ * @param cbk_fn The callback function, called once per
+ *      JLS_TAG_CHUNK_CLOCK chunk from the start of the file to the end.
+ * @param cbk_user_data The arbitrary data provided to cbk_fn.
+ * @return 0, JLS_ERROR_NOT_FOUND when the writer did not enable
+ *      jls_wr_chunk_clock_en(), or another error code.
+ *
+ * Correlate the entry offsets with chunk sample timestamps to measure
+ * the wall-clock delay between sample acquisition and persistence.
+ */
+JLS_API int32_t jls_rd_chunk_clock(struct jls_rd_s * self,
+        jls_rd_chunk_clock_cbk_fn cbk_fn, void * cbk_user_data);
+
+/**
+ * @brief Get the level 0 data chunk coverage map for a signal.
+ *
+ * @param self The reader instance.
+ * @param signal_id The signal id for an FSR signal.
+ * @param[out] entries The (timestamp, entry_count) entry per data
+ *      chunk, in chunk order.  The pointer remains valid until
+ *      jls_rd_close().
+ * @param[out] count The number of entries.
+ * @return 0 or error code.
+ *
+ * Each entry gives the starting sample id and sample count of one
+ * data chunk, so a sample_id continuity audit checks
+ * entries[k].timestamp + entries[k].entry_count ==
+ * entries[k + 1].timestamp without reading any sample payloads.
+ * Properly closed files serve the map from the trailing
+ * JLS_TAG_DATA_MAP chunk, 16 bytes per data chunk.  Older or
+ * improperly closed files build it by walking the data chunks once.
+ * Not supported for multi-file readers.
+ */
+JLS_API int32_t jls_rd_fsr_data_map(struct jls_rd_s * self, uint16_t signal_id,
+        const struct jls_fsr_data_map_entry_s ** entries, uint32_t * count);
+
 /**
  * @brief Convert from sample_id to timestamp for FSR signals.
  *
@@ -270,6 +1405,67 @@ JLS_API int32_t jls_rd_sample_id_to_timestamp(struct jls_rd_s * self, uint16_t s
 JLS_API int32_t jls_rd_timestamp_to_sample_id(struct jls_rd_s * self, uint16_t signal_id,
         int64_t timestamp, int64_t * sample_id);
 
+/**
+ * @brief Convert an array of sample_ids to timestamps for FSR signals.
+ *
+ * @param self The reader instance.
+ * @param signal_id The signal id.
+ * @param sample_ids The sample ids to convert.
+ * @param[out] timestamps The JLS timestamp for each entry in sample_ids.
+ * @param count The number of entries in sample_ids and timestamps.
+ * @return 0 or error code.
+ *
+ * Equivalent to calling jls_rd_sample_id_to_timestamp() per entry,
+ * but runs within one time map segment binary search once and then
+ * interpolate, which greatly reduces the cost of annotating large
+ * exported windows.
+ */
+JLS_API int32_t jls_rd_sample_id_to_timestamp_batch(struct jls_rd_s * self, uint16_t signal_id,
+        int64_t const * sample_ids, int64_t * timestamps, size_t count);
+
+/**
+ * @brief Convert an array of timestamps to sample_ids for FSR signals.
+ *
+ * @param self The reader instance.
+ * @param signal_id The signal id.
+ * @param timestamps The JLS timestamps to convert.
+ * @param[out] sample_ids The sample_id for each entry in timestamps.
+ * @param count The number of entries in timestamps and sample_ids.
+ * @return 0 or error code.
+ *
+ * See jls_rd_sample_id_to_timestamp_batch().
+ */
+JLS_API int32_t jls_rd_timestamp_to_sample_id_batch(struct jls_rd_s * self, uint16_t signal_id,
+        int64_t const * timestamps, int64_t * sample_ids, size_t count);
+
+/**
+ * @brief Read FSR sample data for a UTC time range.
+ *
+ * @param self The reader instance.
+ * @param signal_id The signal id.
+ * @param utc_start The starting JLS timestamp, inclusive.
+ * @param utc_end The ending JLS timestamp, exclusive, at least utc_start.
+ * @param[out] data The caller-provided buffer, in the signal data type,
+ *      with room for data_length_max samples.
+ * @param data_length_max The buffer capacity in samples.
+ * @param[out] start_sample_id The sample id of data[0].
+ * @param[out] data_length The number of samples stored in data, which
+ *      is 0 when the range falls entirely outside the recording and
+ *      is capped at data_length_max for larger ranges.
+ * @return 0 or error code.
+ *
+ * Equivalent to converting utc_start and utc_end with
+ * jls_rd_timestamp_to_sample_id(), clamping to the recorded range, and
+ * calling jls_rd_fsr(), but resolves the time map once inside a single
+ * call.  Report generators that read the same wall-clock window from
+ * many signals avoid repeating the time map resolution and range
+ * bookkeeping per signal.
+ */
+JLS_API int32_t jls_rd_fsr_by_utc(struct jls_rd_s * self, uint16_t signal_id,
+        int64_t utc_start, int64_t utc_end,
+        void * data, int64_t data_length_max,
+        int64_t * start_sample_id, int64_t * data_length);
+
 JLS_CPP_GUARD_END
 
 /** @} */
@@ -127,6 +127,40 @@ JLS_API void jls_statistics_combine(struct jls_statistics_s * tgt,
                                     struct jls_statistics_s const * a,
                                     struct jls_statistics_s const * b);
 
+/**
+ * @brief Combine consecutive equal-weight f32 summary entries.
+ *
+ * @param tgt The accumulated statistics instance, updated in place.
+ * @param entries The summary entries, 4 values per entry in the
+ *      JLS_SUMMARY_FSR_e order: mean, standard deviation, minimum, maximum.
+ * @param count The number of entries.
+ * @param samples_per_entry The number of samples covered by each entry.
+ *
+ * Equivalent to converting each entry and calling jls_statistics_combine()
+ * once per entry, but the equal weights allow a single-pass closed-form
+ * reduction with one combine at the end.  The entry values are read and
+ * compared in their native precision; only the reduction accumulators
+ * and the final output are f64.
+ */
+JLS_API void jls_statistics_combine_summary_f32(struct jls_statistics_s * tgt,
+                                                const float * entries, uint64_t count,
+                                                uint64_t samples_per_entry);
+
+/**
+ * @brief Combine consecutive equal-weight f64 summary entries.
+ *
+ * @param tgt The accumulated statistics instance, updated in place.
+ * @param entries The summary entries, 4 values per entry in the
+ *      JLS_SUMMARY_FSR_e order: mean, standard deviation, minimum, maximum.
+ * @param count The number of entries.
+ * @param samples_per_entry The number of samples covered by each entry.
+ *
+ * @see jls_statistics_combine_summary_f32()
+ */
+JLS_API void jls_statistics_combine_summary_f64(struct jls_statistics_s * tgt,
+                                                const double * entries, uint64_t count,
+                                                uint64_t samples_per_entry);
+
 JLS_CPP_GUARD_END
 
 /** @} */
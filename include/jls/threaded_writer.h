@@ -27,6 +27,7 @@
 #include <stdint.h>
 #include "jls/cmacro.h"
 #include "jls/format.h"
+#include "jls/writer.h"  // jls_wr_fsr_transform_fn
 
 /**
  * @ingroup jls
@@ -94,9 +95,224 @@ JLS_API int32_t jls_twr_flags_set(struct jls_twr_s * self, uint32_t flags);
  *
  * @param self The JLS writer instance from jls_twr_open().
  * @return 0 or error code.
+ *
+ * This call blocks until all queued messages are written and synced,
+ * so it also serves as the durability barrier for checkpoints when
+ * using jls_twr_durability_set().
  */
 JLS_API int32_t jls_twr_flush(struct jls_twr_s * self);
 
+/**
+ * @brief Roll over to the next segment file.
+ *
+ * @param self The JLS writer instance from jls_twr_open().
+ * @param path The JLS file path for the next segment.
+ * @return 0 or error code.
+ *
+ * This function queues the rollover and returns immediately.  The
+ * writer thread opens the next file, copies the source and signal
+ * definitions to it, and only then finalizes the current segment, so
+ * producers keep streaming into the message buffer throughout the
+ * handoff.  Sample ids continue across segments: each segment records
+ * the first sample id it contains as the signal sample_id_offset.
+ * If the next file cannot be opened, the writer thread logs the error
+ * and continues recording into the current segment.  Call
+ * jls_twr_flush() to wait for the handoff to complete.
+ */
+JLS_API int32_t jls_twr_rollover(struct jls_twr_s * self, const char * path);
+
+/**
+ * @brief Configure the group-commit durability policy.
+ *
+ * @param self The JLS writer instance from jls_twr_open().
+ * @param bytes Sync after this many message bytes, or 0 to disable.
+ * @param duration_ms Sync at least every duration_ms milliseconds
+ *      while messages arrive, or 0 to disable.
+ * @return 0 or error code.
+ *
+ * By default, data is only synced by jls_twr_flush() and close, which
+ * risks losing the operating system's write cache on power failure.
+ * This policy makes the writer thread sync periodically, amortizing
+ * the sync cost over many chunks (group commit).  The periodic sync
+ * runs between queued messages, so an idle writer defers the sync
+ * until the next message arrives.
+ */
+JLS_API int32_t jls_twr_durability_set(struct jls_twr_s * self, uint64_t bytes, uint32_t duration_ms);
+
+/**
+ * @brief Configure incremental finalization during idle ring time.
+ *
+ * @param self The JLS writer instance from jls_twr_open().
+ * @param interval_ms Run a finalization pass at most every
+ *      interval_ms milliseconds when the message ring drains,
+ *      or 0 to disable (default).
+ * @return 0 or error code.
+ *
+ * By default, jls_twr_close() performs all deferred work in one
+ * burst: it replays the buffered head-pointer rewrites and flushes
+ * everything the operating system cached, which can take seconds on
+ * a file with many signals.  With finalization enabled, the writer
+ * thread trickles out a bounded batch of head rewrites and a backend
+ * flush each time the ring goes idle, so close performs only the
+ * fraction accumulated since the last pass.  The trailing summary
+ * and directory chunks still write at close, as the format requires.
+ */
+JLS_API int32_t jls_twr_finalize_set(struct jls_twr_s * self, uint32_t interval_ms);
+
+/**
+ * @brief Configure the message buffer overflow chain for burst absorption.
+ *
+ * @param self The JLS writer instance from jls_twr_open().
+ * @param bytes_max The maximum additional heap bytes for overflow
+ *      segments, or 0 to disable (default).
+ * @return 0 or error code.
+ *
+ * By default, the message buffer size is fixed: when a device delivers
+ * a sustained burst faster than the writer thread can drain, producers
+ * block (or drop with JLS_TWR_FLAG_DROP_ON_OVERFLOW).  With the
+ * overflow chain enabled, the writer instead appends temporary heap
+ * segments up to bytes_max, and only blocks or drops once they are
+ * also full.  The segments are freed as the writer thread catches up.
+ */
+JLS_API int32_t jls_twr_overflow_set(struct jls_twr_s * self, uint64_t bytes_max);
+
+/**
+ * @brief Emit periodic recovery checkpoint chunks.
+ *
+ * @param self The JLS writer instance from jls_twr_open().
+ * @param bytes Checkpoint every this many appended file bytes,
+ *      0 to disable (default).
+ * @return 0 or error code.
+ *
+ * See jls_wr_checkpoint_interval().
+ */
+JLS_API int32_t jls_twr_checkpoint_interval(struct jls_twr_s * self, uint64_t bytes);
+
+/// Opaque shared I/O scheduler, see jls_twr_sched_open().
+struct jls_twr_sched_s;
+
+/**
+ * @brief Open a shared I/O scheduler for multiple writer instances.
+ *
+ * @param[out] instance The scheduler instance.
+ * @return 0 or error code.
+ *
+ * Each writer thread normally writes whenever its message buffer has
+ * data.  When many writer instances record to the same disk, their
+ * chunk-sized writes interleave and the disk seeks between files.  A
+ * scheduler serializes the writer threads: each joined writer drains
+ * its queued messages as one sequential burst while holding the
+ * scheduler, so the disk sees large per-file runs instead of
+ * interleaved chunks.  A writer releases the scheduler when its
+ * message buffer empties or after draining a bounded burst, so one
+ * busy writer cannot starve the others.
+ *
+ * Call jls_twr_sched_close() when done, after closing all joined
+ * writers.
+ */
+JLS_API int32_t jls_twr_sched_open(struct jls_twr_sched_s ** instance);
+
+/**
+ * @brief Close a shared I/O scheduler.
+ *
+ * @param self The scheduler instance from jls_twr_sched_open().
+ * @return 0 or error code.
+ *
+ * All joined writers must be closed or detached first.
+ */
+JLS_API int32_t jls_twr_sched_close(struct jls_twr_sched_s * self);
+
+/**
+ * @brief Join a writer instance to a shared I/O scheduler.
+ *
+ * @param self The JLS writer instance from jls_twr_open().
+ * @param sched The scheduler instance from jls_twr_sched_open(),
+ *      or NULL to detach.
+ * @return 0 or error code.
+ *
+ * May be called at any time; it takes effect at the writer thread's
+ * next burst.  Producers are unaffected: they enqueue into the
+ * per-writer message buffer as usual, and only the writer threads
+ * take turns at the disk.
+ */
+JLS_API int32_t jls_twr_sched_join(struct jls_twr_s * self, struct jls_twr_sched_s * sched);
+
+/// The threaded writer performance counters, see jls_twr_counters().
+struct jls_twr_counters_s {
+    uint64_t seeks;          ///< File repositioning operations that changed the position.
+    uint64_t bytes_written;  ///< Bytes written to the file.
+    uint64_t chunks;         ///< Chunks written to the file.
+    uint64_t msg_bytes_max;  ///< The message ring buffer high-water mark in bytes.
+};
+
+/// The number of jls_twr_latency_s histogram buckets.
+#define JLS_TWR_LATENCY_BUCKET_COUNT (32)
+
+/**
+ * @brief The write-path latency histograms, see jls_twr_latency_get().
+ *
+ * Bucket 0 counts durations under 1 microsecond.  Bucket i counts
+ * durations in [2^(i-1), 2^i) microseconds, so bucket 11 covers
+ * roughly 1 to 2 milliseconds.  The last bucket also counts anything
+ * longer than its lower bound.
+ */
+struct jls_twr_latency_s {
+    /// Writer-thread service time per message.
+    uint64_t service[JLS_TWR_LATENCY_BUCKET_COUNT];
+    /// Producer enqueue time per call, including any ring-full blocking.
+    uint64_t enqueue[JLS_TWR_LATENCY_BUCKET_COUNT];
+    /// Ring buffer dwell time per message, from commit to service start.
+    uint64_t dwell[JLS_TWR_LATENCY_BUCKET_COUNT];
+    /// Cumulative file write time in microseconds, see jls_bk_fwrite().
+    uint64_t write_duration_us;
+    /// Cumulative file sync time in microseconds, see jls_bk_fflush().
+    uint64_t flush_duration_us;
+};
+
+/**
+ * @brief Get the write-path latency histograms for this handle.
+ *
+ * @param self The JLS writer instance from jls_twr_open().
+ * @param[out] latency The histogram counts since open.
+ * @return 0 or error code.
+ *
+ * The histograms are always on: recording is a fixed-bucket atomic
+ * increment per message, cheap enough for production.  Growth in the
+ * upper service buckets indicates slow storage or summary generation;
+ * growth in the upper enqueue buckets indicates producers blocking on
+ * a full message buffer; growth in the upper dwell buckets indicates
+ * the writer thread falling behind the producers.  When service time
+ * is high, compare write_duration_us and flush_duration_us against
+ * wall time to separate the disk from the summary computation.
+ */
+JLS_API int32_t jls_twr_latency_get(struct jls_twr_s * self, struct jls_twr_latency_s * latency);
+
+/**
+ * @brief Get the cumulative performance counters for this handle.
+ *
+ * @param self The JLS writer instance from jls_twr_open().
+ * @param[out] counters The counter values since open.
+ * @return 0 or error code.
+ *
+ * A high seek rate relative to chunks indicates frequent head-pointer
+ * rewrites.  A ring buffer high-water mark near the buffer size
+ * indicates the writer thread cannot keep up with the producers.
+ */
+JLS_API int32_t jls_twr_counters(struct jls_twr_s * self, struct jls_twr_counters_s * counters);
+
+/**
+ * @brief Also emit a summary-only mirror file during capture.
+ *
+ * @param self The JLS writer instance.
+ * @param path The mirror JLS file path.
+ * @return 0 or error code.
+ *
+ * See jls_wr_mirror_open().  Call before writing sample data, like
+ * the definitions.  Segments created by jls_twr_rollover() do not
+ * inherit the mirror.
+ */
+JLS_API int32_t jls_twr_mirror_open(struct jls_twr_s * self, const char * path);
+
 /**
  * @brief Define a new source.
  *
@@ -148,6 +364,63 @@ JLS_API int32_t jls_twr_user_data(struct jls_twr_s * self, uint16_t chunk_meta,
 JLS_API int32_t jls_twr_fsr(struct jls_twr_s * self, uint16_t signal_id,
                             int64_t sample_id, const void * data, uint32_t data_length);
 
+/// One sample data block for jls_twr_fsr_multi().
+struct jls_twr_fsr_block_s {
+    uint16_t signal_id;     ///< The signal id.
+    int64_t sample_id;      ///< The sample id for data[0].
+    const void * data;      ///< The packed sample data, see jls_twr_fsr().
+    uint32_t data_length;   ///< The length of data in samples.
+};
+
+/**
+ * @brief Write multiple fixed-rate sample data blocks in one batch.
+ *
+ * @param self The JLS writer instance.
+ * @param blocks The sample data blocks, which may target different signals.
+ * @param count The number of blocks.
+ * @return 0 or error code.
+ *
+ * Equivalent to calling jls_twr_fsr() for each block in order, but the
+ * batch takes the producer lock once and wakes the writer thread once,
+ * which reduces overhead for sources that deliver many signals per
+ * hardware frame.  On error, blocks already enqueued are still written.
+ */
+JLS_API int32_t jls_twr_fsr_multi(struct jls_twr_s * self,
+                                  const struct jls_twr_fsr_block_s * blocks, uint32_t count);
+
+/**
+ * @brief Reserve sample data space directly in the writer queue.
+ *
+ * @param self The JLS writer instance.
+ * @param signal_id The signal id.
+ * @param sample_count The number of samples to reserve.
+ * @param[out] buffer The buffer to fill with sample data.
+ * @return 0, JLS_ERROR_BUSY when the queue is full, or
+ *      JLS_ERROR_SEQUENCE when a reservation is already outstanding.
+ *
+ * Unlike jls_twr_fsr(), which copies the caller's samples into the
+ * queue, this reserves queue space for the caller (or a DMA engine)
+ * to fill in place.  Complete the write with jls_twr_fsr_commit().
+ * Only one reservation may be outstanding, and all other jls_twr_*()
+ * message calls return JLS_ERROR_BUSY until it commits, so commit
+ * promptly.
+ */
+JLS_API int32_t jls_twr_fsr_reserve(struct jls_twr_s * self, uint16_t signal_id,
+                                    uint32_t sample_count, void ** buffer);
+
+/**
+ * @brief Commit sample data reserved with jls_twr_fsr_reserve().
+ *
+ * @param self The JLS writer instance.
+ * @param signal_id The signal id.
+ * @param sample_id The sample id for the first sample in the buffer.
+ * @param sample_count The number of valid samples, which may be less
+ *      than reserved.  0 discards the reservation.
+ * @return 0 or error code.
+ */
+JLS_API int32_t jls_twr_fsr_commit(struct jls_twr_s * self, uint16_t signal_id,
+                                   int64_t sample_id, uint32_t sample_count);
+
 /**
  * @brief Write sample data to a float32 FSR signal.
  *
@@ -180,6 +453,82 @@ JLS_API int32_t jls_twr_fsr_f32(struct jls_twr_s * self, uint16_t signal_id,
  */
 JLS_API int32_t jls_twr_fsr_omit_data(struct jls_twr_s * self, uint16_t signal_id, uint32_t enable);
 
+/**
+ * @brief Scale incoming samples on the writer thread.
+ *
+ * @param self The writer instance.
+ * @param signal_id The signal id, which must use a floating-point
+ *      data type.
+ * @param gain The multiplier applied to each incoming sample.
+ * @param offset The offset added after the gain.
+ * @return 0 or error code.
+ *
+ * See jls_wr_fsr_scale().  The scaling is queued behind any pending
+ * sample data for the signal and applies to samples written after it,
+ * blockwise on the writer thread rather than in the producer.
+ */
+JLS_API int32_t jls_twr_fsr_scale(struct jls_twr_s * self, uint16_t signal_id,
+                                  double gain, double offset);
+
+/**
+ * @brief Transform incoming samples on the writer thread.
+ *
+ * @param self The writer instance.
+ * @param signal_id The signal id.
+ * @param fn The transform applied to each sample block before it is
+ *      written, or NULL to disable.  fn runs on the writer thread.
+ * @param user_data The arbitrary data for fn.
+ * @return 0 or error code.
+ *
+ * See jls_wr_fsr_transform().
+ */
+JLS_API int32_t jls_twr_fsr_transform(struct jls_twr_s * self, uint16_t signal_id,
+                                      jls_wr_fsr_transform_fn fn, void * user_data);
+
+/**
+ * @brief Configure periodic summary preview chunks for one level.
+ *
+ * @param self The JLS threaded writer instance.
+ * @param signal_id The signal id.
+ * @param level The summary level, 1 to JLS_SUMMARY_LEVEL_COUNT - 1.
+ * @param interval_ms The minimum milliseconds between preview chunks,
+ *      0 (default) to disable.
+ * @return 0 or error code.
+ *
+ * Summary levels normally reach the file only when their buffers fill
+ * or the file closes.  With a watermark, the writer thread periodically
+ * snapshots the completed-but-buffered entries into
+ * JLS_TAG_SUMMARY_PREVIEW chunks, so follow-mode readers can render
+ * the trailing window from summaries instead of level 0 data.
+ * @see jls_wr_fsr_summary_watermark(), jls_rd_fsr_summary_preview().
+ */
+JLS_API int32_t jls_twr_fsr_summary_watermark(struct jls_twr_s * self, uint16_t signal_id,
+                                              uint8_t level, uint32_t interval_ms);
+
+/**
+ * @brief Release an idle signal's write buffers until its next samples.
+ *
+ * @param self The writer instance.
+ * @param signal_id The signal id.
+ * @return 0 or error code.
+ *
+ * See jls_wr_fsr_suspend().  The suspend is queued behind any pending
+ * sample data for the signal; writing further samples resumes the
+ * signal implicitly, or call jls_twr_signal_resume().
+ */
+JLS_API int32_t jls_twr_signal_suspend(struct jls_twr_s * self, uint16_t signal_id);
+
+/**
+ * @brief Reallocate a suspended signal's write buffers.
+ *
+ * @param self The writer instance.
+ * @param signal_id The signal id.
+ * @return 0 or error code.
+ *
+ * See jls_twr_signal_suspend().
+ */
+JLS_API int32_t jls_twr_signal_resume(struct jls_twr_s * self, uint16_t signal_id);
+
 /**
  * @brief Add an annotation to a signal.
  *
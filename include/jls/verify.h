@@ -0,0 +1,123 @@
+/*
+ * Copyright 2023 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief JLS whole-file integrity verification.
+ */
+
+#ifndef JLS_VERIFY_H__
+#define JLS_VERIFY_H__
+
+#include <stdint.h>
+#include "jls/cmacro.h"
+
+/**
+ * @ingroup jls
+ * @defgroup jls_verify Verify
+ *
+ * @brief Verify the integrity of a JLS file.
+ *
+ * @{
+ */
+
+JLS_CPP_GUARD_START
+
+/// The maximum number of concurrent CRC verification threads.
+#define JLS_VERIFY_THREADS_MAX (8)
+
+/**
+ * @brief The function called for each verification failure.
+ *
+ * @param user_data The arbitrary user data provided to jls_verify().
+ * @param offset The failing chunk's file offset.
+ * @param tag The failing chunk's jls_tag_e tag.
+ * @param error The error code: JLS_ERROR_MESSAGE_INTEGRITY for a
+ *      payload CRC mismatch or JLS_ERROR_NOT_FOUND for a head-pointer
+ *      link that does not target a valid chunk.
+ */
+typedef void (*jls_verify_fn)(void * user_data, int64_t offset, uint8_t tag, int32_t error);
+
+/**
+ * @brief Verify every chunk in a JLS file.
+ *
+ * @param path The JLS file path.
+ * @param threads The number of concurrent CRC verification threads,
+ *      clamped to JLS_VERIFY_THREADS_MAX.  0 for the default.
+ * @param fn The function to call for each failure, or NULL.
+ * @param user_data The arbitrary data for fn.
+ * @return 0 when the file is intact, JLS_ERROR_MESSAGE_INTEGRITY when
+ *      any check failed, or another error code.
+ *
+ * The verification runs in two phases.  First, the file is
+ * partitioned into byte ranges and each thread CRC-checks every
+ * chunk header and payload in its range.  Second, a single pass
+ * cross-checks the doubly-linked chunk lists: every item_next and
+ * item_prev must target a valid chunk offset.
+ *
+ * Partition boundaries rarely align with chunk boundaries, so each
+ * thread scans forward for the first valid chunk header at or after
+ * its range start, the same recovery used by jls_repair().
+ */
+JLS_API int32_t jls_verify(const char * path, uint32_t threads,
+                           jls_verify_fn fn, void * user_data);
+
+/// One chunk identity entry, see jls_manifest().
+struct jls_manifest_entry_s {
+    int64_t offset;           ///< The chunk file offset.
+    int64_t length;           ///< The chunk bytes: header, payload, pad, and CRC.
+    uint32_t hdr_crc32c;      ///< The stored chunk header CRC32C.
+    uint32_t payload_crc32c;  ///< The stored payload CRC32C, 0 for empty payloads.
+    uint8_t tag;              ///< The jls_tag_e chunk type.
+};
+
+/**
+ * @brief The function called for each batch of manifest entries.
+ *
+ * @param user_data The arbitrary user data provided to jls_manifest().
+ * @param entries The manifest entries, in ascending offset order,
+ *      valid only for the duration of the callback.
+ * @param count The number of entries in this batch.
+ * @return 0 to continue or any other value to abort.
+ */
+typedef int32_t (*jls_manifest_fn)(void * user_data,
+        const struct jls_manifest_entry_s * entries, uint32_t count);
+
+/**
+ * @brief Emit the chunk identity map of a JLS file.
+ *
+ * @param path The JLS file path.
+ * @param fn The function to call for each batch of entries.
+ * @param user_data The arbitrary data for fn.
+ * @return 0, JLS_ERROR_ABORTED when fn returned nonzero, or error code.
+ *
+ * The manifest reports the CRCs already stored in the file, so the
+ * scan reads only chunk headers and the 4-byte trailing CRC of each
+ * chunk, never the payloads.  A differential sync agent can diff two
+ * manifests to upload only the chunks that changed: for append-mostly
+ * files that is the new chunks plus the rewritten headers whose chain
+ * pointers now target them, which the header CRC exposes without
+ * byte comparison.  The scan stops at the first invalid chunk, as for
+ * an unclosed recording; the remainder has no stable identity yet.
+ */
+JLS_API int32_t jls_manifest(const char * path, jls_manifest_fn fn, void * user_data);
+
+JLS_CPP_GUARD_END
+
+/** @} */
+
+#endif  /* JLS_VERIFY_H__ */
@@ -69,6 +69,42 @@ JLS_API int32_t jls_wr_close(struct jls_wr_s * self);
  */
 JLS_API int32_t jls_wr_flush(struct jls_wr_s * self);
 
+/**
+ * @brief Emit periodic recovery checkpoint chunks.
+ *
+ * @param self The JLS writer instance from jls_wr_open().
+ * @param bytes Checkpoint every this many appended file bytes,
+ *      0 to disable (default).
+ * @return 0 or error code.
+ *
+ * Each checkpoint snapshots the in-memory track head state and
+ * per-signal sample ids, see JLS_TAG_CHECKPOINT.  After a crash,
+ * repair loads the most recent checkpoint and replays only the chunks
+ * written after it, so the recovery time is bounded by this interval
+ * instead of the file size.  This pairs with the JLS_APPEND_ONLY
+ * deferred head updates: the stream stays append-only while the
+ * checkpoints record the head state that has not been written back.
+ */
+JLS_API int32_t jls_wr_checkpoint_interval(struct jls_wr_s * self, uint64_t bytes);
+
+/**
+ * @brief Enable wall-clock persist time recording for data chunks.
+ *
+ * @param self The JLS writer instance.
+ * @param enable 1 to record, 0 to disable (default).
+ * @return 0 or error code.
+ *
+ * When enabled, the writer records the jls_now() wall-clock time each
+ * FSR data chunk write is issued and stores the (offset, time) pairs
+ * in JLS_TAG_CHUNK_CLOCK chunks, written mid-stream in batches plus a
+ * trailing chunk at close.  A post-run tool reads them back with
+ * jls_rd_chunk_clock() to reconstruct when each chunk persisted and
+ * quantify buffering delay, such as for persistence SLO audits.  The
+ * chunks are never linked or indexed: readers unaware of the tag skip
+ * them, and the overhead is 16 bytes per data chunk.
+ */
+JLS_API int32_t jls_wr_chunk_clock_en(struct jls_wr_s * self, uint8_t enable);
+
 /**
  * @brief Define a new source.
  *
@@ -133,6 +169,117 @@ JLS_API int32_t jls_wr_fsr(struct jls_wr_s * self, uint16_t signal_id,
 JLS_API int32_t jls_wr_fsr_f32(struct jls_wr_s * self, uint16_t signal_id,
         int64_t sample_id, const float * data, uint32_t data_length);
 
+/**
+ * @brief Write sample data to a float64 FSR signal.
+ *
+ * @param self The JLS writer instance.
+ * @param signal_id The signal id.
+ * @param sample_id The sample id for data[0].
+ * @param data The sample data array.
+ * @param data_length The length of data in doubles (bytes / 8).
+ * @return 0 or error code
+ */
+JLS_API int32_t jls_wr_fsr_f64(struct jls_wr_s * self, uint16_t signal_id,
+        int64_t sample_id, const double * data, uint32_t data_length);
+
+/**
+ * @brief Scale incoming samples on the write path.
+ *
+ * @param self The JLS writer instance.
+ * @param signal_id The signal id, which must use a floating-point
+ *      data type.
+ * @param gain The multiplier applied to each incoming sample.
+ * @param offset The offset added after the gain.
+ * @return 0 or error code.
+ *
+ * Each subsequent jls_wr_fsr() or jls_wr_fsr_f32() call stores
+ * sample * gain + offset instead of the caller's raw values, computed
+ * blockwise in a staging buffer so producers can feed raw ADC counts
+ * without a separate calibration pass.  Pass gain 1.0 and offset 0.0
+ * to disable.  With the threaded writer, the scaling runs on the
+ * writer thread.
+ */
+JLS_API int32_t jls_wr_fsr_scale(struct jls_wr_s * self, uint16_t signal_id,
+                                 double gain, double offset);
+
+/**
+ * @brief The sample block transform for jls_wr_fsr_transform().
+ *
+ * @param user_data The arbitrary user data.
+ * @param signal_id The signal id.
+ * @param sample_id The sample id for data[0].
+ * @param data The packed sample block to modify in place.
+ * @param data_length The length of data in samples.
+ * @return 0 to continue or any other value to fail the write.
+ */
+typedef int32_t (*jls_wr_fsr_transform_fn)(void * user_data, uint16_t signal_id,
+        int64_t sample_id, void * data, uint32_t data_length);
+
+/**
+ * @brief Transform incoming samples on the write path.
+ *
+ * @param self The JLS writer instance.
+ * @param signal_id The signal id.
+ * @param fn The transform applied to each sample block before it is
+ *      written, or NULL to disable.
+ * @param user_data The arbitrary data for fn.
+ * @return 0 or error code.
+ *
+ * The transform receives a private copy of each incoming block, so
+ * the caller's buffer is never modified.  When combined with
+ * jls_wr_fsr_scale(), the scale applies first.  With the threaded
+ * writer, fn runs on the writer thread, off the producer's critical
+ * path.
+ */
+JLS_API int32_t jls_wr_fsr_transform(struct jls_wr_s * self, uint16_t signal_id,
+                                     jls_wr_fsr_transform_fn fn, void * user_data);
+
+/**
+ * @brief Write a summary preview chunk for one signal and level now.
+ *
+ * @param self The JLS writer instance.
+ * @param signal_id The signal id.
+ * @param level The summary level, 1 to JLS_SUMMARY_LEVEL_COUNT - 1.
+ * @return 0 or error code.
+ *
+ * Summary levels normally reach the file only when their buffers fill
+ * or the file closes, so live followers miss up to entries_per_summary
+ * entries per level.  A preview snapshots the completed entries still
+ * buffered for the level into a JLS_TAG_SUMMARY_PREVIEW chunk.  The
+ * chunk is never linked or indexed, so readers of closed files skip it;
+ * follow-mode readers surface the most recent preview through
+ * jls_rd_fsr_summary_preview().  Does nothing when no entries
+ * completed since the last preview or summary flush.
+ */
+JLS_API int32_t jls_wr_fsr_summary_preview(struct jls_wr_s * self, uint16_t signal_id, uint8_t level);
+
+/**
+ * @brief Configure periodic summary preview chunks for one level.
+ *
+ * @param self The JLS writer instance.
+ * @param signal_id The signal id.
+ * @param level The summary level, 1 to JLS_SUMMARY_LEVEL_COUNT - 1.
+ * @param interval_ms The minimum milliseconds between preview chunks,
+ *      0 (default) to disable.
+ * @return 0 or error code.
+ *
+ * Call jls_wr_fsr_summary_preview_process() periodically to write the
+ * due previews.  The threaded writer does this automatically, see
+ * jls_twr_fsr_summary_watermark().
+ */
+JLS_API int32_t jls_wr_fsr_summary_watermark(struct jls_wr_s * self, uint16_t signal_id,
+                                             uint8_t level, uint32_t interval_ms);
+
+/**
+ * @brief Write any summary preview chunks whose watermark is due.
+ *
+ * @param self The JLS writer instance.
+ * @return 0 or error code.
+ *
+ * @see jls_wr_fsr_summary_watermark()
+ */
+JLS_API int32_t jls_wr_fsr_summary_preview_process(struct jls_wr_s * self);
+
 /**
  * @brief Omit level 0 data chunks from the signal's stream.
  *
@@ -148,6 +295,106 @@ JLS_API int32_t jls_wr_fsr_f32(struct jls_wr_s * self, uint16_t signal_id,
  */
 JLS_API int32_t jls_wr_fsr_omit_data(struct jls_wr_s * self, uint16_t signal_id, uint32_t enable);
 
+/**
+ * @brief Release an idle signal's write buffers until its next samples.
+ *
+ * @param self The JLS writer instance.
+ * @param signal_id The signal id.
+ * @return 0 or error code.
+ *
+ * The per-signal sample staging and summary level buffers dominate
+ * writer memory when many configured signals are idle, such as
+ * power-gated channels.  Suspend copies the partial summary state into
+ * a compact snapshot and releases the full-size buffers; nothing is
+ * written to the file and the recorded data is unchanged.
+ * jls_wr_fsr_resume(), or the next jls_wr_fsr() call for the signal,
+ * reallocates the buffers and restores the snapshot, so suspend and
+ * resume may repeat freely at any sample position.
+ */
+JLS_API int32_t jls_wr_fsr_suspend(struct jls_wr_s * self, uint16_t signal_id);
+
+/**
+ * @brief Reallocate a suspended signal's write buffers.
+ *
+ * @param self The JLS writer instance.
+ * @param signal_id The signal id.
+ * @return 0 or error code.
+ *
+ * Optional: writing samples to a suspended signal resumes implicitly.
+ * See jls_wr_fsr_suspend().
+ */
+JLS_API int32_t jls_wr_fsr_resume(struct jls_wr_s * self, uint16_t signal_id);
+
+/**
+ * @brief Retain only the most recent samples at full rate (ring mode).
+ *
+ * @param self The JLS writer instance.
+ * @param signal_id The signal id.
+ * @param sample_count The approximate number of recent samples to retain
+ *      at full rate, 0 to disable (default).
+ * @return 0 or error code.
+ *
+ * In ring mode, the writer recycles the oldest level 0 data chunk slots
+ * in place once sample_count samples are on disk, which bounds the
+ * level 0 file growth for arbitrarily long recordings.  The summaries
+ * are always retained, so the overwritten history remains readable at
+ * the summary rates, and jls_rd_fsr_f32() reconstructs overwritten
+ * sample data from the summaries like omitted data.  See
+ * jls_wr_fsr_omit_data().
+ *
+ * Call after jls_wr_signal_def().  The retention rounds up to whole
+ * data chunks, at least one full summary block.  Ring mode requires
+ * fixed-size data chunks and returns JLS_ERROR_NOT_SUPPORTED when
+ * JLS_COMPRESSION is enabled or the signal uses delta encoding.
+ */
+JLS_API int32_t jls_wr_fsr_ring(struct jls_wr_s * self, uint16_t signal_id, int64_t sample_count);
+
+/**
+ * @brief Provide precomputed level 1 summary entries for upcoming samples.
+ *
+ * @param self The JLS writer instance.
+ * @param signal_id The signal id.
+ * @param entries The summary entries, each entry_count entries of
+ *      [mean, standard deviation, minimum, maximum], matching the
+ *      jls_rd_fsr_statistics() output with
+ *      increment = sample_decimate_factor.  NULL to clear.
+ * @param entry_count The number of entries, 0 to clear.
+ * @return 0 or error code.
+ *
+ * Each entry covers sample_decimate_factor samples, starting at the
+ * signal's next level 1 summary boundary.  The writer consumes the
+ * entries in order instead of recomputing the statistics from the
+ * sample data, which jls_rd_extract() uses to reuse existing summaries
+ * when copying sample windows.  When the entries are exhausted or a
+ * block is not fully covered, the writer computes normally.  The
+ * higher summary levels always derive from level 1.
+ */
+JLS_API int32_t jls_wr_fsr_summary_inject(struct jls_wr_s * self, uint16_t signal_id,
+                                          const double * entries, uint32_t entry_count);
+
+/**
+ * @brief Also emit a summary-only mirror file during capture.
+ *
+ * @param self The JLS writer instance.
+ * @param path The mirror JLS file path.
+ * @return 0 or error code.
+ *
+ * The mirror receives every source and signal definition and the FSR
+ * sample stream, but omits the level 0 data chunks like
+ * jls_wr_fsr_omit_data(), so it stays roughly sample_decimate_factor
+ * times smaller than the primary file.  The summary statistics are
+ * computed once for the primary and reused for the mirror through
+ * jls_wr_fsr_summary_inject().  Use the mirror as a preview that can
+ * upload or render while the capture continues, without re-reading
+ * the primary file.
+ *
+ * Call after jls_wr_open() and before writing sample data.
+ * Definitions made before this call replay to the mirror.
+ * Annotations, UTC entries, and user data are not mirrored.
+ * jls_wr_close() closes the mirror with the primary file.
+ */
+JLS_API int32_t jls_wr_mirror_open(struct jls_wr_s * self, const char * path);
+
 /**
  * @brief Add an annotation to a signal.
  *
@@ -173,6 +420,47 @@ JLS_API int32_t jls_wr_annotation(struct jls_wr_s * self,
                                   const uint8_t * data,
                                   uint32_t data_size);
 
+/**
+ * @brief Queue an annotation for a coalesced write.
+ *
+ * @param self The writer instance.
+ * @param signal_id The signal id.
+ * @param timestamp The x-axis timestamp in sample_id for FSR and UTC for VSR.
+ * @param y The y-axis value or NAN to automatically position.
+ * @param annotation_type The annotation type.
+ * @param group_id The optional group identifier.  If unused, set to 0.
+ * @param storage_type The storage type.
+ * @param data The data for the annotation.
+ * @param data_size The length of data for JLS_STORAGE_TYPE_BINARY storage_type.
+ *      Set to 0 for all other storage types.
+ * @return 0 or error code.
+ *
+ * Unlike jls_wr_annotation(), which emits one chunk per call, queued
+ * annotations share a single DATA chunk.  Each queued annotation still
+ * gets its own index and summary entry, so reads are unaffected.
+ * The pending chunk is written by jls_wr_annotation_commit() and
+ * automatically when the batch reaches capacity, when an annotation
+ * for a different signal arrives, and on jls_wr_flush() and
+ * jls_wr_close().
+ */
+JLS_API int32_t jls_wr_annotation_append(struct jls_wr_s * self,
+                                         uint16_t signal_id,
+                                         int64_t timestamp,
+                                         float y,
+                                         enum jls_annotation_type_e annotation_type,
+                                         uint8_t group_id,
+                                         enum jls_storage_type_e storage_type,
+                                         const uint8_t * data,
+                                         uint32_t data_size);
+
+/**
+ * @brief Write any annotations queued by jls_wr_annotation_append().
+ *
+ * @param self The writer instance.
+ * @return 0 or error code.
+ */
+JLS_API int32_t jls_wr_annotation_commit(struct jls_wr_s * self);
+
 /**
  * @brief Add a mapping from sample_id to UTC timestamp for an FSR signal.
  *
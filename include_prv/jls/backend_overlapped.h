@@ -0,0 +1,110 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief JLS OVERLAPPED write queue, Windows only.
+ */
+
+#ifndef JLS_BACKEND_OVERLAPPED_H__
+#define JLS_BACKEND_OVERLAPPED_H__
+
+#include "jls/cmacro.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @ingroup jls
+ * @defgroup jls_backend_overlapped OVERLAPPED write queue
+ *
+ * @brief Asynchronous write queue using Windows OVERLAPPED I/O.
+ *
+ * The Windows counterpart to the Linux io_uring write queue: instead
+ * of blocking the writer thread in synchronous WriteFile calls, writes
+ * queue on a separate FILE_FLAG_OVERLAPPED handle to the same file and
+ * complete in the background, so short storage stalls are absorbed by
+ * queue depth.  The handle optionally adds FILE_FLAG_NO_BUFFERING to
+ * bypass the system cache, which requires 4096-byte aligned offsets
+ * and lengths; unaligned writes then return JLS_ERROR_NOT_SUPPORTED
+ * so the caller can fall back to the buffered synchronous path.
+ *
+ * @{
+ */
+
+JLS_CPP_GUARD_START
+
+/// The opaque OVERLAPPED write queue object.
+struct jls_winol_s;
+
+/**
+ * @brief Create an OVERLAPPED write queue for a file.
+ *
+ * @param[out] instance The new write queue instance.
+ * @param filename The wide-character path of the already-open file.
+ * @param no_buffering When true, also bypass the system cache with
+ *      FILE_FLAG_NO_BUFFERING.
+ * @return 0, JLS_ERROR_NOT_SUPPORTED when the file cannot be opened
+ *      for overlapped access, or error code.
+ *
+ * The queue opens its own write handle, so the file must be opened
+ * with write sharing allowed.
+ */
+int32_t jls_winol_open(struct jls_winol_s ** instance, const wchar_t * filename, bool no_buffering);
+
+/**
+ * @brief Queue a write.
+ *
+ * @param self The write queue instance.
+ * @param offset The file offset for the write.
+ * @param buffer The data to write, which is copied.
+ * @param count The number of bytes to write.
+ * @param ordered When true, complete all previously queued writes
+ *      first.  Required when rewriting a region that an earlier
+ *      queued write may still target.
+ * @return 0, JLS_ERROR_NOT_SUPPORTED when no_buffering is enabled
+ *      and offset or count is not 4096-byte aligned, or error code
+ *      including errors deferred from previously queued writes.
+ *
+ * This function only blocks when the queue is full.
+ */
+int32_t jls_winol_fwrite(struct jls_winol_s * self, int64_t offset,
+                         const void * buffer, uint32_t count, bool ordered);
+
+/**
+ * @brief Wait for all queued writes to complete.
+ *
+ * @param self The write queue instance.
+ * @return 0 or error code, including deferred write errors.
+ *
+ * Call before any operation that must observe the queued writes,
+ * such as reads, flush, and truncate.
+ */
+int32_t jls_winol_drain(struct jls_winol_s * self);
+
+/**
+ * @brief Drain the queue and free all resources.
+ *
+ * @param self The write queue instance.
+ * @return 0 or error code, including deferred write errors.
+ */
+int32_t jls_winol_close(struct jls_winol_s * self);
+
+JLS_CPP_GUARD_END
+
+/** @} */
+
+#endif  /* JLS_BACKEND_OVERLAPPED_H__ */
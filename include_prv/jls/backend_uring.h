@@ -0,0 +1,101 @@
+/*
+ * Copyright 2021-2023 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief JLS io_uring write queue, Linux only.
+ */
+
+#ifndef JLS_BACKEND_URING_H__
+#define JLS_BACKEND_URING_H__
+
+#include "jls/cmacro.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @ingroup jls
+ * @defgroup jls_backend_uring io_uring write queue
+ *
+ * @brief Asynchronous write queue using Linux io_uring.
+ *
+ * Synchronous write() calls block the writer thread during device
+ * flush storms, which backs up the threaded writer message ring
+ * buffer and forces sample drops.  This queue submits writes
+ * asynchronously and batches completion handling so short storage
+ * stalls are absorbed by queue depth instead of blocking the caller.
+ *
+ * @{
+ */
+
+JLS_CPP_GUARD_START
+
+/// The opaque io_uring write queue object.
+struct jls_uring_s;
+
+/**
+ * @brief Create an io_uring write queue for a file.
+ *
+ * @param[out] instance The new write queue instance.
+ * @param fd The open file descriptor for all queued writes.
+ * @return 0, JLS_ERROR_NOT_SUPPORTED when the kernel does not
+ *      provide io_uring, or error code.
+ */
+int32_t jls_uring_open(struct jls_uring_s ** instance, int fd);
+
+/**
+ * @brief Queue a write.
+ *
+ * @param self The write queue instance.
+ * @param offset The file offset for the write.
+ * @param buffer The data to write, which is copied.
+ * @param count The number of bytes to write.
+ * @param ordered When true, order this write after all previously
+ *      queued writes.  Required when rewriting a region that an
+ *      earlier queued write may still target.
+ * @return 0 or error code, including errors deferred from
+ *      previously queued writes.
+ *
+ * This function only blocks when the queue is full.
+ */
+int32_t jls_uring_fwrite(struct jls_uring_s * self, int64_t offset,
+                         const void * buffer, uint32_t count, bool ordered);
+
+/**
+ * @brief Wait for all queued writes to complete.
+ *
+ * @param self The write queue instance.
+ * @return 0 or error code, including deferred write errors.
+ *
+ * Call before any operation that must observe the queued writes,
+ * such as reads, flush, and truncate.
+ */
+int32_t jls_uring_drain(struct jls_uring_s * self);
+
+/**
+ * @brief Drain the queue and free all resources.
+ *
+ * @param self The write queue instance.
+ * @return 0 or error code, including deferred write errors.
+ */
+int32_t jls_uring_close(struct jls_uring_s * self);
+
+JLS_CPP_GUARD_END
+
+/** @} */
+
+#endif  /* JLS_BACKEND_URING_H__ */
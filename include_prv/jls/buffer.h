@@ -52,20 +52,46 @@ struct jls_buf_strings_s {
     char buffer[JLS_BUF_STRING_SIZE];    ///< Buffer for 0-terminated strings.
 };
 
+/**
+ * @brief A string intern table entry.
+ */
+struct jls_buf_intern_s {
+    uint64_t hash;                       ///< The string's xxh64 hash.
+    char * cstr;                         ///< The interned string, or NULL when empty.
+};
+
 struct jls_buf_s {
     uint8_t * start;
     uint8_t * cur;
     uint8_t * end;      // current end
     size_t length;      // current length
     size_t alloc_size;  // end - start
+    size_t alloc_max;   // maximum allowed alloc_size, 0 for unlimited
     struct jls_buf_strings_s * strings_head;
     struct jls_buf_strings_s * strings_tail;
+    struct jls_buf_intern_s * intern;    // open-addressing intern table, power-of-two size
+    size_t intern_alloc;                 // table entries allocated
+    size_t intern_count;                 // table entries used
 };
 
+/**
+ * @brief Allocate a buffer instance.
+ *
+ * @return The buffer instance or NULL.
+ *
+ * Freed instances are held in a small process-wide pool and reused by
+ * later allocations to avoid cycling multi-MB allocations through the
+ * allocator on frequent open/close cycles.
+ */
 struct jls_buf_s * jls_buf_alloc(void);
 
 void jls_buf_free(struct jls_buf_s * self);
 
+/**
+ * @brief Release all buffer instances held by the process-wide pool.
+ */
+void jls_buf_pool_clear(void);
+
 int32_t jls_buf_realloc(struct jls_buf_s * self, size_t size);
 
 void jls_buf_reset(struct jls_buf_s * self);
@@ -91,6 +117,9 @@ int32_t jls_buf_copy(struct jls_buf_s * self, const struct jls_buf_s * src);
  * @param cstr_in The string to save.
  * @param cstr_save The saved string, which remains valid until jls_buf_free(self).
  * @return 0 or error code.
+ *
+ * Strings are interned: saving a string that matches an earlier save
+ * returns the existing shared copy rather than storing a duplicate.
  */
 int32_t jls_buf_string_save(struct jls_buf_s * self, const char * cstr_in, char ** cstr_save);
 
@@ -105,9 +134,11 @@ int32_t jls_buf_wr_i64(struct jls_buf_s * self, int64_t value);
 
 
 int32_t jls_buf_rd_skip(struct jls_buf_s * self, size_t count);
+int32_t jls_buf_rd_bin(struct jls_buf_s * self, void * data, uint32_t data_size);
 int32_t jls_buf_rd_u8(struct jls_buf_s * self, uint8_t * value);
 int32_t jls_buf_rd_u16(struct jls_buf_s * self, uint16_t * value);
 int32_t jls_buf_rd_u32(struct jls_buf_s * self, uint32_t * value);
+int32_t jls_buf_rd_i64(struct jls_buf_s * self, int64_t * value);
 int32_t jls_buf_rd_str(struct jls_buf_s * self, const char ** value);
 
 
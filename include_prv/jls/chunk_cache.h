@@ -0,0 +1,97 @@
+/*
+ * Copyright 2021-2023 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief JLS chunk cache.
+ */
+
+#ifndef JLS_CHUNK_CACHE_H__
+#define JLS_CHUNK_CACHE_H__
+
+#include "jls/cmacro.h"
+#include "jls/format.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @ingroup jls
+ * @defgroup jls_chunk_cache Chunk cache
+ *
+ * @brief LRU cache for chunks read from a JLS file, keyed by file offset.
+ *
+ * Interactive pan and zoom operations repeatedly revisit nearby file
+ * regions.  Caching chunks after the CRC-validated read turns most
+ * of these revisits into memory copies, skipping the seek, read, and
+ * CRC check.
+ *
+ * @{
+ */
+
+JLS_CPP_GUARD_START
+
+/// The opaque chunk cache object.
+struct jls_chunk_cache_s;
+
+/**
+ * @brief Allocate a new chunk cache.
+ *
+ * @param[out] instance The new chunk cache instance.
+ * @param size_max The maximum total size in bytes for cached chunks.
+ * @return 0 or error code.
+ */
+int32_t jls_chunk_cache_alloc(struct jls_chunk_cache_s ** instance, size_t size_max);
+
+/**
+ * @brief Free a chunk cache and all cached chunks.
+ *
+ * @param self The chunk cache instance.
+ */
+void jls_chunk_cache_free(struct jls_chunk_cache_s * self);
+
+/**
+ * @brief Get a cached chunk.
+ *
+ * @param self The chunk cache instance.
+ * @param offset The chunk file offset.
+ * @param[out] hdr The cached chunk header.
+ * @param[out] payload The cached payload of hdr->payload_length bytes,
+ *      which remains valid until the next cache operation.
+ * @return 0, JLS_ERROR_NOT_FOUND on cache miss, or error code.
+ */
+int32_t jls_chunk_cache_get(struct jls_chunk_cache_s * self, int64_t offset,
+                            struct jls_chunk_header_s * hdr, const uint8_t ** payload);
+
+/**
+ * @brief Add a chunk to the cache, evicting least recently used chunks as needed.
+ *
+ * @param self The chunk cache instance.
+ * @param offset The chunk file offset.
+ * @param hdr The chunk header.
+ * @param payload The payload of hdr->payload_length bytes, which is copied.
+ * @return 0 or error code.
+ *
+ * Chunks too large for the cache are silently ignored.
+ */
+int32_t jls_chunk_cache_put(struct jls_chunk_cache_s * self, int64_t offset,
+                            const struct jls_chunk_header_s * hdr, const uint8_t * payload);
+
+JLS_CPP_GUARD_END
+
+/** @} */
+
+#endif  /* JLS_CHUNK_CACHE_H__ */
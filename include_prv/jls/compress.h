@@ -0,0 +1,102 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * @file
+ *
+ * @brief JLS chunk payload compression codecs.
+ */
+
+#ifndef JLS_PRIV_COMPRESS_H__
+#define JLS_PRIV_COMPRESS_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @ingroup jls
+ * @defgroup jls_compress Compression
+ *
+ * @brief JLS chunk payload compression codecs.
+ *
+ * Dispatches on the jls_compression_e method stored in each chunk
+ * header.  JLS_COMPRESSION_RLE is always available.  The zstd and
+ * LZ4 codecs are only available when built with JLS_HAS_ZSTD or
+ * JLS_HAS_LZ4 and linked against the matching library.
+ *
+ * @{
+ */
+
+/**
+ * @brief Check if a compression method is available in this build.
+ *
+ * @param compression The jls_compression_e method.
+ * @return 1 if available, 0 otherwise.
+ */
+int32_t jls_compression_available(uint8_t compression);
+
+/**
+ * @brief Get the worst-case compressed size.
+ *
+ * @param compression The jls_compression_e method.
+ * @param src_length The uncompressed length in bytes.
+ * @return The destination buffer size that guarantees jls_compress()
+ *      cannot fail for lack of space, or 0 if compression is
+ *      JLS_COMPRESSION_NONE or not available.
+ */
+uint32_t jls_compress_bound(uint8_t compression, uint32_t src_length);
+
+/**
+ * @brief Compress a buffer.
+ *
+ * @param compression The jls_compression_e method.
+ * @param src The uncompressed data.
+ * @param src_length The uncompressed length in bytes.
+ * @param[out] dst The compressed data.
+ * @param dst_length The available size of dst in bytes.
+ * @return The compressed length in bytes on success,
+ *      0 if the data does not fit in dst (incompressible),
+ *      or a negative jls_error_code_e value.
+ */
+int32_t jls_compress(uint8_t compression, const uint8_t * src, uint32_t src_length,
+                     uint8_t * dst, uint32_t dst_length);
+
+/**
+ * @brief Decompress a buffer.
+ *
+ * @param compression The jls_compression_e method.
+ * @param src The compressed data.
+ * @param src_length The compressed length in bytes.
+ * @param[out] dst The uncompressed data.
+ * @param dst_length The expected uncompressed length in bytes,
+ *      which must match exactly.
+ * @return 0 or error code.
+ */
+int32_t jls_decompress(uint8_t compression, const uint8_t * src, uint32_t src_length,
+                       uint8_t * dst, uint32_t dst_length);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* JLS_PRIV_COMPRESS_H__ */
@@ -25,8 +25,10 @@
 
 #include "jls/cmacro.h"
 #include "jls/format.h"
+#include "jls/writer.h"
 #include "jls/raw.h"
 #include "jls/buffer.h"
+#include "jls/datatype.h"
 #include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
@@ -44,6 +46,7 @@ JLS_CPP_GUARD_START
 
 struct jls_core_signal_s;
 struct jls_core_s;
+struct jls_wr_s;
 
 
 struct jls_core_chunk_s {
@@ -55,6 +58,7 @@ struct jls_core_f64_buf_s {
     double * start;
     double * end;
     size_t alloc_length;  // in double
+    uint8_t rsv_align[64 - 3 * sizeof(size_t)];  // keep buffer cache-line aligned
     double buffer[];
 };
 
@@ -65,22 +69,55 @@ struct jls_core_fsr_level_s {
     uint8_t rsv8_3;
     uint32_t index_entries;
     uint32_t summary_entries;
-    uint32_t rsv32_1;
+    uint32_t preview_entry_count;  // entries already in the latest preview chunk, see jls_fsr_summary_preview_wr()
     struct jls_fsr_index_s * index;
     struct jls_fsr_f32_summary_s * summary;  // either jls_fsr_f32_summary_s or jls_fsr_f64_summary_s
 };
 
+struct jls_bk_thread_s;  // opaque, see "jls/backend.h"
+
 struct jls_core_fsr_s {
     struct jls_core_signal_s * parent;
     int64_t signal_length;  // total, including skipped samples
     uint32_t data_length;  // for data, in samples
     struct jls_fsr_data_s * data;  // for level 0 sample data
+    struct jls_fsr_data_s * data_prev;  // filled buffer under parallel reduction, NULL when disabled
     double * data_f64;             // for level 0 sample data summarization statistics computation
+    double * reduce_entries;       // level-1 scratch: mean, min, max, var per summary entry
+    uint8_t * delta_buf;           // staging for delta-encoded level 0 payloads, NULL when unused
+    uint32_t delta_alloc;          // the allocated size of delta_buf in bytes
+    uint8_t * suspend_buf;         // compact state snapshot while suspended, NULL otherwise
+    double * inject_entries;       // preset level-1 summary entries, NULL to compute from samples
+    uint32_t inject_count;         // entries at inject_entries
+    uint32_t inject_offset;        // entries already consumed
+    double * mirror_entries;       // level-1 entries staged for the mirror writer, see jls_wr_mirror_open()
+    uint32_t mirror_count;         // entries at mirror_entries
+    uint32_t mirror_alloc;         // allocated entries at mirror_entries
+    uint32_t reduce_count;         // the entry count from the most recent parallel reduction
+    uint8_t parallel_en;           // 1 to reduce level-1 summaries on a worker thread
+    struct jls_bk_thread_s * reduce_thread;  // the in-flight reduction or NULL when idle
+    jls_dt_f64_fn data_f64_fn;     // selected per data_type at open
+    double data_f64_scale;         // fixed-point scale for data_f64_fn
     int64_t sample_id_offset;
+    int64_t ring_chunks;           // level 0 data blocks to retain, 0 for unbounded recording
+    int64_t ring_data_count;       // level 0 data blocks written this session, including omitted
+    uint8_t summarize_int;        // 1 for integer-native level-1 summarization, no data_f64 staging
     uint8_t write_omit_data;      // omit level 0 sample data. >1=enabled, else disabled
     uint8_t shift_amount;
     uint8_t shift_buffer;
+    uint8_t scale_en;              // 1 to apply scale_gain/scale_offset, see jls_wr_fsr_scale()
+    double scale_gain;
+    double scale_offset;
+    jls_wr_fsr_transform_fn transform_fn;  // block transform or NULL, see jls_wr_fsr_transform()
+    void * transform_user_data;
+    void * transform_buf;          // staging for transformed sample blocks, NULL when unused
+    uint32_t transform_alloc;      // the allocated size of transform_buf in bytes
+    // summary preview watermarks, see jls_wr_fsr_summary_watermark()
+    uint32_t preview_interval_ms[JLS_SUMMARY_LEVEL_COUNT];  // 0 when disabled
+    int64_t preview_due[JLS_SUMMARY_LEVEL_COUNT];           // the jls_now() time for the next preview
     uint64_t buffer_u64[4096];     // for shifting incoming sample data on skips & duplicates
+    int64_t rd_next_sample_id;     // expected start for a sequential read, -1 when unknown
+    int64_t rd_prefetch_offset;    // most recent readahead file offset, to avoid rehinting
     struct jls_core_fsr_level_s * level[JLS_SUMMARY_LEVEL_COUNT];  // level 0 unused
 
     struct jls_tmap_s * tmap;     // on read, map UTC to sample_id
@@ -115,14 +152,45 @@ struct jls_core_track_s {
     struct jls_core_chunk_s summary_head[JLS_SUMMARY_LEVEL_COUNT];
 };
 
+// one annotation record location, for the binary-searchable annotation index
+struct jls_core_anno_index_entry_s {
+    int64_t timestamp;   // the raw file timestamp, including sample_id_offset
+    int64_t offset;      // the JLS_TAG_TRACK_ANNOTATION_DATA chunk offset
+    uint64_t digest;     // Bloom filter over the payload content, see jls_rd_annotations_find()
+};
+
+// the per-signal annotation index, sorted by timestamp
+struct jls_core_anno_index_s {
+    int64_t count;
+    struct jls_core_anno_index_entry_s entries[];
+};
+
+/// The monomorphic FSR sample copy loop, specialized per entry_size_bits.
+typedef int32_t (*jls_core_fsr_rd_fn)(struct jls_core_s * self, uint16_t signal_id,
+                                      uint8_t * data_u8, int64_t start_sample_id,
+                                      int64_t data_length, int64_t * end_sample_id);
+
 struct jls_core_signal_s {
     struct jls_core_s * parent;
     struct jls_core_chunk_s chunk_def;
     struct jls_signal_def_s signal_def;
+    jls_core_fsr_rd_fn fsr_rd_fn;  // selected per data_type on first read
     struct jls_core_track_s tracks[JLS_TRACK_TYPE_COUNT];   // array index is jls_track_type_e
     struct jls_core_fsr_s * track_fsr;
     struct jls_core_ts_s * track_anno;
     struct jls_core_ts_s * track_utc;  // for fsr only
+    struct jls_fsr_seek_index_s * seek_index;  // level-1 seek index, NULL when unavailable
+    uint32_t seek_index_alloc;                 // allocated entry capacity, for write
+    struct jls_fsr_index_s * follow_index;     // synthetic level-1 index over the unindexed tail (follow mode)
+    uint32_t follow_index_alloc;               // allocated entry capacity
+    struct jls_utc_tmap_s * tmap_sidecar;      // UTC time map sidecar, NULL when unavailable
+    uint32_t tmap_sidecar_alloc;               // allocated entry capacity, for write
+    struct jls_fsr_data_map_s * data_map;      // level-0 data chunk coverage map, NULL when unavailable
+    uint32_t data_map_alloc;                   // allocated entry capacity, for write
+    struct jls_core_anno_index_s * anno_index; // built on first range query, read only
+    struct jls_fsr_f32_summary_s * preview[JLS_SUMMARY_LEVEL_COUNT];  // latest summary preview payload
+                                               // (f32 or f64 per entry_size_bits), follow mode only
+    uint32_t preview_alloc[JLS_SUMMARY_LEVEL_COUNT];  // allocated bytes
 };
 
 struct jls_core_source_s {
@@ -130,9 +198,17 @@ struct jls_core_source_s {
     struct jls_source_def_s source_def;
 };
 
+struct jls_chunk_cache_s;  // opaque, see "jls/chunk_cache.h"
+struct jls_shared_cache_s;  // opaque, see "jls/shared_cache.h"
+
 struct jls_core_s {
     struct jls_raw_s * raw;
     struct jls_buf_s * buf;  // automatic target for chunk read
+    struct jls_chunk_cache_s * cache;  // optional LRU cache for chunk reads, may be NULL
+    struct jls_bkm_s * cache_mutex;    // guards cache when shared with the prefetch
+                                       // worker, see jls_rd_prefetch(), may be NULL
+    struct jls_shared_cache_s * shared_cache;  // optional cross-process cache, may be NULL
+    uint64_t shared_cache_file_id;     // file identity within the shared cache
 
     struct jls_buf_s * rd_index;    // the index for the most recent FSR read operation
     struct jls_core_chunk_s rd_index_chunk;
@@ -148,15 +224,126 @@ struct jls_core_s {
     struct jls_core_chunk_s signal_head;  // for most recently added signal_def, track_def, track_head
 
     struct jls_core_chunk_s user_data_head;  // for most recently added user_data
+    struct jls_core_chunk_s user_data_first; // writer copy of the first user_data chunk, the read anchor
 
     struct jls_core_chunk_s chunk_cur;           // most recent read chunk header, payload in buf
     struct jls_core_f64_buf_s * f64_sample_buf;  // for reading samples
     struct jls_core_f64_buf_s * f64_stats_buf;   // for reading statistics
+    size_t mem_budget;                           // total buffer byte budget, 0 for unlimited
+    uint8_t dir_en;                              // 1 when the footer directory provided defs and heads
+    uint8_t omit_mode;                           // jls_rd_omit_mode_e for omitted data reconstruction
+    struct jls_link_table_s * link_table;        // footer links for strict append-only files, or NULL
+
+    // per-chunk wall-clock persist times, see jls_wr_chunk_clock_en()
+    uint8_t chunk_clock_en;                      // 1 to record data chunk persist times
+    struct jls_chunk_clock_entry_s * chunk_clock;  // the pending (offset, wall clock) entries
+    uint32_t chunk_clock_count;                  // the pending entry count
+    uint32_t chunk_clock_alloc;                  // the allocated entry count
+    int64_t chunk_clock_prev;                    // the last written CHUNK_CLOCK chunk offset, 0 if none
+    int64_t chunk_clock_head;                    // reader: the trailing CHUNK_CLOCK chunk offset, 0 if none
+
+    // tail-follow reader mode, see jls_rd_open_follow()
+    uint8_t follow_en;                     // 1 to discover appended chunks on refresh
+    int64_t follow_pos;                    // the next unscanned chunk offset
+
+    // deferred head-pointer updates, enabled by the JLS_APPEND_ONLY environment variable
+    uint8_t head_defer_en;                 // 1 to buffer item_next header rewrites in memory,
+                                           // 2 to write them to the link table footer chunk instead
+    struct jls_core_chunk_s * head_defer;  // the pending header rewrites
+    uint32_t head_defer_count;             // the number of pending rewrites
+    uint32_t head_defer_alloc;             // the allocated entry count for head_defer
+
+    // periodic recovery checkpoints, see jls_wr_checkpoint_interval()
+    uint64_t checkpoint_interval;          // checkpoint every this many file bytes, 0 to disable
+    int64_t checkpoint_next;               // emit the next checkpoint at this file offset
+
+    // writer allocation arena, see jls_core_arena_alloc()
+    uint8_t arena_en;                      // 1 to serve working buffers from the arena
+    struct jls_core_arena_s * arena;       // the most recent arena block or NULL
+    struct jls_core_arena_free_s * arena_free;  // released arena allocations, for reuse
+
+    struct jls_wr_s * mirror;              // the summary-only mirror writer, see jls_wr_mirror_open()
+
+    // optional per-handle instrumentation, see jls_rd_progress_register()
+    int32_t (*progress_fn)(void * user_data, uint8_t phase, int64_t bytes, int64_t chunks);
+    void * progress_user_data;
+    uint8_t progress_phase;                // the current jls_rd_phase_e
+    int64_t progress_bytes;                // cumulative header + payload bytes read
+    int64_t progress_chunks;               // cumulative chunks visited
+    int64_t progress_bytes_next;           // invoke progress_fn at this byte count
+    volatile uint8_t cancel;               // set by jls_rd_cancel(), cleared when observed
+    int64_t budget_bytes;                  // remaining I/O byte budget:
+                                           //   0 = unlimited, >0 = remaining, <0 = exhausted
+    uint64_t cache_hits;                   // chunk cache hits, see jls_rd_counters()
+    uint64_t cache_misses;                 // chunk cache lookups that missed
 };
 
-int32_t jls_core_f64_buf_alloc(size_t length, struct jls_core_f64_buf_s ** buf);
+/// One block of the writer allocation arena, see jls_core_arena_alloc().
+struct jls_core_arena_s {
+    struct jls_core_arena_s * next;        // the older blocks
+    size_t size;                           // the usable byte count following this header
+    size_t pos;                            // the next unallocated byte offset
+};
+
+/// One released arena allocation, linked in place, see jls_core_arena_free().
+struct jls_core_arena_free_s {
+    struct jls_core_arena_free_s * next;   // the next released allocation
+    size_t size;                           // the usable byte count of this allocation
+};
+
+/**
+ * @brief Allocate a cache-line aligned working buffer.
+ *
+ * @param size The desired size in bytes.
+ * @return The 64-byte aligned allocation or NULL.
+ *
+ * The 64-byte alignment keeps the SIMD summary loops and
+ * jls_dt_buffer_to_f64() off split cache lines.  Set the
+ * JLS_HUGE_PAGES environment variable to additionally back
+ * allocations of 2 MB and up with transparent huge pages on Linux,
+ * which reduces TLB misses when streaming through the large sample
+ * and statistics buffers.  Release with jls_core_buf_free().
+ */
+void * jls_core_buf_alloc(size_t size);
+
+/**
+ * @brief Release a buffer from jls_core_buf_alloc().
+ *
+ * @param ptr The buffer, or NULL.
+ */
+void jls_core_buf_free(void * ptr);
+
+int32_t jls_core_f64_buf_alloc(struct jls_core_s * self, size_t length, struct jls_core_f64_buf_s ** buf);
 void jls_core_f64_buf_free(struct jls_core_f64_buf_s * buf);
 
+/**
+ * @brief Configure the memory budget for read buffers.
+ *
+ * @param self The core instance.
+ * @param budget The total byte budget shared by the payload, index,
+ *      summary, and f64 working buffers.  0 restores the default
+ *      unlimited behavior.
+ * @return 0 or error code.
+ *
+ * When a nonzero budget is set, buffer growth that would exceed the
+ * budget fails with JLS_ERROR_NOT_ENOUGH_MEMORY, and the f64 sample
+ * buffer is pre-sized for the defined FSR signals when it fits so that
+ * steady-state reads do not allocate.
+ */
+int32_t jls_core_mem_config(struct jls_core_s * self, size_t budget);
+
+/**
+ * @brief Release the f64 working buffers retained at their high-water size.
+ *
+ * @param self The core instance.
+ * @return 0 or error code.
+ *
+ * The buffers grow on demand and are retained between queries, so the
+ * largest query performed so far sets the resident size.  The next
+ * query reallocates at the size it actually needs.
+ */
+int32_t jls_core_mem_trim(struct jls_core_s * self);
+
 /**
  * @brief Validate the signal definition.
  *
@@ -194,10 +381,140 @@ int32_t jls_core_update_chunk_header(struct jls_core_s * self, struct jls_core_c
  * This function causes a file seek back to the head chunk in order to
  * perform the write.  However, it uses the provided head data to
  * skip performing a read.
+ *
+ * When head_defer_en is set, the rewrite is buffered in memory instead
+ * and the stream remains append-only until jls_core_head_defer_apply().
  */
 int32_t jls_core_update_item_head(struct jls_core_s * self,
         struct jls_core_chunk_s * head, struct jls_core_chunk_s * next);
 
+/**
+ * @brief Find the next chunk in a doubly-linked list by forward scan.
+ *
+ * @param self The core instance.
+ * @param offset The offset for the chunk with the missing item_next.
+ * @param tag The jls_tag_e to match.
+ * @param chunk_meta The chunk_meta to match.
+ * @return The offset for the next matching chunk or 0 when not found.
+ *
+ * Captures interrupted before the deferred head-pointer rewrites were
+ * applied leave valid chunks with zero item_next links.  The chunks are
+ * self-describing, so the repair rebuilds each missing link by scanning
+ * the physically sequential stream for the next chunk with the same
+ * tag and chunk_meta.
+ */
+int64_t jls_core_chain_scan_next(struct jls_core_s * self, int64_t offset, uint8_t tag, uint16_t chunk_meta);
+
+/**
+ * @brief Allocate a writer working buffer.
+ *
+ * @param self The core instance.
+ * @param size The desired size in bytes.
+ * @return The 64-byte aligned allocation or NULL.
+ *
+ * When arena_en is set, the allocation bumps from large arena blocks so
+ * that the per-signal, per-level summary state stays contiguous and a
+ * multi-signal open does not perform dozens of scattered allocations.
+ * The arena is freed as a whole by jls_core_arena_finalize(); release
+ * individual buffers with jls_core_arena_free().  Released arena-backed
+ * buffers are not returned to the system, but are reused by later
+ * allocations of the same size, so a suspend/resume cycle does not grow
+ * the arena.  Without arena_en, this is plain malloc.
+ */
+void * jls_core_arena_alloc(struct jls_core_s * self, size_t size);
+
+/**
+ * @brief Release a buffer from jls_core_arena_alloc().
+ *
+ * @param self The core instance.
+ * @param ptr The buffer, or NULL.
+ */
+void jls_core_arena_free(struct jls_core_s * self, void * ptr);
+
+/**
+ * @brief Free all arena blocks.
+ *
+ * @param self The core instance.
+ *
+ * Call only when every buffer from jls_core_arena_alloc() is done,
+ * normally at writer close.
+ */
+void jls_core_arena_finalize(struct jls_core_s * self);
+
+/**
+ * @brief Apply the buffered head-pointer rewrites to the file.
+ *
+ * @param self The core instance.
+ * @return 0 or error code.
+ *
+ * The rewrites are applied in file offset order to keep the seek
+ * pattern sequential.  Call on flush and before close.
+ * Does nothing in the strict append-only mode (head_defer_en 2),
+ * where jls_core_wr_link_table() consumes the buffered links at close.
+ */
+int32_t jls_core_head_defer_apply(struct jls_core_s * self);
+
+/**
+ * @brief Apply a bounded batch of the buffered head-pointer updates.
+ *
+ * @param self The core instance.
+ * @param count_max The maximum number of rewrites to apply.
+ * @return 0 or error code.
+ *
+ * Incremental form of jls_core_head_defer_apply() for trickling the
+ * backlog out during idle time, so close replays only the remainder.
+ * Does nothing in the strict append-only mode (head_defer_en 2).
+ */
+int32_t jls_core_head_defer_apply_slice(struct jls_core_s * self, uint32_t count_max);
+
+/**
+ * @brief Write the buffered head-pointer updates as a link table chunk.
+ *
+ * @param self The core instance.
+ * @return 0 or error code.
+ *
+ * Only the strict append-only mode (head_defer_en 2) writes the
+ * JLS_TAG_LINK_TABLE chunk; otherwise this function does nothing.
+ * Call with the other trailing sidecar chunks, before JLS_TAG_END.
+ */
+int32_t jls_core_wr_link_table(struct jls_core_s * self);
+
+/**
+ * @brief Record the wall-clock persist time for a data chunk write.
+ *
+ * @param self The core instance.
+ * @param offset The data chunk file offset.
+ * @return 0 or error code.
+ *
+ * Does nothing unless enabled with jls_wr_chunk_clock_en().  Full
+ * entry batches write out as mid-stream JLS_TAG_CHUNK_CLOCK chunks.
+ */
+int32_t jls_core_chunk_clock_record(struct jls_core_s * self, int64_t offset);
+
+/**
+ * @brief Write the pending chunk clock entries as a CHUNK_CLOCK chunk.
+ *
+ * @param self The core instance.
+ * @return 0 or error code.
+ *
+ * At close, call even with no pending entries so the trailing chunk
+ * anchors the backward chain for the reader.  Does nothing when
+ * chunk clock recording is disabled.
+ */
+int32_t jls_core_wr_chunk_clock(struct jls_core_s * self);
+
+/**
+ * @brief Substitute a link table entry for a zero on-disk item_next.
+ *
+ * @param self The core instance.
+ * @param offset The file offset of the chunk that hdr was read from.
+ * @param hdr The chunk header to patch in place.
+ *
+ * Does nothing when no link table was loaded, the header already has
+ * a forward link, or the table has no entry for offset.
+ */
+void jls_core_link_table_patch(struct jls_core_s * self, int64_t offset, struct jls_chunk_header_s * hdr);
+
 int32_t jls_core_signal_validate(struct jls_core_s * self, uint16_t signal_id);
 int32_t jls_core_signal_validate_typed(struct jls_core_s * self, uint16_t signal_id, enum jls_signal_type_e signal_type);
 int32_t jls_core_validate_track_tag(struct jls_core_s * self, uint16_t signal_id, uint8_t tag);
@@ -213,6 +530,28 @@ static inline uint8_t jls_core_tag_parse_track_type(uint8_t tag) {
 int32_t jls_core_wr_data(struct jls_core_s * self, uint16_t signal_id, enum jls_track_type_e track_type,
                          const uint8_t * payload, uint32_t payload_length);
 
+/**
+ * @brief Write FSR sample data, recycling the oldest level 0 data chunk slot.
+ *
+ * @param self The core instance.
+ * @param signal_id The signal id.
+ * @param chunk_idx The level 0 data block index for the slot to recycle.
+ * @param payload The chunk payload.
+ * @param payload_length The payload length in bytes.
+ * @param[out] pos The file offset for the written data chunk, for the
+ *      caller's level 1 INDEX entry.
+ * @return 0 or error code.
+ *
+ * Rewrites the data chunk at chunk_idx in place and zeros its entry in
+ * the covering on-disk level 1 INDEX chunk, so that readers reconstruct
+ * the overwritten region from the retained summaries like omitted data.
+ * When the slot cannot be recycled safely, such as when the covering
+ * INDEX chunk is not yet on disk or the payload lengths differ, the
+ * chunk appends normally through jls_core_wr_data().
+ */
+int32_t jls_core_fsr_ring_wr_data(struct jls_core_s * self, uint16_t signal_id, int64_t chunk_idx,
+                                  const uint8_t * payload, uint32_t payload_length, int64_t * pos);
+
 int32_t jls_core_wr_summary(struct jls_core_s * self, uint16_t signal_id, enum jls_track_type_e track_type, uint8_t level,
                             const uint8_t * payload, uint32_t payload_length);
 
@@ -221,6 +560,148 @@ int32_t jls_core_wr_index(struct jls_core_s * self, uint16_t signal_id, enum jls
 
 int32_t jls_core_wr_end(struct jls_core_s * self);
 
+/**
+ * @brief Append a level-1 INDEX chunk offset to the in-memory seek index.
+ *
+ * @param self The core instance.
+ * @param signal_id The signal id.
+ * @param timestamp The starting sample id for the INDEX chunk.
+ * @param offset The INDEX chunk file offset.
+ * @return 0 or error code.
+ */
+int32_t jls_core_seek_index_append(struct jls_core_s * self, uint16_t signal_id,
+                                   int64_t timestamp, int64_t offset);
+
+/**
+ * @brief Write the accumulated seek index chunks, one per FSR signal.
+ *
+ * @param self The core instance.
+ * @return 0 or error code.
+ *
+ * Call immediately before jls_core_wr_end().
+ */
+int32_t jls_core_wr_seek_index(struct jls_core_s * self);
+
+/**
+ * @brief Append a level-0 data chunk entry to the in-memory data map.
+ *
+ * @param self The core instance.
+ * @param signal_id The signal id.
+ * @param timestamp The starting sample id for the data chunk.
+ * @param entry_count The number of samples in the data chunk.
+ * @return 0 or error code.
+ */
+int32_t jls_core_data_map_append(struct jls_core_s * self, uint16_t signal_id,
+                                 int64_t timestamp, uint32_t entry_count);
+
+/**
+ * @brief Write the accumulated data map chunks, one per FSR signal.
+ *
+ * @param self The core instance.
+ * @return 0 or error code.
+ *
+ * Call immediately before jls_core_wr_end(), see JLS_TAG_DATA_MAP.
+ */
+int32_t jls_core_wr_data_map(struct jls_core_s * self);
+
+/**
+ * @brief Load the seek index chunks from a properly closed file.
+ *
+ * @param self The core instance, positioned at the JLS_TAG_END chunk.
+ * @return 0 or error code.
+ *
+ * Files without seek index chunks load nothing, and
+ * jls_core_fsr_seek() falls back to the summary hierarchy walk.
+ * This same backward walk also loads the UTC time map and the
+ * footer directory sidecars when present, see JLS_TAG_DIRECTORY.
+ */
+int32_t jls_core_rd_seek_index(struct jls_core_s * self);
+
+/**
+ * @brief Write the footer directory chunk, see JLS_TAG_DIRECTORY.
+ *
+ * @param self The core instance.
+ * @return 0 or error code.
+ *
+ * Call immediately before jls_core_wr_end(), before the other
+ * trailing sidecar chunks so that older readers stop their backward
+ * sidecar walk at this chunk after reading the sidecars they know.
+ */
+int32_t jls_core_wr_directory(struct jls_core_s * self);
+
+/**
+ * @brief Write a recovery checkpoint chunk, see JLS_TAG_CHECKPOINT.
+ *
+ * @param self The core instance, positioned at the file end.
+ * @return 0 or error code.
+ *
+ * The checkpoint snapshots the in-memory track head state using the
+ * directory payload, including head rewrites still buffered by
+ * head_defer_en, so repair after a crash replays only the chunks
+ * written after the checkpoint.
+ */
+int32_t jls_core_wr_checkpoint(struct jls_core_s * self);
+
+/**
+ * @brief Write a checkpoint when the configured interval has elapsed.
+ *
+ * @param self The core instance, positioned at the file end.
+ * @return 0 or error code.
+ *
+ * Does nothing when checkpoint_interval is 0 (the default) or fewer
+ * than checkpoint_interval bytes were appended since the last
+ * checkpoint.
+ */
+int32_t jls_core_checkpoint_process(struct jls_core_s * self);
+
+/**
+ * @brief Load the most recent checkpoint before repairing a crashed file.
+ *
+ * @param self The core instance, positioned at the last valid chunk.
+ * @return 0 or error code.  A file without checkpoints returns 0.
+ *
+ * Walks backward until a JLS_TAG_CHECKPOINT chunk is found and loads
+ * its track head state, so the chain repair starts from the
+ * checkpoint instead of the much older on-disk head pointers.
+ */
+int32_t jls_core_rd_checkpoint(struct jls_core_s * self);
+
+/**
+ * @brief Free the seek index for all signals.
+ *
+ * @param self The core instance.
+ */
+void jls_core_seek_index_free(struct jls_core_s * self);
+
+/**
+ * @brief Append an entry to the in-memory UTC time map sidecar.
+ *
+ * @param self The core instance.
+ * @param signal_id The signal id.
+ * @param sample_id The sample id, in file units.
+ * @param utc The corresponding UTC timestamp.
+ * @return 0 or error code.
+ */
+int32_t jls_core_tmap_append(struct jls_core_s * self, uint16_t signal_id,
+                             int64_t sample_id, int64_t utc);
+
+/**
+ * @brief Write the accumulated UTC time map chunks, one per FSR signal.
+ *
+ * @param self The core instance.
+ * @return 0 or error code.
+ *
+ * Call immediately before jls_core_wr_end(), see JLS_TAG_UTC_TMAP.
+ */
+int32_t jls_core_wr_tmap(struct jls_core_s * self);
+
+/**
+ * @brief Free the UTC time map sidecar for all signals.
+ *
+ * @param self The core instance.
+ */
+void jls_core_tmap_sidecar_free(struct jls_core_s * self);
+
 int32_t jls_core_fsr_summary_level_alloc(struct jls_core_fsr_s * self, uint8_t level);
 int32_t jls_core_fsr_summary1(struct jls_core_fsr_s * self, int64_t pos);
 int32_t jls_core_fsr_summaryN(struct jls_core_fsr_s * self, uint8_t level, int64_t pos);
@@ -228,12 +709,92 @@ int32_t jls_core_fsr_summaryN(struct jls_core_fsr_s * self, uint8_t level, int64
 int32_t jls_fsr_open(struct jls_core_fsr_s ** instance, struct jls_core_signal_s * parent);
 int32_t jls_fsr_close(struct jls_core_fsr_s * self);
 
+/**
+ * @brief Write a JLS_TAG_SUMMARY_PREVIEW chunk for one summary level.
+ *
+ * @param self The FSR track instance.
+ * @param level The summary level, 1 to JLS_SUMMARY_LEVEL_COUNT - 1.
+ * @return 0 or error code.
+ *
+ * Snapshots the completed entries accumulating in the level's summary
+ * buffer without resetting it, so the eventual TRACK_FSR_SUMMARY chunk
+ * and the index geometry are unchanged.  Skips when the signal is
+ * suspended or no entries completed since the last preview or flush.
+ */
+int32_t jls_fsr_summary_preview_wr(struct jls_core_fsr_s * self, uint8_t level);
+
+/**
+ * @brief Release a signal's write buffers into a compact state snapshot.
+ *
+ * @param self The FSR track instance.
+ * @return 0 or error code.
+ *
+ * Copies the staged level 0 samples and the partial per-level summary
+ * accumulations into a single right-sized snapshot, then releases the
+ * full-size buffers.  Nothing is written to the file, so the on-disk
+ * chunk geometry that jls_core_fsr_seek() relies on is unchanged.
+ * jls_core_fsr_resume() restores the buffers from the snapshot;
+ * jls_wr_fsr_data() and jls_fsr_close() resume implicitly.
+ */
+int32_t jls_core_fsr_suspend(struct jls_core_fsr_s * self);
+
+/**
+ * @brief Reallocate a suspended signal's write buffers.
+ *
+ * @param self The FSR track instance.
+ * @return 0 or error code.
+ *
+ * No-op when not suspended.
+ */
+int32_t jls_core_fsr_resume(struct jls_core_fsr_s * self);
+
 int32_t jls_core_rd_chunk(struct jls_core_s * self);
 int32_t jls_core_rd_chunk_end(struct jls_core_s * self);
 int32_t jls_core_scan_sources(struct jls_core_s * self);
 int32_t jls_core_scan_signals(struct jls_core_s * self);
 int32_t jls_core_scan_fsr_sample_id(struct jls_core_s * self);
 int32_t jls_core_scan_initial(struct jls_core_s * self);
+
+/**
+ * @brief Initialize tail-follow mode, see jls_rd_open_follow().
+ *
+ * @param self The core instance with all FSR tracks opened.
+ * @param end_offset The offset of the last valid chunk in the file.
+ * @return 0 or error code.
+ *
+ * Walks the chunk headers once to build the level-1 seek index,
+ * which a live capture only persists as a sidecar on close, and a
+ * synthetic level-1 index over the data chunks not yet covered by an
+ * on-disk index chunk.  Together these let jls_core_fsr_seek() and
+ * jls_core_fsr_length() operate without the closed-file invariant
+ * that the highest summary level has a single chunk: the writer
+ * still holds the top of the summary hierarchy in memory.
+ */
+int32_t jls_core_follow_init(struct jls_core_s * self, int64_t end_offset);
+
+/**
+ * @brief Discover chunks appended since open or the previous call.
+ *
+ * @param self The core instance with follow_en set.
+ * @return 0 or error code.
+ *
+ * Re-reads only the appended tail and the in-place rewritten track
+ * head chunks: the signal lengths and summary level heads update
+ * without rescanning the file.  Chunks still being written are
+ * skipped and picked up by a later call.
+ */
+int32_t jls_core_follow_refresh(struct jls_core_s * self);
+
+/**
+ * @brief Serve the synthetic tail index for a follow-mode read.
+ *
+ * @param self The core instance.
+ * @param signal_id The signal id.
+ * @param sample_id The target sample id, in file coordinates.
+ * @return true when rd_index and rd_summary were loaded from the
+ *      synthetic index, false to use the on-disk summary hierarchy.
+ */
+bool jls_core_follow_index_load(struct jls_core_s * self, uint16_t signal_id, int64_t sample_id);
 int32_t jls_core_sources(struct jls_core_s * self, struct jls_source_def_s ** sources, uint16_t * count);
 int32_t jls_core_signals(struct jls_core_s * self, struct jls_signal_def_s ** signals, uint16_t * count);
 int32_t jls_core_signal(struct jls_core_s * self, uint16_t signal_id, struct jls_signal_def_s * signal);
@@ -245,9 +806,14 @@ int32_t jls_core_fsr(struct jls_core_s * self, uint16_t signal_id, int64_t start
                      void * data, int64_t data_length);
 int32_t jls_core_fsr_f32(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id,
                          float * data, int64_t data_length);
+int32_t jls_core_fsr_f64(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id,
+                         double * data, int64_t data_length);
 int32_t jls_core_fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
                                 int64_t start_sample_id, int64_t increment,
                                 double * data, int64_t data_length);
+int32_t jls_core_fsr_envelope(struct jls_core_s * self, uint16_t signal_id,
+                              int64_t start_sample_id, int64_t increment,
+                              float * data, int64_t data_length);
 int32_t jls_core_ts_seek(struct jls_core_s * self, uint16_t signal_id, uint8_t level,
                          enum jls_track_type_e track_type, int64_t timestamp);
 
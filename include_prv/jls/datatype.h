@@ -51,6 +51,37 @@ extern "C" {
  */
 int32_t jls_dt_buffer_to_f64(const void * src, uint32_t src_datatype, double * dst, size_t samples);
 
+/**
+ * @brief The per-datatype conversion function to doubles.
+ *
+ * @param src The source buffer pointer.
+ * @param[out] dst The output f64 buffer.
+ * @param samples The number of samples to convert.
+ * @param scale The fixed-point scale factor applied to each sample,
+ *      see jls_dt_f64_scale().
+ */
+typedef void (*jls_dt_f64_fn)(const void * src, double * dst, size_t samples, double scale);
+
+/**
+ * @brief Get the conversion function for a datatype.
+ *
+ * @param src_datatype The source buffer datatype, see JLS_DATATYPE_*.
+ * @return The conversion function or NULL for unsupported datatypes.
+ *
+ * Resolve once at open time and call the function directly to skip
+ * the per-buffer datatype dispatch.
+ */
+jls_dt_f64_fn jls_dt_buffer_to_f64_fn(uint32_t src_datatype);
+
+/**
+ * @brief Get the fixed-point scale factor for a datatype.
+ *
+ * @param src_datatype The source buffer datatype, see JLS_DATATYPE_*.
+ * @return The scale factor 2 ** -q for fixed-point INT and UINT
+ *      datatypes, otherwise 1.0.
+ */
+double jls_dt_f64_scale(uint32_t src_datatype);
+
 
 /** @} */
 
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/**
+ * @file
+ *
+ * @brief JLS delta + bit-packing encoder for FSR level 0 data.
+ */
+
+#ifndef JLS_PRIV_DELTA_H__
+#define JLS_PRIV_DELTA_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// forward declaration from "jls/buffer.h"
+struct jls_buf_s;
+
+/**
+ * @ingroup jls
+ * @defgroup jls_delta Delta encoding
+ *
+ * @brief JLS_FSR_DATA_ENCODING_DELTA for FSR level 0 data chunks.
+ *
+ * Entries are treated as a bit-packed stream of entry_size_bits
+ * values.  The first entry is stored verbatim followed by zigzag
+ * deltas in blocks of 64, each block prefixed by one byte giving
+ * the packed bit width for that block.  Slowly varying integer
+ * signals pack to the few bits that actually change per sample.
+ *
+ * @{
+ */
+
+/**
+ * @brief Get the worst-case encoded size.
+ *
+ * @param entry_size_bits The size of each entry, in bits.
+ * @param entry_count The number of entries.
+ * @return The destination buffer size in bytes that guarantees
+ *      jls_delta_encode() cannot fail for lack of space.
+ */
+uint32_t jls_delta_bound(uint16_t entry_size_bits, uint32_t entry_count);
+
+/**
+ * @brief Encode bit-packed entries as delta + bit-packed values.
+ *
+ * @param src The entries, bit-packed at entry_size_bits each.
+ * @param entry_count The number of entries in src.
+ * @param entry_size_bits The size of each entry, in bits, at most 64.
+ * @param[out] dst The encoded data.
+ * @param dst_length The available size of dst in bytes.
+ * @return The encoded length in bytes on success,
+ *      0 if the encoding does not fit in dst (caller stores RAW),
+ *      or a negative jls_error_code_e value.
+ */
+int32_t jls_delta_encode(const uint8_t * src, uint32_t entry_count, uint16_t entry_size_bits,
+                         uint8_t * dst, uint32_t dst_length);
+
+/**
+ * @brief Decode delta + bit-packed values to bit-packed entries.
+ *
+ * @param src The encoded data from jls_delta_encode().
+ * @param src_length The encoded length in bytes, which must match exactly.
+ * @param entry_count The number of entries to decode.
+ * @param entry_size_bits The size of each entry, in bits, at most 64.
+ * @param[out] dst The entries, bit-packed at entry_size_bits each.
+ * @param dst_length The available size of dst in bytes.
+ * @return 0 or error code.
+ */
+int32_t jls_delta_decode(const uint8_t * src, uint32_t src_length,
+                         uint32_t entry_count, uint16_t entry_size_bits,
+                         uint8_t * dst, uint32_t dst_length);
+
+/**
+ * @brief Decode an FSR DATA payload in place when encoded.
+ *
+ * @param buf The buffer holding the payload, starting with
+ *      jls_payload_header_s.  On return, the buffer holds the
+ *      RAW equivalent payload with length, cur, and end updated.
+ *      RAW payloads pass through unchanged.  This also expands
+ *      JLS_FSR_DATA_ENCODING_CONST runs to the repeated value.
+ * @return 0 or error code.
+ */
+int32_t jls_delta_buf_decode(struct jls_buf_s * buf);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* JLS_PRIV_DELTA_H__ */
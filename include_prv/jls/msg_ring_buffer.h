@@ -32,6 +32,11 @@
  *
  * @brief Provide a simple ring buffer for first-in, first-out messages.
  *
+ * The buffer is lock-free for one producer thread and one consumer
+ * thread.  The producer calls jls_mrb_alloc() then jls_mrb_commit().
+ * The consumer calls jls_mrb_peek() and jls_mrb_pop().  All other
+ * functions require external synchronization.
+ *
  * @{
  */
 
@@ -41,11 +46,24 @@ extern "C" {
 
 /// The message ring buffer instance.
 struct jls_mrb_s {
-    volatile uint32_t head;
-    volatile uint32_t tail;
-    volatile uint32_t count;    ///< number of messages
+    volatile uint32_t head;     ///< written by the producer, release ordered
+    uint32_t head_pending;      ///< producer-private: head for the uncommitted alloc
+    volatile uint32_t tail;     ///< written by the consumer, release ordered
+    volatile uint32_t count;    ///< number of messages, all segments
     uint8_t * buf;
     uint32_t buf_size;  // Size of buf in bytes
+
+    // overflow chain, see jls_mrb_overflow_set()
+    struct jls_mrb_s * volatile next;   ///< the next newer segment, producer published
+    struct jls_mrb_s * wr;              ///< producer-private: the segment receiving messages
+    struct jls_mrb_s * rd;              ///< consumer-private: the segment being drained
+    volatile uint32_t idle;             ///< primary segment drained and unlinked, consumer published
+    uint32_t owned;                     ///< heap segment, freed by the consumer when drained
+    uint32_t alloc_size_pending;        ///< producer-private: size for the uncommitted alloc
+    volatile uint32_t used_bytes;       ///< committed message bytes, all segments
+    uint32_t overflow_size;             ///< overflow segment size in bytes, 0 when disabled
+    uint32_t overflow_max;              ///< maximum total overflow segment bytes
+    volatile uint32_t overflow_bytes;   ///< currently allocated overflow segment bytes
 };
 
 /**
@@ -61,6 +79,9 @@ void jls_mrb_init(struct jls_mrb_s * self, uint8_t * buffer, uint32_t buffer_siz
  * @brief Clear all data from the memory buffer.
  *
  * @param self The ring buffer instance.
+ *
+ * This also frees any overflow segments.  Requires external
+ * synchronization with both the producer and the consumer.
  */
 void jls_mrb_clear(struct jls_mrb_s * self);
 
@@ -72,15 +93,46 @@ void jls_mrb_clear(struct jls_mrb_s * self);
  */
 uint32_t jls_mrb_used_bytes(struct jls_mrb_s * self);
 
+/**
+ * @brief Enable the overflow chain for burst absorption.
+ *
+ * @param self The ring buffer instance.
+ * @param segment_size The size of each overflow segment in bytes.
+ * @param bytes_max The maximum total bytes for all overflow segments.
+ *      0 disables the overflow chain (default).
+ *
+ * When the primary buffer cannot hold a message, jls_mrb_alloc()
+ * normally returns NULL and the producer must drop or retry.  With the
+ * overflow chain enabled, the producer instead appends heap-allocated
+ * segments, up to bytes_max total, and jls_mrb_alloc() only returns
+ * NULL once the chain is also full.  The consumer drains segments in
+ * FIFO order and frees each one as it empties, so memory use returns
+ * to the primary buffer after a burst.
+ *
+ * Call from the producer side; requires the same external
+ * synchronization as jls_mrb_alloc().
+ */
+void jls_mrb_overflow_set(struct jls_mrb_s * self, uint32_t segment_size, uint32_t bytes_max);
+
 /**
  * @brief Allocate a message on the ring buffer.
  *
  * @param self The ring buffer instance.
  * @param size The desired size of the buffer.
  * @return The buffer or NULL on out of space.
+ *
+ * The message is not visible to the consumer until the producer
+ * fills the buffer and then calls jls_mrb_commit().
  */
 uint8_t * jls_mrb_alloc(struct jls_mrb_s * self, uint32_t size);
 
+/**
+ * @brief Publish the message from the most recent jls_mrb_alloc().
+ *
+ * @param self The ring buffer instance.
+ */
+void jls_mrb_commit(struct jls_mrb_s * self);
+
 /**
  * @brief Peek at the next message from the buffer.
  *
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2021-2023 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief JLS shared-memory chunk cache.
+ */
+
+#ifndef JLS_SHARED_CACHE_H__
+#define JLS_SHARED_CACHE_H__
+
+#include "jls/cmacro.h"
+#include "jls/format.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @ingroup jls
+ * @defgroup jls_shared_cache Shared chunk cache
+ *
+ * @brief Cross-process chunk cache in named shared memory.
+ *
+ * Co-resident processes (UI, exporter, alerting) that read the same
+ * file each pay the CRC check and payload staging even when the OS
+ * page cache already holds the raw bytes.  This cache places validated
+ * chunk payloads in a shared memory segment so one physical read and
+ * CRC check serves every attached reader on the host.
+ *
+ * The segment is a direct-mapped slot table.  Each slot is guarded by
+ * a seqlock: writers claim the slot by moving the sequence number to
+ * odd and publish by moving it to the next even value; readers copy
+ * the slot and verify the sequence number is even and unchanged across
+ * the copy.  There is no daemon and no cross-process blocking: a
+ * contended or torn slot simply reads as a miss and the caller falls
+ * back to the file.
+ *
+ * @{
+ */
+
+JLS_CPP_GUARD_START
+
+/// The opaque shared cache attachment.
+struct jls_shared_cache_s;
+
+/**
+ * @brief Attach to (or create) a shared chunk cache.
+ *
+ * @param[out] instance The attached shared cache.
+ * @param name The host-wide cache name shared by the cooperating
+ *      processes, see jls_bk_shm_open().
+ * @param size The total segment size in bytes, on which all attached
+ *      processes must agree.
+ * @return 0 or error code.
+ */
+int32_t jls_shared_cache_open(struct jls_shared_cache_s ** instance,
+                              const char * name, int64_t size);
+
+/**
+ * @brief Detach from a shared chunk cache.
+ *
+ * @param self The shared cache attachment.
+ *
+ * The segment and its contents remain available to other attached
+ * processes.
+ */
+void jls_shared_cache_close(struct jls_shared_cache_s * self);
+
+/**
+ * @brief Get a cached chunk.
+ *
+ * @param self The shared cache attachment.
+ * @param file_id The file identity, identical across processes reading
+ *      the same file.
+ * @param offset The chunk file offset.
+ * @param[out] hdr The cached chunk header.
+ * @param[out] payload The buffer for the cached payload.
+ * @param payload_max The payload buffer size in bytes.
+ * @return 0, JLS_ERROR_NOT_FOUND on cache miss, or JLS_ERROR_TOO_BIG
+ *      when payload_max is too small for hdr->payload_length, in which
+ *      case hdr is valid and the caller may retry with a larger buffer.
+ */
+int32_t jls_shared_cache_get(struct jls_shared_cache_s * self,
+                             uint64_t file_id, int64_t offset,
+                             struct jls_chunk_header_s * hdr,
+                             uint8_t * payload, uint32_t payload_max);
+
+/**
+ * @brief Add a chunk to the cache.
+ *
+ * @param self The shared cache attachment.
+ * @param file_id The file identity.
+ * @param offset The chunk file offset.
+ * @param hdr The chunk header.
+ * @param payload The payload of hdr->payload_length bytes, which is copied.
+ * @return 0 or error code.
+ *
+ * Chunks too large for a slot and slots contended by another writer
+ * are silently skipped: the cache is best effort.
+ */
+int32_t jls_shared_cache_put(struct jls_shared_cache_s * self,
+                             uint64_t file_id, int64_t offset,
+                             const struct jls_chunk_header_s * hdr,
+                             const uint8_t * payload);
+
+JLS_CPP_GUARD_END
+
+/** @} */
+
+#endif  /* JLS_SHARED_CACHE_H__ */
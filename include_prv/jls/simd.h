@@ -0,0 +1,75 @@
+/*
+ * Copyright 2021-2025 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief SIMD capability detection for kernel dispatch.
+ */
+
+#ifndef JLS_PRIV_SIMD_H__
+#define JLS_PRIV_SIMD_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @ingroup jls
+ * @defgroup jls_simd SIMD
+ *
+ * @brief SIMD capability detection for kernel dispatch.
+ *
+ * @{
+ */
+
+/**
+ * @brief The SIMD capability levels, in increasing vector width.
+ *
+ * The levels beyond JLS_SIMD_LEVEL_SSE2 only apply to x86-64, where
+ * the wider instruction sets are optional.  On aarch64, NEON is
+ * architecturally required and the kernels select it at compile time,
+ * so jls_simd_level() reports JLS_SIMD_LEVEL_SW.
+ */
+enum jls_simd_level_e {
+    JLS_SIMD_LEVEL_SW = 0,      ///< Portable scalar kernels.
+    JLS_SIMD_LEVEL_SSE2 = 1,    ///< SSE2, the x86-64 baseline.
+    JLS_SIMD_LEVEL_AVX2 = 2,    ///< AVX2, 256-bit vectors.
+    JLS_SIMD_LEVEL_AVX512 = 3,  ///< AVX-512 F, 512-bit vectors.
+};
+
+/**
+ * @brief Get the SIMD capability level for kernel dispatch.
+ *
+ * @return The capability level.
+ *
+ * The hardware support is detected once on first use and cached.
+ * The JLS_SIMD_LEVEL environment variable, when set to a level name
+ * ("sw", "sse2", "avx2", "avx512") or number (0-3), lowers the
+ * reported level for benchmarking kernel variants against each other.
+ * The override cannot raise the level above the detected hardware
+ * support.  Set the environment variable before the first kernel
+ * invocation in the process.
+ */
+enum jls_simd_level_e jls_simd_level(void);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  /* JLS_PRIV_SIMD_H__ */
@@ -0,0 +1,146 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief JLS statistics sidecar cache.
+ */
+
+#ifndef JLS_STAT_CACHE_H__
+#define JLS_STAT_CACHE_H__
+
+#include "jls/cmacro.h"
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @ingroup jls
+ * @defgroup jls_stat_cache Statistics sidecar cache
+ *
+ * @brief Persisted cache for composed FSR statistics results, keyed
+ *      by (signal_id, start_sample_id, increment, length).
+ *
+ * Analysts reopen the same large files across sessions, and the first
+ * plot render repeats the same statistics queries each time.  This
+ * cache stores the query results in a sidecar file so the next open
+ * serves them from memory without touching the JLS file.  The sidecar
+ * records an identity hash of the JLS file so results from a modified
+ * or different file are discarded, not served.
+ *
+ * The cache is exact-match only: a query with a different start,
+ * increment, or length recomputes from the JLS file.  Interactive
+ * sessions rerun identical queries because plot geometry is stable,
+ * which is the case this accelerates.
+ *
+ * @{
+ */
+
+JLS_CPP_GUARD_START
+
+/// The maximum entries (output rows) cached per query result.
+#define JLS_STAT_CACHE_ENTRY_LENGTH_MAX (65536)
+
+/// The default total data budget in bytes, evicting oldest first.
+#define JLS_STAT_CACHE_BYTES_DEFAULT (64 * 1024 * 1024)
+
+/// The opaque statistics cache object.
+struct jls_stat_cache_s;
+
+/**
+ * @brief Compute the JLS file identity for sidecar validation.
+ *
+ * @param jls_path The JLS file path.
+ * @param[out] file_id The identity hash, valid on return 0.
+ * @return 0 or error code.
+ *
+ * Hashes the file length and the file head, which changes whenever
+ * a file is rewritten, appended, or repaired in place.
+ */
+int32_t jls_stat_cache_file_id(const char * jls_path, uint64_t * file_id);
+
+/**
+ * @brief Open a statistics cache, loading the sidecar if valid.
+ *
+ * @param[out] instance The new cache instance.
+ * @param path The sidecar file path, copied by this instance.
+ * @param file_id The JLS file identity from jls_stat_cache_file_id().
+ * @return 0 or error code.
+ *
+ * A missing, corrupt, or mismatched sidecar opens an empty cache;
+ * only allocation and parameter failures return an error.
+ */
+int32_t jls_stat_cache_open(struct jls_stat_cache_s ** instance,
+                            const char * path, uint64_t file_id);
+
+/**
+ * @brief Look up a cached statistics result.
+ *
+ * @param self The cache instance.
+ * @param signal_id The signal id.
+ * @param start_sample_id The query start sample id.
+ * @param increment The query increment in samples.
+ * @param[out] data The statistics output, length * JLS_SUMMARY_FSR_COUNT
+ *      doubles, only modified on return 0.
+ * @param data_length The number of output entries.
+ * @return 0 on hit or JLS_ERROR_NOT_FOUND on miss.
+ */
+int32_t jls_stat_cache_get(struct jls_stat_cache_s * self, uint16_t signal_id,
+                           int64_t start_sample_id, int64_t increment,
+                           double * data, int64_t data_length);
+
+/**
+ * @brief Store a statistics result, evicting oldest over budget.
+ *
+ * @param self The cache instance.
+ * @param signal_id The signal id.
+ * @param start_sample_id The query start sample id.
+ * @param increment The query increment in samples.
+ * @param data The statistics, length * JLS_SUMMARY_FSR_COUNT doubles.
+ * @param data_length The number of entries, at most
+ *      JLS_STAT_CACHE_ENTRY_LENGTH_MAX.
+ * @return 0 or error code.
+ *
+ * Storing an existing key replaces its data.
+ */
+int32_t jls_stat_cache_put(struct jls_stat_cache_s * self, uint16_t signal_id,
+                           int64_t start_sample_id, int64_t increment,
+                           const double * data, int64_t data_length);
+
+/**
+ * @brief Write the cache contents to the sidecar file.
+ *
+ * @param self The cache instance.
+ * @return 0 or error code.
+ *
+ * Writes to a temporary file first and renames over the sidecar so a
+ * concurrent open never sees a partial file.  Unmodified caches skip
+ * the write.
+ */
+int32_t jls_stat_cache_save(struct jls_stat_cache_s * self);
+
+/**
+ * @brief Save and free a statistics cache.
+ *
+ * @param self The cache instance, or NULL (ignored).
+ */
+void jls_stat_cache_close(struct jls_stat_cache_s * self);
+
+JLS_CPP_GUARD_END
+
+/** @} */
+
+#endif  /* JLS_STAT_CACHE_H__ */
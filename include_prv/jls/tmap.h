@@ -48,6 +48,10 @@ extern "C" {
 struct jls_tmap_s;
 
 struct jls_tmap_s * jls_tmap_alloc(double sample_rate);
+
+/// Create an independent deep copy, or NULL on error.
+struct jls_tmap_s * jls_tmap_copy(const struct jls_tmap_s * src);
+
 void jls_tmap_free(struct jls_tmap_s * self);
 
 int32_t jls_tmap_add_cbk(void * user_data, const struct jls_utc_summary_entry_s * utc, uint32_t size);
@@ -55,6 +59,37 @@ int32_t jls_tmap_add(struct jls_tmap_s * self, int64_t sample_id, int64_t timest
 int32_t jls_tmap_sample_id_to_timestamp(struct jls_tmap_s * self, int64_t sample_id, int64_t * timestamp);
 int32_t jls_tmap_timestamp_to_sample_id(struct jls_tmap_s * self, int64_t timestamp, int64_t * sample_id);
 
+/**
+ * @brief Convert an array of sample_ids to timestamps.
+ *
+ * @param self The instance.
+ * @param sample_ids The sample_ids to convert.
+ * @param[out] timestamps The timestamp for each entry in sample_ids.
+ * @param count The number of entries in sample_ids and timestamps.
+ * @return 0 or error code.
+ *
+ * Equivalent to calling jls_tmap_sample_id_to_timestamp() per entry,
+ * but each run within one time map segment binary searches once and
+ * then interpolates, which matters when converting millions of
+ * mostly-ordered values.
+ */
+int32_t jls_tmap_sample_id_to_timestamp_batch(struct jls_tmap_s * self, int64_t const * sample_ids,
+                                              int64_t * timestamps, size_t count);
+
+/**
+ * @brief Convert an array of timestamps to sample_ids.
+ *
+ * @param self The instance.
+ * @param timestamps The timestamps to convert.
+ * @param[out] sample_ids The sample_id for each entry in timestamps.
+ * @param count The number of entries in timestamps and sample_ids.
+ * @return 0 or error code.
+ *
+ * See jls_tmap_sample_id_to_timestamp_batch().
+ */
+int32_t jls_tmap_timestamp_to_sample_id_batch(struct jls_tmap_s * self, int64_t const * timestamps,
+                                              int64_t * sample_ids, size_t count);
+
 
 /** @} */
 
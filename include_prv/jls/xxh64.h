@@ -0,0 +1,60 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief XXH64 fast non-cryptographic hash.
+ */
+
+#ifndef JLS_PRIV_XXH64_H__
+#define JLS_PRIV_XXH64_H__
+
+#include <stdint.h>
+#include <stddef.h>
+#include "jls/cmacro.h"
+
+/**
+ * @ingroup jls
+ * @defgroup jls_xxh64 XXH64
+ *
+ * @brief XXH64 fast non-cryptographic hash.
+ *
+ * This implementation follows the public XXH64 specification with
+ * seed 0, see https://github.com/Cyan4973/xxHash.  It exists for the
+ * JLS_CHECKSUM_XXH64 payload check value, which computes an order of
+ * magnitude faster than the software CRC-32C fallback on platforms
+ * without hardware CRC instructions.
+ *
+ * @{
+ */
+
+JLS_CPP_GUARD_START
+
+/**
+ * @brief Compute the XXH64 hash with seed 0.
+ *
+ * @param data The data to hash.
+ * @param length The length of data in bytes.
+ * @return The 64-bit hash.
+ */
+uint64_t jls_xxh64(const uint8_t * data, size_t length);
+
+JLS_CPP_GUARD_END
+
+/** @} */
+
+#endif  /* JLS_PRIV_XXH64_H__ */
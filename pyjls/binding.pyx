@@ -23,8 +23,12 @@ Python binding for the native JLS implementation.
 from libc.stdint cimport uint8_t, uint16_t, uint32_t, uint64_t, int32_t, int64_t
 from libc.float cimport DBL_MAX
 from libc.math cimport isfinite, NAN
+from libc.stdlib cimport realloc, free
+from libc.string cimport memcpy, memset
+from cpython.ref cimport Py_INCREF, Py_DECREF
 
 from collections.abc import Mapping
+import asyncio
 import json
 import logging
 import numpy as np
@@ -33,6 +37,8 @@ cimport numpy as np
 from . cimport c_jls
 from .structs import SourceDef, SignalDef
 
+np.import_array()
+
 
 __all__ = ['DataType', 'AnnotationType', 'SignalType', 'Writer', 'Reader',
            'SourceDef', 'SignalDef', 'SummaryFSR', 'jls_inject_log',
@@ -428,8 +434,14 @@ cdef class Writer:
 
         :param signal_id: The signal id for the data.
         :param sample_id: The sample id for the first sample in data.
-        :param data: The data to add.
+        :param data: The 1-D data to add.  Sample data types accept
+            any stride.  Packed u1 and u4 data must be C-contiguous.
         :raise: On error.
+
+        When the writer queue has space, the samples are copied exactly
+        once with the GIL released, directly into the queue through
+        jls_twr_fsr_reserve() / jls_twr_fsr_commit().  No staging array
+        is allocated, even for non-contiguous data.
         """
         cdef c_jls.jls_twr_s * wr = self._wr
         cdef uint16_t signal_id_u16 = signal_id
@@ -439,19 +451,47 @@ cdef class Writer:
         cdef uint32_t data_type
         cdef uint32_t entry_size_bits
         cdef uint32_t length
+        cdef np.ndarray arr
+        cdef const uint8_t * src
+        cdef uint8_t * dst
+        cdef void * buffer = NULL
+        cdef int64_t stride
+        cdef int64_t itemsize
+        cdef uint32_t i
 
         data_type = self._signals[signal_id].data_type
         entry_size_bits = (data_type >> 8) & 0xff
         np_type = _data_type_map[data_type & 0xffff]
         if np_type != data.dtype:
             raise ValueError(f'Data type mismatch {data.dtype} != {np_type}')
-        data_u8 = data.view(dtype=np.uint8)
-        u8 = data_u8
         length = len(data)
         if entry_size_bits == 4:
             length *= 2
         elif entry_size_bits == 1:
             length *= 8
+        elif (data.ndim == 1) and (length > 0):
+            # sample-aligned types: reserve queue space and copy once
+            # from the (possibly strided) source with the GIL released
+            arr = data
+            src = <const uint8_t *> np.PyArray_DATA(arr)
+            stride = data.strides[0]
+            itemsize = data.itemsize
+            with nogil:
+                rc = c_jls.jls_twr_fsr_reserve(wr, signal_id_u16, length, &buffer)
+                if 0 == rc:
+                    dst = <uint8_t *> buffer
+                    if stride == itemsize:
+                        memcpy(dst, src, length * itemsize)
+                    else:
+                        for i in range(length):
+                            memcpy(dst + i * itemsize, src + i * stride, itemsize)
+                    rc = c_jls.jls_twr_fsr_commit(wr, signal_id_u16, sample_id_i64, length)
+            if 0 == rc:
+                return
+            # queue full or reservation unavailable: block in the copying path
+            data = np.ascontiguousarray(data)
+        data_u8 = data.view(dtype=np.uint8)
+        u8 = data_u8
         with nogil:
             rc = c_jls.jls_twr_fsr(wr, signal_id_u16, sample_id_i64, &u8[0], length)
         _handle_rc('fsr', rc)
@@ -529,6 +569,168 @@ cdef class AnnotationCallback:
         self.cbk_fn = cbk_fn
 
 
+ANNOTATION_DTYPE = np.dtype([
+    ('timestamp', np.int64),
+    ('y', np.float32),
+    ('annotation_type', np.uint8),
+    ('group_id', np.uint8),
+    ('storage_type', np.uint8),
+    ('data_offset', np.int64),
+    ('data_size', np.uint32),
+])
+"""The structured dtype returned by :meth:`Reader.annotations_array`."""
+
+
+cdef struct _anno_acc_s:
+    int64_t count
+    int64_t alloc
+    int64_t payload_size
+    int64_t payload_alloc
+    int64_t * timestamp
+    float * y
+    uint8_t * annotation_type
+    uint8_t * group_id
+    uint8_t * storage_type
+    int64_t * data_offset
+    uint32_t * data_size
+    uint8_t * payload
+    int32_t error
+
+
+cdef void _anno_acc_free(_anno_acc_s * acc) noexcept:
+    free(acc.timestamp)
+    free(acc.y)
+    free(acc.annotation_type)
+    free(acc.group_id)
+    free(acc.storage_type)
+    free(acc.data_offset)
+    free(acc.data_size)
+    free(acc.payload)
+    memset(acc, 0, sizeof(_anno_acc_s))
+
+
+cdef int32_t _anno_acc_grow(_anno_acc_s * acc) noexcept nogil:
+    cdef int64_t alloc = 1024 if acc.alloc == 0 else acc.alloc * 2
+    cdef void * p
+    p = realloc(acc.timestamp, alloc * sizeof(int64_t))
+    if p == NULL:
+        return 1
+    acc.timestamp = <int64_t *> p
+    p = realloc(acc.y, alloc * sizeof(float))
+    if p == NULL:
+        return 1
+    acc.y = <float *> p
+    p = realloc(acc.annotation_type, alloc * sizeof(uint8_t))
+    if p == NULL:
+        return 1
+    acc.annotation_type = <uint8_t *> p
+    p = realloc(acc.group_id, alloc * sizeof(uint8_t))
+    if p == NULL:
+        return 1
+    acc.group_id = <uint8_t *> p
+    p = realloc(acc.storage_type, alloc * sizeof(uint8_t))
+    if p == NULL:
+        return 1
+    acc.storage_type = <uint8_t *> p
+    p = realloc(acc.data_offset, alloc * sizeof(int64_t))
+    if p == NULL:
+        return 1
+    acc.data_offset = <int64_t *> p
+    p = realloc(acc.data_size, alloc * sizeof(uint32_t))
+    if p == NULL:
+        return 1
+    acc.data_size = <uint32_t *> p
+    acc.alloc = alloc
+    return 0
+
+
+cdef int32_t _annotation_acc_cbk_fn(void * user_data, const c_jls.jls_annotation_s * annotation) noexcept nogil:
+    cdef _anno_acc_s * acc = <_anno_acc_s *> user_data
+    cdef int64_t payload_alloc
+    cdef void * p
+    if acc.count >= acc.alloc:
+        if _anno_acc_grow(acc):
+            acc.error = 1
+            return 1
+    if (acc.payload_size + annotation.data_size) > acc.payload_alloc:
+        payload_alloc = 4096 if acc.payload_alloc == 0 else acc.payload_alloc
+        while payload_alloc < (acc.payload_size + annotation.data_size):
+            payload_alloc *= 2
+        p = realloc(acc.payload, payload_alloc)
+        if p == NULL:
+            acc.error = 1
+            return 1
+        acc.payload = <uint8_t *> p
+        acc.payload_alloc = payload_alloc
+    acc.timestamp[acc.count] = annotation.timestamp
+    acc.y[acc.count] = annotation.y
+    acc.annotation_type[acc.count] = annotation.annotation_type
+    acc.group_id[acc.count] = annotation.group_id
+    acc.storage_type[acc.count] = annotation.storage_type
+    acc.data_offset[acc.count] = acc.payload_size
+    acc.data_size[acc.count] = annotation.data_size
+    if annotation.data_size:
+        memcpy(acc.payload + acc.payload_size, annotation.data, annotation.data_size)
+        acc.payload_size += annotation.data_size
+    acc.count += 1
+    return 0
+
+
+cdef struct _utc_acc_s:
+    int64_t count
+    int64_t alloc
+    int64_t * entries
+    int32_t error
+
+
+cdef int32_t _utc_acc_cbk_fn(void * user_data, const c_jls.jls_utc_summary_entry_s * utc, uint32_t size) noexcept nogil:
+    cdef _utc_acc_s * acc = <_utc_acc_s *> user_data
+    cdef int64_t alloc
+    cdef void * p
+    if (acc.count + size) > acc.alloc:
+        alloc = 1024 if acc.alloc == 0 else acc.alloc
+        while alloc < (acc.count + size):
+            alloc *= 2
+        p = realloc(acc.entries, alloc * 2 * sizeof(int64_t))
+        if p == NULL:
+            acc.error = 1
+            return 1
+        acc.entries = <int64_t *> p
+        acc.alloc = alloc
+    # jls_utc_summary_entry_s is two contiguous int64 fields
+    memcpy(acc.entries + 2 * acc.count, utc, size * 2 * sizeof(int64_t))
+    acc.count += size
+    return 0
+
+
+cdef class _FsrAsyncRequest:
+    # keeps the destination array alive until the C completion callback runs
+    cdef object loop
+    cdef object future
+    cdef object data
+
+    def _complete(self, return_code):
+        if self.future.cancelled():
+            return
+        if return_code == 0:
+            self.future.set_result(self.data)
+        else:
+            try:
+                _handle_rc('rd_fsr_async', return_code)
+            except RuntimeError as ex:
+                self.future.set_exception(ex)
+
+
+cdef void _fsr_async_cbk_fn(void * user_data, int32_t return_code) noexcept with gil:
+    # runs on the C async worker thread: hop to the event loop thread
+    req = <_FsrAsyncRequest> user_data
+    try:
+        req.loop.call_soon_threadsafe(req._complete, return_code)
+    except Exception:
+        logging.getLogger(__name__).exception('fsr_async completion dropped')
+    Py_DECREF(req)
+
+
 cdef class Reader:
     """Open a JLS v2 file for reading.
 
@@ -594,7 +796,11 @@ cdef class Reader:
 
     def close(self):
         """Close the JLS file and free all resources."""
-        c_jls.jls_rd_close(self._rd)
+        cdef c_jls.jls_rd_s * rd = self._rd
+        # release the GIL: outstanding fsr_async completion callbacks
+        # acquire it before jls_rd_close() can join the worker
+        with nogil:
+            c_jls.jls_rd_close(rd)
 
     @property
     def sources(self) -> Mapping[int, SourceDef]:
@@ -719,6 +925,114 @@ cdef class Reader:
         _handle_rc('rd_fsr', rc)
         return data
 
+    def fsr_into(self, signal_id, start_sample_id, out):
+        """Read FSR data into a caller-owned, preallocated array.
+
+        :param signal_id: The signal id.
+        :param start_sample_id: The starting sample id to read.
+        :param out: The preallocated, C-contiguous NumPy array to fill.
+            The dtype must match the signal data type.
+            u1 and u4 signals use np.uint8 arrays holding the
+            packed samples: each output byte holds 8 u1 samples or
+            2 u4 samples, as with :meth:`fsr`.
+        :return: The number of samples read, which fills out.
+        :raise ValueError: If out is not compatible with the signal.
+
+        Unlike :meth:`fsr`, this method does not allocate and releases
+        the GIL for the entire read, so multithreaded readers into
+        preallocated buffers scale with cores.
+        """
+
+        cdef int32_t rc
+        cdef np.uint8_t [::1] u8
+        cdef uint32_t data_type
+        cdef uint32_t entry_size_bits
+        cdef uint16_t signal_id_u16 = signal_id
+        cdef int64_t start_sample_id_i64 = start_sample_id
+        cdef int64_t length_i64
+
+        data_type = self._signals[signal_id].data_type
+        entry_size_bits = (data_type >> 8) & 0xff
+        np_type = np.dtype(_data_type_map[data_type & 0xffff])
+        if not out.flags.c_contiguous:
+            raise ValueError('out must be C-contiguous')
+        if entry_size_bits == 4:
+            if out.dtype != np.uint8:
+                raise ValueError(f'u4 signal requires uint8 out, not {out.dtype}')
+            length_i64 = out.size * 2
+        elif entry_size_bits == 1:
+            if out.dtype != np.uint8:
+                raise ValueError(f'u1 signal requires uint8 out, not {out.dtype}')
+            length_i64 = out.size * 8
+        else:
+            if out.dtype != np_type:
+                raise ValueError(f'out dtype {out.dtype} does not match signal dtype {np_type}')
+            length_i64 = out.size
+        if length_i64 <= 0:
+            raise ValueError('out is empty')
+
+        u8 = out.view(np.uint8).reshape(-1)
+        with nogil:
+            rc = c_jls.jls_rd_fsr(self._rd, signal_id_u16, start_sample_id_i64, &u8[0], length_i64)
+        _handle_rc('rd_fsr', rc)
+        return length_i64
+
+    def fsr_async(self, signal_id, start_sample_id, length):
+        """Read FSR data without blocking the asyncio event loop.
+
+        :param signal_id: The signal id.
+        :param start_sample_id: The starting sample id to read.
+        :param length: The number of samples to read.
+        :return: An awaitable resolving to the data, formatted as for
+            :meth:`fsr`.  On read error, awaiting raises RuntimeError.
+
+        Call from a running event loop and await the result::
+
+            data = await reader.fsr_async(signal_id, 0, 1000)
+
+        Unlike wrapping :meth:`fsr` in run_in_executor, the read runs
+        on this reader's dedicated C worker thread with no executor
+        contention and no extra copy: the C read fills the returned
+        array directly and the completion callback resolves the
+        awaitable.  Requests complete in submission order.  Closing
+        the reader fails outstanding awaitables with RuntimeError.
+        """
+        cdef int32_t rc
+        cdef np.uint8_t [::1] u8
+        cdef uint32_t data_type
+        cdef uint32_t entry_size_bits
+        cdef uint32_t u8_length
+        cdef uint16_t signal_id_u16 = signal_id
+        cdef int64_t start_sample_id_i64 = start_sample_id
+        cdef int64_t length_i64 = length
+        cdef _FsrAsyncRequest req
+
+        loop = asyncio.get_running_loop()
+        data_type = self._signals[signal_id].data_type
+        entry_size_bits = (data_type >> 8) & 0xff
+        np_type = _data_type_map[data_type & 0xffff]
+        u8_length = length
+        if entry_size_bits == 4:
+            u8_length = (length + 1) // 2
+        elif entry_size_bits == 1:
+            u8_length = (length + 7) // 8
+        else:
+            u8_length *= entry_size_bits // 8
+
+        data_u8 = np.empty(u8_length, dtype=np.uint8)
+        u8 = data_u8
+        req = _FsrAsyncRequest()
+        req.loop = loop
+        req.future = loop.create_future()
+        req.data = data_u8.view(dtype=np_type)
+        Py_INCREF(req)  # the completion callback owns this reference
+        rc = c_jls.jls_rd_fsr_async(self._rd, signal_id_u16, start_sample_id_i64,
+                                    &u8[0], length_i64, _fsr_async_cbk_fn, <void *> req)
+        if rc:
+            Py_DECREF(req)
+            _handle_rc('rd_fsr_async', rc)
+        return req.future
+
     def fsr_statistics(self, signal_id, start_sample_id, increment, length):
         """Read FSR statistics (mean, stdev, min, max).
 
@@ -774,6 +1088,54 @@ cdef class Reader:
         rc = c_jls.jls_rd_annotations(self._rd, signal_id, timestamp, _annotation_cbk_fn, <void *> user_data)
         _handle_rc('rd_annotations', rc)
 
+    def annotations_array(self, signal_id, timestamp=0):
+        """Read annotations from a signal into structured arrays.
+
+        :param signal_id: The signal id.
+        :param timestamp: The starting timestamp.  FSR uses sample_id.  VSR uses utc.
+        :return: (annotations, payload).
+            annotations is a NumPy structured array with dtype
+            :data:`ANNOTATION_DTYPE`: timestamp, y, annotation_type,
+            group_id, storage_type, data_offset, data_size.
+            payload is a np.uint8 array holding the concatenated
+            annotation data.  The data bytes for annotation i are
+            payload[data_offset[i]:data_offset[i] + data_size[i]],
+            encoded according to storage_type.
+            y is NAN when not specified.
+
+        Unlike :meth:`annotations`, accumulation happens in C without
+        a Python callback crossing per annotation, which is much faster
+        for captures with millions of annotations.
+        """
+        cdef int32_t rc
+        cdef _anno_acc_s acc
+        cdef uint16_t signal_id_u16 = signal_id
+        cdef int64_t timestamp_i64 = timestamp
+        memset(&acc, 0, sizeof(acc))
+        with nogil:
+            rc = c_jls.jls_rd_annotations(self._rd, signal_id_u16, timestamp_i64,
+                                          _annotation_acc_cbk_fn, <void *> &acc)
+        try:
+            if acc.error:
+                raise MemoryError('annotations_array accumulation failed')
+            _handle_rc('rd_annotations', rc)
+            count = acc.count
+            annotations = np.empty(count, dtype=ANNOTATION_DTYPE)
+            payload = np.empty(acc.payload_size, dtype=np.uint8)
+            if count:
+                annotations['timestamp'] = <int64_t[:count]> acc.timestamp
+                annotations['y'] = <float[:count]> acc.y
+                annotations['annotation_type'] = <uint8_t[:count]> acc.annotation_type
+                annotations['group_id'] = <uint8_t[:count]> acc.group_id
+                annotations['storage_type'] = <uint8_t[:count]> acc.storage_type
+                annotations['data_offset'] = <int64_t[:count]> acc.data_offset
+                annotations['data_size'] = <uint32_t[:count]> acc.data_size
+            if acc.payload_size:
+                payload[:] = <uint8_t[:acc.payload_size]> acc.payload
+            return annotations, payload
+        finally:
+            _anno_acc_free(&acc)
+
     def user_data(self, cbk_fn):
         """Get the user data.
 
@@ -800,6 +1162,35 @@ cdef class Reader:
         rc = c_jls.jls_rd_utc(self._rd, signal_id, sample_id, _utc_cbk_fn, <void *> cbk_fn)
         _handle_rc(f'rd_utc({signal_id}, {sample_id})', rc)
 
+    def utc_array(self, signal_id, sample_id=0):
+        """Read the sample_id / utc pairs from a FSR signal into one array.
+
+        :param signal_id: The signal id.
+        :param sample_id: The starting sample_id.
+        :return: The Nx2 numpy array of [sample_id, utc_timestamp].
+
+        Unlike :meth:`utc`, accumulation happens in C without a Python
+        callback crossing per entry block.
+        """
+        cdef int32_t rc
+        cdef _utc_acc_s acc
+        cdef uint16_t signal_id_u16 = signal_id
+        cdef int64_t sample_id_i64 = sample_id
+        memset(&acc, 0, sizeof(acc))
+        with nogil:
+            rc = c_jls.jls_rd_utc(self._rd, signal_id_u16, sample_id_i64,
+                                  _utc_acc_cbk_fn, <void *> &acc)
+        try:
+            if acc.error:
+                raise MemoryError('utc_array accumulation failed')
+            _handle_rc(f'rd_utc({signal_id}, {sample_id})', rc)
+            entries = np.empty((acc.count, 2), dtype=np.int64)
+            if acc.count:
+                entries.reshape(-1)[:] = <int64_t[:2 * acc.count]> acc.entries
+            return entries
+        finally:
+            free(acc.entries)
+
     def sample_id_to_timestamp(self, signal_id, sample_id):
         """Convert sample_id to UTC timestamp for FSR signals.
 
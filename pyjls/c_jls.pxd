@@ -112,6 +112,10 @@ cdef extern from "jls/threaded_writer.h":
             jls_storage_type_e storage_type, const uint8_t * data, uint32_t data_size) nogil
     int32_t jls_twr_fsr(jls_twr_s * self, uint16_t signal_id,
             int64_t sample_id, const void * data, uint32_t data_length) nogil
+    int32_t jls_twr_fsr_reserve(jls_twr_s * self, uint16_t signal_id,
+            uint32_t sample_count, void ** buffer) nogil
+    int32_t jls_twr_fsr_commit(jls_twr_s * self, uint16_t signal_id,
+            int64_t sample_id, uint32_t sample_count) nogil
     int32_t jls_twr_fsr_omit_data(jls_twr_s * self, uint16_t signal_id, uint32_t enable)
     int32_t jls_twr_annotation(jls_twr_s * self, uint16_t signal_id,
             int64_t timestamp,
@@ -133,6 +137,9 @@ cdef extern from "jls/reader.h":
     int32_t jls_rd_signal(jls_rd_s * self, uint16_t signal_id, jls_signal_def_s * signal)
     int32_t jls_rd_fsr_length(jls_rd_s * self, uint16_t signal_id, int64_t * samples)
     int32_t jls_rd_fsr(jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id, void * data, int64_t data_length) nogil
+    ctypedef void (*jls_rd_fsr_async_cbk_fn)(void * user_data, int32_t return_code)
+    int32_t jls_rd_fsr_async(jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
+        void * data, int64_t data_length, jls_rd_fsr_async_cbk_fn cbk_fn, void * cbk_user_data) nogil
     int32_t jls_rd_fsr_statistics(jls_rd_s * self, uint16_t signal_id,
         int64_t start_sample_id, int64_t increment, double * data, int64_t data_length) nogil
     ctypedef int32_t (*jls_rd_annotation_cbk_fn)(void * user_data, const jls_annotation_s * annotation)
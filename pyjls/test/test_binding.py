@@ -13,6 +13,7 @@
 # limitations under the License.
 
 from pyjls.binding import SECOND, Writer, Reader, SummaryFSR, DataType, jls_inject_log, copy
+import asyncio
 import io
 import logging
 from logging import StreamHandler
@@ -107,6 +108,52 @@ class TestBinding(unittest.TestCase):
             np.testing.assert_allclose(np.max(data), stats[0, SummaryFSR.MAX])
             np.testing.assert_allclose(np.std(data, ddof=1), stats[0, SummaryFSR.STD], rtol=1e-6)
 
+    def test_fsr_f32_strided(self):
+        interleaved = np.arange(20000, dtype=np.float32).reshape(-1, 2)
+        data = interleaved[:, 0]  # non-contiguous view
+        with Writer(self._path) as w:
+            w.source_def(source_id=1, name='name', vendor='vendor', model='model',
+                         version='version', serial_number='serial_number')
+            w.signal_def(3, source_id=1, sample_rate=1000000, name='current', units='A')
+            w.fsr(3, 0, data)
+
+        with Reader(self._path) as r:
+            np.testing.assert_allclose(np.ascontiguousarray(data), r.fsr(3, 0, len(data)))
+
+    def test_fsr_into(self):
+        data = np.arange(110000, dtype=np.float32)
+        with Writer(self._path) as w:
+            w.source_def(source_id=1, name='name', vendor='vendor', model='model',
+                         version='version', serial_number='serial_number')
+            w.signal_def(3, source_id=1, sample_rate=1000000, name='current', units='A')
+            w.fsr(3, 0, data)
+
+        with Reader(self._path) as r:
+            out = np.empty(1000, dtype=np.float32)
+            self.assertEqual(1000, r.fsr_into(3, 100, out))
+            np.testing.assert_allclose(data[100:1100], out)
+            with self.assertRaises(ValueError):
+                r.fsr_into(3, 0, np.empty(10, dtype=np.float64))
+            with self.assertRaises(ValueError):
+                r.fsr_into(3, 0, np.empty(0, dtype=np.float32))
+
+    def test_fsr_async(self):
+        data = np.arange(110000, dtype=np.float32)
+        with Writer(self._path) as w:
+            w.source_def(source_id=1, name='name', vendor='vendor', model='model',
+                         version='version', serial_number='serial_number')
+            w.signal_def(3, source_id=1, sample_rate=1000000, name='current', units='A')
+            w.fsr(3, 0, data)
+
+        async def _read(r):
+            futures = [r.fsr_async(3, i * 1000, 1000) for i in range(4)]
+            return await asyncio.gather(*futures)
+
+        with Reader(self._path) as r:
+            results = asyncio.run(_read(r))
+            for i, result in enumerate(results):
+                np.testing.assert_allclose(data[i * 1000:(i + 1) * 1000], result)
+
     def test_fsr_u1(self):
         data = np.zeros(1024, dtype=np.uint8)
         data[1::2] = 1
@@ -180,6 +227,24 @@ class TestBinding(unittest.TestCase):
             r.annotations(signal_id, expected[2][0], self._on_annotations)
         self.assertEqual(expected[2:], self.annotations)
 
+    def test_annotation_array(self):
+        signal_id = 3
+        expected = self._annotation_gen(signal_id)
+        with Reader(self._path) as r:
+            annotations, payload = r.annotations_array(signal_id, 0)
+        self.assertEqual(len(expected), len(annotations))
+        for e, a in zip(expected, annotations):
+            self.assertEqual(e[0], a['timestamp'])
+            if e[1] is None:
+                self.assertTrue(np.isnan(a['y']))
+            else:
+                self.assertEqual(e[1], a['y'])
+            self.assertEqual(e[2], a['annotation_type'])
+            self.assertEqual(e[3], a['group_id'])
+        data = bytes(payload[annotations[1]['data_offset']:
+                             annotations[1]['data_offset'] + annotations[1]['data_size']])
+        self.assertEqual(b'annotation binary', data)
+
     def _utc_gen(self, signal_id, sample_id_offset=None):
         sample_id_offset = 0 if sample_id_offset is None else int(sample_id_offset)
         data = []
@@ -213,6 +278,13 @@ class TestBinding(unittest.TestCase):
             os.remove(self._path)
             self._utc = []
 
+    def test_utc_array(self):
+        signal_id = 3
+        expected = self._utc_gen(signal_id)
+        with Reader(self._path) as r:
+            entries = r.utc_array(signal_id, 0)
+        np.testing.assert_equal(expected, entries)
+
     def test_utc_seek(self):
         signal_id = 3
         expected = self._utc_gen(signal_id)
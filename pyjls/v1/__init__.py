@@ -11,3 +11,12 @@
 # WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 # See the License for the specific language governing permissions and
 # limitations under the License.
+
+"""Placeholder for legacy JLS v1 file support.
+
+JLS v1 uses the pyjoulescope datafile container, which is an entirely
+different format from JLS v2 and is not parsed by this package.  Read
+v1 captures with joulescope.data_recorder.DataReader from the
+pyjoulescope package:
+https://github.com/jetperch/pyjoulescope/blob/master/joulescope/data_recorder.py
+"""
@@ -0,0 +1,196 @@
+/*
+ * Copyright 2021-2022 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/backend.h"
+#include "jls/ec.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+#define REGISTRY_SIZE (4)
+#define MEM_ALLOC_MIN (4096)
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+
+void jls_bk_counter_add(volatile uint64_t * counter, uint64_t value) {
+    _InterlockedExchangeAdd64((volatile __int64 *) counter, (__int64) value);
+}
+
+uint64_t jls_bk_counter_load(volatile uint64_t * counter) {
+    return (uint64_t) _InterlockedOr64((volatile __int64 *) counter, 0);
+}
+
+#else
+
+void jls_bk_counter_add(volatile uint64_t * counter, uint64_t value) {
+    // single writer per counter: load + store avoids a locked RMW
+    __atomic_store_n(counter, __atomic_load_n(counter, __ATOMIC_RELAXED) + value,
+                     __ATOMIC_RELAXED);
+}
+
+uint64_t jls_bk_counter_load(volatile uint64_t * counter) {
+    return __atomic_load_n(counter, __ATOMIC_RELAXED);
+}
+
+#endif
+
+static const struct jls_bk_ops_s * registry_[REGISTRY_SIZE];
+
+int32_t jls_bk_register(const struct jls_bk_ops_s * ops) {
+    if ((NULL == ops) || (NULL == ops->prefix) || (0 == ops->prefix[0])
+            || (NULL == ops->open) || (NULL == ops->read)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    for (int i = 0; i < REGISTRY_SIZE; ++i) {
+        if (registry_[i] == ops) {
+            return JLS_ERROR_ALREADY_EXISTS;
+        }
+    }
+    for (int i = 0; i < REGISTRY_SIZE; ++i) {
+        if (NULL == registry_[i]) {
+            registry_[i] = ops;
+            return 0;
+        }
+    }
+    return JLS_ERROR_FULL;
+}
+
+int32_t jls_bk_unregister(const struct jls_bk_ops_s * ops) {
+    for (int i = 0; i < REGISTRY_SIZE; ++i) {
+        if (registry_[i] == ops) {
+            registry_[i] = NULL;
+            return 0;
+        }
+    }
+    return JLS_ERROR_NOT_FOUND;
+}
+
+struct jls_mem_s {
+    uint8_t * data;
+    int64_t size;
+    int64_t alloc;
+};
+
+int32_t jls_mem_alloc(struct jls_mem_s ** mem) {
+    if (NULL == mem) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    *mem = calloc(1, sizeof(struct jls_mem_s));
+    if (NULL == *mem) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    return 0;
+}
+
+void jls_mem_free(struct jls_mem_s * mem) {
+    if (mem) {
+        if (mem->data) {
+            free(mem->data);
+        }
+        free(mem);
+    }
+}
+
+const uint8_t * jls_mem_data(struct jls_mem_s * mem, int64_t * size) {
+    if (NULL == mem) {
+        return NULL;
+    }
+    if (size) {
+        *size = mem->size;
+    }
+    return mem->data;
+}
+
+static int32_t mem_open(struct jls_bkf_s * self, const char * path, const char * mode) {
+    (void) path;  // opened by arena handle, see jls_raw_open_mem()
+    struct jls_mem_s * mem = (struct jls_mem_s *) self->user_data;
+    if ('w' == mode[0]) {
+        mem->size = 0;
+    }
+    self->fend = mem->size;
+    return 0;
+}
+
+static int32_t mem_read(struct jls_bkf_s * self, void * buffer, unsigned int count) {
+    struct jls_mem_s * mem = (struct jls_mem_s *) self->user_data;
+    if ((self->fpos + count) > mem->size) {
+        return JLS_ERROR_IO;
+    }
+    memcpy(buffer, mem->data + self->fpos, count);
+    return 0;
+}
+
+static int32_t mem_write(struct jls_bkf_s * self, const void * buffer, unsigned int count) {
+    struct jls_mem_s * mem = (struct jls_mem_s *) self->user_data;
+    int64_t end = self->fpos + count;
+    if (end > mem->alloc) {
+        int64_t alloc = (mem->alloc < MEM_ALLOC_MIN) ? MEM_ALLOC_MIN : mem->alloc;
+        while (alloc < end) {
+            alloc *= 2;
+        }
+        uint8_t * data = realloc(mem->data, (size_t) alloc);
+        if (NULL == data) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        mem->data = data;
+        mem->alloc = alloc;
+    }
+    memcpy(mem->data + self->fpos, buffer, count);
+    if (end > mem->size) {
+        mem->size = end;
+    }
+    return 0;
+}
+
+static int32_t mem_truncate(struct jls_bkf_s * self) {
+    struct jls_mem_s * mem = (struct jls_mem_s *) self->user_data;
+    if (self->fpos < mem->size) {
+        mem->size = self->fpos;
+    }
+    return 0;
+}
+
+const struct jls_bk_ops_s jls_bk_mem_ops = {
+        .prefix = "",  // opened by arena handle, never by path match
+        .open = mem_open,
+        .close = NULL,
+        .read = mem_read,
+        .write = mem_write,
+        .flush = NULL,
+        .truncate = mem_truncate,
+        .readahead = NULL,
+};
+
+const struct jls_bk_ops_s * jls_bk_ops_match(const char * path) {
+    const struct jls_bk_ops_s * best = NULL;
+    size_t best_length = 0;
+    if (NULL == path) {
+        return NULL;
+    }
+    for (int i = 0; i < REGISTRY_SIZE; ++i) {
+        const struct jls_bk_ops_s * ops = registry_[i];
+        if (NULL == ops) {
+            continue;
+        }
+        size_t length = strlen(ops->prefix);
+        if ((length > best_length) && (0 == strncmp(ops->prefix, path, length))) {
+            best = ops;
+            best_length = length;
+        }
+    }
+    return best;
+}
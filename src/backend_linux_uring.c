@@ -0,0 +1,266 @@
+/*
+ * Copyright 2021-2023 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(__linux__)
+
+#include "jls/backend_uring.h"
+#include "jls/ec.h"
+#include "jls/log.h"
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+
+#define QUEUE_DEPTH (64)  // power of 2, writes in flight before blocking
+
+
+struct slot_s {
+    void * buf;             // owned copy of the caller data
+    struct iovec iov;       // must remain valid until completion
+    uint32_t count;
+    bool in_flight;
+};
+
+struct jls_uring_s {
+    int ring_fd;
+    int fd;
+    uint32_t depth;
+    uint32_t inflight;
+    int32_t error;          // first deferred write error, latched
+
+    // submission queue
+    unsigned * sq_head;
+    unsigned * sq_tail;
+    unsigned * sq_mask;
+    unsigned * sq_array;
+    struct io_uring_sqe * sqes;
+
+    // completion queue
+    unsigned * cq_head;
+    unsigned * cq_tail;
+    unsigned * cq_mask;
+    struct io_uring_cqe * cqes;
+
+    void * sq_ring;
+    size_t sq_ring_sz;
+    void * cq_ring;
+    size_t cq_ring_sz;
+    size_t sqes_sz;
+
+    struct slot_s slots[QUEUE_DEPTH];
+};
+
+static int ring_enter(struct jls_uring_s * self, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    while (1) {
+        int rc = (int) syscall(SYS_io_uring_enter, self->ring_fd, to_submit, min_complete, flags, NULL, 0);
+        if ((rc < 0) && (EINTR == errno)) {
+            continue;
+        }
+        return rc;
+    }
+}
+
+static void reap(struct jls_uring_s * self) {
+    unsigned head = *self->cq_head;
+    while (head != __atomic_load_n(self->cq_tail, __ATOMIC_ACQUIRE)) {
+        struct io_uring_cqe * cqe = &self->cqes[head & *self->cq_mask];
+        struct slot_s * slot = (struct slot_s *) (uintptr_t) cqe->user_data;
+        if ((cqe->res < 0) || ((uint32_t) cqe->res != slot->count)) {
+            if (!self->error) {
+                JLS_LOGE("queued write failed: res=%d, count=%u", cqe->res, slot->count);
+                self->error = JLS_ERROR_IO;
+            }
+        }
+        free(slot->buf);
+        slot->buf = NULL;
+        slot->in_flight = false;
+        --self->inflight;
+        ++head;
+    }
+    __atomic_store_n(self->cq_head, head, __ATOMIC_RELEASE);
+}
+
+int32_t jls_uring_open(struct jls_uring_s ** instance, int fd) {
+    if (!instance || (fd < 0)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_uring_s * self = calloc(1, sizeof(struct jls_uring_s));
+    if (!self) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    self->fd = fd;
+
+    struct io_uring_params p;
+    memset(&p, 0, sizeof(p));
+    self->ring_fd = (int) syscall(SYS_io_uring_setup, QUEUE_DEPTH, &p);
+    if (self->ring_fd < 0) {
+        JLS_LOGD1("io_uring_setup failed %d, using synchronous writes", errno);
+        free(self);
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    self->depth = (p.sq_entries < QUEUE_DEPTH) ? p.sq_entries : QUEUE_DEPTH;
+
+    self->sq_ring_sz = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    self->cq_ring_sz = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (self->cq_ring_sz > self->sq_ring_sz) {
+            self->sq_ring_sz = self->cq_ring_sz;
+        }
+        self->cq_ring_sz = self->sq_ring_sz;
+    }
+    self->sq_ring = mmap(NULL, self->sq_ring_sz, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, self->ring_fd, IORING_OFF_SQ_RING);
+    if (MAP_FAILED == self->sq_ring) {
+        goto fail;
+    }
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        self->cq_ring = self->sq_ring;
+    } else {
+        self->cq_ring = mmap(NULL, self->cq_ring_sz, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, self->ring_fd, IORING_OFF_CQ_RING);
+        if (MAP_FAILED == self->cq_ring) {
+            self->cq_ring = NULL;
+            goto fail;
+        }
+    }
+    self->sqes_sz = p.sq_entries * sizeof(struct io_uring_sqe);
+    self->sqes = mmap(NULL, self->sqes_sz, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, self->ring_fd, IORING_OFF_SQES);
+    if (MAP_FAILED == self->sqes) {
+        self->sqes = NULL;
+        goto fail;
+    }
+
+    uint8_t * sq = (uint8_t *) self->sq_ring;
+    self->sq_head = (unsigned *) (sq + p.sq_off.head);
+    self->sq_tail = (unsigned *) (sq + p.sq_off.tail);
+    self->sq_mask = (unsigned *) (sq + p.sq_off.ring_mask);
+    self->sq_array = (unsigned *) (sq + p.sq_off.array);
+    uint8_t * cq = (uint8_t *) self->cq_ring;
+    self->cq_head = (unsigned *) (cq + p.cq_off.head);
+    self->cq_tail = (unsigned *) (cq + p.cq_off.tail);
+    self->cq_mask = (unsigned *) (cq + p.cq_off.ring_mask);
+    self->cqes = (struct io_uring_cqe *) (cq + p.cq_off.cqes);
+
+    *instance = self;
+    return 0;
+
+fail:
+    JLS_LOGW("io_uring mmap failed %d", errno);
+    if (self->sq_ring && (MAP_FAILED != self->sq_ring)) {
+        munmap(self->sq_ring, self->sq_ring_sz);
+    }
+    if (self->cq_ring && (self->cq_ring != self->sq_ring)) {
+        munmap(self->cq_ring, self->cq_ring_sz);
+    }
+    close(self->ring_fd);
+    free(self);
+    return JLS_ERROR_NOT_SUPPORTED;
+}
+
+int32_t jls_uring_fwrite(struct jls_uring_s * self, int64_t offset,
+                         const void * buffer, uint32_t count, bool ordered) {
+    if (!self || !buffer || !count) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    reap(self);
+    while (self->inflight >= self->depth) {
+        if (ring_enter(self, 0, 1, IORING_ENTER_GETEVENTS) < 0) {
+            JLS_LOGE("io_uring_enter wait failed %d", errno);
+            return JLS_ERROR_IO;
+        }
+        reap(self);
+    }
+
+    struct slot_s * slot = NULL;
+    for (uint32_t i = 0; i < self->depth; ++i) {
+        if (!self->slots[i].in_flight) {
+            slot = &self->slots[i];
+            break;
+        }
+    }
+    slot->buf = malloc(count);
+    if (!slot->buf) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    memcpy(slot->buf, buffer, count);
+    slot->count = count;
+    slot->iov.iov_base = slot->buf;
+    slot->iov.iov_len = count;
+    slot->in_flight = true;
+
+    unsigned tail = *self->sq_tail;
+    unsigned idx = tail & *self->sq_mask;
+    struct io_uring_sqe * sqe = &self->sqes[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_WRITEV;
+    sqe->fd = self->fd;
+    sqe->off = (uint64_t) offset;
+    sqe->addr = (uint64_t) (uintptr_t) &slot->iov;
+    sqe->len = 1;
+    sqe->flags = ordered ? IOSQE_IO_DRAIN : 0;
+    sqe->user_data = (uint64_t) (uintptr_t) slot;
+    self->sq_array[idx] = idx;
+    __atomic_store_n(self->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    ++self->inflight;
+
+    if (ring_enter(self, 1, 0, 0) < 0) {
+        JLS_LOGE("io_uring_enter submit failed %d", errno);
+        free(slot->buf);
+        slot->buf = NULL;
+        slot->in_flight = false;
+        --self->inflight;
+        return JLS_ERROR_IO;
+    }
+    return self->error;
+}
+
+int32_t jls_uring_drain(struct jls_uring_s * self) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    reap(self);
+    while (self->inflight) {
+        if (ring_enter(self, 0, self->inflight, IORING_ENTER_GETEVENTS) < 0) {
+            JLS_LOGE("io_uring_enter drain failed %d", errno);
+            return JLS_ERROR_IO;
+        }
+        reap(self);
+    }
+    return self->error;
+}
+
+int32_t jls_uring_close(struct jls_uring_s * self) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    int32_t rc = jls_uring_drain(self);
+    munmap(self->sqes, self->sqes_sz);
+    if (self->cq_ring != self->sq_ring) {
+        munmap(self->cq_ring, self->cq_ring_sz);
+    }
+    munmap(self->sq_ring, self->sq_ring_sz);
+    close(self->ring_fd);
+    free(self);
+    return rc;
+}
+
+#endif  /* __linux__ */
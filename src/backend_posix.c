@@ -14,8 +14,15 @@
  * limitations under the License.
  */
 
+#if defined(__linux__)
+#define _GNU_SOURCE  // fallocate
+#endif
 #include "jls/backend.h"
+#if defined(__linux__)
+#include "jls/backend_uring.h"
+#endif
 #include "jls/wr_prv.h"
+#include "jls/cdef.h"
 #include "jls/ec.h"
 #include "jls/log.h"
 #include "jls/time.h"
@@ -23,11 +30,16 @@
 #define _FILE_OFFSET_BITS
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
 #include <fcntl.h>
 #include <unistd.h>
 #include <time.h>
 #include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <errno.h>
 
 
@@ -42,6 +54,7 @@ struct jls_bkt_s {
     pthread_mutex_t msg_mutex;
     pthread_mutex_t process_mutex;
     struct event_flag * msg_event;
+    struct event_flag * ack_event;
     pthread_t thread;
 };
 
@@ -83,12 +96,273 @@ static void eventflag_set(struct event_flag* ev) {
     pthread_mutex_unlock(&ev->mutex);
 }
 
+static void eventflag_wait_ms(struct event_flag * ev, uint32_t timeout_ms) {
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += timeout_ms / 1000;
+    ts.tv_nsec += (long) (timeout_ms % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec += 1;
+        ts.tv_nsec -= 1000000000L;
+    }
+    pthread_mutex_lock(&ev->mutex);
+    while (!ev->flag) {
+        if (pthread_cond_timedwait(&ev->condition, &ev->mutex, &ts)) {
+            break;  // timeout: the caller rechecks its condition
+        }
+    }
+    ev->flag = 0;
+    pthread_mutex_unlock(&ev->mutex);
+}
+
+// Default extent reservation step: 256 MiB, see prealloc_init().
+#define PREALLOC_STEP_DEFAULT (256LL * 1024 * 1024)
+
+// Configure extent preallocation from the JLS_PREALLOCATE environment
+// variable: unset or "0" disables, "1" uses the default step, and any
+// other number is the reservation step in MiB.
+static void prealloc_init(struct jls_bkf_s * self) {
+    const char * env = getenv("JLS_PREALLOCATE");
+    if (!env || (env[0] == '0')) {
+        return;
+    }
+    long long step_mb = atoll(env);
+    self->prealloc_step = (step_mb > 1) ? (step_mb * 1024 * 1024) : PREALLOC_STEP_DEFAULT;
+}
+
+#if defined(O_DIRECT)
+
+#define DIRECT_ALIGN (4096)                 // logical block alignment
+#define DIRECT_BUF_SIZE (256 * 1024)        // staging size, multiple of DIRECT_ALIGN
+
+/*
+ * O_DIRECT recording: stage appends in an aligned buffer and write full
+ * blocks through a second O_DIRECT descriptor, bypassing the page cache
+ * entirely.  This avoids double caching on RAM-constrained recorders and
+ * the write jitter from dirty-page writeback.  Rewrites of staged bytes
+ * patch the buffer in memory; rewrites below the staged region use the
+ * buffered descriptor, which never shares a block with later direct
+ * writes.  An unaligned tail syncs as a zero-padded block followed by
+ * a trim back to the logical file end.
+ */
+struct jls_direct_s {
+    int fd;             // the O_DIRECT descriptor
+    uint8_t * buf;      // the staging buffer, DIRECT_ALIGN aligned
+    uint32_t pending;   // staged bytes not yet on disk
+    int64_t offset;     // file offset of buf[0], aligned, -1 until first append
+};
+
+// Enable O_DIRECT recording from the JLS_O_DIRECT environment variable:
+// unset or "0" uses buffered writes.
+static void direct_init(struct jls_bkf_s * self, const char * filename) {
+    const char * env = getenv("JLS_O_DIRECT");
+    if (!env || (env[0] == '0')) {
+        return;
+    }
+    struct jls_direct_s * d = calloc(1, sizeof(struct jls_direct_s));
+    if (!d) {
+        return;
+    }
+    if (posix_memalign((void **) &d->buf, DIRECT_ALIGN, DIRECT_BUF_SIZE)) {
+        free(d);
+        return;
+    }
+    d->fd = open(filename, O_WRONLY | O_DIRECT);
+    if (d->fd < 0) {
+        JLS_LOGD1("O_DIRECT open failed %d, using buffered writes", errno);
+        free(d->buf);
+        free(d);
+        return;
+    }
+    d->offset = -1;
+    self->direct = d;
+}
+
+// Write staged full blocks.  When sync, also write the unaligned tail as
+// a zero-padded block and trim the file back to the logical end, so that
+// reads and flush observe all staged bytes; the tail stays staged and the
+// block rewrites in place when it fills.
+static int32_t direct_flush(struct jls_bkf_s * self, bool sync) {
+    struct jls_direct_s * d = self->direct;
+    if (d->offset < 0) {
+        return 0;
+    }
+    uint32_t blocks = d->pending & ~((uint32_t) (DIRECT_ALIGN - 1));
+    uint32_t tail = d->pending - blocks;
+    uint32_t sz = blocks;
+    if (sync && tail) {
+        memset(d->buf + d->pending, 0, blocks + DIRECT_ALIGN - d->pending);
+        sz += DIRECT_ALIGN;
+    }
+    if (sz && (pwrite(d->fd, d->buf, sz, d->offset) != (ssize_t) sz)) {
+        JLS_LOGE("O_DIRECT write failed %d", errno);
+        return JLS_ERROR_IO;
+    }
+    if (blocks) {
+        memmove(d->buf, d->buf + blocks, tail);
+        d->offset += blocks;
+        d->pending = tail;
+    }
+    if (sync && tail && ftruncate(self->fd, self->fend)) {
+        JLS_LOGE("O_DIRECT trim failed %d", errno);
+        return JLS_ERROR_IO;
+    }
+    return 0;
+}
+
+static int32_t direct_append(struct jls_bkf_s * self, const uint8_t * buffer, uint32_t count) {
+    struct jls_direct_s * d = self->direct;
+    if (d->offset < 0) {
+        // first append: stage the unaligned tail of any existing data
+        d->offset = self->fpos & ~((int64_t) (DIRECT_ALIGN - 1));
+        d->pending = (uint32_t) (self->fpos - d->offset);
+        if (d->pending && (pread(self->fd, d->buf, d->pending, d->offset) != (ssize_t) d->pending)) {
+            JLS_LOGE("O_DIRECT tail read failed %d", errno);
+            return JLS_ERROR_IO;
+        }
+    }
+    while (count) {
+        uint32_t k = DIRECT_BUF_SIZE - d->pending;
+        if (k > count) {
+            k = count;
+        }
+        memcpy(d->buf + d->pending, buffer, k);
+        d->pending += k;
+        buffer += k;
+        count -= k;
+        if (d->pending == DIRECT_BUF_SIZE) {
+            ROE(direct_flush(self, false));
+        }
+    }
+    return 0;
+}
+
+static int32_t direct_rewrite(struct jls_bkf_s * self, const uint8_t * buffer, uint32_t count) {
+    struct jls_direct_s * d = self->direct;
+    int64_t pos = self->fpos;
+    uint32_t buffered = count;
+    if ((d->offset >= 0) && ((pos + count) > d->offset)) {
+        buffered = (pos < d->offset) ? (uint32_t) (d->offset - pos) : 0;
+    }
+    if (buffered && (pwrite(self->fd, buffer, buffered, pos) != (ssize_t) buffered)) {
+        JLS_LOGE("rewrite failed %d", errno);
+        return JLS_ERROR_IO;
+    }
+    if (buffered < count) {  // remainder patches the staging buffer in memory
+        memcpy(d->buf + (pos + buffered - d->offset), buffer + buffered, count - buffered);
+    }
+    return 0;
+}
+
+static int32_t direct_close(struct jls_bkf_s * self) {
+    struct jls_direct_s * d = self->direct;
+    int32_t rc = direct_flush(self, true);
+    close(d->fd);
+    free(d->buf);
+    free(d);
+    self->direct = NULL;
+    return rc;
+}
+
+#endif  /* O_DIRECT */
+
+// Default write-behind eviction chunk: 16 MiB, see cache_drop_init().
+#define CACHE_DROP_STEP_DEFAULT (16LL * 1024 * 1024)
+
+// Configure write-behind page cache eviction from the JLS_WRITE_DONTNEED
+// environment variable: unset or "0" disables, "1" uses the default chunk,
+// and any other number is the chunk size in MiB.  A 24/7 recording would
+// otherwise evict the whole page cache and starve co-resident readers.
+static void cache_drop_init(struct jls_bkf_s * self) {
+    const char * env = getenv("JLS_WRITE_DONTNEED");
+    if (!env || (env[0] == '0')) {
+        return;
+    }
+#if defined(__APPLE__)
+    // macOS has no posix_fadvise: keep written data out of the cache entirely
+    fcntl(self->fd, F_NOCACHE, 1);
+#else
+    long long step_mb = atoll(env);
+    self->cache_drop_step = (step_mb > 1) ? (step_mb * 1024 * 1024) : CACHE_DROP_STEP_DEFAULT;
+#endif
+}
+
+// Release the page cache behind the write position.  Eviction lags one
+// chunk so that asynchronous writeback completes before the drop;
+// POSIX_FADV_DONTNEED silently skips pages that are still dirty.
+static void cache_drop_update(struct jls_bkf_s * self) {
+#if defined(POSIX_FADV_DONTNEED)
+    int64_t step = self->cache_drop_step;
+    if (!step) {
+        return;
+    }
+    while ((self->cache_drop + 2 * step) <= self->fpos) {
+#if defined(__linux__)
+        // start writeback on the newest full chunk so the next pass can drop it
+        sync_file_range(self->fd, self->cache_drop + step, step, SYNC_FILE_RANGE_WRITE);
+#endif
+        posix_fadvise(self->fd, self->cache_drop, step, POSIX_FADV_DONTNEED);
+        self->cache_drop += step;
+    }
+#else
+    (void) self;
+#endif
+}
+
+// Reserve extents ahead of the write position to reduce fragmentation
+// during long captures.  The logical file size is unchanged.
+static void prealloc_update(struct jls_bkf_s * self) {
+    if (!self->prealloc_step || (self->fend + (self->prealloc_step / 2) <= self->prealloc)) {
+        return;
+    }
+    int64_t end = ((self->fend / self->prealloc_step) + 1) * self->prealloc_step;
+#if defined(__linux__)
+    if (fallocate(self->fd, FALLOC_FL_KEEP_SIZE, self->prealloc, end - self->prealloc)) {
+        JLS_LOGW("fallocate failed %d, preallocation disabled", errno);
+        self->prealloc_step = 0;
+        return;
+    }
+#elif defined(__APPLE__)
+    fstore_t store = {
+            .fst_flags = F_ALLOCATECONTIG,
+            .fst_posmode = F_PEOFPOSMODE,
+            .fst_offset = 0,
+            .fst_length = end - self->prealloc,
+    };
+    if (fcntl(self->fd, F_PREALLOCATE, &store) == -1) {
+        store.fst_flags = F_ALLOCATEALL;  // contiguous reservation unavailable
+        if (fcntl(self->fd, F_PREALLOCATE, &store) == -1) {
+            JLS_LOGW("F_PREALLOCATE failed %d, preallocation disabled", errno);
+            self->prealloc_step = 0;
+            return;
+        }
+    }
+#endif
+    self->prealloc = end;
+}
+
 // https://docs.microsoft.com/en-us/cpp/c-runtime-library/low-level-i-o?view=msvc-160
 // The C standard library only gets in the way for JLS.
 int32_t jls_bk_fopen(struct jls_bkf_s * self, const char * filename, const char * mode) {
     int oflag;
     int fmode = S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP;
 
+    const struct jls_bk_ops_s * ops = jls_bk_ops_match(filename);
+    if (ops) {
+        if ((mode[0] != 'r') && (NULL == ops->write)) {
+            return JLS_ERROR_NOT_SUPPORTED;
+        }
+        self->ops = ops;
+        self->fd = -1;
+        self->fpos = 0;
+        self->fend = 0;
+        int32_t rc = ops->open(self, filename, mode);
+        if (rc) {
+            self->ops = NULL;
+        }
+        return rc;
+    }
+
     switch (mode[0]) {
         case 'w':
             oflag = O_RDWR | O_CREAT | O_TRUNC;
@@ -107,27 +381,197 @@ int32_t jls_bk_fopen(struct jls_bkf_s * self, const char * filename, const char
         JLS_LOGW("open failed with %d: filename=%s, mode=%s", errno, filename, mode);
         return JLS_ERROR_IO;
     }
+#if defined(O_DIRECT)
+    if (mode[0] != 'r') {
+        direct_init(self, filename);
+    }
+#endif
+#if defined(__linux__)
+    if ((mode[0] != 'r') && !self->direct) {
+        const char * env = getenv("JLS_IO_URING");
+        if (env && (env[0] != '0')) {
+            if (jls_uring_open(&self->uring, self->fd)) {
+                self->uring = NULL;  // fall back to synchronous writes
+            }
+        }
+    }
+#endif
+#if defined(POSIX_FADV_SEQUENTIAL)
+    if (mode[0] == 'r') {
+        // readers seek between chunks; jls_bk_readahead() issues
+        // POSIX_FADV_WILLNEED for the ranges a read plan will touch
+        posix_fadvise(self->fd, 0, 0, POSIX_FADV_RANDOM);
+    } else {
+        posix_fadvise(self->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+#endif
+    if (mode[0] != 'r') {
+        prealloc_init(self);
+        prealloc_update(self);
+        cache_drop_init(self);
+    }
     return 0;
 }
 
 int32_t jls_bk_fclose(struct jls_bkf_s * self) {
+    int32_t rc = 0;
+    if (self->ops) {
+        if (self->ops->close) {
+            rc = self->ops->close(self);
+        }
+        self->ops = NULL;
+        return rc;
+    }
+#if defined(__linux__)
+    if (self->uring) {
+        rc = jls_uring_close(self->uring);
+        self->uring = NULL;
+    }
+#endif
+#if defined(O_DIRECT)
+    if (self->direct) {
+        rc = direct_close(self);
+    }
+#endif
+    jls_bk_munmap(self);
+    if ((self->fd != -1) && (self->prealloc > self->fend)) {
+        // release the unused reservation beyond the file end
+#if defined(__linux__)
+        // ftruncate to the unchanged logical size would not free the blocks
+        if (fallocate(self->fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                      self->fend, self->prealloc - self->fend)) {
+            JLS_LOGW("prealloc trim failed %d", errno);
+        }
+#endif  // macOS releases unused F_PREALLOCATE space on close
+        self->prealloc = 0;
+        self->prealloc_step = 0;
+    }
     if (self->fd != -1) {
         close(self->fd);
         self->fd = -1;
     }
+    return rc;
+}
+
+int32_t jls_bk_mmap(struct jls_bkf_s * self) {
+    if (self->ops) {
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    if (self->fd < 0) {
+        return JLS_ERROR_IO;
+    }
+    if (self->mmap_ptr) {
+        return 0;  // already mapped
+    }
+    struct stat st;
+    if (fstat(self->fd, &st) || (st.st_size <= 0)) {
+        JLS_LOGW("mmap fstat failed %d", errno);
+        return JLS_ERROR_IO;
+    }
+    void * p = mmap(NULL, (size_t) st.st_size, PROT_READ, MAP_SHARED, self->fd, 0);
+    if (MAP_FAILED == p) {
+        JLS_LOGW("mmap failed %d", errno);
+        return JLS_ERROR_IO;
+    }
+    self->mmap_ptr = (uint8_t *) p;
+    self->mmap_size = st.st_size;
     return 0;
 }
 
-int32_t jls_bk_fwrite(struct jls_bkf_s * self, const void * buffer, unsigned int count) {
+int32_t jls_bk_munmap(struct jls_bkf_s * self) {
+    if (self->ops) {
+        return 0;
+    }
+    if (self->mmap_ptr) {
+        if (munmap(self->mmap_ptr, (size_t) self->mmap_size)) {
+            JLS_LOGW("munmap failed %d", errno);
+        }
+        self->mmap_ptr = NULL;
+        self->mmap_size = 0;
+    }
+    return 0;
+}
+
+int32_t jls_bk_readahead(struct jls_bkf_s * self, int64_t offset, int64_t length) {
+    if (!self || (offset < 0) || (length <= 0)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (self->ops) {
+        return self->ops->readahead ? self->ops->readahead(self, offset, length) : 0;
+    }
+    if (self->fd < 0) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+#if defined(POSIX_FADV_WILLNEED)
+    posix_fadvise(self->fd, offset, length, POSIX_FADV_WILLNEED);
+#elif defined(F_RDADVISE)  // macOS
+    struct radvisory advise = {
+            .ra_offset = offset,
+            .ra_count = (length > INT32_MAX) ? INT32_MAX : (int) length,
+    };
+    fcntl(self->fd, F_RDADVISE, &advise);
+#else
+    (void) offset;
+    (void) length;
+#endif
+    return 0;
+}
+
+static int32_t bk_fwrite(struct jls_bkf_s * self, const void * buffer, unsigned int count) {
+    if (self->ops) {
+        ROE(self->ops->write(self, buffer, count));
+        jls_bk_counter_add(&self->bytes_written, count);
+        self->fpos += count;
+        if (self->fpos > self->fend) {
+            self->fend = self->fpos;
+        }
+        return 0;
+    }
+#if defined(__linux__)
+    if (self->uring) {
+        // order rewrites of existing regions after all queued writes
+        bool ordered = self->fpos < self->fend;
+        int32_t rc = jls_uring_fwrite(self->uring, self->fpos, buffer, count, ordered);
+        if (rc) {
+            return rc;
+        }
+        self->fpos += count;
+        if (self->fpos > self->fend) {
+            self->fend = self->fpos;
+        }
+        jls_bk_counter_add(&self->bytes_written, count);
+        prealloc_update(self);
+        cache_drop_update(self);
+        return 0;
+    }
+#endif
+#if defined(O_DIRECT)
+    if (self->direct) {
+        if (self->fpos == self->fend) {
+            ROE(direct_append(self, (const uint8_t *) buffer, count));
+            self->fpos += count;
+            self->fend = self->fpos;
+            prealloc_update(self);
+        } else {  // rewrite of existing data, e.g. chunk header patches
+            ROE(direct_rewrite(self, (const uint8_t *) buffer, count));
+            self->fpos += count;
+        }
+        jls_bk_counter_add(&self->bytes_written, count);
+        return 0;
+    }
+#endif
     ssize_t sz = write(self->fd, buffer, count);
     if (sz < 0) {
         JLS_LOGE("write failed %d", errno);
         return JLS_ERROR_IO;
     }
+    jls_bk_counter_add(&self->bytes_written, sz);
     self->fpos += sz;
     if (self->fpos > self->fend) {
         self->fend = self->fpos;
     }
+    prealloc_update(self);
+    cache_drop_update(self);
     if ((unsigned int) sz != count) {
         JLS_LOGE("write mismatch %zd != %u", sz, count);
         return JLS_ERROR_IO;
@@ -135,12 +579,123 @@ int32_t jls_bk_fwrite(struct jls_bkf_s * self, const void * buffer, unsigned int
     return 0;
 }
 
+int32_t jls_bk_fwrite(struct jls_bkf_s * self, const void * buffer, unsigned int count) {
+    int64_t t_start = jls_now();
+    int32_t rc = bk_fwrite(self, buffer, count);
+    jls_bk_counter_add(&self->write_duration, (uint64_t) (jls_now() - t_start));
+    return rc;
+}
+
+static int32_t bk_fwritev(struct jls_bkf_s * self, const struct jls_bk_iovec_s * iov, int count) {
+    if (self->ops) {
+        if ((count <= 0) || (count > JLS_BK_IOVEC_MAX)) {
+            return JLS_ERROR_PARAMETER_INVALID;
+        }
+        for (int idx = 0; idx < count; ++idx) {
+            ROE(bk_fwrite(self, iov[idx].base, iov[idx].length));
+        }
+        return 0;
+    }
+#if defined(__linux__)
+    if (self->uring) {
+        for (int idx = 0; idx < count; ++idx) {
+            ROE(bk_fwrite(self, iov[idx].base, iov[idx].length));
+        }
+        return 0;
+    }
+#endif
+#if defined(O_DIRECT)
+    if (self->direct) {
+        for (int idx = 0; idx < count; ++idx) {
+            ROE(bk_fwrite(self, iov[idx].base, iov[idx].length));
+        }
+        return 0;
+    }
+#endif
+    struct iovec v[JLS_BK_IOVEC_MAX];
+    size_t total = 0;
+    if ((count <= 0) || (count > JLS_BK_IOVEC_MAX)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    for (int idx = 0; idx < count; ++idx) {
+        v[idx].iov_base = (void *) (uintptr_t) iov[idx].base;
+        v[idx].iov_len = iov[idx].length;
+        total += iov[idx].length;
+    }
+    ssize_t sz = writev(self->fd, v, count);
+    if (sz < 0) {
+        JLS_LOGE("writev failed %d", errno);
+        return JLS_ERROR_IO;
+    }
+    jls_bk_counter_add(&self->bytes_written, sz);
+    self->fpos += sz;
+    if (self->fpos > self->fend) {
+        self->fend = self->fpos;
+    }
+    prealloc_update(self);
+    if ((size_t) sz != total) {
+        JLS_LOGE("writev mismatch %zd != %zu", sz, total);
+        return JLS_ERROR_IO;
+    }
+    return 0;
+}
+
+int32_t jls_bk_fwritev(struct jls_bkf_s * self, const struct jls_bk_iovec_s * iov, int count) {
+    int64_t t_start = jls_now();
+    int32_t rc = bk_fwritev(self, iov, count);
+    jls_bk_counter_add(&self->write_duration, (uint64_t) (jls_now() - t_start));
+    return rc;
+}
+
 int32_t jls_bk_fread(struct jls_bkf_s * self, void * const buffer, unsigned const buffer_size) {
+    if (self->ops) {
+        ROE(self->ops->read(self, buffer, buffer_size));
+        jls_bk_counter_add(&self->bytes_read, buffer_size);
+        self->fpos += buffer_size;
+        return 0;
+    }
+#if defined(__linux__)
+    if (self->uring) {
+        // reads must observe queued writes, which do not advance the kernel file offset
+        int32_t rc = jls_uring_drain(self->uring);
+        if (rc) {
+            return rc;
+        }
+        if (lseek(self->fd, self->fpos, SEEK_SET) < 0) {
+            JLS_LOGE("seek fail %d", errno);
+            return JLS_ERROR_IO;
+        }
+    }
+#endif
+#if defined(O_DIRECT)
+    if (self->direct) {
+        // reads must observe staged bytes, which do not advance the kernel file offset
+        ROE(direct_flush(self, true));
+        if (lseek(self->fd, self->fpos, SEEK_SET) < 0) {
+            JLS_LOGE("seek fail %d", errno);
+            return JLS_ERROR_IO;
+        }
+    }
+#endif
+    if (self->mmap_ptr && ((self->fpos + buffer_size) <= self->mmap_size)) {
+        memcpy(buffer, self->mmap_ptr + self->fpos, buffer_size);
+        self->fpos += buffer_size;
+        jls_bk_counter_add(&self->bytes_read, buffer_size);
+        return 0;
+    }
+    if (self->mmap_ptr) {
+        // mapped reads do not advance the kernel file offset
+        if (lseek(self->fd, self->fpos, SEEK_SET) < 0) {
+            JLS_LOGE("seek fail %d", errno);
+            return JLS_ERROR_IO;
+        }
+    }
     int sz = read(self->fd, buffer, buffer_size);
     if (sz < 0) {
         JLS_LOGE("read failed %d", errno);
         return JLS_ERROR_IO;
     }
+    jls_bk_counter_add(&self->bytes_read, sz);
     self->fpos += sz;
     if ((unsigned int) sz != buffer_size) {
         JLS_LOGE("write mismatch %d != %d", sz, buffer_size);
@@ -150,6 +705,23 @@ int32_t jls_bk_fread(struct jls_bkf_s * self, void * const buffer, unsigned cons
 }
 
 int32_t jls_bk_fseek(struct jls_bkf_s * self, int64_t offset, int origin) {
+    if (self->ops) {
+        int64_t pos;
+        switch (origin) {
+            case SEEK_SET: pos = offset; break;
+            case SEEK_CUR: pos = self->fpos + offset; break;
+            case SEEK_END: pos = self->fend + offset; break;
+            default: return JLS_ERROR_PARAMETER_INVALID;
+        }
+        if (pos < 0) {
+            return JLS_ERROR_IO;
+        }
+        if (self->fpos != pos) {
+            jls_bk_counter_add(&self->seek_count, 1);
+        }
+        self->fpos = pos;
+        return 0;
+    }
     int64_t pos = lseek(self->fd, offset, origin);
     if (pos < 0) {
         JLS_LOGE("seek fail %d", errno);
@@ -159,19 +731,154 @@ int32_t jls_bk_fseek(struct jls_bkf_s * self, int64_t offset, int origin) {
         JLS_LOGE("seek fail %d", errno);
         return JLS_ERROR_IO;
     }
+    if (self->fpos != pos) {
+        jls_bk_counter_add(&self->seek_count, 1);
+    }
     self->fpos = pos;
     return 0;
 }
 
 int64_t jls_bk_ftell(struct jls_bkf_s * self) {
+    if (self->ops) {
+        return self->fpos;
+    }
+#if defined(__linux__)
+    if (self->uring) {
+        // queued writes do not advance the kernel file offset
+        return self->fpos;
+    }
+#endif
+#if defined(O_DIRECT)
+    if (self->direct) {
+        // staged writes do not advance the kernel file offset
+        return self->fpos;
+    }
+#endif
     return lseek(self->fd, 0, SEEK_CUR);
 }
 
-int32_t jls_bk_fflush(struct jls_bkf_s * self) {
+static int32_t bk_fflush(struct jls_bkf_s * self) {
+    if (self->ops) {
+        return self->ops->flush ? self->ops->flush(self) : 0;
+    }
+#if defined(__linux__)
+    if (self->uring) {
+        int32_t rc = jls_uring_drain(self->uring);
+        if (rc) {
+            return rc;
+        }
+    }
+#endif
+#if defined(O_DIRECT)
+    if (self->direct) {
+        ROE(direct_flush(self, true));
+    }
+#endif
     return fsync(self->fd);
 }
 
+int32_t jls_bk_fflush(struct jls_bkf_s * self) {
+    int64_t t_start = jls_now();
+    int32_t rc = bk_fflush(self);
+    jls_bk_counter_add(&self->flush_duration, (uint64_t) (jls_now() - t_start));
+    return rc;
+}
+
+int32_t jls_bk_punch_hole(struct jls_bkf_s * self, int64_t offset, int64_t length) {
+    if (self->ops || self->uring || self->direct) {
+        // cannot order against queued asynchronous or staged writes
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+#if defined(__linux__) && defined(FALLOC_FL_PUNCH_HOLE)
+    if (fallocate(self->fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset, length)) {
+        return JLS_ERROR_NOT_SUPPORTED;  // filesystem dependent
+    }
+    return 0;
+#elif defined(F_PUNCHHOLE)  // macOS
+    struct fpunchhole hole = {
+            .fp_flags = 0,
+            .reserved = 0,
+            .fp_offset = offset,
+            .fp_length = length,
+    };
+    if (fcntl(self->fd, F_PUNCHHOLE, &hole)) {
+        return JLS_ERROR_NOT_SUPPORTED;  // filesystem dependent
+    }
+    return 0;
+#else
+    (void) offset;
+    (void) length;
+    return JLS_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+int32_t jls_bk_shm_open(struct jls_bk_shm_s * self, const char * name, int64_t size) {
+    if (!self || !name || !name[0] || (size <= 0)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    char shm_name[256];
+    snprintf(shm_name, sizeof(shm_name), "/%s", name);
+    int fd = shm_open(shm_name, O_RDWR | O_CREAT, 0666);
+    if (fd < 0) {
+        JLS_LOGW("shm_open(%s) failed %d", shm_name, errno);
+        return JLS_ERROR_IO;
+    }
+    if (ftruncate(fd, (off_t) size)) {
+        JLS_LOGW("shm ftruncate failed %d", errno);
+        close(fd);
+        return JLS_ERROR_IO;
+    }
+    void * p = mmap(NULL, (size_t) size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == p) {
+        JLS_LOGW("shm mmap failed %d", errno);
+        close(fd);
+        return JLS_ERROR_IO;
+    }
+    self->ptr = p;
+    self->size = size;
+    self->handle = (intptr_t) fd;
+    return 0;
+}
+
+int32_t jls_bk_shm_close(struct jls_bk_shm_s * self) {
+    if (!self || (NULL == self->ptr)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    munmap(self->ptr, (size_t) self->size);
+    close((int) self->handle);
+    self->ptr = NULL;
+    self->size = 0;
+    return 0;
+}
+
 int32_t jls_bk_truncate(struct jls_bkf_s * self) {
+    if (self->ops) {
+        if (NULL == self->ops->truncate) {
+            return JLS_ERROR_NOT_SUPPORTED;
+        }
+        ROE(self->ops->truncate(self));
+        if (self->fend > self->fpos) {
+            self->fend = self->fpos;
+        }
+        return 0;
+    }
+#if defined(__linux__)
+    if (self->uring) {
+        int32_t rc32 = jls_uring_drain(self->uring);
+        if (rc32) {
+            return rc32;
+        }
+    }
+#endif
+#if defined(O_DIRECT)
+    if (self->direct) {
+        struct jls_direct_s * d = self->direct;
+        ROE(direct_flush(self, true));
+        // discard any staged bytes beyond the new end; the next append restages
+        d->offset = -1;
+        d->pending = 0;
+    }
+#endif
     int rc = ftruncate(self->fd, self->fpos);
     if (rc) {
         JLS_LOGE("truncate fail %d", errno);
@@ -213,6 +920,13 @@ struct jls_bkt_s * jls_bkt_initialize(struct jls_twr_s * wr) {
         return NULL;
     }
 
+    self->ack_event = eventflag_create();
+    if (!self->ack_event) {
+        JLS_LOGE("jls_bkt_initialize: eventflag_create failed");
+        jls_bkt_finalize(self);
+        return NULL;
+    }
+
     wr->bk = self;
     int rc = pthread_create(&self->thread, NULL, task, wr);
     if (rc) {
@@ -237,6 +951,10 @@ void jls_bkt_finalize(struct jls_bkt_s * self) {
             eventflag_destroy(self->msg_event);
             self->msg_event = NULL;
         }
+        if (self->ack_event) {
+            eventflag_destroy(self->ack_event);
+            self->ack_event = NULL;
+        }
         pthread_mutex_destroy(&self->msg_mutex);
         pthread_mutex_destroy(&self->process_mutex);
         free(self);
@@ -283,6 +1001,14 @@ void jls_bkt_msg_signal(struct jls_bkt_s * self) {
     eventflag_set(self->msg_event);
 }
 
+void jls_bkt_ack_wait(struct jls_bkt_s * self, uint32_t timeout_ms) {
+    eventflag_wait_ms(self->ack_event, timeout_ms);
+}
+
+void jls_bkt_ack_signal(struct jls_bkt_s * self) {
+    eventflag_set(self->ack_event);
+}
+
 void jls_bkt_sleep_ms(uint32_t duration_ms) {
     struct timespec ts;
     int rv;
@@ -293,6 +1019,90 @@ void jls_bkt_sleep_ms(uint32_t duration_ms) {
     } while (rv && errno == EINTR);
 }
 
+struct jls_bkm_s {
+    pthread_mutex_t mutex;
+};
+
+struct jls_bkm_s * jls_bkm_initialize(void) {
+    struct jls_bkm_s * self = calloc(1, sizeof(struct jls_bkm_s));
+    if (NULL == self) {
+        return NULL;
+    }
+    if (pthread_mutex_init(&self->mutex, NULL)) {
+        free(self);
+        return NULL;
+    }
+    return self;
+}
+
+void jls_bkm_finalize(struct jls_bkm_s * self) {
+    if (self) {
+        pthread_mutex_destroy(&self->mutex);
+        free(self);
+    }
+}
+
+int jls_bkm_lock(struct jls_bkm_s * self) {
+    int rc = pthread_mutex_lock(&self->mutex);
+    if (rc) {
+        JLS_LOGE("jls_bkm_lock failed %d", rc);
+    }
+    return rc;
+}
+
+int jls_bkm_unlock(struct jls_bkm_s * self) {
+    int rc = pthread_mutex_unlock(&self->mutex);
+    if (rc) {
+        JLS_LOGE("jls_bkm_unlock failed %d", rc);
+    }
+    return rc;
+}
+
+struct jls_bk_thread_s {
+    pthread_t thread;
+    jls_bk_thread_fn fn;
+    void * user_data;
+};
+
+static void * bk_thread_task(void * user_data) {
+    struct jls_bk_thread_s * self = (struct jls_bk_thread_s *) user_data;
+    self->fn(self->user_data);
+    return NULL;
+}
+
+int32_t jls_bk_thread_run(struct jls_bk_thread_s ** thread, jls_bk_thread_fn fn, void * user_data) {
+    if (!thread || !fn) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_bk_thread_s * self = calloc(1, sizeof(struct jls_bk_thread_s));
+    if (!self) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    self->fn = fn;
+    self->user_data = user_data;
+    int rc = pthread_create(&self->thread, NULL, bk_thread_task, self);
+    if (rc) {
+        JLS_LOGE("jls_bk_thread_run: pthread_create returned %d", rc);
+        free(self);
+        return JLS_ERROR_UNSPECIFIED;
+    }
+    *thread = self;
+    return 0;
+}
+
+int32_t jls_bk_thread_join(struct jls_bk_thread_s * self) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    void * rv = NULL;
+    int rc = pthread_join(self->thread, &rv);
+    if (rc) {
+        JLS_LOGE("jls_bk_thread_join failed with %d", rc);
+    }
+    free(self);
+    return rc ? JLS_ERROR_UNSPECIFIED : 0;
+}
+
 int64_t jls_now(void) {
     int64_t t;
     struct timespec ts;
@@ -15,6 +15,7 @@
  */
 
 #include "jls/backend.h"
+#include "jls/backend_overlapped.h"
 #include "jls/cdef.h"
 #include "jls/wr_prv.h"
 #include "jls/ec.h"
@@ -26,12 +27,14 @@
 #include <fcntl.h>
 #include <sys\stat.h>
 #include <share.h>
+#include <string.h>
 
 
 struct jls_bkt_s {
     HANDLE msg_mutex;
     HANDLE process_mutex;
     HANDLE msg_event;
+    HANDLE ack_event;
     HANDLE thread;
 };
 
@@ -42,7 +45,58 @@ struct jls_twr_s {
 
 // https://docs.microsoft.com/en-us/cpp/c-runtime-library/low-level-i-o?view=msvc-160
 // The C standard library only gets in the way for JLS.
+// Default extent reservation step: 256 MiB, see prealloc_init().
+#define PREALLOC_STEP_DEFAULT (256LL * 1024 * 1024)
+
+// Configure extent preallocation from the JLS_PREALLOCATE environment
+// variable: unset or "0" disables, "1" uses the default step, and any
+// other number is the reservation step in MiB.
+static void prealloc_init(struct jls_bkf_s * self) {
+    const char * env = getenv("JLS_PREALLOCATE");
+    if (!env || (env[0] == '0')) {
+        return;
+    }
+    long long step_mb = _atoi64(env);
+    self->prealloc_step = (step_mb > 1) ? (step_mb * 1024 * 1024) : PREALLOC_STEP_DEFAULT;
+}
+
+// Reserve allocation ahead of the write position to reduce fragmentation
+// during long captures.  The logical file size (EOF) is unchanged.
+static void prealloc_update(struct jls_bkf_s * self) {
+    if (!self->prealloc_step || (self->fend + (self->prealloc_step / 2) <= self->prealloc)) {
+        return;
+    }
+    int64_t end = ((self->fend / self->prealloc_step) + 1) * self->prealloc_step;
+    HANDLE file = (HANDLE) _get_osfhandle(self->fd);
+    if (INVALID_HANDLE_VALUE == file) {
+        self->prealloc_step = 0;
+        return;
+    }
+    FILE_ALLOCATION_INFO info = { .AllocationSize = { .QuadPart = end } };
+    if (!SetFileInformationByHandle(file, FileAllocationInfo, &info, sizeof(info))) {
+        JLS_LOGW("SetFileInformationByHandle failed %d, preallocation disabled", (int) GetLastError());
+        self->prealloc_step = 0;
+        return;
+    }
+    self->prealloc = end;
+}
+
 int32_t jls_bk_fopen(struct jls_bkf_s * self, const char * filename, const char * mode) {
+    const struct jls_bk_ops_s * ops = jls_bk_ops_match(filename);
+    if (ops) {
+        if ((mode[0] != 'r') && (NULL == ops->write)) {
+            return JLS_ERROR_NOT_SUPPORTED;
+        }
+        self->ops = ops;
+        self->fd = -1;
+        self->fpos = 0;
+        self->fend = 0;
+        int32_t rc = ops->open(self, filename, mode);
+        if (rc) {
+            self->ops = NULL;
+        }
+        return rc;
+    }
     // https://learn.microsoft.com/en-us/windows/win32/fileio/maximum-file-path-limitation?tabs=registry
     wchar_t filename_wide[32768];
     int oflag;
@@ -67,32 +121,175 @@ int32_t jls_bk_fopen(struct jls_bkf_s * self, const char * filename, const char
     if (!MultiByteToWideChar(CP_UTF8, 0, filename, -1, filename_wide, JLS_ARRAY_SIZE(filename_wide))) {
         return JLS_ERROR_IO;
     }
+    const char * env_overlapped = NULL;
+    if (mode[0] != 'r') {
+        env_overlapped = getenv("JLS_WIN_OVERLAPPED");
+        if (env_overlapped && (env_overlapped[0] != '0')) {
+            // the write queue opens a second handle to the same file
+            shflag = _SH_DENYNO;
+        } else {
+            env_overlapped = NULL;
+        }
+    }
     errno_t err = _wsopen_s(&self->fd, filename_wide, oflag, shflag, _S_IREAD | _S_IWRITE);
     if (err != 0) {
         JLS_LOGW("open failed with %d: filename=%s, mode=%s", err, filename, mode);
         return JLS_ERROR_IO;
     }
+    if (env_overlapped) {
+        const char * env_nb = getenv("JLS_WIN_NO_BUFFERING");
+        bool no_buffering = env_nb && (env_nb[0] != '0');
+        if (jls_winol_open(&self->winol, filename_wide, no_buffering)) {
+            self->winol = NULL;  // fall back to synchronous writes
+        }
+    }
+    if (mode[0] != 'r') {
+        prealloc_init(self);
+        prealloc_update(self);
+    }
     return 0;
 }
 
 int32_t jls_bk_fclose(struct jls_bkf_s * self) {
+    if (self->ops) {
+        int32_t rc = self->ops->close ? self->ops->close(self) : 0;
+        self->ops = NULL;
+        return rc;
+    }
+    if (self->winol) {
+        jls_winol_close(self->winol);
+        self->winol = NULL;
+    }
+    jls_bk_munmap(self);
     if (self->fd != -1) {
+        // NTFS releases any allocation reserved beyond the file end on close
         _close(self->fd);
         self->fd = -1;
     }
     return 0;
 }
 
-int32_t jls_bk_fwrite(struct jls_bkf_s * self, const void * buffer, unsigned int count) {
+int32_t jls_bk_mmap(struct jls_bkf_s * self) {
+    if (self->ops) {
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    if (self->fd == -1) {
+        return JLS_ERROR_IO;
+    }
+    if (self->mmap_ptr) {
+        return 0;  // already mapped
+    }
+    HANDLE file = (HANDLE) _get_osfhandle(self->fd);
+    if (INVALID_HANDLE_VALUE == file) {
+        return JLS_ERROR_IO;
+    }
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || (file_size.QuadPart <= 0)) {
+        JLS_LOGW("mmap GetFileSizeEx failed %d", (int) GetLastError());
+        return JLS_ERROR_IO;
+    }
+    HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) {
+        JLS_LOGW("mmap CreateFileMapping failed %d", (int) GetLastError());
+        return JLS_ERROR_IO;
+    }
+    void * p = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);  // the view keeps the mapping alive
+    if (!p) {
+        JLS_LOGW("mmap MapViewOfFile failed %d", (int) GetLastError());
+        return JLS_ERROR_IO;
+    }
+    self->mmap_ptr = (uint8_t *) p;
+    self->mmap_size = file_size.QuadPart;
+    return 0;
+}
+
+int32_t jls_bk_munmap(struct jls_bkf_s * self) {
+    if (self->ops) {
+        return 0;
+    }
+    if (self->mmap_ptr) {
+        if (!UnmapViewOfFile(self->mmap_ptr)) {
+            JLS_LOGW("munmap failed %d", (int) GetLastError());
+        }
+        self->mmap_ptr = NULL;
+        self->mmap_size = 0;
+    }
+    return 0;
+}
+
+int32_t jls_bk_readahead(struct jls_bkf_s * self, int64_t offset, int64_t length) {
+    if (!self || (offset < 0) || (length <= 0)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (self->ops) {
+        return self->ops->readahead ? self->ops->readahead(self, offset, length) : 0;
+    }
+    if (self->fd < 0) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+#if defined(_WIN32_WINNT_WIN8) && (_WIN32_WINNT >= _WIN32_WINNT_WIN8)
+    if (self->mmap_ptr && (offset < self->mmap_size)) {
+        if ((offset + length) > self->mmap_size) {
+            length = self->mmap_size - offset;
+        }
+        WIN32_MEMORY_RANGE_ENTRY range = {
+                .VirtualAddress = self->mmap_ptr + offset,
+                .NumberOfBytes = (SIZE_T) length,
+        };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+#else
+    (void) offset;
+    (void) length;
+#endif
+    return 0;
+}
+
+static int32_t bk_fwrite(struct jls_bkf_s * self, const void * buffer, unsigned int count) {
+    if (self->ops) {
+        ROE(self->ops->write(self, buffer, count));
+        jls_bk_counter_add(&self->bytes_written, count);
+        self->fpos += count;
+        if (self->fpos > self->fend) {
+            self->fend = self->fpos;
+        }
+        return 0;
+    }
+    if (self->winol) {
+        // order rewrites of existing regions after all queued writes
+        bool ordered = self->fpos < self->fend;
+        int32_t rc = jls_winol_fwrite(self->winol, self->fpos, buffer, count, ordered);
+        if (0 == rc) {
+            jls_bk_counter_add(&self->bytes_written, count);
+            self->fpos += count;
+            if (self->fpos > self->fend) {
+                self->fend = self->fpos;
+            }
+            prealloc_update(self);
+            return 0;
+        } else if (JLS_ERROR_NOT_SUPPORTED != rc) {
+            return rc;
+        }
+        // unbuffered alignment not met: use the buffered synchronous path,
+        // which requires the queued writes to land first
+        ROE(jls_winol_drain(self->winol));
+        if (_lseeki64(self->fd, self->fpos, SEEK_SET) < 0) {
+            JLS_LOGE("seek fail %d", errno);
+            return JLS_ERROR_IO;
+        }
+    }
     int sz = _write(self->fd, buffer, count);
     if (sz < 0) {
         JLS_LOGE("write failed %d", errno);
         return JLS_ERROR_IO;
     }
+    jls_bk_counter_add(&self->bytes_written, sz);
     self->fpos += sz;
     if (self->fpos > self->fend) {
         self->fend = self->fpos;
     }
+    prealloc_update(self);
     if ((unsigned int) sz != count) {
         JLS_LOGE("write mismatch %d != %d", sz, count);
         return JLS_ERROR_IO;
@@ -100,12 +297,65 @@ int32_t jls_bk_fwrite(struct jls_bkf_s * self, const void * buffer, unsigned int
     return 0;
 }
 
+int32_t jls_bk_fwrite(struct jls_bkf_s * self, const void * buffer, unsigned int count) {
+    int64_t t_start = jls_now();
+    int32_t rc = bk_fwrite(self, buffer, count);
+    jls_bk_counter_add(&self->write_duration, (uint64_t) (jls_now() - t_start));
+    return rc;
+}
+
+int32_t jls_bk_fwritev(struct jls_bkf_s * self, const struct jls_bk_iovec_s * iov, int count) {
+    // WriteFileGather requires unbuffered, sector-aligned I/O, which does
+    // not fit this backend.  Write the segments sequentially instead.
+    if ((count <= 0) || (count > JLS_BK_IOVEC_MAX)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    int64_t t_start = jls_now();
+    for (int idx = 0; idx < count; ++idx) {
+        int32_t rc = bk_fwrite(self, iov[idx].base, iov[idx].length);
+        if (rc) {
+            jls_bk_counter_add(&self->write_duration, (uint64_t) (jls_now() - t_start));
+            return rc;
+        }
+    }
+    jls_bk_counter_add(&self->write_duration, (uint64_t) (jls_now() - t_start));
+    return 0;
+}
+
 int32_t jls_bk_fread(struct jls_bkf_s * self, void * const buffer, unsigned const buffer_size) {
+    if (self->ops) {
+        ROE(self->ops->read(self, buffer, buffer_size));
+        jls_bk_counter_add(&self->bytes_read, buffer_size);
+        self->fpos += buffer_size;
+        return 0;
+    }
+    if (self->winol) {
+        // reads must observe queued writes, which do not advance the descriptor offset
+        ROE(jls_winol_drain(self->winol));
+        if (_lseeki64(self->fd, self->fpos, SEEK_SET) < 0) {
+            JLS_LOGE("seek fail %d", errno);
+            return JLS_ERROR_IO;
+        }
+    }
+    if (self->mmap_ptr && ((self->fpos + buffer_size) <= self->mmap_size)) {
+        memcpy(buffer, self->mmap_ptr + self->fpos, buffer_size);
+        self->fpos += buffer_size;
+        jls_bk_counter_add(&self->bytes_read, buffer_size);
+        return 0;
+    }
+    if (self->mmap_ptr) {
+        // mapped reads do not advance the file descriptor offset
+        if (_lseeki64(self->fd, self->fpos, SEEK_SET) < 0) {
+            JLS_LOGE("seek fail %d", errno);
+            return JLS_ERROR_IO;
+        }
+    }
     int sz = _read(self->fd, buffer, buffer_size);
     if (sz < 0) {
         JLS_LOGE("read failed %d", errno);
         return JLS_ERROR_IO;
     }
+    jls_bk_counter_add(&self->bytes_read, sz);
     self->fpos += sz;
     if ((unsigned int) sz != buffer_size) {
         JLS_LOGE("read length mismatch: read %d, expected %d", sz, buffer_size);
@@ -115,6 +365,23 @@ int32_t jls_bk_fread(struct jls_bkf_s * self, void * const buffer, unsigned cons
 }
 
 int32_t jls_bk_fseek(struct jls_bkf_s * self, int64_t offset, int origin) {
+    if (self->ops) {
+        int64_t pos;
+        switch (origin) {
+            case SEEK_SET: pos = offset; break;
+            case SEEK_CUR: pos = self->fpos + offset; break;
+            case SEEK_END: pos = self->fend + offset; break;
+            default: return JLS_ERROR_PARAMETER_INVALID;
+        }
+        if (pos < 0) {
+            return JLS_ERROR_IO;
+        }
+        if (self->fpos != pos) {
+            jls_bk_counter_add(&self->seek_count, 1);
+        }
+        self->fpos = pos;
+        return 0;
+    }
     int64_t pos = _lseeki64(self->fd, offset, origin);
     if (pos < 0) {
         JLS_LOGE("seek fail %d", errno);
@@ -124,19 +391,110 @@ int32_t jls_bk_fseek(struct jls_bkf_s * self, int64_t offset, int origin) {
         JLS_LOGE("seek fail %d", errno);
         return JLS_ERROR_IO;
     }
+    if (self->fpos != pos) {
+        jls_bk_counter_add(&self->seek_count, 1);
+    }
     self->fpos = pos;
     return 0;
 }
 
 int64_t jls_bk_ftell(struct jls_bkf_s * self) {
+    if (self->ops) {
+        return self->fpos;
+    }
+    if (self->winol) {
+        // queued writes do not advance the descriptor offset
+        return self->fpos;
+    }
     return _telli64(self->fd);
 }
 
 int32_t jls_bk_fflush(struct jls_bkf_s * self) {
-    return _commit(self->fd);
+    int64_t t_start = jls_now();
+    int32_t rc = 0;
+    if (self->ops) {
+        rc = self->ops->flush ? self->ops->flush(self) : 0;
+    } else {
+        if (self->winol) {
+            rc = jls_winol_drain(self->winol);
+        }
+        if (0 == rc) {
+            rc = _commit(self->fd);
+        }
+    }
+    jls_bk_counter_add(&self->flush_duration, (uint64_t) (jls_now() - t_start));
+    return rc;
+}
+
+int32_t jls_bk_punch_hole(struct jls_bkf_s * self, int64_t offset, int64_t length) {
+    if (self->ops || self->winol) {
+        // cannot order against queued asynchronous writes
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    HANDLE h = (HANDLE) _get_osfhandle(self->fd);
+    if (INVALID_HANDLE_VALUE == h) {
+        return JLS_ERROR_IO;
+    }
+    DWORD returned = 0;
+    if (!DeviceIoControl(h, FSCTL_SET_SPARSE, NULL, 0, NULL, 0, &returned, NULL)) {
+        return JLS_ERROR_NOT_SUPPORTED;  // filesystem dependent
+    }
+    FILE_ZERO_DATA_INFORMATION zero;
+    zero.FileOffset.QuadPart = offset;
+    zero.BeyondFinalZero.QuadPart = offset + length;
+    if (!DeviceIoControl(h, FSCTL_SET_ZERO_DATA, &zero, sizeof(zero), NULL, 0, &returned, NULL)) {
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    return 0;
+}
+
+int32_t jls_bk_shm_open(struct jls_bk_shm_s * self, const char * name, int64_t size) {
+    if (!self || !name || !name[0] || (size <= 0)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    HANDLE h = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+                                  (DWORD) (size >> 32), (DWORD) (size & 0xffffffff), name);
+    if (NULL == h) {
+        JLS_LOGW("CreateFileMapping(%s) failed %d", name, (int) GetLastError());
+        return JLS_ERROR_IO;
+    }
+    void * p = MapViewOfFile(h, FILE_MAP_ALL_ACCESS, 0, 0, (SIZE_T) size);
+    if (NULL == p) {
+        JLS_LOGW("MapViewOfFile failed %d", (int) GetLastError());
+        CloseHandle(h);
+        return JLS_ERROR_IO;
+    }
+    self->ptr = p;
+    self->size = size;
+    self->handle = (intptr_t) h;
+    return 0;
+}
+
+int32_t jls_bk_shm_close(struct jls_bk_shm_s * self) {
+    if (!self || (NULL == self->ptr)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    UnmapViewOfFile(self->ptr);
+    CloseHandle((HANDLE) self->handle);
+    self->ptr = NULL;
+    self->size = 0;
+    return 0;
 }
 
 int32_t jls_bk_truncate(struct jls_bkf_s * self) {
+    if (self->ops) {
+        if (NULL == self->ops->truncate) {
+            return JLS_ERROR_NOT_SUPPORTED;
+        }
+        ROE(self->ops->truncate(self));
+        if (self->fend > self->fpos) {
+            self->fend = self->fpos;
+        }
+        return 0;
+    }
+    if (self->winol) {
+        ROE(jls_winol_drain(self->winol));
+    }
     if (_chsize_s(self->fd, self->fpos) < 0) {
         JLS_LOGE("V failed %d", errno);
         return JLS_ERROR_IO;
@@ -182,6 +540,12 @@ struct jls_bkt_s * jls_bkt_initialize(struct jls_twr_s * wr) {
         return NULL;
     }
 
+    self->ack_event = CreateEvent(NULL, TRUE, FALSE, NULL);
+    if (!self->ack_event) {
+        jls_bkt_finalize(self);
+        return NULL;
+    }
+
     wr->bk = self;
     self->thread = CreateThread(
             NULL,                   // default security attributes
@@ -215,6 +579,10 @@ void jls_bkt_finalize(struct jls_bkt_s * self) {
             CloseHandle(self->msg_event);
             self->msg_event = NULL;
         }
+        if (self->ack_event) {
+            CloseHandle(self->ack_event);
+            self->ack_event = NULL;
+        }
         if (self->msg_mutex) {
             CloseHandle(self->msg_mutex);
             self->msg_mutex = NULL;
@@ -270,10 +638,119 @@ void jls_bkt_msg_signal(struct jls_bkt_s * self) {
     SetEvent(self->msg_event);
 }
 
+void jls_bkt_ack_wait(struct jls_bkt_s * self, uint32_t timeout_ms) {
+    WaitForSingleObject(self->ack_event, timeout_ms);
+    ResetEvent(self->ack_event);
+}
+
+void jls_bkt_ack_signal(struct jls_bkt_s * self) {
+    SetEvent(self->ack_event);
+}
+
 void jls_bkt_sleep_ms(uint32_t duration_ms) {
     Sleep(duration_ms);
 }
 
+struct jls_bkm_s {
+    HANDLE mutex;
+};
+
+struct jls_bkm_s * jls_bkm_initialize(void) {
+    struct jls_bkm_s * self = calloc(1, sizeof(struct jls_bkm_s));
+    if (NULL == self) {
+        return NULL;
+    }
+    self->mutex = CreateMutex(
+            NULL,                   // default security attributes
+            FALSE,                  // initially not owned
+            NULL);                  // unnamed mutex
+    if (!self->mutex) {
+        free(self);
+        return NULL;
+    }
+    return self;
+}
+
+void jls_bkm_finalize(struct jls_bkm_s * self) {
+    if (self) {
+        if (self->mutex) {
+            CloseHandle(self->mutex);
+            self->mutex = NULL;
+        }
+        free(self);
+    }
+}
+
+int jls_bkm_lock(struct jls_bkm_s * self) {
+    DWORD rc = WaitForSingleObject(self->mutex, INFINITE);
+    if (WAIT_OBJECT_0 != rc) {
+        JLS_LOGE("jls_bkm_lock failed %d", (int) rc);
+        return rc;
+    }
+    return 0;
+}
+
+int jls_bkm_unlock(struct jls_bkm_s * self) {
+    if (!ReleaseMutex(self->mutex)) {
+        JLS_LOGE("jls_bkm_unlock failed");
+        return 1;
+    }
+    return 0;
+}
+
+struct jls_bk_thread_s {
+    HANDLE thread;
+    jls_bk_thread_fn fn;
+    void * user_data;
+};
+
+static DWORD WINAPI bk_thread_task(LPVOID user_data) {
+    struct jls_bk_thread_s * self = (struct jls_bk_thread_s *) user_data;
+    self->fn(self->user_data);
+    return 0;
+}
+
+int32_t jls_bk_thread_run(struct jls_bk_thread_s ** thread, jls_bk_thread_fn fn, void * user_data) {
+    if (!thread || !fn) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_bk_thread_s * self = calloc(1, sizeof(struct jls_bk_thread_s));
+    if (!self) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    self->fn = fn;
+    self->user_data = user_data;
+    self->thread = CreateThread(
+            NULL,                   // default security attributes
+            0,                      // use default stack size
+            bk_thread_task,         // thread function name
+            self,                   // argument to thread function
+            0,                      // use default creation flags
+            NULL);                  // returns the thread identifier
+    if (!self->thread) {
+        JLS_LOGE("jls_bk_thread_run: CreateThread failed %d", (int) GetLastError());
+        free(self);
+        return JLS_ERROR_UNSPECIFIED;
+    }
+    *thread = self;
+    return 0;
+}
+
+int32_t jls_bk_thread_join(struct jls_bk_thread_s * self) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    int32_t rc = 0;
+    DWORD rv = WaitForSingleObject(self->thread, INFINITE);
+    if (WAIT_OBJECT_0 != rv) {
+        JLS_LOGE("jls_bk_thread_join wait failed %d", (int) rv);
+        rc = JLS_ERROR_UNSPECIFIED;
+    }
+    CloseHandle(self->thread);
+    free(self);
+    return rc;
+}
+
 
 int64_t jls_now(void) {
     // Contains a 64-bit value representing the number of 100-nanosecond intervals since January 1, 1601 (UTC).
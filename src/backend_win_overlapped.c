@@ -0,0 +1,187 @@
+/*
+ * Copyright 2021-2023 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if defined(_WIN32)
+
+#include "jls/backend_overlapped.h"
+#include "jls/ec.h"
+#include "jls/log.h"
+#include <windows.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define QUEUE_DEPTH (64)        // writes in flight before blocking
+#define SECTOR_SIZE (4096)      // FILE_FLAG_NO_BUFFERING alignment
+
+
+struct slot_s {
+    OVERLAPPED ov;          // hEvent created once at open
+    void * buf;             // owned copy of the caller data
+    uint32_t count;
+    bool in_flight;
+};
+
+struct jls_winol_s {
+    HANDLE file;            // second handle with FILE_FLAG_OVERLAPPED
+    uint32_t inflight;
+    uint32_t idx;           // next slot, round robin
+    int32_t error;          // first deferred write error, latched
+    bool no_buffering;
+    struct slot_s slots[QUEUE_DEPTH];
+};
+
+static void slot_free_buf(struct jls_winol_s * self, struct slot_s * slot) {
+    if (slot->buf) {
+        if (self->no_buffering) {
+            _aligned_free(slot->buf);
+        } else {
+            free(slot->buf);
+        }
+        slot->buf = NULL;
+    }
+}
+
+// Wait for one queued write to complete.
+static void slot_complete(struct jls_winol_s * self, struct slot_s * slot) {
+    DWORD transferred = 0;
+    if (!GetOverlappedResult(self->file, &slot->ov, &transferred, TRUE)
+            || (transferred != slot->count)) {
+        if (!self->error) {
+            JLS_LOGE("queued write failed: error=%d, transferred=%d, count=%u",
+                     (int) GetLastError(), (int) transferred, slot->count);
+            self->error = JLS_ERROR_IO;
+        }
+    }
+    slot_free_buf(self, slot);
+    slot->in_flight = false;
+    --self->inflight;
+}
+
+int32_t jls_winol_open(struct jls_winol_s ** instance, const wchar_t * filename, bool no_buffering) {
+    if (!instance || !filename) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_winol_s * self = calloc(1, sizeof(struct jls_winol_s));
+    if (!self) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    self->no_buffering = no_buffering;
+
+    DWORD flags = FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED;
+    if (no_buffering) {
+        flags |= FILE_FLAG_NO_BUFFERING;
+    }
+    // second handle: the CRT cannot open with FILE_FLAG_OVERLAPPED
+    self->file = CreateFileW(filename, GENERIC_WRITE,
+                             FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                             OPEN_EXISTING, flags, NULL);
+    if (INVALID_HANDLE_VALUE == self->file) {
+        JLS_LOGD1("overlapped open failed %d, using synchronous writes", (int) GetLastError());
+        free(self);
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    for (uint32_t i = 0; i < QUEUE_DEPTH; ++i) {
+        self->slots[i].ov.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+        if (!self->slots[i].ov.hEvent) {
+            JLS_LOGW("overlapped CreateEvent failed %d", (int) GetLastError());
+            for (uint32_t k = 0; k < i; ++k) {
+                CloseHandle(self->slots[k].ov.hEvent);
+            }
+            CloseHandle(self->file);
+            free(self);
+            return JLS_ERROR_NOT_SUPPORTED;
+        }
+    }
+    *instance = self;
+    return 0;
+}
+
+int32_t jls_winol_fwrite(struct jls_winol_s * self, int64_t offset,
+                         const void * buffer, uint32_t count, bool ordered) {
+    if (!self || !buffer || !count) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (self->no_buffering
+            && ((offset % SECTOR_SIZE) || (count % SECTOR_SIZE))) {
+        // the caller falls back to the buffered synchronous path
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    if (ordered) {
+        int32_t rc = jls_winol_drain(self);
+        if (rc) {
+            return rc;
+        }
+    }
+
+    struct slot_s * slot = &self->slots[self->idx];
+    self->idx = (self->idx + 1) % QUEUE_DEPTH;
+    if (slot->in_flight) {
+        slot_complete(self, slot);  // oldest entry, wait for it
+    }
+    if (self->no_buffering) {
+        slot->buf = _aligned_malloc(count, SECTOR_SIZE);
+    } else {
+        slot->buf = malloc(count);
+    }
+    if (!slot->buf) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    memcpy(slot->buf, buffer, count);
+    slot->count = count;
+    slot->ov.Offset = (DWORD) (offset & 0xffffffff);
+    slot->ov.OffsetHigh = (DWORD) (offset >> 32);
+    ResetEvent(slot->ov.hEvent);
+    if (!WriteFile(self->file, slot->buf, count, NULL, &slot->ov)) {
+        DWORD err = GetLastError();
+        if (ERROR_IO_PENDING != err) {
+            JLS_LOGE("overlapped WriteFile failed %d", (int) err);
+            slot_free_buf(self, slot);
+            return JLS_ERROR_IO;
+        }
+    }
+    slot->in_flight = true;
+    ++self->inflight;
+    return self->error;
+}
+
+int32_t jls_winol_drain(struct jls_winol_s * self) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    for (uint32_t i = 0; self->inflight && (i < QUEUE_DEPTH); ++i) {
+        struct slot_s * slot = &self->slots[i];
+        if (slot->in_flight) {
+            slot_complete(self, slot);
+        }
+    }
+    return self->error;
+}
+
+int32_t jls_winol_close(struct jls_winol_s * self) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    int32_t rc = jls_winol_drain(self);
+    for (uint32_t i = 0; i < QUEUE_DEPTH; ++i) {
+        CloseHandle(self->slots[i].ov.hEvent);
+    }
+    CloseHandle(self->file);
+    free(self);
+    return rc;
+}
+
+#endif  /* _WIN32 */
@@ -14,26 +14,43 @@
  * limitations under the License.
  */
 
-#include "jls/bit_shift.h"
-#include "jls/ec.h"
+/*
+ * Dynamically detect the bit shift implementation, using the same
+ * approach as crc32c.c.  The scalar loop processes about one byte per
+ * cycle, which throttles every unaligned u1/u4 signal read, so use the
+ * SIMD kernels whenever the target supports them.
+ */
+
+#if defined(JLS_OPTIMIZE_CRC_DISABLE) || defined(JLS_OPTIMIZE_SHIFT_DISABLE)
+#include "bit_shift_sw.c"
+
+#elif defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+#if defined(_M_X64) || defined(__x86_64__)
+#include "bit_shift_intel_sse.c"
+#else
+#include "bit_shift_sw.c"
+#endif
+
+#elif defined(__APPLE__) && defined(__MACH__)
+#if defined(_M_ARM64) || defined(__aarch64__) || defined(__arm64__)
+#include "bit_shift_arm_neon.c"
+#elif defined(_M_X64) || defined(__x86_64__)
+#include "bit_shift_intel_sse.c"
+#else
+#include "bit_shift_sw.c"
+#endif
+
+#elif defined(__linux__) && __linux__
+#if defined(_M_X64) || defined(__x86_64__)
+#include "bit_shift_intel_sse.c"
+#elif defined(__aarch64__)
+// NEON is architecturally required on aarch64, unlike the CRC extension.
+#include "bit_shift_arm_neon.c"
+#else
+#include "bit_shift_sw.c"
+#endif
 
-int32_t jls_bit_shift_array_right(uint8_t bits, void * data, size_t size) {
-    if ((bits == 0) || (size == 0)) {
-        return 0;
-    }
-    if (bits >= 8) {
-        return JLS_ERROR_PARAMETER_INVALID;
-    }
+#else
+#include "bit_shift_sw.c"
 
-    uint8_t * u8 = (uint8_t *) data;
-    if (size == 1) {
-        u8[0] >>= bits;
-        return 0;
-    }
-    uint8_t carry = u8[0] >> bits;
-    for (size_t i = 1; i < size; ++i) {
-        u8[i - 1] = (u8[i] << (8 - bits)) | carry;
-        carry = u8[i] >> bits;
-    }
-    return 0;
-}
+#endif
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2022 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/bit_shift.h"
+#include "jls/ec.h"
+#include <emmintrin.h>
+
+int32_t jls_bit_shift_array_right(uint8_t bits, void * data, size_t size) {
+    if ((bits == 0) || (size == 0)) {
+        return 0;
+    }
+    if (bits >= 8) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+
+    uint8_t * u8 = (uint8_t *) data;
+    if (size == 1) {
+        u8[0] >>= bits;
+        return 0;
+    }
+
+    // out[i] = (u8[i] >> bits) | (u8[i + 1] << (8 - bits)), last byte preserved.
+    // SSE has no per-byte shifts: shift 16-bit lanes, then mask cross-byte spill.
+    size_t i = 0;
+    const size_t end = size - 1;
+    const __m128i mask_lo = _mm_set1_epi8((char) (uint8_t) (0xFFU >> bits));
+    const __m128i mask_hi = _mm_set1_epi8((char) (uint8_t) (0xFFU << (8 - bits)));
+    for (; (i + 16) <= end; i += 16) {
+        __m128i v0 = _mm_loadu_si128((const __m128i *) (u8 + i));
+        __m128i v1 = _mm_loadu_si128((const __m128i *) (u8 + i + 1));
+        __m128i lo = _mm_and_si128(_mm_srli_epi16(v0, bits), mask_lo);
+        __m128i hi = _mm_and_si128(_mm_slli_epi16(v1, 8 - bits), mask_hi);
+        _mm_storeu_si128((__m128i *) (u8 + i), _mm_or_si128(lo, hi));
+    }
+    uint8_t carry = u8[i] >> bits;
+    for (++i; i < size; ++i) {
+        u8[i - 1] = (u8[i] << (8 - bits)) | carry;
+        carry = u8[i] >> bits;
+    }
+    return 0;
+}
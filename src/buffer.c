@@ -18,10 +18,22 @@
 #include "jls/cdef.h"
 #include "jls/ec.h"
 #include "jls/log.h"
+#include "jls/xxh64.h"
+#include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
 
 
+#define INTERN_ALLOC_INIT (64)
+
+// process-wide pool of freed buffer instances, reused across reader
+// and writer open/close cycles to avoid allocator churn
+#define BUF_POOL_SIZE (8)
+// only pool instances that have not grown far beyond the default size
+#define BUF_POOL_ALLOC_MAX (2 * JLS_BUF_DEFAULT_SIZE)
+static struct jls_buf_s * buf_pool[BUF_POOL_SIZE];
+
+
 static inline int32_t wr_end(struct jls_buf_s * self) {
     if (self->cur > self->end) {
         self->end = self->cur;
@@ -45,7 +57,61 @@ static int32_t strings_alloc(struct jls_buf_s * self) {
     return 0;
 }
 
+static int32_t intern_resize(struct jls_buf_s * self, size_t alloc) {
+    struct jls_buf_intern_s * t = calloc(alloc, sizeof(struct jls_buf_intern_s));
+    if (NULL == t) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    for (size_t i = 0; i < self->intern_alloc; ++i) {
+        if (NULL != self->intern[i].cstr) {
+            size_t k = self->intern[i].hash & (alloc - 1);
+            while (NULL != t[k].cstr) {
+                k = (k + 1) & (alloc - 1);
+            }
+            t[k] = self->intern[i];
+        }
+    }
+    free(self->intern);
+    self->intern = t;
+    self->intern_alloc = alloc;
+    return 0;
+}
+
+static char * intern_get(struct jls_buf_s * self, uint64_t hash, const char * cstr) {
+    if (0 == self->intern_alloc) {
+        return NULL;
+    }
+    size_t k = hash & (self->intern_alloc - 1);
+    while (NULL != self->intern[k].cstr) {
+        if ((self->intern[k].hash == hash) && (0 == strcmp(self->intern[k].cstr, cstr))) {
+            return self->intern[k].cstr;
+        }
+        k = (k + 1) & (self->intern_alloc - 1);
+    }
+    return NULL;
+}
+
+static int32_t intern_put(struct jls_buf_s * self, uint64_t hash, char * cstr) {
+    if ((self->intern_count * 4) >= (self->intern_alloc * 3)) {
+        ROE(intern_resize(self, self->intern_alloc ? (self->intern_alloc * 2) : INTERN_ALLOC_INIT));
+    }
+    size_t k = hash & (self->intern_alloc - 1);
+    while (NULL != self->intern[k].cstr) {
+        k = (k + 1) & (self->intern_alloc - 1);
+    }
+    self->intern[k].hash = hash;
+    self->intern[k].cstr = cstr;
+    ++self->intern_count;
+    return 0;
+}
+
 struct jls_buf_s * jls_buf_alloc(void) {
+    for (int i = 0; i < BUF_POOL_SIZE; ++i) {
+        struct jls_buf_s * s = __atomic_exchange_n(&buf_pool[i], NULL, __ATOMIC_ACQ_REL);
+        if (NULL != s) {
+            return s;
+        }
+    }
     struct jls_buf_s * s = calloc(1, sizeof(struct jls_buf_s));
     if (NULL == s) {
         JLS_LOGE("jls_buf_alloc out of memory on jls_buf_s");
@@ -61,27 +127,64 @@ struct jls_buf_s * jls_buf_alloc(void) {
     s->end = s->start;
     s->length = 0;
     s->alloc_size = JLS_BUF_DEFAULT_SIZE;
+    s->alloc_max = 0;
     s->strings_head = NULL;
     s->strings_tail = NULL;
     return s;
 }
 
-void jls_buf_free(struct jls_buf_s * self) {
-    if (NULL == self) {
-        return;
-    }
+static void buf_destroy(struct jls_buf_s * self) {
     while (NULL != self->strings_head) {
         struct jls_buf_strings_s * next = self->strings_head->next;
         self->strings_head->next = NULL;
         free(self->strings_head);
         self->strings_head = next;
     }
+    if (NULL != self->intern) {
+        free(self->intern);
+    }
     if (NULL != self->start) {
         free(self->start);
     }
     free(self);
 }
 
+void jls_buf_free(struct jls_buf_s * self) {
+    if (NULL == self) {
+        return;
+    }
+    if ((self->alloc_size <= BUF_POOL_ALLOC_MAX)
+            && (self->strings_head == self->strings_tail)) {
+        // reset for reuse
+        jls_buf_reset(self);
+        self->alloc_max = 0;
+        if (NULL != self->strings_tail) {
+            self->strings_tail->cur = self->strings_tail->buffer;
+        }
+        if (self->intern_alloc) {
+            memset(self->intern, 0, self->intern_alloc * sizeof(struct jls_buf_intern_s));
+            self->intern_count = 0;
+        }
+        for (int i = 0; i < BUF_POOL_SIZE; ++i) {
+            struct jls_buf_s * expected = NULL;
+            if (__atomic_compare_exchange_n(&buf_pool[i], &expected, self, false,
+                                            __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+                return;
+            }
+        }
+    }
+    buf_destroy(self);
+}
+
+void jls_buf_pool_clear(void) {
+    for (int i = 0; i < BUF_POOL_SIZE; ++i) {
+        struct jls_buf_s * s = __atomic_exchange_n(&buf_pool[i], NULL, __ATOMIC_ACQ_REL);
+        if (NULL != s) {
+            buf_destroy(s);
+        }
+    }
+}
+
 int32_t jls_buf_realloc(struct jls_buf_s * self, size_t size) {
     if (size <= self->alloc_size) {
         return 0;
@@ -89,7 +192,14 @@ int32_t jls_buf_realloc(struct jls_buf_s * self, size_t size) {
 
     size_t alloc_size = self->alloc_size;
     while (alloc_size < size) {
-        alloc_size *= alloc_size;
+        alloc_size *= 2;
+    }
+    if (self->alloc_max && (alloc_size > self->alloc_max)) {
+        if (size > self->alloc_max) {
+            JLS_LOGW("jls_buf_realloc exceeds memory budget: %zu > %zu", size, self->alloc_max);
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        alloc_size = self->alloc_max;
     }
 
     uint8_t * ptr = realloc(self->start, alloc_size);
@@ -122,10 +232,18 @@ int32_t jls_buf_copy(struct jls_buf_s * self, const struct jls_buf_s * src) {
 }
 
 int32_t jls_buf_string_save(struct jls_buf_s * self, const char * cstr_in, char ** cstr_save) {
+    size_t sz = strlen(cstr_in) + 1;
+    uint64_t hash = jls_xxh64((const uint8_t *) cstr_in, sz - 1);
+    char * existing = intern_get(self, hash, cstr_in);
+    if (NULL != existing) {
+        if (NULL != cstr_save) {
+            *cstr_save = existing;
+        }
+        return 0;
+    }
     if (NULL == self->strings_tail) {
         ROE(strings_alloc(self));
     }
-    size_t sz = strlen(cstr_in) + 1;
     struct jls_buf_strings_s * s = self->strings_tail;
     char * buf_end = s->buffer + sizeof(s->buffer) - 1;
     if ((size_t) (buf_end - s->cur) < sz) {
@@ -133,6 +251,7 @@ int32_t jls_buf_string_save(struct jls_buf_s * self, const char * cstr_in, char
         s = self->strings_tail;
     }
     memcpy(s->cur, cstr_in, sz);
+    ROE(intern_put(self, hash, s->cur));
     if (NULL != cstr_save) {
         *cstr_save = s->cur;
     }
@@ -226,6 +345,15 @@ int32_t jls_buf_wr_i64(struct jls_buf_s * self, int64_t value) {
     return wr_end(self);
 }
 
+int32_t jls_buf_rd_bin(struct jls_buf_s * self, void * data, uint32_t data_size) {
+    if ((self->cur + data_size) > self->end) {
+        return JLS_ERROR_EMPTY;
+    }
+    memcpy(data, self->cur, data_size);
+    self->cur += data_size;
+    return 0;
+}
+
 int32_t jls_buf_rd_skip(struct jls_buf_s * self, size_t count) {
     if ((self->cur + count) > self->end) {
         return JLS_ERROR_EMPTY;
@@ -265,6 +393,22 @@ int32_t jls_buf_rd_u32(struct jls_buf_s * self, uint32_t * value) {
     return 0;
 }
 
+int32_t jls_buf_rd_i64(struct jls_buf_s * self, int64_t * value) {
+    if ((self->cur + sizeof(*value)) > self->end) {
+        return JLS_ERROR_EMPTY;
+    }
+    *value = (int64_t) (((uint64_t) self->cur[0])
+             | (((uint64_t) self->cur[1]) << 8)
+             | (((uint64_t) self->cur[2]) << 16)
+             | (((uint64_t) self->cur[3]) << 24)
+             | (((uint64_t) self->cur[4]) << 32)
+             | (((uint64_t) self->cur[5]) << 40)
+             | (((uint64_t) self->cur[6]) << 48)
+             | (((uint64_t) self->cur[7]) << 56));
+    self->cur += sizeof(*value);
+    return 0;
+}
+
 int32_t jls_buf_rd_str(struct jls_buf_s * self, const char ** value) {
     struct jls_buf_strings_s * s;
     if (NULL == self->strings_tail) {
@@ -292,7 +436,15 @@ int32_t jls_buf_rd_str(struct jls_buf_s * self, const char ** value) {
             if (*self->cur == 0x1f) {
                 self->cur++;
             }
-            *value = str;
+            uint64_t hash = jls_xxh64((const uint8_t *) str, (size_t) (s->cur - str) - 1);
+            char * existing = intern_get(self, hash, str);
+            if (NULL != existing) {
+                s->cur = str;  // reclaim: return the shared interned copy
+                *value = existing;
+            } else {
+                ROE(intern_put(self, hash, str));
+                *value = str;
+            }
             return 0;
         }
     }
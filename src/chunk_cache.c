@@ -0,0 +1,199 @@
+/*
+ * Copyright 2021-2023 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/chunk_cache.h"
+#include "jls/ec.h"
+#include "jls/log.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+#define BUCKETS_MIN (256)
+#define BUCKETS_MAX (1 << 20)
+#define BYTES_PER_BUCKET (16384)  // heuristic bucket count scaling
+
+
+struct entry_s {
+    int64_t offset;
+    struct jls_chunk_header_s hdr;
+    struct entry_s * hash_next;
+    struct entry_s * lru_prev;
+    struct entry_s * lru_next;
+    uint8_t payload[];
+};
+
+struct jls_chunk_cache_s {
+    size_t size;        // current total size in bytes, including entry overhead
+    size_t size_max;
+    size_t bucket_mask; // bucket count - 1, power of 2
+    struct entry_s ** buckets;
+    struct entry_s * lru_head;  // most recently used
+    struct entry_s * lru_tail;  // least recently used
+};
+
+static inline size_t bucket_index(struct jls_chunk_cache_s * self, int64_t offset) {
+    // chunks are 8-byte aligned, mix the offset for an even spread
+    uint64_t h = ((uint64_t) offset) >> 3;
+    h *= 0x9e3779b97f4a7c15LLU;
+    return (size_t) (h >> 32) & self->bucket_mask;
+}
+
+static inline size_t entry_size(const struct entry_s * entry) {
+    return sizeof(*entry) + entry->hdr.payload_length;
+}
+
+static void lru_unlink(struct jls_chunk_cache_s * self, struct entry_s * entry) {
+    if (entry->lru_prev) {
+        entry->lru_prev->lru_next = entry->lru_next;
+    } else {
+        self->lru_head = entry->lru_next;
+    }
+    if (entry->lru_next) {
+        entry->lru_next->lru_prev = entry->lru_prev;
+    } else {
+        self->lru_tail = entry->lru_prev;
+    }
+    entry->lru_prev = NULL;
+    entry->lru_next = NULL;
+}
+
+static void lru_push_head(struct jls_chunk_cache_s * self, struct entry_s * entry) {
+    entry->lru_prev = NULL;
+    entry->lru_next = self->lru_head;
+    if (self->lru_head) {
+        self->lru_head->lru_prev = entry;
+    } else {
+        self->lru_tail = entry;
+    }
+    self->lru_head = entry;
+}
+
+static void hash_remove(struct jls_chunk_cache_s * self, struct entry_s * entry) {
+    struct entry_s ** p = &self->buckets[bucket_index(self, entry->offset)];
+    while (*p) {
+        if (*p == entry) {
+            *p = entry->hash_next;
+            return;
+        }
+        p = &(*p)->hash_next;
+    }
+}
+
+static struct entry_s * hash_find(struct jls_chunk_cache_s * self, int64_t offset) {
+    struct entry_s * entry = self->buckets[bucket_index(self, offset)];
+    while (entry) {
+        if (entry->offset == offset) {
+            return entry;
+        }
+        entry = entry->hash_next;
+    }
+    return NULL;
+}
+
+static void evict_tail(struct jls_chunk_cache_s * self) {
+    struct entry_s * entry = self->lru_tail;
+    if (entry) {
+        lru_unlink(self, entry);
+        hash_remove(self, entry);
+        self->size -= entry_size(entry);
+        free(entry);
+    }
+}
+
+int32_t jls_chunk_cache_alloc(struct jls_chunk_cache_s ** instance, size_t size_max) {
+    if (!instance || !size_max) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_chunk_cache_s * self = calloc(1, sizeof(struct jls_chunk_cache_s));
+    if (!self) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    self->size_max = size_max;
+    size_t buckets = BUCKETS_MIN;
+    while ((buckets < (size_max / BYTES_PER_BUCKET)) && (buckets < BUCKETS_MAX)) {
+        buckets <<= 1;
+    }
+    self->bucket_mask = buckets - 1;
+    self->buckets = calloc(buckets, sizeof(struct entry_s *));
+    if (!self->buckets) {
+        free(self);
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    *instance = self;
+    return 0;
+}
+
+void jls_chunk_cache_free(struct jls_chunk_cache_s * self) {
+    if (self) {
+        struct entry_s * entry = self->lru_head;
+        while (entry) {
+            struct entry_s * next = entry->lru_next;
+            free(entry);
+            entry = next;
+        }
+        free(self->buckets);
+        free(self);
+    }
+}
+
+int32_t jls_chunk_cache_get(struct jls_chunk_cache_s * self, int64_t offset,
+                            struct jls_chunk_header_s * hdr, const uint8_t ** payload) {
+    if (!self || !hdr || !payload) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct entry_s * entry = hash_find(self, offset);
+    if (!entry) {
+        return JLS_ERROR_NOT_FOUND;
+    }
+    if (entry != self->lru_head) {
+        lru_unlink(self, entry);
+        lru_push_head(self, entry);
+    }
+    *hdr = entry->hdr;
+    *payload = entry->payload;
+    return 0;
+}
+
+int32_t jls_chunk_cache_put(struct jls_chunk_cache_s * self, int64_t offset,
+                            const struct jls_chunk_header_s * hdr, const uint8_t * payload) {
+    if (!self || !hdr || (hdr->payload_length && !payload)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (hash_find(self, offset)) {
+        return 0;  // already cached, get handles recency
+    }
+    size_t sz = sizeof(struct entry_s) + hdr->payload_length;
+    if (sz > (self->size_max / 4)) {
+        return 0;  // too large relative to the cache, not worth evicting for
+    }
+    while ((self->size + sz) > self->size_max) {
+        evict_tail(self);
+    }
+    struct entry_s * entry = malloc(sz);
+    if (!entry) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    entry->offset = offset;
+    entry->hdr = *hdr;
+    if (hdr->payload_length) {
+        memcpy(entry->payload, payload, hdr->payload_length);
+    }
+    entry->hash_next = self->buckets[bucket_index(self, offset)];
+    self->buckets[bucket_index(self, offset)] = entry;
+    lru_push_head(self, entry);
+    self->size += sz;
+    return 0;
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/compress.h"
+#include "jls/format.h"
+#include "jls/ec.h"
+#include <string.h>
+
+#if defined(JLS_HAS_ZSTD)
+#include <zstd.h>
+#endif
+#if defined(JLS_HAS_LZ4)
+#include <lz4.h>
+#endif
+
+// RLE control byte: 0x00-0x7f copies (control + 1) literal bytes that
+// follow, 0x80-0xff repeats the single byte that follows
+// (control - 0x80 + RLE_RUN_MIN) times.
+#define RLE_RUN_MIN (3)
+#define RLE_RUN_MAX (0x7f + RLE_RUN_MIN)
+#define RLE_LITERAL_MAX (0x80)
+
+static uint32_t rle_run_length(const uint8_t * src, uint32_t src_length) {
+    uint32_t run = 1;
+    while ((run < src_length) && (run < RLE_RUN_MAX) && (src[run] == src[0])) {
+        ++run;
+    }
+    return run;
+}
+
+static int32_t rle_compress(const uint8_t * src, uint32_t src_length,
+                            uint8_t * dst, uint32_t dst_length) {
+    const uint8_t * src_end = src + src_length;
+    uint8_t * d = dst;
+    uint8_t * dst_end = dst + dst_length;
+    while (src < src_end) {
+        uint32_t remaining = (uint32_t) (src_end - src);
+        uint32_t run = rle_run_length(src, remaining);
+        if (run >= RLE_RUN_MIN) {
+            if ((dst_end - d) < 2) {
+                return 0;
+            }
+            *d++ = (uint8_t) (0x80 + (run - RLE_RUN_MIN));
+            *d++ = src[0];
+            src += run;
+            continue;
+        }
+        uint32_t literal = 0;
+        while ((literal < remaining) && (literal < RLE_LITERAL_MAX)) {
+            uint32_t next = rle_run_length(src + literal, remaining - literal);
+            if (next >= RLE_RUN_MIN) {
+                break;
+            }
+            literal += next;
+        }
+        if (literal > RLE_LITERAL_MAX) {
+            literal = RLE_LITERAL_MAX;
+        }
+        if ((uint32_t) (dst_end - d) < (literal + 1)) {
+            return 0;
+        }
+        *d++ = (uint8_t) (literal - 1);
+        memcpy(d, src, literal);
+        d += literal;
+        src += literal;
+    }
+    return (int32_t) (d - dst);
+}
+
+static int32_t rle_decompress(const uint8_t * src, uint32_t src_length,
+                              uint8_t * dst, uint32_t dst_length) {
+    const uint8_t * src_end = src + src_length;
+    uint8_t * dst_end = dst + dst_length;
+    while (src < src_end) {
+        uint8_t control = *src++;
+        if (control < 0x80) {
+            uint32_t literal = (uint32_t) control + 1;
+            if (((src_end - src) < (ptrdiff_t) literal) || ((dst_end - dst) < (ptrdiff_t) literal)) {
+                return JLS_ERROR_MESSAGE_INTEGRITY;
+            }
+            memcpy(dst, src, literal);
+            src += literal;
+            dst += literal;
+        } else {
+            uint32_t run = (uint32_t) (control - 0x80) + RLE_RUN_MIN;
+            if ((src >= src_end) || ((dst_end - dst) < (ptrdiff_t) run)) {
+                return JLS_ERROR_MESSAGE_INTEGRITY;
+            }
+            memset(dst, *src++, run);
+            dst += run;
+        }
+    }
+    if (dst != dst_end) {
+        return JLS_ERROR_MESSAGE_INTEGRITY;
+    }
+    return 0;
+}
+
+int32_t jls_compression_available(uint8_t compression) {
+    switch (compression) {
+        case JLS_COMPRESSION_NONE: return 1;
+        case JLS_COMPRESSION_RLE: return 1;
+#if defined(JLS_HAS_ZSTD)
+        case JLS_COMPRESSION_ZSTD: return 1;
+#endif
+#if defined(JLS_HAS_LZ4)
+        case JLS_COMPRESSION_LZ4: return 1;
+#endif
+        default: return 0;
+    }
+}
+
+uint32_t jls_compress_bound(uint8_t compression, uint32_t src_length) {
+    switch (compression) {
+        case JLS_COMPRESSION_RLE:
+            // worst case: all literals, one control byte per RLE_LITERAL_MAX bytes
+            return src_length + (src_length / RLE_LITERAL_MAX) + 1;
+#if defined(JLS_HAS_ZSTD)
+        case JLS_COMPRESSION_ZSTD:
+            return (uint32_t) ZSTD_compressBound(src_length);
+#endif
+#if defined(JLS_HAS_LZ4)
+        case JLS_COMPRESSION_LZ4:
+            return (uint32_t) LZ4_compressBound((int) src_length);
+#endif
+        default:
+            return 0;
+    }
+}
+
+int32_t jls_compress(uint8_t compression, const uint8_t * src, uint32_t src_length,
+                     uint8_t * dst, uint32_t dst_length) {
+    if (!src || !dst || !src_length) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    switch (compression) {
+        case JLS_COMPRESSION_RLE:
+            return rle_compress(src, src_length, dst, dst_length);
+#if defined(JLS_HAS_ZSTD)
+        case JLS_COMPRESSION_ZSTD: {
+            size_t sz = ZSTD_compress(dst, dst_length, src, src_length, ZSTD_CLEVEL_DEFAULT);
+            return ZSTD_isError(sz) ? 0 : (int32_t) sz;
+        }
+#endif
+#if defined(JLS_HAS_LZ4)
+        case JLS_COMPRESSION_LZ4: {
+            int sz = LZ4_compress_default((const char *) src, (char *) dst,
+                                          (int) src_length, (int) dst_length);
+            return (sz <= 0) ? 0 : (int32_t) sz;
+        }
+#endif
+        default:
+            return JLS_ERROR_NOT_SUPPORTED;
+    }
+}
+
+int32_t jls_decompress(uint8_t compression, const uint8_t * src, uint32_t src_length,
+                       uint8_t * dst, uint32_t dst_length) {
+    if (!src || !dst || !src_length) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    switch (compression) {
+        case JLS_COMPRESSION_RLE:
+            return rle_decompress(src, src_length, dst, dst_length);
+#if defined(JLS_HAS_ZSTD)
+        case JLS_COMPRESSION_ZSTD: {
+            size_t sz = ZSTD_decompress(dst, dst_length, src, src_length);
+            if (ZSTD_isError(sz) || (sz != dst_length)) {
+                return JLS_ERROR_MESSAGE_INTEGRITY;
+            }
+            return 0;
+        }
+#endif
+#if defined(JLS_HAS_LZ4)
+        case JLS_COMPRESSION_LZ4: {
+            int sz = LZ4_decompress_safe((const char *) src, (char *) dst,
+                                         (int) src_length, (int) dst_length);
+            if (sz != (int) dst_length) {
+                return JLS_ERROR_MESSAGE_INTEGRITY;
+            }
+            return 0;
+        }
+#endif
+        default:
+            return JLS_ERROR_NOT_SUPPORTED;
+    }
+}
@@ -15,17 +15,45 @@
  */
 
 #include "jls/copy.h"
+#include "jls/backend.h"
 #include "jls/ec.h"
 #include "jls/raw.h"
-#include "jls/writer.h"
+#include "jls/reader.h"
+#include "jls/threaded_writer.h"
 #include "jls/buffer.h"
 #include "jls/cdef.h"
+#include "jls/delta.h"
+#include "jls/log.h"
+#include "jls/msg_ring_buffer.h"
+#include "jls/datatype.h"
+#include <float.h>
 #include <inttypes.h>
+#include <math.h>
+#include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 
 #define PROGRESS_INTERVAL_BYTES (10000000LL)
 
+/*
+ * The copy runs as a three-stage pipeline so that the source read,
+ * the chunk parse/rewrite, and the destination compress/write each
+ * get their own thread:
+ *   1. The read stage (thread started here) sequentially reads each
+ *      source chunk, validates the CRC, and decompresses the payload.
+ *      It publishes the decoded chunks to a bounded SPSC ring buffer.
+ *   2. The process stage (calling thread) consumes the ring buffer,
+ *      parses each chunk, and replays it through the writer API.
+ *   3. The write stage is the threaded writer's own thread, which
+ *      performs summarization, compression, and the destination
+ *      file writes.
+ */
+#define COPY_MRB_SIZE (1 << 24)
+// chunks too big for the ring buffer hand off a heap payload instead
+#define COPY_MSG_HEAP_THRESHOLD (COPY_MRB_SIZE / 4)
+
 #define MSG_ERROR(description, ec) do {                                                             \
     char msg_str[1024];                                                                             \
     if (NULL != msg_fn) {                                                                           \
@@ -38,21 +66,376 @@
 } while (0)
 
 
-int32_t jls_copy(const char * src, const char * dst,
-                 jls_copy_msg_fn msg_fn, void * msg_user_data,
-                 jls_copy_progress_fn progress_fn, void * progress_user_data) {
+enum copy_msg_type_e {
+    COPY_MSG_CHUNK = 0,     ///< decoded chunk: hdr + payload
+    COPY_MSG_ERROR = 1,     ///< read stage error: ec + description string payload
+};
+
+// memcpy into and out of the ring message: the ring only guarantees
+// 4-byte alignment, see msg_send_inner() in threaded_writer.c.
+// When heap is NULL, the payload follows this header in the message.
+struct copy_msg_s {
+    uint8_t msg_type;               ///< copy_msg_type_e
+    int32_t ec;                     ///< the error code for COPY_MSG_ERROR
+    int64_t offset;                 ///< the source chunk offset
+    struct jls_chunk_header_s hdr;  ///< the chunk header for COPY_MSG_CHUNK
+    uint32_t length;                ///< the decoded payload length in bytes
+    uint8_t * heap;                 ///< payload location when over COPY_MSG_HEAP_THRESHOLD
+};
+
+struct copy_rd_s {
+    struct jls_raw_s * raw;
+    struct jls_mrb_s mrb;
+    uint8_t * mrb_buf;
+    int64_t offset_end;
+    volatile uint8_t quit;          ///< set by the process stage to abort
+    volatile uint8_t done;          ///< set by the read stage on exit
+    volatile int32_t rc;            ///< the read stage exit status
+};
+
+static uint8_t * copy_msg_alloc(struct copy_rd_s * self, uint32_t payload_length) {
+    uint32_t sz = (uint32_t) sizeof(struct copy_msg_s) + payload_length;
+    uint8_t * b;
+    while (NULL == (b = jls_mrb_alloc(&self->mrb, sz))) {
+        if (self->quit) {
+            return NULL;
+        }
+        jls_bkt_sleep_ms(1);
+    }
+    return b;
+}
+
+static void copy_msg_error(struct copy_rd_s * self, int64_t offset, const char * description, int32_t ec) {
+    uint32_t sz = (uint32_t) (strlen(description) + 1);
+    uint8_t * b = copy_msg_alloc(self, sz);
+    if (NULL == b) {
+        return;
+    }
+    struct copy_msg_s msg = {
+            .msg_type = COPY_MSG_ERROR,
+            .ec = ec,
+            .offset = offset,
+            .length = sz,
+            .heap = NULL,
+    };
+    memcpy(b, &msg, sizeof(msg));
+    memcpy(b + sizeof(msg), description, sz);
+    jls_mrb_commit(&self->mrb);
+}
+
+static void copy_rd_thread(void * user_data) {
+    struct copy_rd_s * self = (struct copy_rd_s *) user_data;
+    struct jls_chunk_header_s hdr;
+    int32_t rc;
+    int64_t offset = jls_raw_chunk_tell(self->raw);
+    struct jls_buf_s * buf = jls_buf_alloc();
+    if (NULL == buf) {
+        self->rc = JLS_ERROR_NOT_ENOUGH_MEMORY;
+        self->done = 1;
+        return;
+    }
+
+    while (!self->quit && (offset < self->offset_end)) {
+        rc = jls_raw_rd_header(self->raw, &hdr);
+        if (rc) {
+            copy_msg_error(self, offset, "jls_raw_rd_header", rc);
+            jls_raw_chunk_seek(self->raw, offset + 1);
+            rc = jls_raw_chunk_scan(self->raw);
+            if (rc) {
+                copy_msg_error(self, offset, "jls_raw_chunk_scan", rc);
+                self->rc = rc;
+                break;
+            }
+        }
+        rc = jls_buf_realloc(buf, hdr.payload_length);
+        if (rc) {
+            copy_msg_error(self, offset, "jls_buf_realloc", rc);
+            self->rc = JLS_ERROR_NOT_ENOUGH_MEMORY;
+            break;
+        }
+        rc = jls_raw_rd_payload(self->raw, (uint32_t) buf->alloc_size, buf->start);
+        if (rc == JLS_ERROR_TOO_BIG) {
+            // compressed chunks may decode larger than the on-disk payload
+            rc = jls_buf_realloc(buf, jls_raw_payload_decoded_length(self->raw));
+            if (0 == rc) {
+                rc = jls_raw_rd_payload(self->raw, (uint32_t) buf->alloc_size, buf->start);
+            }
+        }
+        if (rc) {
+            copy_msg_error(self, offset, "jls_raw_rd_payload", rc);
+            rc = jls_raw_chunk_next(self->raw);
+            if (rc) {
+                copy_msg_error(self, offset, "jls_raw_chunk_next", rc);
+                self->rc = JLS_ERROR_IO;
+                break;
+            }
+            offset = jls_raw_chunk_tell(self->raw);
+            continue;
+        }
+        uint32_t length = (uint32_t) jls_raw_payload_decoded_length(self->raw);
+        offset = jls_raw_chunk_tell(self->raw);
+
+        uint8_t * b;
+        uint8_t * heap = NULL;
+        if ((sizeof(struct copy_msg_s) + length) > COPY_MSG_HEAP_THRESHOLD) {
+            heap = malloc(length);
+            if (NULL == heap) {
+                self->rc = JLS_ERROR_NOT_ENOUGH_MEMORY;
+                break;
+            }
+            memcpy(heap, buf->start, length);
+            b = copy_msg_alloc(self, 0);
+        } else {
+            b = copy_msg_alloc(self, length);
+        }
+        if (NULL == b) {  // quit requested
+            free(heap);
+            break;
+        }
+        struct copy_msg_s msg = {
+                .msg_type = COPY_MSG_CHUNK,
+                .ec = 0,
+                .offset = offset,
+                .hdr = hdr,
+                .length = length,
+                .heap = heap,
+        };
+        memcpy(b, &msg, sizeof(msg));
+        if (NULL == heap) {
+            memcpy(b + sizeof(msg), buf->start, length);
+        }
+        jls_mrb_commit(&self->mrb);
+    }
+    jls_buf_free(buf);
+    self->done = 1;
+}
+
+// The per-signal datatype conversion state for jls_transcode().
+struct transcode_s {
+    uint32_t data_type;                       // the target JLS_DATATYPE_*, q 0
+    uint32_t src_data_type[JLS_SIGNAL_COUNT]; // captured from each SIGNAL_DEF chunk
+    uint8_t en[JLS_SIGNAL_COUNT];             // 1 when the signal converts
+    uint8_t q[JLS_SIGNAL_COUNT];              // computed fixed-point q, INT targets only
+    double * f64;                             // source samples widened to f64
+    void * out;                               // converted target samples
+    size_t alloc;                             // allocated sample capacity of f64 and out
+};
+
+static int32_t transcode_buffers_alloc(struct transcode_s * self, size_t samples) {
+    if (samples <= self->alloc) {
+        return 0;
+    }
+    free(self->f64);
+    free(self->out);
+    self->alloc = 0;
+    self->f64 = malloc(samples * sizeof(double));
+    self->out = malloc(samples * sizeof(double));  // the largest target is 64 bits
+    if ((NULL == self->f64) || (NULL == self->out)) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    self->alloc = samples;
+    return 0;
+}
+
+static int32_t transcode_fsr_data(struct transcode_s * self, uint16_t signal_id,
+                                  struct jls_fsr_data_s * data) {
+    const size_t n = data->header.entry_count;
+    ROE(transcode_buffers_alloc(self, n));
+    ROE(jls_dt_buffer_to_f64(data->data, self->src_data_type[signal_id], self->f64, n));
+    const uint8_t size = jls_datatype_parse_size(self->data_type);
+    if (JLS_DATATYPE_BASETYPE_FLOAT == jls_datatype_parse_basetype(self->data_type)) {
+        if (64 == size) {
+            memcpy(self->out, self->f64, n * sizeof(double));
+        } else {
+            float * o = (float *) self->out;
+            for (size_t i = 0; i < n; ++i) {
+                o[i] = (float) self->f64[i];
+            }
+        }
+        return 0;
+    }
+    // INT target: value = round(v * 2**q), saturated
+    const double scale = (double) ((int64_t) 1 << self->q[signal_id]);
+    const double v_max = (double) ((1ll << (size - 1)) - 1);
+    const double v_min = -v_max - 1.0;
+    switch (size) {
+        case 8: {
+            int8_t * o = (int8_t *) self->out;
+            for (size_t i = 0; i < n; ++i) {
+                double v = nearbyint(self->f64[i] * scale);
+                o[i] = (int8_t) fmax(v_min, fmin(v, v_max));
+            }
+            break;
+        }
+        case 16: {
+            int16_t * o = (int16_t *) self->out;
+            for (size_t i = 0; i < n; ++i) {
+                double v = nearbyint(self->f64[i] * scale);
+                o[i] = (int16_t) fmax(v_min, fmin(v, v_max));
+            }
+            break;
+        }
+        case 32: {
+            int32_t * o = (int32_t *) self->out;
+            for (size_t i = 0; i < n; ++i) {
+                double v = nearbyint(self->f64[i] * scale);
+                o[i] = (int32_t) fmax(v_min, fmin(v, v_max));
+            }
+            break;
+        }
+        default:
+            return JLS_ERROR_NOT_SUPPORTED;
+    }
+    return 0;
+}
+
+static int32_t copy_chunk_process(struct jls_twr_s * wr, const struct jls_chunk_header_s * hdr,
+                                  struct jls_buf_s * buf, uint32_t omit_data,
+                                  struct transcode_s * transcode) {
+    switch (hdr->tag) {
+        case JLS_TAG_INVALID: break;
+        case JLS_TAG_SOURCE_DEF: {
+            struct jls_source_def_s source;
+            source.source_id = hdr->chunk_meta;
+            ROE(jls_buf_rd_skip(buf, 64));
+            ROE(jls_buf_rd_str(buf, (const char **) &source.name));
+            ROE(jls_buf_rd_str(buf, (const char **) &source.vendor));
+            ROE(jls_buf_rd_str(buf, (const char **) &source.model));
+            ROE(jls_buf_rd_str(buf, (const char **) &source.version));
+            ROE(jls_buf_rd_str(buf, (const char **) &source.serial_number));
+            if (source.source_id != 0) {
+                ROE(jls_twr_source_def(wr, &source));
+            }
+            break;
+        }
+        case JLS_TAG_SIGNAL_DEF: {
+            struct jls_signal_def_s signal;
+            signal.signal_id = hdr->chunk_meta;
+            ROE(jls_buf_rd_u16(buf, &signal.source_id));
+            ROE(jls_buf_rd_u8(buf, &signal.signal_type));
+            ROE(jls_buf_rd_u8(buf, &signal.data_encoding));
+            ROE(jls_buf_rd_u32(buf, &signal.data_type));
+            ROE(jls_buf_rd_u32(buf, &signal.sample_rate));
+            ROE(jls_buf_rd_u32(buf, &signal.samples_per_data));
+            ROE(jls_buf_rd_u32(buf, &signal.sample_decimate_factor));
+            ROE(jls_buf_rd_u32(buf, &signal.entries_per_summary));
+            ROE(jls_buf_rd_u32(buf, &signal.summary_decimate_factor));
+            ROE(jls_buf_rd_u32(buf, &signal.annotation_decimate_factor));
+            ROE(jls_buf_rd_u32(buf, &signal.utc_decimate_factor));
+            ROE(jls_buf_rd_skip(buf, 92));
+            ROE(jls_buf_rd_str(buf, (const char **) &signal.name));
+            ROE(jls_buf_rd_str(buf, (const char **) &signal.units));
+            if (signal.signal_id != 0) {
+                if ((NULL != transcode) && (JLS_SIGNAL_TYPE_FSR == signal.signal_type)) {
+                    transcode->src_data_type[signal.signal_id] = signal.data_type;
+                    uint32_t dt = transcode->data_type;
+                    if (JLS_DATATYPE_BASETYPE_INT == jls_datatype_parse_basetype(dt)) {
+                        dt |= ((uint32_t) transcode->q[signal.signal_id]) << 16;
+                    }
+                    if (signal.data_type != dt) {
+                        signal.data_type = dt;
+                        transcode->en[signal.signal_id] = 1;
+                    }
+                }
+                ROE(jls_twr_signal_def(wr, &signal));
+                if (omit_data && (JLS_SIGNAL_TYPE_FSR == signal.signal_type)) {
+                    ROE(jls_twr_fsr_omit_data(wr, signal.signal_id, 1));
+                }
+            }
+            break;
+        }
+
+        case JLS_TAG_TRACK_FSR_DEF: break;
+        case JLS_TAG_TRACK_FSR_HEAD: break;
+        case JLS_TAG_TRACK_FSR_DATA: {
+            uint16_t signal_id = hdr->chunk_meta & 0x0fff;
+            ROE(jls_delta_buf_decode(buf));
+            struct jls_fsr_data_s * data = (struct jls_fsr_data_s *) buf->start;
+            // future: handle omitted data by looking at level 1 index & summary
+            if ((NULL != transcode) && transcode->en[signal_id]) {
+                ROE(transcode_fsr_data(transcode, signal_id, data));
+                ROE(jls_twr_fsr(wr, signal_id, data->header.timestamp,
+                                transcode->out, data->header.entry_count));
+            } else {
+                ROE(jls_twr_fsr(wr, signal_id, data->header.timestamp,
+                                data->data, data->header.entry_count));
+            }
+            break;
+        }
+        case JLS_TAG_TRACK_FSR_INDEX: break;
+        case JLS_TAG_TRACK_FSR_SUMMARY: break;
+
+        case JLS_TAG_TRACK_VSR_DEF: break;
+        case JLS_TAG_TRACK_VSR_HEAD: break;
+        case JLS_TAG_TRACK_VSR_DATA: break;
+        case JLS_TAG_TRACK_VSR_INDEX: break;
+        case JLS_TAG_TRACK_VSR_SUMMARY: break;
+
+        case JLS_TAG_TRACK_ANNOTATION_DEF: break;
+        case JLS_TAG_TRACK_ANNOTATION_HEAD: break;
+        case JLS_TAG_TRACK_ANNOTATION_DATA: {
+            uint16_t signal_id = hdr->chunk_meta & 0x0fff;
+            struct jls_annotation_s * data = (struct jls_annotation_s *) buf->start;
+            ROE(jls_twr_annotation(wr, signal_id, data->timestamp, data->y,
+                        data->annotation_type, data->group_id, data->storage_type,
+                        data->data, data->data_size));
+            break;
+        }
+        case JLS_TAG_TRACK_ANNOTATION_INDEX: break;
+        case JLS_TAG_TRACK_ANNOTATION_SUMMARY: break;
+
+        case JLS_TAG_TRACK_UTC_DEF: break;
+        case JLS_TAG_TRACK_UTC_HEAD: break;
+        case JLS_TAG_TRACK_UTC_DATA: {
+            uint16_t signal_id = hdr->chunk_meta & 0x0fff;
+            struct jls_utc_data_s * data = (struct jls_utc_data_s *) buf->start;
+            ROE(jls_twr_utc(wr, signal_id, data->header.timestamp, data->timestamp));
+            break;
+        }
+        case JLS_TAG_TRACK_UTC_INDEX: break;
+        case JLS_TAG_TRACK_UTC_SUMMARY: break;
+
+        case JLS_TAG_USER_DATA: {
+            enum jls_storage_type_e storage_type = (hdr->chunk_meta >> 12) & 0x000f;
+            if (storage_type != JLS_STORAGE_TYPE_INVALID) {
+                ROE(jls_twr_user_data(wr, hdr->chunk_meta & 0x0fff, (hdr->chunk_meta >> 12) & 0x000f,
+                                      buf->start, hdr->payload_length));
+            }
+            break;
+        }
+        case JLS_TAG_END: break;
+        default: break;
+    }
+    return 0;
+}
+
+static int32_t copy_run(const char * src, const char * dst,
+                        jls_copy_msg_fn msg_fn, void * msg_user_data,
+                        jls_copy_progress_fn progress_fn, void * progress_user_data,
+                        uint32_t omit_data, struct transcode_s * transcode) {
     int32_t rc = 0;
     int64_t offset = 0;
     int64_t offset_progress = 0;
     struct jls_raw_s * rd = NULL;
-    struct jls_wr_s * wr = NULL;
+    struct jls_twr_s * wr = NULL;
+    struct jls_bk_thread_s * thread = NULL;
+    struct copy_rd_s rd_stage;
     struct jls_buf_s * buf = jls_buf_alloc();
     if (NULL == buf) {
         return JLS_ERROR_NOT_ENOUGH_MEMORY;
     }
+    memset(&rd_stage, 0, sizeof(rd_stage));
+    rd_stage.mrb_buf = malloc(COPY_MRB_SIZE);
+    if (NULL == rd_stage.mrb_buf) {
+        jls_buf_free(buf);
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    jls_mrb_init(&rd_stage.mrb, rd_stage.mrb_buf, COPY_MRB_SIZE);
 
     rc = jls_raw_open(&rd, src, "r");
     if (rc && (rc != JLS_ERROR_TRUNCATED)) {
+        free(rd_stage.mrb_buf);
+        jls_buf_free(buf);
         return rc;
     }
     offset = jls_raw_chunk_tell(rd);
@@ -60,152 +443,1204 @@ int32_t jls_copy(const char * src, const char * dst,
     int64_t offset_end = jls_raw_chunk_tell(rd);
     jls_raw_chunk_seek(rd, offset);
 
-    rc = jls_wr_open(&wr, dst);
+    rc = jls_twr_open(&wr, dst);
     if (rc) {
         jls_raw_close(rd);
+        free(rd_stage.mrb_buf);
+        jls_buf_free(buf);
         return rc;
     }
 
-    struct jls_chunk_header_s hdr;
+    rd_stage.raw = rd;
+    rd_stage.offset_end = offset_end;
+    rc = jls_bk_thread_run(&thread, copy_rd_thread, &rd_stage);
+    if (rc) {
+        MSG_ERROR("jls_bk_thread_run", rc);
+        thread = NULL;
+        rd_stage.done = 1;
+        rd_stage.rc = rc;
+    }
 
-    while (offset < offset_end) {
-        rc = jls_raw_rd_header(rd, &hdr);
-        if (rc) {
-            MSG_ERROR("jls_raw_rd_header", rc);
-            jls_raw_chunk_seek(rd, offset + 1);
-            rc = jls_raw_chunk_scan(rd);
+    while (0 == rc) {
+        uint32_t msg_size = 0;
+        uint8_t * b = jls_mrb_peek(&rd_stage.mrb, &msg_size);
+        if (NULL == b) {
+            if (rd_stage.done) {
+                break;
+            }
+            jls_bkt_sleep_ms(1);
+            continue;
+        }
+        struct copy_msg_s msg;
+        memcpy(&msg, b, sizeof(msg));
+        offset = msg.offset;
+        if (COPY_MSG_ERROR == msg.msg_type) {
+            MSG_ERROR((const char *) (b + sizeof(msg)), msg.ec);
+        } else {
+            rc = jls_buf_realloc(buf, msg.length);
             if (rc) {
-                MSG_ERROR("jls_raw_chunk_scan", rc);
-                return rc;
+                MSG_ERROR("jls_buf_realloc", rc);
+                rc = JLS_ERROR_NOT_ENOUGH_MEMORY;
+            } else {
+                const uint8_t * payload = (NULL != msg.heap) ? msg.heap : (b + sizeof(msg));
+                memcpy(buf->start, payload, msg.length);
+                buf->length = msg.length;
+                buf->cur = buf->start;
+                buf->end = buf->start + buf->length;
+                rc = copy_chunk_process(wr, &msg.hdr, buf, omit_data, transcode);
+                if (rc) {
+                    MSG_ERROR("copy_chunk_process", rc);
+                }
             }
         }
-        // printf("%" PRIi64 " %d %" PRIu32 "\n", offset, hdr.tag, hdr.payload_length);
-        rc = jls_buf_realloc(buf, hdr.payload_length);
+        if (NULL != msg.heap) {
+            free(msg.heap);
+        }
+        jls_mrb_pop(&rd_stage.mrb, &msg_size);
+        if ((offset - offset_progress) >= PROGRESS_INTERVAL_BYTES) {
+            if (NULL != progress_fn) {
+                progress_fn(progress_user_data, offset / (double) offset_end);
+            }
+            offset_progress = offset;
+        }
+    }
+
+    rd_stage.quit = 1;
+    if (NULL != thread) {
+        jls_bk_thread_join(thread);
+    }
+    // drain any remaining messages, releasing handed-off heap payloads
+    uint32_t msg_size = 0;
+    uint8_t * b;
+    while (NULL != (b = jls_mrb_pop(&rd_stage.mrb, &msg_size))) {
+        struct copy_msg_s msg;
+        memcpy(&msg, b, sizeof(msg));
+        if ((COPY_MSG_CHUNK == msg.msg_type) && (NULL != msg.heap)) {
+            free(msg.heap);
+        }
+    }
+    if ((0 == rc) && rd_stage.rc) {
+        rc = rd_stage.rc;
+    }
+    if ((0 == rc) && (NULL != progress_fn)) {
+        progress_fn(progress_user_data, 1.0);
+    }
+    jls_raw_close(rd);
+    jls_twr_close(wr);
+    free(rd_stage.mrb_buf);
+    jls_buf_free(buf);
+    return rc;
+}
+
+int32_t jls_copy(const char * src, const char * dst,
+                 jls_copy_msg_fn msg_fn, void * msg_user_data,
+                 jls_copy_progress_fn progress_fn, void * progress_user_data) {
+    return copy_run(src, dst, msg_fn, msg_user_data, progress_fn, progress_user_data, 0, NULL);
+}
+
+int32_t jls_copy_downsample(const char * src, const char * dst,
+                            jls_copy_msg_fn msg_fn, void * msg_user_data,
+                            jls_copy_progress_fn progress_fn, void * progress_user_data) {
+    return copy_run(src, dst, msg_fn, msg_user_data, progress_fn, progress_user_data, 1, NULL);
+}
+
+// transcode q search upper bound: keeps 2**q exactly representable
+#define TRANSCODE_Q_MAX (30)
+
+// Choose q per signal so the full source amplitude fits the target
+// integer range: the largest q with max_abs * 2**q <= INT_MAX.
+static void transcode_q_compute(struct transcode_s * self, struct jls_rd_s * rd,
+                                const struct jls_signal_def_s * def) {
+    const uint16_t signal_id = def->signal_id;
+    const uint8_t size = jls_datatype_parse_size(self->data_type);
+    const double int_max = (double) ((1ll << (size - 1)) - 1);
+    int64_t samples = 0;
+    double stats[JLS_SUMMARY_FSR_COUNT];
+    self->q[signal_id] = (uint8_t) (size - 1);  // no samples: keep full fraction
+    if (jls_rd_fsr_length(rd, signal_id, &samples) || (samples <= 0)) {
+        return;
+    }
+    if (jls_rd_fsr_statistics(rd, signal_id, 0, samples, stats, 1)) {
+        return;
+    }
+    double max_abs = fmax(fabs(stats[JLS_SUMMARY_FSR_MIN]), fabs(stats[JLS_SUMMARY_FSR_MAX]));
+    uint8_t q = 0;
+    while ((q < TRANSCODE_Q_MAX)
+            && ((max_abs * (double) ((int64_t) 1 << (q + 1))) <= int_max)) {
+        ++q;
+    }
+    self->q[signal_id] = q;
+}
+
+int32_t jls_transcode(const char * src, const char * dst, uint32_t data_type,
+                      jls_copy_msg_fn msg_fn, void * msg_user_data,
+                      jls_copy_progress_fn progress_fn, void * progress_user_data) {
+    int32_t rc = 0;
+    const uint8_t basetype = jls_datatype_parse_basetype(data_type);
+    const uint8_t size = jls_datatype_parse_size(data_type);
+    if (jls_datatype_parse_q(data_type)) {
+        return JLS_ERROR_PARAMETER_INVALID;  // q is computed per signal
+    }
+    if (JLS_DATATYPE_BASETYPE_FLOAT == basetype) {
+        if ((32 != size) && (64 != size)) {
+            return JLS_ERROR_PARAMETER_INVALID;
+        }
+    } else if (JLS_DATATYPE_BASETYPE_INT == basetype) {
+        if ((8 != size) && (16 != size) && (32 != size)) {
+            return JLS_ERROR_PARAMETER_INVALID;
+        }
+    } else {
+        return JLS_ERROR_PARAMETER_INVALID;  // UINT and BOOL targets unsupported
+    }
+    struct transcode_s * transcode = calloc(1, sizeof(struct transcode_s));
+    if (NULL == transcode) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    transcode->data_type = data_type;
+    if (JLS_DATATYPE_BASETYPE_INT == basetype) {
+        // pre-pass: the per-signal amplitude from the summaries selects q
+        struct jls_rd_s * rd = NULL;
+        rc = jls_rd_open(&rd, src);
+        if (0 == rc) {
+            struct jls_signal_def_s * signals = NULL;
+            uint16_t count = 0;
+            rc = jls_rd_signals(rd, &signals, &count);
+            for (uint16_t i = 0; (0 == rc) && (i < count); ++i) {
+                if ((0 != signals[i].signal_id)
+                        && (JLS_SIGNAL_TYPE_FSR == signals[i].signal_type)) {
+                    transcode_q_compute(transcode, rd, &signals[i]);
+                }
+            }
+            jls_rd_close(rd);
+        }
         if (rc) {
-            MSG_ERROR("jls_buf_realloc", rc);
+            free(transcode);
+            return rc;
+        }
+    }
+    rc = copy_run(src, dst, msg_fn, msg_user_data, progress_fn, progress_user_data,
+                  0, transcode);
+    free(transcode->f64);
+    free(transcode->out);
+    free(transcode);
+    return rc;
+}
+
+struct erase_s {
+    struct jls_raw_s * raw;
+    struct jls_buf_s * buf;
+    uint16_t signal_id;
+    int64_t api_start;              ///< erase start, signal sample id
+    int64_t api_end;                ///< erase end, signal sample id
+    int64_t start;                  ///< erase start, file sample id, valid when offset_found
+    int64_t end;                    ///< erase end, file sample id, valid when offset_found
+    int64_t offset;                 ///< the current chunk offset, for error reporting
+    uint8_t signal_found;
+    uint8_t offset_found;
+    struct jls_signal_def_s def;    ///< scalar fields only, name/units not parsed
+    int64_t * omitted;              ///< fully-erased data chunk timestamps, ascending
+    size_t omitted_count;
+    size_t omitted_alloc;
+    int64_t data_chunk_count;       ///< data chunks modified
+    int64_t summary_entry_count;    ///< summary entries patched
+    int64_t hole_bytes;             ///< storage released by hole punching
+};
+
+#define ERASE_HOLE_ALIGN (4096)
+
+/**
+ * @brief Deallocate the file blocks for a payload span that now reads as zeros.
+ *
+ * Holes read back as zeros, so the chunk payload and its CRC are unchanged;
+ * this only releases the underlying storage.  Best effort: when the backend
+ * or filesystem does not support hole punching, the zeros remain stored.
+ */
+static void erase_punch_hole(struct erase_s * self, int64_t start, int64_t end) {
+    start = (start + ERASE_HOLE_ALIGN - 1) & ~((int64_t) (ERASE_HOLE_ALIGN - 1));
+    end &= ~((int64_t) (ERASE_HOLE_ALIGN - 1));
+    if ((end - start) < ERASE_HOLE_ALIGN) {
+        return;
+    }
+    if (0 == jls_bk_punch_hole(jls_raw_backend(self->raw), start, end - start)) {
+        self->hole_bytes += end - start;
+    }
+}
+
+/// The next chunk offset: header plus payload, pad, and payload CRC.
+static int64_t erase_chunk_end(int64_t offset, uint32_t payload_length) {
+    offset += sizeof(struct jls_chunk_header_s);
+    if (payload_length) {
+        offset += (payload_length + 4 + 7) & ~((int64_t) 7);
+    }
+    return offset;
+}
+
+static int32_t chunk_payload_rd(struct jls_raw_s * raw, struct jls_buf_s * buf,
+                                const struct jls_chunk_header_s * hdr) {
+    ROE(jls_buf_realloc(buf, hdr->payload_length));
+    int32_t rc = jls_raw_rd_payload(raw, (uint32_t) buf->alloc_size, buf->start);
+    if (JLS_ERROR_TOO_BIG == rc) {
+        // compressed chunks may decode larger than the on-disk payload
+        ROE(jls_buf_realloc(buf, jls_raw_payload_decoded_length(raw)));
+        rc = jls_raw_rd_payload(raw, (uint32_t) buf->alloc_size, buf->start);
+    }
+    ROE(rc);
+    buf->length = jls_raw_payload_decoded_length(raw);
+    buf->cur = buf->start;
+    buf->end = buf->start + buf->length;
+    return 0;
+}
+
+static int32_t erase_payload_rd(struct erase_s * self, const struct jls_chunk_header_s * hdr) {
+    return chunk_payload_rd(self->raw, self->buf, hdr);
+}
+
+static int32_t erase_chunk_wr(struct erase_s * self, int64_t offset, struct jls_chunk_header_s * hdr) {
+    ROE(jls_raw_chunk_seek(self->raw, offset));
+    ROE(jls_raw_wr_header(self->raw, hdr));
+    return jls_raw_wr_payload(self->raw, hdr->payload_length, self->buf->start);
+}
+
+static int32_t erase_omitted_add(struct erase_s * self, int64_t timestamp) {
+    if (self->omitted_count >= self->omitted_alloc) {
+        size_t alloc = self->omitted_alloc ? (self->omitted_alloc * 2) : 256;
+        int64_t * omitted = realloc(self->omitted, alloc * sizeof(int64_t));
+        if (NULL == omitted) {
             return JLS_ERROR_NOT_ENOUGH_MEMORY;
         }
-        rc = jls_raw_rd_payload(rd, (uint32_t) buf->alloc_size, buf->start);
-        if (rc) {
-            MSG_ERROR("jls_raw_rd_payload", rc);
-            rc = jls_raw_chunk_next(rd);
-            if (rc) {
-                MSG_ERROR("jls_raw_chunk_next", rc);
-                return JLS_ERROR_IO;
+        self->omitted = omitted;
+        self->omitted_alloc = alloc;
+    }
+    self->omitted[self->omitted_count++] = timestamp;
+    return 0;
+}
+
+static uint8_t erase_omitted_contains(struct erase_s * self, int64_t timestamp) {
+    size_t lo = 0;
+    size_t hi = self->omitted_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (self->omitted[mid] < timestamp) {
+            lo = mid + 1;
+        } else if (self->omitted[mid] > timestamp) {
+            hi = mid;
+        } else {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static uint8_t erase_omitted_overlap(struct erase_s * self, int64_t t0, int64_t t1) {
+    for (size_t i = 0; i < self->omitted_count; ++i) {
+        if ((self->omitted[i] >= t0) && (self->omitted[i] < t1)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int32_t signal_def_parse(struct jls_buf_s * buf, struct jls_signal_def_s * def) {
+    ROE(jls_buf_rd_u16(buf, &def->source_id));
+    ROE(jls_buf_rd_u8(buf, &def->signal_type));
+    ROE(jls_buf_rd_u8(buf, &def->data_encoding));
+    ROE(jls_buf_rd_u32(buf, &def->data_type));
+    ROE(jls_buf_rd_u32(buf, &def->sample_rate));
+    ROE(jls_buf_rd_u32(buf, &def->samples_per_data));
+    ROE(jls_buf_rd_u32(buf, &def->sample_decimate_factor));
+    ROE(jls_buf_rd_u32(buf, &def->entries_per_summary));
+    ROE(jls_buf_rd_u32(buf, &def->summary_decimate_factor));
+    return 0;
+}
+
+static int32_t erase_signal_def(struct erase_s * self) {
+    ROE(signal_def_parse(self->buf, &self->def));
+    self->signal_found = 1;
+    return 0;
+}
+
+static int32_t erase_data_chunk(struct erase_s * self, int64_t offset,
+                                struct jls_chunk_header_s * hdr, uint32_t modify) {
+    struct jls_fsr_data_s * data = (struct jls_fsr_data_s *) self->buf->start;
+    if (!self->offset_found) {
+        // the first data chunk timestamp maps signal sample ids to file sample ids
+        self->offset_found = 1;
+        self->start = self->api_start + data->header.timestamp;
+        self->end = self->api_end + data->header.timestamp;
+    }
+    int64_t t0 = data->header.timestamp;
+    int64_t t1 = t0 + data->header.entry_count;
+    uint16_t entry_size_bits = data->header.entry_size_bits;
+    if ((t1 <= self->start) || (t0 >= self->end)) {
+        return 0;
+    }
+    uint8_t full = (t0 >= self->start) && (t1 <= self->end);
+    uint8_t transformed = ((hdr->compression & JLS_COMPRESSION_METHOD_MASK) != JLS_COMPRESSION_NONE)
+            || (JLS_FSR_DATA_ENCODING_RAW != data->header.rsv16);
+    if (!modify) {
+        if (transformed && !full) {
+            // the decoded payload does not fit the on-disk payload length
+            JLS_LOGE("erase: compressed data chunk at %" PRIi64 " partially in range", offset);
+            return JLS_ERROR_NOT_SUPPORTED;
+        }
+        if (full) {
+            ROE(erase_omitted_add(self, t0));
+        }
+        return 0;
+    }
+    if (transformed) {
+        // scrub the entire stored payload, leaving an empty raw header
+        // when it fits; the level 1 index marks this chunk as omitted
+        ROE(jls_buf_realloc(self->buf, hdr->payload_length));
+        memset(self->buf->start, 0, hdr->payload_length);
+        if (hdr->payload_length >= sizeof(struct jls_payload_header_s)) {
+            struct jls_payload_header_s * ph = (struct jls_payload_header_s *) self->buf->start;
+            ph->timestamp = t0;
+            ph->entry_count = 0;
+            ph->entry_size_bits = entry_size_bits;
+            ph->rsv16 = JLS_FSR_DATA_ENCODING_RAW;
+        }
+        hdr->compression &= (uint8_t) ~JLS_COMPRESSION_METHOD_MASK;
+    } else {
+        int64_t i0 = ((self->start > t0) ? self->start : t0) - t0;
+        int64_t i1 = ((self->end < t1) ? self->end : t1) - t0;
+        // sub-byte data types round outward to byte boundaries
+        size_t byte0 = (size_t) ((i0 * entry_size_bits) / 8);
+        size_t byte1 = (size_t) (((i1 * entry_size_bits) + 7) / 8);
+        memset(((uint8_t *) data->data) + byte0, 0, byte1 - byte0);
+    }
+    ROE(erase_chunk_wr(self, offset, hdr));
+    ++self->data_chunk_count;
+    int64_t payload_start = offset + sizeof(struct jls_chunk_header_s);
+    if (transformed) {
+        erase_punch_hole(self, payload_start + sizeof(struct jls_payload_header_s),
+                         payload_start + hdr->payload_length);
+    } else {
+        int64_t i0 = ((self->start > t0) ? self->start : t0) - t0;
+        int64_t i1 = ((self->end < t1) ? self->end : t1) - t0;
+        int64_t byte0 = (i0 * entry_size_bits) / 8;
+        int64_t byte1 = ((i1 * entry_size_bits) + 7) / 8;
+        int64_t data_start = payload_start + offsetof(struct jls_fsr_data_s, data);
+        erase_punch_hole(self, data_start + byte0, data_start + byte1);
+    }
+    return 0;
+}
+
+static int32_t erase_index_chunk(struct erase_s * self, int64_t offset,
+                                 struct jls_chunk_header_s * hdr, uint32_t modify) {
+    struct jls_fsr_index_s * idx = (struct jls_fsr_index_s *) self->buf->start;
+    int64_t t0 = idx->header.timestamp;
+    int64_t t1 = t0 + (int64_t) idx->header.entry_count * self->def.samples_per_data;
+    if (!modify) {
+        if (((hdr->compression & JLS_COMPRESSION_METHOD_MASK) != JLS_COMPRESSION_NONE)
+                && erase_omitted_overlap(self, t0, t1)) {
+            JLS_LOGE("erase: compressed index chunk at %" PRIi64 " needs patching", offset);
+            return JLS_ERROR_NOT_SUPPORTED;
+        }
+        return 0;
+    }
+    uint8_t changed = 0;
+    for (uint32_t i = 0; i < idx->header.entry_count; ++i) {
+        if (!idx->offsets[i]) {
+            continue;
+        }
+        int64_t t = t0 + (int64_t) i * self->def.samples_per_data;
+        if (erase_omitted_contains(self, t)) {
+            idx->offsets[i] = 0;  // mark omitted, see reconstruction on read
+            changed = 1;
+        }
+    }
+    if (changed) {
+        ROE(erase_chunk_wr(self, offset, hdr));
+    }
+    return 0;
+}
+
+static int32_t erase_summary_chunk(struct erase_s * self, int64_t offset,
+                                   struct jls_chunk_header_s * hdr, uint8_t level, uint32_t modify) {
+    struct jls_fsr_f32_summary_s * f32_summary = (struct jls_fsr_f32_summary_s *) self->buf->start;
+    struct jls_fsr_f64_summary_s * f64_summary = (struct jls_fsr_f64_summary_s *) self->buf->start;
+    uint8_t is_f32;
+    if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(float) * 8) {
+        is_f32 = 1;
+    } else if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(double) * 8) {
+        is_f32 = 0;
+    } else {
+        JLS_LOGE("invalid summary entry size: %d", (int) f32_summary->header.entry_size_bits);
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    int64_t step = self->def.sample_decimate_factor;
+    for (uint8_t lvl = 1; lvl < level; ++lvl) {
+        step *= self->def.summary_decimate_factor;
+    }
+    int64_t t0 = f32_summary->header.timestamp;
+    int64_t t1 = t0 + (int64_t) f32_summary->header.entry_count * step;
+    if ((t1 <= self->start) || (t0 >= self->end)) {
+        return 0;
+    }
+    if (!modify) {
+        if ((hdr->compression & JLS_COMPRESSION_METHOD_MASK) != JLS_COMPRESSION_NONE) {
+            JLS_LOGE("erase: compressed summary chunk at %" PRIi64 " in range", offset);
+            return JLS_ERROR_NOT_SUPPORTED;
+        }
+        return 0;
+    }
+    uint8_t changed = 0;
+    for (uint32_t i = 0; i < f32_summary->header.entry_count; ++i) {
+        int64_t e0 = t0 + (int64_t) i * step;
+        int64_t e1 = e0 + step;
+        int64_t ov0 = (self->start > e0) ? self->start : e0;
+        int64_t ov1 = (self->end < e1) ? self->end : e1;
+        if (ov0 >= ov1) {
+            continue;
+        }
+        changed = 1;
+        ++self->summary_entry_count;
+        if ((ov0 <= e0) && (ov1 >= e1)) {  // entry fully erased
+            if (is_f32) {
+                memset(f32_summary->data[i], 0, sizeof(f32_summary->data[i]));
+            } else {
+                memset(f64_summary->data[i], 0, sizeof(f64_summary->data[i]));
             }
-            offset = jls_raw_chunk_tell(rd);
             continue;
         }
-        buf->length = hdr.payload_length;
-        buf->cur = buf->start;
-        buf->end = buf->start + buf->length;
+        // partial coverage: the erased samples become zeros, so widen
+        // min/max to include zero and scale the mean by the retained
+        // fraction, which is exact when the erased mean matched the
+        // entry mean.  The standard deviation is retained unchanged.
+        double scale = (double) (step - (ov1 - ov0)) / (double) step;
+        if (is_f32) {
+            float * e = f32_summary->data[i];
+            e[JLS_SUMMARY_FSR_MEAN] = (float) (e[JLS_SUMMARY_FSR_MEAN] * scale);
+            if (e[JLS_SUMMARY_FSR_MIN] > 0.0f) {
+                e[JLS_SUMMARY_FSR_MIN] = 0.0f;
+            }
+            if (e[JLS_SUMMARY_FSR_MAX] < 0.0f) {
+                e[JLS_SUMMARY_FSR_MAX] = 0.0f;
+            }
+        } else {
+            double * e = f64_summary->data[i];
+            e[JLS_SUMMARY_FSR_MEAN] *= scale;
+            if (e[JLS_SUMMARY_FSR_MIN] > 0.0) {
+                e[JLS_SUMMARY_FSR_MIN] = 0.0;
+            }
+            if (e[JLS_SUMMARY_FSR_MAX] < 0.0) {
+                e[JLS_SUMMARY_FSR_MAX] = 0.0;
+            }
+        }
+    }
+    if (changed) {
+        ROE(erase_chunk_wr(self, offset, hdr));
+    }
+    return 0;
+}
 
+static int32_t erase_pass(struct erase_s * self, uint32_t modify) {
+    struct jls_raw_s * raw = self->raw;
+    struct jls_chunk_header_s hdr;
+    int32_t rc;
+    ROE(jls_raw_chunk_seek(raw, sizeof(struct jls_file_header_s)));
+    while (1) {
+        int64_t offset = jls_raw_chunk_tell(raw);
+        self->offset = offset;
+        rc = jls_raw_rd_header(raw, &hdr);
+        if (JLS_ERROR_EMPTY == rc) {
+            break;
+        }
+        ROE(rc);
+        if (JLS_TAG_END == hdr.tag) {
+            break;
+        }
+        uint16_t chunk_signal_id = hdr.chunk_meta & 0x0fff;
+        uint8_t level = (uint8_t) (hdr.chunk_meta >> 12);
+        uint8_t relevant = 0;
         switch (hdr.tag) {
-            case JLS_TAG_INVALID: break;
-            case JLS_TAG_SOURCE_DEF: {
-                struct jls_source_def_s source;
-                source.source_id = hdr.chunk_meta;
-                ROE(jls_buf_rd_skip(buf, 64));
-                ROE(jls_buf_rd_str(buf, (const char **) &source.name));
-                ROE(jls_buf_rd_str(buf, (const char **) &source.vendor));
-                ROE(jls_buf_rd_str(buf, (const char **) &source.model));
-                ROE(jls_buf_rd_str(buf, (const char **) &source.version));
-                ROE(jls_buf_rd_str(buf, (const char **) &source.serial_number));
-                if (source.source_id != 0) {
-                    ROE(jls_wr_source_def(wr, &source));
-                }
+            case JLS_TAG_SIGNAL_DEF:
+                relevant = !modify && (hdr.chunk_meta == self->signal_id);
+                break;
+            case JLS_TAG_TRACK_FSR_DATA:
+                relevant = (chunk_signal_id == self->signal_id);
+                break;
+            case JLS_TAG_TRACK_FSR_INDEX:
+                relevant = (chunk_signal_id == self->signal_id) && (1 == level)
+                        && self->offset_found && (self->omitted_count > 0);
+                break;
+            case JLS_TAG_TRACK_FSR_SUMMARY:
+                relevant = (chunk_signal_id == self->signal_id) && self->offset_found;
+                break;
+            default:
+                break;
+        }
+        if (!relevant || (hdr.payload_length < sizeof(struct jls_payload_header_s))) {
+            rc = jls_raw_chunk_next(raw);
+            if (JLS_ERROR_EMPTY == rc) {
                 break;
             }
-            case JLS_TAG_SIGNAL_DEF: {
-                struct jls_signal_def_s signal;
-                signal.signal_id = hdr.chunk_meta;
-                ROE(jls_buf_rd_u16(buf, &signal.source_id));
-                ROE(jls_buf_rd_u8(buf, &signal.signal_type));
-                ROE(jls_buf_rd_skip(buf, 1));
-                ROE(jls_buf_rd_u32(buf, &signal.data_type));
-                ROE(jls_buf_rd_u32(buf, &signal.sample_rate));
-                ROE(jls_buf_rd_u32(buf, &signal.samples_per_data));
-                ROE(jls_buf_rd_u32(buf, &signal.sample_decimate_factor));
-                ROE(jls_buf_rd_u32(buf, &signal.entries_per_summary));
-                ROE(jls_buf_rd_u32(buf, &signal.summary_decimate_factor));
-                ROE(jls_buf_rd_u32(buf, &signal.annotation_decimate_factor));
-                ROE(jls_buf_rd_u32(buf, &signal.utc_decimate_factor));
-                ROE(jls_buf_rd_skip(buf, 92));
-                ROE(jls_buf_rd_str(buf, (const char **) &signal.name));
-                ROE(jls_buf_rd_str(buf, (const char **) &signal.units));
-                if (signal.signal_id != 0) {
-                    ROE(jls_wr_signal_def(wr, &signal));
-                }
+            ROE(rc);
+            continue;
+        }
+        ROE(erase_payload_rd(self, &hdr));
+        switch (hdr.tag) {
+            case JLS_TAG_SIGNAL_DEF:
+                ROE(erase_signal_def(self));
                 break;
+            case JLS_TAG_TRACK_FSR_DATA:
+                ROE(erase_data_chunk(self, offset, &hdr, modify));
+                break;
+            case JLS_TAG_TRACK_FSR_INDEX:
+                ROE(erase_index_chunk(self, offset, &hdr, modify));
+                break;
+            case JLS_TAG_TRACK_FSR_SUMMARY:
+                ROE(erase_summary_chunk(self, offset, &hdr, level, modify));
+                break;
+            default:
+                break;
+        }
+        ROE(jls_raw_chunk_seek(raw, erase_chunk_end(offset, hdr.payload_length)));
+    }
+    return 0;
+}
+
+int32_t jls_fsr_erase(const char * path, uint16_t signal_id,
+                      int64_t start_sample_id, int64_t end_sample_id,
+                      jls_copy_msg_fn msg_fn, void * msg_user_data) {
+    char msg_str[1024];
+    int64_t offset = 0;  // for MSG_ERROR
+    if ((start_sample_id < 0) || (start_sample_id >= end_sample_id)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct erase_s self;
+    memset(&self, 0, sizeof(self));
+    self.signal_id = signal_id & 0x0fff;
+    self.api_start = start_sample_id;
+    self.api_end = end_sample_id;
+    self.buf = jls_buf_alloc();
+    if (NULL == self.buf) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    int32_t rc = jls_raw_open(&self.raw, path, "a");
+    if (JLS_ERROR_TRUNCATED == rc) {
+        rc = 0;  // summaries past the valid end do not exist to patch
+    }
+    if (rc) {
+        jls_buf_free(self.buf);
+        MSG_ERROR("jls_raw_open", rc);
+        return rc;
+    }
+
+    // feasibility pass: locate the signal and refuse ranges that would
+    // require resizing compressed chunks, before modifying anything
+    rc = erase_pass(&self, 0);
+    if ((0 == rc) && !self.signal_found) {
+        rc = JLS_ERROR_NOT_FOUND;
+    }
+    if ((0 == rc) && self.signal_found && (JLS_SIGNAL_TYPE_FSR != self.def.signal_type)) {
+        rc = JLS_ERROR_NOT_SUPPORTED;
+    }
+    if ((0 == rc) && (!self.def.samples_per_data || !self.def.sample_decimate_factor
+            || !self.def.summary_decimate_factor)) {
+        rc = JLS_ERROR_PARAMETER_INVALID;
+    }
+
+    // modify pass: zero data, mark omitted chunks, patch summaries
+    if ((0 == rc) && self.offset_found) {
+        rc = erase_pass(&self, 1);
+    }
+    if (rc) {
+        offset = self.offset;
+        MSG_ERROR("jls_fsr_erase", rc);
+    } else if (NULL != msg_fn) {
+        snprintf(msg_str, sizeof(msg_str),
+                 "signal %d: erased %" PRIi64 " data chunks (%zu omitted), "
+                 "patched %" PRIi64 " summary entries, "
+                 "released %" PRIi64 " bytes of storage",
+                 (int) self.signal_id, self.data_chunk_count,
+                 self.omitted_count, self.summary_entry_count,
+                 self.hole_bytes);
+        msg_fn(msg_user_data, msg_str);
+    }
+    jls_raw_close(self.raw);
+    jls_buf_free(self.buf);
+    free(self.omitted);
+    return rc;
+}
+
+int32_t jls_repair(const char * path, jls_copy_msg_fn msg_fn, void * msg_user_data) {
+    struct jls_rd_s * rd = NULL;
+    char msg_str[1024];
+    int64_t offset = 0;  // for MSG_ERROR
+
+    // the reader repairs unclosed files in place on open:
+    // it scans backward from the file end for the last valid chunk,
+    // truncates the remainder, rebuilds the missing head pointers and
+    // summaries, and writes the END chunk.
+    int32_t rc = jls_rd_open(&rd, path);
+    if (rc) {
+        MSG_ERROR("jls_rd_open", rc);
+        return rc;
+    }
+
+    if (NULL != msg_fn) {
+        struct jls_signal_def_s * signals = NULL;
+        uint16_t count = 0;
+        if (0 == jls_rd_signals(rd, &signals, &count)) {
+            for (uint16_t i = 0; i < count; ++i) {
+                if (JLS_SIGNAL_TYPE_FSR != signals[i].signal_type) {
+                    continue;
+                }
+                int64_t samples = 0;
+                if (0 == jls_rd_fsr_length(rd, signals[i].signal_id, &samples)) {
+                    snprintf(msg_str, sizeof(msg_str),
+                             "signal %d \"%s\": %" PRIi64 " samples",
+                             (int) signals[i].signal_id, signals[i].name, samples);
+                    msg_fn(msg_user_data, msg_str);
+                }
             }
+        }
+    }
 
-            case JLS_TAG_TRACK_FSR_DEF: break;
-            case JLS_TAG_TRACK_FSR_HEAD: break;
-            case JLS_TAG_TRACK_FSR_DATA: {
-                uint16_t signal_id = hdr.chunk_meta & 0x0fff;
-                struct jls_fsr_data_s * data = (struct jls_fsr_data_s *) buf->start;
-                // future: handle omitted data by looking at level 1 index & summary
-                // future: decompress if needed
-                ROE(jls_wr_fsr(wr, signal_id, data->header.timestamp,
-                               data->data, data->header.entry_count));
-                break;
+    jls_rd_close(rd);
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// resummarize
+////////////////////////////////////////////////////////////////////////////////
+
+#define RESUM_LEVEL_MAX (16)        // jls_track_head_s holds 16 level offsets
+#define RESUM_WORKERS_MAX (8)
+#define RESUM_MSG_SIZE (256)
+
+/// The recomputed entries for one summary level, [mean, min, max, var] each.
+struct resum_pending_s {
+    double * entries;
+    size_t count;
+    size_t alloc;
+};
+
+/// The per-signal recompute state for one file pass.
+struct resum_s {
+    struct jls_raw_s * raw;
+    struct jls_buf_s * buf;
+    const struct jls_signal_def_s * def;    ///< scalar fields only
+    struct resum_pending_s pending[RESUM_LEVEL_MAX];
+    double * f64;                           ///< sample conversion scratch
+    size_t f64_alloc;                       ///< allocated doubles
+    int64_t offset;                         ///< the current chunk offset, for error reporting
+    int64_t summary_chunks;                 ///< summary chunks rewritten
+    int64_t entry_count;                    ///< summary entries recomputed
+};
+
+static int32_t resum_pending_append(struct resum_pending_s * p,
+                                    double v_mean, double v_min, double v_max, double v_var) {
+    if (p->count >= p->alloc) {
+        size_t alloc = p->alloc ? (p->alloc * 2) : 1024;
+        double * entries = realloc(p->entries, alloc * JLS_SUMMARY_FSR_COUNT * sizeof(double));
+        if (NULL == entries) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        p->entries = entries;
+        p->alloc = alloc;
+    }
+    double * e = p->entries + p->count * JLS_SUMMARY_FSR_COUNT;
+    e[0] = v_mean;
+    e[1] = v_min;
+    e[2] = v_max;
+    e[3] = v_var;
+    ++p->count;
+    return 0;
+}
+
+/**
+ * @brief Recompute the level-1 entries covered by one level-0 data chunk.
+ *
+ * Matches the writer's summarization semantics, see jls_core_fsr_summary1():
+ * entries reduce exactly sample_decimate_factor samples, non-finite samples
+ * are excluded, empty entries become all-NaN, and trailing samples that do
+ * not fill a whole entry produce no entry.
+ */
+static int32_t resum_data_chunk(struct resum_s * self) {
+    struct jls_fsr_data_s * data = (struct jls_fsr_data_s *) self->buf->start;
+    const uint32_t sdf = self->def->sample_decimate_factor;
+    uint32_t summaries_per = data->header.entry_count / sdf;
+    if (0 == summaries_per) {
+        return 0;
+    }
+    size_t samples = (size_t) summaries_per * sdf;
+    if (self->f64_alloc < samples) {
+        free(self->f64);
+        self->f64 = malloc(samples * sizeof(double));
+        if (NULL == self->f64) {
+            self->f64_alloc = 0;
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        self->f64_alloc = samples;
+    }
+    ROE(jls_dt_buffer_to_f64(data->data, self->def->data_type, self->f64, samples));
+    for (uint32_t idx = 0; idx < summaries_per; ++idx) {
+        const double * src = self->f64 + (size_t) idx * sdf;
+        uint32_t count = 0;
+        double v_sum = 0.0;
+        double v_min = DBL_MAX;
+        double v_max = -DBL_MAX;
+        for (uint32_t i = 0; i < sdf; ++i) {
+            double v = src[i];
+            if (isfinite(v)) {
+                ++count;
+                v_sum += v;
+                if (v < v_min) {
+                    v_min = v;
+                }
+                if (v > v_max) {
+                    v_max = v;
+                }
             }
-            case JLS_TAG_TRACK_FSR_INDEX: break;
-            case JLS_TAG_TRACK_FSR_SUMMARY: break;
+        }
+        double v_mean = NAN;
+        double v_var = NAN;
+        if (count) {
+            v_mean = v_sum / count;
+            v_min = (v_min == DBL_MAX) ? NAN : v_min;
+            v_max = (v_max == -DBL_MAX) ? NAN : v_max;
+            v_var = 0.0;
+            if (count > 1) {
+                for (uint32_t i = 0; i < sdf; ++i) {
+                    double v = src[i];
+                    if (isfinite(v)) {
+                        v -= v_mean;
+                        v_var += v * v;
+                    }
+                }
+                v_var /= count;
+            }
+        } else {
+            v_min = NAN;
+            v_max = NAN;
+        }
+        ROE(resum_pending_append(&self->pending[1], v_mean, v_min, v_max, v_var));
+    }
+    return 0;
+}
 
-            case JLS_TAG_TRACK_VSR_DEF: break;
-            case JLS_TAG_TRACK_VSR_HEAD: break;
-            case JLS_TAG_TRACK_VSR_DATA: break;
-            case JLS_TAG_TRACK_VSR_INDEX: break;
-            case JLS_TAG_TRACK_VSR_SUMMARY: break;
+/**
+ * @brief Overwrite one summary chunk with recomputed entries in place.
+ *
+ * The chunk geometry is unchanged: entry count, storage format, and
+ * payload length all stay as recorded, so the rewrite lands at the
+ * original offset.  The recomputed entries then reduce into the next
+ * level with the writer's per-chunk grouping, see jls_core_fsr_summaryN().
+ */
+static int32_t resum_summary_chunk(struct resum_s * self, int64_t offset,
+                                   struct jls_chunk_header_s * hdr, uint8_t level) {
+    struct jls_fsr_f32_summary_s * f32_summary = (struct jls_fsr_f32_summary_s *) self->buf->start;
+    struct jls_fsr_f64_summary_s * f64_summary = (struct jls_fsr_f64_summary_s *) self->buf->start;
+    uint8_t is_f32;
+    if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(float) * 8) {
+        is_f32 = 1;
+    } else if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(double) * 8) {
+        is_f32 = 0;
+    } else {
+        JLS_LOGE("invalid summary entry size: %d", (int) f32_summary->header.entry_size_bits);
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    if ((level < 1) || (level >= RESUM_LEVEL_MAX)) {
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    struct resum_pending_s * p = &self->pending[level];
+    uint32_t entry_count = f32_summary->header.entry_count;
+    if (p->count != entry_count) {
+        // omitted data chunks or an inconsistent file: the source
+        // entries for this chunk are not all available
+        JLS_LOGE("resummarize: summary chunk at %" PRIi64 " expects %" PRIu32
+                 " entries, computed %zu", offset, entry_count, p->count);
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    for (uint32_t i = 0; i < entry_count; ++i) {
+        const double * e = p->entries + (size_t) i * JLS_SUMMARY_FSR_COUNT;
+        double v_std = sqrt(e[3]);
+        if (is_f32) {
+            float * dst = f32_summary->data[i];
+            dst[JLS_SUMMARY_FSR_MEAN] = (float) e[0];
+            dst[JLS_SUMMARY_FSR_STD] = (float) v_std;
+            dst[JLS_SUMMARY_FSR_MIN] = (float) e[1];
+            dst[JLS_SUMMARY_FSR_MAX] = (float) e[2];
+        } else {
+            double * dst = f64_summary->data[i];
+            dst[JLS_SUMMARY_FSR_MEAN] = e[0];
+            dst[JLS_SUMMARY_FSR_STD] = v_std;
+            dst[JLS_SUMMARY_FSR_MIN] = e[1];
+            dst[JLS_SUMMARY_FSR_MAX] = e[2];
+        }
+    }
+    ROE(jls_raw_chunk_seek(self->raw, offset));
+    ROE(jls_raw_wr_header(self->raw, hdr));
+    ROE(jls_raw_wr_payload(self->raw, hdr->payload_length, self->buf->start));
+    ++self->summary_chunks;
+    self->entry_count += entry_count;
 
-            case JLS_TAG_TRACK_ANNOTATION_DEF: break;
-            case JLS_TAG_TRACK_ANNOTATION_HEAD: break;
-            case JLS_TAG_TRACK_ANNOTATION_DATA: {
-                uint16_t signal_id = hdr.chunk_meta & 0x0fff;
-                struct jls_annotation_s * data = (struct jls_annotation_s *) buf->start;
-                ROE(jls_wr_annotation(wr, signal_id, data->timestamp, data->y,
-                            data->annotation_type, data->group_id, data->storage_type,
-                            data->data, data->data_size));
-                break;
+    // reduce into the next level with the writer's per-chunk grouping:
+    // the trailing entries that do not fill a whole group produce no
+    // parent entry, matching jls_core_fsr_summaryN()
+    const uint32_t sdf2 = self->def->summary_decimate_factor;
+    uint32_t groups = entry_count / sdf2;
+    for (uint32_t g = 0; g < groups; ++g) {
+        const double * src = p->entries + (size_t) g * sdf2 * JLS_SUMMARY_FSR_COUNT;
+        uint32_t count = 0;
+        double v_sum = 0.0;
+        double v_min = DBL_MAX;
+        double v_max = -DBL_MAX;
+        for (uint32_t i = 0; i < sdf2; ++i) {
+            const double * e = src + (size_t) i * JLS_SUMMARY_FSR_COUNT;
+            if (isfinite(e[0])) {
+                ++count;
+                v_sum += e[0];
+                if (e[1] < v_min) {
+                    v_min = e[1];
+                }
+                if (e[2] > v_max) {
+                    v_max = e[2];
+                }
+            }
+        }
+        double v_mean = NAN;
+        double v_var = NAN;
+        if (count) {
+            v_mean = v_sum / count;
+            v_var = 0.0;
+            for (uint32_t i = 0; i < sdf2; ++i) {
+                const double * e = src + (size_t) i * JLS_SUMMARY_FSR_COUNT;
+                double dm = e[0] - v_mean;
+                v_var += e[3] + dm * dm;
             }
-            case JLS_TAG_TRACK_ANNOTATION_INDEX: break;
-            case JLS_TAG_TRACK_ANNOTATION_SUMMARY: break;
+            v_var /= count;
+        } else {
+            v_min = NAN;
+            v_max = NAN;
+        }
+        if ((level + 1) < RESUM_LEVEL_MAX) {
+            ROE(resum_pending_append(&self->pending[level + 1], v_mean, v_min, v_max, v_var));
+        }
+    }
+    p->count = 0;
+    return 0;
+}
 
-            case JLS_TAG_TRACK_UTC_DEF: break;
-            case JLS_TAG_TRACK_UTC_HEAD: break;
-            case JLS_TAG_TRACK_UTC_DATA: {
-                uint16_t signal_id = hdr.chunk_meta & 0x0fff;
-                struct jls_utc_data_s * data = (struct jls_utc_data_s *) buf->start;
-                ROE(jls_wr_utc(wr, signal_id, data->header.timestamp, data->timestamp));
+/**
+ * @brief Recompute all summaries for one signal with a single file pass.
+ *
+ * Streams the level-0 data chunks in file order, reducing each into
+ * level-1 entries, and overwrites every summary chunk in place as it
+ * is reached; summary chunks always follow the chunks they summarize,
+ * so each level's entries are complete when its chunk arrives.
+ */
+static int32_t resum_signal_pass(struct resum_s * self, volatile int32_t * abort_flag,
+                                 jls_copy_progress_fn progress_fn, void * progress_user_data) {
+    struct jls_raw_s * raw = self->raw;
+    struct jls_chunk_header_s hdr;
+    int32_t rc;
+    const uint16_t signal_id = self->def->signal_id;
+    int64_t progress_next = PROGRESS_INTERVAL_BYTES;
+    int64_t fend = jls_raw_backend(raw)->fend;
+    ROE(jls_raw_chunk_seek(raw, sizeof(struct jls_file_header_s)));
+    while (1) {
+        int64_t offset = jls_raw_chunk_tell(raw);
+        self->offset = offset;
+        if (*abort_flag) {
+            return JLS_ERROR_ABORTED;
+        }
+        if ((NULL != progress_fn) && (offset >= progress_next)) {
+            progress_next = offset + PROGRESS_INTERVAL_BYTES;
+            if (progress_fn(progress_user_data, (double) offset / (double) fend)) {
+                *abort_flag = 1;
+                return JLS_ERROR_ABORTED;
+            }
+        }
+        rc = jls_raw_rd_header(raw, &hdr);
+        if (JLS_ERROR_EMPTY == rc) {
+            break;
+        }
+        ROE(rc);
+        if (JLS_TAG_END == hdr.tag) {
+            break;
+        }
+        uint16_t chunk_signal_id = hdr.chunk_meta & 0x0fff;
+        uint8_t level = (uint8_t) (hdr.chunk_meta >> 12);
+        uint8_t relevant = 0;
+        switch (hdr.tag) {
+            case JLS_TAG_TRACK_FSR_DATA:
+                relevant = (chunk_signal_id == signal_id);
+                break;
+            case JLS_TAG_TRACK_FSR_INDEX:
+                relevant = (chunk_signal_id == signal_id) && (1 == level);
+                break;
+            case JLS_TAG_TRACK_FSR_SUMMARY:
+                relevant = (chunk_signal_id == signal_id);
+                break;
+            default:
+                break;
+        }
+        if (!relevant || (hdr.payload_length < sizeof(struct jls_payload_header_s))) {
+            rc = jls_raw_chunk_next(raw);
+            if (JLS_ERROR_EMPTY == rc) {
                 break;
             }
-            case JLS_TAG_TRACK_UTC_INDEX: break;
-            case JLS_TAG_TRACK_UTC_SUMMARY: break;
-
-            case JLS_TAG_USER_DATA: {
-                enum jls_storage_type_e storage_type = (hdr.chunk_meta >> 12) & 0x000f;
-                if (storage_type != JLS_STORAGE_TYPE_INVALID) {
-                    ROE(jls_wr_user_data(wr, hdr.chunk_meta & 0x0fff, (hdr.chunk_meta >> 12) & 0x000f,
-                                         buf->start, hdr.payload_length));
+            ROE(rc);
+            continue;
+        }
+        if ((JLS_TAG_TRACK_FSR_SUMMARY == hdr.tag)
+                && ((hdr.compression & JLS_COMPRESSION_METHOD_MASK) != JLS_COMPRESSION_NONE)) {
+            // recompression could change the payload length
+            JLS_LOGE("resummarize: compressed summary chunk at %" PRIi64, offset);
+            return JLS_ERROR_NOT_SUPPORTED;
+        }
+        ROE(chunk_payload_rd(raw, self->buf, &hdr));
+        switch (hdr.tag) {
+            case JLS_TAG_TRACK_FSR_DATA:
+                ROE(jls_delta_buf_decode(self->buf));
+                ROE(resum_data_chunk(self));
+                break;
+            case JLS_TAG_TRACK_FSR_INDEX: {
+                struct jls_fsr_index_s * idx = (struct jls_fsr_index_s *) self->buf->start;
+                for (uint32_t i = 0; i < idx->header.entry_count; ++i) {
+                    if (0 == idx->offsets[i]) {
+                        // omitted data chunk: the level-0 samples do not exist
+                        JLS_LOGE("resummarize: omitted data chunk, signal %d", (int) signal_id);
+                        return JLS_ERROR_NOT_SUPPORTED;
+                    }
                 }
                 break;
             }
-            case JLS_TAG_END: break;
-            default: break;
+            case JLS_TAG_TRACK_FSR_SUMMARY:
+                ROE(resum_summary_chunk(self, offset, &hdr, level));
+                break;
+            default:
+                break;
         }
-        offset = jls_raw_chunk_tell(rd);
-        if ((offset - offset_progress) >= PROGRESS_INTERVAL_BYTES) {
-            if (NULL != progress_fn) {
-                progress_fn(progress_user_data, offset / (double) offset_end);
+        ROE(jls_raw_chunk_seek(raw, erase_chunk_end(offset, hdr.payload_length)));
+    }
+    return 0;
+}
+
+/// The scaled progress relay for multi-pass resummarize workers.
+struct resum_progress_s {
+    jls_copy_progress_fn fn;
+    void * user_data;
+    double base;
+    double scale;
+};
+
+static int32_t resum_progress_relay(void * user_data, double progress) {
+    struct resum_progress_s * p = (struct resum_progress_s *) user_data;
+    return p->fn(p->user_data, p->base + p->scale * progress);
+}
+
+struct resum_worker_s {
+    struct jls_raw_s * raw;                 ///< this worker's file handle
+    const struct jls_signal_def_s * defs;   ///< the FSR signal definitions
+    uint16_t def_count;
+    uint16_t idx;                           ///< this worker's first signal
+    uint16_t stride;                        ///< the number of workers
+    volatile int32_t * abort_flag;
+    jls_copy_progress_fn progress_fn;       ///< worker 0 only, NULL otherwise
+    void * progress_user_data;
+    int32_t * rcs;                          ///< per-signal results, disjoint writes
+    char (*msgs)[RESUM_MSG_SIZE];           ///< per-signal messages, disjoint writes
+};
+
+static void resum_worker(void * user_data) {
+    struct resum_worker_s * w = (struct resum_worker_s *) user_data;
+    uint16_t assigned = 0;
+    uint16_t pass = 0;
+    for (uint16_t i = w->idx; i < w->def_count; i += w->stride) {
+        ++assigned;
+    }
+    for (uint16_t i = w->idx; i < w->def_count; i += w->stride, ++pass) {
+        struct resum_s s;
+        memset(&s, 0, sizeof(s));
+        s.raw = w->raw;
+        s.def = &w->defs[i];
+        s.buf = jls_buf_alloc();
+        int32_t rc = (NULL == s.buf) ? JLS_ERROR_NOT_ENOUGH_MEMORY : 0;
+        if (0 == rc) {
+            struct resum_progress_s progress = {
+                    .fn = w->progress_fn,
+                    .user_data = w->progress_user_data,
+                    .base = pass / (double) assigned,
+                    .scale = 1.0 / assigned,
+            };
+            rc = resum_signal_pass(&s, w->abort_flag,
+                                   w->progress_fn ? resum_progress_relay : NULL, &progress);
+        }
+        w->rcs[i] = rc;
+        if (rc) {
+            snprintf(w->msgs[i], RESUM_MSG_SIZE,
+                     "signal %d \"%s\": %" PRIi64 ": ERROR %d %s : %s",
+                     (int) s.def->signal_id, s.def->name ? s.def->name : "", s.offset,
+                     rc, jls_error_code_name(rc), jls_error_code_description(rc));
+        } else {
+            snprintf(w->msgs[i], RESUM_MSG_SIZE,
+                     "signal %d \"%s\": rewrote %" PRIi64 " summary chunks, %" PRIi64 " entries",
+                     (int) s.def->signal_id, s.def->name ? s.def->name : "",
+                     s.summary_chunks, s.entry_count);
+        }
+        for (int level = 0; level < RESUM_LEVEL_MAX; ++level) {
+            free(s.pending[level].entries);
+        }
+        free(s.f64);
+        jls_buf_free(s.buf);
+    }
+}
+
+int32_t jls_fsr_resummarize(const char * path,
+                            jls_copy_msg_fn msg_fn, void * msg_user_data,
+                            jls_copy_progress_fn progress_fn, void * progress_user_data) {
+    struct jls_chunk_header_s hdr;
+    struct jls_signal_def_s defs[JLS_SIGNAL_COUNT];
+    char names[JLS_SIGNAL_COUNT][32];
+    uint16_t def_count = 0;
+    int64_t offset = 0;  // for MSG_ERROR
+    int32_t rc;
+
+    // discovery pass: collect the FSR signal definitions
+    struct jls_raw_s * raw = NULL;
+    struct jls_buf_s * buf = jls_buf_alloc();
+    if (NULL == buf) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    rc = jls_raw_open(&raw, path, "r");
+    if (rc) {
+        jls_buf_free(buf);
+        MSG_ERROR("jls_raw_open", rc);
+        return rc;
+    }
+    rc = jls_raw_chunk_seek(raw, sizeof(struct jls_file_header_s));
+    while (0 == rc) {
+        offset = jls_raw_chunk_tell(raw);
+        rc = jls_raw_rd_header(raw, &hdr);
+        if ((JLS_ERROR_EMPTY == rc) || ((0 == rc) && (JLS_TAG_END == hdr.tag))) {
+            rc = 0;
+            break;
+        }
+        if (rc) {
+            break;
+        }
+        if ((JLS_TAG_SIGNAL_DEF == hdr.tag) && (def_count < JLS_SIGNAL_COUNT)) {
+            rc = chunk_payload_rd(raw, buf, &hdr);
+            if (rc) {
+                break;
             }
-            offset_progress = offset;
+            struct jls_signal_def_s * def = &defs[def_count];
+            memset(def, 0, sizeof(*def));
+            def->signal_id = hdr.chunk_meta & 0x0fff;
+            rc = signal_def_parse(buf, def);
+            if (rc) {
+                break;
+            }
+            if ((JLS_SIGNAL_TYPE_FSR == def->signal_type)
+                    && def->samples_per_data && def->sample_decimate_factor
+                    && def->summary_decimate_factor) {
+                const char * name = NULL;
+                if ((0 == jls_buf_rd_u32(buf, &def->annotation_decimate_factor))
+                        && (0 == jls_buf_rd_u32(buf, &def->utc_decimate_factor))
+                        && (0 == jls_buf_rd_skip(buf, 92))
+                        && (0 == jls_buf_rd_str(buf, &name))) {
+                    snprintf(names[def_count], sizeof(names[def_count]), "%s", name);
+                    def->name = names[def_count];
+                }
+                ++def_count;
+            }
+            rc = jls_raw_chunk_seek(raw, erase_chunk_end(offset, hdr.payload_length));
+        } else {
+            rc = jls_raw_chunk_next(raw);
+            if (JLS_ERROR_EMPTY == rc) {
+                rc = 0;
+                break;
+            }
+        }
+    }
+    jls_raw_close(raw);
+    jls_buf_free(buf);
+    if (rc) {
+        MSG_ERROR("signal discovery", rc);
+        return rc;
+    }
+    if (0 == def_count) {
+        if (NULL != msg_fn) {
+            msg_fn(msg_user_data, "no FSR signals to resummarize");
         }
+        return 0;
+    }
+
+    // one file handle per worker: the workers rewrite disjoint chunks
+    uint16_t workers = def_count;
+    if (workers > RESUM_WORKERS_MAX) {
+        workers = RESUM_WORKERS_MAX;
+    }
+    struct jls_raw_s * raws[RESUM_WORKERS_MAX];
+    for (uint16_t k = 0; k < workers; ++k) {
+        if (jls_raw_open(&raws[k], path, "a")) {
+            workers = k;  // fall back to fewer workers
+            break;
+        }
+    }
+    if (0 == workers) {
+        offset = 0;
+        MSG_ERROR("jls_raw_open for write", JLS_ERROR_IO);
+        return JLS_ERROR_IO;
+    }
+
+    int32_t rcs[JLS_SIGNAL_COUNT];
+    char (*msgs)[RESUM_MSG_SIZE] = calloc(def_count, RESUM_MSG_SIZE);
+    if (NULL == msgs) {
+        for (uint16_t k = 0; k < workers; ++k) {
+            jls_raw_close(raws[k]);
+        }
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
     }
-    if (NULL != progress_fn) {
+    volatile int32_t abort_flag = 0;
+    struct resum_worker_s w[RESUM_WORKERS_MAX];
+    struct jls_bk_thread_s * threads[RESUM_WORKERS_MAX];
+    for (uint16_t k = 0; k < workers; ++k) {
+        w[k].raw = raws[k];
+        w[k].defs = defs;
+        w[k].def_count = def_count;
+        w[k].idx = k;
+        w[k].stride = workers;
+        w[k].abort_flag = &abort_flag;
+        w[k].progress_fn = (0 == k) ? progress_fn : NULL;
+        w[k].progress_user_data = progress_user_data;
+        w[k].rcs = rcs;
+        w[k].msgs = msgs;
+        threads[k] = NULL;
+    }
+    for (uint16_t k = 1; k < workers; ++k) {
+        if (jls_bk_thread_run(&threads[k], resum_worker, &w[k])) {
+            threads[k] = NULL;
+            resum_worker(&w[k]);  // run this worker's slice on the calling thread
+        }
+    }
+    resum_worker(&w[0]);
+    for (uint16_t k = 1; k < workers; ++k) {
+        if (threads[k]) {
+            jls_bk_thread_join(threads[k]);
+        }
+    }
+    for (uint16_t k = 0; k < workers; ++k) {
+        jls_raw_close(raws[k]);
+    }
+
+    rc = 0;
+    for (uint16_t i = 0; i < def_count; ++i) {
+        if (NULL != msg_fn) {
+            msg_fn(msg_user_data, msgs[i]);
+        }
+        if (rcs[i] && !rc) {
+            rc = rcs[i];
+        }
+    }
+    free(msgs);
+    if ((0 == rc) && (NULL != progress_fn)) {
         progress_fn(progress_user_data, 1.0);
     }
-    jls_raw_close(rd);
-    jls_wr_close(wr);
-    return 0;
+    return rc;
 }
@@ -16,18 +16,28 @@
 
 #include "jls/core.h"
 #include "jls/backend.h"
+#include "jls/chunk_cache.h"
+#include "jls/shared_cache.h"
+#include "jls/delta.h"
 #include "jls/crc32c.h"
 #include "jls/format.h"
 #include "jls/bit_shift.h"
 #include "jls/cdef.h"
 #include "jls/ec.h"
 #include "jls/log.h"
+#include "jls/reader.h"
+#include "jls/time.h"
 #include "jls/track.h"
 #include "jls/util.h"
 #include <inttypes.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#if defined(_WIN32)
+#include <malloc.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#endif
 
 
 #define SAMPLE_SIZE_BYTES_MAX           (32)  // =256 bits, must be power of 2
@@ -92,23 +102,108 @@ static uint32_t round_up_to_multiple(uint32_t x, uint32_t m) {
     return ((x + m - 1) / m) * m;
 }
 
-int32_t jls_core_f64_buf_alloc(size_t length, struct jls_core_f64_buf_s ** buf) {
+#define BUF_ALIGN ((size_t) 64)
+#define HUGE_PAGE_SIZE ((size_t) 2 * 1024 * 1024)
+
+static bool huge_pages_enabled(void) {
+    static int en = -1;
+    if (en < 0) {
+        char * env = getenv("JLS_HUGE_PAGES");
+        en = (env && (env[0] != '0')) ? 1 : 0;
+    }
+    return en != 0;
+}
+
+void * jls_core_buf_alloc(size_t size) {
+#if defined(_WIN32)
+    (void) huge_pages_enabled;
+    return _aligned_malloc(size, BUF_ALIGN);
+#else
+    void * ptr = NULL;
+    size_t align = BUF_ALIGN;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    bool huge = huge_pages_enabled() && (size >= HUGE_PAGE_SIZE);
+    if (huge) {
+        // 2 MB aligned and sized so the kernel can back it with huge pages
+        align = HUGE_PAGE_SIZE;
+        size = (size + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    }
+#endif
+    if (posix_memalign(&ptr, align, size)) {
+        return NULL;
+    }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (huge) {
+        madvise(ptr, size, MADV_HUGEPAGE);  // best effort, small pages still work
+    }
+#endif
+    return ptr;
+#endif
+}
+
+void jls_core_buf_free(void * ptr) {
+    if (ptr) {
+#if defined(_WIN32)
+        _aligned_free(ptr);
+#else
+        free(ptr);
+#endif
+    }
+}
+
+static size_t f64_buf_mem(struct jls_core_f64_buf_s * buf) {
+    return (NULL == buf) ? 0 : (sizeof(struct jls_core_f64_buf_s) + buf->alloc_length * sizeof(double));
+}
+
+static size_t core_mem_used(struct jls_core_s * self) {
+    size_t sz = 0;
+    if (self->buf) {
+        sz += self->buf->alloc_size;
+    }
+    if (self->rd_index) {
+        sz += self->rd_index->alloc_size;
+    }
+    if (self->rd_summary) {
+        sz += self->rd_summary->alloc_size;
+    }
+    sz += f64_buf_mem(self->f64_sample_buf);
+    sz += f64_buf_mem(self->f64_stats_buf);
+    return sz;
+}
+
+int32_t jls_core_f64_buf_alloc(struct jls_core_s * self, size_t length, struct jls_core_f64_buf_s ** buf) {
     if (*buf) {
         if ((*buf)->alloc_length >= (size_t) length) {
             return 0;
-        } else {
-            free(*buf);
-            *buf = NULL;
         }
     }
 
     if (length < F64_BUF_LENGTH_MIN) {
         length = F64_BUF_LENGTH_MIN;
     }
-    struct jls_core_f64_buf_s * b = malloc(sizeof(struct jls_core_f64_buf_s) + length * sizeof(double));
+    size_t sz = sizeof(struct jls_core_f64_buf_s) + length * sizeof(double);
+    if (self->mem_budget) {
+        size_t used = core_mem_used(self) - f64_buf_mem(*buf);
+        if ((used + sz) > self->mem_budget) {
+            JLS_LOGW("f64 buffer alloc exceeds memory budget: %zu > %zu", used + sz, self->mem_budget);
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+    }
+    if (*buf) {
+        jls_core_buf_free(*buf);
+        *buf = NULL;
+    }
+    struct jls_core_f64_buf_s * b = jls_core_buf_alloc(sz);
     if (!b) {
         return JLS_ERROR_NOT_ENOUGH_MEMORY;
     }
+    // touch every page now: decode buffers allocate lazily on the
+    // thread that fills them, so committing here places the pages on
+    // that thread's NUMA node instead of wherever the first partial
+    // use happens to fault them in
+    for (size_t i = 0; i < sz; i += 4096) {
+        ((volatile uint8_t *) b)[i] = 0;
+    }
     b->start = b->buffer;
     b->end = b->buffer + length;
     b->alloc_length = length;
@@ -116,10 +211,50 @@ int32_t jls_core_f64_buf_alloc(size_t length, struct jls_core_f64_buf_s ** buf)
     return 0;
 }
 
+int32_t jls_core_mem_config(struct jls_core_s * self, size_t budget) {
+    if (NULL == self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    self->mem_budget = budget;
+    if (self->buf) {
+        self->buf->alloc_max = budget;
+    }
+    if (self->rd_index) {
+        self->rd_index->alloc_max = budget;
+    }
+    if (self->rd_summary) {
+        self->rd_summary->alloc_max = budget;
+    }
+    if (budget) {
+        // pre-size the sample buffer so that steady-state reads do not allocate
+        uint32_t samples_per_data = 0;
+        for (uint16_t i = 0; i < JLS_SIGNAL_COUNT; ++i) {
+            struct jls_signal_def_s * def = &self->signal_info[i].signal_def;
+            if ((def->signal_id == i) && (def->signal_type == JLS_SIGNAL_TYPE_FSR)) {
+                samples_per_data = u32_max(samples_per_data, def->samples_per_data);
+            }
+        }
+        if (samples_per_data
+                && jls_core_f64_buf_alloc(self, (size_t) samples_per_data, &self->f64_sample_buf)) {
+            JLS_LOGW("memory budget too small to pre-size the f64 sample buffer");
+        }
+    }
+    return 0;
+}
+
 void jls_core_f64_buf_free(struct jls_core_f64_buf_s * buf) {
-    if (NULL != buf) {
-        free(buf);
+    jls_core_buf_free(buf);
+}
+
+int32_t jls_core_mem_trim(struct jls_core_s * self) {
+    if (NULL == self) {
+        return JLS_ERROR_PARAMETER_INVALID;
     }
+    jls_core_f64_buf_free(self->f64_stats_buf);
+    self->f64_stats_buf = NULL;
+    jls_core_f64_buf_free(self->f64_sample_buf);
+    self->f64_sample_buf = NULL;
+    return 0;
 }
 
 int32_t jls_core_signal_def_validate(struct jls_signal_def_s const * def) {
@@ -176,6 +311,21 @@ int32_t jls_core_signal_def_validate(struct jls_signal_def_s const * def) {
                 return JLS_ERROR_PARAMETER_INVALID;
         }
     }
+
+    // Check data encoding
+    switch (def->data_encoding) {
+        case JLS_FSR_DATA_ENCODING_RAW: break;
+        case JLS_FSR_DATA_ENCODING_DELTA:
+            if ((def->signal_type != JLS_SIGNAL_TYPE_FSR)
+                    || (JLS_DATATYPE_BASETYPE_FLOAT == jls_datatype_parse_basetype(def->data_type))) {
+                JLS_LOGW("Delta encoding requires an FSR integer signal");
+                return JLS_ERROR_PARAMETER_INVALID;
+            }
+            break;
+        default:
+            JLS_LOGW("Invalid data encoding: %d", (int) def->data_encoding);
+            return JLS_ERROR_PARAMETER_INVALID;
+    }
     return 0;
 }
 
@@ -208,7 +358,51 @@ static void signal_def_defaults(struct jls_signal_def_s * def) {
     SIGNAL_DEF_DEFAULT(utc_decimate_factor);
 }
 
+// The auto-tuning model, see JLS_SIGNAL_DEF_AUTO:
+// Data chunks target CHUNK_BYTES_TARGET of payload, which amortizes
+// the per-chunk header, CRC, and seek costs without growing the
+// working buffers excessively.  The byte-derived sample count is
+// capped at CHUNK_SECONDS_MAX of samples so low-rate signals still
+// produce chunks often enough to seek and to survive truncation.
+// Each data chunk contributes ENTRIES_PER_DATA_TARGET summary
+// entries.  Summary chunks hold ENTRIES_PER_SUMMARY_AUTO entries of
+// JLS_SUMMARY_FSR_COUNT doubles, about the same payload size, chosen
+// as a multiple of both ENTRIES_PER_DATA_TARGET and the summary
+// decimate factor so the alignment pass does not shrink the data
+// chunks to fit.
+#define CHUNK_BYTES_TARGET        (32768)
+#define CHUNK_SECONDS_MAX         (10)
+#define ENTRIES_PER_DATA_TARGET   (64)
+#define ENTRIES_PER_SUMMARY_AUTO  (1280)
+
+static void signal_def_auto(struct jls_signal_def_s * def) {
+    if (JLS_SIGNAL_DEF_AUTO != def->samples_per_data) {
+        return;
+    }
+    uint8_t sample_size = jls_datatype_parse_size(def->data_type);
+    if (!sample_size) {
+        def->samples_per_data = 0;  // invalid data type, static defaults path
+        return;
+    }
+    uint64_t samples = ((uint64_t) CHUNK_BYTES_TARGET * 8) / sample_size;
+    if (def->sample_rate) {
+        uint64_t samples_max = (uint64_t) def->sample_rate * CHUNK_SECONDS_MAX;
+        if (samples_max < samples) {
+            samples = samples_max;
+        }
+    }
+    if (samples < SAMPLES_PER_DATA_MIN) {
+        samples = SAMPLES_PER_DATA_MIN;
+    }
+    def->samples_per_data = (uint32_t) samples;
+    def->sample_decimate_factor = u32_max((uint32_t) (samples / ENTRIES_PER_DATA_TARGET),
+                                          SAMPLE_DECIMATE_FACTOR_MIN);
+    def->entries_per_summary = ENTRIES_PER_SUMMARY_AUTO;
+    def->summary_decimate_factor = SIGNAL_32_DEFAULTS.summary_decimate_factor;
+}
+
 int32_t jls_core_signal_def_align(struct jls_signal_def_s * def) {
+    signal_def_auto(def);
     signal_def_defaults(def);
     uint8_t sample_size = jls_datatype_parse_size(def->data_type);
     uint32_t samples_per_data_multiple = (SAMPLE_SIZE_BYTES_MAX * 8) / sample_size;
@@ -261,13 +455,297 @@ int32_t jls_core_update_chunk_header(struct jls_core_s * self, struct jls_core_c
     return 0;
 }
 
+#define ARENA_BLOCK_SIZE (1 << 20)
+
+void * jls_core_arena_alloc(struct jls_core_s * self, size_t size) {
+    if (!self->arena_en) {
+        return jls_core_buf_alloc(size);
+    }
+    size = (size + (BUF_ALIGN - 1)) & ~(BUF_ALIGN - 1);
+
+    // reuse a released allocation of the same size, see jls_core_arena_free()
+    struct jls_core_arena_free_s ** prev = &self->arena_free;
+    while (*prev) {
+        if ((*prev)->size == size) {
+            struct jls_core_arena_free_s * f = *prev;
+            *prev = f->next;
+            return ((uint8_t *) f) + BUF_ALIGN;
+        }
+        prev = &(*prev)->next;
+    }
+
+    struct jls_core_arena_s * b = self->arena;
+    if ((NULL == b) || ((b->size - b->pos) < (size + BUF_ALIGN))) {
+        // slack so the first allocation can start on an aligned boundary
+        size_t block_size = (((size + BUF_ALIGN) > ARENA_BLOCK_SIZE) ? (size + BUF_ALIGN) : ARENA_BLOCK_SIZE)
+                + BUF_ALIGN;
+        b = jls_core_buf_alloc(sizeof(struct jls_core_arena_s) + block_size);
+        if (!b) {
+            return NULL;
+        }
+        b->next = self->arena;
+        b->size = block_size;
+        b->pos = (BUF_ALIGN - (((uintptr_t) (b + 1)) & (BUF_ALIGN - 1))) & (BUF_ALIGN - 1);
+        self->arena = b;
+    }
+    // an aligned header records the size so that a later free can recycle
+    uint8_t * hdr = ((uint8_t *) (b + 1)) + b->pos;
+    b->pos += size + BUF_ALIGN;
+    ((struct jls_core_arena_free_s *) hdr)->size = size;
+    return hdr + BUF_ALIGN;
+}
+
+static bool arena_owns(struct jls_core_s * self, void * ptr) {
+    uint8_t * p = (uint8_t *) ptr;
+    for (struct jls_core_arena_s * b = self->arena; b; b = b->next) {
+        uint8_t * start = (uint8_t *) (b + 1);
+        if ((p >= start) && (p < (start + b->size))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void jls_core_arena_free(struct jls_core_s * self, void * ptr) {
+    if (NULL == ptr) {
+        return;
+    }
+    if (!arena_owns(self, ptr)) {
+        jls_core_buf_free(ptr);
+        return;
+    }
+    // link in place for reuse by a later same-size allocation
+    struct jls_core_arena_free_s * f = (struct jls_core_arena_free_s *) (((uint8_t *) ptr) - BUF_ALIGN);
+    f->next = self->arena_free;
+    self->arena_free = f;
+}
+
+void jls_core_arena_finalize(struct jls_core_s * self) {
+    struct jls_core_arena_s * b = self->arena;
+    while (b) {
+        struct jls_core_arena_s * next = b->next;
+        jls_core_buf_free(b);
+        b = next;
+    }
+    self->arena = NULL;
+    self->arena_free = NULL;  // nodes lived inside the freed blocks
+}
+
+static int32_t head_defer_push(struct jls_core_s * self, struct jls_core_chunk_s * chunk) {
+    if (self->head_defer_count >= self->head_defer_alloc) {
+        uint32_t alloc = self->head_defer_alloc ? (self->head_defer_alloc * 2) : 1024;
+        struct jls_core_chunk_s * b = realloc(self->head_defer, alloc * sizeof(*b));
+        if (!b) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        self->head_defer = b;
+        self->head_defer_alloc = alloc;
+    }
+    self->head_defer[self->head_defer_count++] = *chunk;
+    return 0;
+}
+
+static int head_defer_compare(const void * a, const void * b) {
+    int64_t oa = ((const struct jls_core_chunk_s *) a)->offset;
+    int64_t ob = ((const struct jls_core_chunk_s *) b)->offset;
+    return (oa > ob) - (oa < ob);
+}
+
+int32_t jls_core_head_defer_apply(struct jls_core_s * self) {
+    if (!self->head_defer_count) {
+        return 0;
+    }
+    if (2 == self->head_defer_en) {
+        // strict append-only: never rewrite in place, keep deferring
+        // until jls_core_wr_link_table() drains the list at close
+        return 0;
+    }
+    qsort(self->head_defer, self->head_defer_count, sizeof(*self->head_defer), head_defer_compare);
+    // CRC the whole batch in one pass before issuing any I/O: the CRC
+    // kernel stays hot instead of interleaving with seek and write calls
+    for (uint32_t i = 0; i < self->head_defer_count; ++i) {
+        struct jls_chunk_header_s * hdr = &self->head_defer[i].hdr;
+        hdr->crc32 = jls_crc32c_hdr(hdr);
+    }
+    int64_t current_pos = jls_raw_chunk_tell(self->raw);
+    for (uint32_t i = 0; i < self->head_defer_count; ++i) {
+        struct jls_core_chunk_s * chunk = &self->head_defer[i];
+        ROE(jls_raw_chunk_seek(self->raw, chunk->offset));
+        ROE(jls_raw_wr_header_prechecked(self->raw, &chunk->hdr));
+    }
+    self->head_defer_count = 0;
+    ROE(jls_raw_chunk_seek(self->raw, current_pos));
+    return 0;
+}
+
+int32_t jls_core_head_defer_apply_slice(struct jls_core_s * self, uint32_t count_max) {
+    if (!self->head_defer_count || (2 == self->head_defer_en)) {
+        return 0;
+    }
+    if (count_max >= self->head_defer_count) {
+        return jls_core_head_defer_apply(self);
+    }
+    qsort(self->head_defer, self->head_defer_count, sizeof(*self->head_defer), head_defer_compare);
+    for (uint32_t i = 0; i < count_max; ++i) {
+        struct jls_chunk_header_s * hdr = &self->head_defer[i].hdr;
+        hdr->crc32 = jls_crc32c_hdr(hdr);
+    }
+    int64_t current_pos = jls_raw_chunk_tell(self->raw);
+    for (uint32_t i = 0; i < count_max; ++i) {
+        struct jls_core_chunk_s * chunk = &self->head_defer[i];
+        ROE(jls_raw_chunk_seek(self->raw, chunk->offset));
+        ROE(jls_raw_wr_header_prechecked(self->raw, &chunk->hdr));
+    }
+    self->head_defer_count -= count_max;
+    memmove(self->head_defer, self->head_defer + count_max,
+            self->head_defer_count * sizeof(*self->head_defer));
+    ROE(jls_raw_chunk_seek(self->raw, current_pos));
+    return 0;
+}
+
+int32_t jls_core_wr_link_table(struct jls_core_s * self) {
+    if ((2 != self->head_defer_en) || (0 == self->head_defer_count)) {
+        return 0;
+    }
+    qsort(self->head_defer, self->head_defer_count, sizeof(*self->head_defer), head_defer_compare);
+    size_t sz = sizeof(struct jls_link_table_s) + self->head_defer_count * sizeof(struct jls_link_entry_s);
+    struct jls_link_table_s * tbl = malloc(sz);
+    if (NULL == tbl) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    tbl->header.timestamp = 0;
+    tbl->header.entry_count = self->head_defer_count;
+    tbl->header.entry_size_bits = sizeof(struct jls_link_entry_s) * 8;
+    tbl->header.rsv16 = 0;
+    for (uint32_t i = 0; i < self->head_defer_count; ++i) {
+        tbl->entries[i].offset = self->head_defer[i].offset;
+        tbl->entries[i].item_next = self->head_defer[i].hdr.item_next;
+    }
+    struct jls_core_chunk_s chunk;
+    chunk.hdr.item_next = 0;
+    chunk.hdr.item_prev = 0;
+    chunk.hdr.tag = JLS_TAG_LINK_TABLE;
+    chunk.hdr.compression = JLS_COMPRESSION_NONE;
+    chunk.hdr.chunk_meta = 0;
+    chunk.hdr.payload_length = (uint32_t) sz;
+    chunk.offset = jls_raw_chunk_tell(self->raw);
+    int32_t rc = jls_raw_wr(self->raw, &chunk.hdr, (const uint8_t *) tbl);
+    free(tbl);
+    self->head_defer_count = 0;
+    return rc;
+}
+
+// chunk clock entries per mid-stream CHUNK_CLOCK chunk (16 KiB payload)
+#define CHUNK_CLOCK_ENTRIES_MAX (1024U)
+
+int32_t jls_core_chunk_clock_record(struct jls_core_s * self, int64_t offset) {
+    if (!self->chunk_clock_en) {
+        return 0;
+    }
+    if (self->chunk_clock_count >= self->chunk_clock_alloc) {
+        uint32_t alloc = self->chunk_clock_alloc ? (self->chunk_clock_alloc * 2) : 256;
+        struct jls_chunk_clock_entry_s * b = realloc(self->chunk_clock, alloc * sizeof(*b));
+        if (NULL == b) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        self->chunk_clock = b;
+        self->chunk_clock_alloc = alloc;
+    }
+    self->chunk_clock[self->chunk_clock_count].offset = offset;
+    self->chunk_clock[self->chunk_clock_count].timestamp = jls_now();
+    ++self->chunk_clock_count;
+    if (self->chunk_clock_count >= CHUNK_CLOCK_ENTRIES_MAX) {
+        return jls_core_wr_chunk_clock(self);
+    }
+    return 0;
+}
+
+int32_t jls_core_wr_chunk_clock(struct jls_core_s * self) {
+    if (!self->chunk_clock_en) {
+        return 0;
+    }
+    size_t sz = sizeof(struct jls_chunk_clock_s)
+            + self->chunk_clock_count * sizeof(struct jls_chunk_clock_entry_s);
+    struct jls_chunk_clock_s * clk = malloc(sz);
+    if (NULL == clk) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    clk->header.timestamp = self->chunk_clock_prev;  // backward chain
+    clk->header.entry_count = self->chunk_clock_count;
+    clk->header.entry_size_bits = sizeof(struct jls_chunk_clock_entry_s) * 8;
+    clk->header.rsv16 = 0;
+    memcpy(clk->entries, self->chunk_clock,
+           self->chunk_clock_count * sizeof(struct jls_chunk_clock_entry_s));
+    struct jls_core_chunk_s chunk;
+    chunk.hdr.item_next = 0;
+    chunk.hdr.item_prev = 0;
+    chunk.hdr.tag = JLS_TAG_CHUNK_CLOCK;
+    chunk.hdr.compression = JLS_COMPRESSION_NONE;
+    chunk.hdr.chunk_meta = 0;
+    chunk.hdr.payload_length = (uint32_t) sz;
+    chunk.offset = jls_raw_chunk_tell(self->raw);
+    int32_t rc = jls_raw_wr(self->raw, &chunk.hdr, (const uint8_t *) clk);
+    free(clk);
+    if (0 == rc) {
+        self->chunk_clock_prev = chunk.offset;
+        self->chunk_clock_count = 0;
+    }
+    return rc;
+}
+
+void jls_core_link_table_patch(struct jls_core_s * self, int64_t offset, struct jls_chunk_header_s * hdr) {
+    const struct jls_link_table_s * tbl = self->link_table;
+    if ((NULL == tbl) || hdr->item_next) {
+        return;
+    }
+    uint32_t lo = 0;
+    uint32_t hi = tbl->header.entry_count;
+    while (lo < hi) {
+        uint32_t mid = lo + ((hi - lo) >> 1);
+        if (tbl->entries[mid].offset < offset) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if ((lo < tbl->header.entry_count) && (tbl->entries[lo].offset == offset)) {
+        hdr->item_next = tbl->entries[lo].item_next;
+    }
+}
+
+int64_t jls_core_chain_scan_next(struct jls_core_s * self, int64_t offset, uint8_t tag, uint16_t chunk_meta) {
+    struct jls_chunk_header_s hdr;
+    if (jls_raw_chunk_seek(self->raw, offset)) {
+        return 0;
+    }
+    while (0 == jls_raw_chunk_next(self->raw)) {
+        if (jls_raw_rd_header(self->raw, &hdr)) {
+            return 0;
+        }
+        if ((hdr.tag == tag) && (hdr.chunk_meta == chunk_meta)) {
+            return jls_raw_chunk_tell(self->raw);
+        }
+    }
+    return 0;
+}
+
 int32_t jls_core_update_item_head(struct jls_core_s * self, struct jls_core_chunk_s * head, struct jls_core_chunk_s * next) {
     if (head->offset) {
-        int64_t current_pos = jls_raw_chunk_tell(self->raw);
         head->hdr.item_next = next->offset;
-        ROE(jls_raw_chunk_seek(self->raw, head->offset));
-        ROE(jls_raw_wr_header(self->raw, &head->hdr));
-        ROE(jls_raw_chunk_seek(self->raw, current_pos));
+        // Only track data/index/summary chains defer: the definition
+        // chains (source, signal, track def/head, user data) are walked
+        // on open, including the repair of unclosed files, and they
+        // update rarely enough that immediate rewrites do not matter.
+        if (self->head_defer_en && (head->hdr.tag & JLS_TRACK_TAG_FLAG)
+                && ((head->hdr.tag & 7) >= JLS_TRACK_CHUNK_DATA)) {
+            // append-only steady state: batch the backward header rewrite
+            ROE(head_defer_push(self, head));
+        } else {
+            int64_t current_pos = jls_raw_chunk_tell(self->raw);
+            ROE(jls_raw_chunk_seek(self->raw, head->offset));
+            ROE(jls_raw_wr_header(self->raw, &head->hdr));
+            ROE(jls_raw_chunk_seek(self->raw, current_pos));
+        }
     }
     *head = *next;
     return 0;
@@ -342,9 +820,10 @@ int32_t jls_core_wr_data(struct jls_core_s * self, uint16_t signal_id, enum jls_
     chunk.hdr.item_next = 0;  // update later
     chunk.hdr.item_prev = track->data_head.offset;
     chunk.hdr.tag = jls_track_tag_pack(track_type, JLS_TRACK_CHUNK_DATA);
-    chunk.hdr.rsv0_u8 = 0;
+    chunk.hdr.compression = JLS_COMPRESSION_NONE;
     chunk.hdr.chunk_meta = signal_id | (0 << 12);
     chunk.hdr.payload_length = payload_length;
+    ROE(jls_raw_align(self->raw));
     chunk.offset = jls_raw_chunk_tell(self->raw);
 
     if (JLS_LOG_CHECK_STATIC(JLS_LOG_LEVEL_DEBUG3)) {
@@ -356,73 +835,717 @@ int32_t jls_core_wr_data(struct jls_core_s * self, uint16_t signal_id, enum jls_
 
     ROE(jls_raw_wr(self->raw, &chunk.hdr, payload));
     ROE(jls_core_update_item_head(self, &track->data_head, &chunk));
+    if (JLS_TRACK_TYPE_FSR == track_type) {
+        ROE(jls_core_chunk_clock_record(self, chunk.offset));
+        struct jls_payload_header_s * hdr = (struct jls_payload_header_s *) payload;
+        ROE(jls_core_data_map_append(self, signal_id, hdr->timestamp, hdr->entry_count));
+    }
 
     if (!track->head_offsets[0]) {
         track->head_offsets[0] = chunk.offset;
         ROE(jls_track_wr_head(track));
     }
 
-    return 0;
+    return jls_core_checkpoint_process(self);
+}
+
+/**
+ * @brief Locate and claim the level 0 data chunk slot for a ring rewrite.
+ *
+ * @param self The core instance.
+ * @param signal_id The signal id with a valid FSR signal_def.
+ * @param chunk_idx The level 0 data block index for the slot to recycle.
+ * @param payload_length The replacement payload length in bytes.
+ * @param[out] slot The recycled data chunk offset, 0 to append instead.
+ * @param[out] payload_prev_length The on-disk payload_prev_length at slot.
+ * @return 0 or error code.
+ *
+ * On success, the slot's entry in the covering on-disk level 1 INDEX
+ * chunk has been zeroed, which readers already treat as omitted data.
+ * Zero the entry before overwriting the slot so that a crash between
+ * the two writes cannot leave the index pointing at mismatched data.
+ * The caller must restore the file position.
+ */
+static int32_t fsr_ring_slot_acquire(struct jls_core_s * self, uint16_t signal_id, int64_t chunk_idx,
+                                     uint32_t payload_length, int64_t * slot, uint32_t * payload_prev_length) {
+    struct jls_core_signal_s * info = &self->signal_info[signal_id];
+    struct jls_signal_def_s * def = &info->signal_def;
+    struct jls_fsr_seek_index_s * idx = info->seek_index;
+    *slot = 0;
+    if ((chunk_idx <= 0) || (NULL == idx) || !def->samples_per_data) {
+        return 0;
+    }
+    uint32_t per_index = (uint32_t) (((uint64_t) def->sample_decimate_factor * def->entries_per_summary)
+            / def->samples_per_data);
+    if (!per_index) {
+        return 0;
+    }
+    int64_t idx_block = chunk_idx / per_index;
+    uint32_t entry = (uint32_t) (chunk_idx - idx_block * per_index);
+    if (idx_block >= (int64_t) idx->header.entry_count) {
+        return 0;  // the covering INDEX chunk is not yet on disk
+    }
+    int64_t index_offset = (int64_t) idx->offsets[idx_block];
+
+    // read the on-disk INDEX chunk directly, bypassing the chunk cache
+    struct jls_chunk_header_s idx_hdr;
+    ROE(jls_raw_chunk_seek(self->raw, index_offset));
+    ROE(jls_raw_rd_header(self->raw, &idx_hdr));
+    if ((idx_hdr.tag != JLS_TAG_TRACK_FSR_INDEX)
+            || (idx_hdr.chunk_meta != (signal_id | (1 << 12)))) {
+        JLS_LOGW("ring: INDEX chunk mismatch at %" PRIi64, index_offset);
+        return 0;
+    }
+    if (idx_hdr.payload_length > self->buf->alloc_size) {
+        ROE(jls_buf_realloc(self->buf, idx_hdr.payload_length));
+    }
+    ROE(jls_raw_rd_payload(self->raw, (uint32_t) self->buf->alloc_size, self->buf->start));
+    struct jls_fsr_index_s * ridx = (struct jls_fsr_index_s *) self->buf->start;
+    if (entry >= ridx->header.entry_count) {
+        return 0;
+    }
+    int64_t offset = (int64_t) ridx->offsets[entry];
+    if (!offset) {
+        return 0;  // already omitted, nothing to reclaim
+    }
+
+    // the slot must hold a data chunk with exactly matching payload length
+    struct jls_chunk_header_s slot_hdr;
+    ROE(jls_raw_chunk_seek(self->raw, offset));
+    ROE(jls_raw_rd_header(self->raw, &slot_hdr));
+    if ((slot_hdr.tag != JLS_TAG_TRACK_FSR_DATA) || (slot_hdr.payload_length != payload_length)) {
+        return 0;
+    }
+
+    // persist the omission: rewrite the INDEX chunk with the entry zeroed
+    ridx->offsets[entry] = 0;
+    ROE(jls_raw_chunk_seek(self->raw, index_offset));
+    ROE(jls_raw_wr(self->raw, &idx_hdr, self->buf->start));
+
+    *slot = offset;
+    *payload_prev_length = slot_hdr.payload_prev_length;
+    return 0;
+}
+
+int32_t jls_core_fsr_ring_wr_data(struct jls_core_s * self, uint16_t signal_id, int64_t chunk_idx,
+                                  const uint8_t * payload, uint32_t payload_length, int64_t * pos) {
+    ROE(jls_core_signal_validate(self, signal_id));
+    struct jls_core_signal_s * info = &self->signal_info[signal_id];
+    struct jls_core_track_s * track = &info->tracks[JLS_TRACK_TYPE_FSR];
+    int64_t end_pos = jls_raw_chunk_tell(self->raw);
+    int64_t slot = 0;
+    uint32_t payload_prev_length = 0;
+    ROE(fsr_ring_slot_acquire(self, signal_id, chunk_idx, payload_length, &slot, &payload_prev_length));
+    if (!slot) {
+        // cannot recycle safely: append and let the file grow
+        ROE(jls_raw_chunk_seek(self->raw, end_pos));
+        ROE(jls_core_wr_data(self, signal_id, JLS_TRACK_TYPE_FSR, payload, payload_length));
+        *pos = track->data_head.offset;
+        return 0;
+    }
+
+    struct jls_core_chunk_s chunk;
+    chunk.hdr.item_next = 0;  // update later
+    chunk.hdr.item_prev = track->data_head.offset;
+    chunk.hdr.tag = JLS_TAG_TRACK_FSR_DATA;
+    chunk.hdr.compression = JLS_COMPRESSION_NONE;
+    chunk.hdr.chunk_meta = signal_id | (0 << 12);
+    chunk.hdr.payload_length = payload_length;
+    chunk.hdr.payload_prev_length = payload_prev_length;  // in-place rewrites keep the on-disk value
+    chunk.offset = slot;
+
+    if (JLS_LOG_CHECK_STATIC(JLS_LOG_LEVEL_DEBUG3)) {
+        struct jls_payload_header_s * hdr = (struct jls_payload_header_s *) payload;
+        JLS_LOGD3("ring_wr_data(signal_id=%d, timestamp=%" PRIi64 ", entries=%" PRIu32 ") => slot=%" PRIi64,
+                  (int) signal_id, hdr->timestamp, hdr->entry_count, slot);
+    }
+
+    ROE(jls_raw_chunk_seek(self->raw, slot));
+    ROE(jls_raw_wr(self->raw, &chunk.hdr, payload));
+    ROE(jls_core_update_item_head(self, &track->data_head, &chunk));
+    struct jls_fsr_data_map_s * map = info->data_map;
+    if ((NULL != map) && (chunk_idx < (int64_t) map->header.entry_count)) {
+        // keep the data map tracking the recycled slot contents
+        struct jls_payload_header_s * hdr = (struct jls_payload_header_s *) payload;
+        map->entries[chunk_idx].timestamp = hdr->timestamp;
+        map->entries[chunk_idx].entry_count = hdr->entry_count;
+    }
+    *pos = slot;
+    return jls_raw_chunk_seek(self->raw, end_pos);
+}
+
+int32_t jls_core_wr_summary(struct jls_core_s * self, uint16_t signal_id, enum jls_track_type_e track_type, uint8_t level,
+                            const uint8_t * payload, uint32_t payload_length) {
+    ROE(jls_core_signal_validate(self, signal_id));
+    struct jls_core_signal_s * info = &self->signal_info[signal_id];
+    struct jls_core_track_s * track = &info->tracks[track_type];
+    struct jls_core_chunk_s chunk;
+
+    chunk.hdr.item_next = 0;  // update later
+    chunk.hdr.item_prev = track->summary_head[level].offset;
+    chunk.hdr.tag = jls_track_tag_pack(track_type, JLS_TRACK_CHUNK_SUMMARY);
+    chunk.hdr.compression = JLS_COMPRESSION_NONE;
+    chunk.hdr.chunk_meta = signal_id | (((uint16_t) level) << 12);
+    chunk.hdr.payload_length = payload_length;
+    ROE(jls_raw_align(self->raw));
+    chunk.offset = jls_raw_chunk_tell(self->raw);
+
+    // write
+    if (JLS_LOG_CHECK_STATIC(JLS_LOG_LEVEL_DEBUG3)) {
+        struct jls_payload_header_s * hdr = (struct jls_payload_header_s *) payload;
+                JLS_LOGD3("wr_summary(signal_id=%d, level=%d, timestamp=%" PRIi64 ", entries=%" PRIu32
+                                  ") => offset=%" PRIi64,
+                          (int) signal_id, (int) level,
+                          hdr->timestamp, hdr->entry_count,
+                          jls_raw_chunk_tell(self->raw));
+    }
+    ROE(jls_raw_wr(self->raw, &chunk.hdr, payload));
+    ROE(jls_core_update_item_head(self, &track->summary_head[level], &chunk));
+    return 0;
+}
+
+int32_t jls_core_wr_index(struct jls_core_s * self, uint16_t signal_id, enum jls_track_type_e track_type, uint8_t level,
+                          const uint8_t * payload, uint32_t payload_length) {
+    ROE(jls_core_signal_validate(self, signal_id));
+    struct jls_core_signal_s * info = &self->signal_info[signal_id];
+    struct jls_core_track_s * track = &info->tracks[track_type];
+    struct jls_core_chunk_s chunk;
+
+    chunk.hdr.item_next = 0;  // update later
+    chunk.hdr.item_prev = track->index_head[level].offset;
+    chunk.hdr.tag = jls_track_tag_pack(track_type, JLS_TRACK_CHUNK_INDEX);
+    chunk.hdr.compression = JLS_COMPRESSION_NONE;
+    chunk.hdr.chunk_meta = signal_id | (((uint16_t) level) << 12);;
+    chunk.hdr.payload_length = payload_length;
+    chunk.offset = jls_raw_chunk_tell(self->raw);
+
+    // write
+    if (JLS_LOG_CHECK_STATIC(JLS_LOG_LEVEL_DEBUG3)) {
+        struct jls_payload_header_s * hdr = (struct jls_payload_header_s *) payload;
+                JLS_LOGD3("wr_index(signal_id=%d, level=%d, timestamp=%" PRIi64 ", entries=%" PRIu32
+                                  ") => offset=%" PRIi64,
+                          (int) signal_id, (int) level,
+                          hdr->timestamp, hdr->entry_count,
+                          jls_raw_chunk_tell(self->raw));
+    }
+    ROE(jls_raw_wr(self->raw, &chunk.hdr, payload));
+    ROE(jls_core_update_item_head(self, &track->index_head[level], &chunk));
+    ROE(jls_track_update(track, level, chunk.offset));
+
+    if ((JLS_TRACK_TYPE_FSR == track_type) && (1 == level)) {
+        struct jls_payload_header_s * hdr = (struct jls_payload_header_s *) payload;
+        ROE(jls_core_seek_index_append(self, signal_id, hdr->timestamp, chunk.offset));
+    }
+
+    return 0;
+}
+
+int32_t jls_core_seek_index_append(struct jls_core_s * self, uint16_t signal_id,
+                                   int64_t timestamp, int64_t offset) {
+    ROE(jls_core_signal_validate(self, signal_id));
+    struct jls_core_signal_s * info = &self->signal_info[signal_id];
+    struct jls_fsr_seek_index_s * idx = info->seek_index;
+    if (NULL == idx) {
+        info->seek_index_alloc = 1024;
+        idx = malloc(sizeof(*idx) + info->seek_index_alloc * sizeof(uint64_t));
+        if (NULL == idx) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        idx->header.timestamp = timestamp;
+        idx->header.entry_count = 0;
+        idx->header.entry_size_bits = sizeof(uint64_t) * 8;
+        idx->header.rsv16 = 0;
+        info->seek_index = idx;
+    } else if (idx->header.entry_count >= info->seek_index_alloc) {
+        info->seek_index_alloc *= 2;
+        idx = realloc(idx, sizeof(*idx) + info->seek_index_alloc * sizeof(uint64_t));
+        if (NULL == idx) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        info->seek_index = idx;
+    }
+    idx->offsets[idx->header.entry_count++] = (uint64_t) offset;
+    return 0;
+}
+
+int32_t jls_core_wr_seek_index(struct jls_core_s * self) {
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        struct jls_fsr_seek_index_s * idx = self->signal_info[signal_id].seek_index;
+        if ((NULL == idx) || (0 == idx->header.entry_count)) {
+            continue;
+        }
+        struct jls_core_chunk_s chunk;
+        chunk.hdr.item_next = 0;
+        chunk.hdr.item_prev = 0;
+        chunk.hdr.tag = JLS_TAG_SEEK_INDEX;
+        chunk.hdr.compression = JLS_COMPRESSION_NONE;
+        chunk.hdr.chunk_meta = signal_id;
+        chunk.hdr.payload_length = (uint32_t) (sizeof(*idx) + idx->header.entry_count * sizeof(uint64_t));
+        chunk.offset = jls_raw_chunk_tell(self->raw);
+        ROE(jls_raw_wr(self->raw, &chunk.hdr, (const uint8_t *) idx));
+    }
+    return 0;
+}
+
+int32_t jls_core_data_map_append(struct jls_core_s * self, uint16_t signal_id,
+                                 int64_t timestamp, uint32_t entry_count) {
+    ROE(jls_core_signal_validate(self, signal_id));
+    struct jls_core_signal_s * info = &self->signal_info[signal_id];
+    struct jls_fsr_data_map_s * map = info->data_map;
+    if (NULL == map) {
+        info->data_map_alloc = 1024;
+        map = malloc(sizeof(*map) + info->data_map_alloc * sizeof(struct jls_fsr_data_map_entry_s));
+        if (NULL == map) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        map->header.timestamp = timestamp;
+        map->header.entry_count = 0;
+        map->header.entry_size_bits = sizeof(struct jls_fsr_data_map_entry_s) * 8;
+        map->header.rsv16 = 0;
+        info->data_map = map;
+    } else if (map->header.entry_count >= info->data_map_alloc) {
+        info->data_map_alloc *= 2;
+        map = realloc(map, sizeof(*map) + info->data_map_alloc * sizeof(struct jls_fsr_data_map_entry_s));
+        if (NULL == map) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        info->data_map = map;
+    }
+    struct jls_fsr_data_map_entry_s * entry = &map->entries[map->header.entry_count++];
+    entry->timestamp = timestamp;
+    entry->entry_count = entry_count;
+    entry->rsv32 = 0;
+    return 0;
+}
+
+int32_t jls_core_wr_data_map(struct jls_core_s * self) {
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        struct jls_fsr_data_map_s * map = self->signal_info[signal_id].data_map;
+        if ((NULL == map) || (0 == map->header.entry_count)) {
+            continue;
+        }
+        struct jls_core_chunk_s chunk;
+        chunk.hdr.item_next = 0;
+        chunk.hdr.item_prev = 0;
+        chunk.hdr.tag = JLS_TAG_DATA_MAP;
+        chunk.hdr.compression = JLS_COMPRESSION_NONE;
+        chunk.hdr.chunk_meta = signal_id;
+        chunk.hdr.payload_length = (uint32_t) (sizeof(*map)
+                + map->header.entry_count * sizeof(struct jls_fsr_data_map_entry_s));
+        chunk.offset = jls_raw_chunk_tell(self->raw);
+        ROE(jls_raw_wr(self->raw, &chunk.hdr, (const uint8_t *) map));
+    }
+    return 0;
+}
+
+static int32_t core_rd_directory(struct jls_core_s * self) {
+    struct jls_buf_s * buf = self->buf;
+    uint8_t version = 0;
+    uint8_t rsv8 = 0;
+    uint16_t source_count = 0;
+    uint16_t signal_count = 0;
+    uint16_t rsv16 = 0;
+    ROE(jls_buf_rd_u8(buf, &version));
+    if (1 != version) {
+        JLS_LOGW("unsupported directory version %d - skip", (int) version);
+        return 0;
+    }
+    ROE(jls_buf_rd_u8(buf, &rsv8));
+    ROE(jls_buf_rd_u16(buf, &source_count));
+    ROE(jls_buf_rd_u16(buf, &signal_count));
+    ROE(jls_buf_rd_u16(buf, &rsv16));
+    // the first user_data chunk: the jls_core_user_data() iteration anchor
+    ROE(jls_buf_rd_i64(buf, &self->user_data_head.offset));
+    ROE(jls_buf_rd_bin(buf, &self->user_data_head.hdr, sizeof(self->user_data_head.hdr)));
+
+    for (uint16_t k = 0; k < source_count; ++k) {
+        uint16_t source_id = 0;
+        ROE(jls_buf_rd_u16(buf, &source_id));
+        if (source_id >= JLS_SOURCE_COUNT) {
+            return JLS_ERROR_PARAMETER_INVALID;
+        }
+        struct jls_core_source_s * info = &self->source_info[source_id];
+        ROE(jls_buf_rd_i64(buf, &info->chunk_def.offset));
+        ROE(jls_buf_rd_bin(buf, &info->chunk_def.hdr, sizeof(info->chunk_def.hdr)));
+        struct jls_source_def_s * src = &info->source_def;
+        ROE(jls_buf_rd_str(buf, (const char **) &src->name));
+        ROE(jls_buf_rd_str(buf, (const char **) &src->vendor));
+        ROE(jls_buf_rd_str(buf, (const char **) &src->model));
+        ROE(jls_buf_rd_str(buf, (const char **) &src->version));
+        ROE(jls_buf_rd_str(buf, (const char **) &src->serial_number));
+        src->source_id = source_id;  // indicate that this source is valid!
+    }
+
+    for (uint16_t k = 0; k < signal_count; ++k) {
+        uint16_t signal_id = 0;
+        ROE(jls_buf_rd_u16(buf, &signal_id));
+        if (signal_id >= JLS_SIGNAL_COUNT) {
+            return JLS_ERROR_PARAMETER_INVALID;
+        }
+        struct jls_core_signal_s * info = &self->signal_info[signal_id];
+        info->parent = self;
+        ROE(jls_buf_rd_i64(buf, &info->chunk_def.offset));
+        ROE(jls_buf_rd_bin(buf, &info->chunk_def.hdr, sizeof(info->chunk_def.hdr)));
+        struct jls_signal_def_s * s = &info->signal_def;
+        ROE(jls_buf_rd_u16(buf, &s->source_id));
+        ROE(jls_buf_rd_u8(buf, &s->signal_type));
+        ROE(jls_buf_rd_u8(buf, &s->data_encoding));
+        ROE(jls_buf_rd_u32(buf, &s->data_type));
+        ROE(jls_buf_rd_u32(buf, &s->sample_rate));
+        ROE(jls_buf_rd_u32(buf, &s->samples_per_data));
+        ROE(jls_buf_rd_u32(buf, &s->sample_decimate_factor));
+        ROE(jls_buf_rd_u32(buf, &s->entries_per_summary));
+        ROE(jls_buf_rd_u32(buf, &s->summary_decimate_factor));
+        ROE(jls_buf_rd_u32(buf, &s->annotation_decimate_factor));
+        ROE(jls_buf_rd_u32(buf, &s->utc_decimate_factor));
+        ROE(jls_buf_rd_i64(buf, &s->sample_id_offset));
+        ROE(jls_buf_rd_str(buf, (const char **) &s->name));
+        ROE(jls_buf_rd_str(buf, (const char **) &s->units));
+        if (0 == jls_core_signal_def_validate(s)) {  // validate passed
+            s->signal_id = signal_id;  // indicate that this signal is valid
+        } else {
+            JLS_LOGW("Signal validation failed for %d : %s", signal_id, s->name);
+        } // else skip
+
+        for (uint8_t track_type = 0; track_type < JLS_TRACK_TYPE_COUNT; ++track_type) {
+            int64_t offset = 0;
+            ROE(jls_buf_rd_i64(buf, &offset));
+            if (!offset) {
+                continue;
+            }
+            struct jls_core_track_s * track = &info->tracks[track_type];
+            track->parent = info;
+            track->track_type = track_type;
+            track->head.offset = offset;
+            ROE(jls_buf_rd_bin(buf, &track->head.hdr, sizeof(track->head.hdr)));
+            ROE(jls_buf_rd_bin(buf, track->head_offsets, sizeof(track->head_offsets)));
+        }
+    }
+
+    self->dir_en = 1;
+    JLS_LOGD1("directory: %d sources, %d signals", (int) source_count, (int) signal_count);
+    return 0;
+}
+
+int32_t jls_core_rd_seek_index(struct jls_core_s * self) {
+    // walk backward from the END chunk over the trailing sidecar chunks
+    while (1) {
+        if (jls_raw_chunk_prev(self->raw)) {
+            return 0;
+        }
+        int64_t offset = jls_raw_chunk_tell(self->raw);
+        ROE(jls_core_rd_chunk(self));
+        uint16_t signal_id = self->chunk_cur.hdr.chunk_meta & 0x0fff;
+        if (self->chunk_cur.hdr.tag == JLS_TAG_SEEK_INDEX) {
+            struct jls_fsr_seek_index_s * src = (struct jls_fsr_seek_index_s *) self->buf->start;
+            size_t sz = sizeof(*src) + src->header.entry_count * sizeof(uint64_t);
+            if ((signal_id >= JLS_SIGNAL_COUNT) || (sz > self->buf->length)) {
+                JLS_LOGW("invalid seek index chunk at %" PRIi64 " - skip", offset);
+            } else {
+                struct jls_core_signal_s * info = &self->signal_info[signal_id];
+                free(info->seek_index);
+                info->seek_index = malloc(sz);
+                if (NULL == info->seek_index) {
+                    return JLS_ERROR_NOT_ENOUGH_MEMORY;
+                }
+                memcpy(info->seek_index, src, sz);
+                info->seek_index_alloc = src->header.entry_count;
+                JLS_LOGD1("seek index signal %d: %" PRIu32 " entries",
+                          (int) signal_id, src->header.entry_count);
+            }
+        } else if (self->chunk_cur.hdr.tag == JLS_TAG_UTC_TMAP) {
+            struct jls_utc_tmap_s * src = (struct jls_utc_tmap_s *) self->buf->start;
+            size_t sz = sizeof(*src) + src->header.entry_count * sizeof(struct jls_utc_summary_entry_s);
+            if ((signal_id >= JLS_SIGNAL_COUNT) || (sz > self->buf->length)) {
+                JLS_LOGW("invalid UTC time map chunk at %" PRIi64 " - skip", offset);
+            } else {
+                struct jls_core_signal_s * info = &self->signal_info[signal_id];
+                free(info->tmap_sidecar);
+                info->tmap_sidecar = malloc(sz);
+                if (NULL == info->tmap_sidecar) {
+                    return JLS_ERROR_NOT_ENOUGH_MEMORY;
+                }
+                memcpy(info->tmap_sidecar, src, sz);
+                info->tmap_sidecar_alloc = src->header.entry_count;
+                JLS_LOGD1("UTC time map signal %d: %" PRIu32 " entries",
+                          (int) signal_id, src->header.entry_count);
+            }
+        } else if (self->chunk_cur.hdr.tag == JLS_TAG_DATA_MAP) {
+            struct jls_fsr_data_map_s * src = (struct jls_fsr_data_map_s *) self->buf->start;
+            size_t sz = sizeof(*src) + src->header.entry_count * sizeof(struct jls_fsr_data_map_entry_s);
+            if ((signal_id >= JLS_SIGNAL_COUNT) || (sz > self->buf->length)) {
+                JLS_LOGW("invalid data map chunk at %" PRIi64 " - skip", offset);
+            } else {
+                struct jls_core_signal_s * info = &self->signal_info[signal_id];
+                free(info->data_map);
+                info->data_map = malloc(sz);
+                if (NULL == info->data_map) {
+                    return JLS_ERROR_NOT_ENOUGH_MEMORY;
+                }
+                memcpy(info->data_map, src, sz);
+                info->data_map_alloc = src->header.entry_count;
+                JLS_LOGD1("data map signal %d: %" PRIu32 " entries",
+                          (int) signal_id, src->header.entry_count);
+            }
+        } else if (self->chunk_cur.hdr.tag == JLS_TAG_LINK_TABLE) {
+            struct jls_link_table_s * src = (struct jls_link_table_s *) self->buf->start;
+            size_t sz = sizeof(*src) + src->header.entry_count * sizeof(struct jls_link_entry_s);
+            if ((src->header.entry_size_bits != (sizeof(struct jls_link_entry_s) * 8))
+                    || (sz > self->buf->length)) {
+                JLS_LOGW("invalid link table chunk at %" PRIi64 " - skip", offset);
+            } else {
+                free(self->link_table);
+                self->link_table = malloc(sz);
+                if (NULL == self->link_table) {
+                    return JLS_ERROR_NOT_ENOUGH_MEMORY;
+                }
+                memcpy(self->link_table, src, sz);
+                JLS_LOGD1("link table: %" PRIu32 " entries", src->header.entry_count);
+            }
+        } else if (self->chunk_cur.hdr.tag == JLS_TAG_CHUNK_CLOCK) {
+            // anchor only: jls_rd_chunk_clock() follows the chain on demand
+            self->chunk_clock_head = offset;
+        } else if (self->chunk_cur.hdr.tag == JLS_TAG_DIRECTORY) {
+            if (core_rd_directory(self)) {
+                JLS_LOGW("invalid directory chunk at %" PRIi64 " - skip", offset);
+                self->dir_en = 0;
+            }
+        } else {
+            return 0;
+        }
+        ROE(jls_raw_chunk_seek(self->raw, offset));
+    }
+}
+
+void jls_core_seek_index_free(struct jls_core_s * self) {
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        struct jls_core_signal_s * info = &self->signal_info[signal_id];
+        if (NULL != info->seek_index) {
+            free(info->seek_index);
+            info->seek_index = NULL;
+        }
+        info->seek_index_alloc = 0;
+        if (NULL != info->data_map) {
+            free(info->data_map);
+            info->data_map = NULL;
+        }
+        info->data_map_alloc = 0;
+        if (NULL != info->follow_index) {
+            free(info->follow_index);
+            info->follow_index = NULL;
+        }
+        info->follow_index_alloc = 0;
+        for (uint8_t level = 0; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+            if (NULL != info->preview[level]) {
+                free(info->preview[level]);
+                info->preview[level] = NULL;
+            }
+            info->preview_alloc[level] = 0;
+        }
+    }
+    free(self->link_table);
+    self->link_table = NULL;
+}
+
+int32_t jls_core_tmap_append(struct jls_core_s * self, uint16_t signal_id,
+                             int64_t sample_id, int64_t utc) {
+    ROE(jls_core_signal_validate(self, signal_id));
+    struct jls_core_signal_s * info = &self->signal_info[signal_id];
+    struct jls_utc_tmap_s * tmap = info->tmap_sidecar;
+    if (NULL == tmap) {
+        info->tmap_sidecar_alloc = 1024;
+        tmap = malloc(sizeof(*tmap) + info->tmap_sidecar_alloc * sizeof(struct jls_utc_summary_entry_s));
+        if (NULL == tmap) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        tmap->header.timestamp = sample_id;
+        tmap->header.entry_count = 0;
+        tmap->header.entry_size_bits = sizeof(struct jls_utc_summary_entry_s) * 8;
+        tmap->header.rsv16 = 0;
+        info->tmap_sidecar = tmap;
+    } else if (tmap->header.entry_count >= info->tmap_sidecar_alloc) {
+        info->tmap_sidecar_alloc *= 2;
+        tmap = realloc(tmap, sizeof(*tmap) + info->tmap_sidecar_alloc * sizeof(struct jls_utc_summary_entry_s));
+        if (NULL == tmap) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        info->tmap_sidecar = tmap;
+    }
+    tmap->entries[tmap->header.entry_count].sample_id = sample_id;
+    tmap->entries[tmap->header.entry_count].timestamp = utc;
+    ++tmap->header.entry_count;
+    return 0;
+}
+
+int32_t jls_core_wr_tmap(struct jls_core_s * self) {
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        struct jls_utc_tmap_s * tmap = self->signal_info[signal_id].tmap_sidecar;
+        if ((NULL == tmap) || (0 == tmap->header.entry_count)) {
+            continue;
+        }
+        struct jls_core_chunk_s chunk;
+        chunk.hdr.item_next = 0;
+        chunk.hdr.item_prev = 0;
+        chunk.hdr.tag = JLS_TAG_UTC_TMAP;
+        chunk.hdr.compression = JLS_COMPRESSION_NONE;
+        chunk.hdr.chunk_meta = signal_id;
+        chunk.hdr.payload_length = (uint32_t) (sizeof(*tmap)
+                + tmap->header.entry_count * sizeof(struct jls_utc_summary_entry_s));
+        chunk.offset = jls_raw_chunk_tell(self->raw);
+        ROE(jls_raw_wr(self->raw, &chunk.hdr, (const uint8_t *) tmap));
+    }
+    return 0;
+}
+
+static int32_t core_wr_directory_tag(struct jls_core_s * self, uint8_t tag) {
+    struct jls_buf_s * buf = self->buf;
+    uint16_t source_count = 0;
+    uint16_t signal_count = 0;
+    for (uint16_t i = 0; i < JLS_SOURCE_COUNT; ++i) {
+        if (self->source_info[i].source_def.source_id == i) {
+            ++source_count;
+        }
+    }
+    for (uint16_t i = 0; i < JLS_SIGNAL_COUNT; ++i) {
+        if (self->signal_info[i].signal_def.signal_id == i) {
+            ++signal_count;
+        }
+    }
+
+    jls_buf_reset(buf);
+    ROE(jls_buf_wr_u8(buf, 1));  // version
+    ROE(jls_buf_wr_u8(buf, 0));
+    ROE(jls_buf_wr_u16(buf, source_count));
+    ROE(jls_buf_wr_u16(buf, signal_count));
+    ROE(jls_buf_wr_u16(buf, 0));
+    ROE(jls_buf_wr_i64(buf, self->user_data_first.offset));
+    ROE(jls_buf_wr_bin(buf, &self->user_data_first.hdr, sizeof(self->user_data_first.hdr)));
+
+    for (uint16_t i = 0; i < JLS_SOURCE_COUNT; ++i) {
+        struct jls_core_source_s * info = &self->source_info[i];
+        if (info->source_def.source_id != i) {
+            continue;
+        }
+        ROE(jls_buf_wr_u16(buf, i));
+        ROE(jls_buf_wr_i64(buf, info->chunk_def.offset));
+        ROE(jls_buf_wr_bin(buf, &info->chunk_def.hdr, sizeof(info->chunk_def.hdr)));
+        ROE(jls_buf_wr_str(buf, info->source_def.name));
+        ROE(jls_buf_wr_str(buf, info->source_def.vendor));
+        ROE(jls_buf_wr_str(buf, info->source_def.model));
+        ROE(jls_buf_wr_str(buf, info->source_def.version));
+        ROE(jls_buf_wr_str(buf, info->source_def.serial_number));
+    }
+
+    for (uint16_t i = 0; i < JLS_SIGNAL_COUNT; ++i) {
+        struct jls_core_signal_s * info = &self->signal_info[i];
+        struct jls_signal_def_s * s = &info->signal_def;
+        if (s->signal_id != i) {
+            continue;
+        }
+        ROE(jls_buf_wr_u16(buf, i));
+        ROE(jls_buf_wr_i64(buf, info->chunk_def.offset));
+        ROE(jls_buf_wr_bin(buf, &info->chunk_def.hdr, sizeof(info->chunk_def.hdr)));
+        ROE(jls_buf_wr_u16(buf, s->source_id));
+        ROE(jls_buf_wr_u8(buf, s->signal_type));
+        ROE(jls_buf_wr_u8(buf, s->data_encoding));
+        ROE(jls_buf_wr_u32(buf, s->data_type));
+        ROE(jls_buf_wr_u32(buf, s->sample_rate));
+        ROE(jls_buf_wr_u32(buf, s->samples_per_data));
+        ROE(jls_buf_wr_u32(buf, s->sample_decimate_factor));
+        ROE(jls_buf_wr_u32(buf, s->entries_per_summary));
+        ROE(jls_buf_wr_u32(buf, s->summary_decimate_factor));
+        ROE(jls_buf_wr_u32(buf, s->annotation_decimate_factor));
+        ROE(jls_buf_wr_u32(buf, s->utc_decimate_factor));
+        ROE(jls_buf_wr_i64(buf, s->sample_id_offset));
+        ROE(jls_buf_wr_str(buf, s->name));
+        ROE(jls_buf_wr_str(buf, s->units));
+        for (uint8_t track_type = 0; track_type < JLS_TRACK_TYPE_COUNT; ++track_type) {
+            struct jls_core_track_s * track = &info->tracks[track_type];
+            ROE(jls_buf_wr_i64(buf, track->head.offset));
+            if (!track->head.offset) {
+                continue;
+            }
+            ROE(jls_buf_wr_bin(buf, &track->head.hdr, sizeof(track->head.hdr)));
+            ROE(jls_buf_wr_bin(buf, track->head_offsets, sizeof(track->head_offsets)));
+        }
+    }
+
+    struct jls_core_chunk_s chunk;
+    chunk.hdr.item_next = 0;
+    chunk.hdr.item_prev = 0;
+    chunk.hdr.tag = tag;
+    chunk.hdr.compression = JLS_COMPRESSION_NONE;
+    chunk.hdr.chunk_meta = 0;
+    chunk.hdr.payload_length = (uint32_t) jls_buf_length(buf);
+    chunk.offset = jls_raw_chunk_tell(self->raw);
+    return jls_raw_wr(self->raw, &chunk.hdr, buf->start);
 }
 
-int32_t jls_core_wr_summary(struct jls_core_s * self, uint16_t signal_id, enum jls_track_type_e track_type, uint8_t level,
-                            const uint8_t * payload, uint32_t payload_length) {
-    ROE(jls_core_signal_validate(self, signal_id));
-    struct jls_core_signal_s * info = &self->signal_info[signal_id];
-    struct jls_core_track_s * track = &info->tracks[track_type];
-    struct jls_core_chunk_s chunk;
+int32_t jls_core_wr_directory(struct jls_core_s * self) {
+    return core_wr_directory_tag(self, JLS_TAG_DIRECTORY);
+}
 
-    chunk.hdr.item_next = 0;  // update later
-    chunk.hdr.item_prev = track->summary_head[level].offset;
-    chunk.hdr.tag = jls_track_tag_pack(track_type, JLS_TRACK_CHUNK_SUMMARY);
-    chunk.hdr.rsv0_u8 = 0;
-    chunk.hdr.chunk_meta = signal_id | (((uint16_t) level) << 12);
-    chunk.hdr.payload_length = payload_length;
-    chunk.offset = jls_raw_chunk_tell(self->raw);
+int32_t jls_core_wr_checkpoint(struct jls_core_s * self) {
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        struct jls_core_signal_s * info = &self->signal_info[signal_id];
+        if (NULL != info->track_fsr) {
+            // normally copied at close for the footer directory
+            info->signal_def.sample_id_offset = info->track_fsr->sample_id_offset;
+        }
+    }
+    return core_wr_directory_tag(self, JLS_TAG_CHECKPOINT);
+}
 
-    // write
-    if (JLS_LOG_CHECK_STATIC(JLS_LOG_LEVEL_DEBUG3)) {
-        struct jls_payload_header_s * hdr = (struct jls_payload_header_s *) payload;
-                JLS_LOGD3("wr_summary(signal_id=%d, level=%d, timestamp=%" PRIi64 ", entries=%" PRIu32
-                                  ") => offset=%" PRIi64,
-                          (int) signal_id, (int) level,
-                          hdr->timestamp, hdr->entry_count,
-                          jls_raw_chunk_tell(self->raw));
+int32_t jls_core_checkpoint_process(struct jls_core_s * self) {
+    if (0 == self->checkpoint_interval) {
+        return 0;
     }
-    ROE(jls_raw_wr(self->raw, &chunk.hdr, payload));
-    ROE(jls_core_update_item_head(self, &track->summary_head[level], &chunk));
+    int64_t pos = jls_raw_chunk_tell(self->raw);
+    if (pos < self->checkpoint_next) {
+        return 0;
+    }
+    ROE(jls_core_wr_checkpoint(self));
+    self->checkpoint_next = jls_raw_chunk_tell(self->raw) + (int64_t) self->checkpoint_interval;
     return 0;
 }
 
-int32_t jls_core_wr_index(struct jls_core_s * self, uint16_t signal_id, enum jls_track_type_e track_type, uint8_t level,
-                          const uint8_t * payload, uint32_t payload_length) {
-    ROE(jls_core_signal_validate(self, signal_id));
-    struct jls_core_signal_s * info = &self->signal_info[signal_id];
-    struct jls_core_track_s * track = &info->tracks[track_type];
-    struct jls_core_chunk_s chunk;
-
-    chunk.hdr.item_next = 0;  // update later
-    chunk.hdr.item_prev = track->index_head[level].offset;
-    chunk.hdr.tag = jls_track_tag_pack(track_type, JLS_TRACK_CHUNK_INDEX);
-    chunk.hdr.rsv0_u8 = 0;
-    chunk.hdr.chunk_meta = signal_id | (((uint16_t) level) << 12);;
-    chunk.hdr.payload_length = payload_length;
-    chunk.offset = jls_raw_chunk_tell(self->raw);
-
-    // write
-    if (JLS_LOG_CHECK_STATIC(JLS_LOG_LEVEL_DEBUG3)) {
-        struct jls_payload_header_s * hdr = (struct jls_payload_header_s *) payload;
-                JLS_LOGD3("wr_index(signal_id=%d, level=%d, timestamp=%" PRIi64 ", entries=%" PRIu32
-                                  ") => offset=%" PRIi64,
-                          (int) signal_id, (int) level,
-                          hdr->timestamp, hdr->entry_count,
-                          jls_raw_chunk_tell(self->raw));
+int32_t jls_core_rd_checkpoint(struct jls_core_s * self) {
+    while (1) {
+        if (jls_raw_chunk_prev(self->raw)) {
+            return 0;  // reached the file start without a checkpoint
+        }
+        int64_t offset = jls_raw_chunk_tell(self->raw);
+        struct jls_chunk_header_s hdr;
+        if (jls_raw_rd_header(self->raw, &hdr)) {
+            return 0;
+        }
+        if (JLS_TAG_CHECKPOINT == hdr.tag) {
+            ROE(jls_raw_chunk_seek(self->raw, offset));
+            ROE(jls_core_rd_chunk(self));
+            uint8_t dir_en = self->dir_en;
+            int32_t rc = core_rd_directory(self);
+            // the checkpoint only seeds repair; it is not the footer directory
+            self->dir_en = dir_en;
+            if (rc) {
+                JLS_LOGW("invalid checkpoint chunk at %" PRIi64 " - ignore", offset);
+                return 0;
+            }
+            JLS_LOGI("checkpoint at %" PRIi64 " bounds the repair", offset);
+            return 0;
+        }
+        ROE(jls_raw_chunk_seek(self->raw, offset));
     }
-    ROE(jls_raw_wr(self->raw, &chunk.hdr, payload));
-    ROE(jls_core_update_item_head(self, &track->index_head[level], &chunk));
-    ROE(jls_track_update(track, level, chunk.offset));
+}
 
-    return 0;
+void jls_core_tmap_sidecar_free(struct jls_core_s * self) {
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        struct jls_core_signal_s * info = &self->signal_info[signal_id];
+        if (NULL != info->tmap_sidecar) {
+            free(info->tmap_sidecar);
+            info->tmap_sidecar = NULL;
+        }
+        info->tmap_sidecar_alloc = 0;
+    }
 }
 
 int32_t jls_core_wr_end(struct jls_core_s * self) {
@@ -431,7 +1554,7 @@ int32_t jls_core_wr_end(struct jls_core_s * self) {
     chunk.hdr.item_next = 0;
     chunk.hdr.item_prev = 0;
     chunk.hdr.tag = JLS_TAG_END;
-    chunk.hdr.rsv0_u8 = 0;
+    chunk.hdr.compression = JLS_COMPRESSION_NONE;
     chunk.hdr.chunk_meta = 0;
     chunk.hdr.payload_length = 0;
     chunk.offset = jls_raw_chunk_tell(self->raw);
@@ -441,17 +1564,150 @@ int32_t jls_core_wr_end(struct jls_core_s * self) {
     return 0;
 }
 
+static inline int64_t chunk_next_offset(const struct jls_core_chunk_s * chunk) {
+    // payload on disk is payload + crc32, padded to the 8-byte header alignment
+    int64_t sz = 0;
+    if (chunk->hdr.payload_length) {
+        sz = (chunk->hdr.payload_length + 4 + 7) & ~((int64_t) 7);
+    }
+    return chunk->offset + (int64_t) sizeof(struct jls_chunk_header_s) + sz;
+}
+
+// progress callback cadence, see jls_rd_progress_register()
+#define PROGRESS_INTERVAL_BYTES (1 << 20)
+
+static int32_t core_progress_update(struct jls_core_s * self) {
+    const int64_t sz = (int64_t) sizeof(struct jls_chunk_header_s) + self->chunk_cur.hdr.payload_length;
+    self->progress_chunks += 1;
+    self->progress_bytes += sz;
+    if (self->cancel) {
+        self->cancel = 0;  // the token is consumed by the operation it stops
+        return JLS_ERROR_ABORTED;
+    }
+    if (self->budget_bytes) {  // see jls_rd_budget()
+        if (self->budget_bytes < 0) {
+            return JLS_ERROR_BUDGET;
+        }
+        self->budget_bytes -= sz;
+        if (self->budget_bytes <= 0) {
+            self->budget_bytes = -1;  // exhausted until the caller tops up
+            return JLS_ERROR_BUDGET;
+        }
+    }
+    if ((NULL != self->progress_fn) && (self->progress_bytes >= self->progress_bytes_next)) {
+        self->progress_bytes_next = self->progress_bytes + PROGRESS_INTERVAL_BYTES;
+        if (self->progress_fn(self->progress_user_data, self->progress_phase,
+                              self->progress_bytes, self->progress_chunks)) {
+            return JLS_ERROR_ABORTED;
+        }
+    }
+    return 0;
+}
+
+// guard the private cache when a prefetch worker shares it, see jls_rd_prefetch()
+static inline void cache_lock(struct jls_core_s * self) {
+    if (NULL != self->cache_mutex) {
+        jls_bkm_lock(self->cache_mutex);
+    }
+}
+
+static inline void cache_unlock(struct jls_core_s * self) {
+    if (NULL != self->cache_mutex) {
+        jls_bkm_unlock(self->cache_mutex);
+    }
+}
+
 int32_t jls_core_rd_chunk(struct jls_core_s * self) {
+    self->chunk_cur.offset = jls_raw_chunk_tell(self->raw);
+    if (NULL != self->cache) {
+        const uint8_t * payload = NULL;
+        int32_t rc = JLS_ERROR_NOT_FOUND;
+        cache_lock(self);
+        if (0 == jls_chunk_cache_get(self->cache, self->chunk_cur.offset, &self->chunk_cur.hdr, &payload)) {
+            self->cache_hits += 1;
+            rc = 0;
+            if (self->chunk_cur.hdr.payload_length > self->buf->alloc_size) {
+                rc = jls_buf_realloc(self->buf, self->chunk_cur.hdr.payload_length);
+            }
+            if (0 == rc) {
+                // copy while holding the lock: the entry may be evicted after
+                memcpy(self->buf->start, payload, self->chunk_cur.hdr.payload_length);
+            }
+        } else {
+            self->cache_misses += 1;
+        }
+        cache_unlock(self);
+        if (0 == rc) {
+            jls_core_link_table_patch(self, self->chunk_cur.offset, &self->chunk_cur.hdr);
+            self->buf->cur = self->buf->start;
+            self->buf->length = self->chunk_cur.hdr.payload_length;
+            self->buf->end = self->buf->start + self->buf->length;
+            ROE(core_progress_update(self));
+            // advance past this chunk, as jls_raw_rd() would
+            return jls_raw_chunk_seek(self->raw, chunk_next_offset(&self->chunk_cur));
+        } else if (JLS_ERROR_NOT_FOUND != rc) {
+            return rc;
+        }
+    }
+    if (NULL != self->shared_cache) {
+        // co-resident readers share validated payloads, see jls_rd_cache_shared()
+        int32_t src = jls_shared_cache_get(self->shared_cache, self->shared_cache_file_id,
+                                           self->chunk_cur.offset, &self->chunk_cur.hdr,
+                                           self->buf->start, (uint32_t) self->buf->alloc_size);
+        if (JLS_ERROR_TOO_BIG == src) {
+            if (0 == jls_buf_realloc(self->buf, self->chunk_cur.hdr.payload_length)) {
+                src = jls_shared_cache_get(self->shared_cache, self->shared_cache_file_id,
+                                           self->chunk_cur.offset, &self->chunk_cur.hdr,
+                                           self->buf->start, (uint32_t) self->buf->alloc_size);
+            }
+        }
+        if (0 == src) {
+            jls_core_link_table_patch(self, self->chunk_cur.offset, &self->chunk_cur.hdr);
+            self->buf->cur = self->buf->start;
+            self->buf->length = self->chunk_cur.hdr.payload_length;
+            self->buf->end = self->buf->start + self->buf->length;
+            if (NULL != self->cache) {
+                cache_lock(self);
+                jls_chunk_cache_put(self->cache, self->chunk_cur.offset,
+                                    &self->chunk_cur.hdr, self->buf->start);
+                cache_unlock(self);
+            }
+            ROE(core_progress_update(self));
+            // advance past this chunk, as jls_raw_rd() would
+            return jls_raw_chunk_seek(self->raw, chunk_next_offset(&self->chunk_cur));
+        }
+    }
     while (1) {
         self->chunk_cur.offset = jls_raw_chunk_tell(self->raw);
         int32_t rc = jls_raw_rd(self->raw, &self->chunk_cur.hdr, (uint32_t) self->buf->alloc_size, self->buf->start);
         if (rc == JLS_ERROR_TOO_BIG) {
-            ROE(jls_buf_realloc(self->buf, self->chunk_cur.hdr.payload_length));
+            ROE(jls_buf_realloc(self->buf, jls_raw_payload_decoded_length(self->raw)));
         } else if (rc == 0) {
+            if (self->chunk_cur.hdr.tag == JLS_TAG_PADDING) {
+                continue;  // alignment filler, see JLS_CHUNK_ALIGN
+            }
+            jls_core_link_table_patch(self, self->chunk_cur.offset, &self->chunk_cur.hdr);
             self->buf->cur = self->buf->start;
-            self->buf->length = self->chunk_cur.hdr.payload_length;
+            self->buf->length = jls_raw_payload_decoded_length(self->raw);
             self->buf->end = self->buf->start + self->buf->length;
-            return 0;
+            if (self->chunk_cur.hdr.tag == JLS_TAG_TRACK_FSR_DATA) {
+                ROE(jls_delta_buf_decode(self->buf));
+            }
+            if (self->buf->length == self->chunk_cur.hdr.payload_length) {
+                // cache the pristine payload before any in-place modification
+                // (the cache entry size is the on-disk payload_length, so
+                //  decompressed and delta-decoded payloads are not cached)
+                if (NULL != self->cache) {
+                    cache_lock(self);
+                    jls_chunk_cache_put(self->cache, self->chunk_cur.offset, &self->chunk_cur.hdr, self->buf->start);
+                    cache_unlock(self);
+                }
+                if (NULL != self->shared_cache) {
+                    jls_shared_cache_put(self->shared_cache, self->shared_cache_file_id,
+                                         self->chunk_cur.offset, &self->chunk_cur.hdr, self->buf->start);
+                }
+            }
+            return core_progress_update(self);
         } else {
             return rc;
         }
@@ -542,7 +1798,7 @@ static int32_t handle_signal_def(struct jls_core_s * self) {
     struct jls_signal_def_s *s = &signal_info->signal_def;
     ROE(jls_buf_rd_u16(self->buf, &s->source_id));
     ROE(jls_buf_rd_u8(self->buf, &s->signal_type));
-    ROE(jls_buf_rd_skip(self->buf, 1));
+    ROE(jls_buf_rd_u8(self->buf, &s->data_encoding));
     ROE(jls_buf_rd_u32(self->buf, &s->data_type));
     ROE(jls_buf_rd_u32(self->buf, &s->sample_rate));
     ROE(jls_buf_rd_u32(self->buf, &s->samples_per_data));
@@ -732,6 +1988,18 @@ int32_t jls_core_fsr_seek(struct jls_core_s * self, uint16_t signal_id, uint8_t
         JLS_LOGW("fsr_seek not support for signal type %d", (int) signal_def->signal_type);
         return JLS_ERROR_NOT_SUPPORTED;
     }
+
+    struct jls_fsr_seek_index_s * seek_index = self->signal_info[signal_id].seek_index;
+    if ((1 == level) && (NULL != seek_index) && seek_index->header.entry_count) {
+        // O(1) seek: each entry is a level-1 index chunk with fixed sample spacing
+        int64_t step_size = (int64_t) signal_def->sample_decimate_factor * signal_def->entries_per_summary;
+        int64_t idx = (sample_id - seek_index->header.timestamp) / step_size;
+        if ((idx >= 0) && (idx < (int64_t) seek_index->header.entry_count)) {
+            return jls_raw_chunk_seek(self->raw, (int64_t) seek_index->offsets[idx]);
+        }
+        // out of range, fall back to the summary hierarchy walk
+    }
+
     int64_t offset = 0;
     int64_t * offsets = self->signal_info[signal_id].tracks[JLS_TRACK_TYPE_FSR].head_offsets;
     int initial_level = JLS_SUMMARY_LEVEL_COUNT - 1;
@@ -857,6 +2125,314 @@ int32_t jls_core_fsr_length(struct jls_core_s * self, uint16_t signal_id, int64_
     return 0;
 }
 
+// Update the signal length from the level 0 FSR data chunk in chunk_cur.
+static void follow_data_length(struct jls_core_s * self) {
+    uint16_t signal_id = self->chunk_cur.hdr.chunk_meta & SIGNAL_MASK;
+    if (signal_id >= JLS_SIGNAL_COUNT) {
+        return;
+    }
+    struct jls_core_signal_s * signal_info = &self->signal_info[signal_id];
+    if ((signal_info->signal_def.signal_id != signal_id) || (NULL == signal_info->track_fsr)) {
+        return;  // signal defined after open: skip
+    }
+    struct jls_fsr_data_s * d = (struct jls_fsr_data_s *) self->buf->start;
+    struct jls_core_track_s * track = &signal_info->tracks[JLS_TRACK_TYPE_FSR];
+    if (!track->head_offsets[0]) {
+        // first data for this signal since open
+        track->head_offsets[0] = self->chunk_cur.offset;
+        signal_info->signal_def.sample_id_offset = d->header.timestamp;
+    }
+    int64_t length = d->header.timestamp + d->header.entry_count
+            - signal_info->signal_def.sample_id_offset;
+    if (length > signal_info->track_fsr->signal_length) {
+        signal_info->track_fsr->signal_length = length;
+    }
+}
+
+// Append a tail data chunk to the synthetic level-1 index.
+static int32_t follow_index_append(struct jls_core_s * self, uint16_t signal_id,
+                                   int64_t timestamp, int64_t offset) {
+    struct jls_core_signal_s * info = &self->signal_info[signal_id];
+    struct jls_fsr_index_s * idx = info->follow_index;
+    if ((NULL != idx) && idx->header.entry_count) {
+        int64_t expect = idx->header.timestamp
+                + (int64_t) idx->header.entry_count * info->signal_def.samples_per_data;
+        if (timestamp != expect) {
+            idx->header.entry_count = 0;  // sample skip: restart the index at this chunk
+        }
+    }
+    if (NULL == idx) {
+        info->follow_index_alloc = 256;
+        idx = malloc(sizeof(*idx) + info->follow_index_alloc * sizeof(uint64_t));
+        if (NULL == idx) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        idx->header.entry_count = 0;
+        idx->header.entry_size_bits = sizeof(uint64_t) * 8;
+        idx->header.rsv16 = 0;
+        info->follow_index = idx;
+    } else if (idx->header.entry_count >= info->follow_index_alloc) {
+        info->follow_index_alloc *= 2;
+        idx = realloc(idx, sizeof(*idx) + info->follow_index_alloc * sizeof(uint64_t));
+        if (NULL == idx) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        info->follow_index = idx;
+    }
+    if (0 == idx->header.entry_count) {
+        idx->header.timestamp = timestamp;
+    }
+    idx->offsets[idx->header.entry_count++] = (uint64_t) offset;
+    return 0;
+}
+
+// Drop synthetic index entries now covered by an on-disk level-1 index chunk.
+static void follow_index_trim(struct jls_core_signal_s * info, int64_t end_timestamp) {
+    struct jls_fsr_index_s * idx = info->follow_index;
+    if ((NULL == idx) || (0 == idx->header.entry_count)) {
+        return;
+    }
+    int64_t spd = info->signal_def.samples_per_data;
+    int64_t n = (end_timestamp - idx->header.timestamp) / spd;
+    if (n <= 0) {
+        return;
+    }
+    if (n >= (int64_t) idx->header.entry_count) {
+        idx->header.entry_count = 0;
+        return;
+    }
+    memmove(&idx->offsets[0], &idx->offsets[n],
+            (idx->header.entry_count - n) * sizeof(uint64_t));
+    idx->header.timestamp += n * spd;
+    idx->header.entry_count -= (uint32_t) n;
+}
+
+bool jls_core_follow_index_load(struct jls_core_s * self, uint16_t signal_id, int64_t sample_id) {
+    struct jls_core_signal_s * info = &self->signal_info[signal_id];
+    struct jls_fsr_index_s * idx = info->follow_index;
+    if (!self->follow_en || (NULL == idx) || (0 == idx->header.entry_count)) {
+        return false;
+    }
+    int64_t spd = info->signal_def.samples_per_data;
+    int64_t end = idx->header.timestamp + (int64_t) idx->header.entry_count * spd;
+    if ((sample_id < idx->header.timestamp) || (sample_id >= end)) {
+        return false;
+    }
+    size_t sz = sizeof(*idx) + idx->header.entry_count * sizeof(uint64_t);
+    if (jls_buf_realloc(self->rd_index, sz)
+            || jls_buf_realloc(self->rd_summary, sizeof(struct jls_payload_header_s))) {
+        return false;
+    }
+    memcpy(self->rd_index->start, idx, sz);
+    self->rd_index->length = sz;
+    memset(&self->rd_index_chunk, 0, sizeof(self->rd_index_chunk));
+    self->rd_index_chunk.offset = (int64_t) idx->offsets[0];
+    self->rd_index_chunk.hdr.tag = JLS_TAG_TRACK_FSR_INDEX;
+    self->rd_index_chunk.hdr.chunk_meta = (1 << 12) | (signal_id & 0x00ff);
+    self->rd_index_chunk.hdr.payload_length = (uint32_t) sz;
+
+    // no summary exists yet for the tail: empty, so omitted-chunk
+    // reconstruction degrades instead of reading stale entries
+    struct jls_payload_header_s * s = (struct jls_payload_header_s *) self->rd_summary->start;
+    s->timestamp = idx->header.timestamp;
+    s->entry_count = 0;
+    s->entry_size_bits = 4 * sizeof(float) * 8;
+    s->rsv16 = 0;
+    self->rd_summary->length = sizeof(*s);
+    self->rd_summary_chunk = self->rd_index_chunk;
+    return true;
+}
+
+int32_t jls_core_follow_init(struct jls_core_s * self, int64_t end_offset) {
+    int32_t rc = 0;
+    self->follow_en = 1;
+    ROE(jls_raw_chunk_seek(self->raw, end_offset));
+    ROE(jls_core_rd_chunk(self));
+    self->follow_pos = chunk_next_offset(&self->chunk_cur);
+
+    // one-time header walk: build the level-1 seek index, which only
+    // persists as a sidecar on close, and find the data chunks not yet
+    // covered by an on-disk index chunk.
+    int64_t * pending[JLS_SIGNAL_COUNT];
+    uint32_t pending_alloc[JLS_SIGNAL_COUNT];
+    uint32_t pending_count[JLS_SIGNAL_COUNT];
+    int64_t index_end[JLS_SIGNAL_COUNT];  // sample end of the last on-disk level-1 index
+    memset(pending, 0, sizeof(pending));
+    memset(pending_alloc, 0, sizeof(pending_alloc));
+    memset(pending_count, 0, sizeof(pending_count));
+    memset(index_end, 0, sizeof(index_end));
+
+    int64_t offset = sizeof(struct jls_file_header_s);
+    struct jls_chunk_header_s hdr;
+    while (offset <= end_offset) {
+        if (jls_raw_chunk_seek(self->raw, offset) || jls_raw_rd_header(self->raw, &hdr)) {
+            break;
+        }
+        uint16_t signal_id = hdr.chunk_meta & SIGNAL_MASK;
+        uint8_t level = (uint8_t) (hdr.chunk_meta >> 12);
+        bool is_fsr = (signal_id < JLS_SIGNAL_COUNT)
+                && (self->signal_info[signal_id].signal_def.signal_id == signal_id)
+                && (NULL != self->signal_info[signal_id].track_fsr);
+        if (is_fsr && (JLS_TAG_TRACK_FSR_DATA == hdr.tag)) {
+            if (pending_count[signal_id] >= pending_alloc[signal_id]) {
+                uint32_t alloc = pending_alloc[signal_id] ? (pending_alloc[signal_id] * 2) : 256;
+                int64_t * p = realloc(pending[signal_id], alloc * sizeof(int64_t));
+                if (NULL == p) {
+                    rc = JLS_ERROR_NOT_ENOUGH_MEMORY;
+                    goto cleanup;
+                }
+                pending[signal_id] = p;
+                pending_alloc[signal_id] = alloc;
+            }
+            pending[signal_id][pending_count[signal_id]++] = offset;
+        } else if (is_fsr && (JLS_TAG_TRACK_FSR_INDEX == hdr.tag) && (1 == level)) {
+            if (jls_raw_chunk_seek(self->raw, offset) || jls_core_rd_chunk(self)) {
+                break;
+            }
+            struct jls_payload_header_s * ph = (struct jls_payload_header_s *) self->buf->start;
+            rc = jls_core_seek_index_append(self, signal_id, ph->timestamp, offset);
+            if (rc) {
+                goto cleanup;
+            }
+            // the writer emits the index right after the data chunk that
+            // completes its block, so all pending data chunks are covered
+            pending_count[signal_id] = 0;
+            index_end[signal_id] = ph->timestamp
+                    + (int64_t) ph->entry_count * self->signal_info[signal_id].signal_def.samples_per_data;
+        }
+        struct jls_core_chunk_s chunk = {.hdr = hdr, .offset = offset};
+        int64_t next = chunk_next_offset(&chunk);
+        if (next <= offset) {
+            break;
+        }
+        offset = next;
+    }
+
+    // read the uncovered tail data chunks: synthetic index + signal length
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        struct jls_core_signal_s * signal_info = &self->signal_info[signal_id];
+        if (index_end[signal_id] && (NULL != signal_info->track_fsr)) {
+            // live files hold only full data chunks, so the index end is exact
+            int64_t length = index_end[signal_id] - signal_info->signal_def.sample_id_offset;
+            if (length > signal_info->track_fsr->signal_length) {
+                signal_info->track_fsr->signal_length = length;
+            }
+        }
+        for (uint32_t k = 0; k < pending_count[signal_id]; ++k) {
+            if (jls_raw_chunk_seek(self->raw, pending[signal_id][k])
+                    || jls_core_rd_chunk(self)) {
+                break;
+            }
+            struct jls_payload_header_s * ph = (struct jls_payload_header_s *) self->buf->start;
+            rc = follow_index_append(self, signal_id, ph->timestamp, pending[signal_id][k]);
+            if (rc) {
+                goto cleanup;
+            }
+            follow_data_length(self);
+        }
+    }
+    rc = 0;
+
+cleanup:
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        free(pending[signal_id]);
+    }
+    return rc;
+}
+
+int32_t jls_core_follow_refresh(struct jls_core_s * self) {
+    if (!self->follow_en) {
+        return 0;
+    }
+    struct jls_bkf_s * backend = jls_raw_backend(self->raw);
+    ROE(jls_bk_fseek(backend, 0, SEEK_END));
+    if (backend->fpos > backend->fend) {
+        backend->fend = backend->fpos;
+    }
+    if ((self->follow_pos + (int64_t) sizeof(struct jls_chunk_header_s)) > backend->fend) {
+        return 0;  // nothing new
+    }
+
+    // the track head chunks rewrite in place as new summary levels appear,
+    // so re-read them directly, bypassing the chunk cache
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        struct jls_core_signal_s * signal_info = &self->signal_info[signal_id];
+        if ((signal_info->signal_def.signal_id != signal_id)
+                || (NULL == signal_info->track_fsr)) {
+            continue;
+        }
+        struct jls_core_track_s * track = &signal_info->tracks[JLS_TRACK_TYPE_FSR];
+        if (!track->head.offset) {
+            continue;
+        }
+        struct jls_chunk_header_s hdr;
+        uint8_t buf[JLS_SUMMARY_LEVEL_COUNT * sizeof(int64_t) + 16];  // payload + footer
+        if (jls_raw_chunk_seek(self->raw, track->head.offset)
+                || jls_raw_rd(self->raw, &hdr, sizeof(buf), buf)) {
+            continue;
+        }
+        if ((hdr.tag == track->head.hdr.tag)
+                && (hdr.payload_length == (JLS_SUMMARY_LEVEL_COUNT * sizeof(int64_t)))) {
+            track->head.hdr = hdr;
+            memcpy(track->head_offsets, buf, JLS_SUMMARY_LEVEL_COUNT * sizeof(int64_t));
+        }
+    }
+
+    // scan the appended tail; quiet header validation first so a chunk
+    // still being written does not log integrity errors every refresh
+    while ((self->follow_pos + (int64_t) sizeof(struct jls_chunk_header_s)) <= backend->fend) {
+        struct jls_chunk_header_s hdr;
+        if (jls_bk_fseek(backend, self->follow_pos, SEEK_SET)
+                || jls_bk_fread(backend, (uint8_t *) &hdr, sizeof(hdr))
+                || (jls_crc32c_hdr(&hdr) != hdr.crc32)) {
+            break;
+        }
+        struct jls_core_chunk_s chunk = {.hdr = hdr, .offset = self->follow_pos};
+        if (chunk_next_offset(&chunk) > backend->fend) {
+            break;  // payload still being written
+        }
+        if (jls_raw_chunk_seek(self->raw, self->follow_pos) || jls_core_rd_chunk(self)) {
+            break;
+        }
+        uint16_t signal_id = self->chunk_cur.hdr.chunk_meta & SIGNAL_MASK;
+        uint8_t level = (uint8_t) (self->chunk_cur.hdr.chunk_meta >> 12);
+        bool is_fsr = (signal_id < JLS_SIGNAL_COUNT)
+                && (self->signal_info[signal_id].signal_def.signal_id == signal_id)
+                && (NULL != self->signal_info[signal_id].track_fsr);
+        if (is_fsr && (JLS_TAG_TRACK_FSR_DATA == self->chunk_cur.hdr.tag)) {
+            struct jls_payload_header_s * ph = (struct jls_payload_header_s *) self->buf->start;
+            ROE(follow_index_append(self, signal_id, ph->timestamp, self->follow_pos));
+            follow_data_length(self);
+        } else if (is_fsr && (JLS_TAG_SUMMARY_PREVIEW == self->chunk_cur.hdr.tag)
+                && (level >= 1) && (level < JLS_SUMMARY_LEVEL_COUNT)) {
+            // keep only the most recent preview per signal and level
+            struct jls_core_signal_s * info = &self->signal_info[signal_id];
+            uint32_t sz = (uint32_t) self->buf->length;
+            if (sz < sizeof(struct jls_payload_header_s)) {
+                JLS_LOGW("invalid summary preview chunk at %" PRIi64 " - skip", self->follow_pos);
+            } else {
+                if (sz > info->preview_alloc[level]) {
+                    free(info->preview[level]);
+                    info->preview[level] = malloc(sz);
+                    if (NULL == info->preview[level]) {
+                        info->preview_alloc[level] = 0;
+                        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+                    }
+                    info->preview_alloc[level] = sz;
+                }
+                memcpy(info->preview[level], self->buf->start, sz);
+            }
+        } else if (is_fsr && (JLS_TAG_TRACK_FSR_INDEX == self->chunk_cur.hdr.tag) && (1 == level)) {
+            struct jls_payload_header_s * ph = (struct jls_payload_header_s *) self->buf->start;
+            ROE(jls_core_seek_index_append(self, signal_id, ph->timestamp, self->follow_pos));
+            follow_index_trim(&self->signal_info[signal_id], ph->timestamp
+                    + (int64_t) ph->entry_count * self->signal_info[signal_id].signal_def.samples_per_data);
+        }
+        self->follow_pos = chunk_next_offset(&self->chunk_cur);
+    }
+    return 0;
+}
+
 static void construct_f32(int64_t sample_id, float * y, int64_t count, float mean, float std) {
     for (int64_t i = 0; i < count; i += 2) {
         uint64_t ki = (int64_t) (sample_id + i);
@@ -899,6 +2475,38 @@ static int32_t reconstruct_omitted_chunk(struct jls_core_s * self, uint16_t sign
     int64_t t_index = (start_sample_id - r->header.timestamp) / signal_def->samples_per_data;
     int64_t sample_id = (t_index * signal_def->samples_per_data) + r->header.timestamp;
 
+    // reconstructed chunks have no file offset, so cache under a negative
+    // key derived from (signal, timestamp, mode) that cannot collide with
+    // on-disk chunk offsets
+    int64_t cache_key = -((((sample_id * JLS_SIGNAL_COUNT) + signal_id) * 2 + self->omit_mode) + 1);
+    if (NULL != self->cache) {
+        struct jls_chunk_header_s hdr;
+        const uint8_t * payload = NULL;
+        int32_t rc = JLS_ERROR_NOT_FOUND;
+        cache_lock(self);
+        if (0 == jls_chunk_cache_get(self->cache, cache_key, &hdr, &payload)) {
+            self->cache_hits += 1;
+            rc = 0;
+            if (hdr.payload_length > self->buf->alloc_size) {
+                rc = jls_buf_realloc(self->buf, hdr.payload_length);
+            }
+            if (0 == rc) {
+                memcpy(self->buf->start, payload, hdr.payload_length);
+            }
+        } else {
+            self->cache_misses += 1;
+        }
+        cache_unlock(self);
+        if (0 == rc) {
+            self->buf->cur = self->buf->start;
+            self->buf->length = hdr.payload_length;
+            self->buf->end = self->buf->start + self->buf->length;
+            return 0;
+        } else if (JLS_ERROR_NOT_FOUND != rc) {
+            return rc;
+        }
+    }
+
     struct jls_fsr_f32_summary_s * s32 = (struct jls_fsr_f32_summary_s *) self->rd_summary->start;
     struct jls_fsr_f64_summary_s * s64 = (struct jls_fsr_f64_summary_s *) self->rd_summary->start;
     int64_t s_index = (sample_id - s32->header.timestamp) / signal_def->sample_decimate_factor;
@@ -947,9 +2555,23 @@ static int32_t reconstruct_omitted_chunk(struct jls_core_s * self, uint16_t sign
         }
 
         if (signal_def->data_type == JLS_DATATYPE_F32) {
-            construct_f32(sample_id + k * sz_samples, (float *) d, sz_samples, mu32, std32);
+            if (JLS_RD_OMIT_MODE_MEAN == self->omit_mode) {
+                float * y = (float *) d;
+                for (uint64_t i = 0; i < sz_samples; ++i) {
+                    y[i] = mu32;
+                }
+            } else {
+                construct_f32(sample_id + k * sz_samples, (float *) d, sz_samples, mu32, std32);
+            }
         } else if (signal_def->data_type == JLS_DATATYPE_F64) {
-            construct_f64(sample_id + k * sz_samples, (double *) d, sz_samples, mu64, std64);
+            if (JLS_RD_OMIT_MODE_MEAN == self->omit_mode) {
+                double * y = (double *) d;
+                for (uint64_t i = 0; i < sz_samples; ++i) {
+                    y[i] = mu64;
+                }
+            } else {
+                construct_f64(sample_id + k * sz_samples, (double *) d, sz_samples, mu64, std64);
+            }
         } else if (signal_def->data_type == JLS_DATATYPE_U8) {
             uint8_t value = (uint8_t) roundf(mu32);
             memset(d, value, sz_bytes);
@@ -971,6 +2593,18 @@ static int32_t reconstruct_omitted_chunk(struct jls_core_s * self, uint16_t sign
         ++s_index;
         data->header.entry_count += (uint32_t) sz_samples;
     }
+
+    if (NULL != self->cache) {
+        struct jls_chunk_header_s hdr;
+        memset(&hdr, 0, sizeof(hdr));
+        hdr.tag = JLS_TAG_TRACK_FSR_DATA;
+        hdr.chunk_meta = signal_id;
+        hdr.payload_length = (uint32_t) (sizeof(struct jls_fsr_data_s)
+                + (data->header.entry_count * (uint32_t) sample_size_bits) / 8);
+        cache_lock(self);
+        jls_chunk_cache_put(self->cache, cache_key, &hdr, (const uint8_t *) data);
+        cache_unlock(self);
+    }
     return 0;
 }
 
@@ -992,6 +2626,9 @@ int32_t jls_core_rd_fsr_level1(struct jls_core_s * self, uint16_t signal_id, int
     }
 
     if (0 == self->rd_index_chunk.offset) {
+        if (jls_core_follow_index_load(self, signal_id, start_sample_id)) {
+            return 0;  // tail data not yet covered by an on-disk index
+        }
         ROE(jls_core_fsr_seek(self, signal_id, 1, start_sample_id));
     }
     ROE(jls_core_rd_chunk(self));  // index
@@ -1048,6 +2685,110 @@ int32_t jls_core_rd_fsr_data0(struct jls_core_s * self, uint16_t signal_id, int6
     return 0;
 }
 
+/**
+ * @brief Generate a monomorphic FSR sample copy loop.
+ *
+ * @param name_ The function name.
+ * @param entry_size_bits_ The entry size in bits, normally a constant.
+ *
+ * With a compile-time entry size, the sub-byte shift handling
+ * constant-folds away for byte-aligned data types and compiles with
+ * fixed masks for u1/u4, which matters for digital reads where the
+ * per-sample work is tiny.  fsr_rd_fn_select() binds one variant per
+ * signal, like the data_f64_fn selection in wr_fsr.c.
+ */
+#define FSR_RD_FN(name_, entry_size_bits_)                                                      \
+static int32_t name_(struct jls_core_s * self, uint16_t signal_id, uint8_t * data_u8,           \
+                     int64_t start_sample_id, int64_t data_length,                              \
+                     int64_t * end_sample_id) {                                                 \
+    const uint8_t entry_size_bits = (uint8_t) (entry_size_bits_);                               \
+    int64_t chunk_sample_id;                                                                    \
+    int64_t chunk_sample_count;                                                                 \
+    uint8_t * u8;                                                                               \
+    uint8_t shift_bits = 0;                                                                     \
+    uint8_t shift_carry = 0;                                                                    \
+                                                                                                \
+    while (data_length > 0) {                                                                   \
+        ROE(jls_core_rd_fsr_data0(self, signal_id, start_sample_id));                           \
+                                                                                                \
+        struct jls_fsr_data_s * r = (struct jls_fsr_data_s *) self->buf->start;                 \
+        chunk_sample_id = r->header.timestamp;                                                  \
+        chunk_sample_count = r->header.entry_count;                                             \
+        u8 = (uint8_t *) &r->data[0];                                                           \
+        if (r->header.entry_size_bits != entry_size_bits) {                                     \
+            JLS_LOGE("fsr entry size mismatch");                                                \
+            return JLS_ERROR_UNSPECIFIED;                                                       \
+        }                                                                                       \
+                                                                                                \
+        int64_t sz_samples = chunk_sample_count;                                                \
+        if (start_sample_id > chunk_sample_id) {                                                \
+            /* should only happen on first chunk */                                             \
+            int64_t idx_start = start_sample_id - chunk_sample_id;                              \
+            sz_samples = chunk_sample_count - idx_start;                                        \
+            u8 += ((idx_start * entry_size_bits) / 8);                                          \
+            if (entry_size_bits < 8) {                                                          \
+                shift_bits = (uint8_t) ((start_sample_id * entry_size_bits) & 0x07);            \
+            }                                                                                   \
+            if (shift_bits) {                                                                   \
+                shift_carry = (*u8++) >> shift_bits;                                            \
+                uint8_t rem_bits = (uint8_t) ((start_sample_id + data_length - 1) & 0x07) + 1;  \
+                if ((1 == entry_size_bits) && ((8 - shift_bits + rem_bits) > 8)) {              \
+                    /* write out carry on buffer wrap when carry + end bits exceed a byte */    \
+                    if (data_length > sz_samples) {                                             \
+                        data_length += 8;                                                       \
+                    }                                                                           \
+                } else if ((4 == entry_size_bits) && (sz_samples == 1)) {                       \
+                    data_length -= sz_samples;                                                  \
+                    start_sample_id += sz_samples;                                              \
+                    continue;                                                                   \
+                }                                                                               \
+            }                                                                                   \
+        }                                                                                       \
+                                                                                                \
+        if (sz_samples > data_length) {                                                         \
+            sz_samples = data_length;                                                           \
+        }                                                                                       \
+                                                                                                \
+        size_t sz_bytes = (size_t) (sz_samples * entry_size_bits + 7) / 8;                      \
+        if (shift_bits) {                                                                       \
+            for (size_t i = 0; i < sz_bytes; ++i) {                                             \
+                data_u8[i] = (u8[i] << (8 - shift_bits)) | shift_carry;                         \
+                shift_carry = u8[i] >> shift_bits;                                              \
+            }                                                                                   \
+            sz_bytes = (sz_samples * entry_size_bits) / 8;                                      \
+        } else {                                                                                \
+            memcpy(data_u8, u8, sz_bytes);                                                      \
+        }                                                                                       \
+        data_u8 += sz_bytes;                                                                    \
+        data_length -= sz_samples;                                                              \
+        start_sample_id += sz_samples;                                                          \
+    }                                                                                           \
+    *end_sample_id = start_sample_id;                                                           \
+    return 0;                                                                                   \
+}
+
+FSR_RD_FN(fsr_rd_u1, 1)
+FSR_RD_FN(fsr_rd_u4, 4)
+FSR_RD_FN(fsr_rd_8, 8)
+FSR_RD_FN(fsr_rd_16, 16)
+FSR_RD_FN(fsr_rd_24, 24)
+FSR_RD_FN(fsr_rd_32, 32)
+FSR_RD_FN(fsr_rd_64, 64)
+FSR_RD_FN(fsr_rd_generic, jls_datatype_parse_size(self->signal_info[signal_id].signal_def.data_type))
+
+static jls_core_fsr_rd_fn fsr_rd_fn_select(uint8_t entry_size_bits) {
+    switch (entry_size_bits) {
+        case 1:  return fsr_rd_u1;
+        case 4:  return fsr_rd_u4;
+        case 8:  return fsr_rd_8;
+        case 16: return fsr_rd_16;
+        case 24: return fsr_rd_24;
+        case 32: return fsr_rd_32;
+        case 64: return fsr_rd_64;
+        default: return fsr_rd_generic;
+    }
+}
+
 int32_t jls_core_fsr(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id,
                      void * data, int64_t data_length) {
     // start_sample_id is API zero-based
@@ -1078,69 +2819,32 @@ int32_t jls_core_fsr(struct jls_core_s * self, uint16_t signal_id, int64_t start
 
     //JLS_LOGD3("jls_rd_fsr_f32(%d, %" PRIi64 ")", (int) signal_id, start_sample_id);
     start_sample_id += sample_id_offset;  // file sample_id
-
-    int64_t chunk_sample_id;
-    int64_t chunk_sample_count;
-    uint8_t * u8;
-    uint8_t shift_bits = 0;
-    uint8_t shift_carry = 0;
-
-    while (data_length > 0) {
-        ROE(jls_core_rd_fsr_data0(self, signal_id, start_sample_id));
-
-        struct jls_fsr_data_s * r = (struct jls_fsr_data_s *) self->buf->start;
-        chunk_sample_id = r->header.timestamp;
-        chunk_sample_count = r->header.entry_count;
-        u8 = (uint8_t *) &r->data[0];
-        if (r->header.entry_size_bits != entry_size_bits) {
-            JLS_LOGE("fsr entry size mismatch");
-            return JLS_ERROR_UNSPECIFIED;
-        }
-
-        int64_t sz_samples = chunk_sample_count;
-        if (start_sample_id > chunk_sample_id) {
-            // should only happen on first chunk
-            int64_t idx_start = start_sample_id - chunk_sample_id;
-            sz_samples = chunk_sample_count - idx_start;
-            u8 += ((idx_start * entry_size_bits) / 8);
-            switch (entry_size_bits) {
-                case 1: shift_bits = (uint8_t) (start_sample_id & 0x07); break;
-                case 4: shift_bits = (uint8_t) ((start_sample_id & 0x01) * 4); break;
-                default: break;
-            }
-            if (shift_bits) {
-                shift_carry = (*u8++) >> shift_bits;
-                uint8_t rem_bits = (uint8_t) ((start_sample_id + data_length - 1) & 0x07) + 1;
-                if ((1 == entry_size_bits) && ((8 - shift_bits + rem_bits) > 8)) {
-                    // write out carry on buffer wrap when carry + end bits exceed a byte
-                    if (data_length > sz_samples) {
-                        data_length += 8;
-                    }
-                } else if ((4 == entry_size_bits) && (sz_samples == 1)) {
-                    data_length -= sz_samples;
-                    start_sample_id += sz_samples;
-                    continue;
+    const int64_t read_start_sample_id = start_sample_id;
+
+    jls_core_fsr_rd_fn rd_fn = self->signal_info[signal_id].fsr_rd_fn;
+    if (NULL == rd_fn) {
+        rd_fn = fsr_rd_fn_select(entry_size_bits);
+        self->signal_info[signal_id].fsr_rd_fn = rd_fn;
+    }
+    ROE(rd_fn(self, signal_id, data_u8, start_sample_id, data_length, &start_sample_id));
+
+    // on monotonic sequential scans, hint the OS to read ahead of the next data chunk
+    struct jls_core_fsr_s * fsr = self->signal_info[signal_id].track_fsr;
+    if (NULL != fsr) {
+        if (read_start_sample_id == fsr->rd_next_sample_id) {
+            struct jls_fsr_index_s * idx = (struct jls_fsr_index_s *) self->rd_index->start;
+            int64_t entry = (start_sample_id - idx->header.timestamp) / signal_def->samples_per_data;
+            if ((entry >= 0) && (entry < (int64_t) idx->header.entry_count)) {
+                int64_t offset = (int64_t) idx->offsets[entry];
+                if (offset && (offset != fsr->rd_prefetch_offset)) {
+                    int64_t length = 4 * (((int64_t) signal_def->samples_per_data * entry_size_bits) / 8
+                            + (int64_t) (sizeof(struct jls_chunk_header_s) + sizeof(struct jls_fsr_data_s)));
+                    jls_bk_readahead(jls_raw_backend(self->raw), offset, length);
+                    fsr->rd_prefetch_offset = offset;
                 }
             }
         }
-
-        if (sz_samples > data_length) {
-            sz_samples = data_length;
-        }
-
-        size_t sz_bytes = (size_t) (sz_samples * entry_size_bits + 7) / 8;
-        if (shift_bits) {
-            for (size_t i = 0; i < sz_bytes; ++i) {
-                data_u8[i] = (u8[i] << (8 - shift_bits)) | shift_carry;
-                shift_carry = u8[i] >> shift_bits;
-            }
-            sz_bytes = (sz_samples * entry_size_bits) / 8;
-        } else {
-            memcpy(data_u8, u8, sz_bytes);
-        }
-        data_u8 += sz_bytes;
-        data_length -= sz_samples;
-        start_sample_id += sz_samples;
+        fsr->rd_next_sample_id = start_sample_id;
     }
     return 0;
 }
@@ -1154,6 +2858,15 @@ int32_t jls_core_fsr_f32(struct jls_core_s * self, uint16_t signal_id, int64_t s
     return jls_core_fsr(self, signal_id, start_sample_id, data, data_length);
 }
 
+int32_t jls_core_fsr_f64(struct jls_core_s * self, uint16_t signal_id, int64_t start_sample_id,
+                         double * data, int64_t data_length) {
+    ROE(jls_core_signal_validate_typed(self, signal_id, JLS_SIGNAL_TYPE_FSR));
+    if (self->signal_info[signal_id].signal_def.data_type != JLS_DATATYPE_F64) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    return jls_core_fsr(self, signal_id, start_sample_id, data, data_length);
+}
+
 int32_t jls_core_ts_seek(struct jls_core_s * self, uint16_t signal_id, uint8_t level,
                          enum jls_track_type_e track_type, int64_t timestamp) {
     // timestamp in JLS units with possible non-zero offset
@@ -1258,7 +2971,7 @@ int32_t jls_core_repair_fsr(struct jls_core_s * self, uint16_t signal_id) {
             break;
         }
         index_head = self->chunk_cur;
-        memcpy(lvl->index, self->buf->start, self->chunk_cur.hdr.payload_length);
+        memcpy(lvl->index, self->buf->start, self->buf->length);
 
         if (jls_core_rd_chunk(self)) {  // read summary
             break;
@@ -1266,7 +2979,7 @@ int32_t jls_core_repair_fsr(struct jls_core_s * self, uint16_t signal_id) {
         track->index_head[level] = index_head;
         offset_index_next = index_head.hdr.item_next;
         track->summary_head[level] = self->chunk_cur;
-        memcpy(lvl->summary, self->buf->start, self->chunk_cur.hdr.payload_length);
+        memcpy(lvl->summary, self->buf->start, self->buf->length);
 
         struct jls_fsr_index_s * r = lvl->index;
         if (r->header.entry_size_bits != (sizeof(r->offsets[0]) * 8)) {
@@ -46,9 +46,69 @@
 #elif defined(__linux__) && __linux__
 #if defined(_M_X64) || defined(__x86_64__)
 #include "crc32c_intel_sse4.c"
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+// The toolchain supports the CRC32 instructions, but Linux aarch64
+// distributions run on cores both with and without them.  Compile both
+// implementations and resolve once at first use from the kernel HWCAP
+// bits.  The resolved function pointers are cached so the hot 32-byte
+// header CRCs pay no per-call dispatch logic.
+#include "jls/crc32c.h"
+#include <sys/auxv.h>
+#if defined(__has_include)
+#if __has_include(<asm/hwcap.h>)
+#include <asm/hwcap.h>
+#endif
+#endif
+#ifndef HWCAP_CRC32
+#define HWCAP_CRC32 (1 << 7)
+#endif
+
+#define jls_crc32c_hdr jls_crc32c_hdr_sw
+#define jls_crc32c jls_crc32c_sw
+#include "crc32c_sw.c"
+#undef jls_crc32c_hdr
+#undef jls_crc32c
+
+#define jls_crc32c_hdr jls_crc32c_hdr_hw
+#define jls_crc32c jls_crc32c_hw
+#include "crc32c_arm_neon.c"
+#undef jls_crc32c_hdr
+#undef jls_crc32c
+
+// Lazily resolved; the duplicate-initialization race is benign since
+// every thread resolves to the same pointers and pointer stores are
+// single-copy atomic on aarch64.
+static uint32_t (* volatile crc32c_hdr_fn)(const struct jls_chunk_header_s *);
+static uint32_t (* volatile crc32c_fn)(uint8_t const *, uint32_t);
+
+static void crc32c_resolve(void) {
+    if (getauxval(AT_HWCAP) & HWCAP_CRC32) {
+        crc32c_hdr_fn = jls_crc32c_hdr_hw;
+        crc32c_fn = jls_crc32c_hw;
+    } else {
+        crc32c_hdr_fn = jls_crc32c_hdr_sw;
+        crc32c_fn = jls_crc32c_sw;
+    }
+}
+
+uint32_t jls_crc32c_hdr(const struct jls_chunk_header_s * hdr) {
+    uint32_t (*fn)(const struct jls_chunk_header_s *) = crc32c_hdr_fn;
+    if (!fn) {
+        crc32c_resolve();
+        fn = crc32c_hdr_fn;
+    }
+    return fn(hdr);
+}
+
+uint32_t jls_crc32c(uint8_t const *data, uint32_t length) {
+    uint32_t (*fn)(uint8_t const *, uint32_t) = crc32c_fn;
+    if (!fn) {
+        crc32c_resolve();
+        fn = crc32c_fn;
+    }
+    return fn(data, length);
+}
 #else
-// Raspberry Pi 4 does not support CRC optimization.
-// Other Linux platforms may, but disable for now.
 #include "crc32c_sw.c"
 #endif
 
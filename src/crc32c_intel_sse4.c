@@ -20,6 +20,97 @@
 // https://software.intel.com/sites/landingpage/IntrinsicsGuide/#text=crc&expand=1288
 // Could consider https://github.com/htot/crc32c/blob/master/crc32c/crc_iscsi_v_pcl.asm
 
+#if defined(__x86_64__) || defined(_M_X64)
+
+// A single _mm_crc32_u64 dependency chain is latency bound at 3 cycles
+// per 8 bytes.  Large payloads run three independent chains over
+// adjacent blocks and then merge, which keeps the CRC unit saturated.
+// The merge multiplies a CRC by x^(8*len) mod P in GF(2), applied here
+// through byte-indexed lookup tables built once at first use.
+
+#define CRC32C_POLY (0x82f63b78U)    // CRC-32C (Castagnoli), reflected
+#define CRC32C_LONG (8192)           // bytes per chain, large payloads
+#define CRC32C_SHORT (256)           // bytes per chain, medium payloads
+
+static uint32_t crc32c_long_shift[4][256];
+static uint32_t crc32c_short_shift[4][256];
+static volatile int crc32c_shift_init_done = 0;  // x86 TSO: duplicate init is benign
+
+static uint32_t gf2_matrix_times(const uint32_t * mat, uint32_t vec) {
+    uint32_t sum = 0;
+    while (vec) {
+        if (vec & 1) {
+            sum ^= *mat;
+        }
+        vec >>= 1;
+        ++mat;
+    }
+    return sum;
+}
+
+static void gf2_matrix_square(uint32_t * square, const uint32_t * mat) {
+    for (int n = 0; n < 32; ++n) {
+        square[n] = gf2_matrix_times(mat, mat[n]);
+    }
+}
+
+// Construct the operator that advances a CRC over len zero bytes.
+// len must be a power of two.
+static void crc32c_zeros_op(uint32_t * even, size_t len) {
+    uint32_t odd[32];
+    odd[0] = CRC32C_POLY;
+    uint32_t row = 1;
+    for (int n = 1; n < 32; ++n) {
+        odd[n] = row;
+        row <<= 1;
+    }
+    gf2_matrix_square(even, odd);   // 2 zero bits
+    gf2_matrix_square(odd, even);   // 4 zero bits
+    while (1) {
+        gf2_matrix_square(even, odd);
+        len >>= 1;
+        if (0 == len) {
+            return;
+        }
+        gf2_matrix_square(odd, even);
+        len >>= 1;
+        if (0 == len) {
+            for (int n = 0; n < 32; ++n) {
+                even[n] = odd[n];
+            }
+            return;
+        }
+    }
+}
+
+static void crc32c_zeros(uint32_t shift[4][256], size_t len) {
+    uint32_t op[32];
+    crc32c_zeros_op(op, len);
+    for (uint32_t n = 0; n < 256; ++n) {
+        shift[0][n] = gf2_matrix_times(op, n);
+        shift[1][n] = gf2_matrix_times(op, n << 8);
+        shift[2][n] = gf2_matrix_times(op, n << 16);
+        shift[3][n] = gf2_matrix_times(op, n << 24);
+    }
+}
+
+static inline uint32_t crc32c_shift(uint32_t shift[4][256], uint32_t crc) {
+    return shift[0][crc & 0xff]
+        ^ shift[1][(crc >> 8) & 0xff]
+        ^ shift[2][(crc >> 16) & 0xff]
+        ^ shift[3][crc >> 24];
+}
+
+static void crc32c_shift_init(void) {
+    if (!crc32c_shift_init_done) {
+        crc32c_zeros(crc32c_long_shift, CRC32C_LONG);
+        crc32c_zeros(crc32c_short_shift, CRC32C_SHORT);
+        crc32c_shift_init_done = 1;
+    }
+}
+
+#endif
+
 uint32_t jls_crc32c_hdr(const struct jls_chunk_header_s * hdr) {
     uint32_t crc32;
 #if defined(__x86_64__) || defined(_M_X64)
@@ -50,6 +141,39 @@ uint32_t jls_crc32c(uint8_t const *data, uint32_t length) {
         crc = _mm_crc32_u8(crc, *data);
     }
 #if defined(__x86_64__) || defined(_M_X64)
+    if (length >= 3 * CRC32C_SHORT) {
+        crc32c_shift_init();
+    }
+    while (length >= 3 * CRC32C_LONG) {
+        const uint64_t * d = (const uint64_t *) data;
+        uint64_t crc0 = crc;
+        uint64_t crc1 = 0;
+        uint64_t crc2 = 0;
+        for (uint32_t i = 0; i < (CRC32C_LONG / 8); ++i) {
+            crc0 = _mm_crc32_u64(crc0, d[i]);
+            crc1 = _mm_crc32_u64(crc1, d[i + (CRC32C_LONG / 8)]);
+            crc2 = _mm_crc32_u64(crc2, d[i + 2 * (CRC32C_LONG / 8)]);
+        }
+        crc = crc32c_shift(crc32c_long_shift, (uint32_t) crc0) ^ (uint32_t) crc1;
+        crc = crc32c_shift(crc32c_long_shift, crc) ^ (uint32_t) crc2;
+        data += 3 * CRC32C_LONG;
+        length -= 3 * CRC32C_LONG;
+    }
+    while (length >= 3 * CRC32C_SHORT) {
+        const uint64_t * d = (const uint64_t *) data;
+        uint64_t crc0 = crc;
+        uint64_t crc1 = 0;
+        uint64_t crc2 = 0;
+        for (uint32_t i = 0; i < (CRC32C_SHORT / 8); ++i) {
+            crc0 = _mm_crc32_u64(crc0, d[i]);
+            crc1 = _mm_crc32_u64(crc1, d[i + (CRC32C_SHORT / 8)]);
+            crc2 = _mm_crc32_u64(crc2, d[i + 2 * (CRC32C_SHORT / 8)]);
+        }
+        crc = crc32c_shift(crc32c_short_shift, (uint32_t) crc0) ^ (uint32_t) crc1;
+        crc = crc32c_shift(crc32c_short_shift, crc) ^ (uint32_t) crc2;
+        data += 3 * CRC32C_SHORT;
+        length -= 3 * CRC32C_SHORT;
+    }
     for (; length >= 8; data += 8, length -= 8) {
         crc = (uint32_t) _mm_crc32_u64(crc, *((const uint64_t *) data));
     }
@@ -29,75 +29,233 @@ static inline int8_t uint4_to_int8(uint8_t k) {
     return (int8_t) k;
 }
 
-#define TO_DOUBLE(type_) { \
+#define TO_DOUBLE_FN(name_, type_) \
+static void name_(const void * src, double * dst, size_t samples, double scale) { \
     const type_ * s = (const type_ *) src; \
-    for (uint32_t i = 0; i < samples; ++i) { \
-        *dst++ = (double) *s++; \
+    for (size_t i = 0; i < samples; ++i) { \
+        dst[i] = scale * (double) s[i]; \
     } \
-    break; \
 }
 
-int32_t jls_dt_buffer_to_f64(const void * src, uint32_t src_datatype, double * dst, size_t samples) {
+TO_DOUBLE_FN(dt_i8_to_f64, int8_t)
+TO_DOUBLE_FN(dt_i64_to_f64, int64_t)
+TO_DOUBLE_FN(dt_u8_to_f64, uint8_t)
+TO_DOUBLE_FN(dt_u32_to_f64, uint32_t)
+TO_DOUBLE_FN(dt_u64_to_f64, uint64_t)
+TO_DOUBLE_FN(dt_f64_to_f64, double)
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+
+static void dt_i16_to_f64(const void * src, double * dst, size_t samples, double scale) {
+    const int16_t * s = (const int16_t *) src;
+    const __m128d k = _mm_set1_pd(scale);
+    size_t i = 0;
+    for (; (i + 8) <= samples; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *) (s + i));
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_pd(dst + i + 0, _mm_mul_pd(k, _mm_cvtepi32_pd(lo)));
+        _mm_storeu_pd(dst + i + 2, _mm_mul_pd(k, _mm_cvtepi32_pd(_mm_shuffle_epi32(lo, 0x4E))));
+        _mm_storeu_pd(dst + i + 4, _mm_mul_pd(k, _mm_cvtepi32_pd(hi)));
+        _mm_storeu_pd(dst + i + 6, _mm_mul_pd(k, _mm_cvtepi32_pd(_mm_shuffle_epi32(hi, 0x4E))));
+    }
+    for (; i < samples; ++i) {
+        dst[i] = scale * (double) s[i];
+    }
+}
+
+static void dt_u16_to_f64(const void * src, double * dst, size_t samples, double scale) {
+    const uint16_t * s = (const uint16_t *) src;
+    const __m128d k = _mm_set1_pd(scale);
+    const __m128i z = _mm_setzero_si128();
+    size_t i = 0;
+    for (; (i + 8) <= samples; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *) (s + i));
+        __m128i lo = _mm_unpacklo_epi16(v, z);
+        __m128i hi = _mm_unpackhi_epi16(v, z);
+        _mm_storeu_pd(dst + i + 0, _mm_mul_pd(k, _mm_cvtepi32_pd(lo)));
+        _mm_storeu_pd(dst + i + 2, _mm_mul_pd(k, _mm_cvtepi32_pd(_mm_shuffle_epi32(lo, 0x4E))));
+        _mm_storeu_pd(dst + i + 4, _mm_mul_pd(k, _mm_cvtepi32_pd(hi)));
+        _mm_storeu_pd(dst + i + 6, _mm_mul_pd(k, _mm_cvtepi32_pd(_mm_shuffle_epi32(hi, 0x4E))));
+    }
+    for (; i < samples; ++i) {
+        dst[i] = scale * (double) s[i];
+    }
+}
+
+static void dt_i32_to_f64(const void * src, double * dst, size_t samples, double scale) {
+    const int32_t * s = (const int32_t *) src;
+    const __m128d k = _mm_set1_pd(scale);
+    size_t i = 0;
+    for (; (i + 4) <= samples; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i *) (s + i));
+        _mm_storeu_pd(dst + i + 0, _mm_mul_pd(k, _mm_cvtepi32_pd(v)));
+        _mm_storeu_pd(dst + i + 2, _mm_mul_pd(k, _mm_cvtepi32_pd(_mm_shuffle_epi32(v, 0x4E))));
+    }
+    for (; i < samples; ++i) {
+        dst[i] = scale * (double) s[i];
+    }
+}
+
+static void dt_f32_to_f64(const void * src, double * dst, size_t samples, double scale) {
+    const float * s = (const float *) src;
+    const __m128d k = _mm_set1_pd(scale);
+    size_t i = 0;
+    for (; (i + 4) <= samples; i += 4) {
+        __m128 v = _mm_loadu_ps(s + i);
+        _mm_storeu_pd(dst + i + 0, _mm_mul_pd(k, _mm_cvtps_pd(v)));
+        _mm_storeu_pd(dst + i + 2, _mm_mul_pd(k, _mm_cvtps_pd(_mm_movehl_ps(v, v))));
+    }
+    for (; i < samples; ++i) {
+        dst[i] = scale * (double) s[i];
+    }
+}
+
+#elif defined(__aarch64__) || defined(__arm64__)
+#include <arm_neon.h>
+
+static void dt_i16_to_f64(const void * src, double * dst, size_t samples, double scale) {
+    const int16_t * s = (const int16_t *) src;
+    const float64x2_t k = vdupq_n_f64(scale);
+    size_t i = 0;
+    for (; (i + 8) <= samples; i += 8) {
+        int16x8_t v = vld1q_s16(s + i);
+        int32x4_t lo = vmovl_s16(vget_low_s16(v));
+        int32x4_t hi = vmovl_s16(vget_high_s16(v));
+        vst1q_f64(dst + i + 0, vmulq_f64(k, vcvtq_f64_s64(vmovl_s32(vget_low_s32(lo)))));
+        vst1q_f64(dst + i + 2, vmulq_f64(k, vcvtq_f64_s64(vmovl_s32(vget_high_s32(lo)))));
+        vst1q_f64(dst + i + 4, vmulq_f64(k, vcvtq_f64_s64(vmovl_s32(vget_low_s32(hi)))));
+        vst1q_f64(dst + i + 6, vmulq_f64(k, vcvtq_f64_s64(vmovl_s32(vget_high_s32(hi)))));
+    }
+    for (; i < samples; ++i) {
+        dst[i] = scale * (double) s[i];
+    }
+}
+
+static void dt_u16_to_f64(const void * src, double * dst, size_t samples, double scale) {
+    const uint16_t * s = (const uint16_t *) src;
+    const float64x2_t k = vdupq_n_f64(scale);
+    size_t i = 0;
+    for (; (i + 8) <= samples; i += 8) {
+        uint16x8_t v = vld1q_u16(s + i);
+        uint32x4_t lo = vmovl_u16(vget_low_u16(v));
+        uint32x4_t hi = vmovl_u16(vget_high_u16(v));
+        vst1q_f64(dst + i + 0, vmulq_f64(k, vcvtq_f64_u64(vmovl_u32(vget_low_u32(lo)))));
+        vst1q_f64(dst + i + 2, vmulq_f64(k, vcvtq_f64_u64(vmovl_u32(vget_high_u32(lo)))));
+        vst1q_f64(dst + i + 4, vmulq_f64(k, vcvtq_f64_u64(vmovl_u32(vget_low_u32(hi)))));
+        vst1q_f64(dst + i + 6, vmulq_f64(k, vcvtq_f64_u64(vmovl_u32(vget_high_u32(hi)))));
+    }
+    for (; i < samples; ++i) {
+        dst[i] = scale * (double) s[i];
+    }
+}
+
+static void dt_i32_to_f64(const void * src, double * dst, size_t samples, double scale) {
+    const int32_t * s = (const int32_t *) src;
+    const float64x2_t k = vdupq_n_f64(scale);
+    size_t i = 0;
+    for (; (i + 4) <= samples; i += 4) {
+        int32x4_t v = vld1q_s32(s + i);
+        vst1q_f64(dst + i + 0, vmulq_f64(k, vcvtq_f64_s64(vmovl_s32(vget_low_s32(v)))));
+        vst1q_f64(dst + i + 2, vmulq_f64(k, vcvtq_f64_s64(vmovl_s32(vget_high_s32(v)))));
+    }
+    for (; i < samples; ++i) {
+        dst[i] = scale * (double) s[i];
+    }
+}
+
+static void dt_f32_to_f64(const void * src, double * dst, size_t samples, double scale) {
+    const float * s = (const float *) src;
+    const float64x2_t k = vdupq_n_f64(scale);
+    size_t i = 0;
+    for (; (i + 4) <= samples; i += 4) {
+        float32x4_t v = vld1q_f32(s + i);
+        vst1q_f64(dst + i + 0, vmulq_f64(k, vcvt_f64_f32(vget_low_f32(v))));
+        vst1q_f64(dst + i + 2, vmulq_f64(k, vcvt_high_f64_f32(v)));
+    }
+    for (; i < samples; ++i) {
+        dst[i] = scale * (double) s[i];
+    }
+}
+
+#else
+TO_DOUBLE_FN(dt_i16_to_f64, int16_t)
+TO_DOUBLE_FN(dt_u16_to_f64, uint16_t)
+TO_DOUBLE_FN(dt_i32_to_f64, int32_t)
+TO_DOUBLE_FN(dt_f32_to_f64, float)
+#endif
+
+static void dt_i4_to_f64(const void * src, double * dst, size_t samples, double scale) {
+    const uint8_t * s = (const uint8_t *) src;
+    for (size_t i = 0; i < samples; i += 2) {
+        uint8_t k = s[i >> 1];
+        dst[i + 0] = scale * (double) uint4_to_int8(k);
+        dst[i + 1] = scale * (double) uint4_to_int8(k >> 4);
+    }
+}
+
+static void dt_u1_to_f64(const void * src, double * dst, size_t samples, double scale) {
+    const uint8_t * s = (const uint8_t *) src;
+    for (size_t i = 0; i < (samples / 8); ++i) {
+        uint8_t k = s[i];
+        *dst++ = scale * (double) ((k >> 0) & 1);
+        *dst++ = scale * (double) ((k >> 1) & 1);
+        *dst++ = scale * (double) ((k >> 2) & 1);
+        *dst++ = scale * (double) ((k >> 3) & 1);
+        *dst++ = scale * (double) ((k >> 4) & 1);
+        *dst++ = scale * (double) ((k >> 5) & 1);
+        *dst++ = scale * (double) ((k >> 6) & 1);
+        *dst++ = scale * (double) ((k >> 7) & 1);
+    }
+}
+
+static void dt_u4_to_f64(const void * src, double * dst, size_t samples, double scale) {
+    const uint8_t * s = (const uint8_t *) src;
+    for (size_t i = 0; i < samples; i += 2) {
+        uint8_t k = s[i >> 1];
+        dst[i + 0] = scale * (double) (k & 0x0f);
+        dst[i + 1] = scale * (double) ((k >> 4) & 0x0f);
+    }
+}
+
+jls_dt_f64_fn jls_dt_buffer_to_f64_fn(uint32_t src_datatype) {
     switch (src_datatype & 0xffff) {
-        case JLS_DATATYPE_I4: {
-            const uint8_t *s = (const uint8_t *) src;
-            for (uint32_t i = 0; i < samples; i += 2) {
-                uint8_t k = s[i >> 1];
-                dst[i + 0] = (double) uint4_to_int8(k);
-                dst[i + 1] = (double) uint4_to_int8(k >> 4);
-            }
-            break;
-        }
-        case JLS_DATATYPE_I8: TO_DOUBLE(int8_t);
-        case JLS_DATATYPE_I16: TO_DOUBLE(int16_t);
+        case JLS_DATATYPE_I4:  return dt_i4_to_f64;
+        case JLS_DATATYPE_I8:  return dt_i8_to_f64;
+        case JLS_DATATYPE_I16: return dt_i16_to_f64;
         // case JLS_DATATYPE_I24: break; todo
-        case JLS_DATATYPE_I32: TO_DOUBLE(int32_t);
-        case JLS_DATATYPE_I64: TO_DOUBLE(int64_t);
-        case JLS_DATATYPE_U1: {
-            const uint8_t *s = (const uint8_t *) src;
-            for (uint32_t i = 0; i < (samples / 8); ++i) {
-                uint8_t k = s[i];
-                *dst++ = (double) ((k >> 0) & 1);
-                *dst++ = (double) ((k >> 1) & 1);
-                *dst++ = (double) ((k >> 2) & 1);
-                *dst++ = (double) ((k >> 3) & 1);
-                *dst++ = (double) ((k >> 4) & 1);
-                *dst++ = (double) ((k >> 5) & 1);
-                *dst++ = (double) ((k >> 6) & 1);
-                *dst++ = (double) ((k >> 7) & 1);
-            }
-            break;
-        }
-        case JLS_DATATYPE_U4:  {
-            const uint8_t *s = (const uint8_t *) src;
-            for (uint32_t i = 0; i < samples; i += 2) {
-                uint8_t k = s[i >> 1];
-                dst[i + 0] = (double) (k & 0x0f);
-                dst[i + 1] = (double) ((k >> 4) & 0x0f);
-            }
-            break;
-        }
-        case JLS_DATATYPE_U8: TO_DOUBLE(uint8_t);
-        case JLS_DATATYPE_U16: TO_DOUBLE(uint16_t);
+        case JLS_DATATYPE_I32: return dt_i32_to_f64;
+        case JLS_DATATYPE_I64: return dt_i64_to_f64;
+        case JLS_DATATYPE_U1:  return dt_u1_to_f64;
+        case JLS_DATATYPE_U4:  return dt_u4_to_f64;
+        case JLS_DATATYPE_U8:  return dt_u8_to_f64;
+        case JLS_DATATYPE_U16: return dt_u16_to_f64;
         // case JLS_DATATYPE_U24: break;  todo
-        case JLS_DATATYPE_U32: TO_DOUBLE(uint32_t);
-        case JLS_DATATYPE_U64: TO_DOUBLE(uint64_t);
+        case JLS_DATATYPE_U32: return dt_u32_to_f64;
+        case JLS_DATATYPE_U64: return dt_u64_to_f64;
+        case JLS_DATATYPE_F32: return dt_f32_to_f64;
+        case JLS_DATATYPE_F64: return dt_f64_to_f64;
+        default: return NULL;
+    }
+}
 
-        case JLS_DATATYPE_F32: TO_DOUBLE(float);
-        case JLS_DATATYPE_F64: TO_DOUBLE(double);
-        default:
-            JLS_LOGW("Invalid data type: 0x%08x", src_datatype);
-            return JLS_ERROR_PARAMETER_INVALID;
+double jls_dt_f64_scale(uint32_t src_datatype) {
+    uint8_t basetype = jls_datatype_parse_basetype(src_datatype);
+    int8_t q = (int8_t) jls_datatype_parse_q(src_datatype);
+    if (q && ((JLS_DATATYPE_BASETYPE_INT == basetype) || (JLS_DATATYPE_BASETYPE_UINT == basetype))) {
+        return pow(2.0, -q);
     }
+    return 1.0;
+}
 
-    // fixed point support
-    int8_t fp = (int8_t) ((src_datatype & 0xff) >> 16);
-    if ((src_datatype & JLS_DATATYPE_BASETYPE_UINT) && fp) {
-        double scale = pow(2.0, fp);
-        for (uint32_t i = 0; i < samples; ++i) {
-            dst[i] *= scale;
-        }
+int32_t jls_dt_buffer_to_f64(const void * src, uint32_t src_datatype, double * dst, size_t samples) {
+    jls_dt_f64_fn fn = jls_dt_buffer_to_f64_fn(src_datatype);
+    if (NULL == fn) {
+        JLS_LOGW("Invalid data type: 0x%08x", src_datatype);
+        return JLS_ERROR_PARAMETER_INVALID;
     }
+    fn(src, dst, samples, jls_dt_f64_scale(src_datatype));
     return 0;
 }
 
@@ -0,0 +1,260 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/delta.h"
+#include "jls/buffer.h"
+#include "jls/cdef.h"
+#include "jls/format.h"
+#include "jls/ec.h"
+#include <string.h>
+
+#define BLOCK_SIZE (64)
+
+// Sequential LSB-first bit stream over a byte buffer.
+struct bitstream_s {
+    uint8_t * buf;
+    uint64_t bit_length;    // total capacity, in bits
+    uint64_t bitpos;
+};
+
+static inline uint64_t bs_rd(struct bitstream_s * self, uint32_t bits) {
+    uint64_t v = 0;
+    uint32_t n = 0;
+    while (n < bits) {
+        uint64_t byte = self->bitpos >> 3;
+        uint32_t off = self->bitpos & 7;
+        uint32_t take = 8 - off;
+        if (take > (bits - n)) {
+            take = bits - n;
+        }
+        v |= ((uint64_t) ((self->buf[byte] >> off) & ((1U << take) - 1U))) << n;
+        n += take;
+        self->bitpos += take;
+    }
+    return v;
+}
+
+static inline int32_t bs_wr(struct bitstream_s * self, uint64_t value, uint32_t bits) {
+    if ((self->bitpos + bits) > self->bit_length) {
+        return JLS_ERROR_TOO_BIG;
+    }
+    uint32_t n = 0;
+    while (n < bits) {
+        uint64_t byte = self->bitpos >> 3;
+        uint32_t off = self->bitpos & 7;
+        if (0 == off) {
+            self->buf[byte] = 0;
+        }
+        uint32_t take = 8 - off;
+        if (take > (bits - n)) {
+            take = bits - n;
+        }
+        self->buf[byte] |= (uint8_t) (((value >> n) & ((1U << take) - 1U)) << off);
+        n += take;
+        self->bitpos += take;
+    }
+    return 0;
+}
+
+static inline uint64_t bits_mask(uint16_t bits) {
+    return (bits >= 64) ? ~((uint64_t) 0) : ((((uint64_t) 1) << bits) - 1);
+}
+
+static inline uint64_t zigzag(uint64_t delta, uint16_t bits) {
+    // sign extend the modular delta, then fold negatives onto odd values
+    int64_t s = ((int64_t) (delta << (64 - bits))) >> (64 - bits);
+    return (((uint64_t) s) << 1) ^ ((uint64_t) (s >> 63));
+}
+
+static inline uint64_t unzigzag(uint64_t z) {
+    return (z >> 1) ^ (~((z & 1) - 1));
+}
+
+static inline uint32_t bit_width(uint64_t v) {
+    uint32_t w = 0;
+    while (v) {
+        ++w;
+        v >>= 1;
+    }
+    return w;
+}
+
+uint32_t jls_delta_bound(uint16_t entry_size_bits, uint32_t entry_count) {
+    // worst case: verbatim first entry, full-width blocks, one control byte each
+    uint64_t bits = ((uint64_t) entry_count) * entry_size_bits;
+    uint32_t blocks = (entry_count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    return (uint32_t) ((bits + 7) / 8) + blocks + 8;
+}
+
+int32_t jls_delta_encode(const uint8_t * src, uint32_t entry_count, uint16_t entry_size_bits,
+                         uint8_t * dst, uint32_t dst_length) {
+    if (!src || !dst || !entry_count || !entry_size_bits || (entry_size_bits > 64)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct bitstream_s rd = {
+            .buf = (uint8_t *) src,
+            .bit_length = ((uint64_t) entry_count) * entry_size_bits,
+            .bitpos = 0,
+    };
+    struct bitstream_s wr = {
+            .buf = dst,
+            .bit_length = ((uint64_t) dst_length) * 8,
+            .bitpos = 0,
+    };
+
+    uint64_t prev = bs_rd(&rd, entry_size_bits);
+    if (bs_wr(&wr, prev, entry_size_bits)) {
+        return 0;
+    }
+
+    uint64_t z[BLOCK_SIZE];
+    uint32_t remaining = entry_count - 1;
+    while (remaining) {
+        uint32_t block = (remaining > BLOCK_SIZE) ? BLOCK_SIZE : remaining;
+        uint32_t width = 0;
+        for (uint32_t i = 0; i < block; ++i) {
+            uint64_t v = bs_rd(&rd, entry_size_bits);
+            z[i] = zigzag((v - prev) & bits_mask(entry_size_bits), entry_size_bits);
+            prev = v;
+            uint32_t w = bit_width(z[i]);
+            if (w > width) {
+                width = w;
+            }
+        }
+        // byte-align the control byte so the decoder can resynchronize
+        wr.bitpos = (wr.bitpos + 7) & ~((uint64_t) 7);
+        if (bs_wr(&wr, width, 8)) {
+            return 0;
+        }
+        for (uint32_t i = 0; i < block; ++i) {
+            if (bs_wr(&wr, z[i], width)) {
+                return 0;
+            }
+        }
+        remaining -= block;
+    }
+    return (int32_t) ((wr.bitpos + 7) / 8);
+}
+
+int32_t jls_delta_decode(const uint8_t * src, uint32_t src_length,
+                         uint32_t entry_count, uint16_t entry_size_bits,
+                         uint8_t * dst, uint32_t dst_length) {
+    if (!src || !dst || !entry_count || !entry_size_bits || (entry_size_bits > 64)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    uint64_t dst_bits = ((uint64_t) entry_count) * entry_size_bits;
+    if (((dst_bits + 7) / 8) > dst_length) {
+        return JLS_ERROR_TOO_BIG;
+    }
+    struct bitstream_s rd = {
+            .buf = (uint8_t *) src,
+            .bit_length = ((uint64_t) src_length) * 8,
+            .bitpos = 0,
+    };
+    struct bitstream_s wr = {
+            .buf = dst,
+            .bit_length = dst_bits,
+            .bitpos = 0,
+    };
+
+    if (rd.bit_length < entry_size_bits) {
+        return JLS_ERROR_MESSAGE_INTEGRITY;
+    }
+    uint64_t prev = bs_rd(&rd, entry_size_bits);
+    if (bs_wr(&wr, prev, entry_size_bits)) {
+        return JLS_ERROR_MESSAGE_INTEGRITY;
+    }
+
+    uint32_t remaining = entry_count - 1;
+    while (remaining) {
+        uint32_t block = (remaining > BLOCK_SIZE) ? BLOCK_SIZE : remaining;
+        rd.bitpos = (rd.bitpos + 7) & ~((uint64_t) 7);
+        if ((rd.bitpos + 8) > rd.bit_length) {
+            return JLS_ERROR_MESSAGE_INTEGRITY;
+        }
+        uint32_t width = (uint32_t) bs_rd(&rd, 8);
+        if ((width > 64) || ((rd.bitpos + ((uint64_t) block) * width) > rd.bit_length)) {
+            return JLS_ERROR_MESSAGE_INTEGRITY;
+        }
+        for (uint32_t i = 0; i < block; ++i) {
+            uint64_t s = unzigzag(bs_rd(&rd, width));
+            prev = (prev + s) & bits_mask(entry_size_bits);
+            if (bs_wr(&wr, prev, entry_size_bits)) {
+                return JLS_ERROR_MESSAGE_INTEGRITY;
+            }
+        }
+        remaining -= block;
+    }
+    if (((rd.bitpos + 7) / 8) != src_length) {
+        return JLS_ERROR_MESSAGE_INTEGRITY;
+    }
+    return 0;
+}
+
+int32_t jls_delta_buf_decode(struct jls_buf_s * buf) {
+    if (!buf || (buf->length < sizeof(struct jls_payload_header_s))) {
+        return 0;
+    }
+    struct jls_payload_header_s hdr = *(struct jls_payload_header_s *) buf->start;
+    if (JLS_FSR_DATA_ENCODING_RAW == hdr.rsv16) {
+        return 0;
+    }
+    if (JLS_FSR_DATA_ENCODING_CONST == hdr.rsv16) {
+        uint32_t sample_bytes = (hdr.entry_size_bits + 7) / 8;
+        uint64_t dec_bits = ((uint64_t) hdr.entry_count) * hdr.entry_size_bits;
+        uint32_t dec_length = (uint32_t) ((dec_bits + 7) / 8);
+        if (buf->length < sizeof(hdr) + sample_bytes) {
+            return JLS_ERROR_MESSAGE_INTEGRITY;
+        }
+        ROE(jls_buf_realloc(buf, sizeof(hdr) + dec_length));
+        uint8_t * dec = buf->start + sizeof(hdr);
+        if (hdr.entry_size_bits < 8) {
+            // sub-byte entries store the repeated byte pattern
+            memset(dec, dec[0], dec_length);
+        } else {
+            // tile the stored sample over the run, doubling each pass
+            uint32_t filled = sample_bytes;
+            while (filled < dec_length) {
+                uint32_t n = (filled <= dec_length - filled) ? filled : (dec_length - filled);
+                memcpy(dec + filled, dec, n);
+                filled += n;
+            }
+        }
+        ((struct jls_payload_header_s *) buf->start)->rsv16 = JLS_FSR_DATA_ENCODING_RAW;
+        buf->length = sizeof(hdr) + dec_length;
+        buf->cur = buf->start;
+        buf->end = buf->start + buf->length;
+        return 0;
+    }
+    if (JLS_FSR_DATA_ENCODING_DELTA != hdr.rsv16) {
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    uint32_t enc_length = (uint32_t) (buf->length - sizeof(hdr));
+    uint64_t dec_bits = ((uint64_t) hdr.entry_count) * hdr.entry_size_bits;
+    uint32_t dec_length = (uint32_t) ((dec_bits + 7) / 8);
+    ROE(jls_buf_realloc(buf, sizeof(hdr) + dec_length + enc_length));
+    // move the encoded bytes past the decode destination, then expand forward
+    uint8_t * dec = buf->start + sizeof(hdr);
+    uint8_t * enc = dec + dec_length;
+    memmove(enc, dec, enc_length);
+    ROE(jls_delta_decode(enc, enc_length, hdr.entry_count, hdr.entry_size_bits,
+                         dec, dec_length));
+    ((struct jls_payload_header_s *) buf->start)->rsv16 = JLS_FSR_DATA_ENCODING_RAW;
+    buf->length = sizeof(hdr) + dec_length;
+    buf->cur = buf->start;
+    buf->end = buf->start + buf->length;
+    return 0;
+}
@@ -15,8 +15,13 @@
  */
 
 #include "jls/log.h"
+#include "jls/backend.h"
+#include "jls/ec.h"
+#include "jls/time.h"
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdarg.h>
+#include <string.h>
 
 char const * const jls_log_level_str[JLS_LOG_LEVEL_ALL + 1] = {
         "EMERGENCY",
@@ -42,15 +47,222 @@ static void cbk_default(const char * msg) {
 
 static jls_log_cbk cbk_ = cbk_default;
 
+/*
+ * Asynchronous logging: producers format into a fixed ring of message
+ * slots under a brief spinlock, and a dedicated thread dispatches to
+ * the registered handler.  The spinlock only covers formatting into
+ * the slot, never the handler, so a slow handler cannot stall the
+ * capture threads.  Call sites are identified by their format string
+ * pointer, which the JLS_LOG macros make unique per site.
+ */
+
+#define ASYNC_MSG_SIZE (256)
+#define ASYNC_MSG_COUNT (256)       // must be a power of 2
+#define RATE_LIMIT_SITES (64)
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+
+static inline uint32_t log_load(volatile uint32_t * p) {
+    return (uint32_t) _InterlockedOr((volatile long *) p, 0);
+}
+
+static inline void log_store(volatile uint32_t * p, uint32_t v) {
+    _InterlockedExchange((volatile long *) p, (long) v);
+}
+
+static inline uint32_t log_exchange(volatile uint32_t * p, uint32_t v) {
+    return (uint32_t) _InterlockedExchange((volatile long *) p, (long) v);
+}
+
+#else
+
+static inline uint32_t log_load(volatile uint32_t * p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static inline void log_store(volatile uint32_t * p, uint32_t v) {
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+static inline uint32_t log_exchange(volatile uint32_t * p, uint32_t v) {
+    return __atomic_exchange_n(p, v, __ATOMIC_ACQ_REL);
+}
+
+#endif
+
+struct log_site_s {
+    const char * fmt;           // the call site identity
+    int64_t window_start;       // jls_now() at the window start
+    uint32_t count;             // messages in the current window
+    uint32_t suppressed;        // messages rate limited in the current window
+};
+
+static volatile uint32_t async_lock_ = 0;
+static volatile uint32_t async_enable_ = 0;
+static volatile uint32_t async_quit_ = 0;
+static volatile uint32_t async_head_ = 0;       // producers, lock protected
+static volatile uint32_t async_tail_ = 0;       // logging thread only
+static volatile uint32_t async_dropped_ = 0;    // ring full events
+static jls_log_cbk async_cbk_ = cbk_default;
+static struct jls_bk_thread_s * async_thread_ = NULL;
+static char async_msgs_[ASYNC_MSG_COUNT][ASYNC_MSG_SIZE];
+static struct log_site_s sites_[RATE_LIMIT_SITES];
+
+static inline void async_lock(void) {
+    while (log_exchange(&async_lock_, 1)) {
+        // spin: holders only format one bounded message
+    }
+}
+
+static inline void async_unlock(void) {
+    log_store(&async_lock_, 0);
+}
+
+// Enqueue one message; caller holds the lock.
+static void async_enqueue(const char * fmt, va_list arg) {
+    uint32_t head = async_head_;
+    if ((head - log_load(&async_tail_)) >= ASYNC_MSG_COUNT) {
+        log_store(&async_dropped_, async_dropped_ + 1);
+        return;
+    }
+    vsnprintf(async_msgs_[head & (ASYNC_MSG_COUNT - 1)], ASYNC_MSG_SIZE, fmt, arg);
+    log_store(&async_head_, head + 1);
+}
+
+static void async_enqueue_str(const char * msg) {
+    uint32_t head = async_head_;
+    if ((head - log_load(&async_tail_)) >= ASYNC_MSG_COUNT) {
+        log_store(&async_dropped_, async_dropped_ + 1);
+        return;
+    }
+    snprintf(async_msgs_[head & (ASYNC_MSG_COUNT - 1)], ASYNC_MSG_SIZE, "%s", msg);
+    log_store(&async_head_, head + 1);
+}
+
+// Apply the per-site rate limit; caller holds the lock.
+// Return 1 to emit the message, 0 when rate limited.
+static int async_rate_limit(const char * fmt) {
+    size_t idx = (((size_t) fmt) >> 4) % RATE_LIMIT_SITES;
+    struct log_site_s * site = NULL;
+    for (size_t k = 0; k < RATE_LIMIT_SITES; ++k) {
+        struct log_site_s * s = &sites_[(idx + k) % RATE_LIMIT_SITES];
+        if ((s->fmt == fmt) || (NULL == s->fmt)) {
+            site = s;
+            break;
+        }
+    }
+    if (NULL == site) {
+        return 1;  // site table full, do not limit
+    }
+    int64_t now = jls_now();
+    if (NULL == site->fmt) {
+        site->fmt = fmt;
+        site->window_start = now;
+        site->count = 0;
+        site->suppressed = 0;
+    } else if ((now - site->window_start) >= JLS_TIME_SECOND) {
+        if (site->suppressed) {
+            char msg[ASYNC_MSG_SIZE];
+            snprintf(msg, sizeof(msg), "W jls_log: %" PRIu32 " messages rate limited\n",
+                     site->suppressed);
+            async_enqueue_str(msg);
+        }
+        site->window_start = now;
+        site->count = 0;
+        site->suppressed = 0;
+    }
+    if (site->count >= JLS_LOG_RATE_LIMIT_PER_SECOND) {
+        ++site->suppressed;
+        return 0;
+    }
+    ++site->count;
+    return 1;
+}
+
+static void async_thread(void * user_data) {
+    (void) user_data;
+    char msg[ASYNC_MSG_SIZE];
+    while (1) {
+        uint32_t tail = async_tail_;
+        uint32_t head = log_load(&async_head_);
+        if (tail == head) {
+            if (log_load(&async_quit_)) {
+                break;
+            }
+            jls_bkt_sleep_ms(2);
+            continue;
+        }
+        while (tail != head) {
+            // copy out so the slot frees before the handler runs
+            memcpy(msg, async_msgs_[tail & (ASYNC_MSG_COUNT - 1)], ASYNC_MSG_SIZE);
+            ++tail;
+            log_store(&async_tail_, tail);
+            async_cbk_(msg);
+        }
+        uint32_t dropped = log_exchange(&async_dropped_, 0);
+        if (dropped) {
+            snprintf(msg, sizeof(msg), "W jls_log: %" PRIu32 " messages dropped\n", dropped);
+            async_cbk_(msg);
+        }
+    }
+}
+
 void jls_log_printf(const char * fmt, ...) {
     char buffer[1024];
     va_list arg;
+    if (log_load(&async_enable_)) {
+        async_lock();
+        if (async_rate_limit(fmt)) {
+            va_start(arg, fmt);
+            async_enqueue(fmt, arg);
+            va_end(arg);
+        }
+        async_unlock();
+        return;
+    }
+    if (cbk_default == cbk_) {
+        return;  // no handler registered, skip formatting entirely
+    }
     va_start(arg, fmt);
     vsnprintf(buffer, sizeof(buffer), fmt, arg);
     va_end(arg);
     cbk_(buffer);
 }
 
+JLS_API int32_t jls_log_async_register(jls_log_cbk handler) {
+    if (NULL == handler) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (log_load(&async_enable_)) {
+        return JLS_ERROR_BUSY;
+    }
+    async_cbk_ = handler;
+    async_quit_ = 0;
+    async_head_ = 0;
+    async_tail_ = 0;
+    async_dropped_ = 0;
+    memset(sites_, 0, sizeof(sites_));
+    int32_t rc = jls_bk_thread_run(&async_thread_, async_thread, NULL);
+    if (rc) {
+        async_cbk_ = cbk_default;
+        return rc;
+    }
+    log_store(&async_enable_, 1);
+    return 0;
+}
+
+JLS_API void jls_log_async_unregister(void) {
+    if (!log_load(&async_enable_)) {
+        return;
+    }
+    log_store(&async_enable_, 0);
+    log_store(&async_quit_, 1);
+    jls_bk_thread_join(async_thread_);  // drains all queued messages
+    async_thread_ = NULL;
+    async_cbk_ = cbk_default;
+}
+
 JLS_API void jls_log_register(jls_log_cbk handler) {
     if (NULL == handler) {
         cbk_ = cbk_default;
@@ -16,6 +16,7 @@
 
 #include "jls/msg_ring_buffer.h"
 #include "jls/log.h"
+#include <stdlib.h>
 #include <string.h>
 
 /*
@@ -24,27 +25,118 @@
  * The message size, sz, must be less than 0x80000000.
  * Any message with the bit[31] set is considered a control header,
  * which indicates wrap_around.
+ *
+ * This implementation is lock-free for a single producer and a single
+ * consumer.  The producer writes head, the consumer writes tail, and each
+ * side only reads the index owned by the other.  jls_mrb_alloc() reserves
+ * space without publishing; jls_mrb_commit() publishes head with release
+ * semantics after the caller has filled the message, so the consumer's
+ * acquire load of head makes the message contents visible.
+ *
+ * With jls_mrb_overflow_set(), the buffer becomes a FIFO chain of
+ * segments.  The producer appends messages to the newest segment (wr)
+ * and, when it is full, links a heap-allocated segment with a release
+ * store of next.  The consumer drains the oldest segment (rd) and, when
+ * it empties and has a successor, frees it (or marks the embedded
+ * primary segment idle for the producer to relink).  A segment with a
+ * non-NULL next never receives another message, so the handoff needs no
+ * locks.
  */
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+
+static inline uint32_t mrb_load(volatile uint32_t * p) {
+    return (uint32_t) _InterlockedOr((volatile long *) p, 0);
+}
+
+static inline void mrb_store(volatile uint32_t * p, uint32_t v) {
+    _InterlockedExchange((volatile long *) p, (long) v);
+}
+
+static inline void mrb_add(volatile uint32_t * p, int32_t v) {
+    _InterlockedExchangeAdd((volatile long *) p, (long) v);
+}
+
+static inline struct jls_mrb_s * mrb_load_ptr(struct jls_mrb_s * volatile * p) {
+    return (struct jls_mrb_s *) _InterlockedCompareExchangePointer(
+            (void * volatile *) p, NULL, NULL);
+}
+
+static inline void mrb_store_ptr(struct jls_mrb_s * volatile * p, struct jls_mrb_s * v) {
+    _InterlockedExchangePointer((void * volatile *) p, (void *) v);
+}
+
+#else
+
+static inline uint32_t mrb_load(volatile uint32_t * p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static inline void mrb_store(volatile uint32_t * p, uint32_t v) {
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+static inline void mrb_add(volatile uint32_t * p, int32_t v) {
+    __atomic_add_fetch(p, (uint32_t) v, __ATOMIC_RELAXED);
+}
+
+static inline struct jls_mrb_s * mrb_load_ptr(struct jls_mrb_s * volatile * p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static inline void mrb_store_ptr(struct jls_mrb_s * volatile * p, struct jls_mrb_s * v) {
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+
+#endif
+
 void jls_mrb_init(struct jls_mrb_s * self, uint8_t * buffer, uint32_t buffer_size) {
     self->buf = buffer;
     self->buf_size = buffer_size;
+    self->next = NULL;
+    self->wr = self;
+    self->rd = self;
+    self->idle = 0;
+    self->owned = 0;
+    self->alloc_size_pending = 0;
+    self->used_bytes = 0;
+    self->overflow_size = 0;
+    self->overflow_max = 0;
+    self->overflow_bytes = 0;
     jls_mrb_clear(self);
 }
 
 void jls_mrb_clear(struct jls_mrb_s * self) {
+    struct jls_mrb_s * seg = self->rd;
+    while (NULL != seg) {
+        struct jls_mrb_s * next = seg->next;
+        if (seg->owned) {
+            free(seg);
+        }
+        seg = next;
+    }
     self->head = 0;
+    self->head_pending = 0;
     self->tail = 0;
     self->count = 0;
+    self->next = NULL;
+    self->wr = self;
+    self->rd = self;
+    self->idle = 0;
+    self->alloc_size_pending = 0;
+    self->used_bytes = 0;
+    self->overflow_bytes = 0;
     memset(self->buf, 0, self->buf_size);
 }
 
 uint32_t jls_mrb_used_bytes(struct jls_mrb_s * self) {
-    if (self->head > self->tail) {
-        return self->head - self->tail;
-    } else {
-        return (self-> head + self->buf_size) - self->tail;
-    }
+    return mrb_load(&self->used_bytes);
+}
+
+void jls_mrb_overflow_set(struct jls_mrb_s * self, uint32_t segment_size, uint32_t bytes_max) {
+    self->overflow_size = segment_size;
+    self->overflow_max = bytes_max;
 }
 
 static inline uint8_t * add_sz(uint8_t * p, uint32_t sz) {
@@ -55,29 +147,27 @@ static inline uint8_t * add_sz(uint8_t * p, uint32_t sz) {
     return (p + 4);
 }
 
-uint8_t * jls_mrb_alloc(struct jls_mrb_s * self, uint32_t size) {
-    uint8_t *p = self->buf + self->head;
-    uint32_t head = self->head;
-    uint32_t tail = self->tail;
-
-    if (size > self->buf_size) {
-        JLS_LOGE("jls_mrb_alloc too big");
-        return NULL;
-    }
+static uint8_t * seg_alloc(struct jls_mrb_s * seg, uint32_t size) {
+    uint32_t head = seg->head;  // producer-owned
+    uint32_t tail = mrb_load(&seg->tail);
+    uint8_t *p = seg->buf + head;
 
     if (head >= tail) {
         uint32_t end_idx = head + 4 + size + 4 + (tail ? 0 : 1);
-        if (end_idx < self->buf_size) {
+        if (end_idx < seg->buf_size) {
             // fits as is, no wrap
         } else if ((size + 5) < tail) {
             // fits after wrap
             add_sz(p, 0xffffffffU);
-            p = self->buf;
+            p = seg->buf;
         } else if (head == tail) {
-            // Big item, but buffer is empty.  Reset pointers to make room.
-            self->head = 0;
-            self->tail = 0;
-            p = self->buf;
+            // Big item, but buffer is empty.  Publish a wrap marker so
+            // that the consumer advances tail to 0, then the retry fits.
+            // The producer must not move tail: the consumer owns it.
+            add_sz(p, 0xffffffffU);
+            mrb_store(&seg->head, 0);
+            seg->head_pending = 0;
+            return NULL;
         } else {
             return NULL; // does not fit
         }
@@ -87,15 +177,91 @@ uint8_t * jls_mrb_alloc(struct jls_mrb_s * self, uint32_t size) {
         return NULL; // does not fit.
     }
     p = add_sz(p, size);
-    head = ((uint32_t) (p - self->buf)) + size;
-    if (head >= self->buf_size) {
+    head = ((uint32_t) (p - seg->buf)) + size;
+    if (head >= seg->buf_size) {
         head = 0;
     }
-    self->head = head;
-    ++self->count;
+    seg->head_pending = head;
     return p;
 }
 
+// Relink the drained primary segment as the newest segment.
+static struct jls_mrb_s * primary_relink(struct jls_mrb_s * self) {
+    struct jls_mrb_s * wr = self->wr;
+    self->head = 0;
+    self->head_pending = 0;
+    self->tail = 0;
+    self->next = NULL;
+    self->idle = 0;
+    mrb_store_ptr(&wr->next, self);
+    self->wr = self;
+    return self;
+}
+
+// Append a segment to the overflow chain, or return NULL at the cap.
+static struct jls_mrb_s * overflow_grow(struct jls_mrb_s * self, uint32_t size) {
+    struct jls_mrb_s * wr = self->wr;
+    if ((self != wr) && mrb_load(&self->idle)) {
+        // the consumer drained the primary segment and moved past it: reuse
+        return primary_relink(self);
+    }
+    uint32_t seg_size = self->overflow_size;
+    if (seg_size < (size + 16)) {
+        seg_size = size + 16;  // guarantee the pending message fits
+    }
+    uint32_t total = (uint32_t) sizeof(struct jls_mrb_s) + seg_size;
+    uint32_t in_use = mrb_load(&self->overflow_bytes);
+    if ((in_use + total) > self->overflow_max) {
+        return NULL;  // at the cap, caller blocks or drops as configured
+    }
+    struct jls_mrb_s * seg = malloc(total);
+    if (NULL == seg) {
+        JLS_LOGW("mrb overflow segment malloc failed");
+        return NULL;
+    }
+    seg->head = 0;
+    seg->head_pending = 0;
+    seg->tail = 0;
+    seg->buf = (uint8_t *) (seg + 1);
+    seg->buf_size = seg_size;
+    seg->next = NULL;
+    seg->owned = total;
+    mrb_add(&self->overflow_bytes, (int32_t) total);
+    mrb_store_ptr(&wr->next, seg);
+    self->wr = seg;
+    return seg;
+}
+
+uint8_t * jls_mrb_alloc(struct jls_mrb_s * self, uint32_t size) {
+    if (size > self->buf_size) {
+        JLS_LOGE("jls_mrb_alloc too big");
+        return NULL;
+    }
+    if (self->wr->owned && mrb_load(&self->idle)) {
+        // prefer the drained primary segment over a heap segment,
+        // so memory use returns to the primary buffer after a burst
+        primary_relink(self);
+    }
+    uint8_t * p = seg_alloc(self->wr, size);
+    if ((NULL == p) && self->overflow_size) {
+        struct jls_mrb_s * seg = overflow_grow(self, size);
+        if (NULL != seg) {
+            p = seg_alloc(seg, size);
+        }
+    }
+    if (NULL != p) {
+        self->alloc_size_pending = size;
+    }
+    return p;
+}
+
+void jls_mrb_commit(struct jls_mrb_s * self) {
+    struct jls_mrb_s * wr = self->wr;
+    mrb_add(&self->count, 1);
+    mrb_add(&self->used_bytes, (int32_t) (4 + self->alloc_size_pending));
+    mrb_store(&wr->head, wr->head_pending);
+}
+
 static inline uint32_t get_sz(uint8_t const * p) {
     return ((uint32_t) p[0])
             | (((uint32_t) p[1]) << 8)
@@ -103,47 +269,73 @@ static inline uint32_t get_sz(uint8_t const * p) {
             | (((uint32_t) p[3]) << 24);
 }
 
-uint8_t * jls_mrb_peek(struct jls_mrb_s * self, uint32_t * size) {
-    uint8_t *p = self->buf + self->tail;
-    uint32_t head = self->head;
+static uint8_t * seg_peek(struct jls_mrb_s * seg, uint32_t * size) {
+    uint32_t tail = seg->tail;  // consumer-owned
+    uint32_t head = mrb_load(&seg->head);
+    uint8_t *p = seg->buf + tail;
     uint32_t sz;
     *size = 0;
 
-    if (self->tail == head) {
+    if (tail == head) {
         return NULL;
     }
     sz = get_sz(p);
     if (sz >= 0x80000000) {
         // rollover
-        if (head > self->tail) {
+        if (head > tail) {
             JLS_LOGE("buffer overflow"); // should never be possible
-            jls_mrb_clear(self);
+            seg->head_pending = 0;
+            mrb_store(&seg->head, 0);
+            mrb_store(&seg->tail, 0);
             return NULL;
         }
-        self->tail = 0;
-        if (self->tail == head) {
+        mrb_store(&seg->tail, 0);
+        if (0 == head) {
             return NULL;
         }
-        p = self->buf;
+        p = seg->buf;
         sz = get_sz(p);
     }
     *size = sz;
     return (p + 4);
 }
 
+uint8_t * jls_mrb_peek(struct jls_mrb_s * self, uint32_t * size) {
+    struct jls_mrb_s * rd = self->rd;
+    while (1) {
+        uint8_t * p = seg_peek(rd, size);
+        if (NULL != p) {
+            return p;
+        }
+        struct jls_mrb_s * next = mrb_load_ptr(&rd->next);
+        if (NULL == next) {
+            return NULL;
+        }
+        // fully drained, and the producer moved on: release this segment
+        if (rd->owned) {
+            mrb_add(&self->overflow_bytes, -((int32_t) rd->owned));
+            free(rd);
+        } else {
+            rd->next = NULL;
+            mrb_store(&rd->idle, 1);
+        }
+        rd = next;
+        self->rd = rd;
+    }
+}
+
 
 uint8_t * jls_mrb_pop(struct jls_mrb_s * self, uint32_t * size) {
     uint8_t *p = jls_mrb_peek(self, size);
-    uint32_t tail = self->tail;
     if (p) {
-        tail += (4 + *size);
-        if (tail >= self->buf_size) {
-            tail -= self->buf_size;
-        }
-        if (self->count) {
-            --self->count;
+        struct jls_mrb_s * rd = self->rd;
+        uint32_t tail = rd->tail + 4 + *size;
+        if (tail >= rd->buf_size) {
+            tail -= rd->buf_size;
         }
+        mrb_add(&self->count, -1);
+        mrb_add(&self->used_bytes, -((int32_t) (4 + *size)));
+        mrb_store(&rd->tail, tail);
     }
-    self->tail = tail;
     return p;
 }
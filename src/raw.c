@@ -20,6 +20,8 @@
 #include "jls/ec.h"
 #include "jls/log.h"
 #include "jls/crc32c.h"
+#include "jls/xxh64.h"
+#include "jls/compress.h"
 #include "jls/version.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -30,7 +32,9 @@
 
 #define CRC_SIZE (4)
 #define HEADER_ALIGN (8)            // must be power of 2 and greater than CRC_SIZE
+#define CHUNK_ALIGN_DEFAULT (4096)  // page-aligned placement, see JLS_CHUNK_ALIGN
 #define SCAN_SIZE (4096)
+#define CHUNK_WALK_BUFFER_SIZE (1 << 20)  // see jls_raw_chunk_walk()
 #define CHUNK_BUFFER_SIZE  (1 << 24)
 static const uint8_t FILE_HDR[] = JLS_HEADER_IDENTIFICATION;
 
@@ -55,13 +59,79 @@ struct jls_raw_s {
     int64_t offset;                 // the offset for the current chunk
     uint32_t last_payload_length;   // the payload length for the last chunk in the file.
     uint8_t write_en;
+    uint8_t crc_verify;             // 1 (default) to verify payload CRC on read
     union jls_version_u version;
+
+    // optional payload compression, enabled by the JLS_COMPRESSION environment variable
+    uint8_t compression;            // the jls_compression_e method for appended data chunks
+    // optional fast payload checksum, enabled by the JLS_CHECKSUM_XXH environment variable
+    uint8_t checksum;               // the jls_checksum_e method for appended chunks
+    uint8_t * zbuf;                 // scratch for compress on write and decompress on read
+    uint32_t zbuf_alloc;            // the allocated size of zbuf
+    uint32_t payload_decoded_length;  // the delivered length for the current chunk's payload
+
+    // aligned chunk placement, enabled by the JLS_CHUNK_ALIGN environment variable
+    uint32_t chunk_align;           // chunk start alignment for data and summary chunks, 0 disables
+    uint8_t * pad_buf;              // zeroed payload scratch for JLS_TAG_PADDING chunks
+
+    // double-buffered append writes, enabled by the JLS_DOUBLE_BUFFER environment variable
+    uint8_t dbuf_en;                       // 0=synchronous writes, 1=double-buffered appends
+    uint8_t dbuf_idx;                      // the stage buffer for the next chunk
+    uint8_t * dbuf[2];                     // stage buffers holding header + payload + footer
+    uint32_t dbuf_alloc[2];                // the allocated size for each stage buffer
+    uint8_t * dbuf_wr_ptr;                 // the staged bytes being written
+    uint32_t dbuf_wr_length;               // the staged byte count being written
+    int64_t dbuf_end;                      // the predicted file end including in-flight writes
+    int32_t dbuf_rc;                       // the completion status for the in-flight write
+    struct jls_bk_thread_s * dbuf_thread;  // the in-flight write or NULL when idle
+
+    // hot-path performance counters, see jls_rd_counters() / jls_twr_counters()
+    uint64_t crc_bytes;       // bytes processed by CRC32C compute and verify
+    uint64_t chunk_wr_count;  // chunks written with jls_raw_wr()
 };
 
 static inline void invalidate_current_chunk(struct jls_raw_s * self) {
     self->hdr.tag = JLS_TAG_INVALID;
 }
 
+static void dbuf_write_fn(void * user_data) {
+    struct jls_raw_s * self = (struct jls_raw_s *) user_data;
+    self->dbuf_rc = jls_bk_fwrite(&self->backend, self->dbuf_wr_ptr, self->dbuf_wr_length);
+}
+
+/**
+ * @brief Wait for any in-flight double-buffered write to complete.
+ *
+ * @param self The raw instance.
+ * @return 0 or the in-flight write's error code.
+ *
+ * Must be called before any backend access that is not itself a
+ * double-buffered append: reads, seeks, rewrites, flush, and close.
+ * On return, the backend fpos and fend are authoritative again.
+ */
+static int32_t dbuf_drain(struct jls_raw_s * self) {
+    if (self->dbuf_thread) {
+        jls_bk_thread_join(self->dbuf_thread);
+        self->dbuf_thread = NULL;
+        if (self->dbuf_rc) {
+            return self->dbuf_rc;
+        }
+    }
+    return 0;
+}
+
+static int32_t zbuf_ensure(struct jls_raw_s * self, uint32_t size) {
+    if (self->zbuf_alloc < size) {
+        uint8_t * b = realloc(self->zbuf, size);
+        if (!b) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        self->zbuf = b;
+        self->zbuf_alloc = size;
+    }
+    return 0;
+}
+
 static inline uint32_t payload_size_on_disk(uint32_t payload_size) {
     if (!payload_size) {
         return 0;
@@ -108,7 +178,9 @@ static int32_t rd_file_header(struct jls_raw_s * self, struct jls_file_header_s
     }
 
     if (0 != memcmp(FILE_HDR, hdr->identification, sizeof(FILE_HDR))) {
-        JLS_LOGE("invalid file header identification");
+        // legacy JLS v1 captures use the pyjoulescope datafile container,
+        // which this library does not parse
+        JLS_LOGE("invalid file header identification: not a JLS v2 file");
         return JLS_ERROR_UNSUPPORTED_FILE;
     }
 
@@ -149,21 +221,20 @@ static int32_t read_verify(struct jls_raw_s * self) {
     return rc;
 }
 
-int32_t jls_raw_open(struct jls_raw_s ** instance, const char * path, const char * mode) {
+/**
+ * @brief Complete an open on an already-connected backend.
+ *
+ * @param self The raw instance with the backend open.
+ * @param mode The open mode: "w", "r", or "a".
+ * @return 0, JLS_ERROR_TRUNCATED, or error code.
+ *
+ * Handles the file header, and on success applies the optional
+ * environment-configured write features.  The caller must close
+ * the backend and free self on error.
+ */
+static int32_t raw_open_config(struct jls_raw_s * self, const char * mode) {
     int32_t rc = 0;
 
-    if (!instance || !path || !mode) {
-        return JLS_ERROR_PARAMETER_INVALID;
-    }
-    *instance = NULL;
-
-    struct jls_raw_s * self = calloc(1, sizeof(struct jls_raw_s));
-    if (!self) {
-        return JLS_ERROR_NOT_ENOUGH_MEMORY;
-    }
-    self->backend.fd = -1;
-    ROE(jls_bk_fopen(&self->backend, path, mode));
-
     switch (mode[0]) {
         case 'w':
             self->write_en = 1;
@@ -192,51 +263,424 @@ int32_t jls_raw_open(struct jls_raw_s ** instance, const char * path, const char
             rc = JLS_ERROR_PARAMETER_INVALID;
     }
 
+    if (rc && (rc != JLS_ERROR_TRUNCATED)) {
+        return rc;
+    } else {
+        if (self->write_en && (NULL == self->backend.uring)) {
+            // overlap chunk CRC computation with the previous chunk's write
+            const char * env = getenv("JLS_DOUBLE_BUFFER");
+            if (env && (env[0] != '0')) {
+                self->dbuf_en = 1;
+            }
+        }
+        if (self->write_en) {
+            // pad data and summary chunk starts to page boundaries:
+            // unset or "0" disables, "1" uses 4096, and any other
+            // power of 2 at least 64 is the alignment in bytes
+            const char * env_align = getenv("JLS_CHUNK_ALIGN");
+            if (env_align && (env_align[0] != '0')) {
+                long long align = atoll(env_align);
+                if ((align < (long long) (2 * sizeof(struct jls_chunk_header_s)))
+                        || (align & (align - 1))) {
+                    align = CHUNK_ALIGN_DEFAULT;
+                }
+                self->pad_buf = calloc(1, (size_t) align);
+                if (self->pad_buf) {
+                    self->chunk_align = (uint32_t) align;
+                }
+            }
+        }
+        if (self->write_en) {
+            const char * env = getenv("JLS_COMPRESSION");
+            if (env && (env[0] != '0')) {
+                uint8_t method = JLS_COMPRESSION_RLE;
+                if (0 == strcmp(env, "zstd")) {
+                    method = JLS_COMPRESSION_ZSTD;
+                } else if (0 == strcmp(env, "lz4")) {
+                    method = JLS_COMPRESSION_LZ4;
+                }
+                if (jls_compression_available(method)) {
+                    self->compression = method;
+                } else {
+                    JLS_LOGW("JLS_COMPRESSION=%s not available in this build", env);
+                }
+            }
+            env = getenv("JLS_CHECKSUM_XXH");
+            if (env && (env[0] != '0')) {
+                self->checksum = JLS_CHECKSUM_XXH64;
+            }
+        }
+    }
+    return rc;
+}
+
+int32_t jls_raw_open(struct jls_raw_s ** instance, const char * path, const char * mode) {
+    int32_t rc = 0;
+
+    if (!instance || !path || !mode) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    *instance = NULL;
+
+    struct jls_raw_s * self = calloc(1, sizeof(struct jls_raw_s));
+    if (!self) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    self->backend.fd = -1;
+    self->crc_verify = 1;
+    rc = jls_bk_fopen(&self->backend, path, mode);
+    if (rc) {
+        free(self);
+        return rc;
+    }
+
+    rc = raw_open_config(self, mode);
     if (rc && (rc != JLS_ERROR_TRUNCATED)) {
         jls_bk_fclose(&self->backend);
         free(self);
-    } else {
-        *instance = self;
+        return rc;
+    }
+    *instance = self;
+    return rc;
+}
+
+int32_t jls_raw_open_mem(struct jls_raw_s ** instance, struct jls_mem_s * mem, const char * mode) {
+    int32_t rc = 0;
+
+    if (!instance || !mem || !mode) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    *instance = NULL;
+
+    struct jls_raw_s * self = calloc(1, sizeof(struct jls_raw_s));
+    if (!self) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    self->backend.fd = -1;
+    self->crc_verify = 1;
+    self->backend.ops = &jls_bk_mem_ops;
+    self->backend.user_data = mem;
+    rc = jls_bk_mem_ops.open(&self->backend, NULL, mode);
+    if (rc) {
+        free(self);
+        return rc;
     }
+
+    rc = raw_open_config(self, mode);
+    if (rc && (rc != JLS_ERROR_TRUNCATED)) {
+        jls_bk_fclose(&self->backend);
+        free(self);
+        return rc;
+    }
+    *instance = self;
     return rc;
 }
 
 int32_t jls_raw_close(struct jls_raw_s * self) {
     if (self) {
-        if ((self->backend.fd != -1) && (self->write_en)) {
+        int32_t rc = dbuf_drain(self);
+        if (rc) {
+            JLS_LOGE("close: in-flight write failed %d", rc);
+        }
+        if (((self->backend.fd != -1) || self->backend.ops) && (self->write_en)) {
             wr_file_header(self);
         }
         jls_bk_fclose(&self->backend);
+        if (self->dbuf[0]) {
+            free(self->dbuf[0]);
+        }
+        if (self->dbuf[1]) {
+            free(self->dbuf[1]);
+        }
+        if (self->zbuf) {
+            free(self->zbuf);
+        }
+        if (self->pad_buf) {
+            free(self->pad_buf);
+        }
         free(self);
     }
     return 0;
 }
 
+int32_t jls_raw_mmap_enable(struct jls_raw_s * self) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (self->write_en) {
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    return jls_bk_mmap(&self->backend);
+}
+
 union jls_version_u jls_raw_version(struct jls_raw_s * self) {
     return self->version;
 }
 
 struct jls_bkf_s * jls_raw_backend(struct jls_raw_s * self) {
-    if (self->backend.fd == -1) {
+    if ((self->backend.fd == -1) && (NULL == self->backend.ops)) {
         return NULL;
     }
+    dbuf_drain(self);
     return &self->backend;
 }
 
+uint64_t jls_raw_crc_bytes(struct jls_raw_s * self) {
+    return self->crc_bytes;
+}
+
+uint64_t jls_raw_chunk_wr_count(struct jls_raw_s * self) {
+    return self->chunk_wr_count;
+}
+
+uint8_t jls_raw_compression_get(struct jls_raw_s * self) {
+    return self->compression;
+}
+
+// Compute the payload check value using the jls_checksum_e method
+// declared in the chunk header.
+static uint32_t payload_check(struct jls_raw_s * self, const struct jls_chunk_header_s * hdr,
+                              const uint8_t * payload, uint32_t length) {
+    self->crc_bytes += length;
+    if (JLS_CHECKSUM_XXH64 == (hdr->compression >> JLS_CHECKSUM_SHIFT)) {
+        return (uint32_t) jls_xxh64(payload, length);
+    }
+    return jls_crc32c(payload, length);
+}
+
+static int32_t dbuf_wr(struct jls_raw_s * self, struct jls_chunk_header_s * hdr, const uint8_t * payload) {
+    uint32_t payload_sz = payload_size_on_disk(hdr->payload_length);
+    uint32_t total = (uint32_t) sizeof(*hdr) + payload_sz;
+    if (hdr->payload_length && !payload) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+
+    uint8_t idx = self->dbuf_idx;
+    if (self->dbuf_alloc[idx] < total) {
+        uint8_t * b = realloc(self->dbuf[idx], total);
+        if (!b) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        self->dbuf[idx] = b;
+        self->dbuf_alloc[idx] = total;
+    }
+
+    // stage and CRC this chunk while the previous chunk's write is in flight
+    hdr->payload_prev_length = self->last_payload_length;
+    hdr->crc32 = jls_crc32c_hdr(hdr);
+    self->crc_bytes += sizeof(*hdr) - CRC_SIZE;
+    uint8_t * b = self->dbuf[idx];
+    memcpy(b, hdr, sizeof(*hdr));
+    if (hdr->payload_length) {
+        memcpy(b + sizeof(*hdr), payload, hdr->payload_length);
+        uint8_t pad = (uint8_t) ((hdr->payload_length + CRC_SIZE) & (HEADER_ALIGN - 1));
+        if (pad != 0) {
+            pad = HEADER_ALIGN - pad;
+        }
+        uint32_t crc32 = payload_check(self, hdr, payload, hdr->payload_length);
+        uint8_t * f = b + sizeof(*hdr) + hdr->payload_length;
+        memset(f, 0, pad);
+        f[pad + 0] = crc32 & 0xff;
+        f[pad + 1] = (crc32 >> 8) & 0xff;
+        f[pad + 2] = (crc32 >> 16) & 0xff;
+        f[pad + 3] = (crc32 >> 24) & 0xff;
+    }
+
+    RLE(dbuf_drain(self));
+
+    self->dbuf_wr_ptr = b;
+    self->dbuf_wr_length = total;
+    self->dbuf_idx = idx ^ 1;
+    self->last_payload_length = hdr->payload_length;
+    invalidate_current_chunk(self);
+    self->dbuf_end += total;
+    self->offset = self->dbuf_end;
+    RLE(jls_bk_thread_run(&self->dbuf_thread, dbuf_write_fn, self));
+    return 0;
+}
+
+// Write header, payload, and footer with one scatter-gather operation.
+static int32_t wr_gather(struct jls_raw_s * self, struct jls_chunk_header_s * hdr, const uint8_t * payload) {
+    RLE(dbuf_drain(self));
+    if (hdr->payload_length && !payload) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (self->backend.fpos >= self->backend.fend) {
+        hdr->payload_prev_length = self->last_payload_length;
+    }
+    hdr->crc32 = jls_crc32c_hdr(hdr);
+    self->crc_bytes += sizeof(*hdr) - CRC_SIZE;
+    if (self->offset != self->backend.fpos) {
+        invalidate_current_chunk(self);
+        RLE(jls_bk_fseek(&self->backend, self->offset, SEEK_SET));
+    }
+
+    uint8_t footer[CRC_SIZE + HEADER_ALIGN];
+    struct jls_bk_iovec_s iov[3] = {
+            {.base = hdr, .length = sizeof(*hdr)},
+    };
+    int iov_count = 1;
+    if (hdr->payload_length) {
+        uint8_t pad = (uint8_t) ((hdr->payload_length + CRC_SIZE) & (HEADER_ALIGN - 1));
+        if (pad != 0) {
+            pad = HEADER_ALIGN - pad;
+        }
+        memset(footer, 0, sizeof(footer));
+        uint32_t crc32 = payload_check(self, hdr, payload, hdr->payload_length);
+        footer[pad + 0] = crc32 & 0xff;
+        footer[pad + 1] = (crc32 >> 8) & 0xff;
+        footer[pad + 2] = (crc32 >> 16) & 0xff;
+        footer[pad + 3] = (crc32 >> 24) & 0xff;
+        iov[1].base = payload;
+        iov[1].length = hdr->payload_length;
+        iov[2].base = footer;
+        iov[2].length = pad + CRC_SIZE;
+        iov_count = 3;
+    }
+    RLE(jls_bk_fwritev(&self->backend, iov, iov_count));
+    self->hdr = *hdr;
+    if (self->backend.fpos >= self->backend.fend) {
+        self->last_payload_length = hdr->payload_length;
+    }
+    return 0;
+}
+
+/**
+ * @brief Compress a chunk payload when it saves space.
+ *
+ * @param self The raw instance with compression enabled.
+ * @param[inout] hdr The chunk header, updated in place on success so that
+ *      callers retaining the header for later rewrite match the disk contents.
+ * @param payload The uncompressed payload.
+ * @return The payload to write: the compressed scratch buffer on
+ *      success, or the original payload unchanged when compression
+ *      does not shrink this chunk or scratch allocation fails.
+ *
+ * Only chunks that are appended exactly once may compress: head and
+ * offset chunks are rewritten in place with the same payload length,
+ * which a changed compressed size would corrupt.
+ */
+static const uint8_t * wr_compress(struct jls_raw_s * self, struct jls_chunk_header_s * hdr,
+                                   const uint8_t * payload) {
+    uint32_t bound = jls_compress_bound(self->compression, hdr->payload_length);
+    if (!bound || zbuf_ensure(self, bound + 4)) {
+        return payload;
+    }
+    int32_t sz = jls_compress(self->compression, payload, hdr->payload_length,
+                              self->zbuf + 4, self->zbuf_alloc - 4);
+    if ((sz <= 0) || (((uint32_t) sz + 4) >= hdr->payload_length)) {
+        return payload;  // not smaller: store this chunk uncompressed
+    }
+    self->zbuf[0] = hdr->payload_length & 0xff;
+    self->zbuf[1] = (hdr->payload_length >> 8) & 0xff;
+    self->zbuf[2] = (hdr->payload_length >> 16) & 0xff;
+    self->zbuf[3] = (hdr->payload_length >> 24) & 0xff;
+    hdr->compression = self->compression;
+    hdr->payload_length = (uint32_t) sz + 4;
+    return self->zbuf;
+}
+
+/**
+ * @brief Pad the file so the next chunk starts on a chunk_align boundary.
+ *
+ * @param self The raw instance with chunk_align enabled.
+ * @return 0 or error code.
+ *
+ * The gap fills with a zeroed JLS_TAG_PADDING chunk, which keeps
+ * back-to-back chunk navigation intact.  When the gap cannot hold a
+ * chunk header, the padding extends one full alignment unit.
+ */
+static int32_t wr_align_pad(struct jls_raw_s * self) {
+    uint32_t align = self->chunk_align;
+    uint32_t gap = (uint32_t) ((align - (self->offset & (align - 1))) & (align - 1));
+    if (!gap) {
+        return 0;
+    }
+    if (gap < sizeof(struct jls_chunk_header_s)) {
+        gap += align;
+    }
+    struct jls_chunk_header_s hdr = {
+            .item_next = 0,
+            .item_prev = 0,
+            .tag = JLS_TAG_PADDING,
+            .compression = JLS_COMPRESSION_NONE,
+            .chunk_meta = 0,
+            .payload_length = (gap == sizeof(struct jls_chunk_header_s)) ? 0 :
+                    (gap - (uint32_t) sizeof(struct jls_chunk_header_s) - CRC_SIZE),
+            .payload_prev_length = 0,
+            .crc32 = 0,
+    };
+    return jls_raw_wr(self, &hdr, self->pad_buf);
+}
+
+int32_t jls_raw_align(struct jls_raw_s * self) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (!self->chunk_align) {
+        return 0;
+    }
+    if (!self->dbuf_thread && (self->offset < self->backend.fend)) {
+        return 0;  // rewrite of an existing chunk: position is fixed
+    }
+    return wr_align_pad(self);
+}
+
 int32_t jls_raw_wr(struct jls_raw_s * self, struct jls_chunk_header_s * hdr, const uint8_t * payload) {
     JLS_LOGD3("wr @ %" PRId64 " : %d %s", jls_raw_chunk_tell(self), (int) hdr->tag, jls_tag_to_name(hdr->tag));
-    RLE(jls_raw_wr_header(self, hdr));
-    RLE(jls_raw_wr_payload(self, hdr->payload_length, payload));
+    if (self->compression && (hdr->payload_length > sizeof(struct jls_chunk_header_s))
+            && ((hdr->tag == JLS_TAG_TRACK_FSR_DATA) || (hdr->tag == JLS_TAG_TRACK_FSR_SUMMARY))) {
+        payload = wr_compress(self, hdr, payload);
+    }
+    hdr->compression = (uint8_t) ((hdr->compression & JLS_COMPRESSION_METHOD_MASK)
+            | (self->checksum << JLS_CHECKSUM_SHIFT));
+    if (self->dbuf_en) {
+        if (self->dbuf_thread) {
+            // in flight implies uninterrupted sequential append
+            RLE(dbuf_wr(self, hdr, payload));
+            self->chunk_wr_count += 1;
+            return 0;
+        } else if ((self->offset == self->backend.fend) && (self->offset == self->backend.fpos)) {
+            self->dbuf_end = self->backend.fend;
+            RLE(dbuf_wr(self, hdr, payload));
+            self->chunk_wr_count += 1;
+            return 0;
+        }
+        // rewrite of an existing chunk: use the synchronous path
+    }
+    RLE(wr_gather(self, hdr, payload));
     invalidate_current_chunk(self);
     self->offset = self->backend.fpos;
+    self->chunk_wr_count += 1;
     return 0;
 }
 
 int32_t jls_raw_wr_header(struct jls_raw_s * self, struct jls_chunk_header_s * hdr) {
+    RLE(dbuf_drain(self));
     if (self->backend.fpos >= self->backend.fend) {
         hdr->payload_prev_length = self->last_payload_length;
     }
     hdr->crc32 = jls_crc32c_hdr(hdr);
+    self->crc_bytes += sizeof(*hdr) - CRC_SIZE;
+    if (self->offset != self->backend.fpos) {
+        invalidate_current_chunk(self);
+        RLE(jls_bk_fseek(&self->backend, self->offset, SEEK_SET));
+    }
+    if (jls_bk_fwrite(&self->backend, hdr, sizeof(*hdr))) {
+        return JLS_ERROR_IO;
+    }
+    self->hdr = *hdr;
+    return 0;
+}
+
+int32_t jls_raw_wr_header_prechecked(struct jls_raw_s * self, struct jls_chunk_header_s * hdr) {
+    RLE(dbuf_drain(self));
+    if (self->backend.fpos >= self->backend.fend) {
+        // appending updates payload_prev_length, which invalidates the
+        // caller's CRC: take the recomputing path
+        return jls_raw_wr_header(self, hdr);
+    }
+    self->crc_bytes += sizeof(*hdr) - CRC_SIZE;  // computed by the caller
     if (self->offset != self->backend.fpos) {
         invalidate_current_chunk(self);
         RLE(jls_bk_fseek(&self->backend, self->offset, SEEK_SET));
@@ -252,6 +696,7 @@ int32_t jls_raw_wr_payload(struct jls_raw_s * self, uint32_t payload_length, con
     if (!self) {
         return JLS_ERROR_PARAMETER_INVALID;
     }
+    RLE(dbuf_drain(self));
     struct jls_chunk_header_s * hdr = &self->hdr;
     if (hdr->tag == JLS_TAG_INVALID) {
         RLE(jls_raw_rd_header(self, hdr));
@@ -269,7 +714,7 @@ int32_t jls_raw_wr_payload(struct jls_raw_s * self, uint32_t payload_length, con
     if (pad != 0) {
         pad = HEADER_ALIGN - pad;
     }
-    uint32_t crc32 = jls_crc32c(payload, hdr->payload_length);
+    uint32_t crc32 = payload_check(self, hdr, payload, hdr->payload_length);
     footer[pad + 0] = crc32 & 0xff;
     footer[pad + 1] = (crc32 >> 8) & 0xff;
     footer[pad + 2] = (crc32 >> 16) & 0xff;
@@ -291,6 +736,7 @@ int32_t jls_raw_rd(struct jls_raw_s * self, struct jls_chunk_header_s * hdr, uin
 }
 
 int32_t jls_raw_rd_header(struct jls_raw_s * self, struct jls_chunk_header_s * hdr) {
+    RLE(dbuf_drain(self));
     struct jls_chunk_header_s * h = &self->hdr;
     if (hdr) {
         hdr->tag = JLS_TAG_INVALID;
@@ -314,6 +760,7 @@ int32_t jls_raw_rd_header(struct jls_raw_s * self, struct jls_chunk_header_s * h
             return JLS_ERROR_EMPTY;
         }
         uint32_t crc32 = jls_crc32c_hdr(h);
+        self->crc_bytes += sizeof(*h) - CRC_SIZE;
         if (crc32 != h->crc32) {
             JLS_LOGW("chunk header fpos=%" PRIi64 " crc error: %u != %u",
                      self->backend.fpos, crc32, h->crc32);
@@ -330,20 +777,35 @@ int32_t jls_raw_rd_header(struct jls_raw_s * self, struct jls_chunk_header_s * h
 int32_t jls_raw_rd_payload(struct jls_raw_s * self, uint32_t payload_length_max, uint8_t * payload) {
     uint32_t crc32_file;
     uint32_t crc32_calc;
+    RLE(dbuf_drain(self));
     struct jls_chunk_header_s * hdr = &self->hdr;
     if (hdr->tag == JLS_TAG_INVALID) {
         RLE(jls_raw_rd_header(self, hdr));
     }
     if (0 == hdr->payload_length) {
+        self->payload_decoded_length = 0;
         invalidate_current_chunk(self);
         self->offset = self->backend.fpos;
         return 0;
     }
 
     uint32_t rd_size = payload_size_on_disk(hdr->payload_length);
+    uint8_t * rd_buf = payload;
+    uint8_t method = hdr->compression & JLS_COMPRESSION_METHOD_MASK;
 
-    if (rd_size > payload_length_max) {
-        return JLS_ERROR_TOO_BIG;
+    if (JLS_COMPRESSION_NONE == method) {
+        self->payload_decoded_length = hdr->payload_length;
+        if (rd_size > payload_length_max) {
+            return JLS_ERROR_TOO_BIG;
+        }
+    } else {
+        // read and CRC the compressed bytes in scratch, then decompress into payload
+        if (hdr->payload_length <= 4) {
+            JLS_LOGE("compressed payload too short: %" PRIu32, hdr->payload_length);
+            return JLS_ERROR_MESSAGE_INTEGRITY;
+        }
+        ROE(zbuf_ensure(self, rd_size));
+        rd_buf = self->zbuf;
     }
 
     int64_t pos = self->offset + sizeof(struct jls_chunk_header_s);
@@ -352,22 +814,51 @@ int32_t jls_raw_rd_payload(struct jls_raw_s * self, uint32_t payload_length_max,
         self->backend.fpos = pos;
     }
 
-    RLE(jls_bk_fread(&self->backend, (uint8_t *) payload, rd_size));
-    crc32_calc = jls_crc32c(payload, hdr->payload_length);
-    crc32_file = ((uint32_t)payload[rd_size - 4])
-        | (((uint32_t)payload[rd_size - 3]) << 8)
-        | (((uint32_t)payload[rd_size - 2]) << 16)
-        | (((uint32_t)payload[rd_size - 1]) << 24);
-    if (crc32_calc != crc32_file) {
-        JLS_LOGE("crc32 mismatch: 0x%08x != 0x%08x", crc32_file, crc32_calc);
-        return JLS_ERROR_MESSAGE_INTEGRITY;
+    RLE(jls_bk_fread(&self->backend, rd_buf, rd_size));
+    if (self->crc_verify) {
+        crc32_calc = payload_check(self, hdr, rd_buf, hdr->payload_length);
+        crc32_file = ((uint32_t)rd_buf[rd_size - 4])
+            | (((uint32_t)rd_buf[rd_size - 3]) << 8)
+            | (((uint32_t)rd_buf[rd_size - 2]) << 16)
+            | (((uint32_t)rd_buf[rd_size - 1]) << 24);
+        if (crc32_calc != crc32_file) {
+            JLS_LOGE("crc32 mismatch: 0x%08x != 0x%08x", crc32_file, crc32_calc);
+            return JLS_ERROR_MESSAGE_INTEGRITY;
+        }
+    }
+
+    if (JLS_COMPRESSION_NONE != method) {
+        uint32_t decoded = ((uint32_t) rd_buf[0])
+            | (((uint32_t) rd_buf[1]) << 8)
+            | (((uint32_t) rd_buf[2]) << 16)
+            | (((uint32_t) rd_buf[3]) << 24);
+        self->payload_decoded_length = decoded;
+        if (decoded > payload_length_max) {
+            // caller resizes by jls_raw_payload_decoded_length() and retries
+            return JLS_ERROR_TOO_BIG;
+        }
+        RLE(jls_decompress(method, rd_buf + 4, hdr->payload_length - 4,
+                           payload, decoded));
     }
     invalidate_current_chunk(self);
     self->offset = self->backend.fpos;
     return 0;
 }
 
+uint32_t jls_raw_payload_decoded_length(struct jls_raw_s * self) {
+    return self->payload_decoded_length;
+}
+
+int32_t jls_raw_crc_verify_set(struct jls_raw_s * self, uint8_t enable) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    self->crc_verify = enable ? 1 : 0;
+    return 0;
+}
+
 int32_t jls_raw_chunk_seek(struct jls_raw_s * self, int64_t offset) {
+    RLE(dbuf_drain(self));
     invalidate_current_chunk(self);
     if (offset == 0) {
         JLS_LOGW("seek to 0");
@@ -406,6 +897,7 @@ int32_t jls_raw_chunk_scan(struct jls_raw_s * self) {
         while (sz >= sizeof(struct jls_chunk_header_s)) {
             struct jls_chunk_header_s * hdr = (struct jls_chunk_header_s *) b;
             uint32_t crc32 = jls_crc32c_hdr(hdr);
+            self->crc_bytes += sizeof(*hdr) - CRC_SIZE;
             if (crc32 == hdr->crc32) {
                 return jls_raw_chunk_seek(self, offset);
             }
@@ -419,6 +911,7 @@ int32_t jls_raw_chunk_scan(struct jls_raw_s * self) {
 }
 
 int32_t jls_raw_seek_end(struct jls_raw_s * self) {
+    RLE(dbuf_drain(self));
     invalidate_current_chunk(self);
     if (jls_bk_fseek(&self->backend, 0, SEEK_END)) {
         return JLS_ERROR_IO;
@@ -432,6 +925,7 @@ int64_t jls_raw_chunk_tell(struct jls_raw_s * self) {
 }
 
 int32_t jls_raw_flush(struct jls_raw_s * self) {
+    RLE(dbuf_drain(self));
     return jls_bk_fflush(&self->backend);
 }
 
@@ -455,6 +949,7 @@ int32_t jls_raw_chunk_next(struct jls_raw_s * self) {
 }
 
 int32_t jls_raw_chunk_prev(struct jls_raw_s * self) {
+    RLE(dbuf_drain(self));
     if (self->backend.fpos >= self->backend.fend) {
         invalidate_current_chunk(self);
         return JLS_ERROR_NOT_FOUND;
@@ -475,6 +970,66 @@ int32_t jls_raw_chunk_prev(struct jls_raw_s * self) {
     return 0;
 }
 
+int32_t jls_raw_chunk_walk(struct jls_raw_s * self, int64_t offset,
+                           jls_raw_chunk_walk_fn fn, void * user_data) {
+    if ((NULL == self) || (NULL == fn)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    RLE(dbuf_drain(self));
+    invalidate_current_chunk(self);
+    if (offset <= 0) {
+        offset = sizeof(struct jls_file_header_s);
+    }
+    const int64_t fend = self->backend.fend;
+    const int64_t hdr_sz = sizeof(struct jls_chunk_header_s);
+    uint8_t * buffer = malloc(CHUNK_WALK_BUFFER_SIZE);
+    if (NULL == buffer) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    int64_t extent_offset = 0;
+    int64_t extent_length = 0;
+    int32_t rc = 0;
+    struct jls_chunk_header_s hdr;
+    while ((offset + hdr_sz) <= fend) {
+        if ((offset < extent_offset) || ((offset + hdr_sz) > (extent_offset + extent_length))) {
+            // refill: one large read serves the headers of many chunks
+            extent_offset = offset;
+            extent_length = fend - offset;
+            if (extent_length > CHUNK_WALK_BUFFER_SIZE) {
+                extent_length = CHUNK_WALK_BUFFER_SIZE;
+            }
+            if (jls_bk_fseek(&self->backend, offset, SEEK_SET)) {
+                rc = JLS_ERROR_IO;
+                break;
+            }
+            self->backend.fpos = offset;
+            if (jls_bk_fread(&self->backend, buffer, (unsigned) extent_length)) {
+                rc = JLS_ERROR_IO;
+                break;
+            }
+        }
+        memcpy(&hdr, buffer + (offset - extent_offset), sizeof(hdr));
+        uint32_t crc32 = jls_crc32c_hdr(&hdr);
+        self->crc_bytes += sizeof(hdr) - CRC_SIZE;
+        if (crc32 != hdr.crc32) {
+            JLS_LOGW("chunk header fpos=%" PRIi64 " crc error: %u != %u",
+                     offset, crc32, hdr.crc32);
+            rc = JLS_ERROR_MESSAGE_INTEGRITY;
+            break;
+        }
+        rc = fn(user_data, offset, &hdr);
+        if (rc || (JLS_TAG_END == hdr.tag)) {
+            break;
+        }
+        offset += hdr_sz + payload_size_on_disk(hdr.payload_length);
+    }
+    free(buffer);
+    // the extent reads moved the backend position; leave a coherent
+    // chunk position, the caller seeks before the next read anyway
+    self->offset = self->backend.fpos;
+    return rc;
+}
+
 int32_t jls_raw_item_next(struct jls_raw_s * self) {
     RLE(jls_raw_rd_header(self, NULL));  // ensure that we have the header
     int64_t offset = self->hdr.item_next;
@@ -492,6 +1047,7 @@ int32_t jls_raw_item_next(struct jls_raw_s * self) {
 }
 
 int32_t jls_raw_item_prev(struct jls_raw_s * self) {
+    RLE(dbuf_drain(self));
     if (self->backend.fpos >= self->backend.fend) {
         invalidate_current_chunk(self);
         return JLS_ERROR_NOT_FOUND;
@@ -554,6 +1110,15 @@ const char * jls_tag_to_name(uint8_t tag) {
         case JLS_TAG_TRACK_UTC_INDEX:           return "track_utc_index";
         case JLS_TAG_TRACK_UTC_SUMMARY:         return "track_utc_summary";
         case JLS_TAG_USER_DATA:                 return "user_data";
+        case JLS_TAG_SEEK_INDEX:                return "seek_index";
+        case JLS_TAG_UTC_TMAP:                  return "utc_tmap";
+        case JLS_TAG_PADDING:                   return "padding";
+        case JLS_TAG_DIRECTORY:                 return "directory";
+        case JLS_TAG_CHECKPOINT:                return "checkpoint";
+        case JLS_TAG_LINK_TABLE:                return "link_table";
+        case JLS_TAG_SUMMARY_PREVIEW:           return "summary_preview";
+        case JLS_TAG_CHUNK_CLOCK:               return "chunk_clock";
+        case JLS_TAG_DATA_MAP:                  return "data_map";
         case JLS_TAG_END:                       return "end";
         default:                                return "unknown";
     }
@@ -15,8 +15,13 @@
  */
 
 #include "jls/reader.h"
+#include "jls/writer.h"
 #include "jls/core.h"
 #include "jls/backend.h"
+#include "jls/chunk_cache.h"
+#include "jls/shared_cache.h"
+#include "jls/xxh64.h"
+#include "jls/stat_cache.h"
 #include "jls/raw.h"
 #include "jls/track.h"
 #include "jls/format.h"
@@ -27,6 +32,7 @@
 #include "jls/tmap.h"
 #include "jls/buffer.h"
 #include "jls/statistics.h"
+#include "jls/time.h"
 #include "jls/util.h"
 #include <inttypes.h>
 #include <math.h>
@@ -40,10 +46,110 @@
 #define DECIMATE_PER_DURATION (25)
 
 
+// one segment of a multi-file virtual dataset, see jls_rd_open_multi()
+struct jls_rd_mseg_s {
+    char * path;            // NULL for entry 0, which aliases the parent
+    struct jls_rd_s * rd;   // lazily opened
+};
+
 struct jls_rd_s {
     struct jls_core_s core;
+    char * path;        // for opening batch worker readers
+    bool mmap_enable;
+    bool follow;
+    bool metadata_only;
+    struct jls_rd_s * batch_rd[JLS_RD_FSR_BATCH_WORKERS_MAX];  // worker 0 uses self, lazily opened
+    struct rd_prefetch_s * prefetch;  // background prefetch worker, see jls_rd_prefetch()
+    struct rd_async_s * fsr_async;    // background completion worker, see jls_rd_fsr_async()
+
+    // asynchronous open, see jls_rd_open_async()
+    struct jls_bk_thread_s * open_thread;  // the background open or NULL
+    jls_rd_open_async_fn open_fn;
+    void * open_user_data;
+    volatile int32_t open_rc;              // the completed open status
+    volatile uint8_t open_done;            // 1 when the background open completed
+    volatile uint8_t open_defs_ready;      // 1 once source & signal defs are loaded
+
+    // multi-file virtual dataset, see jls_rd_open_multi()
+    struct jls_rd_mseg_s * msegs;  // the ordered segments, NULL for single-file readers
+    uint16_t mseg_count;
+
+    // deferred CRC verification, see jls_rd_crc_defer()
+    struct jls_raw_s * scan_raw;           // second handle for the background scan
+    struct jls_bk_thread_s * scan_thread;  // the background scan or NULL
+    jls_rd_integrity_fn scan_fn;
+    void * scan_user_data;
+    volatile uint8_t scan_quit;            // 1 to stop the scan at the next chunk
+
+    struct jls_rd_open_profile_s open_profile;  // see jls_rd_open_profile_get()
+    struct jls_rd_query_profile_s query_profile;  // see jls_rd_query_profile_get()
+
+    struct jls_stat_cache_s * stat_cache;  // see jls_rd_stat_cache(), NULL when disabled
+};
+
+static void rd_prefetch_stop(struct jls_rd_s * self);
+static void rd_async_stop(struct jls_rd_s * self);
+
+// one phase measurement for the open profile, see open_phase_start()
+struct open_phase_s {
+    int64_t t_start;
+    uint64_t bytes;
+    uint64_t seeks;
 };
 
+static void open_phase_start(struct jls_rd_s * self, struct open_phase_s * p) {
+    struct jls_bkf_s * backend = jls_raw_backend(self->core.raw);
+    p->t_start = jls_now();
+    p->bytes = (NULL != backend) ? jls_bk_counter_load(&backend->bytes_read) : 0;
+    p->seeks = (NULL != backend) ? jls_bk_counter_load(&backend->seek_count) : 0;
+}
+
+static void open_phase_end(struct jls_rd_s * self, struct open_phase_s * p,
+                           enum jls_rd_open_phase_e phase) {
+    struct jls_bkf_s * backend = jls_raw_backend(self->core.raw);
+    uint64_t bytes = (NULL != backend) ? jls_bk_counter_load(&backend->bytes_read) : 0;
+    uint64_t seeks = (NULL != backend) ? jls_bk_counter_load(&backend->seek_count) : 0;
+    self->open_profile.duration_us[phase] +=
+            (uint64_t) ((jls_now() - p->t_start) / JLS_TIME_MICROSECOND);
+    // a smaller end count means the phase reopened the file, which
+    // restarts the backend counters: count only the new handle
+    self->open_profile.bytes_read[phase] += (bytes >= p->bytes) ? (bytes - p->bytes) : bytes;
+    self->open_profile.seeks[phase] += (seeks >= p->seeks) ? (seeks - p->seeks) : seeks;
+}
+
+
+// physical I/O over every handle a query may touch,
+// for the per-query profile, see jls_rd_query_profile_get()
+static void query_counters(struct jls_rd_s * self, uint64_t * bytes, uint64_t * seeks) {
+    struct jls_bkf_s * backend = jls_raw_backend(self->core.raw);
+    if (NULL != backend) {
+        *bytes += jls_bk_counter_load(&backend->bytes_read);
+        *seeks += jls_bk_counter_load(&backend->seek_count);
+    }
+    for (uint32_t i = 1; i < JLS_RD_FSR_BATCH_WORKERS_MAX; ++i) {
+        if (NULL != self->batch_rd[i]) {
+            query_counters(self->batch_rd[i], bytes, seeks);
+        }
+    }
+    for (uint16_t i = 1; i < self->mseg_count; ++i) {
+        if (NULL != self->msegs[i].rd) {
+            query_counters(self->msegs[i].rd, bytes, seeks);
+        }
+    }
+}
+
+static void query_profile_end(struct jls_rd_s * self, uint64_t bytes_start, uint64_t seeks_start,
+                              uint64_t logical_bytes) {
+    uint64_t bytes = 0;
+    uint64_t seeks = 0;
+    query_counters(self, &bytes, &seeks);
+    self->query_profile.logical_bytes = logical_bytes;
+    // handles opened during the query start their counters at zero,
+    // so the sum only ever grows
+    self->query_profile.physical_bytes = (bytes >= bytes_start) ? (bytes - bytes_start) : bytes;
+    self->query_profile.seeks = (seeks >= seeks_start) ? (seeks - seeks_start) : seeks;
+}
+
 
 #define GOE(x)  do { \
     rc = (x);                           \
@@ -53,7 +159,10 @@ struct jls_rd_s {
 } while (0)
 
 
-int32_t jls_rd_open(struct jls_rd_s ** instance, const char * path) {
+// allocate the instance and open the file through header validation
+static int32_t rd_start(struct jls_rd_s ** instance, const char * path, bool mmap_enable,
+                        bool follow, bool metadata_only,
+                        jls_rd_progress_fn progress_fn, void * progress_user_data) {
     int32_t rc = 0;
     if (!instance) {
         return JLS_ERROR_PARAMETER_INVALID;
@@ -64,6 +173,18 @@ int32_t jls_rd_open(struct jls_rd_s ** instance, const char * path) {
         return JLS_ERROR_NOT_ENOUGH_MEMORY;
     }
 
+    self->mmap_enable = mmap_enable;
+    self->follow = follow;
+    self->metadata_only = metadata_only;
+    self->core.progress_fn = progress_fn;
+    self->core.progress_user_data = progress_user_data;
+    self->core.progress_phase = JLS_RD_PHASE_OPEN;
+    self->path = malloc(strlen(path) + 1);
+    if (!self->path) {
+        GOE(JLS_ERROR_NOT_ENOUGH_MEMORY);
+    }
+    memcpy(self->path, path, strlen(path) + 1);
+
     struct jls_core_s * core = &self->core;
     core->buf = jls_buf_alloc();
     if (!core->buf) {
@@ -86,22 +207,79 @@ int32_t jls_rd_open(struct jls_rd_s ** instance, const char * path) {
     if (rc && (rc != JLS_ERROR_TRUNCATED)) {
         goto exit;
     }
+    if (mmap_enable && jls_raw_mmap_enable(core->raw)) {
+        JLS_LOGW("mmap unavailable, using normal reads");
+    }
+    *instance = self;
+    return 0;
+
+exit:
+    jls_rd_close(self);
+    return rc;
+}
 
-    GOE(jls_core_scan_initial(core));
-    GOE(jls_core_scan_sources(core));
-    GOE(jls_core_scan_signals(core));
+// the scan, repair, and track open phases that follow rd_start()
+static int32_t rd_finish(struct jls_rd_s * self) {
+    int32_t rc = 0;
+    struct jls_core_s * core = &self->core;
+    const bool mmap_enable = self->mmap_enable;
+    const bool follow = self->follow;
+    const bool metadata_only = self->metadata_only;
+    const char * path = self->path;
 
     if (jls_core_rd_chunk_end(core)) {
         return JLS_ERROR_EMPTY;  // no chunk found!
     }
     int64_t pos = jls_raw_chunk_tell(core->raw);
 
-    if (self->core.chunk_cur.hdr.tag != JLS_TAG_END) {
+    struct open_phase_s phase;
+    bool live = (self->core.chunk_cur.hdr.tag != JLS_TAG_END);
+    if (!live) {
+        // trailing sidecar chunks: seek index, UTC time map, footer directory
+        open_phase_start(self, &phase);
+        GOE(jls_core_rd_seek_index(core));
+        open_phase_end(self, &phase, JLS_RD_OPEN_PHASE_SIDECAR);
+    }
+    if (!core->dir_en) {
+        // no footer directory: scan the definition chains
+        open_phase_start(self, &phase);
+        GOE(jls_raw_chunk_seek(core->raw, sizeof(struct jls_file_header_s)));
+        GOE(jls_core_scan_initial(core));
+        GOE(jls_core_scan_sources(core));
+        open_phase_end(self, &phase, JLS_RD_OPEN_PHASE_SCAN_SOURCES);
+        open_phase_start(self, &phase);
+        GOE(jls_core_scan_signals(core));
+        open_phase_end(self, &phase, JLS_RD_OPEN_PHASE_SCAN_SIGNALS);
+    }
+    self->open_defs_ready = 1;  // jls_rd_signals() et al may return early
+    bool read_only_recover = false;
+    if (live && metadata_only) {
+        // cataloging: leave the file untouched and report only the
+        // reachable state; skip the repair pass and the follow-mode
+        // indexes over the unrepaired tail
+        JLS_LOGI("metadata: file is not properly closed");
+    } else if (live && follow) {
+        // still recording: leave the file untouched, discover the
+        // appended data through jls_rd_refresh()
+        JLS_LOGI("follow: file is still recording");
+    } else if (live) {
         JLS_LOGW("not properly closed");  // indices & summaries may be incomplete
+        open_phase_start(self, &phase);
         GOE(jls_raw_close(core->raw));
         rc = jls_raw_open(&core->raw, path, "a");
         if (rc && (rc != JLS_ERROR_TRUNCATED)) {
-            goto exit;
+            // read-only storage: skip the in-place repair and
+            // reconstruct the reachable state in memory instead
+            JLS_LOGW("cannot reopen for repair (%d), reconstructing read-only", (int) rc);
+            rc = jls_raw_open(&core->raw, path, "r");
+            if (rc && (rc != JLS_ERROR_TRUNCATED)) {
+                goto exit;
+            }
+            if (mmap_enable && jls_raw_mmap_enable(core->raw)) {
+                JLS_LOGW("mmap unavailable, using normal reads");
+            }
+            read_only_recover = true;
+            goto repair_done;
         }
 
         // find last full chunk and truncate remainder
@@ -113,6 +291,11 @@ int32_t jls_rd_open(struct jls_rd_s ** instance, const char * path) {
         GOE(jls_raw_chunk_seek(core->raw, pos));
         GOE(jls_raw_wr(core->raw, &core->chunk_cur.hdr, core->buf->cur));
 
+        // a checkpoint provides fresher head state than the stale
+        // on-disk pointers, bounding the chain scans below
+        GOE(jls_raw_chunk_seek(core->raw, pos));
+        GOE(jls_core_rd_checkpoint(core));
+
         for (uint16_t signal_idx = 0; signal_idx < JLS_SIGNAL_COUNT; ++signal_idx) {
             struct jls_core_signal_s * signal_info = &core->signal_info[signal_idx];
             if (signal_info->signal_def.signal_id != signal_idx) {
@@ -146,188 +329,2194 @@ int32_t jls_rd_open(struct jls_rd_s ** instance, const char * path) {
 
         GOE(jls_core_wr_end(core));
         GOE(jls_raw_close(core->raw));
+        // discard the partial seek index accumulated during repair
+        jls_core_seek_index_free(core);
         GOE(jls_raw_open(&core->raw, path, "r"));
+        if (mmap_enable && jls_raw_mmap_enable(core->raw)) {
+            JLS_LOGW("mmap unavailable, using normal reads");
+        }
+repair_done:;
+        open_phase_end(self, &phase, JLS_RD_OPEN_PHASE_REPAIR);
     }
 
+    open_phase_start(self, &phase);
     for (uint16_t i = 0; i < JLS_SIGNAL_COUNT; ++i) {
         struct jls_core_signal_s * signal_info = &core->signal_info[i];
         if ((signal_info->signal_def.signal_id == i) && (JLS_SIGNAL_TYPE_FSR == signal_info->signal_def.signal_type)) {
             ROE(jls_fsr_open(&signal_info->track_fsr, signal_info));
         }
     }
+    open_phase_end(self, &phase, JLS_RD_OPEN_PHASE_FSR_OPEN);
 
-    GOE(jls_core_scan_fsr_sample_id(core));
-    *instance = self;
+    if (!core->dir_en) {
+        open_phase_start(self, &phase);
+        GOE(jls_core_scan_fsr_sample_id(core));
+        open_phase_end(self, &phase, JLS_RD_OPEN_PHASE_SCAN_SAMPLE_ID);
+    }
+    if ((follow || read_only_recover) && live) {
+        // read_only_recover: the follow machinery builds the synthetic
+        // indexes over the unrepaired tail without touching the file
+        GOE(jls_core_follow_init(core, pos));
+    }
+    core->progress_phase = JLS_RD_PHASE_IDLE;
     return 0;
 
 exit:
-    jls_rd_close(self);
     return rc;
 }
 
-void jls_rd_close(struct jls_rd_s * self) {
-    if (self) {
-        struct jls_core_s * core = &self->core;
-        if (NULL != core->raw) {
-            for (size_t i = 0; i < JLS_SIGNAL_COUNT; ++i) {
-                struct jls_core_signal_s *signal_info = &core->signal_info[i];
-                jls_fsr_close(signal_info->track_fsr);
-            }
-            jls_raw_close(core->raw);
-        }
-        core->raw = NULL;
-        jls_buf_free(core->buf);
-        jls_buf_free(core->rd_index);
-        jls_buf_free(core->rd_summary);
-        jls_core_f64_buf_free(core->f64_stats_buf);
-        core->f64_stats_buf = NULL;
-        jls_core_f64_buf_free(core->f64_sample_buf);
-        core->f64_sample_buf = NULL;
-        free(self);
+static int32_t rd_open(struct jls_rd_s ** instance, const char * path, bool mmap_enable,
+                       bool follow, bool metadata_only,
+                       jls_rd_progress_fn progress_fn, void * progress_user_data) {
+    struct jls_rd_s * self = NULL;
+    ROE(rd_start(&self, path, mmap_enable, follow, metadata_only,
+                 progress_fn, progress_user_data));
+    int32_t rc = rd_finish(self);
+    if (rc) {
+        jls_rd_close(self);
+        return rc;
     }
+    *instance = self;
+    return 0;
 }
 
-int32_t jls_rd_sources(struct jls_rd_s * self, struct jls_source_def_s ** sources, uint16_t * count) {
-    return jls_core_sources(&self->core, sources, count);
+// collect the background open, see jls_rd_open_async()
+static int32_t open_wait(struct jls_rd_s * self) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (NULL != self->open_thread) {
+        jls_bk_thread_join(self->open_thread);
+        self->open_thread = NULL;
+    }
+    return self->open_rc;
 }
 
-int32_t jls_rd_signals(struct jls_rd_s * self, struct jls_signal_def_s ** signals, uint16_t * count) {
-    return jls_core_signals(&self->core, signals, count);
+// wait only until the source & signal defs are loaded
+static int32_t open_defs_wait(struct jls_rd_s * self) {
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (NULL == self->open_thread) {
+        return self->open_rc;
+    }
+    while (!self->open_defs_ready && !self->open_done) {
+        jls_bkt_sleep_ms(1);
+    }
+    if (self->open_done) {
+        return open_wait(self);
+    }
+    return 0;
 }
 
-int32_t jls_rd_signal(struct jls_rd_s * self, uint16_t signal_id, struct jls_signal_def_s * signal) {
-    return jls_core_signal(&self->core, signal_id, signal);
+static void open_async_thread(void * user_data) {
+    struct jls_rd_s * self = (struct jls_rd_s *) user_data;
+    int32_t rc = rd_finish(self);
+    self->open_rc = rc;
+    self->open_done = 1;
+    if (self->open_fn) {
+        self->open_fn(self->open_user_data, rc);
+    }
 }
 
-JLS_API int32_t jls_rd_fsr_length(struct jls_rd_s * self, uint16_t signal_id, int64_t * samples) {
-    return jls_core_fsr_length(&self->core, signal_id, samples);
+int32_t jls_rd_open_async(struct jls_rd_s ** instance, const char * path,
+                          jls_rd_open_async_fn fn, void * user_data) {
+    struct jls_rd_s * self = NULL;
+    ROE(rd_start(&self, path, false, false, false, NULL, NULL));
+    self->open_fn = fn;
+    self->open_user_data = user_data;
+    int32_t rc = jls_bk_thread_run(&self->open_thread, open_async_thread, self);
+    if (rc) {
+        jls_rd_close(self);
+        return rc;
+    }
+    *instance = self;
+    return 0;
 }
 
-int32_t jls_rd_fsr(struct jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
-                   void * data, int64_t data_length) {
-    return jls_core_fsr(&self->core, signal_id, start_sample_id, data, data_length);
+int32_t jls_rd_open(struct jls_rd_s ** instance, const char * path) {
+    return rd_open(instance, path, false, false, false, NULL, NULL);
 }
 
-JLS_API int32_t jls_rd_fsr_f32(struct jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
-                               float * data, int64_t data_length) {
-    return jls_core_fsr_f32(&self->core, signal_id, start_sample_id, data, data_length);
+int32_t jls_rd_open_mmap(struct jls_rd_s ** instance, const char * path) {
+    return rd_open(instance, path, true, false, false, NULL, NULL);
 }
 
-static inline void f32_to_stats(struct jls_statistics_s * stats, const float * data, int64_t count) {
-    stats->k = count;
-    stats->mean = data[JLS_SUMMARY_FSR_MEAN];
-    stats->min = data[JLS_SUMMARY_FSR_MIN];
-    stats->max = data[JLS_SUMMARY_FSR_MAX];
-    if (count > 1) {
-        stats->s = ((double) data[JLS_SUMMARY_FSR_STD]) * data[JLS_SUMMARY_FSR_STD] * (count - 1);
-    } else {
-        stats->s = 0.0;
+int32_t jls_rd_open_follow(struct jls_rd_s ** instance, const char * path) {
+    return rd_open(instance, path, false, true, false, NULL, NULL);
+}
+
+int32_t jls_rd_open_metadata(struct jls_rd_s ** instance, const char * path) {
+    return rd_open(instance, path, false, false, true, NULL, NULL);
+}
+
+int32_t jls_rd_open_progress(struct jls_rd_s ** instance, const char * path,
+                             jls_rd_progress_fn fn, void * user_data) {
+    return rd_open(instance, path, false, false, false, fn, user_data);
+}
+
+int32_t jls_rd_open_profile_get(struct jls_rd_s * self, struct jls_rd_open_profile_s * profile) {
+    ROE(open_wait(self));
+    if ((NULL == self) || (NULL == profile)) {
+        return JLS_ERROR_PARAMETER_INVALID;
     }
+    *profile = self->open_profile;
+    return 0;
 }
 
-static inline void stats_to_f64(double * data, struct jls_statistics_s * stats) {
-    data[JLS_SUMMARY_FSR_MEAN] = stats->mean;
-    data[JLS_SUMMARY_FSR_MIN] = stats->min;
-    data[JLS_SUMMARY_FSR_MAX] = stats->max;
-    data[JLS_SUMMARY_FSR_STD] = sqrt(jls_statistics_var(stats));
+static inline void stats_to_f64(double * data, struct jls_statistics_s * stats);
+static inline void f64_to_stats(struct jls_statistics_s * stats, const double * data, int64_t count);
+
+static int32_t mseg_open(struct jls_rd_s * self, uint16_t idx) {
+    struct jls_rd_mseg_s * seg = &self->msegs[idx];
+    if (NULL != seg->rd) {
+        return 0;
+    }
+    return rd_open(&seg->rd, seg->path, self->mmap_enable, false, false, NULL, NULL);
 }
 
-static inline void f64_to_stats(struct jls_statistics_s * stats, const double * data, int64_t count) {
-    stats->k = count;
-    stats->mean = data[JLS_SUMMARY_FSR_MEAN];
-    stats->min = data[JLS_SUMMARY_FSR_MIN];
-    stats->max = data[JLS_SUMMARY_FSR_MAX];
-    if (count > 1) {
-        stats->s = ((double) data[JLS_SUMMARY_FSR_STD]) * data[JLS_SUMMARY_FSR_STD] * (count - 1);
-    } else {
-        stats->s = 0.0;
+struct mseg_open_worker_s {
+    struct jls_rd_s * rd;
+    uint16_t offset;    // first segment index for this worker
+    uint16_t stride;    // the number of workers
+    int32_t return_code;
+};
+
+static void mseg_open_worker(void * user_data) {
+    struct mseg_open_worker_s * w = (struct mseg_open_worker_s *) user_data;
+    for (uint16_t i = w->offset; i < w->rd->mseg_count; i += w->stride) {
+        int32_t rc = mseg_open(w->rd, i);
+        if (rc && !w->return_code) {
+            w->return_code = rc;
+        }
     }
 }
 
-static int32_t rd_stats_chunk(struct jls_core_s * self, uint16_t signal_id, uint8_t level) {
-    ROE(jls_core_rd_chunk(self));
-    if (JLS_TAG_TRACK_FSR_SUMMARY != self->chunk_cur.hdr.tag) {
-        JLS_LOGW("unexpected chunk tag %d at %" PRIi64, (int) self->chunk_cur.hdr.tag, self->chunk_cur.offset);
-        return JLS_ERROR_IO;
+// Open all remaining segments in parallel, for queries that span the dataset.
+static int32_t mseg_open_all(struct jls_rd_s * self) {
+    uint16_t pending = 0;
+    for (uint16_t i = 1; i < self->mseg_count; ++i) {
+        if (NULL == self->msegs[i].rd) {
+            ++pending;
+        }
     }
-    uint16_t metadata = (signal_id & SIGNAL_MASK) | (((uint16_t) level) << 12);
-    if (metadata != self->chunk_cur.hdr.chunk_meta) {
-        JLS_LOGW("unexpected chunk meta 0x%04x", (unsigned int) self->chunk_cur.hdr.chunk_meta);
-        return JLS_ERROR_IO;
+    if (!pending) {
+        return 0;
+    }
+    uint16_t workers = pending;
+    if (workers > JLS_RD_FSR_BATCH_WORKERS_MAX) {
+        workers = JLS_RD_FSR_BATCH_WORKERS_MAX;
     }
 
-    /*
-    // display stats chunk data
-    int64_t *i64 = (int64_t *) self->payload.start;
-    JLS_LOGI("stats chunk: sample_id=%" PRIi64 ", entries=%" PRIi64, i64[0], i64[1]);
-    float * d = (float *) &i64[2];
-    for (int64_t i = 0; i < i64[1] * 4; i += 4) {
-        JLS_LOGI("stats: mean=%f min=%f max=%f std=%f",
-            d[i + JLS_SUMMARY_FSR_MEAN],
-            d[i + JLS_SUMMARY_FSR_MIN],
-            d[i + JLS_SUMMARY_FSR_MAX],
-            d[i + JLS_SUMMARY_FSR_STD]);
+    struct mseg_open_worker_s w[JLS_RD_FSR_BATCH_WORKERS_MAX];
+    struct jls_bk_thread_s * threads[JLS_RD_FSR_BATCH_WORKERS_MAX];
+    for (uint16_t k = 0; k < workers; ++k) {
+        w[k].rd = self;
+        w[k].offset = 1 + k;  // each worker owns a disjoint stride, no locking needed
+        w[k].stride = workers;
+        w[k].return_code = 0;
+        threads[k] = NULL;
     }
-    */
-    return 0;
+    for (uint16_t k = 1; k < workers; ++k) {
+        if (jls_bk_thread_run(&threads[k], mseg_open_worker, &w[k])) {
+            threads[k] = NULL;  // run this worker's slice on the calling thread
+        }
+    }
+    mseg_open_worker(&w[0]);
+
+    int32_t rc = 0;
+    for (uint16_t k = 1; k < workers; ++k) {
+        if (threads[k]) {
+            jls_bk_thread_join(threads[k]);
+        } else {
+            mseg_open_worker(&w[k]);
+        }
+    }
+    for (uint16_t k = 0; k < workers; ++k) {
+        if (w[k].return_code && !rc) {
+            rc = w[k].return_code;
+        }
+    }
+    return rc;
 }
 
-static int32_t fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
-                              int64_t start_sample_id, int64_t increment, uint8_t level,
-                              double * data, int64_t data_length) {
-    // start_sample_id in JLS units with possible non-zero offset
-    JLS_LOGD2("fsr_f32_statistics(signal_id=%d, start_id=%" PRIi64 ", incr=%" PRIi64 ", level=%d, len=%" PRIi64 ")",
-              (int) signal_id, start_sample_id, increment, (int) level, data_length);
-    bool is_f32;
-    struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
-    int64_t step_size = signal_def->sample_decimate_factor;
-    for (uint8_t lvl = 2; lvl <= level; ++lvl) {
-        step_size *= signal_def->summary_decimate_factor;
+/**
+ * @brief Map a virtual sample_id to its segment and segment-local sample_id.
+ *
+ * Opens segments lazily, in order, only as far as the target.  The last
+ * segment also claims any sample_id past the dataset end so that the
+ * child read reports the range error.
+ */
+static int32_t mseg_locate(struct jls_rd_s * self, uint16_t signal_id, int64_t sample_id,
+                           uint16_t * seg_idx, int64_t * local_id) {
+    int64_t base = 0;
+    for (uint16_t i = 0; i < self->mseg_count; ++i) {
+        ROE(mseg_open(self, i));
+        int64_t length = 0;
+        ROE(jls_core_fsr_length(&self->msegs[i].rd->core, signal_id, &length));
+        if ((sample_id < (base + length)) || (i == (self->mseg_count - 1))) {
+            *seg_idx = i;
+            *local_id = sample_id - base;
+            return 0;
+        }
+        base += length;
     }
-    double f64_tmp4[JLS_SUMMARY_FSR_COUNT];
-    const int64_t sample_id_offset = signal_def->sample_id_offset;
+    return JLS_ERROR_UNSPECIFIED;  // unreachable, the last segment always claims
+}
 
-    ROE(jls_core_fsr_seek(self, signal_id, level, start_sample_id)); // returns the index
-    ROE(jls_raw_chunk_next(self->raw));  // statistics
-    int64_t pos = jls_raw_chunk_tell(self->raw);
-    ROE(rd_stats_chunk(self, signal_id, level));
+static int32_t multi_fsr_length(struct jls_rd_s * self, uint16_t signal_id, int64_t * samples) {
+    ROE(mseg_open_all(self));
+    int64_t total = 0;
+    int64_t length = 0;
+    for (uint16_t i = 0; i < self->mseg_count; ++i) {
+        ROE(jls_core_fsr_length(&self->msegs[i].rd->core, signal_id, &length));
+        total += length;
+    }
+    *samples = total;
+    return 0;
+}
 
-    struct jls_fsr_f32_summary_s * f32_summary = (struct jls_fsr_f32_summary_s *) self->buf->start;
-    struct jls_fsr_f64_summary_s * f64_summary = (struct jls_fsr_f64_summary_s *) self->buf->start;
-    int64_t chunk_sample_id = f32_summary->header.timestamp;
-    if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(float) * 8) {
-        is_f32 = true;  // 32-bit float summaries
-    } else if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(double) * 8) {
-        is_f32 = false; // 64-bit float summaries
-    } else {
-        JLS_LOGE("invalid summary entry size: %d", (int) f32_summary->header.entry_size_bits);
+static int32_t multi_fsr(struct jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
+                         void * data, int64_t data_length, bool f32) {
+    ROE(jls_core_signal_validate_typed(&self->core, signal_id, JLS_SIGNAL_TYPE_FSR));
+    struct jls_signal_def_s * signal_def = &self->core.signal_info[signal_id].signal_def;
+    uint8_t sample_size_bits = f32 ? 32 : jls_datatype_parse_size(signal_def->data_type);
+    uint8_t * data_u8 = (uint8_t *) data;
+    uint16_t seg_idx = 0;
+    int64_t local_id = 0;
+    while (data_length > 0) {
+        ROE(mseg_locate(self, signal_id, start_sample_id, &seg_idx, &local_id));
+        struct jls_core_s * core = &self->msegs[seg_idx].rd->core;
+        int64_t length = 0;
+        ROE(jls_core_fsr_length(core, signal_id, &length));
+        int64_t n = length - local_id;
+        if ((n > data_length) || (seg_idx == (self->mseg_count - 1))) {
+            n = data_length;  // the last segment validates the range itself
+        }
+        if (f32) {
+            ROE(jls_core_fsr_f32(core, signal_id, local_id, (float *) data_u8, n));
+        } else {
+            if ((n * sample_size_bits) & 7) {
+                // segment lengths are whole data chunks, so this only occurs
+                // for sub-byte datatypes with an unaligned start_sample_id
+                JLS_LOGW("multi: unaligned sub-byte read spans segments");
+                return JLS_ERROR_NOT_SUPPORTED;
+            }
+            ROE(jls_core_fsr(core, signal_id, local_id, data_u8, n));
+        }
+        data_u8 += (n * sample_size_bits) / 8;
+        start_sample_id += n;
+        data_length -= n;
+    }
+    return 0;
+}
+
+static int32_t multi_fsr_statistics(struct jls_rd_s * self, uint16_t signal_id,
+                                    int64_t start_sample_id, int64_t increment,
+                                    double * data, int64_t data_length) {
+    if ((start_sample_id < 0) || (increment <= 0) || (data_length <= 0)) {
         return JLS_ERROR_PARAMETER_INVALID;
     }
-    int64_t src_offset = 0;
-    int64_t src_end = f32_summary->header.entry_count;
-    int64_t entry_offset = ((start_sample_id - chunk_sample_id + step_size - 1) / step_size);
-    int64_t entry_sample_id = entry_offset * step_size + chunk_sample_id;
+    int64_t e = 0;
+    while (e < data_length) {
+        int64_t s = start_sample_id + e * increment;
+        uint16_t seg_idx = 0;
+        int64_t local_id = 0;
+        ROE(mseg_locate(self, signal_id, s, &seg_idx, &local_id));
+        struct jls_core_s * core = &self->msegs[seg_idx].rd->core;
+        int64_t length = 0;
+        ROE(jls_core_fsr_length(core, signal_id, &length));
+        int64_t entries = (length - local_id) / increment;
+        if ((entries > (data_length - e)) || (seg_idx == (self->mseg_count - 1))) {
+            entries = data_length - e;
+        }
+        if (entries >= 1) {
+            // whole entries within one segment: one bulk child query
+            ROE(jls_core_fsr_statistics(core, signal_id, local_id, increment,
+                                        &data[e * JLS_SUMMARY_FSR_COUNT], entries));
+            e += entries;
+            continue;
+        }
+        // this entry straddles a segment boundary: combine piecewise
+        struct jls_statistics_s acc;
+        jls_statistics_reset(&acc);
+        int64_t remaining = increment;
+        while (remaining > 0) {
+            ROE(mseg_locate(self, signal_id, s, &seg_idx, &local_id));
+            core = &self->msegs[seg_idx].rd->core;
+            ROE(jls_core_fsr_length(core, signal_id, &length));
+            int64_t n = length - local_id;
+            if ((n > remaining) || (seg_idx == (self->mseg_count - 1))) {
+                n = remaining;
+            }
+            double part_f64[JLS_SUMMARY_FSR_COUNT];
+            ROE(jls_core_fsr_statistics(core, signal_id, local_id, n, part_f64, 1));
+            struct jls_statistics_s part;
+            struct jls_statistics_s tmp;
+            f64_to_stats(&part, part_f64, n);
+            jls_statistics_combine(&tmp, &acc, &part);
+            jls_statistics_copy(&acc, &tmp);
+            s += n;
+            remaining -= n;
+        }
+        stats_to_f64(&data[e * JLS_SUMMARY_FSR_COUNT], &acc);
+        e += 1;
+    }
+    return 0;
+}
 
-    struct jls_statistics_s stats_accum;
-    jls_statistics_reset(&stats_accum);
-    struct jls_statistics_s stats_next;
+int32_t jls_rd_open_multi(struct jls_rd_s ** instance, const char * const * paths, uint16_t count) {
+    if (!instance || !paths || !count) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    for (uint16_t i = 0; i < count; ++i) {
+        if (!paths[i]) {
+            return JLS_ERROR_PARAMETER_INVALID;
+        }
+    }
+    // the first segment opens eagerly and provides the defs
+    struct jls_rd_s * self = NULL;
+    ROE(rd_open(&self, paths[0], false, false, false, NULL, NULL));
+    struct jls_rd_mseg_s * msegs = calloc(count, sizeof(struct jls_rd_mseg_s));
+    if (!msegs) {
+        jls_rd_close(self);
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    msegs[0].rd = self;
+    for (uint16_t i = 1; i < count; ++i) {
+        size_t sz = strlen(paths[i]) + 1;
+        msegs[i].path = malloc(sz);
+        if (!msegs[i].path) {
+            for (uint16_t k = 1; k < i; ++k) {
+                free(msegs[k].path);
+            }
+            free(msegs);
+            jls_rd_close(self);
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        memcpy(msegs[i].path, paths[i], sz);
+    }
+    self->msegs = msegs;
+    self->mseg_count = count;
+    *instance = self;
+    return 0;
+}
 
-    int64_t incr_remaining = increment;
+int32_t jls_rd_refresh(struct jls_rd_s * self) {
+    ROE(open_wait(self));
+    if (NULL == self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    return jls_core_follow_refresh(&self->core);
+}
 
-    if (entry_sample_id != start_sample_id) {
-        int64_t incr = entry_sample_id - start_sample_id;
-        // invalidates stats, need to reload, providing API sample_id
-        ROE(jls_core_fsr_statistics(self, signal_id, start_sample_id - sample_id_offset,
-                                  incr, f64_tmp4, 1));
-        ROE(jls_raw_chunk_seek(self->raw, pos));
-        ROE(rd_stats_chunk(self, signal_id, level));
-        f64_to_stats(&stats_accum, f64_tmp4, incr);
-        incr_remaining -= incr;
-        start_sample_id += incr;
+int32_t jls_rd_progress_register(struct jls_rd_s * self, jls_rd_progress_fn fn, void * user_data) {
+    if (NULL == self) {
+        return JLS_ERROR_PARAMETER_INVALID;
     }
-    src_offset += entry_offset;
+    self->core.progress_fn = fn;
+    self->core.progress_user_data = user_data;
+    self->core.progress_bytes_next = 0;  // report on the next chunk read
+    return 0;
+}
 
-    while (data_length) {
+int32_t jls_rd_cancel(struct jls_rd_s * self) {
+    if (NULL == self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    // no open_wait: cancellation targets the operation already in flight
+    self->core.cancel = 1;
+    return 0;
+}
+
+int32_t jls_rd_budget(struct jls_rd_s * self, int64_t bytes) {
+    if ((NULL == self) || (bytes < 0)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    self->core.budget_bytes = bytes;  // 0 removes the budget
+    return 0;
+}
+
+int32_t jls_rd_counters(struct jls_rd_s * self, struct jls_rd_counters_s * counters) {
+    ROE(open_wait(self));
+    if ((NULL == self) || (NULL == counters)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_bkf_s * backend = jls_raw_backend(self->core.raw);
+    if (NULL == backend) {
+        return JLS_ERROR_CLOSED;
+    }
+    counters->seeks = jls_bk_counter_load(&backend->seek_count);
+    counters->bytes_read = jls_bk_counter_load(&backend->bytes_read);
+    counters->chunks = (uint64_t) self->core.progress_chunks;
+    counters->crc_bytes = jls_raw_crc_bytes(self->core.raw);
+    counters->cache_hits = self->core.cache_hits;
+    counters->cache_misses = self->core.cache_misses;
+    return 0;
+}
+
+int32_t jls_rd_query_profile_get(struct jls_rd_s * self, struct jls_rd_query_profile_s * profile) {
+    ROE(open_wait(self));
+    if ((NULL == self) || (NULL == profile)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    *profile = self->query_profile;
+    return 0;
+}
+
+static int32_t fork_string(struct jls_buf_s * buf, const char ** str) {
+    if (NULL == *str) {
+        return 0;
+    }
+    return jls_buf_string_save(buf, *str, (char **) str);
+}
+
+int32_t jls_rd_fork(struct jls_rd_s * self, struct jls_rd_s ** copy) {
+    ROE(open_wait(self));
+    int32_t rc = 0;
+    if (!self || !copy) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    *copy = NULL;
+
+    struct jls_rd_s * rd = calloc(1, sizeof(struct jls_rd_s));
+    if (!rd) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    rd->mmap_enable = self->mmap_enable;
+    rd->path = malloc(strlen(self->path) + 1);
+    if (!rd->path) {
+        GOE(JLS_ERROR_NOT_ENOUGH_MEMORY);
+    }
+    memcpy(rd->path, self->path, strlen(self->path) + 1);
+
+    struct jls_core_s * core = &rd->core;
+    struct jls_core_s * src = &self->core;
+    core->buf = jls_buf_alloc();
+    core->rd_index = jls_buf_alloc();
+    core->rd_summary = jls_buf_alloc();
+    if (!core->buf || !core->rd_index || !core->rd_summary) {
+        GOE(JLS_ERROR_NOT_ENOUGH_MEMORY);
+    }
+
+    // own file handle for an independent cursor; the parent already repaired on open
+    GOE(jls_raw_open(&core->raw, rd->path, "r"));
+    if (rd->mmap_enable && jls_raw_mmap_enable(core->raw)) {
+        JLS_LOGW("mmap unavailable, using normal reads");
+    }
+
+    // copy the open-scan results instead of rescanning the file
+    core->source_head = src->source_head;
+    core->signal_head = src->signal_head;
+    core->user_data_head = src->user_data_head;
+
+    for (uint16_t i = 0; i < JLS_SOURCE_COUNT; ++i) {
+        struct jls_core_source_s * d = &core->source_info[i];
+        *d = src->source_info[i];
+        GOE(fork_string(core->buf, &d->source_def.name));
+        GOE(fork_string(core->buf, &d->source_def.vendor));
+        GOE(fork_string(core->buf, &d->source_def.model));
+        GOE(fork_string(core->buf, &d->source_def.version));
+        GOE(fork_string(core->buf, &d->source_def.serial_number));
+    }
+
+    for (uint16_t i = 0; i < JLS_SIGNAL_COUNT; ++i) {
+        struct jls_core_signal_s * d = &core->signal_info[i];
+        struct jls_core_signal_s * s = &src->signal_info[i];
+        *d = *s;
+        d->parent = core;
+        for (int t = 0; t < JLS_TRACK_TYPE_COUNT; ++t) {
+            d->tracks[t].parent = d;
+        }
+        d->track_fsr = NULL;
+        d->track_anno = NULL;
+        d->track_utc = NULL;
+        d->seek_index = NULL;
+        d->seek_index_alloc = 0;
+        d->tmap_sidecar = NULL;
+        d->tmap_sidecar_alloc = 0;
+        d->data_map = NULL;
+        d->data_map_alloc = 0;
+        GOE(fork_string(core->buf, &d->signal_def.name));
+        GOE(fork_string(core->buf, &d->signal_def.units));
+
+        if (s->seek_index) {
+            size_t sz = sizeof(struct jls_fsr_seek_index_s)
+                    + s->seek_index->header.entry_count * sizeof(uint64_t);
+            d->seek_index = malloc(sz);
+            if (!d->seek_index) {
+                GOE(JLS_ERROR_NOT_ENOUGH_MEMORY);
+            }
+            memcpy(d->seek_index, s->seek_index, sz);
+        }
+
+        if (s->tmap_sidecar) {
+            size_t sz = sizeof(struct jls_utc_tmap_s)
+                    + s->tmap_sidecar->header.entry_count * sizeof(struct jls_utc_summary_entry_s);
+            d->tmap_sidecar = malloc(sz);
+            if (!d->tmap_sidecar) {
+                GOE(JLS_ERROR_NOT_ENOUGH_MEMORY);
+            }
+            memcpy(d->tmap_sidecar, s->tmap_sidecar, sz);
+        }
+
+        if (s->data_map) {
+            size_t sz = sizeof(struct jls_fsr_data_map_s)
+                    + s->data_map->header.entry_count * sizeof(struct jls_fsr_data_map_entry_s);
+            d->data_map = malloc(sz);
+            if (!d->data_map) {
+                GOE(JLS_ERROR_NOT_ENOUGH_MEMORY);
+            }
+            memcpy(d->data_map, s->data_map, sz);
+            d->data_map_alloc = s->data_map->header.entry_count;
+        }
+
+        if ((d->signal_def.signal_id == i) && (JLS_SIGNAL_TYPE_FSR == d->signal_def.signal_type)) {
+            GOE(jls_fsr_open(&d->track_fsr, d));
+            if (s->track_fsr && s->track_fsr->tmap) {
+                d->track_fsr->tmap = jls_tmap_copy(s->track_fsr->tmap);
+                if (!d->track_fsr->tmap) {
+                    GOE(JLS_ERROR_NOT_ENOUGH_MEMORY);
+                }
+            }
+        }
+    }
+
+    *copy = rd;
+    return 0;
+
+exit:
+    jls_rd_close(rd);
+    return rc;
+}
+
+static void crc_scan_fn(void * user_data) {
+    struct jls_rd_s * self = (struct jls_rd_s *) user_data;
+    struct jls_raw_s * raw = self->scan_raw;
+    struct jls_chunk_header_s hdr;
+    uint32_t buf_alloc = 1 << 16;
+    uint8_t * buf = malloc(buf_alloc);
+    if (!buf) {
+        self->scan_fn(self->scan_user_data, -1, JLS_TAG_INVALID, JLS_ERROR_NOT_ENOUGH_MEMORY);
+        return;
+    }
+    while (!self->scan_quit) {
+        if (jls_raw_rd_header(raw, &hdr)) {
+            break;  // end of chunks or unrecoverable header
+        }
+        int64_t offset = jls_raw_chunk_tell(raw);
+        int32_t rc = jls_raw_rd_payload(raw, buf_alloc, buf);
+        if (JLS_ERROR_TOO_BIG == rc) {
+            // payload_size_on_disk adds at most pad + CRC32 beyond the payload
+            uint32_t sz = jls_raw_payload_decoded_length(raw) + 16;
+            uint8_t * b = realloc(buf, sz);
+            if (!b) {
+                break;
+            }
+            buf = b;
+            buf_alloc = sz;
+            rc = jls_raw_rd_payload(raw, buf_alloc, buf);
+        }
+        if (JLS_ERROR_MESSAGE_INTEGRITY == rc) {
+            self->scan_fn(self->scan_user_data, offset, hdr.tag, rc);
+            if (jls_raw_chunk_next(raw)) {  // skip the corrupt payload
+                break;
+            }
+        } else if (rc) {
+            break;
+        }
+    }
+    free(buf);
+    self->scan_fn(self->scan_user_data, -1, JLS_TAG_INVALID, 0);
+}
+
+int32_t jls_rd_crc_defer(struct jls_rd_s * self, jls_rd_integrity_fn fn, void * user_data) {
+    ROE(open_wait(self));
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (self->scan_thread) {
+        return JLS_ERROR_IN_USE;
+    }
+    ROE(jls_raw_crc_verify_set(self->core.raw, 0));
+    if (NULL == fn) {
+        return 0;
+    }
+    self->scan_fn = fn;
+    self->scan_user_data = user_data;
+    int32_t rc = jls_raw_open(&self->scan_raw, self->path, "r");
+    if (rc && (rc != JLS_ERROR_TRUNCATED)) {
+        return rc;
+    }
+    rc = jls_bk_thread_run(&self->scan_thread, crc_scan_fn, self);
+    if (rc) {
+        jls_raw_close(self->scan_raw);
+        self->scan_raw = NULL;
+        return rc;
+    }
+    return 0;
+}
+
+void jls_rd_close(struct jls_rd_s * self) {
+    if (self) {
+        struct jls_core_s * core = &self->core;
+        if (self->open_thread) {
+            jls_bk_thread_join(self->open_thread);
+            self->open_thread = NULL;
+        }
+        if (self->scan_thread) {
+            self->scan_quit = 1;
+            jls_bk_thread_join(self->scan_thread);
+            self->scan_thread = NULL;
+        }
+        rd_async_stop(self);  // aborts outstanding requests, see jls_rd_fsr_async()
+        rd_prefetch_stop(self);
+        if (self->scan_raw) {
+            jls_raw_close(self->scan_raw);
+            self->scan_raw = NULL;
+        }
+        for (size_t i = 1; i < JLS_RD_FSR_BATCH_WORKERS_MAX; ++i) {
+            jls_rd_close(self->batch_rd[i]);
+            self->batch_rd[i] = NULL;
+        }
+        if (self->msegs) {
+            for (uint16_t i = 1; i < self->mseg_count; ++i) {
+                jls_rd_close(self->msegs[i].rd);
+                free(self->msegs[i].path);
+            }
+            free(self->msegs);
+            self->msegs = NULL;
+        }
+        free(self->path);
+        self->path = NULL;
+        if (NULL != core->raw) {
+            for (size_t i = 0; i < JLS_SIGNAL_COUNT; ++i) {
+                struct jls_core_signal_s *signal_info = &core->signal_info[i];
+                jls_fsr_close(signal_info->track_fsr);
+            }
+            jls_raw_close(core->raw);
+        }
+        core->raw = NULL;
+        for (size_t i = 0; i < JLS_SIGNAL_COUNT; ++i) {
+            free(core->signal_info[i].anno_index);
+            core->signal_info[i].anno_index = NULL;
+        }
+        jls_core_seek_index_free(core);
+        jls_core_tmap_sidecar_free(core);
+        jls_chunk_cache_free(core->cache);
+        core->cache = NULL;
+        jls_shared_cache_close(core->shared_cache);
+        core->shared_cache = NULL;
+        jls_stat_cache_close(self->stat_cache);  // persists the sidecar
+        self->stat_cache = NULL;
+        jls_buf_free(core->buf);
+        jls_buf_free(core->rd_index);
+        jls_buf_free(core->rd_summary);
+        jls_core_f64_buf_free(core->f64_stats_buf);
+        core->f64_stats_buf = NULL;
+        jls_core_f64_buf_free(core->f64_sample_buf);
+        core->f64_sample_buf = NULL;
+        free(self);
+    }
+}
+
+int32_t jls_rd_cache(struct jls_rd_s * self, int64_t size) {
+    ROE(open_wait(self));
+    if (!self || (size < 0)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    rd_prefetch_stop(self);  // the worker shares the cache being replaced
+    jls_chunk_cache_free(self->core.cache);
+    self->core.cache = NULL;
+    if (size) {
+        return jls_chunk_cache_alloc(&self->core.cache, (size_t) size);
+    }
+    return 0;
+}
+
+int32_t jls_rd_cache_shared(struct jls_rd_s * self, const char * name, int64_t size) {
+    ROE(open_wait(self));
+    if (!self || (size < 0)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (self->msegs) {
+        // no single file identity for the cache key
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    rd_prefetch_stop(self);  // the worker shares the attachment being replaced
+    jls_shared_cache_close(self->core.shared_cache);
+    self->core.shared_cache = NULL;
+    if (!size || !name) {
+        return 0;
+    }
+    ROE(jls_shared_cache_open(&self->core.shared_cache, name, size));
+    self->core.shared_cache_file_id = jls_xxh64((const uint8_t *) self->path, strlen(self->path));
+    return 0;
+}
+
+int32_t jls_rd_stat_cache(struct jls_rd_s * self, const char * path) {
+    ROE(open_wait(self));
+    if (!self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (self->msegs) {
+        // no single file identity to validate the sidecar against
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    if (self->stat_cache) {
+        jls_stat_cache_close(self->stat_cache);
+        self->stat_cache = NULL;
+    }
+    uint64_t file_id = 0;
+    ROE(jls_stat_cache_file_id(self->path, &file_id));
+    char * path_derived = NULL;
+    if (NULL == path) {
+        size_t sz = strlen(self->path) + sizeof(".stats");
+        path_derived = malloc(sz);
+        if (NULL == path_derived) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        snprintf(path_derived, sz, "%s.stats", self->path);
+        path = path_derived;
+    }
+    int32_t rc = jls_stat_cache_open(&self->stat_cache, path, file_id);
+    free(path_derived);
+    return rc;
+}
+
+int32_t jls_rd_omit_mode(struct jls_rd_s * self, enum jls_rd_omit_mode_e mode) {
+    ROE(open_wait(self));
+    if (!self || (mode > JLS_RD_OMIT_MODE_MEAN)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    self->core.omit_mode = (uint8_t) mode;
+    return 0;
+}
+
+int32_t jls_rd_sources(struct jls_rd_s * self, struct jls_source_def_s ** sources, uint16_t * count) {
+    ROE(open_defs_wait(self));
+    return jls_core_sources(&self->core, sources, count);
+}
+
+int32_t jls_rd_signals(struct jls_rd_s * self, struct jls_signal_def_s ** signals, uint16_t * count) {
+    ROE(open_defs_wait(self));
+    return jls_core_signals(&self->core, signals, count);
+}
+
+int32_t jls_rd_signal(struct jls_rd_s * self, uint16_t signal_id, struct jls_signal_def_s * signal) {
+    ROE(open_defs_wait(self));
+    return jls_core_signal(&self->core, signal_id, signal);
+}
+
+int32_t jls_rd_mem_config(struct jls_rd_s * self, size_t budget) {
+    ROE(open_wait(self));
+    if (NULL == self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    return jls_core_mem_config(&self->core, budget);
+}
+
+int32_t jls_rd_mem_trim(struct jls_rd_s * self) {
+    ROE(open_wait(self));
+    if (NULL == self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    return jls_core_mem_trim(&self->core);
+}
+
+JLS_API int32_t jls_rd_fsr_length(struct jls_rd_s * self, uint16_t signal_id, int64_t * samples) {
+    ROE(open_wait(self));
+    if (self->msegs) {
+        return multi_fsr_length(self, signal_id, samples);
+    }
+    return jls_core_fsr_length(&self->core, signal_id, samples);
+}
+
+int32_t jls_rd_fsr(struct jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
+                   void * data, int64_t data_length) {
+    ROE(open_wait(self));
+    int32_t rc;
+    uint64_t bytes = 0;
+    uint64_t seeks = 0;
+    query_counters(self, &bytes, &seeks);
+    if (self->msegs) {
+        rc = multi_fsr(self, signal_id, start_sample_id, data, data_length, false);
+    } else {
+        rc = jls_core_fsr(&self->core, signal_id, start_sample_id, data, data_length);
+    }
+    uint64_t logical = 0;
+    if ((0 == rc) && (signal_id < JLS_SIGNAL_COUNT)) {
+        uint8_t sample_size_bits = jls_datatype_parse_size(
+                self->core.signal_info[signal_id].signal_def.data_type);
+        logical = (((uint64_t) data_length) * sample_size_bits + 7) / 8;
+    }
+    query_profile_end(self, bytes, seeks, logical);
+    return rc;
+}
+
+JLS_API int32_t jls_rd_fsr_f32(struct jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
+                               float * data, int64_t data_length) {
+    ROE(open_wait(self));
+    int32_t rc;
+    uint64_t bytes = 0;
+    uint64_t seeks = 0;
+    query_counters(self, &bytes, &seeks);
+    if (self->msegs) {
+        rc = multi_fsr(self, signal_id, start_sample_id, data, data_length, true);
+    } else {
+        rc = jls_core_fsr_f32(&self->core, signal_id, start_sample_id, data, data_length);
+    }
+    query_profile_end(self, bytes, seeks,
+                      rc ? 0 : ((uint64_t) data_length) * sizeof(float));
+    return rc;
+}
+
+JLS_API int32_t jls_rd_fsr_f64(struct jls_rd_s * self, uint16_t signal_id, int64_t start_sample_id,
+                               double * data, int64_t data_length) {
+    ROE(open_wait(self));
+    int32_t rc;
+    uint64_t bytes = 0;
+    uint64_t seeks = 0;
+    query_counters(self, &bytes, &seeks);
+    if (self->msegs) {
+        rc = jls_core_signal_validate_typed(&self->core, signal_id, JLS_SIGNAL_TYPE_FSR);
+        if (!rc && (self->core.signal_info[signal_id].signal_def.data_type != JLS_DATATYPE_F64)) {
+            rc = JLS_ERROR_PARAMETER_INVALID;
+        }
+        if (!rc) {
+            rc = multi_fsr(self, signal_id, start_sample_id, data, data_length, false);
+        }
+    } else {
+        rc = jls_core_fsr_f64(&self->core, signal_id, start_sample_id, data, data_length);
+    }
+    query_profile_end(self, bytes, seeks,
+                      rc ? 0 : ((uint64_t) data_length) * sizeof(double));
+    return rc;
+}
+
+struct rd_batch_worker_s {
+    struct jls_rd_s * rd;
+    struct jls_rd_fsr_req_s * requests;
+    const uint32_t * order;  // offset-sorted request indices, NULL for natural order
+    uint32_t offset;    // first order index for this worker
+    uint32_t end;       // end order index, exclusive
+    int32_t return_code;
+};
+
+// fork one reader per missing worker slot, each on its own thread:
+// the fork allocates the parse buffers and the seek index copies, and
+// running it on a worker thread first-touches those pages where that
+// worker runs.  Forking from the calling thread instead places every
+// worker's buffers on the caller's NUMA node, which multi-socket
+// machines then serve to half the workers across the interconnect.
+// The parent is quiescent while the forks run, and jls_rd_fork() only
+// reads it, so concurrent forks from one parent are safe.
+struct rd_fork_worker_s {
+    struct jls_rd_s * parent;
+    struct jls_rd_s ** slot;
+};
+
+static void rd_fork_worker(void * user_data) {
+    struct rd_fork_worker_s * w = (struct rd_fork_worker_s *) user_data;
+    jls_rd_fork(w->parent, w->slot);  // failure leaves the slot NULL
+}
+
+static uint32_t batch_workers_fork(struct jls_rd_s * self, uint32_t workers) {
+    struct rd_fork_worker_s w[JLS_RD_FSR_BATCH_WORKERS_MAX];
+    struct jls_bk_thread_s * threads[JLS_RD_FSR_BATCH_WORKERS_MAX];
+    for (uint32_t k = 1; k < workers; ++k) {
+        threads[k] = NULL;
+        if (NULL != self->batch_rd[k]) {
+            continue;
+        }
+        w[k].parent = self;
+        w[k].slot = &self->batch_rd[k];
+        if (jls_bk_thread_run(&threads[k], rd_fork_worker, &w[k])) {
+            rd_fork_worker(&w[k]);  // fork on the calling thread instead
+        }
+    }
+    for (uint32_t k = 1; k < workers; ++k) {
+        if (threads[k]) {
+            jls_bk_thread_join(threads[k]);
+        }
+    }
+    for (uint32_t k = 1; k < workers; ++k) {
+        if (NULL == self->batch_rd[k]) {
+            JLS_LOGW("batch worker open failed, using %" PRIu32 " workers", k);
+            return k;
+        }
+    }
+    return workers;
+}
+
+static void rd_batch_worker(void * user_data) {
+    struct rd_batch_worker_s * w = (struct rd_batch_worker_s *) user_data;
+    for (uint32_t i = w->offset; i < w->end; ++i) {
+        struct jls_rd_fsr_req_s * req = &w->requests[w->order ? w->order[i] : i];
+        req->return_code = jls_rd_fsr(w->rd, req->signal_id, req->start_sample_id,
+                                      req->data, req->data_length);
+        if (req->return_code && !w->return_code) {
+            w->return_code = req->return_code;
+        }
+    }
+}
+
+struct rd_batch_key_s {
+    uint64_t key;
+    uint32_t idx;
+};
+
+static int rd_batch_key_cmp(const void * a, const void * b) {
+    const struct rd_batch_key_s * ka = (const struct rd_batch_key_s *) a;
+    const struct rd_batch_key_s * kb = (const struct rd_batch_key_s *) b;
+    if (ka->key != kb->key) {
+        return (ka->key < kb->key) ? -1 : 1;
+    }
+    return (ka->idx < kb->idx) ? -1 : 1;  // stable for equal keys
+}
+
+// The approximate file offset of the first level-0 chunk the request
+// touches, for elevator (offset-sorted) issue order.  The level-1 seek
+// index gives the enclosing index chunk offset without any I/O; its
+// neighboring data chunks follow in append order.  Signals without a
+// seek index fall back to the start sample id, which still matches
+// file order within that signal.  Invalid requests sort wherever and
+// fail in the worker with the usual per-request error code.
+static uint64_t rd_batch_key(struct jls_rd_s * self, const struct jls_rd_fsr_req_s * req) {
+    if (self->msegs || (req->signal_id >= JLS_SIGNAL_COUNT)) {
+        return (uint64_t) req->start_sample_id;
+    }
+    struct jls_core_signal_s * info = &self->core.signal_info[req->signal_id];
+    struct jls_signal_def_s * def = &info->signal_def;
+    int64_t sample_id = req->start_sample_id + def->sample_id_offset;
+    struct jls_fsr_seek_index_s * idx = info->seek_index;
+    int64_t step_size = (int64_t) def->sample_decimate_factor * def->entries_per_summary;
+    if ((NULL != idx) && idx->header.entry_count && (step_size > 0)) {
+        int64_t i = (sample_id - idx->header.timestamp) / step_size;
+        if (i < 0) {
+            i = 0;
+        } else if (i >= (int64_t) idx->header.entry_count) {
+            i = (int64_t) idx->header.entry_count - 1;
+        }
+        return idx->offsets[i];
+    }
+    return (uint64_t) sample_id;
+}
+
+int32_t jls_rd_fsr_batch(struct jls_rd_s * self, struct jls_rd_fsr_req_s * requests, uint32_t count) {
+    ROE(open_wait(self));
+    if (!self || (count && !requests)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (!count) {
+        return 0;
+    }
+    uint32_t workers = count;
+    if (workers > JLS_RD_FSR_BATCH_WORKERS_MAX) {
+        workers = JLS_RD_FSR_BATCH_WORKERS_MAX;
+    }
+
+    // lazily fork one reader per additional worker, worker 0 uses self
+    workers = batch_workers_fork(self, workers);
+
+    // elevator scheduling: issue in file offset order, not request
+    // order, so each worker sweeps one contiguous file region forward
+    // instead of seek-thrashing between caller-ordered windows.  The
+    // sort is a permutation only; results and return codes still land
+    // in the caller's request entries.
+    uint32_t * order = NULL;
+    struct rd_batch_key_s * keys = malloc(count * sizeof(struct rd_batch_key_s));
+    if (NULL != keys) {  // on allocation failure, keep natural order
+        for (uint32_t i = 0; i < count; ++i) {
+            keys[i].key = rd_batch_key(self, &requests[i]);
+            keys[i].idx = i;
+        }
+        qsort(keys, count, sizeof(struct rd_batch_key_s), rd_batch_key_cmp);
+        order = malloc(count * sizeof(uint32_t));
+        if (NULL != order) {
+            for (uint32_t i = 0; i < count; ++i) {
+                order[i] = keys[i].idx;
+            }
+        }
+        free(keys);
+    }
+
+    // contiguous spans of the sorted order, not interleaving: each
+    // worker decodes one contiguous file region and the chunks it
+    // touches stay local to that worker
+    struct rd_batch_worker_s w[JLS_RD_FSR_BATCH_WORKERS_MAX];
+    struct jls_bk_thread_s * threads[JLS_RD_FSR_BATCH_WORKERS_MAX];
+    for (uint32_t k = 0; k < workers; ++k) {
+        w[k].rd = k ? self->batch_rd[k] : self;
+        w[k].requests = requests;
+        w[k].order = order;
+        w[k].offset = (uint32_t) (((uint64_t) count * k) / workers);
+        w[k].end = (uint32_t) (((uint64_t) count * (k + 1)) / workers);
+        w[k].return_code = 0;
+        threads[k] = NULL;
+    }
+    for (uint32_t k = 1; k < workers; ++k) {
+        if (jls_bk_thread_run(&threads[k], rd_batch_worker, &w[k])) {
+            threads[k] = NULL;  // run this worker's slice on the calling thread
+        }
+    }
+    rd_batch_worker(&w[0]);
+
+    int32_t rc = 0;
+    for (uint32_t k = 1; k < workers; ++k) {
+        if (threads[k]) {
+            jls_bk_thread_join(threads[k]);
+        } else {
+            rd_batch_worker(&w[k]);
+        }
+    }
+    for (uint32_t k = 0; k < workers; ++k) {
+        if (w[k].return_code && !rc) {
+            rc = w[k].return_code;
+        }
+    }
+    free(order);
+    return rc;
+}
+
+// SPSC queue index publication for the async-read and prefetch
+// workers: the producer must publish head with release semantics
+// after the request fields, and the consumer must load it with
+// acquire semantics before reading them, matching msg_ring_buffer.c.
+#if defined(_MSC_VER)
+#include <intrin.h>
+static inline uint32_t rdq_load(volatile uint32_t * p) {
+    return (uint32_t) _InterlockedOr((volatile long *) p, 0);
+}
+static inline void rdq_store(volatile uint32_t * p, uint32_t v) {
+    _InterlockedExchange((volatile long *) p, (long) v);
+}
+#else
+static inline uint32_t rdq_load(volatile uint32_t * p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+static inline void rdq_store(volatile uint32_t * p, uint32_t v) {
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+#endif
+
+#define ASYNC_QUEUE_SIZE (64)
+#define ASYNC_IDLE_POLL_MS (1)
+
+struct rd_async_req_s {
+    uint16_t signal_id;
+    int64_t start_sample_id;
+    int64_t data_length;
+    void * data;
+    jls_rd_fsr_async_cbk_fn cbk_fn;
+    void * cbk_user_data;
+};
+
+struct rd_async_s {
+    struct jls_rd_s * rd;   // forked reader, so the parent stays usable while reads run
+    struct jls_bk_thread_s * thread;
+    struct rd_async_req_s queue[ASYNC_QUEUE_SIZE];
+    volatile uint32_t head;         // producer: the calling thread
+    volatile uint32_t tail;         // consumer: the worker thread
+    volatile uint8_t quit;
+};
+
+static void rd_async_worker(void * user_data) {
+    struct rd_async_s * p = (struct rd_async_s *) user_data;
+    while (!p->quit) {
+        uint32_t tail = p->tail;
+        if (rdq_load(&p->head) == tail) {
+            jls_bkt_sleep_ms(ASYNC_IDLE_POLL_MS);
+            continue;
+        }
+        struct rd_async_req_s req = p->queue[tail % ASYNC_QUEUE_SIZE];
+        rdq_store(&p->tail, tail + 1);  // single consumer
+        int32_t rc = jls_rd_fsr(p->rd, req.signal_id, req.start_sample_id,
+                                req.data, req.data_length);
+        req.cbk_fn(req.cbk_user_data, rc);
+    }
+}
+
+static int32_t rd_async_start(struct jls_rd_s * self) {
+    if (NULL != self->fsr_async) {
+        return 0;
+    }
+    struct rd_async_s * p = calloc(1, sizeof(struct rd_async_s));
+    if (NULL == p) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    int32_t rc = jls_rd_fork(self, &p->rd);
+    if (rc) {
+        free(p);
+        return rc;
+    }
+    if (jls_bk_thread_run(&p->thread, rd_async_worker, p)) {
+        jls_rd_close(p->rd);
+        free(p);
+        return JLS_ERROR_UNSPECIFIED;
+    }
+    self->fsr_async = p;
+    return 0;
+}
+
+static void rd_async_stop(struct jls_rd_s * self) {
+    struct rd_async_s * p = self->fsr_async;
+    if (NULL == p) {
+        return;
+    }
+    p->quit = 1;
+    jls_bk_thread_join(p->thread);
+    // every queued request completes exactly once: abort the remainder
+    while (p->tail != p->head) {
+        struct rd_async_req_s * req = &p->queue[p->tail % ASYNC_QUEUE_SIZE];
+        req->cbk_fn(req->cbk_user_data, JLS_ERROR_ABORTED);
+        p->tail = p->tail + 1;
+    }
+    jls_rd_close(p->rd);
+    free(p);
+    self->fsr_async = NULL;
+}
+
+JLS_API int32_t jls_rd_fsr_async(struct jls_rd_s * self, uint16_t signal_id,
+        int64_t start_sample_id, void * data, int64_t data_length,
+        jls_rd_fsr_async_cbk_fn cbk_fn, void * cbk_user_data) {
+    ROE(open_wait(self));
+    if ((NULL == cbk_fn) || (NULL == data) || (data_length <= 0)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    ROE(rd_async_start(self));
+    struct rd_async_s * p = self->fsr_async;
+    uint32_t head = p->head;
+    if ((head - rdq_load(&p->tail)) >= ASYNC_QUEUE_SIZE) {
+        return JLS_ERROR_FULL;
+    }
+    struct rd_async_req_s * req = &p->queue[head % ASYNC_QUEUE_SIZE];
+    req->signal_id = signal_id;
+    req->start_sample_id = start_sample_id;
+    req->data_length = data_length;
+    req->data = data;
+    req->cbk_fn = cbk_fn;
+    req->cbk_user_data = cbk_user_data;
+    rdq_store(&p->head, head + 1);  // single producer, publishes the fields
+    return 0;
+}
+
+#define PREFETCH_QUEUE_SIZE (16)
+#define PREFETCH_IDLE_POLL_MS (2)
+#define PREFETCH_STATS_SLICE (256)  // statistics entries per cancellation check
+
+struct rd_prefetch_req_s {
+    uint16_t signal_id;
+    uint8_t level;
+    int64_t start_sample_id;
+    int64_t sample_count;
+    uint32_t generation;    // stale when it no longer matches, see jls_rd_prefetch_cancel()
+};
+
+struct rd_prefetch_s {
+    struct jls_rd_s * rd;   // forked reader sharing the parent's caches
+    struct jls_bk_thread_s * thread;
+    struct rd_prefetch_req_s queue[PREFETCH_QUEUE_SIZE];
+    volatile uint32_t head;         // producer: the calling thread
+    volatile uint32_t tail;         // consumer: the worker thread
+    volatile uint32_t generation;
+    volatile uint8_t quit;
+};
+
+// decode one anticipated range on the worker thread so the chunks land
+// in the shared chunk cache before the foreground read needs them.
+// Best effort throughout: errors just end the prefetch.
+static void rd_prefetch_one(struct rd_prefetch_s * p, struct rd_prefetch_req_s * req) {
+    struct jls_core_s * core = &p->rd->core;
+    if (jls_core_signal_validate_typed(core, req->signal_id, JLS_SIGNAL_TYPE_FSR)) {
+        return;
+    }
+    struct jls_signal_def_s * def = &core->signal_info[req->signal_id].signal_def;
+    int64_t samples = 0;
+    if (jls_core_fsr_length(core, req->signal_id, &samples)) {
+        return;
+    }
+    int64_t start = (req->start_sample_id < 0) ? 0 : req->start_sample_id;
+    int64_t end = req->start_sample_id + req->sample_count;
+    if (end > samples) {
+        end = samples;
+    }
+    if (start >= end) {
+        return;
+    }
+    if (0 == req->level) {
+        const int64_t slice = def->samples_per_data;
+        const uint8_t sample_size_bits = jls_datatype_parse_size(def->data_type);
+        uint8_t * buf = malloc(1 + ((size_t) slice * sample_size_bits) / 8);
+        if (NULL == buf) {
+            return;
+        }
+        for (int64_t s = start; s < end; s += slice) {
+            if (p->quit || (p->generation != req->generation)) {
+                break;
+            }
+            int64_t n = end - s;
+            if (n > slice) {
+                n = slice;
+            }
+            if (jls_core_fsr(core, req->signal_id, s, buf, n)) {
+                break;
+            }
+        }
+        free(buf);
+    } else {
+        int64_t increment = def->sample_decimate_factor;
+        for (uint8_t lvl = 2; lvl <= req->level; ++lvl) {
+            increment *= def->summary_decimate_factor;
+        }
+        int64_t entries = (end - start) / increment;
+        double * buf = malloc(PREFETCH_STATS_SLICE * JLS_SUMMARY_FSR_COUNT * sizeof(double));
+        if (NULL == buf) {
+            return;
+        }
+        for (int64_t e = 0; e < entries; e += PREFETCH_STATS_SLICE) {
+            if (p->quit || (p->generation != req->generation)) {
+                break;
+            }
+            int64_t n = entries - e;
+            if (n > PREFETCH_STATS_SLICE) {
+                n = PREFETCH_STATS_SLICE;
+            }
+            if (jls_core_fsr_statistics(core, req->signal_id, start + e * increment,
+                                        increment, buf, n)) {
+                break;
+            }
+        }
+        free(buf);
+    }
+}
+
+static void rd_prefetch_worker(void * user_data) {
+    struct rd_prefetch_s * p = (struct rd_prefetch_s *) user_data;
+    while (!p->quit) {
+        uint32_t tail = p->tail;
+        if (rdq_load(&p->head) == tail) {
+            jls_bkt_sleep_ms(PREFETCH_IDLE_POLL_MS);
+            continue;
+        }
+        struct rd_prefetch_req_s req = p->queue[tail % PREFETCH_QUEUE_SIZE];
+        rdq_store(&p->tail, tail + 1);  // single consumer
+        if (req.generation != p->generation) {
+            continue;  // cancelled while queued
+        }
+        rd_prefetch_one(p, &req);
+    }
+}
+
+static int32_t rd_prefetch_start(struct jls_rd_s * self) {
+    if (NULL != self->prefetch) {
+        return 0;
+    }
+    if (NULL == self->core.cache) {
+        // nowhere to keep the prefetched chunks, see jls_rd_cache()
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    struct rd_prefetch_s * p = calloc(1, sizeof(struct rd_prefetch_s));
+    if (NULL == p) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    int32_t rc = jls_rd_fork(self, &p->rd);
+    if (rc) {
+        free(p);
+        return rc;
+    }
+    struct jls_bkm_s * mutex = jls_bkm_initialize();
+    if (NULL == mutex) {
+        jls_rd_close(p->rd);
+        free(p);
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    // share the parent's caches so the prefetched chunks serve the
+    // foreground reads, instead of duplicating cache state per handle
+    self->core.cache_mutex = mutex;
+    p->rd->core.cache = self->core.cache;
+    p->rd->core.cache_mutex = mutex;
+    p->rd->core.shared_cache = self->core.shared_cache;
+    p->rd->core.shared_cache_file_id = self->core.shared_cache_file_id;
+    if (jls_bk_thread_run(&p->thread, rd_prefetch_worker, p)) {
+        p->rd->core.cache = NULL;       // owned by the parent
+        p->rd->core.cache_mutex = NULL;
+        p->rd->core.shared_cache = NULL;
+        jls_rd_close(p->rd);
+        self->core.cache_mutex = NULL;
+        jls_bkm_finalize(mutex);
+        free(p);
+        return JLS_ERROR_UNSPECIFIED;
+    }
+    self->prefetch = p;
+    return 0;
+}
+
+static void rd_prefetch_stop(struct jls_rd_s * self) {
+    struct rd_prefetch_s * p = self->prefetch;
+    if (NULL == p) {
+        return;
+    }
+    p->generation = p->generation + 1;  // abort the range in progress
+    p->quit = 1;
+    jls_bk_thread_join(p->thread);
+    p->rd->core.cache = NULL;           // owned by the parent
+    p->rd->core.cache_mutex = NULL;
+    p->rd->core.shared_cache = NULL;
+    jls_rd_close(p->rd);
+    jls_bkm_finalize(self->core.cache_mutex);
+    self->core.cache_mutex = NULL;
+    free(p);
+    self->prefetch = NULL;
+}
+
+JLS_API int32_t jls_rd_prefetch(struct jls_rd_s * self, uint16_t signal_id,
+                                int64_t start_sample_id, int64_t sample_count, uint8_t level) {
+    ROE(open_wait(self));
+    if ((sample_count <= 0) || (level >= JLS_SUMMARY_LEVEL_COUNT)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (self->msegs) {
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    ROE(rd_prefetch_start(self));
+    struct rd_prefetch_s * p = self->prefetch;
+    uint32_t head = p->head;
+    if ((head - rdq_load(&p->tail)) >= PREFETCH_QUEUE_SIZE) {
+        return JLS_ERROR_FULL;
+    }
+    struct rd_prefetch_req_s * req = &p->queue[head % PREFETCH_QUEUE_SIZE];
+    req->signal_id = signal_id;
+    req->level = level;
+    req->start_sample_id = start_sample_id;
+    req->sample_count = sample_count;
+    req->generation = p->generation;
+    rdq_store(&p->head, head + 1);  // single producer, publishes the fields
+    return 0;
+}
+
+JLS_API int32_t jls_rd_prefetch_cancel(struct jls_rd_s * self) {
+    ROE(open_wait(self));
+    struct rd_prefetch_s * p = self->prefetch;
+    if (NULL != p) {
+        p->generation = p->generation + 1;  // queued and in-progress ranges go stale
+    }
+    return 0;
+}
+
+struct jls_rd_fsr_iter_s {
+    struct jls_core_s * core;
+    uint16_t signal_id;
+    int64_t sample_id;          // next file sample_id to yield
+    int64_t sample_id_end;      // file sample_id end, exclusive
+    int64_t sample_id_offset;   // for conversion back to API sample ids
+    uint8_t entry_size_bits;
+};
+
+int32_t jls_rd_fsr_iter_open(struct jls_rd_s * self, uint16_t signal_id,
+                             int64_t start_sample_id, int64_t sample_count,
+                             struct jls_rd_fsr_iter_s ** iter) {
+    ROE(open_wait(self));
+    if (!self || !iter) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    *iter = NULL;
+    ROE(jls_core_signal_validate_typed(&self->core, signal_id, JLS_SIGNAL_TYPE_FSR));
+    int64_t samples = 0;
+    ROE(jls_core_fsr_length(&self->core, signal_id, &samples));
+    if ((start_sample_id < 0) || (sample_count < 0)
+            || ((start_sample_id + sample_count) > samples)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_signal_def_s * signal_def = &self->core.signal_info[signal_id].signal_def;
+    struct jls_rd_fsr_iter_s * it = calloc(1, sizeof(struct jls_rd_fsr_iter_s));
+    if (!it) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    it->core = &self->core;
+    it->signal_id = signal_id;
+    it->sample_id_offset = signal_def->sample_id_offset;
+    it->sample_id = start_sample_id + it->sample_id_offset;
+    it->sample_id_end = it->sample_id + sample_count;
+    it->entry_size_bits = jls_datatype_parse_size(signal_def->data_type);
+    *iter = it;
+    return 0;
+}
+
+int32_t jls_rd_fsr_iter_next(struct jls_rd_fsr_iter_s * iter,
+                             const void ** data, int64_t * sample_id,
+                             int64_t * sample_count) {
+    if (!iter || !data || !sample_id || !sample_count) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (iter->sample_id >= iter->sample_id_end) {
+        return JLS_ERROR_EMPTY;
+    }
+    struct jls_core_s * core = iter->core;
+    ROE(jls_core_rd_fsr_data0(core, iter->signal_id, iter->sample_id));
+    struct jls_fsr_data_s * r = (struct jls_fsr_data_s *) core->buf->start;
+    int64_t chunk_sample_id = r->header.timestamp;
+    int64_t chunk_sample_count = r->header.entry_count;
+    uint8_t * u8 = (uint8_t *) &r->data[0];
+    if (r->header.entry_size_bits != iter->entry_size_bits) {
+        JLS_LOGE("fsr entry size mismatch");
+        return JLS_ERROR_UNSPECIFIED;
+    }
+
+    int64_t start = iter->sample_id;
+    if (start > chunk_sample_id) {
+        // should only happen on the first block
+        int64_t idx_start = start - chunk_sample_id;
+        if (iter->entry_size_bits < 8) {
+            // start on the containing byte boundary, no shifting
+            int64_t samples_per_byte = 8 / iter->entry_size_bits;
+            idx_start -= idx_start % samples_per_byte;
+            start = chunk_sample_id + idx_start;
+        }
+        u8 += (idx_start * iter->entry_size_bits) / 8;
+    }
+    int64_t count = chunk_sample_id + chunk_sample_count - start;
+    if ((start + count) > iter->sample_id_end) {
+        count = iter->sample_id_end - start;
+    }
+
+    *data = u8;
+    *sample_id = start - iter->sample_id_offset;
+    *sample_count = count;
+    iter->sample_id = start + count;
+    return 0;
+}
+
+void jls_rd_fsr_iter_close(struct jls_rd_fsr_iter_s * iter) {
+    if (iter) {
+        free(iter);
+    }
+}
+
+#define EXPORT_BATCH_SAMPLES_DEFAULT (65536)
+#define EXPORT_PREFETCH_CHUNKS_DEFAULT (2)
+
+JLS_API int32_t jls_rd_fsr_export(struct jls_rd_s * self, uint16_t signal_id,
+                                  int64_t start_sample_id, int64_t sample_count,
+                                  int64_t batch_size, uint32_t prefetch_chunks,
+                                  jls_rd_fsr_export_fn fn, void * user_data) {
+    ROE(open_wait(self));
+    if (!self || !fn || (batch_size < 0)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_core_s * core = &self->core;
+    ROE(jls_core_signal_validate_typed(core, signal_id, JLS_SIGNAL_TYPE_FSR));
+    int64_t samples = 0;
+    ROE(jls_core_fsr_length(core, signal_id, &samples));
+    if ((start_sample_id < 0) || (sample_count < 0)
+            || ((start_sample_id + sample_count) > samples)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_signal_def_s * signal_def = &core->signal_info[signal_id].signal_def;
+    const int64_t sample_id_offset = signal_def->sample_id_offset;
+    const uint8_t entry_size_bits = jls_datatype_parse_size(signal_def->data_type);
+    if (0 == batch_size) {
+        batch_size = EXPORT_BATCH_SAMPLES_DEFAULT;
+    }
+    if (0 == prefetch_chunks) {
+        prefetch_chunks = EXPORT_PREFETCH_CHUNKS_DEFAULT;
+    }
+
+    int64_t pos = start_sample_id + sample_id_offset;       // file sample id
+    int64_t pos_end = pos + sample_count;
+    if (entry_size_bits < 8) {
+        // batches copy whole bytes: start on the containing byte
+        // boundary and size the batch to a whole number of bytes
+        int64_t samples_per_byte = 8 / entry_size_bits;
+        pos -= pos % samples_per_byte;
+        batch_size += (samples_per_byte - 1);
+        batch_size -= batch_size % samples_per_byte;
+    }
+    uint8_t * batch = malloc((size_t) ((batch_size * entry_size_bits + 7) / 8));
+    if (!batch) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    int32_t rc = 0;
+    int64_t batch_fill = 0;         // samples staged in batch
+    int64_t batch_sample_id = 0;    // file sample id of batch[0]
+
+    while (pos < pos_end) {
+        GOE(jls_core_rd_fsr_data0(core, signal_id, pos));
+        struct jls_fsr_data_s * r = (struct jls_fsr_data_s *) core->buf->start;
+        if (r->header.entry_size_bits != entry_size_bits) {
+            JLS_LOGE("fsr entry size mismatch");
+            rc = JLS_ERROR_UNSPECIFIED;
+            goto exit;
+        }
+        int64_t chunk_sample_id = r->header.timestamp;
+        int64_t chunk_end = chunk_sample_id + r->header.entry_count;
+        if (core->chunk_cur.hdr.item_next) {
+            // fetched by the operating system while fn processes batches
+            int64_t chunk_span = sizeof(struct jls_chunk_header_s)
+                    + core->chunk_cur.hdr.payload_length + 4;
+            jls_bk_readahead(jls_raw_backend(core->raw), core->chunk_cur.hdr.item_next,
+                             prefetch_chunks * chunk_span);
+        }
+        int64_t end = (chunk_end < pos_end) ? chunk_end : pos_end;
+        while (pos < end) {
+            int64_t n = end - pos;
+            if (n > (batch_size - batch_fill)) {
+                n = batch_size - batch_fill;
+            }
+            if (0 == batch_fill) {
+                batch_sample_id = pos;
+            }
+            memcpy(batch + (batch_fill * entry_size_bits) / 8,
+                   ((uint8_t *) &r->data[0]) + ((pos - chunk_sample_id) * entry_size_bits) / 8,
+                   (size_t) ((n * entry_size_bits + 7) / 8));
+            batch_fill += n;
+            pos += n;
+            if (batch_fill >= batch_size) {
+                if (fn(user_data, batch, batch_sample_id - sample_id_offset, batch_fill)) {
+                    rc = JLS_ERROR_ABORTED;
+                    goto exit;
+                }
+                batch_fill = 0;
+            }
+        }
+    }
+    if (batch_fill) {
+        if (fn(user_data, batch, batch_sample_id - sample_id_offset, batch_fill)) {
+            rc = JLS_ERROR_ABORTED;
+        }
+    }
+
+exit:
+    free(batch);
+    return rc;
+}
+
+static inline void f32_to_stats(struct jls_statistics_s * stats, const float * data, int64_t count) {
+    stats->k = count;
+    stats->mean = data[JLS_SUMMARY_FSR_MEAN];
+    stats->min = data[JLS_SUMMARY_FSR_MIN];
+    stats->max = data[JLS_SUMMARY_FSR_MAX];
+    if (count > 1) {
+        stats->s = ((double) data[JLS_SUMMARY_FSR_STD]) * data[JLS_SUMMARY_FSR_STD] * (count - 1);
+    } else {
+        stats->s = 0.0;
+    }
+}
+
+static inline void stats_to_f64(double * data, struct jls_statistics_s * stats) {
+    data[JLS_SUMMARY_FSR_MEAN] = stats->mean;
+    data[JLS_SUMMARY_FSR_MIN] = stats->min;
+    data[JLS_SUMMARY_FSR_MAX] = stats->max;
+    data[JLS_SUMMARY_FSR_STD] = sqrt(jls_statistics_var(stats));
+}
+
+static inline void f64_to_stats(struct jls_statistics_s * stats, const double * data, int64_t count) {
+    stats->k = count;
+    stats->mean = data[JLS_SUMMARY_FSR_MEAN];
+    stats->min = data[JLS_SUMMARY_FSR_MIN];
+    stats->max = data[JLS_SUMMARY_FSR_MAX];
+    if (count > 1) {
+        stats->s = ((double) data[JLS_SUMMARY_FSR_STD]) * data[JLS_SUMMARY_FSR_STD] * (count - 1);
+    } else {
+        stats->s = 0.0;
+    }
+}
+
+static int32_t rd_stats_chunk(struct jls_core_s * self, uint16_t signal_id, uint8_t level) {
+    ROE(jls_core_rd_chunk(self));
+    if (JLS_TAG_TRACK_FSR_SUMMARY != self->chunk_cur.hdr.tag) {
+        JLS_LOGW("unexpected chunk tag %d at %" PRIi64, (int) self->chunk_cur.hdr.tag, self->chunk_cur.offset);
+        return JLS_ERROR_IO;
+    }
+    uint16_t metadata = (signal_id & SIGNAL_MASK) | (((uint16_t) level) << 12);
+    if (metadata != self->chunk_cur.hdr.chunk_meta) {
+        JLS_LOGW("unexpected chunk meta 0x%04x", (unsigned int) self->chunk_cur.hdr.chunk_meta);
+        return JLS_ERROR_IO;
+    }
+
+    /*
+    // display stats chunk data
+    int64_t *i64 = (int64_t *) self->payload.start;
+    JLS_LOGI("stats chunk: sample_id=%" PRIi64 ", entries=%" PRIi64, i64[0], i64[1]);
+    float * d = (float *) &i64[2];
+    for (int64_t i = 0; i < i64[1] * 4; i += 4) {
+        JLS_LOGI("stats: mean=%f min=%f max=%f std=%f",
+            d[i + JLS_SUMMARY_FSR_MEAN],
+            d[i + JLS_SUMMARY_FSR_MIN],
+            d[i + JLS_SUMMARY_FSR_MAX],
+            d[i + JLS_SUMMARY_FSR_STD]);
+    }
+    */
+    return 0;
+}
+
+// accumulate raw level-0 samples over file sample ids [a, b)
+static int32_t fsr_stats_level0(struct jls_core_s * self, uint16_t signal_id,
+                                int64_t a, int64_t b, struct jls_statistics_s * stats) {
+    struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
+    struct jls_statistics_s stats_next;
+    ROE(jls_core_f64_buf_alloc(self, (size_t) signal_def->samples_per_data, &self->f64_sample_buf));
+    while (a < b) {
+        ROE(jls_core_rd_fsr_data0(self, signal_id, a));
+        struct jls_fsr_data_s * s = (struct jls_fsr_data_s *) self->buf->start;
+        int64_t chunk_sample_id = s->header.timestamp;
+        jls_dt_buffer_to_f64(&s->data[0], signal_def->data_type,
+                             self->f64_sample_buf->start, signal_def->samples_per_data);
+        int64_t idx = a - chunk_sample_id;
+        int64_t count = (int64_t) s->header.entry_count - idx;
+        if (count > (b - a)) {
+            count = b - a;
+        }
+        if (count <= 0) {
+            JLS_LOGW("stats level 0: no samples at %" PRIi64, a);
+            return JLS_ERROR_NOT_FOUND;
+        }
+        jls_statistics_compute_f64(&stats_next, &self->f64_sample_buf->start[idx], (uint64_t) count);
+        jls_statistics_combine(stats, stats, &stats_next);
+        a += count;
+    }
+    return 0;
+}
+
+// accumulate level summary entries over file sample ids [a, b), both step aligned
+static int32_t fsr_stats_level_n(struct jls_core_s * self, uint16_t signal_id, uint8_t level,
+                                 int64_t a, int64_t b, int64_t step, struct jls_statistics_s * stats) {
+    ROE(jls_core_fsr_seek(self, signal_id, level, a));   // the index
+    ROE(jls_raw_chunk_next(self->raw));                  // the summary
+    ROE(rd_stats_chunk(self, signal_id, level));
+    while (a < b) {
+        struct jls_fsr_f32_summary_s * f32_summary = (struct jls_fsr_f32_summary_s *) self->buf->start;
+        struct jls_fsr_f64_summary_s * f64_summary = (struct jls_fsr_f64_summary_s *) self->buf->start;
+        bool is_f32;
+        if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(float) * 8) {
+            is_f32 = true;
+        } else if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(double) * 8) {
+            is_f32 = false;
+        } else {
+            JLS_LOGE("invalid summary entry size: %d", (int) f32_summary->header.entry_size_bits);
+            return JLS_ERROR_PARAMETER_INVALID;
+        }
+        int64_t src_offset = (a - f32_summary->header.timestamp) / step;
+        int64_t src_end = f32_summary->header.entry_count;
+        int64_t entries = src_end - src_offset;  // [a, b) is step aligned
+        if (entries > ((b - a) / step)) {
+            entries = (b - a) / step;
+        }
+        if (entries > 0) {
+            if (is_f32) {
+                jls_statistics_combine_summary_f32(stats, f32_summary->data[src_offset],
+                                                   (uint64_t) entries, (uint64_t) step);
+            } else {
+                jls_statistics_combine_summary_f64(stats, f64_summary->data[src_offset],
+                                                   (uint64_t) entries, (uint64_t) step);
+            }
+            a += entries * step;
+        }
+        if (a < b) {
+            if (!self->chunk_cur.hdr.item_next) {
+                JLS_LOGW("stats level %d: missing summary at %" PRIi64, (int) level, a);
+                return JLS_ERROR_NOT_FOUND;
+            }
+            ROE(jls_raw_chunk_seek(self->raw, self->chunk_cur.hdr.item_next));
+            ROE(rd_stats_chunk(self, signal_id, level));
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Compute statistics over file sample ids [a, b) by level decomposition.
+ *
+ * Decomposes the range like a segment tree query: the largest aligned
+ * summary spans at this level, with the unaligned edges delegated to
+ * the next lower level down to level 0 sample data.  This touches at
+ * most two partially covered summary chunks per level instead of
+ * walking the whole range at a single granularity.
+ */
+static int32_t fsr_stats_interval(struct jls_core_s * self, uint16_t signal_id, uint8_t level,
+                                  int64_t a, int64_t b, struct jls_statistics_s * stats) {
+    if (a >= b) {
+        return 0;
+    }
+    if (0 == level) {
+        return fsr_stats_level0(self, signal_id, a, b, stats);
+    }
+    struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
+    int64_t step = signal_def->sample_decimate_factor;
+    for (uint8_t lvl = 2; lvl <= level; ++lvl) {
+        step *= signal_def->summary_decimate_factor;
+    }
+    const int64_t base = signal_def->sample_id_offset;  // summary entry alignment
+    int64_t a_up = base + ((a - base + step - 1) / step) * step;
+    int64_t b_dn = base + ((b - base) / step) * step;
+    if (a_up >= b_dn) {
+        return fsr_stats_interval(self, signal_id, level - 1, a, b, stats);
+    }
+    ROE(fsr_stats_interval(self, signal_id, level - 1, a, a_up, stats));
+    ROE(fsr_stats_level_n(self, signal_id, level, a_up, b_dn, step, stats));
+    return fsr_stats_interval(self, signal_id, level - 1, b_dn, b, stats);
+}
+
+static int32_t fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
+                              int64_t start_sample_id, int64_t increment, uint8_t level,
+                              double * data, int64_t data_length) {
+    // start_sample_id in JLS units with possible non-zero offset
+    JLS_LOGD2("fsr_f32_statistics(signal_id=%d, start_id=%" PRIi64 ", incr=%" PRIi64 ", level=%d, len=%" PRIi64 ")",
+              (int) signal_id, start_sample_id, increment, (int) level, data_length);
+    bool is_f32;
+    struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
+    int64_t step_size = signal_def->sample_decimate_factor;
+    for (uint8_t lvl = 2; lvl <= level; ++lvl) {
+        step_size *= signal_def->summary_decimate_factor;
+    }
+    double f64_tmp4[JLS_SUMMARY_FSR_COUNT];
+    const int64_t sample_id_offset = signal_def->sample_id_offset;
+
+    ROE(jls_core_fsr_seek(self, signal_id, level, start_sample_id)); // returns the index
+    ROE(jls_raw_chunk_next(self->raw));  // statistics
+    int64_t pos = jls_raw_chunk_tell(self->raw);
+    ROE(rd_stats_chunk(self, signal_id, level));
+
+    struct jls_fsr_f32_summary_s * f32_summary = (struct jls_fsr_f32_summary_s *) self->buf->start;
+    struct jls_fsr_f64_summary_s * f64_summary = (struct jls_fsr_f64_summary_s *) self->buf->start;
+    int64_t chunk_sample_id = f32_summary->header.timestamp;
+    if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(float) * 8) {
+        is_f32 = true;  // 32-bit float summaries
+    } else if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(double) * 8) {
+        is_f32 = false; // 64-bit float summaries
+    } else {
+        JLS_LOGE("invalid summary entry size: %d", (int) f32_summary->header.entry_size_bits);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    int64_t src_offset = 0;
+    int64_t src_end = f32_summary->header.entry_count;
+    int64_t entry_offset = ((start_sample_id - chunk_sample_id + step_size - 1) / step_size);
+    int64_t entry_sample_id = entry_offset * step_size + chunk_sample_id;
+
+    struct jls_statistics_s stats_accum;
+    jls_statistics_reset(&stats_accum);
+    struct jls_statistics_s stats_next;
+
+    int64_t incr_remaining = increment;
+
+    if (entry_sample_id != start_sample_id) {
+        int64_t incr = entry_sample_id - start_sample_id;
+        // invalidates stats, need to reload, providing API sample_id
+        ROE(jls_core_fsr_statistics(self, signal_id, start_sample_id - sample_id_offset,
+                                  incr, f64_tmp4, 1));
+        ROE(jls_raw_chunk_seek(self->raw, pos));
+        ROE(rd_stats_chunk(self, signal_id, level));
+        f64_to_stats(&stats_accum, f64_tmp4, incr);
+        incr_remaining -= incr;
+        start_sample_id += incr;
+    }
+    src_offset += entry_offset;
+
+    while (data_length) {
+        if (src_offset >= src_end) {
+            if (self->chunk_cur.hdr.item_next) {
+                ROE(jls_raw_chunk_seek(self->raw, self->chunk_cur.hdr.item_next));
+                ROE(rd_stats_chunk(self, signal_id, level));
+                f32_summary = (struct jls_fsr_f32_summary_s *) self->buf->start;
+                f64_summary = (struct jls_fsr_f64_summary_s *) self->buf->start;
+                if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(float) * 8) {
+                    is_f32 = true;  // 32-bit float summaries
+                } else if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(double) * 8) {
+                    is_f32 = false; // 64-bit float summaries
+                } else {
+                    JLS_LOGE("invalid summary entry size: %d", (int) f32_summary->header.entry_size_bits);
+                    return JLS_ERROR_PARAMETER_INVALID;
+                }
+                src_offset = 0;
+                src_end = f32_summary->header.entry_count;
+            } else {
+                if ((incr_remaining <= step_size) && (data_length == 1)) {
+                    // not a problem, will fetch from lower statistics
+                } else {
+                    JLS_LOGW("cannot get final %" PRIi64 " samples", data_length);
+                    for (int64_t idx = 0; idx < (JLS_SUMMARY_FSR_COUNT * data_length); ++idx) {
+                        data[idx] = NAN;
+                    }
+                    return JLS_ERROR_PARAMETER_INVALID;
+                }
+            }
+        }
+
+        if (incr_remaining <= step_size) {
+            if (data_length == 1) {
+                ROE(jls_core_fsr_statistics(self, signal_id, start_sample_id - sample_id_offset,
+                                            incr_remaining, f64_tmp4, 1));
+                f64_to_stats(&stats_next, f64_tmp4, incr_remaining);
+            } else if (is_f32) {
+                f32_to_stats(&stats_next, f32_summary->data[src_offset], incr_remaining);
+            } else {
+                f64_to_stats(&stats_next, f64_summary->data[src_offset], incr_remaining);
+            }
+            jls_statistics_combine(&stats_accum, &stats_accum, &stats_next);
+            stats_to_f64(data, &stats_accum);
+            data += JLS_SUMMARY_FSR_COUNT;
+            --data_length;
+            int64_t incr = step_size - incr_remaining;
+            if (incr < 0) {
+                JLS_LOGE("internal error");
+                incr = 0;
+                jls_statistics_reset(&stats_accum);
+            } else if (incr == 0) {
+                jls_statistics_reset(&stats_accum);
+            } else if (is_f32) {
+                f32_to_stats(&stats_accum, f32_summary->data[src_offset], incr);
+            } else {
+                f64_to_stats(&stats_accum, f64_summary->data[src_offset], incr);
+            }
+            incr_remaining = increment - incr;
+        } else {
+            // batch the run of whole entries before the next output boundary
+            int64_t entries = (incr_remaining - 1) / step_size;  // leave incr_remaining > 0
+            if (entries > (src_end - src_offset)) {
+                entries = src_end - src_offset;
+            }
+            if (is_f32) {
+                jls_statistics_combine_summary_f32(&stats_accum, f32_summary->data[src_offset],
+                                                   (uint64_t) entries, (uint64_t) step_size);
+            } else {
+                jls_statistics_combine_summary_f64(&stats_accum, f64_summary->data[src_offset],
+                                                   (uint64_t) entries, (uint64_t) step_size);
+            }
+            incr_remaining -= (entries - 1) * step_size;
+            start_sample_id += (entries - 1) * step_size;
+            src_offset += entries - 1;
+            incr_remaining -= step_size;
+        }
+        start_sample_id += step_size;
+        ++src_offset;
+    }
+    return 0;
+}
+
+/**
+ * @brief Produce exactly data_length entries over [start, end) from summaries.
+ *
+ * @param self The core instance.
+ * @param signal_id The signal id.
+ * @param start_sample_id The starting JLS file sample id (offset applied).
+ * @param end_sample_id The ending JLS file sample id, exclusive.
+ * @param data The caller buffer of data_length * JLS_SUMMARY_FSR_COUNT doubles.
+ * @param data_length The number of output entries.
+ * @return 0 or error code.
+ *
+ * Walks the coarsest stored summary level whose entries fit within one
+ * output entry, splitting the summary entries that straddle output
+ * boundaries proportionally.  Output boundaries are computed with
+ * integer rounding so any data_length maps onto the span without the
+ * caller aligning to the stored summary geometry, and level-0 sample
+ * data is never touched.  Split entries reuse the summary entry's
+ * statistics scaled to the covered sample count, an approximation
+ * suitable for display.
+ */
+static int32_t fsr_statistics_resample(struct jls_core_s * self, uint16_t signal_id,
+                                       int64_t start_sample_id, int64_t end_sample_id,
+                                       double * data, int64_t data_length) {
+    struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
+    int64_t * head_offsets = self->signal_info[signal_id].tracks[JLS_TRACK_TYPE_FSR].head_offsets;
+    const int64_t span = end_sample_id - start_sample_id;
+    bool is_f32;
+
+    uint8_t level = 1;
+    int64_t step = signal_def->sample_decimate_factor;
+    while (((level + 1) < JLS_SUMMARY_LEVEL_COUNT) && head_offsets[level + 1]
+            && ((step * (int64_t) signal_def->summary_decimate_factor * data_length) <= span)) {
+        ++level;
+        step *= signal_def->summary_decimate_factor;
+    }
+
+    ROE(jls_core_fsr_seek(self, signal_id, level, start_sample_id));  // the index
+    ROE(jls_raw_chunk_next(self->raw));                               // the summary
+    ROE(rd_stats_chunk(self, signal_id, level));
+
+    struct jls_fsr_f32_summary_s * f32_summary = (struct jls_fsr_f32_summary_s *) self->buf->start;
+    struct jls_fsr_f64_summary_s * f64_summary = (struct jls_fsr_f64_summary_s *) self->buf->start;
+    int64_t chunk_sample_id = f32_summary->header.timestamp;
+    int64_t src_offset = (start_sample_id - chunk_sample_id) / step;
+    int64_t src_end = f32_summary->header.entry_count;
+
+    struct jls_statistics_s accum;
+    struct jls_statistics_s part;
+    jls_statistics_reset(&accum);
+    int64_t cursor = start_sample_id;
+    int64_t k = 0;
+    int64_t boundary = start_sample_id + span / data_length;
+
+    while (k < data_length) {
+        if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(float) * 8) {
+            is_f32 = true;
+        } else if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(double) * 8) {
+            is_f32 = false;
+        } else {
+            JLS_LOGE("invalid summary entry size: %d", (int) f32_summary->header.entry_size_bits);
+            return JLS_ERROR_PARAMETER_INVALID;
+        }
+        while ((src_offset < src_end) && (k < data_length)) {
+            const int64_t entry_end = chunk_sample_id + (src_offset + 1) * step;
+            int64_t n;
+            while ((k < data_length) && (boundary <= entry_end)) {
+                n = boundary - cursor;
+                if (n > 0) {
+                    if (is_f32) {
+                        f32_to_stats(&part, f32_summary->data[src_offset], n);
+                    } else {
+                        f64_to_stats(&part, f64_summary->data[src_offset], n);
+                    }
+                    jls_statistics_combine(&accum, &accum, &part);
+                }
+                stats_to_f64(&data[k * JLS_SUMMARY_FSR_COUNT], &accum);
+                jls_statistics_reset(&accum);
+                cursor = boundary;
+                ++k;
+                boundary = start_sample_id + ((k + 1) * span) / data_length;
+            }
+            if (k >= data_length) {
+                break;
+            }
+            n = entry_end - cursor;
+            if (n == step) {
+                // whole entries: batch the run that ends before the boundary
+                int64_t entries = (boundary - cursor - 1) / step;  // >= 1, boundary > entry_end
+                if (entries > (src_end - src_offset)) {
+                    entries = src_end - src_offset;
+                }
+                if (is_f32) {
+                    jls_statistics_combine_summary_f32(&accum, f32_summary->data[src_offset],
+                                                       (uint64_t) entries, (uint64_t) step);
+                } else {
+                    jls_statistics_combine_summary_f64(&accum, f64_summary->data[src_offset],
+                                                       (uint64_t) entries, (uint64_t) step);
+                }
+                cursor += entries * step;
+                src_offset += entries;
+            } else {
+                if (n > 0) {
+                    if (is_f32) {
+                        f32_to_stats(&part, f32_summary->data[src_offset], n);
+                    } else {
+                        f64_to_stats(&part, f64_summary->data[src_offset], n);
+                    }
+                    jls_statistics_combine(&accum, &accum, &part);
+                    cursor = entry_end;
+                }
+                ++src_offset;
+            }
+        }
+        if (k < data_length) {
+            if (!self->chunk_cur.hdr.item_next) {
+                JLS_LOGW("resample: missing summary at %" PRIi64, cursor);
+                for (int64_t idx = k * JLS_SUMMARY_FSR_COUNT;
+                        idx < (data_length * JLS_SUMMARY_FSR_COUNT); ++idx) {
+                    data[idx] = NAN;
+                }
+                return JLS_ERROR_NOT_FOUND;
+            }
+            ROE(jls_raw_chunk_seek(self->raw, self->chunk_cur.hdr.item_next));
+            ROE(rd_stats_chunk(self, signal_id, level));
+            f32_summary = (struct jls_fsr_f32_summary_s *) self->buf->start;
+            f64_summary = (struct jls_fsr_f64_summary_s *) self->buf->start;
+            chunk_sample_id = f32_summary->header.timestamp;
+            src_offset = 0;
+            src_end = f32_summary->header.entry_count;
+        }
+    }
+    return 0;
+}
+
+int32_t jls_core_fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
+                              int64_t start_sample_id, int64_t increment,
+                              double * data, int64_t data_length) {
+    // API zero-based start_sample_id
+    ROE(jls_core_signal_validate_typed(self, signal_id, JLS_SIGNAL_TYPE_FSR));
+    if (increment <= 0) {
+        JLS_LOGW("invalid increment: %" PRIi64, increment);
+        return JLS_ERROR_PARAMETER_INVALID;
+    } else if (data_length <= 0) {
+        JLS_LOGW("invalid length: %" PRIi64, data_length);
+        return 0;
+    } else if (start_sample_id < 0) {
+        JLS_LOGW("invalid start_sample_id: %" PRIi64, start_sample_id);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+
+    int64_t samples = 0;
+    ROE(jls_core_fsr_length(self, signal_id, &samples));
+    int64_t end_sample_id = start_sample_id + increment * data_length;
+    if (end_sample_id > samples) {
+        JLS_LOGW("invalid length: %" PRIi64 " > %" PRIi64, end_sample_id, samples);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
+    const int64_t sample_id_offset = signal_def->sample_id_offset;
+
+    uint8_t level = 0;
+    int64_t sample_multiple_next = signal_def->sample_decimate_factor;
+    int64_t duration = increment * data_length;
+    while ((increment >= sample_multiple_next)
+            && (duration >= (DECIMATE_PER_DURATION * sample_multiple_next))) {
+        ++level;
+        sample_multiple_next *= signal_def->summary_decimate_factor;
+    }
+    start_sample_id += sample_id_offset; // JLS file sample_id
+
+    if (level && (1 == data_length)) {
+        // single interval: decompose into the minimal mix of summary spans
+        // plus finer edges instead of walking the range at one granularity
+        int64_t * head_offsets = self->signal_info[signal_id].tracks[JLS_TRACK_TYPE_FSR].head_offsets;
+        while (((level + 1) < JLS_SUMMARY_LEVEL_COUNT) && head_offsets[level + 1]
+                && (sample_multiple_next <= increment)) {
+            ++level;
+            sample_multiple_next *= signal_def->summary_decimate_factor;
+        }
+        struct jls_statistics_s stats;
+        jls_statistics_reset(&stats);
+        ROE(fsr_stats_interval(self, signal_id, level, start_sample_id,
+                               start_sample_id + increment, &stats));
+        stats_to_f64(data, &stats);
+        return 0;
+    }
+
+    if (level) {  // use summaries
+        return fsr_statistics(self, signal_id, start_sample_id, increment, level, data, data_length);
+    }  // else, use sample data
+    JLS_LOGD2("f32(signal_id=%d, start_id=%" PRIi64 ", incr=%" PRIi64 ", level=0, len=%" PRIi64 ")",
+              (int) signal_id, start_sample_id, increment, data_length);
+
+    ROE(jls_core_f64_buf_alloc(self, (size_t) increment, &self->f64_stats_buf));
+    ROE(jls_core_f64_buf_alloc(self, (size_t) signal_def->samples_per_data, &self->f64_sample_buf));
+    int64_t buf_offset = 0;
+    uint8_t entry_size_bits = jls_datatype_parse_size(signal_def->data_type);
+    if (entry_size_bits > 32) {
+        JLS_LOGE("entry_size > 64 (float64 stats) not yet supported");
+        return JLS_ERROR_UNSUPPORTED_FILE;
+    }
+
+    ROE(jls_core_rd_fsr_data0(self, signal_id, start_sample_id));
+    struct jls_fsr_data_s * s = (struct jls_fsr_data_s *) self->buf->start;
+    int64_t chunk_sample_id = s->header.timestamp;
+    if (s->header.entry_size_bits != entry_size_bits) {
+        JLS_LOGE("invalid data entry size: %d", (int) s->header.entry_size_bits);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    jls_dt_buffer_to_f64(&s->data[0], signal_def->data_type, self->f64_sample_buf->start, signal_def->samples_per_data);
+    double * src = &self->f64_sample_buf->start[0];
+    double * src_end = &self->f64_sample_buf->start[s->header.entry_count];
+    if (start_sample_id > chunk_sample_id) {
+        src += start_sample_id - chunk_sample_id;
+    }
+    double v_mean = 0.0;
+    double v_min = DBL_MAX;
+    double v_max = -DBL_MAX;
+    double v_var = 0.0;
+    double mean_scale = 1.0 / increment;
+    double var_scale = 1.0;
+    if (increment > 1) {
+        var_scale = 1.0 / (increment - 1.0);
+    }
+    double v;
+
+    while (data_length > 0) {
+        if (src >= src_end) {
+            ROE(jls_core_rd_fsr_data0(self, signal_id, start_sample_id));
+            s = (struct jls_fsr_data_s *) self->buf->start;
+            chunk_sample_id = s->header.timestamp;
+            jls_dt_buffer_to_f64(&s->data[0], signal_def->data_type, self->f64_sample_buf->start, signal_def->samples_per_data);
+            src = &self->f64_sample_buf->start[0];
+            src_end = &self->f64_sample_buf->start[s->header.entry_count];
+        }
+        v = *src++;
+        v_mean += v;
+        if (v < v_min) {
+            v_min = v;
+        }
+        if (v > v_max) {
+            v_max = v;
+        }
+        self->f64_stats_buf->start[buf_offset++] = v;
+
+        if (buf_offset >= increment) {
+            v_mean *= mean_scale;
+            v_var = 0.0;
+            for (int64_t i = 0; i < increment; ++i) {
+                double v_diff = self->f64_stats_buf->start[i] - v_mean;
+                v_var += v_diff * v_diff;
+            }
+            v_var *= var_scale;
+
+            data[JLS_SUMMARY_FSR_MEAN] = v_mean;
+            data[JLS_SUMMARY_FSR_MIN] = v_min;
+            data[JLS_SUMMARY_FSR_MAX] = v_max;
+            data[JLS_SUMMARY_FSR_STD] = sqrt(v_var);
+            data += JLS_SUMMARY_FSR_COUNT;
+
+            buf_offset = 0;
+            v_mean = 0.0;
+            v_min = DBL_MAX;
+            v_max = -DBL_MAX;
+            --data_length;
+        }
+        ++start_sample_id;
+    }
+    return 0;
+}
+
+static int32_t fsr_envelope(struct jls_core_s * self, uint16_t signal_id,
+                            int64_t start_sample_id, int64_t increment, uint8_t level,
+                            float * data, int64_t data_length) {
+    // start_sample_id in JLS units with possible non-zero offset
+    bool is_f32;
+    struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
+    int64_t step_size = signal_def->sample_decimate_factor;
+    for (uint8_t lvl = 2; lvl <= level; ++lvl) {
+        step_size *= signal_def->summary_decimate_factor;
+    }
+    double f64_tmp4[JLS_SUMMARY_FSR_COUNT];
+    const int64_t sample_id_offset = signal_def->sample_id_offset;
+
+    ROE(jls_core_fsr_seek(self, signal_id, level, start_sample_id)); // returns the index
+    ROE(jls_raw_chunk_next(self->raw));  // statistics
+    int64_t pos = jls_raw_chunk_tell(self->raw);
+    ROE(rd_stats_chunk(self, signal_id, level));
+
+    struct jls_fsr_f32_summary_s * f32_summary = (struct jls_fsr_f32_summary_s *) self->buf->start;
+    struct jls_fsr_f64_summary_s * f64_summary = (struct jls_fsr_f64_summary_s *) self->buf->start;
+    int64_t chunk_sample_id = f32_summary->header.timestamp;
+    if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(float) * 8) {
+        is_f32 = true;  // 32-bit float summaries
+    } else if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(double) * 8) {
+        is_f32 = false; // 64-bit float summaries
+    } else {
+        JLS_LOGE("invalid summary entry size: %d", (int) f32_summary->header.entry_size_bits);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    int64_t src_offset = 0;
+    int64_t src_end = f32_summary->header.entry_count;
+    int64_t entry_offset = ((start_sample_id - chunk_sample_id + step_size - 1) / step_size);
+    int64_t entry_sample_id = entry_offset * step_size + chunk_sample_id;
+
+    double v_min = DBL_MAX;
+    double v_max = -DBL_MAX;
+    int64_t incr_remaining = increment;
+
+    if (entry_sample_id != start_sample_id) {
+        int64_t incr = entry_sample_id - start_sample_id;
+        // invalidates the loaded chunk, need to reload, providing API sample_id
+        ROE(jls_core_fsr_statistics(self, signal_id, start_sample_id - sample_id_offset,
+                                    incr, f64_tmp4, 1));
+        ROE(jls_raw_chunk_seek(self->raw, pos));
+        ROE(rd_stats_chunk(self, signal_id, level));
+        v_min = f64_tmp4[JLS_SUMMARY_FSR_MIN];
+        v_max = f64_tmp4[JLS_SUMMARY_FSR_MAX];
+        incr_remaining -= incr;
+        start_sample_id += incr;
+    }
+    src_offset += entry_offset;
+
+    while (data_length) {
         if (src_offset >= src_end) {
             if (self->chunk_cur.hdr.item_next) {
                 ROE(jls_raw_chunk_seek(self->raw, self->chunk_cur.hdr.item_next));
@@ -349,7 +2538,7 @@ static int32_t fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
                     // not a problem, will fetch from lower statistics
                 } else {
                     JLS_LOGW("cannot get final %" PRIi64 " samples", data_length);
-                    for (int64_t idx = 0; idx < (JLS_SUMMARY_FSR_COUNT * data_length); ++idx) {
+                    for (int64_t idx = 0; idx < (2 * data_length); ++idx) {
                         data[idx] = NAN;
                     }
                     return JLS_ERROR_PARAMETER_INVALID;
@@ -357,40 +2546,58 @@ static int32_t fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
             }
         }
 
+        double e_min;
+        double e_max;
         if (incr_remaining <= step_size) {
             if (data_length == 1) {
                 ROE(jls_core_fsr_statistics(self, signal_id, start_sample_id - sample_id_offset,
                                             incr_remaining, f64_tmp4, 1));
-                f64_to_stats(&stats_next, f64_tmp4, incr_remaining);
+                e_min = f64_tmp4[JLS_SUMMARY_FSR_MIN];
+                e_max = f64_tmp4[JLS_SUMMARY_FSR_MAX];
             } else if (is_f32) {
-                f32_to_stats(&stats_next, f32_summary->data[src_offset], incr_remaining);
+                e_min = f32_summary->data[src_offset][JLS_SUMMARY_FSR_MIN];
+                e_max = f32_summary->data[src_offset][JLS_SUMMARY_FSR_MAX];
             } else {
-                f64_to_stats(&stats_next, f64_summary->data[src_offset], incr_remaining);
+                e_min = f64_summary->data[src_offset][JLS_SUMMARY_FSR_MIN];
+                e_max = f64_summary->data[src_offset][JLS_SUMMARY_FSR_MAX];
             }
-            jls_statistics_combine(&stats_accum, &stats_accum, &stats_next);
-            stats_to_f64(data, &stats_accum);
-            data += JLS_SUMMARY_FSR_COUNT;
+            if (e_min < v_min) {
+                v_min = e_min;
+            }
+            if (e_max > v_max) {
+                v_max = e_max;
+            }
+            data[0] = (float) v_min;
+            data[1] = (float) v_max;
+            data += 2;
             --data_length;
             int64_t incr = step_size - incr_remaining;
-            if (incr < 0) {
-                JLS_LOGE("internal error");
-                incr = 0;
-                jls_statistics_reset(&stats_accum);
-            } else if (incr == 0) {
-                jls_statistics_reset(&stats_accum);
+            if (incr <= 0) {
+                v_min = DBL_MAX;
+                v_max = -DBL_MAX;
             } else if (is_f32) {
-                f32_to_stats(&stats_accum, f32_summary->data[src_offset], incr);
+                // straddling entry: seed the next output with this entry
+                v_min = f32_summary->data[src_offset][JLS_SUMMARY_FSR_MIN];
+                v_max = f32_summary->data[src_offset][JLS_SUMMARY_FSR_MAX];
             } else {
-                f64_to_stats(&stats_accum, f64_summary->data[src_offset], incr);
+                v_min = f64_summary->data[src_offset][JLS_SUMMARY_FSR_MIN];
+                v_max = f64_summary->data[src_offset][JLS_SUMMARY_FSR_MAX];
             }
             incr_remaining = increment - incr;
         } else {
             if (is_f32) {
-                f32_to_stats(&stats_next, f32_summary->data[src_offset], step_size);
+                e_min = f32_summary->data[src_offset][JLS_SUMMARY_FSR_MIN];
+                e_max = f32_summary->data[src_offset][JLS_SUMMARY_FSR_MAX];
             } else {
-                f64_to_stats(&stats_next, f64_summary->data[src_offset], step_size);
+                e_min = f64_summary->data[src_offset][JLS_SUMMARY_FSR_MIN];
+                e_max = f64_summary->data[src_offset][JLS_SUMMARY_FSR_MAX];
+            }
+            if (e_min < v_min) {
+                v_min = e_min;
+            }
+            if (e_max > v_max) {
+                v_max = e_max;
             }
-            jls_statistics_combine(&stats_accum, &stats_accum, &stats_next);
             incr_remaining -= step_size;
         }
         start_sample_id += step_size;
@@ -399,9 +2606,9 @@ static int32_t fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
     return 0;
 }
 
-int32_t jls_core_fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
+int32_t jls_core_fsr_envelope(struct jls_core_s * self, uint16_t signal_id,
                               int64_t start_sample_id, int64_t increment,
-                              double * data, int64_t data_length) {
+                              float * data, int64_t data_length) {
     // API zero-based start_sample_id
     ROE(jls_core_signal_validate_typed(self, signal_id, JLS_SIGNAL_TYPE_FSR));
     if (increment <= 0) {
@@ -423,7 +2630,6 @@ int32_t jls_core_fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
         return JLS_ERROR_PARAMETER_INVALID;
     }
     struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
-    const int64_t sample_id_offset = signal_def->sample_id_offset;
 
     uint8_t level = 0;
     int64_t sample_multiple_next = signal_def->sample_decimate_factor;
@@ -433,96 +2639,787 @@ int32_t jls_core_fsr_statistics(struct jls_core_s * self, uint16_t signal_id,
         ++level;
         sample_multiple_next *= signal_def->summary_decimate_factor;
     }
-    start_sample_id += sample_id_offset; // JLS file sample_id
+    start_sample_id += signal_def->sample_id_offset; // JLS file sample_id
 
-    if (level) {  // use summaries
-        return fsr_statistics(self, signal_id, start_sample_id, increment, level, data, data_length);
+    if (level) {  // min/max straight from the summary payload
+        return fsr_envelope(self, signal_id, start_sample_id, increment, level, data, data_length);
     }  // else, use sample data
-    JLS_LOGD2("f32(signal_id=%d, start_id=%" PRIi64 ", incr=%" PRIi64 ", level=0, len=%" PRIi64 ")",
-              (int) signal_id, start_sample_id, increment, data_length);
 
-    ROE(jls_core_f64_buf_alloc((size_t) increment, &self->f64_stats_buf));
-    ROE(jls_core_f64_buf_alloc((size_t) signal_def->samples_per_data, &self->f64_sample_buf));
-    int64_t buf_offset = 0;
+    // no staging through f64_stats_buf: min/max need no second pass
+    ROE(jls_core_f64_buf_alloc(self, (size_t) signal_def->samples_per_data, &self->f64_sample_buf));
     uint8_t entry_size_bits = jls_datatype_parse_size(signal_def->data_type);
     if (entry_size_bits > 32) {
         JLS_LOGE("entry_size > 64 (float64 stats) not yet supported");
         return JLS_ERROR_UNSUPPORTED_FILE;
     }
 
-    ROE(jls_core_rd_fsr_data0(self, signal_id, start_sample_id));
-    struct jls_fsr_data_s * s = (struct jls_fsr_data_s *) self->buf->start;
-    int64_t chunk_sample_id = s->header.timestamp;
-    if (s->header.entry_size_bits != entry_size_bits) {
-        JLS_LOGE("invalid data entry size: %d", (int) s->header.entry_size_bits);
+    ROE(jls_core_rd_fsr_data0(self, signal_id, start_sample_id));
+    struct jls_fsr_data_s * s = (struct jls_fsr_data_s *) self->buf->start;
+    int64_t chunk_sample_id = s->header.timestamp;
+    if (s->header.entry_size_bits != entry_size_bits) {
+        JLS_LOGE("invalid data entry size: %d", (int) s->header.entry_size_bits);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    jls_dt_buffer_to_f64(&s->data[0], signal_def->data_type, self->f64_sample_buf->start, signal_def->samples_per_data);
+    double * src = &self->f64_sample_buf->start[0];
+    double * src_end = &self->f64_sample_buf->start[s->header.entry_count];
+    if (start_sample_id > chunk_sample_id) {
+        src += start_sample_id - chunk_sample_id;
+    }
+    double v_min = DBL_MAX;
+    double v_max = -DBL_MAX;
+    int64_t count = 0;
+    double v;
+
+    while (data_length > 0) {
+        if (src >= src_end) {
+            ROE(jls_core_rd_fsr_data0(self, signal_id, start_sample_id));
+            s = (struct jls_fsr_data_s *) self->buf->start;
+            jls_dt_buffer_to_f64(&s->data[0], signal_def->data_type, self->f64_sample_buf->start, signal_def->samples_per_data);
+            src = &self->f64_sample_buf->start[0];
+            src_end = &self->f64_sample_buf->start[s->header.entry_count];
+        }
+        v = *src++;
+        if (v < v_min) {
+            v_min = v;
+        }
+        if (v > v_max) {
+            v_max = v;
+        }
+        if (++count >= increment) {
+            data[0] = (float) v_min;
+            data[1] = (float) v_max;
+            data += 2;
+            count = 0;
+            v_min = DBL_MAX;
+            v_max = -DBL_MAX;
+            --data_length;
+        }
+        ++start_sample_id;
+    }
+    return 0;
+}
+
+JLS_API int32_t jls_rd_fsr_envelope(struct jls_rd_s * self, uint16_t signal_id,
+                                    int64_t start_sample_id, int64_t increment,
+                                    float * data, int64_t data_length) {
+    ROE(open_wait(self));
+    self->core.progress_phase = JLS_RD_PHASE_QUERY;
+    int32_t rc = jls_core_fsr_envelope(&self->core, signal_id, start_sample_id, increment, data, data_length);
+    self->core.progress_phase = JLS_RD_PHASE_IDLE;
+    return rc;
+}
+
+struct fsr_find_s {
+    struct jls_core_s * core;
+    uint16_t signal_id;
+    double value_min;
+    double value_max;
+    int64_t sample_id_offset;
+    struct jls_rd_fsr_find_range_s * ranges;
+    int64_t ranges_alloc;
+    int64_t count;
+    int64_t last_end;       // file sample id end of the last emitted range
+};
+
+// emit a matching range [a, b) in file sample ids, coalescing adjacent ranges
+static void fsr_find_emit(struct fsr_find_s * ctx, int64_t a, int64_t b) {
+    if (a == ctx->last_end) {
+        ctx->last_end = b;
+        if (ctx->count && (ctx->count <= ctx->ranges_alloc)) {
+            ctx->ranges[ctx->count - 1].end = b - ctx->sample_id_offset;
+        }
+        return;
+    }
+    ctx->last_end = b;
+    if (ctx->count < ctx->ranges_alloc) {
+        ctx->ranges[ctx->count].start = a - ctx->sample_id_offset;
+        ctx->ranges[ctx->count].end = b - ctx->sample_id_offset;
+    }
+    ++ctx->count;
+}
+
+// scan level 0 sample data over file sample ids [a, b)
+static int32_t fsr_find_level0(struct fsr_find_s * ctx, int64_t a, int64_t b) {
+    struct jls_core_s * self = ctx->core;
+    struct jls_signal_def_s * signal_def = &self->signal_info[ctx->signal_id].signal_def;
+    ROE(jls_core_f64_buf_alloc(self, (size_t) signal_def->samples_per_data, &self->f64_sample_buf));
+    int64_t match_start = INT64_MIN;
+    while (a < b) {
+        ROE(jls_core_rd_fsr_data0(self, ctx->signal_id, a));
+        struct jls_fsr_data_s * s = (struct jls_fsr_data_s *) self->buf->start;
+        int64_t chunk_sample_id = s->header.timestamp;
+        jls_dt_buffer_to_f64(&s->data[0], signal_def->data_type,
+                             self->f64_sample_buf->start, signal_def->samples_per_data);
+        int64_t idx = a - chunk_sample_id;
+        int64_t count = (int64_t) s->header.entry_count - idx;
+        if (count > (b - a)) {
+            count = b - a;
+        }
+        if (count <= 0) {
+            JLS_LOGW("find level 0: no samples at %" PRIi64, a);
+            return JLS_ERROR_NOT_FOUND;
+        }
+        double * y = &self->f64_sample_buf->start[idx];
+        for (int64_t i = 0; i < count; ++i) {
+            bool match = (y[i] >= ctx->value_min) && (y[i] <= ctx->value_max);
+            if (match && (INT64_MIN == match_start)) {
+                match_start = a + i;
+            } else if (!match && (INT64_MIN != match_start)) {
+                fsr_find_emit(ctx, match_start, a + i);
+                match_start = INT64_MIN;
+            }
+        }
+        a += count;
+    }
+    if (INT64_MIN != match_start) {
+        fsr_find_emit(ctx, match_start, b);
+    }
+    return 0;
+}
+
+static int32_t fsr_find_level_n(struct fsr_find_s * ctx, uint8_t level, int64_t a, int64_t b);
+
+// descend into file sample ids [a, b) at the next finer level
+static int32_t fsr_find_descend(struct fsr_find_s * ctx, uint8_t level, int64_t a, int64_t b) {
+    if (level <= 1) {
+        return fsr_find_level0(ctx, a, b);
+    }
+    return fsr_find_level_n(ctx, level - 1, a, b);
+}
+
+// prune file sample ids [a, b) using the level's summary min/max entries
+static int32_t fsr_find_level_n(struct fsr_find_s * ctx, uint8_t level, int64_t a, int64_t b) {
+    struct jls_core_s * self = ctx->core;
+    struct jls_signal_def_s * signal_def = &self->signal_info[ctx->signal_id].signal_def;
+    int64_t step = signal_def->sample_decimate_factor;
+    for (uint8_t lvl = 2; lvl <= level; ++lvl) {
+        step *= signal_def->summary_decimate_factor;
+    }
+
+    int64_t m_a = INT64_MIN;  // pending matching region start
+    while (a < b) {
+        ROE(jls_core_fsr_seek(self, ctx->signal_id, level, a));  // the index
+        ROE(jls_raw_chunk_next(self->raw));                      // the summary
+        ROE(rd_stats_chunk(self, ctx->signal_id, level));
+        struct jls_fsr_f32_summary_s * f32_summary = (struct jls_fsr_f32_summary_s *) self->buf->start;
+        struct jls_fsr_f64_summary_s * f64_summary = (struct jls_fsr_f64_summary_s *) self->buf->start;
+        bool is_f32;
+        if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(float) * 8) {
+            is_f32 = true;
+        } else if (f32_summary->header.entry_size_bits == JLS_SUMMARY_FSR_COUNT * sizeof(double) * 8) {
+            is_f32 = false;
+        } else {
+            JLS_LOGE("invalid summary entry size: %d", (int) f32_summary->header.entry_size_bits);
+            return JLS_ERROR_PARAMETER_INVALID;
+        }
+        int64_t chunk_timestamp = f32_summary->header.timestamp;
+        int64_t src = (a - chunk_timestamp) / step;
+        int64_t src_end = f32_summary->header.entry_count;
+        if (src >= src_end) {
+            // the level's summaries stop before b (partial tail block):
+            // delegate the remaining span to the finer level
+            int64_t region_start = (INT64_MIN != m_a) ? m_a : a;
+            return fsr_find_descend(ctx, level, region_start, b);
+        }
+        bool descended = false;
+        while ((src < src_end) && (a < b)) {
+            double e_min;
+            double e_max;
+            if (is_f32) {
+                e_min = f32_summary->data[src][JLS_SUMMARY_FSR_MIN];
+                e_max = f32_summary->data[src][JLS_SUMMARY_FSR_MAX];
+            } else {
+                e_min = f64_summary->data[src][JLS_SUMMARY_FSR_MIN];
+                e_max = f64_summary->data[src][JLS_SUMMARY_FSR_MAX];
+            }
+            int64_t e_end = chunk_timestamp + (src + 1) * step;
+            if (e_end > b) {
+                e_end = b;
+            }
+            if ((e_max >= ctx->value_min) && (e_min <= ctx->value_max)) {
+                if (INT64_MIN == m_a) {
+                    m_a = a;
+                }
+            } else if (INT64_MIN != m_a) {
+                // descending reuses the shared chunk buffer: resume with a fresh seek
+                int64_t region_start = m_a;
+                int64_t region_end = chunk_timestamp + src * step;  // this entry's start
+                m_a = INT64_MIN;
+                a = e_end;
+                ROE(fsr_find_descend(ctx, level, region_start, region_end));
+                descended = true;
+                break;
+            }
+            a = e_end;
+            ++src;
+        }
+        if (descended) {
+            continue;
+        }
+        // chunk exhausted: any pending region continues into the next chunk
+    }
+    if (INT64_MIN != m_a) {
+        ROE(fsr_find_descend(ctx, level, m_a, b));
+    }
+    return 0;
+}
+
+static int32_t fsr_find(struct jls_core_s * self, uint16_t signal_id,
+                        int64_t start_sample_id, int64_t end_sample_id,
+                        double value_min, double value_max,
+                        struct jls_rd_fsr_find_range_s * ranges, int64_t ranges_alloc,
+                        int64_t * ranges_count) {
+    ROE(jls_core_signal_validate_typed(self, signal_id, JLS_SIGNAL_TYPE_FSR));
+    if ((NULL == ranges_count) || ((ranges_alloc > 0) && (NULL == ranges))) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    *ranges_count = 0;
+    if (value_min > value_max) {
+        JLS_LOGW("invalid value range: %g > %g", value_min, value_max);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    int64_t samples = 0;
+    ROE(jls_core_fsr_length(self, signal_id, &samples));
+    if ((start_sample_id < 0) || (end_sample_id > samples)) {
+        JLS_LOGW("invalid range: [%" PRIi64 ", %" PRIi64 ") length=%" PRIi64,
+                 start_sample_id, end_sample_id, samples);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (start_sample_id >= end_sample_id) {
+        return 0;
+    }
+    struct jls_signal_def_s * signal_def = &self->signal_info[signal_id].signal_def;
+    struct fsr_find_s ctx = {
+            .core = self,
+            .signal_id = signal_id,
+            .value_min = value_min,
+            .value_max = value_max,
+            .sample_id_offset = signal_def->sample_id_offset,
+            .ranges = ranges,
+            .ranges_alloc = ranges_alloc,
+            .count = 0,
+            .last_end = INT64_MIN,
+    };
+    int64_t a = start_sample_id + ctx.sample_id_offset;
+    int64_t b = end_sample_id + ctx.sample_id_offset;
+
+    // start at the coarsest stored summary level
+    int64_t * head_offsets = self->signal_info[signal_id].tracks[JLS_TRACK_TYPE_FSR].head_offsets;
+    uint8_t level = JLS_SUMMARY_LEVEL_COUNT - 1;
+    while (level && !head_offsets[level]) {
+        --level;
+    }
+    if (0 == level) {
+        ROE(fsr_find_level0(&ctx, a, b));
+    } else {
+        ROE(fsr_find_level_n(&ctx, level, a, b));
+    }
+    *ranges_count = ctx.count;
+    return 0;
+}
+
+JLS_API int32_t jls_rd_fsr_find(struct jls_rd_s * self, uint16_t signal_id,
+                                int64_t start_sample_id, int64_t end_sample_id,
+                                double value_min, double value_max,
+                                struct jls_rd_fsr_find_range_s * ranges, int64_t ranges_alloc,
+                                int64_t * ranges_count) {
+    ROE(open_wait(self));
+    self->core.progress_phase = JLS_RD_PHASE_QUERY;
+    int32_t rc = fsr_find(&self->core, signal_id, start_sample_id, end_sample_id,
+                          value_min, value_max, ranges, ranges_alloc, ranges_count);
+    self->core.progress_phase = JLS_RD_PHASE_IDLE;
+    return rc;
+}
+
+JLS_API int32_t jls_rd_extract(struct jls_rd_s * self, const char * path,
+                               const uint16_t * signal_ids, uint16_t signal_count,
+                               int64_t start_sample_id, int64_t end_sample_id) {
+    ROE(open_wait(self));
+    if (!self || !path || (start_sample_id < 0) || (end_sample_id <= start_sample_id)
+            || (signal_count && !signal_ids)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    int32_t rc = 0;
+    uint8_t * buf = NULL;
+    struct jls_wr_s * wr = NULL;
+    ROE(jls_wr_open(&wr, path));
+
+    struct jls_source_def_s * sources = NULL;
+    uint16_t source_count = 0;
+    GOE(jls_rd_sources(self, &sources, &source_count));
+    for (uint16_t i = 0; i < source_count; ++i) {
+        if (0 == sources[i].source_id) {
+            continue;  // defined automatically on open
+        }
+        GOE(jls_wr_source_def(wr, &sources[i]));
+    }
+
+    struct jls_signal_def_s * signals = NULL;
+    uint16_t count = 0;
+    GOE(jls_rd_signals(self, &signals, &count));
+    for (uint16_t i = 0; i < count; ++i) {
+        struct jls_signal_def_s def = signals[i];
+        uint16_t signal_id = def.signal_id;
+        if ((0 == signal_id) || (JLS_SIGNAL_TYPE_FSR != def.signal_type)) {
+            continue;
+        }
+        if (signal_count) {
+            bool selected = false;
+            for (uint16_t k = 0; k < signal_count; ++k) {
+                if (signal_ids[k] == signal_id) {
+                    selected = true;
+                    break;
+                }
+            }
+            if (!selected) {
+                continue;
+            }
+        }
+        GOE(jls_wr_signal_def(wr, &def));
+
+        int64_t length = 0;
+        GOE(jls_rd_fsr_length(self, signal_id, &length));
+        int64_t s0 = start_sample_id;
+        int64_t s1 = (end_sample_id < length) ? end_sample_id : length;
+        if (s0 >= s1) {
+            continue;
+        }
+
+        // reuse the existing level 1 summaries when the window aligns
+        uint32_t sdf = def.sample_decimate_factor;
+        if (sdf && (0 == (s0 % sdf))) {
+            int64_t entries = (s1 - s0) / sdf;
+            if ((entries > 0) && (entries <= UINT32_MAX)) {
+                double * stats = malloc((size_t) entries * JLS_SUMMARY_FSR_COUNT * sizeof(double));
+                if (stats) {
+                    if (0 == jls_rd_fsr_statistics(self, signal_id, s0, sdf, stats, entries)) {
+                        // on failure, the writer computes from samples
+                        jls_wr_fsr_summary_inject(wr, signal_id, stats, (uint32_t) entries);
+                    }
+                    free(stats);
+                }
+            }
+        }
+
+        uint8_t sample_size_bits = jls_datatype_parse_size(def.data_type);
+        uint32_t samples_per_data = def.samples_per_data;
+        buf = malloc(((size_t) samples_per_data * sample_size_bits + 7) / 8);
+        if (!buf) {
+            GOE(JLS_ERROR_NOT_ENOUGH_MEMORY);
+        }
+        int64_t sample_id_offset = def.sample_id_offset;  // keep absolute sample ids
+        for (int64_t k = s0; k < s1; ) {
+            int64_t n = s1 - k;
+            if (n > samples_per_data) {
+                n = samples_per_data;
+            }
+            GOE(jls_rd_fsr(self, signal_id, k, buf, n));
+            GOE(jls_wr_fsr(wr, signal_id, sample_id_offset + k, buf, (uint32_t) n));
+            k += n;
+        }
+        free(buf);
+        buf = NULL;
+    }
+
+exit:
+    free(buf);
+    int32_t rc_close = jls_wr_close(wr);
+    return rc ? rc : rc_close;
+}
+
+// minimum samples per worker: below this, the serial segment-tree
+// decomposition already completes quickly and threads just add overhead
+#define STATISTICS_SPLIT_MIN (1 << 22)
+
+struct rd_stats_worker_s {
+    struct jls_rd_s * rd;
+    uint16_t signal_id;
+    int64_t start_sample_id;
+    int64_t increment;
+    double data[JLS_SUMMARY_FSR_COUNT];
+    int32_t return_code;
+};
+
+static void rd_stats_worker(void * user_data) {
+    struct rd_stats_worker_s * w = (struct rd_stats_worker_s *) user_data;
+    w->return_code = jls_core_fsr_statistics(&w->rd->core, w->signal_id,
+                                             w->start_sample_id, w->increment, w->data, 1);
+}
+
+// single-interval reduction: each worker covers a contiguous sample span,
+// partial results merge in order with jls_statistics_combine()
+static int32_t fsr_statistics_parallel(struct jls_rd_s * self, uint16_t signal_id,
+                                       int64_t start_sample_id, int64_t increment, double * data) {
+    uint32_t workers = (uint32_t) (increment / STATISTICS_SPLIT_MIN);
+    if (workers > JLS_RD_FSR_BATCH_WORKERS_MAX) {
+        workers = JLS_RD_FSR_BATCH_WORKERS_MAX;
+    }
+
+    // lazily fork one reader per additional worker, worker 0 uses self
+    if (workers >= 2) {
+        workers = batch_workers_fork(self, workers);
+    }
+    if (workers < 2) {
+        return jls_core_fsr_statistics(&self->core, signal_id, start_sample_id, increment, data, 1);
+    }
+
+    struct rd_stats_worker_s w[JLS_RD_FSR_BATCH_WORKERS_MAX];
+    struct jls_bk_thread_s * threads[JLS_RD_FSR_BATCH_WORKERS_MAX];
+    int64_t span = increment / workers;
+    for (uint32_t k = 0; k < workers; ++k) {
+        w[k].rd = k ? self->batch_rd[k] : self;
+        w[k].signal_id = signal_id;
+        w[k].start_sample_id = start_sample_id + k * span;
+        w[k].increment = (k == (workers - 1)) ? (increment - k * span) : span;
+        w[k].return_code = 0;
+        threads[k] = NULL;
+    }
+    for (uint32_t k = 1; k < workers; ++k) {
+        if (jls_bk_thread_run(&threads[k], rd_stats_worker, &w[k])) {
+            threads[k] = NULL;  // run this worker's span on the calling thread
+        }
+    }
+    rd_stats_worker(&w[0]);
+
+    int32_t rc = 0;
+    for (uint32_t k = 1; k < workers; ++k) {
+        if (threads[k]) {
+            jls_bk_thread_join(threads[k]);
+        } else {
+            rd_stats_worker(&w[k]);
+        }
+    }
+
+    struct jls_statistics_s accum;
+    struct jls_statistics_s part;
+    jls_statistics_reset(&accum);
+    for (uint32_t k = 0; k < workers; ++k) {
+        if (w[k].return_code) {
+            if (!rc) {
+                rc = w[k].return_code;
+            }
+            continue;
+        }
+        f64_to_stats(&part, w[k].data, w[k].increment);
+        jls_statistics_combine(&accum, &accum, &part);
+    }
+    if (rc) {
+        return rc;
+    }
+    stats_to_f64(data, &accum);
+    return 0;
+}
+
+JLS_API int32_t jls_rd_fsr_statistics(struct jls_rd_s * self, uint16_t signal_id,
+                                      int64_t start_sample_id, int64_t increment,
+                                      double * data, int64_t data_length) {
+    ROE(open_wait(self));
+    int32_t rc;
+    uint64_t bytes = 0;
+    uint64_t seeks = 0;
+    query_counters(self, &bytes, &seeks);
+    if (self->msegs) {
+        rc = multi_fsr_statistics(self, signal_id, start_sample_id, increment, data, data_length);
+        query_profile_end(self, bytes, seeks,
+                          rc ? 0 : ((uint64_t) data_length) * JLS_SUMMARY_FSR_COUNT * sizeof(double));
+        return rc;
+    }
+    if (self->stat_cache
+            && (0 == jls_stat_cache_get(self->stat_cache, signal_id,
+                                        start_sample_id, increment, data, data_length))) {
+        query_profile_end(self, bytes, seeks,
+                          ((uint64_t) data_length) * JLS_SUMMARY_FSR_COUNT * sizeof(double));
+        return 0;
+    }
+    self->core.progress_phase = JLS_RD_PHASE_QUERY;
+    if ((1 == data_length) && (increment >= (2 * STATISTICS_SPLIT_MIN))
+            && (start_sample_id >= 0)) {
+        rc = fsr_statistics_parallel(self, signal_id, start_sample_id, increment, data);
+    } else {
+        rc = jls_core_fsr_statistics(&self->core, signal_id, start_sample_id, increment, data, data_length);
+    }
+    self->core.progress_phase = JLS_RD_PHASE_IDLE;
+    if ((0 == rc) && self->stat_cache) {
+        jls_stat_cache_put(self->stat_cache, signal_id, start_sample_id,
+                           increment, data, data_length);  // best effort
+    }
+    query_profile_end(self, bytes, seeks,
+                      rc ? 0 : ((uint64_t) data_length) * JLS_SUMMARY_FSR_COUNT * sizeof(double));
+    return rc;
+}
+
+JLS_API int32_t jls_rd_fsr_summary_preview(struct jls_rd_s * self, uint16_t signal_id, uint8_t level,
+                                           int64_t * sample_id, double * data, int64_t * entries) {
+    ROE(open_wait(self));
+    if ((NULL == sample_id) || (NULL == data) || (NULL == entries) || (*entries <= 0)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if ((level < 1) || (level >= JLS_SUMMARY_LEVEL_COUNT)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (self->msegs) {
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    ROE(jls_core_signal_validate_typed(&self->core, signal_id, JLS_SIGNAL_TYPE_FSR));
+    struct jls_core_signal_s * info = &self->core.signal_info[signal_id];
+    struct jls_fsr_f32_summary_s * p = info->preview[level];
+    if (NULL == p) {
+        *entries = 0;
+        return JLS_ERROR_NOT_FOUND;
+    }
+    int64_t n = p->header.entry_count;
+    if (n > *entries) {
+        n = *entries;
+    }
+    if (p->header.entry_size_bits == (JLS_SUMMARY_FSR_COUNT * sizeof(double) * 8)) {
+        memcpy(data, ((struct jls_fsr_f64_summary_s *) p)->data[0],
+               (size_t) n * JLS_SUMMARY_FSR_COUNT * sizeof(double));
+    } else {
+        const float * src = p->data[0];
+        for (int64_t i = 0; i < n * JLS_SUMMARY_FSR_COUNT; ++i) {
+            data[i] = src[i];
+        }
+    }
+    *entries = n;
+    *sample_id = p->header.timestamp - info->signal_def.sample_id_offset;
+    return 0;
+}
+
+// entries per signal per block for jls_rd_fsr_statistics_multi:
+// small enough to keep every signal's source chunks cached between
+// signals, large enough to amortize the per-query setup
+#define STATISTICS_MULTI_BLOCK (256)
+
+JLS_API int32_t jls_rd_fsr_statistics_multi(struct jls_rd_s * self,
+                                            const uint16_t * signal_ids, uint16_t signal_count,
+                                            int64_t start_sample_id, int64_t increment,
+                                            double * data, int64_t data_length) {
+    ROE(open_wait(self));
+    if ((NULL == self) || (NULL == signal_ids) || (0 == signal_count)
+            || (NULL == data) || (data_length <= 0) || (increment <= 0)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    double block[STATISTICS_MULTI_BLOCK * JLS_SUMMARY_FSR_COUNT];
+    for (int64_t entry = 0; entry < data_length; ) {
+        int64_t n = data_length - entry;
+        if (n > STATISTICS_MULTI_BLOCK) {
+            n = STATISTICS_MULTI_BLOCK;
+        }
+        int64_t s0 = start_sample_id + entry * increment;
+        for (uint16_t k = 0; k < signal_count; ++k) {
+            ROE(jls_rd_fsr_statistics(self, signal_ids[k], s0, increment, block, n));
+            // scatter into the entry-major aligned layout
+            for (int64_t i = 0; i < n; ++i) {
+                memcpy(&data[((entry + i) * signal_count + k) * JLS_SUMMARY_FSR_COUNT],
+                       &block[i * JLS_SUMMARY_FSR_COUNT],
+                       JLS_SUMMARY_FSR_COUNT * sizeof(double));
+            }
+        }
+        entry += n;
+    }
+    return 0;
+}
+
+JLS_API int32_t jls_rd_fsr_statistics_resample(struct jls_rd_s * self, uint16_t signal_id,
+                                               int64_t start_sample_id, int64_t end_sample_id,
+                                               double * data, int64_t data_length) {
+    ROE(open_wait(self));
+    int32_t rc = 0;
+    struct jls_core_s * core = &self->core;
+    if ((data_length <= 0) || (start_sample_id < 0) || (end_sample_id <= start_sample_id)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    const int64_t span = end_sample_id - start_sample_id;
+    if (span < data_length) {
+        JLS_LOGW("resample: span %" PRIi64 " < entries %" PRIi64, span, data_length);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (self->msegs) {
+        // multi-file: one exact query per output entry
+        for (int64_t k = 0; k < data_length; ++k) {
+            int64_t s0 = start_sample_id + (k * span) / data_length;
+            int64_t s1 = start_sample_id + ((k + 1) * span) / data_length;
+            ROE(jls_rd_fsr_statistics(self, signal_id, s0, s1 - s0,
+                                      &data[k * JLS_SUMMARY_FSR_COUNT], 1));
+        }
+        return 0;
+    }
+    ROE(jls_core_signal_validate_typed(core, signal_id, JLS_SIGNAL_TYPE_FSR));
+    int64_t samples = 0;
+    ROE(jls_core_fsr_length(core, signal_id, &samples));
+    if (end_sample_id > samples) {
+        JLS_LOGW("resample: end %" PRIi64 " > %" PRIi64, end_sample_id, samples);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_signal_def_s * signal_def = &core->signal_info[signal_id].signal_def;
+    int64_t * head_offsets = core->signal_info[signal_id].tracks[JLS_TRACK_TYPE_FSR].head_offsets;
+
+    core->progress_phase = JLS_RD_PHASE_QUERY;
+    if (((span / data_length) < (int64_t) signal_def->sample_decimate_factor)
+            || !head_offsets[1]) {
+        // output entries finer than the level-1 summaries (or no summaries
+        // stored): one exact query per output entry
+        for (int64_t k = 0; (0 == rc) && (k < data_length); ++k) {
+            int64_t s0 = start_sample_id + (k * span) / data_length;
+            int64_t s1 = start_sample_id + ((k + 1) * span) / data_length;
+            rc = jls_core_fsr_statistics(core, signal_id, s0, s1 - s0,
+                                         &data[k * JLS_SUMMARY_FSR_COUNT], 1);
+        }
+    } else {
+        rc = fsr_statistics_resample(core, signal_id,
+                                     start_sample_id + signal_def->sample_id_offset,
+                                     end_sample_id + signal_def->sample_id_offset,
+                                     data, data_length);
+    }
+    core->progress_phase = JLS_RD_PHASE_IDLE;
+    return rc;
+}
+
+// cached partials per window, bounds both the cache memory and the
+// per-query combine cost
+#define STATS_CURSOR_BLOCKS (256)
+
+struct jls_rd_fsr_stats_cursor_s {
+    struct jls_core_s * core;
+    uint16_t signal_id;
+    int64_t window_length;      // window that selected the current block size
+    int64_t block_size;         // samples per cached partial
+    int64_t block_first;        // absolute block index of blocks[0]
+    uint32_t block_count;       // entries in blocks, cached or hole
+    uint32_t block_alloc;
+    struct jls_statistics_s * blocks;   // k == 0 marks a hole
+};
+
+JLS_API int32_t jls_rd_fsr_statistics_cursor_open(struct jls_rd_s * self, uint16_t signal_id,
+                                                  struct jls_rd_fsr_stats_cursor_s ** cursor) {
+    ROE(open_wait(self));
+    if (!self || !cursor) {
         return JLS_ERROR_PARAMETER_INVALID;
     }
-    jls_dt_buffer_to_f64(&s->data[0], signal_def->data_type, self->f64_sample_buf->start, signal_def->samples_per_data);
-    double * src = &self->f64_sample_buf->start[0];
-    double * src_end = &self->f64_sample_buf->start[s->header.entry_count];
-    if (start_sample_id > chunk_sample_id) {
-        src += start_sample_id - chunk_sample_id;
+    *cursor = NULL;
+    ROE(jls_core_signal_validate_typed(&self->core, signal_id, JLS_SIGNAL_TYPE_FSR));
+    struct jls_rd_fsr_stats_cursor_s * c = calloc(1, sizeof(struct jls_rd_fsr_stats_cursor_s));
+    if (!c) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
     }
-    double v_mean = 0.0;
-    double v_min = DBL_MAX;
-    double v_max = -DBL_MAX;
-    double v_var = 0.0;
-    double mean_scale = 1.0 / increment;
-    double var_scale = 1.0;
-    if (increment > 1) {
-        var_scale = 1.0 / (increment - 1.0);
+    c->core = &self->core;
+    c->signal_id = signal_id;
+    *cursor = c;
+    return 0;
+}
+
+static int32_t fsr_stats_cursor_query(struct jls_rd_fsr_stats_cursor_s * self,
+                                      int64_t start_sample_id, int64_t window_length,
+                                      double * data) {
+    struct jls_core_s * core = self->core;
+    if ((start_sample_id < 0) || (window_length < 1)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    int64_t samples = 0;
+    ROE(jls_core_fsr_length(core, self->signal_id, &samples));
+    if ((start_sample_id + window_length) > samples) {
+        return JLS_ERROR_PARAMETER_INVALID;
     }
-    double v;
 
-    while (data_length > 0) {
-        if (src >= src_end) {
-            ROE(jls_core_rd_fsr_data0(self, signal_id, start_sample_id));
-            s = (struct jls_fsr_data_s *) self->buf->start;
-            chunk_sample_id = s->header.timestamp;
-            jls_dt_buffer_to_f64(&s->data[0], signal_def->data_type, self->f64_sample_buf->start, signal_def->samples_per_data);
-            src = &self->f64_sample_buf->start[0];
-            src_end = &self->f64_sample_buf->start[s->header.entry_count];
-        }
-        v = *src++;
-        v_mean += v;
-        if (v < v_min) {
-            v_min = v;
-        }
-        if (v > v_max) {
-            v_max = v;
-        }
-        self->f64_stats_buf->start[buf_offset++] = v;
+    if (window_length != self->window_length) {
+        // block boundaries align to absolute multiples of the block size,
+        // so a sliding window keeps hitting the cached partials
+        struct jls_signal_def_s * signal_def = &core->signal_info[self->signal_id].signal_def;
+        int64_t chunk = signal_def->samples_per_data;
+        int64_t block = (window_length + STATS_CURSOR_BLOCKS - 1) / STATS_CURSOR_BLOCKS;
+        block = ((block + chunk - 1) / chunk) * chunk;
+        self->block_size = block;
+        self->window_length = window_length;
+        self->block_count = 0;
+    }
 
-        if (buf_offset >= increment) {
-            v_mean *= mean_scale;
-            v_var = 0.0;
-            for (int64_t i = 0; i < increment; ++i) {
-                double v_diff = self->f64_stats_buf->start[i] - v_mean;
-                v_var += v_diff * v_diff;
-            }
-            v_var *= var_scale;
+    const int64_t block_size = self->block_size;
+    const int64_t end_sample_id = start_sample_id + window_length;
+    int64_t first = (start_sample_id + block_size - 1) / block_size;  // first fully covered
+    int64_t last = end_sample_id / block_size;                        // exclusive
+    if (first >= last) {  // window spans at most two blocks, nothing cacheable
+        return jls_core_fsr_statistics(core, self->signal_id, start_sample_id,
+                                       window_length, data, 1);
+    }
 
-            data[JLS_SUMMARY_FSR_MEAN] = v_mean;
-            data[JLS_SUMMARY_FSR_MIN] = v_min;
-            data[JLS_SUMMARY_FSR_MAX] = v_max;
-            data[JLS_SUMMARY_FSR_STD] = sqrt(v_var);
-            data += JLS_SUMMARY_FSR_COUNT;
+    uint32_t count = (uint32_t) (last - first);
+    if (count > self->block_alloc) {
+        struct jls_statistics_s * b = realloc(self->blocks, count * sizeof(*b));
+        if (!b) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        self->blocks = b;
+        self->block_alloc = count;
+    }
 
-            buf_offset = 0;
-            v_mean = 0.0;
-            v_min = DBL_MAX;
-            v_max = -DBL_MAX;
-            --data_length;
+    // align blocks[0] with first: drop departed leading partials on a
+    // forward slide, recompute from scratch on a backward jump
+    if (self->block_count) {
+        int64_t shift = first - self->block_first;
+        if ((shift < 0) || (shift >= (int64_t) self->block_count)) {
+            self->block_count = 0;
+        } else if (shift > 0) {
+            self->block_count -= (uint32_t) shift;
+            memmove(self->blocks, self->blocks + shift,
+                    self->block_count * sizeof(*self->blocks));
         }
-        ++start_sample_id;
     }
+    self->block_first = first;
+    if (self->block_count > count) {
+        self->block_count = count;
+    }
+    for (uint32_t i = self->block_count; i < count; ++i) {
+        self->blocks[i].k = 0;  // newly entered, not yet read
+    }
+    self->block_count = count;
+
+    double f64_tmp[JLS_SUMMARY_FSR_COUNT];
+    struct jls_statistics_s accum;
+    struct jls_statistics_s part;
+    jls_statistics_reset(&accum);
+
+    int64_t edge = first * block_size - start_sample_id;
+    if (edge > 0) {
+        ROE(jls_core_fsr_statistics(core, self->signal_id, start_sample_id, edge, f64_tmp, 1));
+        f64_to_stats(&part, f64_tmp, edge);
+        jls_statistics_combine(&accum, &accum, &part);
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        if (0 == self->blocks[i].k) {
+            ROE(jls_core_fsr_statistics(core, self->signal_id, (first + i) * block_size,
+                                        block_size, f64_tmp, 1));
+            f64_to_stats(&self->blocks[i], f64_tmp, block_size);
+        }
+        jls_statistics_combine(&accum, &accum, &self->blocks[i]);
+    }
+    edge = end_sample_id - last * block_size;
+    if (edge > 0) {
+        ROE(jls_core_fsr_statistics(core, self->signal_id, last * block_size, edge, f64_tmp, 1));
+        f64_to_stats(&part, f64_tmp, edge);
+        jls_statistics_combine(&accum, &accum, &part);
+    }
+    stats_to_f64(data, &accum);
     return 0;
 }
 
-JLS_API int32_t jls_rd_fsr_statistics(struct jls_rd_s * self, uint16_t signal_id,
-                                      int64_t start_sample_id, int64_t increment,
-                                      double * data, int64_t data_length) {
-    return jls_core_fsr_statistics(&self->core, signal_id, start_sample_id, increment, data, data_length);
+JLS_API int32_t jls_rd_fsr_statistics_cursor_query(struct jls_rd_fsr_stats_cursor_s * self,
+                                                   int64_t start_sample_id, int64_t window_length,
+                                                   double * data) {
+    if (!self || !data) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    self->core->progress_phase = JLS_RD_PHASE_QUERY;
+    int32_t rc = fsr_stats_cursor_query(self, start_sample_id, window_length, data);
+    self->core->progress_phase = JLS_RD_PHASE_IDLE;
+    return rc;
+}
+
+JLS_API void jls_rd_fsr_statistics_cursor_close(struct jls_rd_fsr_stats_cursor_s * self) {
+    if (self) {
+        free(self->blocks);
+        free(self);
+    }
 }
 
 int32_t jls_core_annotations(struct jls_core_s * self, uint16_t signal_id, int64_t timestamp,
@@ -551,10 +3448,19 @@ int32_t jls_core_annotations(struct jls_core_s * self, uint16_t signal_id, int64
         if (self->chunk_cur.hdr.tag != JLS_TAG_TRACK_ANNOTATION_DATA) {
             return JLS_ERROR_NOT_FOUND;
         }
-        annotation = (struct jls_annotation_s *) self->buf->start;
-        annotation->timestamp -= sample_id_offset;
-        if (cbk_fn(cbk_user_data, annotation)) {
-            return 0;
+        uint8_t * p = self->buf->start;
+        uint8_t * p_end = p + self->buf->length;
+        uint32_t entry_count = ((struct jls_payload_header_s *) p)->entry_count;
+        if (0 == entry_count) {
+            entry_count = 1;  // pre-coalescing writers left the count unreliable
+        }
+        for (uint32_t k = 0; (k < entry_count) && (p < p_end); ++k) {
+            annotation = (struct jls_annotation_s *) p;
+            annotation->timestamp -= sample_id_offset;
+            if (cbk_fn(cbk_user_data, annotation)) {
+                return 0;
+            }
+            p += JLS_ANNOTATION_RECORD_SIZE(annotation->data_size);
         }
         pos = self->chunk_cur.hdr.item_next;
     }
@@ -563,9 +3469,255 @@ int32_t jls_core_annotations(struct jls_core_s * self, uint16_t signal_id, int64
 
 JLS_API int32_t jls_rd_annotations(struct jls_rd_s * self, uint16_t signal_id, int64_t timestamp,
                                    jls_rd_annotation_cbk_fn cbk_fn, void * cbk_user_data) {
+    ROE(open_wait(self));
     return jls_core_annotations(&self->core, signal_id, timestamp, cbk_fn, cbk_user_data);
 }
 
+// 64-bit Bloom filter over the 3-byte windows of an annotation payload.
+// Each window sets two bits.  A payload can contain a query only if the
+// payload filter has every bit that the query filter has, so a failed
+// superset test skips the record without touching its bytes.
+static uint64_t anno_digest(const uint8_t * data, uint32_t data_size) {
+    uint64_t digest = 0;
+    for (uint32_t k = 0; (k + 3) <= data_size; ++k) {
+        uint32_t h = 2166136261u;               // FNV-1a
+        h = (h ^ data[k]) * 16777619u;
+        h = (h ^ data[k + 1]) * 16777619u;
+        h = (h ^ data[k + 2]) * 16777619u;
+        digest |= ((uint64_t) 1) << (h & 0x3f);
+        digest |= ((uint64_t) 1) << ((h >> 6) & 0x3f);
+    }
+    return digest;
+}
+
+static bool anno_contains(const uint8_t * hay, uint32_t hay_size,
+                          const uint8_t * needle, uint32_t needle_size) {
+    if (0 == needle_size) {
+        return true;
+    }
+    if (needle_size > hay_size) {
+        return false;
+    }
+    for (uint32_t k = 0; (k + needle_size) <= hay_size; ++k) {
+        if ((hay[k] == needle[0]) && (0 == memcmp(hay + k, needle, needle_size))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static int32_t anno_index_load(struct jls_core_s * self, uint16_t signal_id) {
+    struct jls_core_signal_s * info = &self->signal_info[signal_id];
+    if (NULL != info->anno_index) {
+        return 0;
+    }
+    int64_t alloc = 1024;
+    struct jls_core_anno_index_s * idx = malloc(
+            sizeof(*idx) + alloc * sizeof(struct jls_core_anno_index_entry_s));
+    if (NULL == idx) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    idx->count = 0;
+
+    int32_t rv = jls_core_ts_seek(self, signal_id, 0, JLS_TRACK_TYPE_ANNOTATION, INT64_MIN);
+    if (rv == JLS_ERROR_NOT_FOUND) {
+        info->anno_index = idx;  // no annotations: keep the empty index
+        return 0;
+    } else if (rv) {
+        free(idx);
+        return rv;
+    }
+
+    int64_t pos = jls_raw_chunk_tell(self->raw);
+    while (pos) {
+        rv = jls_raw_chunk_seek(self->raw, pos);
+        if (!rv) {
+            rv = jls_core_rd_chunk(self);
+        }
+        if (!rv && (self->chunk_cur.hdr.tag != JLS_TAG_TRACK_ANNOTATION_DATA)) {
+            rv = JLS_ERROR_NOT_FOUND;
+        }
+        if (rv) {
+            free(idx);
+            return rv;
+        }
+        uint8_t * p = self->buf->start;
+        uint8_t * p_end = p + self->buf->length;
+        uint32_t entry_count = ((struct jls_payload_header_s *) p)->entry_count;
+        if (0 == entry_count) {
+            entry_count = 1;  // pre-coalescing writers left the count unreliable
+        }
+        for (uint32_t k = 0; (k < entry_count) && (p < p_end); ++k) {
+            if (idx->count >= alloc) {
+                alloc *= 2;
+                struct jls_core_anno_index_s * idx_new = realloc(idx,
+                        sizeof(*idx) + alloc * sizeof(struct jls_core_anno_index_entry_s));
+                if (NULL == idx_new) {
+                    free(idx);
+                    return JLS_ERROR_NOT_ENOUGH_MEMORY;
+                }
+                idx = idx_new;
+            }
+            struct jls_annotation_s * annotation = (struct jls_annotation_s *) p;
+            idx->entries[idx->count].timestamp = annotation->timestamp;  // raw, includes sample_id_offset
+            idx->entries[idx->count].offset = pos;
+            idx->entries[idx->count].digest = anno_digest(annotation->data, annotation->data_size);
+            ++idx->count;
+            p += JLS_ANNOTATION_RECORD_SIZE(annotation->data_size);
+        }
+        pos = self->chunk_cur.hdr.item_next;
+    }
+    info->anno_index = idx;
+    return 0;
+}
+
+// the first entry index with timestamp >= the requested timestamp
+static int64_t anno_index_lower_bound(const struct jls_core_anno_index_s * idx, int64_t timestamp) {
+    int64_t lo = 0;
+    int64_t hi = idx->count;
+    while (lo < hi) {
+        int64_t mid = lo + (hi - lo) / 2;
+        if (idx->entries[mid].timestamp < timestamp) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+JLS_API int32_t jls_rd_annotations_range(struct jls_rd_s * self, uint16_t signal_id,
+                                         int64_t start_timestamp, int64_t end_timestamp,
+                                         jls_rd_annotation_cbk_fn cbk_fn, void * cbk_user_data) {
+    ROE(open_wait(self));
+    if (!self || !cbk_fn) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_core_s * core = &self->core;
+    ROE(jls_core_signal_validate(core, signal_id));
+    ROE(anno_index_load(core, signal_id));
+    struct jls_core_signal_s * info = &core->signal_info[signal_id];
+    const int64_t sample_id_offset = info->signal_def.sample_id_offset;
+    struct jls_core_anno_index_s * idx = info->anno_index;
+    const int64_t t_start = start_timestamp + sample_id_offset;
+    const int64_t t_end = end_timestamp + sample_id_offset;
+    int64_t k = anno_index_lower_bound(idx, t_start);
+    while ((k < idx->count) && (idx->entries[k].timestamp < t_end)) {
+        // coalesced chunks share one offset across consecutive index entries:
+        // read the chunk once and filter its records by timestamp
+        const int64_t chunk_offset = idx->entries[k].offset;
+        ROE(jls_raw_chunk_seek(core->raw, chunk_offset));
+        ROE(jls_core_rd_chunk(core));
+        if (core->chunk_cur.hdr.tag != JLS_TAG_TRACK_ANNOTATION_DATA) {
+            return JLS_ERROR_NOT_FOUND;
+        }
+        uint8_t * p = core->buf->start;
+        uint8_t * p_end = p + core->buf->length;
+        uint32_t entry_count = ((struct jls_payload_header_s *) p)->entry_count;
+        if (0 == entry_count) {
+            entry_count = 1;  // pre-coalescing writers left the count unreliable
+        }
+        for (uint32_t n = 0; (n < entry_count) && (p < p_end); ++n) {
+            struct jls_annotation_s * annotation = (struct jls_annotation_s *) p;
+            p += JLS_ANNOTATION_RECORD_SIZE(annotation->data_size);
+            if ((annotation->timestamp < t_start) || (annotation->timestamp >= t_end)) {
+                continue;
+            }
+            annotation->timestamp -= sample_id_offset;
+            if (cbk_fn(cbk_user_data, annotation)) {
+                return 0;
+            }
+        }
+        while ((k < idx->count) && (idx->entries[k].offset == chunk_offset)) {
+            ++k;
+        }
+    }
+    return 0;
+}
+
+JLS_API int32_t jls_rd_annotations_count(struct jls_rd_s * self, uint16_t signal_id,
+                                         int64_t start_timestamp, int64_t end_timestamp,
+                                         int64_t * count) {
+    ROE(open_wait(self));
+    if (!self || !count) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    *count = 0;
+    struct jls_core_s * core = &self->core;
+    ROE(jls_core_signal_validate(core, signal_id));
+    ROE(anno_index_load(core, signal_id));
+    struct jls_core_signal_s * info = &core->signal_info[signal_id];
+    const int64_t sample_id_offset = info->signal_def.sample_id_offset;
+    struct jls_core_anno_index_s * idx = info->anno_index;
+    int64_t k0 = anno_index_lower_bound(idx, start_timestamp + sample_id_offset);
+    int64_t k1 = anno_index_lower_bound(idx, end_timestamp + sample_id_offset);
+    *count = k1 - k0;
+    return 0;
+}
+
+JLS_API int32_t jls_rd_annotations_find(struct jls_rd_s * self, uint16_t signal_id,
+                                        int64_t start_timestamp, int64_t end_timestamp,
+                                        const uint8_t * data, uint32_t data_size,
+                                        jls_rd_annotation_cbk_fn cbk_fn, void * cbk_user_data) {
+    ROE(open_wait(self));
+    if (!self || !cbk_fn || (!data && data_size)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_core_s * core = &self->core;
+    ROE(jls_core_signal_validate(core, signal_id));
+    ROE(anno_index_load(core, signal_id));
+    struct jls_core_signal_s * info = &core->signal_info[signal_id];
+    const int64_t sample_id_offset = info->signal_def.sample_id_offset;
+    struct jls_core_anno_index_s * idx = info->anno_index;
+    const int64_t t_start = start_timestamp + sample_id_offset;
+    const int64_t t_end = end_timestamp + sample_id_offset;
+    // queries shorter than one digest window cannot be filtered: 0 is a subset of everything
+    const uint64_t query_digest = (data_size >= 3) ? anno_digest(data, data_size) : 0;
+    int64_t k = anno_index_lower_bound(idx, t_start);
+    while ((k < idx->count) && (idx->entries[k].timestamp < t_end)) {
+        const int64_t chunk_offset = idx->entries[k].offset;
+        bool candidate = false;
+        int64_t k_next = k;
+        while ((k_next < idx->count) && (idx->entries[k_next].offset == chunk_offset)) {
+            if ((idx->entries[k_next].timestamp < t_end)
+                    && (query_digest == (idx->entries[k_next].digest & query_digest))) {
+                candidate = true;
+            }
+            ++k_next;
+        }
+        k = k_next;
+        if (!candidate) {
+            continue;  // no record in the chunk can contain the query
+        }
+        ROE(jls_raw_chunk_seek(core->raw, chunk_offset));
+        ROE(jls_core_rd_chunk(core));
+        if (core->chunk_cur.hdr.tag != JLS_TAG_TRACK_ANNOTATION_DATA) {
+            return JLS_ERROR_NOT_FOUND;
+        }
+        uint8_t * p = core->buf->start;
+        uint8_t * p_end = p + core->buf->length;
+        uint32_t entry_count = ((struct jls_payload_header_s *) p)->entry_count;
+        if (0 == entry_count) {
+            entry_count = 1;  // pre-coalescing writers left the count unreliable
+        }
+        for (uint32_t n = 0; (n < entry_count) && (p < p_end); ++n) {
+            struct jls_annotation_s * annotation = (struct jls_annotation_s *) p;
+            p += JLS_ANNOTATION_RECORD_SIZE(annotation->data_size);
+            if ((annotation->timestamp < t_start) || (annotation->timestamp >= t_end)) {
+                continue;
+            }
+            if (!anno_contains(annotation->data, annotation->data_size, data, data_size)) {
+                continue;
+            }
+            annotation->timestamp -= sample_id_offset;
+            if (cbk_fn(cbk_user_data, annotation)) {
+                return 0;
+            }
+        }
+    }
+    return 0;
+}
+
 int32_t jls_core_user_data(struct jls_core_s * self, jls_rd_user_data_cbk_fn cbk_fn, void * cbk_user_data) {
     int32_t rv;
     if (!cbk_fn) {
@@ -590,7 +3742,7 @@ int32_t jls_core_user_data(struct jls_core_s * self, jls_rd_user_data_cbk_fn cbk
         }
         chunk_meta = self->chunk_cur.hdr.chunk_meta & 0x0fff;
         rv = cbk_fn(cbk_user_data, chunk_meta, storage_type,
-                    self->buf->start, self->chunk_cur.hdr.payload_length);
+                    self->buf->start, (uint32_t) self->buf->length);
         if (rv) {  // iteration done
             return 0;
         }
@@ -600,6 +3752,7 @@ int32_t jls_core_user_data(struct jls_core_s * self, jls_rd_user_data_cbk_fn cbk
 }
 
 JLS_API int32_t jls_rd_user_data(struct jls_rd_s * self, jls_rd_user_data_cbk_fn cbk_fn, void * cbk_user_data) {
+    ROE(open_wait(self));
     return jls_core_user_data(&self->core, cbk_fn, cbk_user_data);
 }
 
@@ -625,8 +3778,10 @@ int32_t jls_core_utc(struct jls_core_s * self, uint16_t signal_id, int64_t sampl
     hdr.item_next = jls_raw_chunk_tell(self->raw);
 
     while (hdr.item_next) {
-        ROE(jls_raw_chunk_seek(self->raw, hdr.item_next));
+        int64_t pos = hdr.item_next;
+        ROE(jls_raw_chunk_seek(self->raw, pos));
         ROE(jls_raw_rd_header(self->raw, &hdr));
+        jls_core_link_table_patch(self, pos, &hdr);
         if (hdr.tag == JLS_TAG_TRACK_UTC_DATA) {
             ROE(jls_core_rd_chunk(self));
             struct jls_utc_data_s * utc_data = (struct jls_utc_data_s *) self->buf->start;
@@ -667,9 +3822,159 @@ int32_t jls_core_utc(struct jls_core_s * self, uint16_t signal_id, int64_t sampl
 
 JLS_API int32_t jls_rd_utc(struct jls_rd_s * self, uint16_t signal_id, int64_t sample_id,
                            jls_rd_utc_cbk_fn cbk_fn, void * cbk_user_data) {
+    ROE(open_wait(self));
     return jls_core_utc(&self->core, signal_id, sample_id, cbk_fn, cbk_user_data);
 }
 
+struct utc_range_s {
+    int64_t start_sample_id;   // inclusive
+    int64_t end_sample_id;     // exclusive
+    struct jls_utc_summary_entry_s * entries;
+    int64_t entries_max;
+    int64_t count;
+};
+
+static int32_t on_utc_range(void * user_data, const struct jls_utc_summary_entry_s * utc, uint32_t size) {
+    struct utc_range_s * r = (struct utc_range_s *) user_data;
+    for (uint32_t i = 0; i < size; ++i) {
+        if (utc[i].sample_id < r->start_sample_id) {
+            continue;
+        }
+        if ((utc[i].sample_id >= r->end_sample_id) || (r->count >= r->entries_max)) {
+            return 1;  // iteration done
+        }
+        r->entries[r->count++] = utc[i];
+    }
+    return 0;
+}
+
+JLS_API int32_t jls_rd_utc_range(struct jls_rd_s * self, uint16_t signal_id,
+                                 int64_t start_sample_id, int64_t end_sample_id,
+                                 struct jls_utc_summary_entry_s * entries, int64_t entries_max,
+                                 int64_t * count) {
+    ROE(open_wait(self));
+    if (!self || !entries || (entries_max <= 0) || !count) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    *count = 0;
+    struct utc_range_s r = {
+        .start_sample_id = start_sample_id,
+        .end_sample_id = end_sample_id,
+        .entries = entries,
+        .entries_max = entries_max,
+        .count = 0,
+    };
+    ROE(jls_core_utc(&self->core, signal_id, start_sample_id, on_utc_range, &r));
+    *count = r.count;
+    return 0;
+}
+
+JLS_API int32_t jls_rd_chunk_clock(struct jls_rd_s * self,
+        jls_rd_chunk_clock_cbk_fn cbk_fn, void * cbk_user_data) {
+    ROE(open_wait(self));
+    if (!cbk_fn) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_core_s * core = &self->core;
+    if (0 == core->chunk_clock_head) {
+        return JLS_ERROR_NOT_FOUND;
+    }
+
+    // walk the backward chain to collect the chunk offsets
+    int64_t * offsets = NULL;
+    size_t offsets_count = 0;
+    size_t offsets_alloc = 0;
+    int64_t pos = core->chunk_clock_head;
+    int32_t rv = 0;
+    while (pos) {
+        if (offsets_count >= offsets_alloc) {
+            offsets_alloc = offsets_alloc ? (offsets_alloc * 2) : 16;
+            int64_t * p = realloc(offsets, offsets_alloc * sizeof(int64_t));
+            if (NULL == p) {
+                free(offsets);
+                return JLS_ERROR_NOT_ENOUGH_MEMORY;
+            }
+            offsets = p;
+        }
+        offsets[offsets_count++] = pos;
+        rv = jls_raw_chunk_seek(core->raw, pos);
+        if (!rv) {
+            rv = jls_core_rd_chunk(core);
+        }
+        if (rv) {
+            break;
+        }
+        if (core->chunk_cur.hdr.tag != JLS_TAG_CHUNK_CLOCK) {
+            rv = JLS_ERROR_NOT_FOUND;
+            break;
+        }
+        struct jls_chunk_clock_s * cc = (struct jls_chunk_clock_s *) core->buf->start;
+        pos = cc->header.timestamp;  // offset of the previous chunk in the chain
+    }
+
+    // replay oldest-first
+    for (size_t i = offsets_count; !rv && (i > 0); --i) {
+        rv = jls_raw_chunk_seek(core->raw, offsets[i - 1]);
+        if (!rv) {
+            rv = jls_core_rd_chunk(core);
+        }
+        if (rv) {
+            break;
+        }
+        struct jls_chunk_clock_s * cc = (struct jls_chunk_clock_s *) core->buf->start;
+        if (cc->header.entry_count) {
+            if (cbk_fn(cbk_user_data, cc->entries, cc->header.entry_count)) {
+                break;  // iteration done
+            }
+        }
+    }
+    free(offsets);
+    return rv;
+}
+
+// build the data map by walking the level 0 data chunk chain, for
+// files written before JLS_TAG_DATA_MAP or not closed properly
+static int32_t data_map_build(struct jls_core_s * core, uint16_t signal_id) {
+    struct jls_core_signal_s * info = &core->signal_info[signal_id];
+    int64_t pos = info->tracks[JLS_TRACK_TYPE_FSR].head_offsets[0];
+    while (pos) {
+        ROE(jls_raw_chunk_seek(core->raw, pos));
+        ROE(jls_core_rd_chunk(core));
+        if ((core->chunk_cur.hdr.tag != JLS_TAG_TRACK_FSR_DATA)
+                || ((core->chunk_cur.hdr.chunk_meta & 0x0fff) != signal_id)) {
+            return JLS_ERROR_NOT_FOUND;
+        }
+        struct jls_payload_header_s * hdr = (struct jls_payload_header_s *) core->buf->start;
+        ROE(jls_core_data_map_append(core, signal_id, hdr->timestamp, hdr->entry_count));
+        pos = core->chunk_cur.hdr.item_next;
+    }
+    return 0;
+}
+
+JLS_API int32_t jls_rd_fsr_data_map(struct jls_rd_s * self, uint16_t signal_id,
+        const struct jls_fsr_data_map_entry_s ** entries, uint32_t * count) {
+    ROE(open_wait(self));
+    if ((NULL == entries) || (NULL == count)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    *entries = NULL;
+    *count = 0;
+    if (self->msegs) {
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    struct jls_core_s * core = &self->core;
+    ROE(jls_core_signal_validate_typed(core, signal_id, JLS_SIGNAL_TYPE_FSR));
+    struct jls_core_signal_s * info = &core->signal_info[signal_id];
+    if (NULL == info->data_map) {
+        ROE(data_map_build(core, signal_id));
+    }
+    if (NULL != info->data_map) {
+        *entries = info->data_map->entries;
+        *count = info->data_map->header.entry_count;
+    }
+    return 0;
+}
+
 static int32_t utc_load(struct jls_core_s * self, uint16_t signal_id) {
     ROE(jls_core_signal_validate_typed(self, signal_id, JLS_SIGNAL_TYPE_FSR));
     struct jls_core_signal_s * signal = &self->signal_info[signal_id];
@@ -682,6 +3987,20 @@ static int32_t utc_load(struct jls_core_s * self, uint16_t signal_id) {
     if (NULL == signal->track_fsr->tmap) {
         return JLS_ERROR_NOT_ENOUGH_MEMORY;
     }
+
+    if (NULL != signal->tmap_sidecar) {
+        // properly closed file: build directly from the UTC time map
+        // sidecar chunk instead of walking the UTC track
+        struct jls_utc_tmap_s * sidecar = signal->tmap_sidecar;
+        const int64_t sample_id_offset = signal_def->sample_id_offset;
+        for (uint32_t i = 0; i < sidecar->header.entry_count; ++i) {
+            ROE(jls_tmap_add(signal->track_fsr->tmap,
+                             sidecar->entries[i].sample_id - sample_id_offset,
+                             sidecar->entries[i].timestamp));
+        }
+        return 0;
+    }
+
     int64_t sample_rate = signal_def->sample_rate;
     int64_t sample_start = -3600 * sample_rate;  // within the last hour
     return jls_core_utc(self, signal_id, sample_start, jls_tmap_add_cbk, signal->track_fsr->tmap);
@@ -689,6 +4008,7 @@ static int32_t utc_load(struct jls_core_s * self, uint16_t signal_id) {
 
 JLS_API int32_t jls_rd_sample_id_to_timestamp(struct jls_rd_s * self, uint16_t signal_id,
                                                int64_t sample_id, int64_t * timestamp) {
+    ROE(open_wait(self));
     ROE(utc_load(&self->core, signal_id));
     struct jls_tmap_s * fsr = self->core.signal_info[signal_id].track_fsr->tmap;
     return jls_tmap_sample_id_to_timestamp(fsr, sample_id, timestamp);
@@ -696,7 +4016,68 @@ JLS_API int32_t jls_rd_sample_id_to_timestamp(struct jls_rd_s * self, uint16_t s
 
 JLS_API int32_t jls_rd_timestamp_to_sample_id(struct jls_rd_s * self, uint16_t signal_id,
                                               int64_t timestamp, int64_t * sample_id) {
+    ROE(open_wait(self));
     ROE(utc_load(&self->core, signal_id));
     struct jls_tmap_s * fsr = self->core.signal_info[signal_id].track_fsr->tmap;
     return jls_tmap_timestamp_to_sample_id(fsr, timestamp, sample_id);
 }
+
+JLS_API int32_t jls_rd_sample_id_to_timestamp_batch(struct jls_rd_s * self, uint16_t signal_id,
+        int64_t const * sample_ids, int64_t * timestamps, size_t count) {
+    ROE(open_wait(self));
+    if (count && (!sample_ids || !timestamps)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    ROE(utc_load(&self->core, signal_id));
+    struct jls_tmap_s * fsr = self->core.signal_info[signal_id].track_fsr->tmap;
+    return jls_tmap_sample_id_to_timestamp_batch(fsr, sample_ids, timestamps, count);
+}
+
+JLS_API int32_t jls_rd_timestamp_to_sample_id_batch(struct jls_rd_s * self, uint16_t signal_id,
+        int64_t const * timestamps, int64_t * sample_ids, size_t count) {
+    ROE(open_wait(self));
+    if (count && (!sample_ids || !timestamps)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    ROE(utc_load(&self->core, signal_id));
+    struct jls_tmap_s * fsr = self->core.signal_info[signal_id].track_fsr->tmap;
+    return jls_tmap_timestamp_to_sample_id_batch(fsr, timestamps, sample_ids, count);
+}
+
+JLS_API int32_t jls_rd_fsr_by_utc(struct jls_rd_s * self, uint16_t signal_id,
+        int64_t utc_start, int64_t utc_end,
+        void * data, int64_t data_length_max,
+        int64_t * start_sample_id, int64_t * data_length) {
+    ROE(open_wait(self));
+    if ((NULL == self) || (NULL == data) || (NULL == start_sample_id) || (NULL == data_length)
+            || (data_length_max <= 0) || (utc_end < utc_start)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    *start_sample_id = 0;
+    *data_length = 0;
+    ROE(utc_load(&self->core, signal_id));
+    struct jls_tmap_s * tmap = self->core.signal_info[signal_id].track_fsr->tmap;
+    int64_t s0 = 0;
+    int64_t s1 = 0;
+    ROE(jls_tmap_timestamp_to_sample_id(tmap, utc_start, &s0));
+    ROE(jls_tmap_timestamp_to_sample_id(tmap, utc_end, &s1));
+    int64_t samples = 0;
+    ROE(jls_rd_fsr_length(self, signal_id, &samples));
+    if (s0 < 0) {
+        s0 = 0;
+    }
+    if (s1 > samples) {
+        s1 = samples;
+    }
+    if (s1 <= s0) {
+        return 0;  // the range falls entirely outside the recording
+    }
+    int64_t length = s1 - s0;
+    if (length > data_length_max) {
+        length = data_length_max;
+    }
+    ROE(jls_rd_fsr(self, signal_id, s0, data, length));
+    *start_sample_id = s0;
+    *data_length = length;
+    return 0;
+}
@@ -0,0 +1,215 @@
+/*
+ * Copyright 2021-2023 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/shared_cache.h"
+#include "jls/backend.h"
+#include "jls/ec.h"
+#include "jls/log.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+#define SHM_MAGIC (0x00314d4853534c4aULL)  // "JLSSHM1" little-endian
+#define SLOT_PAYLOAD_MAX (64 * 1024)      // larger chunks are not cached
+#define SLOT_ALIGN (64)                   // cache-line align the slots
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+static inline uint32_t seq_load(volatile uint32_t * p) {
+    return (uint32_t) _InterlockedOr((volatile long *) p, 0);
+}
+static inline void seq_store(volatile uint32_t * p, uint32_t v) {
+    _InterlockedExchange((volatile long *) p, (long) v);
+}
+static inline int seq_cas(volatile uint32_t * p, uint32_t expected, uint32_t v) {
+    return _InterlockedCompareExchange((volatile long *) p, (long) v, (long) expected)
+            == (long) expected;
+}
+static inline void seq_fence_acquire(void) {
+    // seq_load() is a full barrier on MSVC, no extra fence needed
+}
+#else
+static inline uint32_t seq_load(volatile uint32_t * p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+static inline void seq_store(volatile uint32_t * p, uint32_t v) {
+    __atomic_store_n(p, v, __ATOMIC_RELEASE);
+}
+static inline int seq_cas(volatile uint32_t * p, uint32_t expected, uint32_t v) {
+    return __atomic_compare_exchange_n(p, &expected, v, 0,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+static inline void seq_fence_acquire(void) {
+    // an acquire load orders only the loads after it: the seqlock
+    // re-validation must also keep the preceding slot data reads from
+    // sinking past the seq re-load, which needs an explicit fence
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+}
+#endif
+
+struct shm_header_s {
+    uint64_t magic;
+    uint32_t slot_count;
+    uint32_t slot_payload_max;
+};
+
+struct slot_s {
+    volatile uint32_t seq;  // odd while a writer holds the slot
+    uint32_t payload_length;
+    uint64_t file_id;
+    int64_t offset;
+    struct jls_chunk_header_s hdr;
+    uint8_t payload[];
+};
+
+#define SLOT_STRIDE \
+    ((sizeof(struct slot_s) + SLOT_PAYLOAD_MAX + SLOT_ALIGN - 1) & ~((size_t) (SLOT_ALIGN - 1)))
+
+struct jls_shared_cache_s {
+    struct jls_bk_shm_s shm;
+    struct shm_header_s * header;
+    uint8_t * slots;
+    uint32_t slot_count;
+};
+
+static inline struct slot_s * slot_get(struct jls_shared_cache_s * self, uint32_t idx) {
+    return (struct slot_s *) (self->slots + (size_t) idx * SLOT_STRIDE);
+}
+
+static inline uint32_t slot_index(struct jls_shared_cache_s * self,
+                                  uint64_t file_id, int64_t offset) {
+    // chunks are 8-byte aligned, mix for an even spread
+    uint64_t h = file_id ^ (((uint64_t) offset) >> 3);
+    h *= 0x9e3779b97f4a7c15LLU;
+    return (uint32_t) ((h >> 32) % self->slot_count);
+}
+
+int32_t jls_shared_cache_open(struct jls_shared_cache_s ** instance,
+                              const char * name, int64_t size) {
+    if (!instance || !name || (size <= 0)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    int64_t slots = (size - (int64_t) sizeof(struct shm_header_s)) / (int64_t) SLOT_STRIDE;
+    if (slots < 1) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_shared_cache_s * self = calloc(1, sizeof(struct jls_shared_cache_s));
+    if (!self) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    int32_t rc = jls_bk_shm_open(&self->shm, name, size);
+    if (rc) {
+        free(self);
+        return rc;
+    }
+    self->header = (struct shm_header_s *) self->shm.ptr;
+    self->slots = ((uint8_t *) self->shm.ptr) + sizeof(struct shm_header_s);
+    self->slot_count = (uint32_t) slots;
+    if (SHM_MAGIC != self->header->magic) {
+        // first attach initializes; the parameters are deterministic
+        // from the agreed size, so a concurrent attach writes the
+        // identical values
+        self->header->slot_count = self->slot_count;
+        self->header->slot_payload_max = SLOT_PAYLOAD_MAX;
+        self->header->magic = SHM_MAGIC;
+    } else if ((self->header->slot_count != self->slot_count)
+            || (self->header->slot_payload_max != SLOT_PAYLOAD_MAX)) {
+        JLS_LOGW("shared cache %s geometry mismatch", name);
+        jls_bk_shm_close(&self->shm);
+        free(self);
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    *instance = self;
+    return 0;
+}
+
+void jls_shared_cache_close(struct jls_shared_cache_s * self) {
+    if (self) {
+        jls_bk_shm_close(&self->shm);
+        free(self);
+    }
+}
+
+int32_t jls_shared_cache_get(struct jls_shared_cache_s * self,
+                             uint64_t file_id, int64_t offset,
+                             struct jls_chunk_header_s * hdr,
+                             uint8_t * payload, uint32_t payload_max) {
+    if (!self || !hdr || !payload) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    uint32_t idx = slot_index(self, file_id, offset);
+    for (uint32_t probe = 0; probe < 2; ++probe) {
+        struct slot_s * slot = slot_get(self, (idx + probe) % self->slot_count);
+        uint32_t seq = seq_load(&slot->seq);
+        if ((seq & 1) || (0 == seq)) {
+            continue;  // being written or never filled
+        }
+        if ((slot->file_id != file_id) || (slot->offset != offset)) {
+            continue;
+        }
+        struct jls_chunk_header_s hdr_copy = slot->hdr;
+        uint32_t length = slot->payload_length;
+        if (length > SLOT_PAYLOAD_MAX) {
+            continue;  // torn read, the re-check below would also catch it
+        }
+        if (length > payload_max) {
+            seq_fence_acquire();
+            if (seq_load(&slot->seq) != seq) {
+                continue;  // replaced during the copy
+            }
+            *hdr = hdr_copy;
+            return JLS_ERROR_TOO_BIG;  // hdr valid, retry with a larger buffer
+        }
+        memcpy(payload, (const uint8_t *) slot->payload, length);
+        seq_fence_acquire();
+        if (seq_load(&slot->seq) != seq) {
+            continue;  // replaced during the copy
+        }
+        *hdr = hdr_copy;
+        return 0;
+    }
+    return JLS_ERROR_NOT_FOUND;
+}
+
+int32_t jls_shared_cache_put(struct jls_shared_cache_s * self,
+                             uint64_t file_id, int64_t offset,
+                             const struct jls_chunk_header_s * hdr,
+                             const uint8_t * payload) {
+    if (!self || !hdr || (hdr->payload_length && !payload)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (hdr->payload_length > SLOT_PAYLOAD_MAX) {
+        return 0;  // too large for a slot, best effort
+    }
+    uint32_t idx = slot_index(self, file_id, offset);
+    struct slot_s * slot = slot_get(self, idx);
+    uint32_t seq = seq_load(&slot->seq);
+    if ((seq & 1) || ((0 != seq) && (slot->file_id == file_id) && (slot->offset == offset))) {
+        return 0;  // contended or already cached, best effort
+    }
+    if (!seq_cas(&slot->seq, seq, seq + 1)) {
+        return 0;  // another writer claimed the slot
+    }
+    slot->file_id = file_id;
+    slot->offset = offset;
+    slot->hdr = *hdr;
+    slot->payload_length = hdr->payload_length;
+    if (hdr->payload_length) {
+        memcpy((uint8_t *) slot->payload, payload, hdr->payload_length);
+    }
+    seq_store(&slot->seq, seq + 2);
+    return 0;
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2021-2025 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/simd.h"
+#include "jls/log.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+
+static void cpuid_ex(int leaf, int subleaf, int out[4]) {
+    __cpuidex(out, leaf, subleaf);
+}
+
+static uint64_t xgetbv0(void) {
+    return _xgetbv(0);
+}
+
+#else
+#include <cpuid.h>
+
+static void cpuid_ex(int leaf, int subleaf, int out[4]) {
+    unsigned int a = 0;
+    unsigned int b = 0;
+    unsigned int c = 0;
+    unsigned int d = 0;
+    if (!__get_cpuid_count((unsigned int) leaf, (unsigned int) subleaf, &a, &b, &c, &d)) {
+        a = b = c = d = 0;
+    }
+    out[0] = (int) a;
+    out[1] = (int) b;
+    out[2] = (int) c;
+    out[3] = (int) d;
+}
+
+static uint64_t xgetbv0(void) {
+    uint32_t eax;
+    uint32_t edx;
+    // xgetbv encoded directly: <immintrin.h> only exposes _xgetbv under -mxsave
+    __asm__ volatile (".byte 0x0f, 0x01, 0xd0" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (((uint64_t) edx) << 32) | eax;
+}
+
+#endif
+
+static enum jls_simd_level_e simd_detect(void) {
+    int r[4];
+    cpuid_ex(1, 0, r);
+    // OSXSAVE (ecx bit 27) and AVX (ecx bit 28): OS saves the ymm state
+    if (((r[2] >> 27) & 1) == 0 || ((r[2] >> 28) & 1) == 0) {
+        return JLS_SIMD_LEVEL_SSE2;
+    }
+    uint64_t xcr0 = xgetbv0();
+    if ((xcr0 & 0x6) != 0x6) {  // xmm and ymm state enabled
+        return JLS_SIMD_LEVEL_SSE2;
+    }
+    cpuid_ex(7, 0, r);
+    if (((r[1] >> 5) & 1) == 0) {  // AVX2 (ebx bit 5)
+        return JLS_SIMD_LEVEL_SSE2;
+    }
+    // AVX-512 F (ebx bit 16) with opmask, zmm hi256, and hi16 zmm state
+    if (((r[1] >> 16) & 1) && ((xcr0 & 0xe6) == 0xe6)) {
+        return JLS_SIMD_LEVEL_AVX512;
+    }
+    return JLS_SIMD_LEVEL_AVX2;
+}
+
+#else
+
+static enum jls_simd_level_e simd_detect(void) {
+    return JLS_SIMD_LEVEL_SW;
+}
+
+#endif
+
+static int32_t simd_level_parse(const char * s) {
+    if ((0 == strcmp(s, "sw")) || (0 == strcmp(s, "0"))) {
+        return JLS_SIMD_LEVEL_SW;
+    } else if ((0 == strcmp(s, "sse2")) || (0 == strcmp(s, "sse")) || (0 == strcmp(s, "1"))) {
+        return JLS_SIMD_LEVEL_SSE2;
+    } else if ((0 == strcmp(s, "avx2")) || (0 == strcmp(s, "2"))) {
+        return JLS_SIMD_LEVEL_AVX2;
+    } else if ((0 == strcmp(s, "avx512")) || (0 == strcmp(s, "3"))) {
+        return JLS_SIMD_LEVEL_AVX512;
+    }
+    return -1;
+}
+
+// Lazily resolved; the duplicate-initialization race is benign since
+// every thread resolves to the same level.
+static volatile int simd_level_ = -1;
+
+enum jls_simd_level_e jls_simd_level(void) {
+    int level = simd_level_;
+    if (level >= 0) {
+        return (enum jls_simd_level_e) level;
+    }
+    level = simd_detect();
+    const char * env = getenv("JLS_SIMD_LEVEL");
+    if (env && env[0]) {
+        int32_t req = simd_level_parse(env);
+        if (req < 0) {
+            JLS_LOGW("JLS_SIMD_LEVEL invalid: %s", env);
+        } else if (req > level) {
+            JLS_LOGW("JLS_SIMD_LEVEL %s exceeds hardware support, using %d", env, level);
+        } else {
+            level = req;
+        }
+    }
+    simd_level_ = level;
+    return (enum jls_simd_level_e) level;
+}
@@ -0,0 +1,315 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/stat_cache.h"
+#include "jls/xxh64.h"
+#include "jls/cdef.h"
+#include "jls/ec.h"
+#include "jls/format.h"
+#include "jls/log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define FILE_ID_HEAD_BYTES (4096)
+#define SIDECAR_VERSION (1)
+#define PATH_TMP_SUFFIX ".tmp"
+
+// 16-byte sidecar magic in the style of JLS_HEADER_IDENTIFICATION:
+// non-ASCII start, name, then line-ending permutation detectors.
+static const uint8_t MAGIC[16] = {0xd3, 'J', 'L', 'S', '_', 'S', 'T', 'A', 'T', 'S',
+                                  0x0d, 0x0a, 0x20, 0x0a, 0x1a, 0x00};
+
+struct sidecar_header_s {
+    uint8_t magic[16];
+    uint32_t version;
+    uint32_t count;
+    uint64_t file_id;
+};
+
+struct record_header_s {
+    uint16_t signal_id;
+    uint16_t rsv16;
+    uint32_t length;
+    int64_t start_sample_id;
+    int64_t increment;
+};
+
+struct record_s {
+    struct record_header_s hdr;
+    double * data;      // length * JLS_SUMMARY_FSR_COUNT doubles
+};
+
+struct jls_stat_cache_s {
+    char * path;
+    uint64_t file_id;
+    struct record_s * records;  // insertion (FIFO) order for eviction
+    size_t count;
+    size_t alloc;
+    size_t data_bytes;
+    size_t data_bytes_max;
+    uint8_t dirty;
+};
+
+static size_t record_data_size(uint32_t length) {
+    return (size_t) length * JLS_SUMMARY_FSR_COUNT * sizeof(double);
+}
+
+int32_t jls_stat_cache_file_id(const char * jls_path, uint64_t * file_id) {
+    if ((NULL == jls_path) || (NULL == file_id)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    uint8_t head[FILE_ID_HEAD_BYTES + 8];
+    FILE * f = fopen(jls_path, "rb");
+    if (NULL == f) {
+        return JLS_ERROR_IO;
+    }
+    if (fseek(f, 0, SEEK_END)) {
+        fclose(f);
+        return JLS_ERROR_IO;
+    }
+    uint64_t length = (uint64_t) ftell(f);
+    memcpy(head, &length, sizeof(length));
+    if (fseek(f, 0, SEEK_SET)) {
+        fclose(f);
+        return JLS_ERROR_IO;
+    }
+    size_t sz = fread(head + 8, 1, FILE_ID_HEAD_BYTES, f);
+    fclose(f);
+    *file_id = jls_xxh64(head, sz + 8);
+    return 0;
+}
+
+static void sidecar_load(struct jls_stat_cache_s * self) {
+    struct sidecar_header_s hdr;
+    FILE * f = fopen(self->path, "rb");
+    if (NULL == f) {
+        return;  // no sidecar yet, start empty
+    }
+    if ((1 != fread(&hdr, sizeof(hdr), 1, f))
+            || memcmp(hdr.magic, MAGIC, sizeof(MAGIC))
+            || (SIDECAR_VERSION != hdr.version)) {
+        JLS_LOGW("stat_cache: invalid sidecar %s, discard", self->path);
+        fclose(f);
+        return;
+    }
+    if (hdr.file_id != self->file_id) {
+        JLS_LOGI("stat_cache: JLS file changed, discard sidecar %s", self->path);
+        fclose(f);
+        return;
+    }
+    for (uint32_t i = 0; i < hdr.count; ++i) {
+        struct record_header_s r;
+        if ((1 != fread(&r, sizeof(r), 1, f))
+                || (0 == r.length) || (r.length > JLS_STAT_CACHE_ENTRY_LENGTH_MAX)) {
+            break;  // truncated or corrupt tail: keep what loaded
+        }
+        double * data = malloc(record_data_size(r.length));
+        if (NULL == data) {
+            break;
+        }
+        if (1 != fread(data, record_data_size(r.length), 1, f)) {
+            free(data);
+            break;
+        }
+        if (jls_stat_cache_put(self, r.signal_id, r.start_sample_id, r.increment,
+                               data, r.length)) {
+            free(data);
+            break;
+        }
+        free(data);
+    }
+    self->dirty = 0;  // loaded contents match the sidecar
+    fclose(f);
+}
+
+int32_t jls_stat_cache_open(struct jls_stat_cache_s ** instance,
+                            const char * path, uint64_t file_id) {
+    if ((NULL == instance) || (NULL == path)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_stat_cache_s * self = calloc(1, sizeof(struct jls_stat_cache_s));
+    if (NULL == self) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    self->path = malloc(strlen(path) + 1);
+    if (NULL == self->path) {
+        free(self);
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    memcpy(self->path, path, strlen(path) + 1);
+    self->file_id = file_id;
+    self->data_bytes_max = JLS_STAT_CACHE_BYTES_DEFAULT;
+    sidecar_load(self);
+    *instance = self;
+    return 0;
+}
+
+static struct record_s * record_find(struct jls_stat_cache_s * self, uint16_t signal_id,
+                                     int64_t start_sample_id, int64_t increment,
+                                     int64_t data_length) {
+    for (size_t i = 0; i < self->count; ++i) {
+        struct record_s * r = &self->records[i];
+        if ((r->hdr.signal_id == signal_id)
+                && (r->hdr.start_sample_id == start_sample_id)
+                && (r->hdr.increment == increment)
+                && (r->hdr.length == (uint32_t) data_length)) {
+            return r;
+        }
+    }
+    return NULL;
+}
+
+int32_t jls_stat_cache_get(struct jls_stat_cache_s * self, uint16_t signal_id,
+                           int64_t start_sample_id, int64_t increment,
+                           double * data, int64_t data_length) {
+    if ((NULL == self) || (NULL == data)
+            || (data_length <= 0) || (data_length > JLS_STAT_CACHE_ENTRY_LENGTH_MAX)) {
+        return JLS_ERROR_NOT_FOUND;
+    }
+    struct record_s * r = record_find(self, signal_id, start_sample_id, increment, data_length);
+    if (NULL == r) {
+        return JLS_ERROR_NOT_FOUND;
+    }
+    memcpy(data, r->data, record_data_size(r->hdr.length));
+    return 0;
+}
+
+static void record_evict_oldest(struct jls_stat_cache_s * self) {
+    if (0 == self->count) {
+        return;
+    }
+    struct record_s * r = &self->records[0];
+    self->data_bytes -= record_data_size(r->hdr.length);
+    free(r->data);
+    --self->count;
+    memmove(&self->records[0], &self->records[1], self->count * sizeof(struct record_s));
+}
+
+int32_t jls_stat_cache_put(struct jls_stat_cache_s * self, uint16_t signal_id,
+                           int64_t start_sample_id, int64_t increment,
+                           const double * data, int64_t data_length) {
+    if ((NULL == self) || (NULL == data)
+            || (data_length <= 0) || (data_length > JLS_STAT_CACHE_ENTRY_LENGTH_MAX)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    size_t data_size = record_data_size((uint32_t) data_length);
+    struct record_s * r = record_find(self, signal_id, start_sample_id, increment, data_length);
+    if (NULL != r) {
+        if (memcmp(r->data, data, data_size)) {
+            memcpy(r->data, data, data_size);
+            self->dirty = 1;
+        }
+        return 0;
+    }
+    if (data_size > self->data_bytes_max) {
+        return 0;  // larger than the whole budget: skip silently
+    }
+    while ((self->data_bytes + data_size) > self->data_bytes_max) {
+        record_evict_oldest(self);
+        self->dirty = 1;
+    }
+    if (self->count >= self->alloc) {
+        size_t alloc = self->alloc ? (self->alloc * 2) : 256;
+        struct record_s * records = realloc(self->records, alloc * sizeof(struct record_s));
+        if (NULL == records) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        self->records = records;
+        self->alloc = alloc;
+    }
+    r = &self->records[self->count];
+    memset(r, 0, sizeof(*r));
+    r->hdr.signal_id = signal_id;
+    r->hdr.length = (uint32_t) data_length;
+    r->hdr.start_sample_id = start_sample_id;
+    r->hdr.increment = increment;
+    r->data = malloc(data_size);
+    if (NULL == r->data) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    memcpy(r->data, data, data_size);
+    ++self->count;
+    self->data_bytes += data_size;
+    self->dirty = 1;
+    return 0;
+}
+
+int32_t jls_stat_cache_save(struct jls_stat_cache_s * self) {
+    if (NULL == self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (!self->dirty) {
+        return 0;
+    }
+    size_t path_sz = strlen(self->path) + sizeof(PATH_TMP_SUFFIX);
+    char * path_tmp = malloc(path_sz);
+    if (NULL == path_tmp) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    snprintf(path_tmp, path_sz, "%s%s", self->path, PATH_TMP_SUFFIX);
+    FILE * f = fopen(path_tmp, "wb");
+    if (NULL == f) {
+        free(path_tmp);
+        return JLS_ERROR_IO;
+    }
+    struct sidecar_header_s hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, MAGIC, sizeof(MAGIC));
+    hdr.version = SIDECAR_VERSION;
+    hdr.count = (uint32_t) self->count;
+    hdr.file_id = self->file_id;
+    int32_t rc = (1 == fwrite(&hdr, sizeof(hdr), 1, f)) ? 0 : JLS_ERROR_IO;
+    for (size_t i = 0; (0 == rc) && (i < self->count); ++i) {
+        struct record_s * r = &self->records[i];
+        if ((1 != fwrite(&r->hdr, sizeof(r->hdr), 1, f))
+                || (1 != fwrite(r->data, record_data_size(r->hdr.length), 1, f))) {
+            rc = JLS_ERROR_IO;
+        }
+    }
+    if (fclose(f) && (0 == rc)) {
+        rc = JLS_ERROR_IO;
+    }
+    if (0 == rc) {
+        remove(self->path);  // windows rename does not replace
+        if (rename(path_tmp, self->path)) {
+            rc = JLS_ERROR_IO;
+        }
+    }
+    if (rc) {
+        remove(path_tmp);
+    } else {
+        self->dirty = 0;
+    }
+    free(path_tmp);
+    return rc;
+}
+
+void jls_stat_cache_close(struct jls_stat_cache_s * self) {
+    if (NULL == self) {
+        return;
+    }
+    if (jls_stat_cache_save(self)) {
+        JLS_LOGW("stat_cache: could not save sidecar %s", self->path);
+    }
+    for (size_t i = 0; i < self->count; ++i) {
+        free(self->records[i].data);
+    }
+    free(self->records);
+    free(self->path);
+    free(self);
+}
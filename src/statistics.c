@@ -33,72 +33,6 @@ void jls_statistics_invalid(struct jls_statistics_s *s) {
     s->max = NAN;
 }
 
-void jls_statistics_compute_f32(struct jls_statistics_s * s, const float * x, uint64_t length) {
-    if (length <= 0) {
-        jls_statistics_reset(s);
-        return;
-    }
-    float v;
-    double v_mean = 0.0;
-    float v_min = FLT_MAX;
-    float v_max = -FLT_MAX;
-    double v_var = 0.0;
-    for (uint64_t i = 0; i < length; ++i) {
-        v = x[i];
-        v_mean += v;
-        if (v < v_min) {
-            v_min = v;
-        }
-        if (v > v_max) {
-            v_max = v;
-        }
-    }
-    v_mean /= length;
-    double m;
-    for (uint64_t i = 0; i < length; ++i) {
-        m = x[i] - v_mean;
-        v_var += (m * m);
-    }
-    s->k = length;
-    s->mean = v_mean;
-    s->s = v_var;
-    s->min = v_min;
-    s->max = v_max;
-}
-
-void jls_statistics_compute_f64(struct jls_statistics_s * s, const double * x, uint64_t length)  {
-    if (length <= 0) {
-        jls_statistics_reset(s);
-        return;
-    }
-    double v;
-    double v_mean = 0.0;
-    double v_min = DBL_MAX;
-    double v_max = -DBL_MAX;
-    double v_var = 0.0;
-    for (uint64_t i = 0; i < length; ++i) {
-        v = x[i];
-        v_mean += v;
-        if (v < v_min) {
-            v_min = v;
-        }
-        if (v > v_max) {
-            v_max = v;
-        }
-    }
-    v_mean /= length;
-    double m;
-    for (uint64_t i = 0; i < length; ++i) {
-        m = x[i] - v_mean;
-        v_var += (m * m);
-    }
-    s->k = length;
-    s->mean = v_mean;
-    s->s = v_var;
-    s->min = v_min;
-    s->max = v_max;
-}
-
 void jls_statistics_add(struct jls_statistics_s *s, double x) {
     double m_old;
     double m_new;
@@ -158,3 +92,128 @@ void jls_statistics_combine(struct jls_statistics_s *tgt,
         tgt->k = kt;
     }
 }
+
+/*
+ * Batch reduction for consecutive equal-weight summary entries, layout
+ * mean, std, min, max per JLS_SUMMARY_FSR_e.  For n samples per entry,
+ * each entry i contributes s_i = std_i^2 * (n - 1), and the equal
+ * weights collapse the pairwise combine to the closed form
+ *     s = (n - 1) * sum(std_i^2) + n * (sum(mean_i^2) - count * M^2)
+ * with M the average of the means.  This removes the per-entry divide
+ * and branch of jls_statistics_combine(), and the min/max comparisons
+ * stay in the entry's native precision so the compiler can keep f32
+ * summaries in f32 vector lanes; only the final reduction widens.
+ */
+void jls_statistics_combine_summary_f32(struct jls_statistics_s * tgt,
+                                        const float * entries, uint64_t count,
+                                        uint64_t samples_per_entry) {
+    if ((0 == count) || (0 == samples_per_entry)) {
+        return;
+    }
+    float v_min = entries[2];
+    float v_max = entries[3];
+    double mean_sum = 0.0;
+    double mean_sq_sum = 0.0;
+    double std_sq_sum = 0.0;
+    for (uint64_t i = 0; i < count; ++i) {
+        const float * e = entries + i * 4;
+        v_min = (e[2] < v_min) ? e[2] : v_min;
+        v_max = (e[3] > v_max) ? e[3] : v_max;
+        mean_sum += e[0];
+        mean_sq_sum += (double) e[0] * e[0];
+        std_sq_sum += (double) e[1] * e[1];
+    }
+    struct jls_statistics_s b;
+    const double n = (double) samples_per_entry;
+    b.k = count * samples_per_entry;
+    b.mean = mean_sum / (double) count;
+    b.min = v_min;
+    b.max = v_max;
+    b.s = n * (mean_sq_sum - (double) count * b.mean * b.mean);
+    if (samples_per_entry > 1) {
+        b.s += (n - 1.0) * std_sq_sum;
+    }
+    if (b.s < 0.0) {  // guard rounding in the mean cancellation
+        b.s = 0.0;
+    }
+    jls_statistics_combine(tgt, tgt, &b);
+}
+
+void jls_statistics_combine_summary_f64(struct jls_statistics_s * tgt,
+                                        const double * entries, uint64_t count,
+                                        uint64_t samples_per_entry) {
+    if ((0 == count) || (0 == samples_per_entry)) {
+        return;
+    }
+    double v_min = entries[2];
+    double v_max = entries[3];
+    double mean_sum = 0.0;
+    double mean_sq_sum = 0.0;
+    double std_sq_sum = 0.0;
+    for (uint64_t i = 0; i < count; ++i) {
+        const double * e = entries + i * 4;
+        v_min = (e[2] < v_min) ? e[2] : v_min;
+        v_max = (e[3] > v_max) ? e[3] : v_max;
+        mean_sum += e[0];
+        mean_sq_sum += e[0] * e[0];
+        std_sq_sum += e[1] * e[1];
+    }
+    struct jls_statistics_s b;
+    const double n = (double) samples_per_entry;
+    b.k = count * samples_per_entry;
+    b.mean = mean_sum / (double) count;
+    b.min = v_min;
+    b.max = v_max;
+    b.s = n * (mean_sq_sum - (double) count * b.mean * b.mean);
+    if (samples_per_entry > 1) {
+        b.s += (n - 1.0) * std_sq_sum;
+    }
+    if (b.s < 0.0) {
+        b.s = 0.0;
+    }
+    jls_statistics_combine(tgt, tgt, &b);
+}
+
+/*
+ * Dynamically detect the compute kernel implementation, using the same
+ * approach as bit_shift.c and crc32c.c.  jls_rd_fsr_statistics() funnels
+ * every level 0 request through jls_statistics_compute_f32()/_f64(), and
+ * the scalar version makes two full passes over the sample data, so use
+ * the one-pass SIMD kernels whenever the target supports them.  On
+ * x86-64, statistics_intel_dispatch.c additionally resolves the vector
+ * width (SSE2, AVX2, AVX-512) at runtime through jls_simd_level().
+ */
+
+#if defined(JLS_OPTIMIZE_CRC_DISABLE) || defined(JLS_OPTIMIZE_STATS_DISABLE)
+#include "statistics_sw.c"
+
+#elif defined(WIN32) || defined(_WIN32) || defined(__WIN32__) || defined(__NT__)
+#if defined(_M_X64) || defined(__x86_64__)
+#include "statistics_intel_dispatch.c"
+#else
+#include "statistics_sw.c"
+#endif
+
+#elif defined(__APPLE__) && defined(__MACH__)
+#if defined(_M_ARM64) || defined(__aarch64__) || defined(__arm64__)
+#include "statistics_arm_neon.c"
+#elif defined(_M_X64) || defined(__x86_64__)
+#include "statistics_intel_dispatch.c"
+#else
+#include "statistics_sw.c"
+#endif
+
+#elif defined(__linux__) && __linux__
+#if defined(_M_X64) || defined(__x86_64__)
+#include "statistics_intel_dispatch.c"
+#elif defined(__aarch64__)
+// NEON is architecturally required on aarch64, unlike the CRC extension.
+#include "statistics_arm_neon.c"
+#else
+#include "statistics_sw.c"
+#endif
+
+#else
+#include "statistics_sw.c"
+
+#endif
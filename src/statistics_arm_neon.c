@@ -0,0 +1,184 @@
+/*
+ * Copyright 2022 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/statistics.h"
+#include <arm_neon.h>
+#include <float.h>
+
+/*
+ * One-pass accumulation: process the data in blocks.  Within a block,
+ * accumulate the sum and sum of squares of (x - K) where K is the first
+ * block sample, which keeps the squared terms small and well-conditioned.
+ * Convert each block to mean/s form and merge with the existing
+ * jls_statistics_combine() math, so the result matches the two-pass
+ * scalar reference to near machine precision while reading the sample
+ * data only once.
+ */
+
+#define BLOCK (256)     // samples per block, bounds the shifted-sum magnitude
+#define TAIL_MIN (64)   // below this, the scalar accumulator wins
+
+
+static void block_f32(struct jls_statistics_s * acc, const float * x, uint64_t length) {
+    const double k_shift = (double) x[0];
+    const float64x2_t k_v = vdupq_n_f64(k_shift);
+    float64x2_t sum_v = vdupq_n_f64(0.0);
+    float64x2_t sumsq_v = vdupq_n_f64(0.0);
+    float32x4_t min_v = vdupq_n_f32(FLT_MAX);
+    float32x4_t max_v = vdupq_n_f32(-FLT_MAX);
+    uint64_t i = 0;
+    for (; (i + 4) <= length; i += 4) {
+        float32x4_t v = vld1q_f32(x + i);
+        // select on compare, not vminq: NaN in v keeps the running value,
+        // matching the scalar (v < min) update
+        min_v = vbslq_f32(vcltq_f32(v, min_v), v, min_v);
+        max_v = vbslq_f32(vcgtq_f32(v, max_v), v, max_v);
+        float64x2_t lo = vsubq_f64(vcvt_f64_f32(vget_low_f32(v)), k_v);
+        float64x2_t hi = vsubq_f64(vcvt_high_f64_f32(v), k_v);
+        sum_v = vaddq_f64(sum_v, vaddq_f64(lo, hi));
+        sumsq_v = vaddq_f64(sumsq_v, vaddq_f64(vmulq_f64(lo, lo), vmulq_f64(hi, hi)));
+    }
+
+    float mins[4];
+    float maxs[4];
+    vst1q_f32(mins, min_v);
+    vst1q_f32(maxs, max_v);
+    double sum = vaddvq_f64(sum_v);
+    double sumsq = vaddvq_f64(sumsq_v);
+    float v_min = mins[0];
+    float v_max = maxs[0];
+    for (int j = 1; j < 4; ++j) {
+        if (mins[j] < v_min) {
+            v_min = mins[j];
+        }
+        if (maxs[j] > v_max) {
+            v_max = maxs[j];
+        }
+    }
+
+    for (; i < length; ++i) {
+        float v = x[i];
+        double d = v - k_shift;
+        sum += d;
+        sumsq += d * d;
+        if (v < v_min) {
+            v_min = v;
+        }
+        if (v > v_max) {
+            v_max = v;
+        }
+    }
+
+    struct jls_statistics_s b;
+    b.k = length;
+    b.mean = k_shift + sum / (double) length;
+    b.s = sumsq - (sum * sum) / (double) length;
+    if (b.s < 0.0) {  // rounding in the shifted sums, exact result is >= 0
+        b.s = 0.0;
+    }
+    b.min = v_min;
+    b.max = v_max;
+    jls_statistics_combine(acc, acc, &b);
+}
+
+static void block_f64(struct jls_statistics_s * acc, const double * x, uint64_t length) {
+    const double k_shift = x[0];
+    const float64x2_t k_v = vdupq_n_f64(k_shift);
+    float64x2_t sum_v = vdupq_n_f64(0.0);
+    float64x2_t sumsq_v = vdupq_n_f64(0.0);
+    float64x2_t min_v = vdupq_n_f64(DBL_MAX);
+    float64x2_t max_v = vdupq_n_f64(-DBL_MAX);
+    uint64_t i = 0;
+    for (; (i + 2) <= length; i += 2) {
+        float64x2_t v = vld1q_f64(x + i);
+        min_v = vbslq_f64(vcltq_f64(v, min_v), v, min_v);
+        max_v = vbslq_f64(vcgtq_f64(v, max_v), v, max_v);
+        float64x2_t d = vsubq_f64(v, k_v);
+        sum_v = vaddq_f64(sum_v, d);
+        sumsq_v = vaddq_f64(sumsq_v, vmulq_f64(d, d));
+    }
+
+    double mins[2];
+    double maxs[2];
+    vst1q_f64(mins, min_v);
+    vst1q_f64(maxs, max_v);
+    double sum = vaddvq_f64(sum_v);
+    double sumsq = vaddvq_f64(sumsq_v);
+    double v_min = (mins[1] < mins[0]) ? mins[1] : mins[0];
+    double v_max = (maxs[1] > maxs[0]) ? maxs[1] : maxs[0];
+
+    for (; i < length; ++i) {
+        double v = x[i];
+        double d = v - k_shift;
+        sum += d;
+        sumsq += d * d;
+        if (v < v_min) {
+            v_min = v;
+        }
+        if (v > v_max) {
+            v_max = v;
+        }
+    }
+
+    struct jls_statistics_s b;
+    b.k = length;
+    b.mean = k_shift + sum / (double) length;
+    b.s = sumsq - (sum * sum) / (double) length;
+    if (b.s < 0.0) {
+        b.s = 0.0;
+    }
+    b.min = v_min;
+    b.max = v_max;
+    jls_statistics_combine(acc, acc, &b);
+}
+
+void jls_statistics_compute_f32(struct jls_statistics_s * s, const float * x, uint64_t length) {
+    jls_statistics_reset(s);
+    if (length <= 0) {
+        return;
+    }
+    uint64_t i = 0;
+    uint64_t n;
+    while ((n = length - i) >= TAIL_MIN) {
+        if (n > BLOCK) {
+            n = BLOCK;
+        }
+        block_f32(s, x + i, n);
+        i += n;
+    }
+    for (; i < length; ++i) {
+        jls_statistics_add(s, x[i]);
+    }
+}
+
+void jls_statistics_compute_f64(struct jls_statistics_s * s, const double * x, uint64_t length) {
+    jls_statistics_reset(s);
+    if (length <= 0) {
+        return;
+    }
+    uint64_t i = 0;
+    uint64_t n;
+    while ((n = length - i) >= TAIL_MIN) {
+        if (n > BLOCK) {
+            n = BLOCK;
+        }
+        block_f64(s, x + i, n);
+        i += n;
+    }
+    for (; i < length; ++i) {
+        jls_statistics_add(s, x[i]);
+    }
+}
@@ -0,0 +1,352 @@
+/*
+ * Copyright 2022-2025 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/statistics.h"
+#include <immintrin.h>
+#include <float.h>
+
+/*
+ * AVX2 and AVX-512 widenings of the statistics_intel_sse.c kernels,
+ * using the same block structure and shifted accumulation so the
+ * results match the scalar reference to near machine precision.  The
+ * wider instruction sets are optional on x86-64, so these compile with
+ * per-function target attributes and statistics_intel_dispatch.c binds
+ * the widest variant the CPU supports at first use.
+ */
+
+#if defined(_MSC_VER)
+// MSVC exposes all intrinsics without target attributes or /arch flags.
+#define JLS_TARGET_AVX2
+#define JLS_TARGET_AVX512
+#else
+#define JLS_TARGET_AVX2 __attribute__((target("avx2")))
+#define JLS_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+#ifndef BLOCK
+#define BLOCK (256)     // samples per block, bounds the shifted-sum magnitude
+#define TAIL_MIN (64)   // below this, the scalar accumulator wins
+#endif
+
+
+JLS_TARGET_AVX2
+static void block_f32_avx2(struct jls_statistics_s * acc, const float * x, uint64_t length) {
+    const double k_shift = (double) x[0];
+    const __m256d k_v = _mm256_set1_pd(k_shift);
+    __m256d sum_v = _mm256_setzero_pd();
+    __m256d sumsq_v = _mm256_setzero_pd();
+    __m256 min_v = _mm256_set1_ps(FLT_MAX);
+    __m256 max_v = _mm256_set1_ps(-FLT_MAX);
+    uint64_t i = 0;
+    for (; (i + 8) <= length; i += 8) {
+        __m256 v = _mm256_loadu_ps(x + i);
+        // NaN in v keeps the running value, matching the scalar (v < min) update
+        min_v = _mm256_min_ps(v, min_v);
+        max_v = _mm256_max_ps(v, max_v);
+        __m256d lo = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(v)), k_v);
+        __m256d hi = _mm256_sub_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)), k_v);
+        sum_v = _mm256_add_pd(sum_v, _mm256_add_pd(lo, hi));
+        sumsq_v = _mm256_add_pd(sumsq_v, _mm256_add_pd(_mm256_mul_pd(lo, lo), _mm256_mul_pd(hi, hi)));
+    }
+
+    double sums[4];
+    double sumsqs[4];
+    float mins[8];
+    float maxs[8];
+    _mm256_storeu_pd(sums, sum_v);
+    _mm256_storeu_pd(sumsqs, sumsq_v);
+    _mm256_storeu_ps(mins, min_v);
+    _mm256_storeu_ps(maxs, max_v);
+    double sum = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    double sumsq = (sumsqs[0] + sumsqs[1]) + (sumsqs[2] + sumsqs[3]);
+    float v_min = mins[0];
+    float v_max = maxs[0];
+    for (int j = 1; j < 8; ++j) {
+        if (mins[j] < v_min) {
+            v_min = mins[j];
+        }
+        if (maxs[j] > v_max) {
+            v_max = maxs[j];
+        }
+    }
+
+    for (; i < length; ++i) {
+        float v = x[i];
+        double d = v - k_shift;
+        sum += d;
+        sumsq += d * d;
+        if (v < v_min) {
+            v_min = v;
+        }
+        if (v > v_max) {
+            v_max = v;
+        }
+    }
+
+    struct jls_statistics_s b;
+    b.k = length;
+    b.mean = k_shift + sum / (double) length;
+    b.s = sumsq - (sum * sum) / (double) length;
+    if (b.s < 0.0) {  // rounding in the shifted sums, exact result is >= 0
+        b.s = 0.0;
+    }
+    b.min = v_min;
+    b.max = v_max;
+    jls_statistics_combine(acc, acc, &b);
+}
+
+JLS_TARGET_AVX2
+static void block_f64_avx2(struct jls_statistics_s * acc, const double * x, uint64_t length) {
+    const double k_shift = x[0];
+    const __m256d k_v = _mm256_set1_pd(k_shift);
+    __m256d sum_v = _mm256_setzero_pd();
+    __m256d sumsq_v = _mm256_setzero_pd();
+    __m256d min_v = _mm256_set1_pd(DBL_MAX);
+    __m256d max_v = _mm256_set1_pd(-DBL_MAX);
+    uint64_t i = 0;
+    for (; (i + 4) <= length; i += 4) {
+        __m256d v = _mm256_loadu_pd(x + i);
+        min_v = _mm256_min_pd(v, min_v);
+        max_v = _mm256_max_pd(v, max_v);
+        __m256d d = _mm256_sub_pd(v, k_v);
+        sum_v = _mm256_add_pd(sum_v, d);
+        sumsq_v = _mm256_add_pd(sumsq_v, _mm256_mul_pd(d, d));
+    }
+
+    double sums[4];
+    double sumsqs[4];
+    double mins[4];
+    double maxs[4];
+    _mm256_storeu_pd(sums, sum_v);
+    _mm256_storeu_pd(sumsqs, sumsq_v);
+    _mm256_storeu_pd(mins, min_v);
+    _mm256_storeu_pd(maxs, max_v);
+    double sum = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    double sumsq = (sumsqs[0] + sumsqs[1]) + (sumsqs[2] + sumsqs[3]);
+    double v_min = mins[0];
+    double v_max = maxs[0];
+    for (int j = 1; j < 4; ++j) {
+        if (mins[j] < v_min) {
+            v_min = mins[j];
+        }
+        if (maxs[j] > v_max) {
+            v_max = maxs[j];
+        }
+    }
+
+    for (; i < length; ++i) {
+        double v = x[i];
+        double d = v - k_shift;
+        sum += d;
+        sumsq += d * d;
+        if (v < v_min) {
+            v_min = v;
+        }
+        if (v > v_max) {
+            v_max = v;
+        }
+    }
+
+    struct jls_statistics_s b;
+    b.k = length;
+    b.mean = k_shift + sum / (double) length;
+    b.s = sumsq - (sum * sum) / (double) length;
+    if (b.s < 0.0) {
+        b.s = 0.0;
+    }
+    b.min = v_min;
+    b.max = v_max;
+    jls_statistics_combine(acc, acc, &b);
+}
+
+JLS_TARGET_AVX2
+static void jls_statistics_compute_f32_avx2(struct jls_statistics_s * s, const float * x, uint64_t length) {
+    jls_statistics_reset(s);
+    if (length <= 0) {
+        return;
+    }
+    uint64_t i = 0;
+    uint64_t n;
+    while ((n = length - i) >= TAIL_MIN) {
+        if (n > BLOCK) {
+            n = BLOCK;
+        }
+        block_f32_avx2(s, x + i, n);
+        i += n;
+    }
+    for (; i < length; ++i) {
+        jls_statistics_add(s, x[i]);
+    }
+}
+
+JLS_TARGET_AVX2
+static void jls_statistics_compute_f64_avx2(struct jls_statistics_s * s, const double * x, uint64_t length) {
+    jls_statistics_reset(s);
+    if (length <= 0) {
+        return;
+    }
+    uint64_t i = 0;
+    uint64_t n;
+    while ((n = length - i) >= TAIL_MIN) {
+        if (n > BLOCK) {
+            n = BLOCK;
+        }
+        block_f64_avx2(s, x + i, n);
+        i += n;
+    }
+    for (; i < length; ++i) {
+        jls_statistics_add(s, x[i]);
+    }
+}
+
+JLS_TARGET_AVX512
+static void block_f32_avx512(struct jls_statistics_s * acc, const float * x, uint64_t length) {
+    const double k_shift = (double) x[0];
+    const __m512d k_v = _mm512_set1_pd(k_shift);
+    __m512d sum_v = _mm512_setzero_pd();
+    __m512d sumsq_v = _mm512_setzero_pd();
+    __m512 min_v = _mm512_set1_ps(FLT_MAX);
+    __m512 max_v = _mm512_set1_ps(-FLT_MAX);
+    uint64_t i = 0;
+    for (; (i + 16) <= length; i += 16) {
+        __m512 v = _mm512_loadu_ps(x + i);
+        min_v = _mm512_min_ps(v, min_v);
+        max_v = _mm512_max_ps(v, max_v);
+        __m512d lo = _mm512_sub_pd(_mm512_cvtps_pd(_mm512_castps512_ps256(v)), k_v);
+        // extractf64x4 is AVX-512 F; extractf32x8 would require DQ
+        __m256 v_hi = _mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(v), 1));
+        __m512d hi = _mm512_sub_pd(_mm512_cvtps_pd(v_hi), k_v);
+        sum_v = _mm512_add_pd(sum_v, _mm512_add_pd(lo, hi));
+        sumsq_v = _mm512_add_pd(sumsq_v, _mm512_add_pd(_mm512_mul_pd(lo, lo), _mm512_mul_pd(hi, hi)));
+    }
+
+    double sum = _mm512_reduce_add_pd(sum_v);
+    double sumsq = _mm512_reduce_add_pd(sumsq_v);
+    float v_min = _mm512_reduce_min_ps(min_v);
+    float v_max = _mm512_reduce_max_ps(max_v);
+
+    for (; i < length; ++i) {
+        float v = x[i];
+        double d = v - k_shift;
+        sum += d;
+        sumsq += d * d;
+        if (v < v_min) {
+            v_min = v;
+        }
+        if (v > v_max) {
+            v_max = v;
+        }
+    }
+
+    struct jls_statistics_s b;
+    b.k = length;
+    b.mean = k_shift + sum / (double) length;
+    b.s = sumsq - (sum * sum) / (double) length;
+    if (b.s < 0.0) {
+        b.s = 0.0;
+    }
+    b.min = v_min;
+    b.max = v_max;
+    jls_statistics_combine(acc, acc, &b);
+}
+
+JLS_TARGET_AVX512
+static void block_f64_avx512(struct jls_statistics_s * acc, const double * x, uint64_t length) {
+    const double k_shift = x[0];
+    const __m512d k_v = _mm512_set1_pd(k_shift);
+    __m512d sum_v = _mm512_setzero_pd();
+    __m512d sumsq_v = _mm512_setzero_pd();
+    __m512d min_v = _mm512_set1_pd(DBL_MAX);
+    __m512d max_v = _mm512_set1_pd(-DBL_MAX);
+    uint64_t i = 0;
+    for (; (i + 8) <= length; i += 8) {
+        __m512d v = _mm512_loadu_pd(x + i);
+        min_v = _mm512_min_pd(v, min_v);
+        max_v = _mm512_max_pd(v, max_v);
+        __m512d d = _mm512_sub_pd(v, k_v);
+        sum_v = _mm512_add_pd(sum_v, d);
+        sumsq_v = _mm512_add_pd(sumsq_v, _mm512_mul_pd(d, d));
+    }
+
+    double sum = _mm512_reduce_add_pd(sum_v);
+    double sumsq = _mm512_reduce_add_pd(sumsq_v);
+    double v_min = _mm512_reduce_min_pd(min_v);
+    double v_max = _mm512_reduce_max_pd(max_v);
+
+    for (; i < length; ++i) {
+        double v = x[i];
+        double d = v - k_shift;
+        sum += d;
+        sumsq += d * d;
+        if (v < v_min) {
+            v_min = v;
+        }
+        if (v > v_max) {
+            v_max = v;
+        }
+    }
+
+    struct jls_statistics_s b;
+    b.k = length;
+    b.mean = k_shift + sum / (double) length;
+    b.s = sumsq - (sum * sum) / (double) length;
+    if (b.s < 0.0) {
+        b.s = 0.0;
+    }
+    b.min = v_min;
+    b.max = v_max;
+    jls_statistics_combine(acc, acc, &b);
+}
+
+JLS_TARGET_AVX512
+static void jls_statistics_compute_f32_avx512(struct jls_statistics_s * s, const float * x, uint64_t length) {
+    jls_statistics_reset(s);
+    if (length <= 0) {
+        return;
+    }
+    uint64_t i = 0;
+    uint64_t n;
+    while ((n = length - i) >= TAIL_MIN) {
+        if (n > BLOCK) {
+            n = BLOCK;
+        }
+        block_f32_avx512(s, x + i, n);
+        i += n;
+    }
+    for (; i < length; ++i) {
+        jls_statistics_add(s, x[i]);
+    }
+}
+
+JLS_TARGET_AVX512
+static void jls_statistics_compute_f64_avx512(struct jls_statistics_s * s, const double * x, uint64_t length) {
+    jls_statistics_reset(s);
+    if (length <= 0) {
+        return;
+    }
+    uint64_t i = 0;
+    uint64_t n;
+    while ((n = length - i) >= TAIL_MIN) {
+        if (n > BLOCK) {
+            n = BLOCK;
+        }
+        block_f64_avx512(s, x + i, n);
+        i += n;
+    }
+    for (; i < length; ++i) {
+        jls_statistics_add(s, x[i]);
+    }
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2022-2025 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * x86-64 statistics kernel dispatch.  AVX2 and AVX-512 are optional,
+ * so compile the scalar, SSE2, AVX2, and AVX-512 variants and bind the
+ * widest one the CPU supports once at first use, like crc32c.c on
+ * aarch64.  jls_simd_level() honors the JLS_SIMD_LEVEL environment
+ * variable so jls_bench can quantify each variant.
+ */
+
+#include "jls/simd.h"
+
+#define jls_statistics_compute_f32 jls_statistics_compute_f32_sw
+#define jls_statistics_compute_f64 jls_statistics_compute_f64_sw
+#include "statistics_sw.c"
+#undef jls_statistics_compute_f32
+#undef jls_statistics_compute_f64
+
+#define jls_statistics_compute_f32 jls_statistics_compute_f32_sse2
+#define jls_statistics_compute_f64 jls_statistics_compute_f64_sse2
+#include "statistics_intel_sse.c"
+#undef jls_statistics_compute_f32
+#undef jls_statistics_compute_f64
+
+#include "statistics_intel_avx.c"
+
+// Lazily resolved; the duplicate-initialization race is benign since
+// every thread resolves to the same pointers and pointer stores are
+// single-copy atomic on x86-64.
+static void (* volatile stats_f32_fn)(struct jls_statistics_s *, const float *, uint64_t);
+static void (* volatile stats_f64_fn)(struct jls_statistics_s *, const double *, uint64_t);
+
+static void statistics_resolve(void) {
+    switch (jls_simd_level()) {
+        case JLS_SIMD_LEVEL_AVX512:
+            stats_f32_fn = jls_statistics_compute_f32_avx512;
+            stats_f64_fn = jls_statistics_compute_f64_avx512;
+            break;
+        case JLS_SIMD_LEVEL_AVX2:
+            stats_f32_fn = jls_statistics_compute_f32_avx2;
+            stats_f64_fn = jls_statistics_compute_f64_avx2;
+            break;
+        case JLS_SIMD_LEVEL_SW:
+            stats_f32_fn = jls_statistics_compute_f32_sw;
+            stats_f64_fn = jls_statistics_compute_f64_sw;
+            break;
+        default:
+            stats_f32_fn = jls_statistics_compute_f32_sse2;
+            stats_f64_fn = jls_statistics_compute_f64_sse2;
+            break;
+    }
+}
+
+void jls_statistics_compute_f32(struct jls_statistics_s * s, const float * x, uint64_t length) {
+    void (*fn)(struct jls_statistics_s *, const float *, uint64_t) = stats_f32_fn;
+    if (!fn) {
+        statistics_resolve();
+        fn = stats_f32_fn;
+    }
+    fn(s, x, length);
+}
+
+void jls_statistics_compute_f64(struct jls_statistics_s * s, const double * x, uint64_t length) {
+    void (*fn)(struct jls_statistics_s *, const double *, uint64_t) = stats_f64_fn;
+    if (!fn) {
+        statistics_resolve();
+        fn = stats_f64_fn;
+    }
+    fn(s, x, length);
+}
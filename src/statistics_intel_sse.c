@@ -0,0 +1,191 @@
+/*
+ * Copyright 2022 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/statistics.h"
+#include <emmintrin.h>
+#include <float.h>
+
+/*
+ * One-pass accumulation: process the data in blocks.  Within a block,
+ * accumulate the sum and sum of squares of (x - K) where K is the first
+ * block sample, which keeps the squared terms small and well-conditioned.
+ * Convert each block to mean/s form and merge with the existing
+ * jls_statistics_combine() math, so the result matches the two-pass
+ * scalar reference to near machine precision while reading the sample
+ * data only once.
+ */
+
+#define BLOCK (256)     // samples per block, bounds the shifted-sum magnitude
+#define TAIL_MIN (64)   // below this, the scalar accumulator wins
+
+
+static void block_f32(struct jls_statistics_s * acc, const float * x, uint64_t length) {
+    const double k_shift = (double) x[0];
+    const __m128d k_v = _mm_set1_pd(k_shift);
+    __m128d sum_v = _mm_setzero_pd();
+    __m128d sumsq_v = _mm_setzero_pd();
+    __m128 min_v = _mm_set1_ps(FLT_MAX);
+    __m128 max_v = _mm_set1_ps(-FLT_MAX);
+    uint64_t i = 0;
+    for (; (i + 4) <= length; i += 4) {
+        __m128 v = _mm_loadu_ps(x + i);
+        // NaN in v keeps the running value, matching the scalar (v < min) update
+        min_v = _mm_min_ps(v, min_v);
+        max_v = _mm_max_ps(v, max_v);
+        __m128d lo = _mm_sub_pd(_mm_cvtps_pd(v), k_v);
+        __m128d hi = _mm_sub_pd(_mm_cvtps_pd(_mm_movehl_ps(v, v)), k_v);
+        sum_v = _mm_add_pd(sum_v, _mm_add_pd(lo, hi));
+        sumsq_v = _mm_add_pd(sumsq_v, _mm_add_pd(_mm_mul_pd(lo, lo), _mm_mul_pd(hi, hi)));
+    }
+
+    double sums[2];
+    double sumsqs[2];
+    float mins[4];
+    float maxs[4];
+    _mm_storeu_pd(sums, sum_v);
+    _mm_storeu_pd(sumsqs, sumsq_v);
+    _mm_storeu_ps(mins, min_v);
+    _mm_storeu_ps(maxs, max_v);
+    double sum = sums[0] + sums[1];
+    double sumsq = sumsqs[0] + sumsqs[1];
+    float v_min = mins[0];
+    float v_max = maxs[0];
+    for (int j = 1; j < 4; ++j) {
+        if (mins[j] < v_min) {
+            v_min = mins[j];
+        }
+        if (maxs[j] > v_max) {
+            v_max = maxs[j];
+        }
+    }
+
+    for (; i < length; ++i) {
+        float v = x[i];
+        double d = v - k_shift;
+        sum += d;
+        sumsq += d * d;
+        if (v < v_min) {
+            v_min = v;
+        }
+        if (v > v_max) {
+            v_max = v;
+        }
+    }
+
+    struct jls_statistics_s b;
+    b.k = length;
+    b.mean = k_shift + sum / (double) length;
+    b.s = sumsq - (sum * sum) / (double) length;
+    if (b.s < 0.0) {  // rounding in the shifted sums, exact result is >= 0
+        b.s = 0.0;
+    }
+    b.min = v_min;
+    b.max = v_max;
+    jls_statistics_combine(acc, acc, &b);
+}
+
+static void block_f64(struct jls_statistics_s * acc, const double * x, uint64_t length) {
+    const double k_shift = x[0];
+    const __m128d k_v = _mm_set1_pd(k_shift);
+    __m128d sum_v = _mm_setzero_pd();
+    __m128d sumsq_v = _mm_setzero_pd();
+    __m128d min_v = _mm_set1_pd(DBL_MAX);
+    __m128d max_v = _mm_set1_pd(-DBL_MAX);
+    uint64_t i = 0;
+    for (; (i + 2) <= length; i += 2) {
+        __m128d v = _mm_loadu_pd(x + i);
+        min_v = _mm_min_pd(v, min_v);
+        max_v = _mm_max_pd(v, max_v);
+        __m128d d = _mm_sub_pd(v, k_v);
+        sum_v = _mm_add_pd(sum_v, d);
+        sumsq_v = _mm_add_pd(sumsq_v, _mm_mul_pd(d, d));
+    }
+
+    double sums[2];
+    double sumsqs[2];
+    double mins[2];
+    double maxs[2];
+    _mm_storeu_pd(sums, sum_v);
+    _mm_storeu_pd(sumsqs, sumsq_v);
+    _mm_storeu_pd(mins, min_v);
+    _mm_storeu_pd(maxs, max_v);
+    double sum = sums[0] + sums[1];
+    double sumsq = sumsqs[0] + sumsqs[1];
+    double v_min = (mins[1] < mins[0]) ? mins[1] : mins[0];
+    double v_max = (maxs[1] > maxs[0]) ? maxs[1] : maxs[0];
+
+    for (; i < length; ++i) {
+        double v = x[i];
+        double d = v - k_shift;
+        sum += d;
+        sumsq += d * d;
+        if (v < v_min) {
+            v_min = v;
+        }
+        if (v > v_max) {
+            v_max = v;
+        }
+    }
+
+    struct jls_statistics_s b;
+    b.k = length;
+    b.mean = k_shift + sum / (double) length;
+    b.s = sumsq - (sum * sum) / (double) length;
+    if (b.s < 0.0) {
+        b.s = 0.0;
+    }
+    b.min = v_min;
+    b.max = v_max;
+    jls_statistics_combine(acc, acc, &b);
+}
+
+void jls_statistics_compute_f32(struct jls_statistics_s * s, const float * x, uint64_t length) {
+    jls_statistics_reset(s);
+    if (length <= 0) {
+        return;
+    }
+    uint64_t i = 0;
+    uint64_t n;
+    while ((n = length - i) >= TAIL_MIN) {
+        if (n > BLOCK) {
+            n = BLOCK;
+        }
+        block_f32(s, x + i, n);
+        i += n;
+    }
+    for (; i < length; ++i) {
+        jls_statistics_add(s, x[i]);
+    }
+}
+
+void jls_statistics_compute_f64(struct jls_statistics_s * s, const double * x, uint64_t length) {
+    jls_statistics_reset(s);
+    if (length <= 0) {
+        return;
+    }
+    uint64_t i = 0;
+    uint64_t n;
+    while ((n = length - i) >= TAIL_MIN) {
+        if (n > BLOCK) {
+            n = BLOCK;
+        }
+        block_f64(s, x + i, n);
+        i += n;
+    }
+    for (; i < length; ++i) {
+        jls_statistics_add(s, x[i]);
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2020-2022 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/statistics.h"
+#include <float.h>
+
+
+void jls_statistics_compute_f32(struct jls_statistics_s * s, const float * x, uint64_t length) {
+    if (length <= 0) {
+        jls_statistics_reset(s);
+        return;
+    }
+    float v;
+    double v_mean = 0.0;
+    float v_min = FLT_MAX;
+    float v_max = -FLT_MAX;
+    double v_var = 0.0;
+    for (uint64_t i = 0; i < length; ++i) {
+        v = x[i];
+        v_mean += v;
+        if (v < v_min) {
+            v_min = v;
+        }
+        if (v > v_max) {
+            v_max = v;
+        }
+    }
+    v_mean /= length;
+    double m;
+    for (uint64_t i = 0; i < length; ++i) {
+        m = x[i] - v_mean;
+        v_var += (m * m);
+    }
+    s->k = length;
+    s->mean = v_mean;
+    s->s = v_var;
+    s->min = v_min;
+    s->max = v_max;
+}
+
+void jls_statistics_compute_f64(struct jls_statistics_s * s, const double * x, uint64_t length)  {
+    if (length <= 0) {
+        jls_statistics_reset(s);
+        return;
+    }
+    double v;
+    double v_mean = 0.0;
+    double v_min = DBL_MAX;
+    double v_max = -DBL_MAX;
+    double v_var = 0.0;
+    for (uint64_t i = 0; i < length; ++i) {
+        v = x[i];
+        v_mean += v;
+        if (v < v_min) {
+            v_min = v;
+        }
+        if (v > v_max) {
+            v_max = v;
+        }
+    }
+    v_mean /= length;
+    double m;
+    for (uint64_t i = 0; i < length; ++i) {
+        m = x[i] - v_mean;
+        v_var += (m * m);
+    }
+    s->k = length;
+    s->mean = v_mean;
+    s->s = v_var;
+    s->min = v_min;
+    s->max = v_max;
+}
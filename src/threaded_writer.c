@@ -18,17 +18,28 @@
 #include "jls/msg_ring_buffer.h"
 #include "jls/wr_prv.h"
 #include "jls/backend.h"
+#include "jls/core.h"
+#include "jls/raw.h"
 #include "jls/cdef.h"
 #include "jls/ec.h"
 #include "jls/log.h"
 #include "jls/time.h"
 #include "jls/writer.h"
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 #include <inttypes.h>
 
 
 #define MRB_BUFFER_SIZE (64 * 1024 * 1024)
+#define MRB_OVERFLOW_SEGMENT_SIZE (16 * 1024 * 1024)
+#define SCHED_BURST_BYTES (4 * 1024 * 1024)  // release the shared scheduler after this many message bytes
+#define FSR_COALESCE_BYTES_MAX (256 * 1024)  // bound on FSR appends serviced per dispatch
+
+/// The shared I/O scheduler: writer threads take turns at the disk.
+struct jls_twr_sched_s {
+    struct jls_bkm_s * mutex;
+};
 
 
 struct jls_twr_s {
@@ -39,6 +50,22 @@ struct jls_twr_s {
     volatile uint64_t flush_send_id;
     volatile uint64_t flush_processed_id;
     uint8_t fsr_entry_size_bits[JLS_SIGNAL_COUNT];
+    uint8_t * reserve_msg;               // the outstanding jls_twr_fsr_reserve() message, or NULL
+    uint32_t reserve_sample_count;       // the reserved sample count
+    volatile uint64_t durability_bytes;  // group-commit sync threshold in bytes, 0 to disable
+    volatile uint32_t durability_ms;     // group-commit sync interval in milliseconds, 0 to disable
+    uint64_t durability_acc;             // message bytes processed since the last sync
+    int64_t durability_due;              // the jls_now() time for the next periodic sync
+    volatile uint32_t finalize_ms;       // idle finalization interval in milliseconds, 0 to disable
+    int64_t finalize_due;                // the jls_now() time for the next idle finalization
+    volatile uint8_t preview_en;         // 1 when any summary preview watermark is configured
+    volatile uint32_t preview_interval_min_ms;  // the smallest configured watermark interval
+    int64_t preview_due;                 // the jls_now() time for the next preview scan
+    uint32_t mrb_bytes_max;              // ring buffer high-water mark, see jls_twr_counters()
+    struct jls_twr_sched_s * volatile sched;  // shared I/O scheduler, or NULL
+    volatile uint64_t latency_service[JLS_TWR_LATENCY_BUCKET_COUNT];  // writer thread, per message
+    volatile uint64_t latency_enqueue[JLS_TWR_LATENCY_BUCKET_COUNT];  // producers, per call
+    volatile uint64_t latency_dwell[JLS_TWR_LATENCY_BUCKET_COUNT];    // ring dwell, per message
     struct jls_mrb_s mrb;
     uint8_t mrb_buffer[];
 };
@@ -59,6 +86,28 @@ struct msg_header_fsr_omit_s {
     int32_t enable;
 };
 
+struct msg_header_fsr_scale_s {
+    uint16_t signal_id;
+    double gain;
+    double offset;
+};
+
+struct msg_header_fsr_transform_s {
+    uint16_t signal_id;
+    jls_wr_fsr_transform_fn fn;
+    void * user_data;
+};
+
+struct msg_header_fsr_watermark_s {
+    uint16_t signal_id;
+    uint8_t level;
+    uint32_t interval_ms;
+};
+
+struct msg_header_signal_s {
+    uint16_t signal_id;
+};
+
 struct msg_header_annotation_s {
     uint16_t signal_id;
     int64_t timestamp;
@@ -80,10 +129,15 @@ struct msg_header_s {
         struct msg_header_user_data_s user_data;
         struct msg_header_fsr_s fsr;
         struct msg_header_fsr_omit_s fsr_omit;
+        struct msg_header_fsr_scale_s fsr_scale;
+        struct msg_header_fsr_transform_s fsr_transform;
+        struct msg_header_fsr_watermark_s fsr_watermark;
+        struct msg_header_signal_s signal;
         struct msg_header_annotation_s annotation;
         struct msg_header_utc_s utc;
     } h;
     uint64_t d;
+    int64_t t_enqueue;  // the jls_now() ring commit time, for the dwell histogram
 };
 
 enum message_e {
@@ -92,8 +146,14 @@ enum message_e {
     MSG_USER_DATA,      // hdr.user_data, user_data
     MSG_FSR,            // hdr.fsr_f32, data
     MSG_FSR_OMIT,       // hdr.fsr_omit, no args
+    MSG_FSR_SCALE,      // hdr.fsr_scale, no args
+    MSG_FSR_TRANSFORM,  // hdr.fsr_transform, no args
+    MSG_FSR_WATERMARK,  // hdr.fsr_watermark, no args
     MSG_ANNOTATION,     // hdr.annotation, data
     MSG_UTC,            // hdr.utc, data
+    MSG_ROLLOVER,       // no header data, the next segment path string
+    MSG_SIGNAL_SUSPEND, // hdr.signal, no args
+    MSG_SIGNAL_RESUME,  // hdr.signal, no args
     MSG_ITEM_COUNT,
 };
 
@@ -102,10 +162,134 @@ const char * message_str[] = {
         "flush",
         "user_data",
         "fsr",
+        "fsr_omit",
+        "fsr_scale",
+        "fsr_transform",
+        "fsr_watermark",
         "annotation",
         "utc",
+        "rollover",
+        "signal_suspend",
+        "signal_resume",
 };
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+
+static inline void latency_incr(volatile uint64_t * p) {
+    _InterlockedIncrement64((volatile long long *) p);
+}
+
+#else
+
+static inline void latency_incr(volatile uint64_t * p) {
+    __atomic_add_fetch(p, 1, __ATOMIC_RELAXED);
+}
+
+#endif
+
+// Record into the log2 bucket for the duration, see jls_twr_latency_s.
+static void latency_record_us(volatile uint64_t * histogram, uint64_t duration_us) {
+    uint32_t idx = 0;
+    while (duration_us && (idx < (JLS_TWR_LATENCY_BUCKET_COUNT - 1))) {
+        duration_us >>= 1;
+        ++idx;
+    }
+    latency_incr(histogram + idx);
+}
+
+static inline void latency_record_enqueue(struct jls_twr_s * self, int64_t t_start) {
+    latency_record_us(self->latency_enqueue,
+                      (uint64_t) ((jls_now() - t_start) / JLS_TIME_MICROSECOND));
+}
+
+// Group-commit: sync when enough bytes or time accumulated since the last sync.
+static void durability_update(struct jls_twr_s * self) {
+    uint64_t bytes = self->durability_bytes;
+    uint32_t duration_ms = self->durability_ms;
+    if ((!bytes && !duration_ms) || !self->durability_acc) {
+        return;
+    }
+    int64_t now = jls_now();
+    if ((bytes && (self->durability_acc >= bytes))
+            || (duration_ms && (now >= self->durability_due))) {
+        jls_bkt_process_lock(self->bk);
+        jls_wr_flush(self->wr);
+        jls_bkt_process_unlock(self->bk);
+        self->durability_acc = 0;
+        self->durability_due = now + JLS_TIME_MILLISECOND * (int64_t) duration_ms;
+    }
+}
+
+// Summary preview watermarks: scan for due levels at most once per
+// preview_interval_min_ms, see jls_twr_fsr_summary_watermark().
+static void preview_update(struct jls_twr_s * self) {
+    if (!self->preview_en) {
+        return;
+    }
+    int64_t now = jls_now();
+    if (now < self->preview_due) {
+        return;
+    }
+    jls_bkt_process_lock(self->bk);
+    jls_wr_fsr_summary_preview_process(self->wr);
+    jls_bkt_process_unlock(self->bk);
+    self->preview_due = now + JLS_TIME_MILLISECOND * (int64_t) self->preview_interval_min_ms;
+}
+
+// heads applied per idle finalization pass, see finalize_update()
+#define FINALIZE_HEADS_PER_SLICE (256)
+
+// Idle finalization: trickle deferred head rewrites and the backend
+// flush out between message bursts, so jls_twr_close() performs only
+// the last fraction.  See jls_twr_finalize_set().
+static void finalize_update(struct jls_twr_s * self) {
+    uint32_t interval_ms = self->finalize_ms;
+    if (!interval_ms) {
+        return;
+    }
+    int64_t now = jls_now();
+    if (now < self->finalize_due) {
+        return;
+    }
+    struct jls_core_s * core = (struct jls_core_s *) self->wr;
+    jls_bkt_process_lock(self->bk);
+    jls_core_head_defer_apply_slice(core, FINALIZE_HEADS_PER_SLICE);
+    jls_raw_flush(core->raw);
+    jls_bkt_process_unlock(self->bk);
+    self->finalize_due = jls_now() + JLS_TIME_MILLISECOND * (int64_t) interval_ms;
+}
+
+// Switch to the next segment file, carrying the source and signal
+// definitions over so the sample stream continues uninterrupted.
+static int32_t rollover_process(struct jls_twr_s * self, const char * path) {
+    struct jls_wr_s * wr_next = NULL;
+    struct jls_core_s * core = (struct jls_core_s *) self->wr;
+    int32_t rc = jls_wr_open(&wr_next, path);
+    if (rc) {
+        return rc;  // keep recording into the current segment
+    }
+    for (uint16_t i = 1; !rc && (i < JLS_SOURCE_COUNT); ++i) {
+        if (core->source_info[i].source_def.source_id == i) {
+            rc = jls_wr_source_def(wr_next, &core->source_info[i].source_def);
+        }
+    }
+    for (uint16_t i = 1; !rc && (i < JLS_SIGNAL_COUNT); ++i) {
+        if (core->signal_info[i].signal_def.signal_id == i) {
+            rc = jls_wr_signal_def(wr_next, &core->signal_info[i].signal_def);
+        }
+    }
+    if (rc) {
+        jls_wr_close(wr_next);
+        return rc;
+    }
+    struct jls_wr_s * wr_prev = self->wr;
+    self->wr = wr_next;
+    // finalizing blocks this thread only; producers keep queueing
+    jls_wr_close(wr_prev);
+    return 0;
+}
+
 int32_t jls_twr_run(struct jls_twr_s * self) {
     uint32_t msg_size = 0;
     uint8_t * msg = NULL;
@@ -116,6 +300,8 @@ int32_t jls_twr_run(struct jls_twr_s * self) {
     struct jls_time_counter_s counter_end;
     struct jls_time_counter_s counter_prev = counter_start;
     uint64_t duration_ms;
+    struct jls_twr_sched_s * sched = NULL;  // the shared scheduler held for this burst
+    uint32_t sched_burst = 0;
 
     JLS_LOGI("run start");
     while (!self->quit) {
@@ -126,15 +312,26 @@ int32_t jls_twr_run(struct jls_twr_s * self) {
         }
         jls_bkt_msg_wait(self->bk);
         while (1) {
-            jls_bkt_msg_lock(self->bk);
+            // mrb is lock-free SPSC: this thread is the only consumer
             if (NULL != msg) {
                 jls_mrb_pop(&self->mrb, &msg_size);
+                // wake producers blocked on ring space or a flush barrier
+                jls_bkt_ack_signal(self->bk);
             }
             msg = jls_mrb_peek(&self->mrb, &msg_size);
-            jls_bkt_msg_unlock(self->bk);
             if (!msg) {
+                // the burst ended: write out any coalesced annotations
+                jls_bkt_process_lock(self->bk);
+                jls_wr_annotation_commit(self->wr);
+                jls_bkt_process_unlock(self->bk);
                 break;
             }
+            if ((NULL == sched) && (NULL != self->sched)) {
+                // hold the shared scheduler so this burst writes sequentially
+                sched = self->sched;
+                jls_bkm_lock(sched->mutex);
+                sched_burst = 0;
+            }
             counter_start = jls_time_counter();
             if (((counter_start.value - counter_prev.value) / counter_start.frequency) >= 1) {
                 JLS_LOGD2("twr %" PRIu32 " msgs (%" PRIu32 " of %" PRIu32 " bytes)",
@@ -147,7 +344,17 @@ int32_t jls_twr_run(struct jls_twr_s * self) {
             memcpy(&hdr, msg, sizeof(hdr));
             rc = 0;
 
+            int64_t dwell = jls_now() - hdr.t_enqueue;
+            if (dwell < 0) {  // wall clock stepped backwards
+                dwell = 0;
+            }
+            latency_record_us(self->latency_dwell, (uint64_t) (dwell / JLS_TIME_MICROSECOND));
+
             jls_bkt_process_lock(self->bk);
+            if (MSG_ANNOTATION != hdr.msg_type) {
+                // coalesced annotations precede other chunk types in the file
+                rc = jls_wr_annotation_commit(self->wr);
+            }
             switch (hdr.msg_type) {
                 case MSG_CLOSE:
                     self->quit = 1;
@@ -162,25 +369,83 @@ int32_t jls_twr_run(struct jls_twr_s * self) {
                     break;
                 case MSG_FSR:
                     rc = jls_wr_fsr(self->wr, hdr.h.fsr.signal_id, hdr.h.fsr.sample_id, payload, hdr.h.fsr.sample_count);
+                    // coalesce queued FSR appends into this dispatch.
+                    // Tiny producer blocks (control-loop rates) otherwise
+                    // pay a full lock/commit/bookkeeping cycle per few
+                    // samples.  jls_wr_fsr() accumulates sub-chunk appends
+                    // in the pending data chunk buffer, so back-to-back
+                    // appends are memcpy until a chunk fills.  Bounded so
+                    // the process lock and the shared scheduler stay fair.
+                    while ((0 == rc) && (msg_size < FSR_COALESCE_BYTES_MAX)) {
+                        uint32_t sz = 0;
+                        jls_mrb_pop(&self->mrb, &sz);  // the append just serviced
+                        jls_bkt_ack_signal(self->bk);
+                        msg = jls_mrb_peek(&self->mrb, &sz);
+                        if ((NULL == msg) || (sz < sizeof(hdr))) {
+                            msg = NULL;  // drained: the outer loop re-peeks
+                            break;
+                        }
+                        struct msg_header_s hdr_next;
+                        memcpy(&hdr_next, msg, sizeof(hdr_next));
+                        if (MSG_FSR != hdr_next.msg_type) {
+                            msg = NULL;  // not popped: the outer loop services it
+                            break;
+                        }
+                        hdr = hdr_next;
+                        dwell = jls_now() - hdr.t_enqueue;
+                        latency_record_us(self->latency_dwell,
+                                          (dwell > 0) ? (uint64_t) (dwell / JLS_TIME_MICROSECOND) : 0);
+                        payload = msg + sizeof(hdr);
+                        rc = jls_wr_fsr(self->wr, hdr.h.fsr.signal_id, hdr.h.fsr.sample_id,
+                                        payload, hdr.h.fsr.sample_count);
+                        msg_size += sz;  // durability and scheduler see the whole batch
+                    }
                     break;
                 case MSG_FSR_OMIT:
                     rc = jls_wr_fsr_omit_data(self->wr, hdr.h.fsr_omit.signal_id, hdr.h.fsr_omit.enable);
                     break;
+                case MSG_FSR_SCALE:
+                    rc = jls_wr_fsr_scale(self->wr, hdr.h.fsr_scale.signal_id,
+                                          hdr.h.fsr_scale.gain, hdr.h.fsr_scale.offset);
+                    break;
+                case MSG_FSR_TRANSFORM:
+                    rc = jls_wr_fsr_transform(self->wr, hdr.h.fsr_transform.signal_id,
+                                              hdr.h.fsr_transform.fn, hdr.h.fsr_transform.user_data);
+                    break;
+                case MSG_FSR_WATERMARK:
+                    rc = jls_wr_fsr_summary_watermark(self->wr, hdr.h.fsr_watermark.signal_id,
+                                                      hdr.h.fsr_watermark.level,
+                                                      hdr.h.fsr_watermark.interval_ms);
+                    break;
                 case MSG_ANNOTATION:
-                    rc = jls_wr_annotation(self->wr, hdr.h.annotation.signal_id, hdr.h.annotation.timestamp,
-                                           hdr.h.annotation.y,
-                                           hdr.h.annotation.annotation_type,
-                                           hdr.h.annotation.group_id,
-                                           hdr.h.annotation.storage_type,
-                                           (const uint8_t *) payload, payload_sz);
+                    // coalesce bursts: committed when the ring drains or
+                    // any other message type arrives
+                    rc = jls_wr_annotation_append(self->wr, hdr.h.annotation.signal_id, hdr.h.annotation.timestamp,
+                                                  hdr.h.annotation.y,
+                                                  hdr.h.annotation.annotation_type,
+                                                  hdr.h.annotation.group_id,
+                                                  hdr.h.annotation.storage_type,
+                                                  (const uint8_t *) payload, payload_sz);
                     break;
                 case MSG_UTC:
                     rc = jls_wr_utc(self->wr, hdr.h.utc.signal_id, hdr.h.utc.sample_id, hdr.h.utc.utc);
+                    break;
+                case MSG_ROLLOVER:
+                    rc = rollover_process(self, (const char *) payload);
+                    break;
+                case MSG_SIGNAL_SUSPEND:
+                    rc = jls_wr_fsr_suspend(self->wr, hdr.h.signal.signal_id);
+                    break;
+                case MSG_SIGNAL_RESUME:
+                    rc = jls_wr_fsr_resume(self->wr, hdr.h.signal.signal_id);
+                    break;
                 default:
                     break;
             }
             jls_bkt_process_unlock(self->bk);
             counter_end = jls_time_counter();
+            latency_record_us(self->latency_service,
+                              (1000000 * (counter_end.value - counter_start.value)) / counter_end.frequency);
             duration_ms = (1000 * (counter_end.value - counter_start.value)) / counter_end.frequency;
             if (duration_ms > 250) {
                 JLS_LOGW("thread msg %d:%s took %" PRIu64 " ms",
@@ -195,6 +460,29 @@ int32_t jls_twr_run(struct jls_twr_s * self) {
                          (hdr.msg_type < MSG_ITEM_COUNT) ? message_str[hdr.msg_type] : "unknown",
                          (int) rc, jls_error_code_name(rc));
             }
+            if (hdr.msg_type == MSG_FLUSH) {
+                self->durability_acc = 0;  // the barrier already synced
+                self->durability_due = jls_now() + JLS_TIME_MILLISECOND * (int64_t) self->durability_ms;
+            } else {
+                self->durability_acc += msg_size;
+                durability_update(self);
+            }
+            preview_update(self);
+            if (NULL != sched) {
+                sched_burst += msg_size;
+                if (sched_burst >= SCHED_BURST_BYTES) {
+                    // yield the disk to the other joined writers
+                    jls_bkm_unlock(sched->mutex);
+                    sched = NULL;
+                }
+            }
+        }
+        if (NULL != sched) {
+            jls_bkm_unlock(sched->mutex);
+            sched = NULL;
+        }
+        if (!self->quit) {
+            finalize_update(self);  // the ring is drained: idle time
         }
     }
     JLS_LOGI("run done");
@@ -217,6 +505,19 @@ int32_t jls_twr_open(struct jls_twr_s ** instance, const char * path) {
     self->wr = wr;
     self->flush_send_id = 0;
     self->flush_processed_id = 0;
+    self->reserve_msg = NULL;
+    self->reserve_sample_count = 0;
+    self->durability_bytes = 0;
+    self->durability_ms = 0;
+    self->durability_acc = 0;
+    self->durability_due = 0;
+    self->finalize_ms = 0;
+    self->finalize_due = 0;
+    self->mrb_bytes_max = 0;
+    self->sched = NULL;
+    memset((void *) self->latency_service, 0, sizeof(self->latency_service));
+    memset((void *) self->latency_enqueue, 0, sizeof(self->latency_enqueue));
+    memset((void *) self->latency_dwell, 0, sizeof(self->latency_dwell));
 
     jls_mrb_init(&self->mrb, self->mrb_buffer, MRB_BUFFER_SIZE);
     self->bk = jls_bkt_initialize(self);
@@ -239,20 +540,142 @@ int32_t jls_twr_flags_set(struct jls_twr_s * self, uint32_t flags) {
     return 0;
 }
 
+int32_t jls_twr_latency_get(struct jls_twr_s * self, struct jls_twr_latency_s * latency) {
+    if ((NULL == self) || (NULL == latency)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    for (uint32_t idx = 0; idx < JLS_TWR_LATENCY_BUCKET_COUNT; ++idx) {
+        latency->service[idx] = self->latency_service[idx];
+        latency->enqueue[idx] = self->latency_enqueue[idx];
+        latency->dwell[idx] = self->latency_dwell[idx];
+    }
+    struct jls_core_s * core = (struct jls_core_s *) self->wr;
+    // the writer thread holds the process lock while writing
+    jls_bkt_process_lock(self->bk);
+    struct jls_bkf_s * backend = jls_raw_backend(core->raw);
+    latency->write_duration_us = (NULL != backend)
+            ? (jls_bk_counter_load(&backend->write_duration) / JLS_TIME_MICROSECOND) : 0;
+    latency->flush_duration_us = (NULL != backend)
+            ? (jls_bk_counter_load(&backend->flush_duration) / JLS_TIME_MICROSECOND) : 0;
+    jls_bkt_process_unlock(self->bk);
+    return 0;
+}
+
+int32_t jls_twr_counters(struct jls_twr_s * self, struct jls_twr_counters_s * counters) {
+    if ((NULL == self) || (NULL == counters)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_core_s * core = (struct jls_core_s *) self->wr;
+    // the writer thread holds the process lock while writing
+    jls_bkt_process_lock(self->bk);
+    struct jls_bkf_s * backend = jls_raw_backend(core->raw);
+    counters->seeks = (NULL != backend) ? jls_bk_counter_load(&backend->seek_count) : 0;
+    counters->bytes_written = (NULL != backend) ? jls_bk_counter_load(&backend->bytes_written) : 0;
+    counters->chunks = jls_raw_chunk_wr_count(core->raw);
+    counters->msg_bytes_max = self->mrb_bytes_max;
+    jls_bkt_process_unlock(self->bk);
+    return 0;
+}
+
+int32_t jls_twr_overflow_set(struct jls_twr_s * self, uint64_t bytes_max) {
+    if (NULL == self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (bytes_max > UINT32_MAX) {
+        bytes_max = UINT32_MAX;
+    }
+    // msg_lock serializes with the producer-side jls_mrb_alloc() calls
+    jls_bkt_msg_lock(self->bk);
+    jls_mrb_overflow_set(&self->mrb, MRB_OVERFLOW_SEGMENT_SIZE, (uint32_t) bytes_max);
+    jls_bkt_msg_unlock(self->bk);
+    return 0;
+}
+
+int32_t jls_twr_sched_open(struct jls_twr_sched_s ** instance) {
+    if (NULL == instance) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_twr_sched_s * self = calloc(1, sizeof(struct jls_twr_sched_s));
+    if (NULL == self) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    self->mutex = jls_bkm_initialize();
+    if (NULL == self->mutex) {
+        free(self);
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    *instance = self;
+    return 0;
+}
+
+int32_t jls_twr_sched_close(struct jls_twr_sched_s * self) {
+    if (NULL == self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    jls_bkm_finalize(self->mutex);
+    free(self);
+    return 0;
+}
+
+int32_t jls_twr_sched_join(struct jls_twr_s * self, struct jls_twr_sched_s * sched) {
+    if (NULL == self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    // the writer thread keeps its own pointer for the burst in progress,
+    // so changing this mid-burst is safe
+    self->sched = sched;
+    return 0;
+}
+
+int32_t jls_twr_durability_set(struct jls_twr_s * self, uint64_t bytes, uint32_t duration_ms) {
+    if (NULL == self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    self->durability_due = jls_now() + JLS_TIME_MILLISECOND * (int64_t) duration_ms;
+    self->durability_bytes = bytes;
+    self->durability_ms = duration_ms;
+    return 0;
+}
+
+int32_t jls_twr_finalize_set(struct jls_twr_s * self, uint32_t interval_ms) {
+    if (NULL == self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    self->finalize_due = jls_now() + JLS_TIME_MILLISECOND * (int64_t) interval_ms;
+    self->finalize_ms = interval_ms;
+    return 0;
+}
+
 static int32_t msg_send_inner(struct jls_twr_s * self, const struct msg_header_s * hdr, const uint8_t * payload, uint32_t payload_size) {
     uint32_t sz = sizeof(*hdr) + payload_size;
+    // msg_lock serializes producers; the consumer runs lock-free
     jls_bkt_msg_lock(self->bk);
+    if (NULL != self->reserve_msg) {
+        // a jls_twr_fsr_reserve() is outstanding; only one uncommitted
+        // ring allocation can exist at a time.
+        jls_bkt_msg_unlock(self->bk);
+        return JLS_ERROR_BUSY;
+    }
     uint8_t *msg = jls_mrb_alloc(&self->mrb, sz);
     if (msg) {
         memcpy(msg, hdr, sizeof(*hdr));
         if (payload_size) {
             memcpy(msg + sizeof(*hdr), payload, payload_size);
         }
+        int64_t t_enqueue = jls_now();
+        // memcpy: the ring does not guarantee header alignment
+        memcpy(msg + offsetof(struct msg_header_s, t_enqueue), &t_enqueue, sizeof(t_enqueue));
+        jls_mrb_commit(&self->mrb);
+        uint32_t used = jls_mrb_used_bytes(&self->mrb);
+        if (used > self->mrb_bytes_max) {
+            self->mrb_bytes_max = used;
+        }
         jls_bkt_msg_unlock(self->bk);
         jls_bkt_msg_signal(self->bk);
         return 0;
     } else {
         jls_bkt_msg_unlock(self->bk);
+        jls_bkt_msg_signal(self->bk);  // wake the consumer to drain
         return JLS_ERROR_BUSY;
     }
 }
@@ -260,13 +683,16 @@ static int32_t msg_send_inner(struct jls_twr_s * self, const struct msg_header_s
 static int32_t msg_send(struct jls_twr_s * self, const struct msg_header_s * hdr, const uint8_t * payload, uint32_t payload_size) {
     int64_t t_start = jls_now();
     int64_t t_stop = t_start + JLS_TIME_MILLISECOND * (int64_t) JLS_BK_MSG_WRITE_TIMEOUT_MS;
+    int32_t rc = JLS_ERROR_BUSY;
     while (jls_now() <= t_stop) {
         if (0 == msg_send_inner(self, hdr, payload, payload_size)) {
-            return 0;
+            rc = 0;
+            break;
         }
-        jls_bkt_sleep_ms(5);
+        jls_bkt_ack_wait(self->bk, 5);  // wakes as soon as the consumer pops
     }
-    return JLS_ERROR_BUSY;
+    latency_record_enqueue(self, t_start);
+    return rc;
 }
 
 int32_t jls_twr_flush(struct jls_twr_s * self) {
@@ -282,7 +708,7 @@ int32_t jls_twr_flush(struct jls_twr_s * self) {
     int64_t t_start = jls_now();
     int64_t t_stop = t_start + JLS_TIME_MILLISECOND * (int64_t) JLS_BK_FLUSH_TIMEOUT_MS;
     while (self->flush_processed_id < flush_id) {
-        jls_bkt_sleep_ms(10);
+        jls_bkt_ack_wait(self->bk, 10);  // wakes as soon as the consumer pops
         if (jls_now() >= t_stop) {
             JLS_LOGE("flush timed out");
             return JLS_ERROR_TIMED_OUT;
@@ -291,6 +717,14 @@ int32_t jls_twr_flush(struct jls_twr_s * self) {
     return 0;
 }
 
+int32_t jls_twr_rollover(struct jls_twr_s * self, const char * path) {
+    if ((NULL == self) || (NULL == path) || ('\0' == path[0])) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct msg_header_s hdr = { .msg_type = MSG_ROLLOVER, .d = 0 };
+    return msg_send(self, &hdr, (const uint8_t *) path, (uint32_t) strlen(path) + 1);
+}
+
 int32_t jls_twr_close(struct jls_twr_s * self) {
     if (self) {
         JLS_LOGI("jls_twr_close start");
@@ -302,12 +736,29 @@ int32_t jls_twr_close(struct jls_twr_s * self) {
         // JLS_LOGI("jls_wr_flush done");
         jls_wr_close(self->wr);
         self->wr = NULL;
+        if (self->mrb.overflow_size) {
+            jls_mrb_clear(&self->mrb);  // free any remaining overflow segments
+        }
         free(self);
         JLS_LOGI("jls_wr_close done");
     }
     return 0;
 }
 
+int32_t jls_twr_checkpoint_interval(struct jls_twr_s * self, uint64_t bytes) {
+    jls_bkt_process_lock(self->bk);
+    int32_t rv = jls_wr_checkpoint_interval(self->wr, bytes);
+    jls_bkt_process_unlock(self->bk);
+    return rv;
+}
+
+int32_t jls_twr_mirror_open(struct jls_twr_s * self, const char * path) {
+    jls_bkt_process_lock(self->bk);
+    int32_t rv = jls_wr_mirror_open(self->wr, path);
+    jls_bkt_process_unlock(self->bk);
+    return rv;
+}
+
 int32_t jls_twr_source_def(struct jls_twr_s * self, const struct jls_source_def_s * source) {
     jls_bkt_process_lock(self->bk);
     int32_t rv = jls_wr_source_def(self->wr, source);
@@ -354,7 +805,9 @@ int32_t jls_twr_fsr(struct jls_twr_s * self, uint16_t signal_id,
     uint32_t length = (data_length * self->fsr_entry_size_bits[signal_id] + 7) / 8;
     int32_t rc;
     if (self->flags & JLS_TWR_FLAG_DROP_ON_OVERFLOW) {
+        int64_t t_start = jls_now();
         rc = msg_send_inner(self, &hdr, (const uint8_t *) data, length);
+        latency_record_enqueue(self, t_start);
     } else {
         rc = msg_send(self, &hdr, (const uint8_t *) data, length);
     }
@@ -365,6 +818,131 @@ int32_t jls_twr_fsr(struct jls_twr_s * self, uint16_t signal_id,
     return rc;
 }
 
+int32_t jls_twr_fsr_multi(struct jls_twr_s * self,
+                          const struct jls_twr_fsr_block_s * blocks, uint32_t count) {
+    if ((NULL == self) || ((NULL == blocks) && count)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    uint32_t idx = 0;
+    int64_t t_start = jls_now();
+    int64_t t_stop = t_start + JLS_TIME_MILLISECOND * (int64_t) JLS_BK_MSG_WRITE_TIMEOUT_MS;
+    while (idx < count) {
+        // one lock acquisition and one wakeup for as many blocks as fit
+        jls_bkt_msg_lock(self->bk);
+        if (NULL != self->reserve_msg) {
+            jls_bkt_msg_unlock(self->bk);
+            return JLS_ERROR_BUSY;
+        }
+        while (idx < count) {
+            const struct jls_twr_fsr_block_s * b = blocks + idx;
+            struct msg_header_s hdr = {
+                    .msg_type = MSG_FSR,
+                    .h = {
+                            .fsr = {
+                                    .signal_id = b->signal_id,
+                                    .sample_id = b->sample_id,
+                                    .sample_count = b->data_length,
+                            }
+                    },
+                    .d = 0
+            };
+            uint32_t length = (b->data_length * self->fsr_entry_size_bits[b->signal_id] + 7) / 8;
+            uint8_t * msg = jls_mrb_alloc(&self->mrb, sizeof(hdr) + length);
+            if (NULL == msg) {
+                break;
+            }
+            hdr.t_enqueue = jls_now();
+            memcpy(msg, &hdr, sizeof(hdr));
+            if (length) {
+                memcpy(msg + sizeof(hdr), b->data, length);
+            }
+            jls_mrb_commit(&self->mrb);
+            ++idx;
+        }
+        uint32_t used = jls_mrb_used_bytes(&self->mrb);
+        if (used > self->mrb_bytes_max) {
+            self->mrb_bytes_max = used;
+        }
+        jls_bkt_msg_unlock(self->bk);
+        jls_bkt_msg_signal(self->bk);
+        if (idx < count) {
+            if ((self->flags & JLS_TWR_FLAG_DROP_ON_OVERFLOW) || (jls_now() > t_stop)) {
+                JLS_LOGW("signal %" PRIu16 " drop %" PRIu32 " samples @ %" PRIi64,
+                         blocks[idx].signal_id, blocks[idx].data_length, blocks[idx].sample_id);
+                latency_record_enqueue(self, t_start);  // one sample per batch
+                return JLS_ERROR_BUSY;
+            }
+            jls_bkt_ack_wait(self->bk, 5);  // wakes as soon as the consumer pops
+        }
+    }
+    latency_record_enqueue(self, t_start);  // one sample per batch
+    return 0;
+}
+
+int32_t jls_twr_fsr_reserve(struct jls_twr_s * self, uint16_t signal_id,
+                            uint32_t sample_count, void ** buffer) {
+    if ((NULL == self) || (NULL == buffer) || (0 == sample_count)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    uint32_t length = (sample_count * self->fsr_entry_size_bits[signal_id] + 7) / 8;
+    uint32_t sz = (uint32_t) sizeof(struct msg_header_s) + length;
+    jls_bkt_msg_lock(self->bk);
+    if (NULL != self->reserve_msg) {
+        jls_bkt_msg_unlock(self->bk);
+        return JLS_ERROR_SEQUENCE;  // previous reservation not yet committed
+    }
+    uint8_t * msg = jls_mrb_alloc(&self->mrb, sz);
+    if (NULL == msg) {
+        jls_bkt_msg_unlock(self->bk);
+        jls_bkt_msg_signal(self->bk);  // wake the consumer to drain
+        return JLS_ERROR_BUSY;
+    }
+    self->reserve_msg = msg;
+    self->reserve_sample_count = sample_count;
+    jls_bkt_msg_unlock(self->bk);
+    *buffer = msg + sizeof(struct msg_header_s);
+    return 0;
+}
+
+int32_t jls_twr_fsr_commit(struct jls_twr_s * self, uint16_t signal_id,
+                           int64_t sample_id, uint32_t sample_count) {
+    if (NULL == self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct msg_header_s hdr = {
+            .msg_type = MSG_FSR,
+            .h = {
+                    .fsr = {
+                            .signal_id = signal_id,
+                            .sample_id = sample_id,
+                            .sample_count = sample_count,
+                    }
+            },
+            .d = 0
+    };
+    jls_bkt_msg_lock(self->bk);
+    if (NULL == self->reserve_msg) {
+        jls_bkt_msg_unlock(self->bk);
+        return JLS_ERROR_SEQUENCE;  // no outstanding reservation
+    }
+    if (sample_count > self->reserve_sample_count) {
+        jls_bkt_msg_unlock(self->bk);
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    hdr.t_enqueue = jls_now();
+    memcpy(self->reserve_msg, &hdr, sizeof(hdr));
+    self->reserve_msg = NULL;
+    self->reserve_sample_count = 0;
+    jls_mrb_commit(&self->mrb);
+    uint32_t used = jls_mrb_used_bytes(&self->mrb);
+    if (used > self->mrb_bytes_max) {
+        self->mrb_bytes_max = used;
+    }
+    jls_bkt_msg_unlock(self->bk);
+    jls_bkt_msg_signal(self->bk);
+    return 0;
+}
+
 int32_t jls_twr_fsr_f32(struct jls_twr_s * self, uint16_t signal_id,
                         int64_t sample_id, const float * data, uint32_t data_length) {
     return jls_twr_fsr(self, signal_id, sample_id, data, data_length);
@@ -384,6 +962,87 @@ int32_t jls_twr_fsr_omit_data(struct jls_twr_s * self, uint16_t signal_id, uint3
     return msg_send(self, &hdr, NULL, 0);
 }
 
+int32_t jls_twr_fsr_summary_watermark(struct jls_twr_s * self, uint16_t signal_id,
+                                      uint8_t level, uint32_t interval_ms) {
+    struct msg_header_s hdr = {
+            .msg_type = MSG_FSR_WATERMARK,
+            .h = {
+                    .fsr_watermark = {
+                            .signal_id = signal_id,
+                            .level = level,
+                            .interval_ms = interval_ms,
+                    }
+            },
+            .d = 0
+    };
+    if (interval_ms) {
+        uint32_t interval_min = self->preview_interval_min_ms;
+        if (!self->preview_en || (interval_ms < interval_min)) {
+            self->preview_interval_min_ms = interval_ms;
+        }
+        self->preview_en = 1;
+    }
+    return msg_send(self, &hdr, NULL, 0);
+}
+
+int32_t jls_twr_fsr_scale(struct jls_twr_s * self, uint16_t signal_id,
+                          double gain, double offset) {
+    struct msg_header_s hdr = {
+            .msg_type = MSG_FSR_SCALE,
+            .h = {
+                    .fsr_scale = {
+                            .signal_id = signal_id,
+                            .gain = gain,
+                            .offset = offset,
+                    }
+            },
+            .d = 0
+    };
+    return msg_send(self, &hdr, NULL, 0);
+}
+
+int32_t jls_twr_fsr_transform(struct jls_twr_s * self, uint16_t signal_id,
+                              jls_wr_fsr_transform_fn fn, void * user_data) {
+    struct msg_header_s hdr = {
+            .msg_type = MSG_FSR_TRANSFORM,
+            .h = {
+                    .fsr_transform = {
+                            .signal_id = signal_id,
+                            .fn = fn,
+                            .user_data = user_data,
+                    }
+            },
+            .d = 0
+    };
+    return msg_send(self, &hdr, NULL, 0);
+}
+
+int32_t jls_twr_signal_suspend(struct jls_twr_s * self, uint16_t signal_id) {
+    struct msg_header_s hdr = {
+            .msg_type = MSG_SIGNAL_SUSPEND,
+            .h = {
+                    .signal = {
+                            .signal_id = signal_id,
+                    }
+            },
+            .d = 0
+    };
+    return msg_send(self, &hdr, NULL, 0);
+}
+
+int32_t jls_twr_signal_resume(struct jls_twr_s * self, uint16_t signal_id) {
+    struct msg_header_s hdr = {
+            .msg_type = MSG_SIGNAL_RESUME,
+            .h = {
+                    .signal = {
+                            .signal_id = signal_id,
+                    }
+            },
+            .d = 0
+    };
+    return msg_send(self, &hdr, NULL, 0);
+}
+
 int32_t jls_twr_annotation(struct jls_twr_s * self, uint16_t signal_id, int64_t timestamp,
                            float y,
                            enum jls_annotation_type_e annotation_type,
@@ -20,6 +20,7 @@
 #include "jls/time.h"
 #include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 #include <inttypes.h>
 #include <math.h>
 
@@ -61,6 +62,33 @@ struct jls_tmap_s * jls_tmap_alloc(double sample_rate) {
     return s;
 }
 
+struct jls_tmap_s * jls_tmap_copy(const struct jls_tmap_s * src) {
+    if (NULL == src) {
+        return NULL;
+    }
+    struct jls_tmap_s * s = jls_tmap_alloc(src->sample_rate);
+    if (NULL == s) {
+        return NULL;
+    }
+    if (src->entries_length > s->entries_alloc) {
+        int64_t * p1 = realloc(s->sample_id, src->entries_length * sizeof(int64_t));
+        int64_t * p2 = realloc(s->utc, src->entries_length * sizeof(int64_t));
+        if ((NULL == p1) || (NULL == p2)) {
+            free(p1 ? p1 : s->sample_id);
+            free(p2 ? p2 : s->utc);
+            free(s);
+            return NULL;
+        }
+        s->sample_id = p1;
+        s->utc = p2;
+        s->entries_alloc = src->entries_length;
+    }
+    s->entries_length = src->entries_length;
+    memcpy(s->sample_id, src->sample_id, src->entries_length * sizeof(int64_t));
+    memcpy(s->utc, src->utc, src->entries_length * sizeof(int64_t));
+    return s;
+}
+
 void jls_tmap_free(struct jls_tmap_s * self) {
     if (NULL != self) {
         if (NULL != self->sample_id) {
@@ -145,6 +173,70 @@ int64_t interp_i64(struct jls_tmap_s * self, int64_t x0, int64_t const * x, int6
     return y[low] + k;
 }
 
+static void interp_i64_batch(struct jls_tmap_s * self, int64_t const * x0, int64_t * y0, size_t count,
+                             int64_t const * x, int64_t const * y) {
+    size_t low = self->entries_length;  // invalid, force initial search
+    double slope = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        int64_t xi = x0[i];
+        // reuse the current segment for runs, search only on segment change
+        if ((low >= (self->entries_length - 1))
+                || ((xi < x[low]) && (low != 0))
+                || ((xi >= x[low + 1]) && (low != (self->entries_length - 2)))) {
+            size_t lo = 0;
+            size_t high = self->entries_length;
+            size_t mid;
+            while (lo < high) {
+                mid = (lo + high + 1) / 2;
+                if (xi == x[mid]) {
+                    lo = mid;
+                    break;
+                } else if (xi < x[mid]) {
+                    high = mid - 1;
+                } else {
+                    lo = mid;
+                }
+            }
+            if (lo >= (self->entries_length - 1)) {
+                lo = self->entries_length - 2;
+            }
+            low = lo;
+            slope = ((double) (y[low + 1] - y[low])) / ((double) (x[low + 1] - x[low]));
+        }
+        y0[i] = y[low] + (int64_t) round(((double) (xi - x[low])) * slope);
+    }
+}
+
+int32_t jls_tmap_sample_id_to_timestamp_batch(struct jls_tmap_s * self, int64_t const * sample_ids,
+                                              int64_t * timestamps, size_t count) {
+    if (self->entries_length <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            int32_t rc = jls_tmap_sample_id_to_timestamp(self, sample_ids[i], &timestamps[i]);
+            if (rc) {
+                return rc;
+            }
+        }
+        return 0;
+    }
+    interp_i64_batch(self, sample_ids, timestamps, count, self->sample_id, self->utc);
+    return 0;
+}
+
+int32_t jls_tmap_timestamp_to_sample_id_batch(struct jls_tmap_s * self, int64_t const * timestamps,
+                                              int64_t * sample_ids, size_t count) {
+    if (self->entries_length <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            int32_t rc = jls_tmap_timestamp_to_sample_id(self, timestamps[i], &sample_ids[i]);
+            if (rc) {
+                return rc;
+            }
+        }
+        return 0;
+    }
+    interp_i64_batch(self, timestamps, sample_ids, count, self->utc, self->sample_id);
+    return 0;
+}
+
 int32_t jls_tmap_sample_id_to_timestamp(struct jls_tmap_s * self, int64_t sample_id, int64_t * timestamp) {
     if (self->entries_length == 0) {
         return JLS_ERROR_UNAVAILABLE;
@@ -30,7 +30,7 @@ int32_t jls_track_wr_def(struct jls_core_track_s * track_info) {
     chunk.hdr.item_next = 0;  // update later
     chunk.hdr.item_prev = wr->signal_head.offset;
     chunk.hdr.tag = jls_track_tag_pack(track_info->track_type, JLS_TRACK_CHUNK_DEF);
-    chunk.hdr.rsv0_u8 = 0;
+    chunk.hdr.compression = JLS_COMPRESSION_NONE;
     chunk.hdr.chunk_meta = track_info->parent->signal_def.signal_id;
     chunk.hdr.payload_length = 0;
     chunk.offset = jls_raw_chunk_tell(wr->raw);
@@ -48,7 +48,7 @@ int32_t jls_track_wr_head(struct jls_core_track_s * track_info) {
         chunk->hdr.item_next = 0;  // update later
         chunk->hdr.item_prev = wr->signal_head.offset;
         chunk->hdr.tag = jls_track_tag_pack(track_info->track_type, JLS_TRACK_CHUNK_HEAD);
-        chunk->hdr.rsv0_u8 = 0;
+        chunk->hdr.compression = JLS_COMPRESSION_NONE;
         chunk->hdr.chunk_meta = track_info->parent->signal_def.signal_id;
         chunk->hdr.payload_length = sizeof(track_info->head_offsets);
         chunk->offset = jls_raw_chunk_tell(wr->raw);
@@ -131,6 +131,23 @@ int32_t jls_track_repair_pointers(struct jls_core_track_s * track) {
                 index_chunk = index_chunk_next;
                 summary_chunk = core->chunk_cur;
                 offset = index_chunk.hdr.item_next;  // next index
+                if (!offset) {
+                    // deferred head updates may have been lost: rebuild by forward scan
+                    offset = jls_core_chain_scan_next(core, index_chunk.offset,
+                                                      index_chunk.hdr.tag, index_chunk.hdr.chunk_meta);
+                    if (offset) {
+                        index_chunk.hdr.item_next = offset;
+                        jls_core_update_chunk_header(core, &index_chunk);
+                    }
+                }
+                if (!summary_chunk.hdr.item_next) {
+                    int64_t summary_next = jls_core_chain_scan_next(core, summary_chunk.offset,
+                                                                    summary_chunk.hdr.tag, summary_chunk.hdr.chunk_meta);
+                    if (summary_next) {
+                        summary_chunk.hdr.item_next = summary_next;
+                        jls_core_update_chunk_header(core, &summary_chunk);
+                    }
+                }
                 offset_descend = offset_descend_next;
                 track->index_head[level].offset = index_chunk.offset;
                 track->summary_head[level].offset = summary_chunk.offset;
@@ -175,6 +192,15 @@ int32_t jls_track_repair_pointers(struct jls_core_track_s * track) {
         }
         data_chunk = core->chunk_cur;
         offset = core->chunk_cur.hdr.item_next;
+        if (!offset) {
+            // deferred head updates may have been lost: rebuild by forward scan
+            offset = jls_core_chain_scan_next(core, data_chunk.offset,
+                                              data_chunk.hdr.tag, data_chunk.hdr.chunk_meta);
+            if (offset) {
+                data_chunk.hdr.item_next = offset;
+                jls_core_update_chunk_header(core, &data_chunk);
+            }
+        }
     }
 
     ROE(jls_track_wr_head(track));
@@ -0,0 +1,349 @@
+/*
+ * Copyright 2023 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/verify.h"
+#include "jls/backend.h"
+#include "jls/cdef.h"
+#include "jls/ec.h"
+#include "jls/format.h"
+#include "jls/log.h"
+#include "jls/raw.h"
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define VERIFY_THREADS_DEFAULT  (4)
+#define VERIFY_ERRORS_MAX       (64)    // reported per worker, further errors counted only
+#define HEADER_ALIGN            (8)
+
+
+struct verify_error_s {
+    int64_t offset;
+    uint8_t tag;
+    int32_t ec;
+};
+
+struct verify_worker_s {
+    const char * path;
+    int64_t offset_start;
+    int64_t offset_end;
+    struct verify_error_s errors[VERIFY_ERRORS_MAX];
+    uint32_t error_count;               // total, may exceed VERIFY_ERRORS_MAX
+    int32_t rc;
+    struct jls_bk_thread_s * thread;
+};
+
+static void worker_error(struct verify_worker_s * self, int64_t offset, uint8_t tag, int32_t ec) {
+    if (self->error_count < VERIFY_ERRORS_MAX) {
+        self->errors[self->error_count].offset = offset;
+        self->errors[self->error_count].tag = tag;
+        self->errors[self->error_count].ec = ec;
+    }
+    ++self->error_count;
+}
+
+static void verify_crc_thread(void * user_data) {
+    struct verify_worker_s * self = (struct verify_worker_s *) user_data;
+    struct jls_raw_s * raw = NULL;
+    struct jls_chunk_header_s hdr;
+    uint32_t buf_alloc = 1 << 16;
+    uint8_t * buf = malloc(buf_alloc);
+    if (NULL == buf) {
+        self->rc = JLS_ERROR_NOT_ENOUGH_MEMORY;
+        return;
+    }
+    int32_t rc = jls_raw_open(&raw, self->path, "r");
+    if (rc && (rc != JLS_ERROR_TRUNCATED)) {
+        free(buf);
+        self->rc = rc;
+        return;
+    }
+
+    // find the first chunk at or after this partition's start
+    int64_t offset = jls_raw_chunk_tell(raw);
+    if (self->offset_start > offset) {
+        jls_raw_chunk_seek(raw, self->offset_start);
+        if (jls_raw_chunk_scan(raw)) {
+            jls_raw_close(raw);  // no chunks start in this partition
+            free(buf);
+            return;
+        }
+        offset = jls_raw_chunk_tell(raw);
+    }
+
+    while (offset < self->offset_end) {
+        rc = jls_raw_rd_header(raw, &hdr);
+        if (rc) {
+            worker_error(self, offset, JLS_TAG_INVALID, rc);
+            jls_raw_chunk_seek(raw, offset + HEADER_ALIGN);
+            if (jls_raw_chunk_scan(raw)) {
+                break;
+            }
+            offset = jls_raw_chunk_tell(raw);
+            continue;
+        }
+        rc = jls_raw_rd_payload(raw, buf_alloc, buf);
+        if (JLS_ERROR_TOO_BIG == rc) {
+            uint32_t sz = jls_raw_payload_decoded_length(raw) + 16;
+            uint8_t * b = realloc(buf, sz);
+            if (NULL == b) {
+                self->rc = JLS_ERROR_NOT_ENOUGH_MEMORY;
+                break;
+            }
+            buf = b;
+            buf_alloc = sz;
+            rc = jls_raw_rd_payload(raw, buf_alloc, buf);
+        }
+        if (JLS_ERROR_MESSAGE_INTEGRITY == rc) {
+            worker_error(self, offset, hdr.tag, rc);
+            if (jls_raw_chunk_next(raw)) {
+                break;
+            }
+        } else if (rc) {
+            worker_error(self, offset, hdr.tag, rc);
+            break;
+        }
+        offset = jls_raw_chunk_tell(raw);
+    }
+    jls_raw_close(raw);
+    free(buf);
+}
+
+struct verify_link_s {
+    int64_t offset;
+    int64_t item_next;
+    int64_t item_prev;
+    uint8_t tag;
+};
+
+static bool link_offset_find(struct verify_link_s * links, int64_t count, int64_t offset) {
+    // links are collected in ascending offset order
+    int64_t lo = 0;
+    int64_t hi = count - 1;
+    while (lo <= hi) {
+        int64_t mid = lo + (hi - lo) / 2;
+        if (links[mid].offset == offset) {
+            return true;
+        } else if (links[mid].offset < offset) {
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    return false;
+}
+
+static int32_t verify_links(const char * path, jls_verify_fn fn, void * user_data,
+                            uint32_t * error_count) {
+    struct jls_raw_s * raw = NULL;
+    struct jls_chunk_header_s hdr;
+    int64_t count = 0;
+    int64_t alloc = 4096;
+    struct verify_link_s * links = malloc(alloc * sizeof(struct verify_link_s));
+    if (NULL == links) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    int32_t rc = jls_raw_open(&raw, path, "r");
+    if (rc && (rc != JLS_ERROR_TRUNCATED)) {
+        free(links);
+        return rc;
+    }
+
+    while (0 == jls_raw_rd_header(raw, &hdr)) {
+        if (count >= alloc) {
+            alloc *= 2;
+            struct verify_link_s * b = realloc(links, alloc * sizeof(struct verify_link_s));
+            if (NULL == b) {
+                free(links);
+                jls_raw_close(raw);
+                return JLS_ERROR_NOT_ENOUGH_MEMORY;
+            }
+            links = b;
+        }
+        links[count].offset = jls_raw_chunk_tell(raw);
+        links[count].item_next = (int64_t) hdr.item_next;
+        links[count].item_prev = (int64_t) hdr.item_prev;
+        links[count].tag = hdr.tag;
+        ++count;
+        if (jls_raw_chunk_next(raw)) {
+            break;
+        }
+    }
+    jls_raw_close(raw);
+
+    for (int64_t i = 0; i < count; ++i) {
+        if (links[i].item_next && !link_offset_find(links, count, links[i].item_next)) {
+            ++(*error_count);
+            if (NULL != fn) {
+                fn(user_data, links[i].offset, links[i].tag, JLS_ERROR_NOT_FOUND);
+            }
+        }
+        if (links[i].item_prev && !link_offset_find(links, count, links[i].item_prev)) {
+            ++(*error_count);
+            if (NULL != fn) {
+                fn(user_data, links[i].offset, links[i].tag, JLS_ERROR_NOT_FOUND);
+            }
+        }
+    }
+    free(links);
+    return 0;
+}
+
+#define MANIFEST_BATCH (512)
+
+int32_t jls_manifest(const char * path, jls_manifest_fn fn, void * user_data) {
+    if ((NULL == path) || (NULL == fn)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_raw_s * raw = NULL;
+    struct jls_chunk_header_s hdr;
+    struct jls_manifest_entry_s * entries = malloc(MANIFEST_BATCH * sizeof(struct jls_manifest_entry_s));
+    if (NULL == entries) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    int32_t rc = jls_raw_open(&raw, path, "r");
+    if (rc && (rc != JLS_ERROR_TRUNCATED)) {
+        free(entries);
+        return rc;
+    }
+    rc = 0;
+    struct jls_bkf_s * backend = jls_raw_backend(raw);
+    uint32_t count = 0;
+
+    while (0 == jls_raw_rd_header(raw, &hdr)) {
+        int64_t offset = jls_raw_chunk_tell(raw);
+        struct jls_manifest_entry_s * e = &entries[count];
+        e->offset = offset;
+        e->hdr_crc32c = hdr.crc32;
+        e->payload_crc32c = 0;
+        e->tag = hdr.tag;
+        e->length = sizeof(struct jls_chunk_header_s);
+        if (hdr.payload_length) {
+            uint8_t pad = (uint8_t) ((hdr.payload_length + 4) & (HEADER_ALIGN - 1));
+            if (pad != 0) {
+                pad = HEADER_ALIGN - pad;
+            }
+            // the stored CRC trails the payload: skip the payload itself
+            int64_t crc_offset = offset + sizeof(struct jls_chunk_header_s)
+                    + hdr.payload_length + pad;
+            uint8_t crc_u8[4];
+            if (jls_bk_fseek(backend, crc_offset, SEEK_SET)
+                    || jls_bk_fread(backend, crc_u8, sizeof(crc_u8))) {
+                break;  // truncated mid-chunk: no stable identity past here
+            }
+            e->payload_crc32c = ((uint32_t) crc_u8[0])
+                    | (((uint32_t) crc_u8[1]) << 8)
+                    | (((uint32_t) crc_u8[2]) << 16)
+                    | (((uint32_t) crc_u8[3]) << 24);
+            e->length += hdr.payload_length + pad + 4;
+        }
+        ++count;
+        if (count >= MANIFEST_BATCH) {
+            if (fn(user_data, entries, count)) {
+                rc = JLS_ERROR_ABORTED;
+                break;
+            }
+            count = 0;
+        }
+        // resync the chunk walk after the direct backend reads
+        if (jls_raw_chunk_seek(raw, offset) || jls_raw_chunk_next(raw)) {
+            break;
+        }
+    }
+    if ((0 == rc) && count) {
+        if (fn(user_data, entries, count)) {
+            rc = JLS_ERROR_ABORTED;
+        }
+    }
+    jls_raw_close(raw);
+    free(entries);
+    return rc;
+}
+
+int32_t jls_verify(const char * path, uint32_t threads,
+                   jls_verify_fn fn, void * user_data) {
+    struct jls_raw_s * raw = NULL;
+    struct verify_worker_s workers[JLS_VERIFY_THREADS_MAX];
+    if (NULL == path) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    if (0 == threads) {
+        threads = VERIFY_THREADS_DEFAULT;
+    } else if (threads > JLS_VERIFY_THREADS_MAX) {
+        threads = JLS_VERIFY_THREADS_MAX;
+    }
+
+    int32_t rc = jls_raw_open(&raw, path, "r");
+    if (rc && (rc != JLS_ERROR_TRUNCATED)) {
+        return rc;
+    }
+    int64_t offset_first = jls_raw_chunk_tell(raw);
+    jls_raw_seek_end(raw);
+    int64_t offset_end = jls_raw_chunk_tell(raw);
+    jls_raw_close(raw);
+
+    int64_t span = offset_end - offset_first;
+    if (span <= 0) {
+        return 0;  // no chunks
+    }
+    // small files do not benefit from partitioning
+    while ((threads > 1) && ((span / threads) < (1 << 20))) {
+        --threads;
+    }
+
+    memset(workers, 0, sizeof(workers));
+    int64_t partition = span / threads;
+    partition = (partition + (HEADER_ALIGN - 1)) & ~((int64_t) (HEADER_ALIGN - 1));
+    for (uint32_t i = 0; i < threads; ++i) {
+        workers[i].path = path;
+        workers[i].offset_start = offset_first + i * partition;
+        workers[i].offset_end = ((i + 1) == threads) ? offset_end
+                : (offset_first + (i + 1) * partition);
+        rc = jls_bk_thread_run(&workers[i].thread, verify_crc_thread, &workers[i]);
+        if (rc) {
+            workers[i].thread = NULL;
+            verify_crc_thread(&workers[i]);  // run in this thread instead
+        }
+    }
+
+    uint32_t error_count = 0;
+    for (uint32_t i = 0; i < threads; ++i) {
+        if (NULL != workers[i].thread) {
+            jls_bk_thread_join(workers[i].thread);
+        }
+        if (workers[i].rc && (0 == rc)) {
+            rc = workers[i].rc;
+        }
+        error_count += workers[i].error_count;
+        uint32_t reported = workers[i].error_count;
+        if (reported > VERIFY_ERRORS_MAX) {
+            reported = VERIFY_ERRORS_MAX;
+        }
+        if (NULL != fn) {
+            for (uint32_t k = 0; k < reported; ++k) {
+                fn(user_data, workers[i].errors[k].offset,
+                   workers[i].errors[k].tag, workers[i].errors[k].ec);
+            }
+        }
+    }
+    if (rc) {
+        return rc;
+    }
+
+    ROE(verify_links(path, fn, user_data, &error_count));
+    return error_count ? JLS_ERROR_MESSAGE_INTEGRITY : 0;
+}
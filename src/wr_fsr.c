@@ -18,7 +18,9 @@
 #include "jls/core.h"
 #include "jls/cdef.h"
 #include "jls/datatype.h"
+#include "jls/delta.h"
 #include "jls/wr_prv.h"
+#include "jls/backend.h"
 #include "jls/ec.h"
 #include "jls/log.h"
 #include <inttypes.h>
@@ -47,17 +49,34 @@ static inline uint8_t summary_entry_size(struct jls_core_fsr_s * self) {
 }
 
 int32_t jls_core_fsr_sample_buffer_alloc(struct jls_core_fsr_s * self) {
+    struct jls_core_s * core = self->parent->parent;
     size_t sample_buffer_sz = sizeof(struct jls_payload_header_s) + (sample_size_bits(self) * self->parent->signal_def.samples_per_data) / 8;
-    self->data = malloc(sample_buffer_sz);
+    self->data = jls_core_arena_alloc(core, sample_buffer_sz);
     if (!self->data) {
         jls_fsr_close(self);
         return JLS_ERROR_NOT_ENOUGH_MEMORY;
     }
-    self->data_f64 = malloc(self->parent->signal_def.samples_per_data * sizeof(double));
-    if (!self->data_f64) {
+    if (!self->summarize_int) {
+        self->data_f64 = jls_core_arena_alloc(core, self->parent->signal_def.samples_per_data * sizeof(double));
+        if (!self->data_f64) {
+            jls_fsr_close(self);
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+    }
+    size_t entries_per_data = self->parent->signal_def.samples_per_data / self->parent->signal_def.sample_decimate_factor;
+    self->reduce_entries = jls_core_arena_alloc(core, entries_per_data * JLS_SUMMARY_FSR_COUNT * sizeof(double));
+    if (!self->reduce_entries) {
         jls_fsr_close(self);
         return JLS_ERROR_NOT_ENOUGH_MEMORY;
     }
+    if (self->parallel_en) {
+        self->data_prev = jls_core_arena_alloc(core, sample_buffer_sz);
+        if (!self->data_prev) {
+            jls_fsr_close(self);
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        self->data_prev->header.entry_count = 0;
+    }
     JLS_LOGD1("%d sample_buffer alloc %p", self->parent->signal_def.signal_id, (void *) self->data);
     self->data->header.timestamp = 0;
     self->data->header.entry_count = 0;
@@ -68,14 +87,28 @@ int32_t jls_core_fsr_sample_buffer_alloc(struct jls_core_fsr_s * self) {
 }
 
 void jls_core_fsr_sample_buffer_free(struct jls_core_fsr_s * self) {
+    struct jls_core_s * core = self->parent->parent;
     if (self->data) {
-        free(self->data);
+        jls_core_arena_free(core, self->data);
         self->data = NULL;
     }
+    if (self->data_prev) {
+        jls_core_arena_free(core, self->data_prev);
+        self->data_prev = NULL;
+    }
     if (self->data_f64) {
-        free(self->data_f64);
+        jls_core_arena_free(core, self->data_f64);
         self->data_f64 = NULL;
     }
+    if (self->reduce_entries) {
+        jls_core_arena_free(core, self->reduce_entries);
+        self->reduce_entries = NULL;
+    }
+    if (self->delta_buf) {
+        free(self->delta_buf);
+        self->delta_buf = NULL;
+        self->delta_alloc = 0;
+    }
 }
 
 int32_t jls_core_fsr_summary_level_alloc(struct jls_core_fsr_s * self, uint8_t level) {
@@ -99,7 +132,7 @@ int32_t jls_core_fsr_summary_level_alloc(struct jls_core_fsr_s * self, uint8_t l
     index_sz = ((index_sz + 15) / 16) * 16;
 
     size_t sz = sizeof(struct jls_core_fsr_level_s) + buffer_sz + index_sz;
-    uint8_t * buffer = malloc(sz);
+    uint8_t * buffer = jls_core_arena_alloc(self->parent->parent, sz);
     if (!buffer) {
         return JLS_ERROR_NOT_ENOUGH_MEMORY;
     }
@@ -129,23 +162,85 @@ int32_t jls_core_fsr_summary_level_alloc(struct jls_core_fsr_s * self, uint8_t l
 
 static void summary_free(struct jls_core_fsr_s * self, uint8_t level) {
     if (self->level[level]) {
-        free(self->level[level]);
+        jls_core_arena_free(self->parent->parent, self->level[level]);
         self->level[level] = NULL;
     }
 }
 
 static bool is_mem_const(void * mem, size_t mem_size, uint8_t c) {
     uint8_t * m = (uint8_t *) mem;
-    uint8_t * m_end = m + mem_size;
-    while (m < m_end) {
-        if (*m++ != c) {
-            return false;
+    if (0 == mem_size) {
+        return true;
+    }
+    if (*m != c) {
+        return false;
+    }
+    // all bytes equal c when the buffer matches itself shifted by one
+    // byte; memcmp compares at the platform's full vector width
+    return 0 == memcmp(m, m + 1, mem_size - 1);
+}
+
+/// Is mem a repetition of its first period bytes?
+static bool is_mem_repeat(void * mem, size_t mem_size, size_t period) {
+    uint8_t * m = (uint8_t *) mem;
+    if (mem_size <= period) {
+        return true;
+    }
+    return 0 == memcmp(m, m + period, mem_size - period);
+}
+
+static int32_t summary1_join(struct jls_core_fsr_s * self);
+static int32_t summary1_dispatch(struct jls_core_fsr_s * self, int64_t pos);
+static int32_t summary1_append(struct jls_core_fsr_s * self, uint32_t count);
+
+/**
+ * @brief Delta-encode the staged level 0 payload when it saves space.
+ *
+ * @param self The FSR track instance with delta encoding selected.
+ * @param data_length The staged sample data length in bytes, excluding the header.
+ * @param[inout] payload The payload to write, replaced by the encoded
+ *      staging buffer on success.
+ * @param[inout] payload_length The payload length, updated on success.
+ *
+ * Chunks that do not shrink, or any staging allocation failure, leave
+ * payload unchanged and write RAW, which the per-chunk rsv16 marker
+ * keeps self-describing.
+ */
+static void wr_data_delta(struct jls_core_fsr_s * self, uint32_t data_length,
+                          uint8_t ** payload, uint32_t * payload_length) {
+    uint32_t entry_count = self->data->header.entry_count;
+    uint16_t entry_size_bits = self->data->header.entry_size_bits;
+    if (entry_count < 2) {
+        return;
+    }
+    uint32_t bound = (uint32_t) sizeof(struct jls_payload_header_s)
+            + jls_delta_bound(entry_size_bits, entry_count);
+    if (self->delta_alloc < bound) {
+        uint8_t * b = realloc(self->delta_buf, bound);
+        if (!b) {
+            return;
         }
+        self->delta_buf = b;
+        self->delta_alloc = bound;
+    }
+    int32_t sz = jls_delta_encode((const uint8_t *) self->data->data, entry_count, entry_size_bits,
+                                  self->delta_buf + sizeof(struct jls_payload_header_s),
+                                  data_length - 1);  // only accept a strictly smaller payload
+    if (sz <= 0) {
+        return;
     }
-    return true;
+    struct jls_fsr_data_s * d = (struct jls_fsr_data_s *) self->delta_buf;
+    d->header = self->data->header;
+    d->header.rsv16 = JLS_FSR_DATA_ENCODING_DELTA;
+    *payload = self->delta_buf;
+    *payload_length = (uint32_t) sizeof(struct jls_payload_header_s) + (uint32_t) sz;
 }
 
 static int32_t wr_data(struct jls_core_fsr_s * self) {
+    if (self->parallel_en) {
+        // complete the previous buffer's level-1 reduction before the next chunk write
+        ROE(summary1_join(self));
+    }
     if (!self->data->header.entry_count) {
         return 0;
     }
@@ -155,6 +250,7 @@ static int32_t wr_data(struct jls_core_fsr_s * self) {
     uint32_t data_length = (self->data->header.entry_count * sample_size_bits(self) + 7) / 8;
     uint32_t payload_length = sizeof(struct jls_fsr_data_s) + data_length;
     bool omit_data = (self->write_omit_data > 1);
+    bool const_data = false;
     struct jls_core_track_s * track = &self->parent->tracks[JLS_TRACK_TYPE_FSR];
 
     if (sample_size_bits(self) <= 8) {
@@ -166,7 +262,8 @@ static int32_t wr_data(struct jls_core_fsr_s * self) {
             data_const = (data_const & 0x0f);
             data_const |= (data_const << 4);
         }
-        omit_data = is_mem_const(self->data->data, data_length, data_const);
+        const_data = is_mem_const(self->data->data, data_length, data_const);
+        omit_data = const_data;
     }
 
     // cannot omit first chunk, which stores the sample_id offset.
@@ -174,19 +271,104 @@ static int32_t wr_data(struct jls_core_fsr_s * self) {
 
     uint8_t * p_start = (uint8_t *) self->data;
     int64_t pos = jls_raw_chunk_tell(self->parent->parent->raw);
+    uint64_t cbuf[(sizeof(struct jls_fsr_data_s) + 8 + 7) / 8];
     if (omit_data) {
         pos = 0;
     } else {
-        ROE(jls_core_wr_data(self->parent->parent, self->parent->signal_def.signal_id,
-                             JLS_TRACK_TYPE_FSR, p_start, payload_length));
+        uint32_t sample_bytes = (sample_size_bits(self) + 7) / 8;
+        if (!const_data && (sample_size_bits(self) > 8)) {
+            const_data = is_mem_repeat(self->data->data, data_length, sample_bytes);
+        }
+        if (const_data && !self->ring_chunks && (data_length > sample_bytes)) {
+            // constant run: store the single sample value plus the count
+            struct jls_fsr_data_s * cd = (struct jls_fsr_data_s *) cbuf;
+            cd->header = self->data->header;
+            cd->header.rsv16 = JLS_FSR_DATA_ENCODING_CONST;
+            memcpy(cd->data, self->data->data, sample_bytes);
+            p_start = (uint8_t *) cbuf;
+            payload_length = (uint32_t) (sizeof(struct jls_fsr_data_s) + sample_bytes);
+        } else if (JLS_FSR_DATA_ENCODING_DELTA == self->parent->signal_def.data_encoding) {
+            wr_data_delta(self, data_length, &p_start, &payload_length);
+        }
+        int64_t ring_idx = self->ring_chunks ? (self->ring_data_count - self->ring_chunks) : 0;
+        if (ring_idx >= 1) {  // never recycle the first data chunk: it anchors sample_id_offset
+            ROE(jls_core_fsr_ring_wr_data(self->parent->parent, self->parent->signal_def.signal_id,
+                                          ring_idx, p_start, payload_length, &pos));
+        } else {
+            ROE(jls_core_wr_data(self->parent->parent, self->parent->signal_def.signal_id,
+                                 JLS_TRACK_TYPE_FSR, p_start, payload_length));
+        }
+    }
+    self->ring_data_count += 1;
+    if (self->parallel_en) {
+        ROE(summary1_dispatch(self, pos));
+    } else {
+        ROE(jls_core_fsr_summary1(self, pos));
+        self->data->header.timestamp += self->parent->signal_def.samples_per_data;
+        self->data->header.entry_count = 0;
     }
-    ROE(jls_core_fsr_summary1(self, pos));
-    self->data->header.timestamp += self->parent->signal_def.samples_per_data;
-    self->data->header.entry_count = 0;
     self->write_omit_data = (self->write_omit_data << 1) | (self->write_omit_data & 1);
     return 0;
 }
 
+/**
+ * @brief Write one whole-chunk sample gap as a constant-run marker.
+ *
+ * @param self The FSR track instance with an empty staging buffer and
+ *      the fill pattern staged in buffer_u64.
+ * @return 0 or error code.
+ *
+ * Skipped samples otherwise stream filler through the staging buffer at
+ * full write bandwidth.  A whole-chunk gap needs only the single fill
+ * value plus the count on disk (JLS_FSR_DATA_ENCODING_CONST), and its
+ * level 1 summary entries are known without reduction: all-NaN for
+ * float types, zeros for integer types, matching the filler.  The
+ * bookkeeping mirrors wr_data() + jls_core_fsr_summary1() so the chunk
+ * geometry is identical to the filler path.
+ */
+static int32_t wr_data_gap(struct jls_core_fsr_s * self) {
+    if (self->parallel_en) {
+        ROE(summary1_join(self));
+    }
+    uint8_t sample_bytes = (sample_size_bits(self) + 7) / 8;
+    uint64_t cbuf[(sizeof(struct jls_fsr_data_s) + 8 + 7) / 8];
+    struct jls_fsr_data_s * cd = (struct jls_fsr_data_s *) cbuf;
+    cd->header = self->data->header;
+    cd->header.entry_count = self->data_length;
+    cd->header.rsv16 = JLS_FSR_DATA_ENCODING_CONST;
+    memcpy(cd->data, self->buffer_u64, sample_bytes);
+    int64_t pos = jls_raw_chunk_tell(self->parent->parent->raw);
+    ROE(jls_core_wr_data(self->parent->parent, self->parent->signal_def.signal_id,
+                         JLS_TRACK_TYPE_FSR, (uint8_t *) cbuf,
+                         (uint32_t) (sizeof(struct jls_fsr_data_s) + sample_bytes)));
+    self->ring_data_count += 1;
+
+    struct jls_core_fsr_level_s * dst = self->level[1];
+    if (!dst) {
+        ROE(jls_core_fsr_summary_level_alloc(self, 1));
+        dst = self->level[1];
+    }
+    if (0 == dst->index->header.entry_count) {
+        dst->index->header.timestamp = self->data->header.timestamp;
+        dst->summary->header.timestamp = self->data->header.timestamp;
+    }
+    dst->index->offsets[dst->index->header.entry_count++] = pos;
+
+    uint32_t summaries_per = self->data_length / self->parent->signal_def.sample_decimate_factor;
+    uint8_t basetype = jls_datatype_parse_basetype(self->parent->signal_def.data_type);
+    double v = (JLS_DATATYPE_BASETYPE_FLOAT == basetype) ? NAN : 0.0;
+    double * out = self->reduce_entries;
+    for (uint32_t idx = 0; idx < summaries_per; ++idx, out += JLS_SUMMARY_FSR_COUNT) {
+        out[0] = v;  // mean
+        out[1] = v;  // min
+        out[2] = v;  // max
+        out[3] = v;  // variance
+    }
+    ROE(summary1_append(self, summaries_per));
+    self->data->header.timestamp += self->parent->signal_def.samples_per_data;
+    return 0;
+}
+
 static int32_t wr_index(struct jls_core_fsr_s * self, uint8_t level) {
     if (!self->level[level]) {
         JLS_LOGW("No summary buffer, cannot write index");
@@ -223,6 +405,33 @@ static int32_t wr_summary(struct jls_core_fsr_s * self, uint8_t level) {
 
     dst->index->header.entry_count = 0;
     dst->summary->header.entry_count = 0;
+    dst->preview_entry_count = 0;
+    return 0;
+}
+
+int32_t jls_fsr_summary_preview_wr(struct jls_core_fsr_s * self, uint8_t level) {
+    if (self->suspend_buf) {
+        return 0;  // buffers are snapshotted, nothing accumulating
+    }
+    if ((1 == level) && self->parallel_en) {
+        ROE(summary1_join(self));
+    }
+    struct jls_core_fsr_level_s * dst = self->level[level];
+    if ((NULL == dst) || (dst->summary->header.entry_count == dst->preview_entry_count)) {
+        return 0;  // no completed entries since the last preview or flush
+    }
+    uint32_t entry_count = dst->summary->header.entry_count;
+    struct jls_core_chunk_s chunk;
+    chunk.hdr.item_next = 0;
+    chunk.hdr.item_prev = 0;
+    chunk.hdr.tag = JLS_TAG_SUMMARY_PREVIEW;
+    chunk.hdr.compression = JLS_COMPRESSION_NONE;
+    chunk.hdr.chunk_meta = (uint16_t) (self->parent->signal_def.signal_id | (((uint16_t) level) << 12));
+    chunk.hdr.payload_length = (uint32_t) (sizeof(struct jls_payload_header_s)
+            + ((size_t) entry_count * JLS_SUMMARY_FSR_COUNT * summary_entry_size(self)) / 8);
+    chunk.offset = jls_raw_chunk_tell(self->parent->parent->raw);
+    ROE(jls_raw_wr(self->parent->parent->raw, &chunk.hdr, (const uint8_t *) dst->summary));
+    dst->preview_entry_count = entry_count;
     return 0;
 }
 
@@ -243,19 +452,159 @@ int32_t jls_fsr_open(struct jls_core_fsr_s ** instance, struct jls_core_signal_s
     }
     self->parent = parent;
     self->signal_length = -1;
+    self->rd_next_sample_id = -1;
+    self->data_f64_fn = jls_dt_buffer_to_f64_fn(parent->signal_def.data_type);
+    self->data_f64_scale = jls_dt_f64_scale(parent->signal_def.data_type);
+    uint8_t basetype = jls_datatype_parse_basetype(parent->signal_def.data_type);
+    if (((basetype == JLS_DATATYPE_BASETYPE_INT) || (basetype == JLS_DATATYPE_BASETYPE_UINT))
+            && (jls_datatype_parse_size(parent->signal_def.data_type) <= 16)) {
+        // sums and sums of squares fit int64/uint64 exactly, no f64 staging required
+        self->summarize_int = 1;
+    }
+    const char * env = getenv("JLS_PARALLEL_SUMMARY");
+    if (env && (env[0] != '0')) {
+        self->parallel_en = 1;
+    }
 
     *instance = self;
     return 0;
 }
 
+// Compact suspended-state layout, see jls_core_fsr_suspend():
+// this header, the staged sample bytes, then for each level in
+// level_mask: index header, offsets, summary header, summary data.
+struct fsr_suspend_s {
+    uint32_t data_bytes;    // the staged level 0 sample bytes
+    uint16_t level_mask;    // bit k set when level k state follows
+    uint16_t rsv16;
+    struct jls_payload_header_s data_hdr;
+};
+
+static size_t suspend_index_bytes(struct jls_core_fsr_level_s * b) {
+    return b->index->header.entry_count * sizeof(b->index->offsets[0]);
+}
+
+static size_t suspend_summary_bytes(struct jls_core_fsr_s * self, struct jls_core_fsr_level_s * b) {
+    return ((size_t) b->summary->header.entry_count * JLS_SUMMARY_FSR_COUNT * summary_entry_size(self)) / 8;
+}
+
+int32_t jls_core_fsr_suspend(struct jls_core_fsr_s * self) {
+    if (self->suspend_buf || (NULL == self->data)) {
+        return 0;  // already suspended, or nothing staged yet
+    }
+    if (self->parallel_en) {
+        ROE(summary1_join(self));
+    }
+
+    uint32_t data_bytes = (self->data->header.entry_count * sample_size_bits(self) + 7) / 8;
+    size_t sz = sizeof(struct fsr_suspend_s) + data_bytes;
+    uint16_t level_mask = 0;
+    for (uint8_t lvl = 1; lvl < JLS_SUMMARY_LEVEL_COUNT; ++lvl) {
+        struct jls_core_fsr_level_s * b = self->level[lvl];
+        if (b) {
+            level_mask |= (uint16_t) (1 << lvl);
+            sz += 2 * sizeof(struct jls_payload_header_s)
+                    + suspend_index_bytes(b) + suspend_summary_bytes(self, b);
+        }
+    }
+
+    uint8_t * buf = malloc(sz);
+    if (!buf) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    struct fsr_suspend_s * hdr = (struct fsr_suspend_s *) buf;
+    hdr->data_bytes = data_bytes;
+    hdr->level_mask = level_mask;
+    hdr->rsv16 = 0;
+    hdr->data_hdr = self->data->header;
+    uint8_t * p = buf + sizeof(*hdr);
+    memcpy(p, self->data->data, data_bytes);
+    p += data_bytes;
+    for (uint8_t lvl = 1; lvl < JLS_SUMMARY_LEVEL_COUNT; ++lvl) {
+        struct jls_core_fsr_level_s * b = self->level[lvl];
+        if (!b) {
+            continue;
+        }
+        memcpy(p, &b->index->header, sizeof(struct jls_payload_header_s));
+        p += sizeof(struct jls_payload_header_s);
+        memcpy(p, b->index->offsets, suspend_index_bytes(b));
+        p += suspend_index_bytes(b);
+        memcpy(p, &b->summary->header, sizeof(struct jls_payload_header_s));
+        p += sizeof(struct jls_payload_header_s);
+        memcpy(p, ((uint8_t *) b->summary) + sizeof(struct jls_payload_header_s),
+               suspend_summary_bytes(self, b));
+        p += suspend_summary_bytes(self, b);
+    }
+
+    JLS_LOGD1("%d suspend: %zu snapshot bytes", (int) self->parent->signal_def.signal_id, sz);
+    jls_core_fsr_sample_buffer_free(self);
+    for (uint8_t lvl = 1; lvl < JLS_SUMMARY_LEVEL_COUNT; ++lvl) {
+        summary_free(self, lvl);
+    }
+    self->suspend_buf = buf;
+    return 0;
+}
+
+int32_t jls_core_fsr_resume(struct jls_core_fsr_s * self) {
+    if (NULL == self->suspend_buf) {
+        return 0;
+    }
+    uint8_t * buf = self->suspend_buf;
+    self->suspend_buf = NULL;
+    struct fsr_suspend_s * hdr = (struct fsr_suspend_s *) buf;
+    int32_t rc = jls_core_fsr_sample_buffer_alloc(self);
+    if (rc) {
+        free(buf);  // sample_buffer_alloc already closed self
+        return rc;
+    }
+    self->data->header = hdr->data_hdr;
+    uint8_t * p = buf + sizeof(*hdr);
+    memcpy(self->data->data, p, hdr->data_bytes);
+    p += hdr->data_bytes;
+    for (uint8_t lvl = 1; lvl < JLS_SUMMARY_LEVEL_COUNT; ++lvl) {
+        if (!(hdr->level_mask & (1 << lvl))) {
+            continue;
+        }
+        rc = jls_core_fsr_summary_level_alloc(self, lvl);
+        if (rc) {
+            free(buf);
+            return rc;
+        }
+        struct jls_core_fsr_level_s * b = self->level[lvl];
+        memcpy(&b->index->header, p, sizeof(struct jls_payload_header_s));
+        p += sizeof(struct jls_payload_header_s);
+        memcpy(b->index->offsets, p, suspend_index_bytes(b));
+        p += suspend_index_bytes(b);
+        memcpy(&b->summary->header, p, sizeof(struct jls_payload_header_s));
+        p += sizeof(struct jls_payload_header_s);
+        memcpy(((uint8_t *) b->summary) + sizeof(struct jls_payload_header_s), p,
+               suspend_summary_bytes(self, b));
+        p += suspend_summary_bytes(self, b);
+    }
+    free(buf);
+    return 0;
+}
+
 int32_t jls_fsr_close(struct jls_core_fsr_s * self) {
     int32_t rc;
     if (self) {
+        if (self->suspend_buf) {
+            rc = jls_core_fsr_resume(self);  // restore so the final flush writes the pending state
+            if (rc) {
+                // only fails on allocation, which already released this instance
+                JLS_LOGE("resume on close returned %" PRIi32, rc);
+                return 0;
+            }
+        }
         if (self->data) {
             rc = wr_data(self);  // write remaining sample data
             if (rc) {
                 JLS_LOGE("wr_data returned %" PRIi32, rc);
             }
+            rc = summary1_join(self);  // complete any in-flight level-1 reduction
+            if (rc) {
+                JLS_LOGE("summary1_join returned %" PRIi32, rc);
+            }
             JLS_LOGD1("%d sample_buffer free %p", (int) self->parent->signal_def.signal_id, (void *) self->data);
             jls_core_fsr_sample_buffer_free(self);
         }
@@ -266,6 +615,9 @@ int32_t jls_fsr_close(struct jls_core_fsr_s * self) {
                 JLS_LOGE("summary_close(%d) returned %" PRIi32, (int) i, rc);
             }
         }
+        free(self->inject_entries);
+        free(self->mirror_entries);
+        free(self->transform_buf);
         free(self);
     }
     return 0;
@@ -291,47 +643,36 @@ static void summary_entry_add(struct jls_core_fsr_s * self, uint8_t level,
     ++dst->summary->header.entry_count;
 }
 
-#define SUMMARYN_BODY_TEMPLATE()                                                            \
+// The summaryN reduction kernels are defined with the summary_reduce
+// kernels below, sharing the same per-architecture selection.
+static uint32_t summaryn_reduce_f32(const float * src, uint32_t length,
+                                    double * v_sum, double * v_min, double * v_max);
+static double summaryn_reduce_var_f32(const float * src, uint32_t length, double v_mean);
+static uint32_t summaryn_reduce_f64(const double * src, uint32_t length,
+                                    double * v_sum, double * v_min, double * v_max);
+static double summaryn_reduce_var_f64(const double * src, uint32_t length, double v_mean);
+
+#define SUMMARYN_BODY_TEMPLATE(suffix)                                                      \
     for (uint32_t idx = 0; idx < summaries_per; ++idx) {                                    \
-        uint32_t sample_idx = idx * self->parent->signal_def.summary_decimate_factor;                      \
-        uint32_t count = 0;                                                                 \
-        double v;                                                                           \
-        double v_mean = 0.0;                                                                \
-        double v_min = DBL_MAX;                                                             \
-        double v_max = -DBL_MAX;                                                            \
-        double v_var = 0.0;                                                                 \
-        for (uint32_t sample = 0; sample < self->parent->signal_def.summary_decimate_factor; ++sample) {   \
-            uint32_t offset = sample_idx * JLS_SUMMARY_FSR_COUNT;                           \
-            v = src_data[offset + JLS_SUMMARY_FSR_MEAN];                                    \
-            if (isfinite(v)) {                                                              \
-                ++count;                                                                    \
-                v_mean += v;                                                                \
-                if (src_data[offset + JLS_SUMMARY_FSR_MIN] < v_min) {                       \
-                    v_min = src_data[offset + JLS_SUMMARY_FSR_MIN];                         \
-                }                                                                           \
-                if (src_data[offset + JLS_SUMMARY_FSR_MAX] > v_max) {                       \
-                    v_max = src_data[offset + JLS_SUMMARY_FSR_MAX];                         \
-                }                                                                           \
-            }                                                                               \
-            ++sample_idx;                                                                   \
+        const uint32_t sdf2 = self->parent->signal_def.summary_decimate_factor;             \
+        double r_sum = 0.0;                                                                 \
+        double r_min = 0.0;                                                                 \
+        double r_max = 0.0;                                                                 \
+        double v_mean = NAN;                                                                \
+        double v_min = NAN;                                                                 \
+        double v_max = NAN;                                                                 \
+        double v_var = NAN;                                                                 \
+        uint32_t count = summaryn_reduce_##suffix(                                          \
+                src_data + (size_t) idx * sdf2 * JLS_SUMMARY_FSR_COUNT, sdf2,               \
+                &r_sum, &r_min, &r_max);                                                    \
+        if (count) {                                                                        \
+            v_mean = r_sum / count;                                                         \
+            v_min = r_min;                                                                  \
+            v_max = r_max;                                                                  \
+            v_var = summaryn_reduce_var_##suffix(                                           \
+                    src_data + (size_t) idx * sdf2 * JLS_SUMMARY_FSR_COUNT, sdf2,           \
+                    v_mean) / count;                                                        \
         }                                                                                   \
-        if (count == 0) {                                                                   \
-            v_mean = NAN;                                                                   \
-            v_var = NAN;                                                                    \
-            v_min = NAN;                                                                    \
-            v_max = NAN;                                                                    \
-        } else {                                                                            \
-            v_mean /= count;                                                                    \
-            sample_idx = idx * self->parent->signal_def.summary_decimate_factor;                               \
-            for (uint32_t sample = 0; sample < self->parent->signal_def.summary_decimate_factor; ++sample) {   \
-                uint32_t offset = sample_idx * JLS_SUMMARY_FSR_COUNT;                           \
-                double v = src_data[offset + JLS_SUMMARY_FSR_MEAN] - v_mean;                    \
-                double std = src_data[offset + JLS_SUMMARY_FSR_STD];                            \
-                v_var += (std * std) + (v * v);                                                 \
-                ++sample_idx;                                                                   \
-            }                                                                                   \
-            v_var /= count;                                                                 \
-        }                                                                                    \
         summary_entry_add(self, level, v_mean, v_min, v_max, v_var);                        \
     }
 
@@ -360,10 +701,10 @@ int32_t jls_core_fsr_summaryN(struct jls_core_fsr_s * self, uint8_t level, int64
     uint32_t summaries_per = (uint32_t) (src->summary->header.entry_count / self->parent->signal_def.summary_decimate_factor);
     if (summary_entry_size(self) == 64) {
         double * src_data = ((struct jls_fsr_f64_summary_s *) src->summary)->data[0];
-        SUMMARYN_BODY_TEMPLATE();
+        SUMMARYN_BODY_TEMPLATE(f64);
     } else {
         float * src_data = src->summary->data[0];
-        SUMMARYN_BODY_TEMPLATE();
+        SUMMARYN_BODY_TEMPLATE(f32);
     }
 
     if (dst->summary->header.entry_count >= dst->summary_entries) {
@@ -372,52 +713,725 @@ int32_t jls_core_fsr_summaryN(struct jls_core_fsr_s * self, uint8_t level, int64
     return 0;
 }
 
-static void data_to_f64(struct jls_core_fsr_s * self) {
-    void * src = &self->data->data[0];
-    double * dst = self->data_f64;
-    const uint32_t count = self->data->header.entry_count;
-    jls_dt_buffer_to_f64(src, self->parent->signal_def.data_type, dst, count);
+// Level-1 summary reduction kernels, and the summaryN kernels that
+// reduce [mean, std, min, max] entries into the next summary level.
+// Match the scalar semantics: entries with a non-finite mean are
+// excluded from count, mean, min, and max.
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+
+static uint32_t summary_reduce(const double * data, uint32_t length,
+                               double * v_sum, double * v_min, double * v_max) {
+    const __m128d abs_mask = _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+    const __m128d inf = _mm_set1_pd(HUGE_VAL);
+    const __m128d one = _mm_set1_pd(1.0);
+    __m128d acc_cnt = _mm_setzero_pd();
+    __m128d acc_sum = _mm_setzero_pd();
+    __m128d acc_min = _mm_set1_pd(DBL_MAX);
+    __m128d acc_max = _mm_set1_pd(-DBL_MAX);
+    uint32_t i = 0;
+    for (; (i + 2) <= length; i += 2) {
+        __m128d v = _mm_loadu_pd(data + i);
+        __m128d finite = _mm_cmplt_pd(_mm_and_pd(v, abs_mask), inf);
+        acc_cnt = _mm_add_pd(acc_cnt, _mm_and_pd(finite, one));
+        acc_sum = _mm_add_pd(acc_sum, _mm_and_pd(finite, v));
+        acc_min = _mm_min_pd(acc_min, _mm_or_pd(_mm_and_pd(finite, v), _mm_andnot_pd(finite, acc_min)));
+        acc_max = _mm_max_pd(acc_max, _mm_or_pd(_mm_and_pd(finite, v), _mm_andnot_pd(finite, acc_max)));
+    }
+    double cnt2[2];
+    double sum2[2];
+    double min2[2];
+    double max2[2];
+    _mm_storeu_pd(cnt2, acc_cnt);
+    _mm_storeu_pd(sum2, acc_sum);
+    _mm_storeu_pd(min2, acc_min);
+    _mm_storeu_pd(max2, acc_max);
+    uint32_t count = (uint32_t) (cnt2[0] + cnt2[1]);
+    double sum = sum2[0] + sum2[1];
+    double mn = (min2[0] < min2[1]) ? min2[0] : min2[1];
+    double mx = (max2[0] > max2[1]) ? max2[0] : max2[1];
+    for (; i < length; ++i) {
+        double v = data[i];
+        if (isfinite(v)) {
+            ++count;
+            sum += v;
+            if (v < mn) {
+                mn = v;
+            }
+            if (v > mx) {
+                mx = v;
+            }
+        }
+    }
+    *v_sum = sum;
+    *v_min = mn;
+    *v_max = mx;
+    return count;
 }
 
-int32_t jls_core_fsr_summary1(struct jls_core_fsr_s * self, int64_t pos) {
-    struct jls_core_fsr_level_s * dst = self->level[1];
+static double summary_reduce_var(const double * data, uint32_t length, double v_mean) {
+    const __m128d abs_mask = _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+    const __m128d inf = _mm_set1_pd(HUGE_VAL);
+    const __m128d mean = _mm_set1_pd(v_mean);
+    __m128d acc = _mm_setzero_pd();
+    uint32_t i = 0;
+    for (; (i + 2) <= length; i += 2) {
+        __m128d v = _mm_loadu_pd(data + i);
+        __m128d finite = _mm_cmplt_pd(_mm_and_pd(v, abs_mask), inf);
+        __m128d d = _mm_and_pd(finite, _mm_sub_pd(v, mean));
+        acc = _mm_add_pd(acc, _mm_mul_pd(d, d));
+    }
+    double acc2[2];
+    _mm_storeu_pd(acc2, acc);
+    double v_var = acc2[0] + acc2[1];
+    for (; i < length; ++i) {
+        double v = data[i];
+        if (isfinite(v)) {
+            v -= v_mean;
+            v_var += v * v;
+        }
+    }
+    return v_var;
+}
 
-    if (!dst) {
-        ROE(jls_core_fsr_summary_level_alloc(self, 1));
-        dst = self->level[1];
+static uint32_t summaryn_reduce_f64(const double * src, uint32_t length,
+                                    double * v_sum, double * v_min, double * v_max) {
+    const __m128d abs_mask = _mm_castsi128_pd(_mm_set1_epi64x(0x7fffffffffffffffLL));
+    const __m128d inf = _mm_set1_pd(HUGE_VAL);
+    const __m128d one = _mm_set1_pd(1.0);
+    __m128d acc_cnt = _mm_setzero_pd();
+    __m128d acc_sum = _mm_setzero_pd();
+    __m128d acc_min = _mm_set1_pd(DBL_MAX);
+    __m128d acc_max = _mm_set1_pd(-DBL_MAX);
+    uint32_t i = 0;
+    for (; (i + 2) <= length; i += 2) {
+        const double * p = src + (size_t) i * JLS_SUMMARY_FSR_COUNT;
+        __m128d a0 = _mm_loadu_pd(p);      // [mean0, std0]
+        __m128d a1 = _mm_loadu_pd(p + 2);  // [min0, max0]
+        __m128d b0 = _mm_loadu_pd(p + 4);  // [mean1, std1]
+        __m128d b1 = _mm_loadu_pd(p + 6);  // [min1, max1]
+        __m128d means = _mm_unpacklo_pd(a0, b0);
+        __m128d mins = _mm_unpacklo_pd(a1, b1);
+        __m128d maxs = _mm_unpackhi_pd(a1, b1);
+        __m128d finite = _mm_cmplt_pd(_mm_and_pd(means, abs_mask), inf);
+        acc_cnt = _mm_add_pd(acc_cnt, _mm_and_pd(finite, one));
+        acc_sum = _mm_add_pd(acc_sum, _mm_and_pd(finite, means));
+        acc_min = _mm_min_pd(acc_min, _mm_or_pd(_mm_and_pd(finite, mins), _mm_andnot_pd(finite, acc_min)));
+        acc_max = _mm_max_pd(acc_max, _mm_or_pd(_mm_and_pd(finite, maxs), _mm_andnot_pd(finite, acc_max)));
+    }
+    double cnt2[2];
+    double sum2[2];
+    double min2[2];
+    double max2[2];
+    _mm_storeu_pd(cnt2, acc_cnt);
+    _mm_storeu_pd(sum2, acc_sum);
+    _mm_storeu_pd(min2, acc_min);
+    _mm_storeu_pd(max2, acc_max);
+    uint32_t count = (uint32_t) (cnt2[0] + cnt2[1]);
+    double sum = sum2[0] + sum2[1];
+    double mn = (min2[0] < min2[1]) ? min2[0] : min2[1];
+    double mx = (max2[0] > max2[1]) ? max2[0] : max2[1];
+    for (; i < length; ++i) {
+        const double * p = src + (size_t) i * JLS_SUMMARY_FSR_COUNT;
+        double v = p[JLS_SUMMARY_FSR_MEAN];
+        if (isfinite(v)) {
+            ++count;
+            sum += v;
+            if (p[JLS_SUMMARY_FSR_MIN] < mn) {
+                mn = p[JLS_SUMMARY_FSR_MIN];
+            }
+            if (p[JLS_SUMMARY_FSR_MAX] > mx) {
+                mx = p[JLS_SUMMARY_FSR_MAX];
+            }
+        }
     }
-    data_to_f64(self);
+    *v_sum = sum;
+    *v_min = mn;
+    *v_max = mx;
+    return count;
+}
 
-    double * data = self->data_f64;
-    // JLS_LOGI("1 add %" PRIi64 " @ %" PRIi64 " %p", pos, dst->index->offset, &dst->index->data[dst->index->offset]);
-    if (0 == dst->index->header.entry_count) {
-        dst->index->header.timestamp = self->data->header.timestamp;
-        dst->summary->header.timestamp = self->data->header.timestamp;
+static double summaryn_reduce_var_f64(const double * src, uint32_t length, double v_mean) {
+    const __m128d mean = _mm_set1_pd(v_mean);
+    __m128d acc = _mm_setzero_pd();
+    uint32_t i = 0;
+    for (; (i + 2) <= length; i += 2) {
+        const double * p = src + (size_t) i * JLS_SUMMARY_FSR_COUNT;
+        __m128d a0 = _mm_loadu_pd(p);
+        __m128d b0 = _mm_loadu_pd(p + 4);
+        __m128d means = _mm_unpacklo_pd(a0, b0);
+        __m128d stds = _mm_unpackhi_pd(a0, b0);
+        __m128d d = _mm_sub_pd(means, mean);
+        acc = _mm_add_pd(acc, _mm_add_pd(_mm_mul_pd(stds, stds), _mm_mul_pd(d, d)));
     }
-    dst->index->offsets[dst->index->header.entry_count++] = pos;
+    double acc2[2];
+    _mm_storeu_pd(acc2, acc);
+    double v_var = acc2[0] + acc2[1];
+    for (; i < length; ++i) {
+        const double * p = src + (size_t) i * JLS_SUMMARY_FSR_COUNT;
+        double v = p[JLS_SUMMARY_FSR_MEAN] - v_mean;
+        double std = p[JLS_SUMMARY_FSR_STD];
+        v_var += (std * std) + (v * v);
+    }
+    return v_var;
+}
 
-    uint32_t summaries_per = (uint32_t) (self->data->header.entry_count / self->parent->signal_def.sample_decimate_factor);
+static uint32_t summaryn_reduce_f32(const float * src, uint32_t length,
+                                    double * v_sum, double * v_min, double * v_max) {
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 inf = _mm_set1_ps(HUGE_VALF);
+    const __m128 one = _mm_set1_ps(1.0f);
+    __m128 acc_cnt = _mm_setzero_ps();
+    __m128d acc_sum = _mm_setzero_pd();
+    __m128 acc_min = _mm_set1_ps(FLT_MAX);
+    __m128 acc_max = _mm_set1_ps(-FLT_MAX);
+    uint32_t i = 0;
+    for (; (i + 4) <= length; i += 4) {
+        const float * p = src + (size_t) i * JLS_SUMMARY_FSR_COUNT;
+        __m128 e0 = _mm_loadu_ps(p);
+        __m128 e1 = _mm_loadu_ps(p + 4);
+        __m128 e2 = _mm_loadu_ps(p + 8);
+        __m128 e3 = _mm_loadu_ps(p + 12);
+        _MM_TRANSPOSE4_PS(e0, e1, e2, e3);  // e0=means e1=stds e2=mins e3=maxs
+        __m128 finite = _mm_cmplt_ps(_mm_and_ps(e0, abs_mask), inf);
+        acc_cnt = _mm_add_ps(acc_cnt, _mm_and_ps(finite, one));
+        __m128 m = _mm_and_ps(finite, e0);
+        acc_sum = _mm_add_pd(acc_sum, _mm_cvtps_pd(m));
+        acc_sum = _mm_add_pd(acc_sum, _mm_cvtps_pd(_mm_movehl_ps(m, m)));
+        acc_min = _mm_min_ps(acc_min, _mm_or_ps(_mm_and_ps(finite, e2), _mm_andnot_ps(finite, acc_min)));
+        acc_max = _mm_max_ps(acc_max, _mm_or_ps(_mm_and_ps(finite, e3), _mm_andnot_ps(finite, acc_max)));
+    }
+    float cnt4[4];
+    float min4[4];
+    float max4[4];
+    double sum2[2];
+    _mm_storeu_ps(cnt4, acc_cnt);
+    _mm_storeu_ps(min4, acc_min);
+    _mm_storeu_ps(max4, acc_max);
+    _mm_storeu_pd(sum2, acc_sum);
+    uint32_t count = (uint32_t) (cnt4[0] + cnt4[1] + cnt4[2] + cnt4[3]);
+    double sum = sum2[0] + sum2[1];
+    double mn = min4[0];
+    double mx = max4[0];
+    for (int j = 1; j < 4; ++j) {
+        if (min4[j] < mn) {
+            mn = min4[j];
+        }
+        if (max4[j] > mx) {
+            mx = max4[j];
+        }
+    }
+    for (; i < length; ++i) {
+        const float * p = src + (size_t) i * JLS_SUMMARY_FSR_COUNT;
+        double v = p[JLS_SUMMARY_FSR_MEAN];
+        if (isfinite(v)) {
+            ++count;
+            sum += v;
+            if (p[JLS_SUMMARY_FSR_MIN] < mn) {
+                mn = p[JLS_SUMMARY_FSR_MIN];
+            }
+            if (p[JLS_SUMMARY_FSR_MAX] > mx) {
+                mx = p[JLS_SUMMARY_FSR_MAX];
+            }
+        }
+    }
+    *v_sum = sum;
+    *v_min = mn;
+    *v_max = mx;
+    return count;
+}
+
+static double summaryn_reduce_var_f32(const float * src, uint32_t length, double v_mean) {
+    const __m128d mean = _mm_set1_pd(v_mean);
+    __m128d acc = _mm_setzero_pd();
+    uint32_t i = 0;
+    for (; (i + 4) <= length; i += 4) {
+        const float * p = src + (size_t) i * JLS_SUMMARY_FSR_COUNT;
+        __m128 e0 = _mm_loadu_ps(p);
+        __m128 e1 = _mm_loadu_ps(p + 4);
+        __m128 e2 = _mm_loadu_ps(p + 8);
+        __m128 e3 = _mm_loadu_ps(p + 12);
+        _MM_TRANSPOSE4_PS(e0, e1, e2, e3);
+        __m128d d_lo = _mm_sub_pd(_mm_cvtps_pd(e0), mean);
+        __m128d d_hi = _mm_sub_pd(_mm_cvtps_pd(_mm_movehl_ps(e0, e0)), mean);
+        __m128d s_lo = _mm_cvtps_pd(e1);
+        __m128d s_hi = _mm_cvtps_pd(_mm_movehl_ps(e1, e1));
+        acc = _mm_add_pd(acc, _mm_add_pd(_mm_mul_pd(s_lo, s_lo), _mm_mul_pd(d_lo, d_lo)));
+        acc = _mm_add_pd(acc, _mm_add_pd(_mm_mul_pd(s_hi, s_hi), _mm_mul_pd(d_hi, d_hi)));
+    }
+    double acc2[2];
+    _mm_storeu_pd(acc2, acc);
+    double v_var = acc2[0] + acc2[1];
+    for (; i < length; ++i) {
+        const float * p = src + (size_t) i * JLS_SUMMARY_FSR_COUNT;
+        double v = p[JLS_SUMMARY_FSR_MEAN] - v_mean;
+        double std = p[JLS_SUMMARY_FSR_STD];
+        v_var += (std * std) + (v * v);
+    }
+    return v_var;
+}
+
+#elif defined(__aarch64__) || defined(__arm64__)
+#include <arm_neon.h>
+
+static uint32_t summary_reduce(const double * data, uint32_t length,
+                               double * v_sum, double * v_min, double * v_max) {
+    const float64x2_t inf = vdupq_n_f64(HUGE_VAL);
+    const float64x2_t one = vdupq_n_f64(1.0);
+    const float64x2_t zero = vdupq_n_f64(0.0);
+    float64x2_t acc_cnt = vdupq_n_f64(0.0);
+    float64x2_t acc_sum = vdupq_n_f64(0.0);
+    float64x2_t acc_min = vdupq_n_f64(DBL_MAX);
+    float64x2_t acc_max = vdupq_n_f64(-DBL_MAX);
+    uint32_t i = 0;
+    for (; (i + 2) <= length; i += 2) {
+        float64x2_t v = vld1q_f64(data + i);
+        uint64x2_t finite = vcltq_f64(vabsq_f64(v), inf);
+        acc_cnt = vaddq_f64(acc_cnt, vbslq_f64(finite, one, zero));
+        acc_sum = vaddq_f64(acc_sum, vbslq_f64(finite, v, zero));
+        acc_min = vminq_f64(acc_min, vbslq_f64(finite, v, acc_min));
+        acc_max = vmaxq_f64(acc_max, vbslq_f64(finite, v, acc_max));
+    }
+    uint32_t count = (uint32_t) vaddvq_f64(acc_cnt);
+    double sum = vaddvq_f64(acc_sum);
+    double mn = vminvq_f64(acc_min);
+    double mx = vmaxvq_f64(acc_max);
+    for (; i < length; ++i) {
+        double v = data[i];
+        if (isfinite(v)) {
+            ++count;
+            sum += v;
+            if (v < mn) {
+                mn = v;
+            }
+            if (v > mx) {
+                mx = v;
+            }
+        }
+    }
+    *v_sum = sum;
+    *v_min = mn;
+    *v_max = mx;
+    return count;
+}
+
+static double summary_reduce_var(const double * data, uint32_t length, double v_mean) {
+    const float64x2_t inf = vdupq_n_f64(HUGE_VAL);
+    const float64x2_t zero = vdupq_n_f64(0.0);
+    const float64x2_t mean = vdupq_n_f64(v_mean);
+    float64x2_t acc = vdupq_n_f64(0.0);
+    uint32_t i = 0;
+    for (; (i + 2) <= length; i += 2) {
+        float64x2_t v = vld1q_f64(data + i);
+        uint64x2_t finite = vcltq_f64(vabsq_f64(v), inf);
+        float64x2_t d = vbslq_f64(finite, vsubq_f64(v, mean), zero);
+        acc = vaddq_f64(acc, vmulq_f64(d, d));
+    }
+    double v_var = vaddvq_f64(acc);
+    for (; i < length; ++i) {
+        double v = data[i];
+        if (isfinite(v)) {
+            v -= v_mean;
+            v_var += v * v;
+        }
+    }
+    return v_var;
+}
+
+static uint32_t summaryn_reduce_f64(const double * src, uint32_t length,
+                                    double * v_sum, double * v_min, double * v_max) {
+    const float64x2_t inf = vdupq_n_f64(HUGE_VAL);
+    const float64x2_t one = vdupq_n_f64(1.0);
+    const float64x2_t zero = vdupq_n_f64(0.0);
+    float64x2_t acc_cnt = vdupq_n_f64(0.0);
+    float64x2_t acc_sum = vdupq_n_f64(0.0);
+    float64x2_t acc_min = vdupq_n_f64(DBL_MAX);
+    float64x2_t acc_max = vdupq_n_f64(-DBL_MAX);
+    uint32_t i = 0;
+    for (; (i + 2) <= length; i += 2) {
+        // deinterleaving load: val[0]=means val[1]=stds val[2]=mins val[3]=maxs
+        float64x2x4_t e = vld4q_f64(src + (size_t) i * JLS_SUMMARY_FSR_COUNT);
+        uint64x2_t finite = vcltq_f64(vabsq_f64(e.val[JLS_SUMMARY_FSR_MEAN]), inf);
+        acc_cnt = vaddq_f64(acc_cnt, vbslq_f64(finite, one, zero));
+        acc_sum = vaddq_f64(acc_sum, vbslq_f64(finite, e.val[JLS_SUMMARY_FSR_MEAN], zero));
+        acc_min = vminq_f64(acc_min, vbslq_f64(finite, e.val[JLS_SUMMARY_FSR_MIN], acc_min));
+        acc_max = vmaxq_f64(acc_max, vbslq_f64(finite, e.val[JLS_SUMMARY_FSR_MAX], acc_max));
+    }
+    uint32_t count = (uint32_t) vaddvq_f64(acc_cnt);
+    double sum = vaddvq_f64(acc_sum);
+    double mn = vminvq_f64(acc_min);
+    double mx = vmaxvq_f64(acc_max);
+    for (; i < length; ++i) {
+        const double * p = src + (size_t) i * JLS_SUMMARY_FSR_COUNT;
+        double v = p[JLS_SUMMARY_FSR_MEAN];
+        if (isfinite(v)) {
+            ++count;
+            sum += v;
+            if (p[JLS_SUMMARY_FSR_MIN] < mn) {
+                mn = p[JLS_SUMMARY_FSR_MIN];
+            }
+            if (p[JLS_SUMMARY_FSR_MAX] > mx) {
+                mx = p[JLS_SUMMARY_FSR_MAX];
+            }
+        }
+    }
+    *v_sum = sum;
+    *v_min = mn;
+    *v_max = mx;
+    return count;
+}
+
+static double summaryn_reduce_var_f64(const double * src, uint32_t length, double v_mean) {
+    const float64x2_t mean = vdupq_n_f64(v_mean);
+    float64x2_t acc = vdupq_n_f64(0.0);
+    uint32_t i = 0;
+    for (; (i + 2) <= length; i += 2) {
+        float64x2x4_t e = vld4q_f64(src + (size_t) i * JLS_SUMMARY_FSR_COUNT);
+        float64x2_t d = vsubq_f64(e.val[JLS_SUMMARY_FSR_MEAN], mean);
+        float64x2_t s = e.val[JLS_SUMMARY_FSR_STD];
+        acc = vaddq_f64(acc, vaddq_f64(vmulq_f64(s, s), vmulq_f64(d, d)));
+    }
+    double v_var = vaddvq_f64(acc);
+    for (; i < length; ++i) {
+        const double * p = src + (size_t) i * JLS_SUMMARY_FSR_COUNT;
+        double v = p[JLS_SUMMARY_FSR_MEAN] - v_mean;
+        double std = p[JLS_SUMMARY_FSR_STD];
+        v_var += (std * std) + (v * v);
+    }
+    return v_var;
+}
+
+static uint32_t summaryn_reduce_f32(const float * src, uint32_t length,
+                                    double * v_sum, double * v_min, double * v_max) {
+    const float32x4_t inf = vdupq_n_f32(HUGE_VALF);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    float32x4_t acc_cnt = vdupq_n_f32(0.0f);
+    float64x2_t acc_sum = vdupq_n_f64(0.0);
+    float32x4_t acc_min = vdupq_n_f32(FLT_MAX);
+    float32x4_t acc_max = vdupq_n_f32(-FLT_MAX);
+    uint32_t i = 0;
+    for (; (i + 4) <= length; i += 4) {
+        float32x4x4_t e = vld4q_f32(src + (size_t) i * JLS_SUMMARY_FSR_COUNT);
+        uint32x4_t finite = vcltq_f32(vabsq_f32(e.val[JLS_SUMMARY_FSR_MEAN]), inf);
+        acc_cnt = vaddq_f32(acc_cnt, vbslq_f32(finite, one, zero));
+        float32x4_t m = vbslq_f32(finite, e.val[JLS_SUMMARY_FSR_MEAN], zero);
+        acc_sum = vaddq_f64(acc_sum, vcvt_f64_f32(vget_low_f32(m)));
+        acc_sum = vaddq_f64(acc_sum, vcvt_high_f64_f32(m));
+        acc_min = vminq_f32(acc_min, vbslq_f32(finite, e.val[JLS_SUMMARY_FSR_MIN], acc_min));
+        acc_max = vmaxq_f32(acc_max, vbslq_f32(finite, e.val[JLS_SUMMARY_FSR_MAX], acc_max));
+    }
+    uint32_t count = (uint32_t) vaddvq_f32(acc_cnt);
+    double sum = vaddvq_f64(acc_sum);
+    double mn = vminvq_f32(acc_min);
+    double mx = vmaxvq_f32(acc_max);
+    for (; i < length; ++i) {
+        const float * p = src + (size_t) i * JLS_SUMMARY_FSR_COUNT;
+        double v = p[JLS_SUMMARY_FSR_MEAN];
+        if (isfinite(v)) {
+            ++count;
+            sum += v;
+            if (p[JLS_SUMMARY_FSR_MIN] < mn) {
+                mn = p[JLS_SUMMARY_FSR_MIN];
+            }
+            if (p[JLS_SUMMARY_FSR_MAX] > mx) {
+                mx = p[JLS_SUMMARY_FSR_MAX];
+            }
+        }
+    }
+    *v_sum = sum;
+    *v_min = mn;
+    *v_max = mx;
+    return count;
+}
+
+static double summaryn_reduce_var_f32(const float * src, uint32_t length, double v_mean) {
+    const float64x2_t mean = vdupq_n_f64(v_mean);
+    float64x2_t acc = vdupq_n_f64(0.0);
+    uint32_t i = 0;
+    for (; (i + 4) <= length; i += 4) {
+        float32x4x4_t e = vld4q_f32(src + (size_t) i * JLS_SUMMARY_FSR_COUNT);
+        float64x2_t d_lo = vsubq_f64(vcvt_f64_f32(vget_low_f32(e.val[JLS_SUMMARY_FSR_MEAN])), mean);
+        float64x2_t d_hi = vsubq_f64(vcvt_high_f64_f32(e.val[JLS_SUMMARY_FSR_MEAN]), mean);
+        float64x2_t s_lo = vcvt_f64_f32(vget_low_f32(e.val[JLS_SUMMARY_FSR_STD]));
+        float64x2_t s_hi = vcvt_high_f64_f32(e.val[JLS_SUMMARY_FSR_STD]);
+        acc = vaddq_f64(acc, vaddq_f64(vmulq_f64(s_lo, s_lo), vmulq_f64(d_lo, d_lo)));
+        acc = vaddq_f64(acc, vaddq_f64(vmulq_f64(s_hi, s_hi), vmulq_f64(d_hi, d_hi)));
+    }
+    double v_var = vaddvq_f64(acc);
+    for (; i < length; ++i) {
+        const float * p = src + (size_t) i * JLS_SUMMARY_FSR_COUNT;
+        double v = p[JLS_SUMMARY_FSR_MEAN] - v_mean;
+        double std = p[JLS_SUMMARY_FSR_STD];
+        v_var += (std * std) + (v * v);
+    }
+    return v_var;
+}
+
+#else
+
+static uint32_t summary_reduce(const double * data, uint32_t length,
+                               double * v_sum, double * v_min, double * v_max) {
+    uint32_t count = 0;
+    double sum = 0.0;
+    double mn = DBL_MAX;
+    double mx = -DBL_MAX;
+    for (uint32_t i = 0; i < length; ++i) {
+        double v = data[i];
+        if (isfinite(v)) {
+            ++count;
+            sum += v;
+            if (v < mn) {
+                mn = v;
+            }
+            if (v > mx) {
+                mx = v;
+            }
+        }
+    }
+    *v_sum = sum;
+    *v_min = mn;
+    *v_max = mx;
+    return count;
+}
+
+static double summary_reduce_var(const double * data, uint32_t length, double v_mean) {
+    double v_var = 0.0;
+    for (uint32_t i = 0; i < length; ++i) {
+        double v = data[i];
+        if (isfinite(v)) {
+            v -= v_mean;
+            v_var += v * v;
+        }
+    }
+    return v_var;
+}
+
+#define SUMMARYN_REDUCE_TEMPLATE(suffix, type)                                  \
+static uint32_t summaryn_reduce_##suffix(const type * src, uint32_t length,     \
+                                         double * v_sum, double * v_min,        \
+                                         double * v_max) {                      \
+    uint32_t count = 0;                                                         \
+    double sum = 0.0;                                                           \
+    double mn = DBL_MAX;                                                        \
+    double mx = -DBL_MAX;                                                       \
+    for (uint32_t i = 0; i < length; ++i) {                                     \
+        const type * p = src + (size_t) i * JLS_SUMMARY_FSR_COUNT;              \
+        double v = p[JLS_SUMMARY_FSR_MEAN];                                     \
+        if (isfinite(v)) {                                                      \
+            ++count;                                                            \
+            sum += v;                                                           \
+            if (p[JLS_SUMMARY_FSR_MIN] < mn) {                                  \
+                mn = p[JLS_SUMMARY_FSR_MIN];                                    \
+            }                                                                   \
+            if (p[JLS_SUMMARY_FSR_MAX] > mx) {                                  \
+                mx = p[JLS_SUMMARY_FSR_MAX];                                    \
+            }                                                                   \
+        }                                                                       \
+    }                                                                           \
+    *v_sum = sum;                                                               \
+    *v_min = mn;                                                                \
+    *v_max = mx;                                                                \
+    return count;                                                               \
+}                                                                               \
+                                                                                \
+static double summaryn_reduce_var_##suffix(const type * src, uint32_t length,   \
+                                           double v_mean) {                     \
+    double v_var = 0.0;                                                         \
+    for (uint32_t i = 0; i < length; ++i) {                                     \
+        const type * p = src + (size_t) i * JLS_SUMMARY_FSR_COUNT;              \
+        double v = p[JLS_SUMMARY_FSR_MEAN] - v_mean;                            \
+        double std = p[JLS_SUMMARY_FSR_STD];                                    \
+        v_var += (std * std) + (v * v);                                         \
+    }                                                                           \
+    return v_var;                                                               \
+}
+
+SUMMARYN_REDUCE_TEMPLATE(f32, float)
+SUMMARYN_REDUCE_TEMPLATE(f64, double)
+
+#endif
+
+static void data_to_f64(struct jls_core_fsr_s * self, struct jls_fsr_data_s * data) {
+    void * src = &data->data[0];
+    double * dst = self->data_f64;
+    const uint32_t count = data->header.entry_count;
+    if (NULL != self->data_f64_fn) {
+        self->data_f64_fn(src, dst, count, self->data_f64_scale);
+    } else {
+        jls_dt_buffer_to_f64(src, self->parent->signal_def.data_type, dst, count);
+    }
+}
+
+static inline int8_t u4_to_i8(uint8_t k) {
+    k = k & 0x0f;
+    if (k & 0x08) {
+        k |= 0xf0;
+    }
+    return (int8_t) k;
+}
+
+static inline uint32_t popcount8(uint8_t v) {
+    v = v - ((v >> 1) & 0x55);
+    v = (v & 0x33) + ((v >> 2) & 0x33);
+    return (v + (v >> 4)) & 0x0f;
+}
+
+// Integer-native level-1 summarization: integer min/max, 64-bit sum and
+// sum of squares, converting only the final reduced values to f64.
+static void summary1_int(struct jls_core_fsr_s * self, struct jls_fsr_data_s * data,
+                         uint32_t summaries_per, double * out) {
+    const uint32_t sample_decimate_factor = self->parent->signal_def.sample_decimate_factor;
+    const uint32_t dt = self->parent->signal_def.data_type & 0xffff;
+    const double scale = self->data_f64_scale;
+    const uint8_t * src_u8 = (const uint8_t *) &data->data[0];
     for (uint32_t idx = 0; idx < summaries_per; ++idx) {
-        uint32_t sample_idx = idx * self->parent->signal_def.sample_decimate_factor;
-        uint32_t count = 0;
-        double v_mean = 0.0;
-        double v_min = DBL_MAX;
-        double v_max = -DBL_MAX;
-        double v_var = 0.0;
-        for (uint32_t sample = 0; sample < self->parent->signal_def.sample_decimate_factor; ++sample) {
-            double v = data[sample_idx];
-            if (isfinite(v)) {
-                ++count;
-                v_mean += v;
-                if (v < v_min) {
-                    v_min = v;
+        const uint32_t sample_idx = idx * sample_decimate_factor;
+        int64_t v_min = INT64_MAX;
+        int64_t v_max = INT64_MIN;
+        int64_t v_sum = 0;
+        uint64_t v_sum_sq = 0;
+        switch (dt) {
+            case JLS_DATATYPE_U1: {
+                uint64_t bit = sample_idx;  // bit 0 is sample 0, LSB first
+                const uint64_t bit_end = bit + sample_decimate_factor;
+                uint32_t ones = 0;
+                while ((bit < bit_end) && (bit & 7)) {
+                    ones += (src_u8[bit >> 3] >> (bit & 7)) & 1;
+                    ++bit;
+                }
+                while ((bit + 8) <= bit_end) {
+                    ones += popcount8(src_u8[bit >> 3]);
+                    bit += 8;
                 }
-                if (v > v_max) {
-                    v_max = v;
+                while (bit < bit_end) {
+                    ones += (src_u8[bit >> 3] >> (bit & 7)) & 1;
+                    ++bit;
                 }
+                v_sum = ones;
+                v_sum_sq = ones;
+                v_min = (ones == sample_decimate_factor) ? 1 : 0;
+                v_max = ones ? 1 : 0;
+                break;
             }
-            ++sample_idx;
+            case JLS_DATATYPE_U4:
+                for (uint32_t k = sample_idx; k < (sample_idx + sample_decimate_factor); ++k) {
+                    uint8_t b = src_u8[k >> 1];
+                    int64_t v = (k & 1) ? ((b >> 4) & 0x0f) : (b & 0x0f);
+                    v_sum += v;
+                    v_sum_sq += (uint64_t) (v * v);
+                    if (v < v_min) {
+                        v_min = v;
+                    }
+                    if (v > v_max) {
+                        v_max = v;
+                    }
+                }
+                break;
+            case JLS_DATATYPE_I4:
+                for (uint32_t k = sample_idx; k < (sample_idx + sample_decimate_factor); ++k) {
+                    uint8_t b = src_u8[k >> 1];
+                    int64_t v = u4_to_i8((k & 1) ? (b >> 4) : b);
+                    v_sum += v;
+                    v_sum_sq += (uint64_t) (v * v);
+                    if (v < v_min) {
+                        v_min = v;
+                    }
+                    if (v > v_max) {
+                        v_max = v;
+                    }
+                }
+                break;
+            case JLS_DATATYPE_I8: {
+                const int8_t * s = (const int8_t *) src_u8;
+                for (uint32_t k = sample_idx; k < (sample_idx + sample_decimate_factor); ++k) {
+                    int64_t v = s[k];
+                    v_sum += v;
+                    v_sum_sq += (uint64_t) (v * v);
+                    if (v < v_min) {
+                        v_min = v;
+                    }
+                    if (v > v_max) {
+                        v_max = v;
+                    }
+                }
+                break;
+            }
+            case JLS_DATATYPE_U8:
+                for (uint32_t k = sample_idx; k < (sample_idx + sample_decimate_factor); ++k) {
+                    int64_t v = src_u8[k];
+                    v_sum += v;
+                    v_sum_sq += (uint64_t) (v * v);
+                    if (v < v_min) {
+                        v_min = v;
+                    }
+                    if (v > v_max) {
+                        v_max = v;
+                    }
+                }
+                break;
+            case JLS_DATATYPE_I16: {
+                const int16_t * s = (const int16_t *) src_u8;
+                for (uint32_t k = sample_idx; k < (sample_idx + sample_decimate_factor); ++k) {
+                    int64_t v = s[k];
+                    v_sum += v;
+                    v_sum_sq += (uint64_t) (v * v);
+                    if (v < v_min) {
+                        v_min = v;
+                    }
+                    if (v > v_max) {
+                        v_max = v;
+                    }
+                }
+                break;
+            }
+            default: {  // JLS_DATATYPE_U16
+                const uint16_t * s = (const uint16_t *) src_u8;
+                for (uint32_t k = sample_idx; k < (sample_idx + sample_decimate_factor); ++k) {
+                    int64_t v = s[k];
+                    v_sum += v;
+                    v_sum_sq += (uint64_t) (v * v);
+                    if (v < v_min) {
+                        v_min = v;
+                    }
+                    if (v > v_max) {
+                        v_max = v;
+                    }
+                }
+                break;
+            }
+        }
+        double v_mean = ((double) v_sum) / sample_decimate_factor;
+        double v_var = ((double) v_sum_sq) / sample_decimate_factor - (v_mean * v_mean);
+        if (v_var < 0.0) {
+            v_var = 0.0;  // guard rounding
         }
+        out[0] = scale * v_mean;
+        out[1] = scale * (double) v_min;
+        out[2] = scale * (double) v_max;
+        out[3] = scale * scale * v_var;
+        out += JLS_SUMMARY_FSR_COUNT;
+    }
+}
+
+// Compute level-1 summary entries into out as [mean, min, max, var] per entry,
+// matching the summary_entry_add() argument order.
+static void summary1_entries(struct jls_core_fsr_s * self, struct jls_fsr_data_s * data,
+                             uint32_t summaries_per, double * out) {
+    if (self->summarize_int) {
+        summary1_int(self, data, summaries_per, out);
+        return;
+    }
+    const uint32_t sample_decimate_factor = self->parent->signal_def.sample_decimate_factor;
+    data_to_f64(self, data);
+    for (uint32_t idx = 0; idx < summaries_per; ++idx) {
+        const double * src = self->data_f64 + idx * sample_decimate_factor;
+        double v_mean = 0.0;
+        double v_min = DBL_MAX;
+        double v_max = -DBL_MAX;
+        double v_var = 0.0;
+        uint32_t count = summary_reduce(src, sample_decimate_factor, &v_mean, &v_min, &v_max);
         if (count == 0) {
             v_mean = NAN;
             v_min = NAN;
@@ -425,30 +1439,161 @@ int32_t jls_core_fsr_summary1(struct jls_core_fsr_s * self, int64_t pos) {
             v_var = NAN;
         } else {
             v_mean /= count;
-            sample_idx = idx * self->parent->signal_def.sample_decimate_factor;
-            for (uint32_t sample = 0; sample < self->parent->signal_def.sample_decimate_factor; ++sample) {
-                double v = data[sample_idx];
-                if (isfinite(v)) {
-                    v -= v_mean;
-                    v_var += v * v;
-                }
-                ++sample_idx;
-            }
             if (count == 1) {
                 v_var = 0.0;
             } else {
-                v_var /= count;
+                v_var = summary_reduce_var(src, sample_decimate_factor, v_mean) / count;
             }
         }
-        summary_entry_add(self, 1, v_mean, v_min, v_max, v_var);
+        out[0] = v_mean;
+        out[1] = v_min;
+        out[2] = v_max;
+        out[3] = v_var;
+        out += JLS_SUMMARY_FSR_COUNT;
     }
+}
+
+/// Cap mirror staging memory; the mirror computes uncovered blocks itself.
+#define MIRROR_ENTRIES_MAX (1 << 16)
 
+/**
+ * @brief Stage the computed level-1 entries for the mirror writer.
+ *
+ * @param self The FSR track instance with a mirror enabled.
+ * @param count The entry count at reduce_entries.
+ *
+ * Converts the [mean, min, max, var] scratch layout to the
+ * jls_wr_fsr_summary_inject() order [mean, std, min, max].  Best
+ * effort: on allocation failure or overflow of the staging cap, the
+ * mirror recomputes the uncovered blocks from the forwarded samples.
+ */
+static void mirror_entries_stage(struct jls_core_fsr_s * self, uint32_t count) {
+    uint32_t total = self->mirror_count + count;
+    if (total > MIRROR_ENTRIES_MAX) {
+        return;
+    }
+    if (total > self->mirror_alloc) {
+        uint32_t alloc = self->mirror_alloc ? self->mirror_alloc : 256;
+        while (alloc < total) {
+            alloc *= 2;
+        }
+        double * b = realloc(self->mirror_entries, (size_t) alloc * JLS_SUMMARY_FSR_COUNT * sizeof(double));
+        if (!b) {
+            return;
+        }
+        self->mirror_entries = b;
+        self->mirror_alloc = alloc;
+    }
+    const double * src = self->reduce_entries;
+    double * dst = self->mirror_entries + (size_t) self->mirror_count * JLS_SUMMARY_FSR_COUNT;
+    for (uint32_t idx = 0; idx < count; ++idx) {
+        dst[JLS_SUMMARY_FSR_MEAN] = src[0];
+        dst[JLS_SUMMARY_FSR_STD] = sqrt(src[3]);
+        dst[JLS_SUMMARY_FSR_MIN] = src[1];
+        dst[JLS_SUMMARY_FSR_MAX] = src[2];
+        src += JLS_SUMMARY_FSR_COUNT;
+        dst += JLS_SUMMARY_FSR_COUNT;
+    }
+    self->mirror_count = total;
+}
+
+static int32_t summary1_append(struct jls_core_fsr_s * self, uint32_t count) {
+    struct jls_core_fsr_level_s * dst = self->level[1];
+    if (self->parent->parent->mirror && !self->parallel_en) {
+        // parallel reduction lags the data stream by one block, which
+        // would misalign the injected entries with the mirror's blocks
+        mirror_entries_stage(self, count);
+    }
+    const double * e = self->reduce_entries;
+    for (uint32_t idx = 0; idx < count; ++idx, e += JLS_SUMMARY_FSR_COUNT) {
+        summary_entry_add(self, 1, e[0], e[1], e[2], e[3]);
+    }
     if (dst->summary->header.entry_count >= dst->summary_entries) {
         ROE(wr_summary(self, 1));
     }
     return 0;
 }
 
+static void summary1_reduce_fn(void * user_data) {
+    struct jls_core_fsr_s * self = (struct jls_core_fsr_s *) user_data;
+    uint32_t summaries_per = (uint32_t) (self->data_prev->header.entry_count
+            / self->parent->signal_def.sample_decimate_factor);
+    summary1_entries(self, self->data_prev, summaries_per, self->reduce_entries);
+    self->reduce_count = summaries_per;
+}
+
+static int32_t summary1_join(struct jls_core_fsr_s * self) {
+    if (NULL == self->reduce_thread) {
+        return 0;
+    }
+    int32_t rc = jls_bk_thread_join(self->reduce_thread);
+    self->reduce_thread = NULL;
+    if (rc) {
+        return rc;
+    }
+    return summary1_append(self, self->reduce_count);
+}
+
+// Hand the filled sample buffer to a worker thread for level-1 reduction.
+// The bookkeeping here matches jls_core_fsr_summary1() exactly so that the
+// resulting file layout is identical to the synchronous path.
+static int32_t summary1_dispatch(struct jls_core_fsr_s * self, int64_t pos) {
+    struct jls_core_fsr_level_s * dst = self->level[1];
+    if (!dst) {
+        ROE(jls_core_fsr_summary_level_alloc(self, 1));
+        dst = self->level[1];
+    }
+    if (0 == dst->index->header.entry_count) {
+        dst->index->header.timestamp = self->data->header.timestamp;
+        dst->summary->header.timestamp = self->data->header.timestamp;
+    }
+    dst->index->offsets[dst->index->header.entry_count++] = pos;
+
+    struct jls_fsr_data_s * data = self->data;
+    self->data = self->data_prev;
+    self->data_prev = data;
+    self->data->header.timestamp = data->header.timestamp + self->parent->signal_def.samples_per_data;
+    self->data->header.entry_count = 0;
+    self->data->header.entry_size_bits = data->header.entry_size_bits;
+    self->data->header.rsv16 = 0;
+    return jls_bk_thread_run(&self->reduce_thread, summary1_reduce_fn, self);
+}
+
+int32_t jls_core_fsr_summary1(struct jls_core_fsr_s * self, int64_t pos) {
+    struct jls_core_fsr_level_s * dst = self->level[1];
+
+    if (!dst) {
+        ROE(jls_core_fsr_summary_level_alloc(self, 1));
+        dst = self->level[1];
+    }
+    // JLS_LOGI("1 add %" PRIi64 " @ %" PRIi64 " %p", pos, dst->index->offset, &dst->index->data[dst->index->offset]);
+    if (0 == dst->index->header.entry_count) {
+        dst->index->header.timestamp = self->data->header.timestamp;
+        dst->summary->header.timestamp = self->data->header.timestamp;
+    }
+    dst->index->offsets[dst->index->header.entry_count++] = pos;
+
+    uint32_t summaries_per = (uint32_t) (self->data->header.entry_count
+            / self->parent->signal_def.sample_decimate_factor);
+    if (self->inject_entries && ((self->inject_offset + summaries_per) <= self->inject_count)) {
+        // reuse the preset entries, see jls_wr_fsr_summary_inject()
+        const double * src = self->inject_entries + (size_t) self->inject_offset * JLS_SUMMARY_FSR_COUNT;
+        double * out = self->reduce_entries;
+        for (uint32_t idx = 0; idx < summaries_per; ++idx) {
+            out[0] = src[JLS_SUMMARY_FSR_MEAN];
+            out[1] = src[JLS_SUMMARY_FSR_MIN];
+            out[2] = src[JLS_SUMMARY_FSR_MAX];
+            out[3] = src[JLS_SUMMARY_FSR_STD] * src[JLS_SUMMARY_FSR_STD];  // reduce entries hold var
+            out += JLS_SUMMARY_FSR_COUNT;
+            src += JLS_SUMMARY_FSR_COUNT;
+        }
+        self->inject_offset += summaries_per;
+    } else {
+        summary1_entries(self, self->data, summaries_per, self->reduce_entries);
+    }
+    return summary1_append(self, summaries_per);
+}
+
 static int32_t wr_data_inner(struct jls_core_fsr_s * self, const void * data, uint32_t data_length) {
     struct jls_fsr_data_s * b = self->data;
     uint8_t sample_size_bits = jls_datatype_parse_size(self->parent->signal_def.data_type);
@@ -458,6 +1603,7 @@ static int32_t wr_data_inner(struct jls_core_fsr_s * self, const void * data, ui
     uint8_t shift_amount_next = (shift_this + self->shift_amount) % 8;
 
     while (data_length) {
+        b = self->data;  // wr_data() may swap buffers under parallel summarization
         dst_u8 = (uint8_t *) &b->data[0];
         dst_u8 += (b->header.entry_count * sample_size_bits) / 8;
         uint32_t length = (uint32_t) (self->data_length - b->header.entry_count);
@@ -503,6 +1649,10 @@ int32_t jls_wr_fsr_data(struct jls_core_fsr_s * self, int64_t sample_id, const v
         return 0;
     }
 
+    if (self->suspend_buf) {
+        ROE(jls_core_fsr_resume(self));  // implicit resume on new samples
+    }
+
     if (!self->data) {
         ROE(jls_core_fsr_sample_buffer_alloc(self));
         self->sample_id_offset = sample_id;  // can be nonzero
@@ -581,12 +1731,29 @@ int32_t jls_wr_fsr_data(struct jls_core_fsr_s * self, int64_t sample_id, const v
             buf_sz = (sizeof(self->buffer_u64) * sample_size_bits) / 8;
             memset(self->buffer_u64, 0, sizeof(self->buffer_u64));
         }
+        bool gap_fast = (sample_size_bits >= 8) && !self->ring_chunks
+                && (self->write_omit_data <= 1);
         while (skip) {
-            if (skip < buf_sz) {
-                buf_sz = skip;
+            if (gap_fast && (0 == self->data->header.entry_count)
+                    && (skip >= (size_t) self->data_length)) {
+                ROE(wr_data_gap(self));
+                skip -= self->data_length;
+                continue;
+            }
+            size_t n = buf_sz;
+            if (gap_fast) {
+                // stop the filler at the chunk boundary so the next
+                // whole-chunk gap takes the constant-run path
+                size_t remaining = (size_t) (self->data_length - self->data->header.entry_count);
+                if (n > remaining) {
+                    n = remaining;
+                }
+            }
+            if (skip < n) {
+                n = skip;
             }
-            ROE(wr_data_inner(self, self->buffer_u64, (uint32_t) buf_sz));
-            skip -= buf_sz;
+            ROE(wr_data_inner(self, self->buffer_u64, (uint32_t) n));
+            skip -= n;
         }
     }
 
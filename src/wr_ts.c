@@ -34,13 +34,14 @@ enum commit_mode_e {
 
 static void ts_free(struct jls_core_ts_s * self) {
     if (self) {
+        struct jls_core_s * core = self->parent->parent;
         for (int i = 0; i < JLS_SUMMARY_LEVEL_COUNT; ++i) {
             if (self->index[i]) {
-                free(self->index[i]);
+                jls_core_arena_free(core, self->index[i]);
                 self->index[i] = 0;
             }
             if (self->summary[i]) {
-                free(self->summary[i]);
+                jls_core_arena_free(core, self->summary[i]);
                 self->summary[i] = 0;
             }
         }
@@ -56,7 +57,7 @@ static int32_t index_alloc(struct jls_core_ts_s * self, uint8_t level) {
         return 0;
     }
     size_t sz = sizeof(struct jls_payload_header_s) + sizeof(struct jls_index_entry_s) * self->decimate_factor;
-    struct jls_index_s * index = malloc(sz);
+    struct jls_index_s * index = jls_core_arena_alloc(self->parent->parent, sz);
     if (!index) {
         return JLS_ERROR_NOT_ENOUGH_MEMORY;
     }
@@ -92,7 +93,7 @@ static int32_t summary_alloc(struct jls_core_ts_s * self, uint8_t level) {
     }
     size_t sz = sizeof(struct jls_payload_header_s) + self->decimate_factor * entry_sz;
     sz = ((sz + 7) / 8) * 8;
-    struct jls_payload_header_s * summary = malloc(sz);
+    struct jls_payload_header_s * summary = jls_core_arena_alloc(self->parent->parent, sz);
     if (!summary) {
         return JLS_ERROR_NOT_ENOUGH_MEMORY;
     }
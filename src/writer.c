@@ -25,13 +25,19 @@
 #include "jls/cdef.h"
 #include "jls/ec.h"
 #include "jls/log.h"
+#include "jls/time.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <inttypes.h>
 
+#define ANNO_BATCH_BYTES_MAX (64 * 1024)  // commit a coalesced annotation chunk at this payload size
+
 struct jls_wr_s {
     struct jls_core_s core;
+    struct jls_buf_s * anno_batch;   // pending coalesced annotation records, or NULL
+    uint16_t anno_batch_signal_id;   // the signal for the pending records
+    uint32_t anno_batch_count;       // the pending record count, 0 when empty
 };
 
 const struct jls_source_def_s SOURCE_0 = {
@@ -69,6 +75,7 @@ int32_t jls_wr_open(struct jls_wr_s ** instance, const char * path) {
         return JLS_ERROR_NOT_ENOUGH_MEMORY;
     }
     struct jls_core_s * core = &self->core;
+    core->arena_en = 1;  // serve summary working state from the bump arena
 
     core->buf = jls_buf_alloc();
     if (!core->buf) {
@@ -92,6 +99,15 @@ int32_t jls_wr_open(struct jls_wr_s ** instance, const char * path) {
         return rc;
     }
 
+    // keep the stream append-only during capture: batch the backward
+    // head-pointer rewrites on flush and close.  "2" makes the stream
+    // strictly append-only: the links are never rewritten in place and
+    // land in the JLS_TAG_LINK_TABLE footer chunk at close instead.
+    const char * env = getenv("JLS_APPEND_ONLY");
+    if (env && (env[0] != '0')) {
+        core->head_defer_en = (env[0] == '2') ? 2 : 1;
+    }
+
     ROE(jls_wr_user_data(self, 0, JLS_STORAGE_TYPE_INVALID, NULL, 0));
     ROE(jls_wr_source_def(self, &SOURCE_0));
     ROE(jls_wr_signal_def(self, &SIGNAL_0));
@@ -100,28 +116,115 @@ int32_t jls_wr_open(struct jls_wr_s ** instance, const char * path) {
     return 0;
 }
 
+int32_t jls_wr_mirror_open(struct jls_wr_s * self, const char * path) {
+    if (!self || !path) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_core_s * core = &self->core;
+    if (core->mirror) {
+        return JLS_ERROR_ALREADY_EXISTS;
+    }
+    struct jls_wr_s * mirror = NULL;
+    ROE(jls_wr_open(&mirror, path));
+
+    // replay the definitions made before the mirror opened
+    int32_t rc = 0;
+    for (uint16_t source_id = 1; (0 == rc) && (source_id < JLS_SOURCE_COUNT); ++source_id) {
+        if (core->source_info[source_id].chunk_def.offset) {
+            rc = jls_wr_source_def(mirror, &core->source_info[source_id].source_def);
+        }
+    }
+    for (uint16_t signal_id = 1; (0 == rc) && (signal_id < JLS_SIGNAL_COUNT); ++signal_id) {
+        struct jls_core_signal_s * info = &core->signal_info[signal_id];
+        if (info->chunk_def.offset) {
+            rc = jls_wr_signal_def(mirror, &info->signal_def);
+            if ((0 == rc) && (JLS_SIGNAL_TYPE_FSR == info->signal_def.signal_type)) {
+                rc = jls_wr_fsr_omit_data(mirror, signal_id, 1);
+            }
+        }
+    }
+    if (rc) {
+        jls_wr_close(mirror);
+        return rc;
+    }
+    core->mirror = mirror;
+    return 0;
+}
+
 int32_t jls_wr_close(struct jls_wr_s * self) {
     if (self) {
         struct jls_core_s * core = &self->core;
+        jls_wr_annotation_commit(self);  // write any pending coalesced annotations
         for (size_t i = 0; i < JLS_SIGNAL_COUNT; ++i) {
             struct jls_core_signal_s * signal_info = &core->signal_info[i];
+            if (NULL != signal_info->track_fsr) {
+                // the directory records the first data chunk timestamp
+                signal_info->signal_def.sample_id_offset = signal_info->track_fsr->sample_id_offset;
+            }
             jls_fsr_close(signal_info->track_fsr);
             jls_wr_ts_close(signal_info->track_anno);
             jls_wr_ts_close(signal_info->track_utc);
         }
+        jls_core_wr_directory(core);
+        jls_core_wr_tmap(core);
+        jls_core_wr_seek_index(core);
+        jls_core_wr_data_map(core);
+        jls_core_wr_link_table(core);  // strict append-only, no-op otherwise
+        jls_core_wr_chunk_clock(core);  // chain anchor when enabled, no-op otherwise
         jls_core_wr_end(core);
+        jls_core_head_defer_apply(core);
         int32_t rc = jls_raw_close(core->raw);
+        jls_core_seek_index_free(core);
+        jls_core_tmap_sidecar_free(core);
+        free(core->head_defer);
+        core->head_defer = NULL;
+        free(core->chunk_clock);
+        core->chunk_clock = NULL;
+        jls_core_arena_finalize(core);
         if (core->buf) {
             jls_buf_free(core->buf);
             core->buf = NULL;
         }
+        if (self->anno_batch) {
+            jls_buf_free(self->anno_batch);
+            self->anno_batch = NULL;
+        }
+        if (core->mirror) {
+            int32_t rc_mirror = jls_wr_close(core->mirror);
+            core->mirror = NULL;
+            if (0 == rc) {
+                rc = rc_mirror;
+            }
+        }
         free(self);
         return rc;
     }
     return 0;
 }
 
+int32_t jls_wr_checkpoint_interval(struct jls_wr_s * self, uint64_t bytes) {
+    if (NULL == self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_core_s * core = &self->core;
+    core->checkpoint_interval = bytes;
+    if (bytes) {
+        core->checkpoint_next = jls_raw_chunk_tell(core->raw) + (int64_t) bytes;
+    }
+    return 0;
+}
+
+int32_t jls_wr_chunk_clock_en(struct jls_wr_s * self, uint8_t enable) {
+    if (NULL == self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    self->core.chunk_clock_en = enable ? 1 : 0;
+    return 0;
+}
+
 int32_t jls_wr_flush(struct jls_wr_s * self) {
+    ROE(jls_wr_annotation_commit(self));
+    ROE(jls_core_head_defer_apply(&self->core));
     return jls_raw_flush(self->core.raw);
 }
 
@@ -167,14 +270,18 @@ int32_t jls_wr_source_def(struct jls_wr_s * self, const struct jls_source_def_s
     chunk->hdr.item_next = 0;  // update later
     chunk->hdr.item_prev = core->source_head.offset;
     chunk->hdr.tag = JLS_TAG_SOURCE_DEF;
-    chunk->hdr.rsv0_u8 = 0;
+    chunk->hdr.compression = JLS_COMPRESSION_NONE;
     chunk->hdr.chunk_meta = source->source_id;
     chunk->hdr.payload_length = payload_length;
     chunk->offset = jls_raw_chunk_tell(core->raw);
 
     // write
-    ROE(jls_core_update_item_head(core, &core->source_head, chunk));
+    // write first so the head copy keeps the raw-layer header updates
     ROE(jls_raw_wr(core->raw, &chunk->hdr, buf->start));
+    ROE(jls_core_update_item_head(core, &core->source_head, chunk));
+    if (core->mirror && (source->source_id != 0)) {
+        ROE(jls_wr_source_def(core->mirror, source));
+    }
     return 0;
 }
 
@@ -236,7 +343,7 @@ int32_t jls_wr_signal_def(struct jls_wr_s * self, const struct jls_signal_def_s
     jls_buf_reset(buf);
     ROE(jls_buf_wr_u16(buf, def->source_id));
     ROE(jls_buf_wr_u8(buf, def->signal_type));
-    ROE(jls_buf_wr_u8(buf, 0));  // reserved
+    ROE(jls_buf_wr_u8(buf, def->data_encoding));
     ROE(jls_buf_wr_u32(buf, def->data_type));
     ROE(jls_buf_wr_u32(buf, def->sample_rate));
     ROE(jls_buf_wr_u32(buf, def->samples_per_data));
@@ -255,7 +362,7 @@ int32_t jls_wr_signal_def(struct jls_wr_s * self, const struct jls_signal_def_s
     chunk->hdr.item_next = 0;  // update later
     chunk->hdr.item_prev = core->signal_head.offset;
     chunk->hdr.tag = JLS_TAG_SIGNAL_DEF;
-    chunk->hdr.rsv0_u8 = 0;
+    chunk->hdr.compression = JLS_COMPRESSION_NONE;
     chunk->hdr.chunk_meta = signal_id;
     chunk->hdr.payload_length = payload_length;
     chunk->offset = jls_raw_chunk_tell(core->raw);
@@ -285,6 +392,13 @@ int32_t jls_wr_signal_def(struct jls_wr_s * self, const struct jls_signal_def_s
                            info->signal_def.annotation_decimate_factor));
     }
 
+    if (core->mirror && (signal_id != 0)) {
+        ROE(jls_wr_signal_def(core->mirror, signal));
+        if (JLS_SIGNAL_TYPE_FSR == def->signal_type) {
+            ROE(jls_wr_fsr_omit_data(core->mirror, signal_id, 1));
+        }
+    }
+
     return 0;
 }
 
@@ -321,21 +435,97 @@ int32_t jls_wr_user_data(struct jls_wr_s * self, uint16_t chunk_meta,
     chunk.hdr.item_next = 0;  // update later
     chunk.hdr.item_prev = self->core.user_data_head.offset;
     chunk.hdr.tag = JLS_TAG_USER_DATA;
-    chunk.hdr.rsv0_u8 = 0;
+    chunk.hdr.compression = JLS_COMPRESSION_NONE;
     chunk.hdr.chunk_meta = chunk_meta;
     chunk.hdr.payload_length = data_size;
     chunk.offset = jls_raw_chunk_tell(self->core.raw);
 
     // write
     ROE(jls_raw_wr(self->core.raw, &chunk.hdr, data));
-    return jls_core_update_item_head(&self->core, &self->core.user_data_head, &chunk);
+    ROE(jls_core_update_item_head(&self->core, &self->core.user_data_head, &chunk));
+
+    // keep a current copy of the first chunk, the read iteration anchor,
+    // for the footer directory
+    if (!self->core.user_data_first.offset) {
+        self->core.user_data_first = chunk;
+    } else if ((uint64_t) self->core.user_data_first.offset == chunk.hdr.item_prev) {
+        self->core.user_data_first.hdr.item_next = chunk.offset;
+    }
+    return 0;
+}
+
+// Forward sample data to the mirror, providing the level-1 summary
+// entries just computed for the primary so that the mirror skips the
+// statistics recomputation, see jls_wr_fsr_summary_inject().
+static int32_t wr_fsr_mirror(struct jls_wr_s * self, uint16_t signal_id,
+                             int64_t sample_id, const void * data, uint32_t data_length) {
+    struct jls_core_fsr_s * fsr = self->core.signal_info[signal_id].track_fsr;
+    if (fsr->mirror_count) {
+        int32_t rc = jls_wr_fsr_summary_inject(self->core.mirror, signal_id,
+                                               fsr->mirror_entries, fsr->mirror_count);
+        if (rc && (JLS_ERROR_NOT_SUPPORTED != rc)) {
+            return rc;
+        }
+        fsr->mirror_count = 0;
+    }
+    return jls_wr_fsr(self->core.mirror, signal_id, sample_id, data, data_length);
+}
+
+// apply the optional scale and block transform, see jls_wr_fsr_scale()
+static int32_t fsr_transform_apply(struct jls_core_signal_s * info, int64_t sample_id,
+                                   const void * data, uint32_t data_length,
+                                   const void ** data_out) {
+    struct jls_core_fsr_s * fsr = info->track_fsr;
+    *data_out = data;
+    if (!fsr->scale_en && (NULL == fsr->transform_fn)) {
+        return 0;
+    }
+    const uint32_t data_type = info->signal_def.data_type;
+    size_t sz = ((size_t) data_length * jls_datatype_parse_size(data_type) + 7) / 8;
+    if (fsr->transform_alloc < sz) {
+        void * b = realloc(fsr->transform_buf, sz);
+        if (NULL == b) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        fsr->transform_buf = b;
+        fsr->transform_alloc = (uint32_t) sz;
+    }
+    memcpy(fsr->transform_buf, data, sz);
+    if (fsr->scale_en) {
+        if (JLS_DATATYPE_F32 == data_type) {
+            float * f = (float *) fsr->transform_buf;
+            const float gain = (float) fsr->scale_gain;
+            const float offset = (float) fsr->scale_offset;
+            for (uint32_t i = 0; i < data_length; ++i) {
+                f[i] = f[i] * gain + offset;
+            }
+        } else if (JLS_DATATYPE_F64 == data_type) {
+            double * f = (double *) fsr->transform_buf;
+            const double gain = fsr->scale_gain;
+            const double offset = fsr->scale_offset;
+            for (uint32_t i = 0; i < data_length; ++i) {
+                f[i] = f[i] * gain + offset;
+            }
+        }
+    }
+    if (fsr->transform_fn) {
+        ROE(fsr->transform_fn(fsr->transform_user_data, info->signal_def.signal_id,
+                              sample_id, fsr->transform_buf, data_length));
+    }
+    *data_out = fsr->transform_buf;
+    return 0;
 }
 
 int32_t jls_wr_fsr(struct jls_wr_s * self, uint16_t signal_id,
                            int64_t sample_id, const void * data, uint32_t data_length) {
     ROE(jls_core_signal_validate(&self->core, signal_id));
     struct jls_core_signal_s * info = &self->core.signal_info[signal_id];
-    return jls_wr_fsr_data(info->track_fsr, sample_id, data, data_length);
+    ROE(fsr_transform_apply(info, sample_id, data, data_length, &data));
+    ROE(jls_wr_fsr_data(info->track_fsr, sample_id, data, data_length));
+    if (self->core.mirror) {
+        return wr_fsr_mirror(self, signal_id, sample_id, data, data_length);
+    }
+    return 0;
 }
 
 int32_t jls_wr_fsr_f32(struct jls_wr_s * self, uint16_t signal_id,
@@ -345,7 +535,99 @@ int32_t jls_wr_fsr_f32(struct jls_wr_s * self, uint16_t signal_id,
     if (info->signal_def.data_type != JLS_DATATYPE_F32) {
         return JLS_ERROR_PARAMETER_INVALID;
     }
-    return jls_wr_fsr_data(info->track_fsr, sample_id, data, data_length);
+    const void * d = data;
+    ROE(fsr_transform_apply(info, sample_id, data, data_length, &d));
+    ROE(jls_wr_fsr_data(info->track_fsr, sample_id, d, data_length));
+    if (self->core.mirror) {
+        return wr_fsr_mirror(self, signal_id, sample_id, d, data_length);
+    }
+    return 0;
+}
+
+int32_t jls_wr_fsr_f64(struct jls_wr_s * self, uint16_t signal_id,
+                       int64_t sample_id, const double * data, uint32_t data_length) {
+    ROE(jls_core_signal_validate(&self->core, signal_id));
+    struct jls_core_signal_s * info = &self->core.signal_info[signal_id];
+    if (info->signal_def.data_type != JLS_DATATYPE_F64) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    const void * d = data;
+    ROE(fsr_transform_apply(info, sample_id, data, data_length, &d));
+    ROE(jls_wr_fsr_data(info->track_fsr, sample_id, d, data_length));
+    if (self->core.mirror) {
+        return wr_fsr_mirror(self, signal_id, sample_id, d, data_length);
+    }
+    return 0;
+}
+
+int32_t jls_wr_fsr_scale(struct jls_wr_s * self, uint16_t signal_id,
+                         double gain, double offset) {
+    ROE(jls_core_signal_validate_typed(&self->core, signal_id, JLS_SIGNAL_TYPE_FSR));
+    struct jls_core_signal_s * info = &self->core.signal_info[signal_id];
+    struct jls_core_fsr_s * fsr = info->track_fsr;
+    if ((1.0 == gain) && (0.0 == offset)) {
+        fsr->scale_en = 0;
+        return 0;
+    }
+    if ((JLS_DATATYPE_F32 != info->signal_def.data_type)
+            && (JLS_DATATYPE_F64 != info->signal_def.data_type)) {
+        JLS_LOGW("scale requires a floating-point data type");
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    fsr->scale_gain = gain;
+    fsr->scale_offset = offset;
+    fsr->scale_en = 1;
+    return 0;
+}
+
+int32_t jls_wr_fsr_transform(struct jls_wr_s * self, uint16_t signal_id,
+                             jls_wr_fsr_transform_fn fn, void * user_data) {
+    ROE(jls_core_signal_validate_typed(&self->core, signal_id, JLS_SIGNAL_TYPE_FSR));
+    struct jls_core_fsr_s * fsr = self->core.signal_info[signal_id].track_fsr;
+    fsr->transform_fn = fn;
+    fsr->transform_user_data = user_data;
+    return 0;
+}
+
+int32_t jls_wr_fsr_summary_preview(struct jls_wr_s * self, uint16_t signal_id, uint8_t level) {
+    ROE(jls_core_signal_validate_typed(&self->core, signal_id, JLS_SIGNAL_TYPE_FSR));
+    if ((level < 1) || (level >= JLS_SUMMARY_LEVEL_COUNT)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    return jls_fsr_summary_preview_wr(self->core.signal_info[signal_id].track_fsr, level);
+}
+
+int32_t jls_wr_fsr_summary_watermark(struct jls_wr_s * self, uint16_t signal_id,
+                                     uint8_t level, uint32_t interval_ms) {
+    ROE(jls_core_signal_validate_typed(&self->core, signal_id, JLS_SIGNAL_TYPE_FSR));
+    if ((level < 1) || (level >= JLS_SUMMARY_LEVEL_COUNT)) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    struct jls_core_fsr_s * fsr = self->core.signal_info[signal_id].track_fsr;
+    fsr->preview_interval_ms[level] = interval_ms;
+    fsr->preview_due[level] = jls_now() + JLS_TIME_MILLISECOND * (int64_t) interval_ms;
+    return 0;
+}
+
+int32_t jls_wr_fsr_summary_preview_process(struct jls_wr_s * self) {
+    if (NULL == self) {
+        return JLS_ERROR_PARAMETER_INVALID;
+    }
+    int64_t now = jls_now();
+    for (uint16_t signal_id = 0; signal_id < JLS_SIGNAL_COUNT; ++signal_id) {
+        struct jls_core_fsr_s * fsr = self->core.signal_info[signal_id].track_fsr;
+        if (NULL == fsr) {
+            continue;
+        }
+        for (uint8_t level = 1; level < JLS_SUMMARY_LEVEL_COUNT; ++level) {
+            if (!fsr->preview_interval_ms[level] || (now < fsr->preview_due[level])) {
+                continue;
+            }
+            ROE(jls_fsr_summary_preview_wr(fsr, level));
+            fsr->preview_due[level] = now + JLS_TIME_MILLISECOND * (int64_t) fsr->preview_interval_ms[level];
+        }
+    }
+    return 0;
 }
 
 int32_t jls_wr_fsr_omit_data(struct jls_wr_s * self, uint16_t signal_id, uint32_t enable) {
@@ -359,28 +641,90 @@ int32_t jls_wr_fsr_omit_data(struct jls_wr_s * self, uint16_t signal_id, uint32_
     return 0;
 }
 
-int32_t jls_wr_annotation(struct jls_wr_s * self, uint16_t signal_id, int64_t timestamp,
-                          float y,
-                          enum jls_annotation_type_e annotation_type,
-                          uint8_t group_id,
-                          enum jls_storage_type_e storage_type,
-                          const uint8_t * data, uint32_t data_size) {
-    ROE(jls_core_signal_validate(&self->core, signal_id));
-    struct jls_core_s * core = &self->core;
-    struct jls_buf_s * buf = self->core.buf;
-    struct jls_core_signal_s * signal_info = &core->signal_info[signal_id];
-    struct jls_core_track_s * track = &signal_info->tracks[JLS_TRACK_TYPE_ANNOTATION];
+int32_t jls_wr_fsr_suspend(struct jls_wr_s * self, uint16_t signal_id) {
+    ROE(jls_core_signal_validate_typed(&self->core, signal_id, JLS_SIGNAL_TYPE_FSR));
+    return jls_core_fsr_suspend(self->core.signal_info[signal_id].track_fsr);
+}
+
+int32_t jls_wr_fsr_resume(struct jls_wr_s * self, uint16_t signal_id) {
+    ROE(jls_core_signal_validate_typed(&self->core, signal_id, JLS_SIGNAL_TYPE_FSR));
+    return jls_core_fsr_resume(self->core.signal_info[signal_id].track_fsr);
+}
+
+int32_t jls_wr_fsr_ring(struct jls_wr_s * self, uint16_t signal_id, int64_t sample_count) {
+    ROE(jls_core_signal_validate_typed(&self->core, signal_id, JLS_SIGNAL_TYPE_FSR));
+    struct jls_core_signal_s * info = &self->core.signal_info[signal_id];
+    struct jls_signal_def_s * def = &info->signal_def;
+    if (sample_count <= 0) {
+        info->track_fsr->ring_chunks = 0;
+        return 0;
+    }
+    if (JLS_COMPRESSION_NONE != jls_raw_compression_get(self->core.raw)) {
+        JLS_LOGW("ring mode requires uncompressed data chunks");
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    if (JLS_FSR_DATA_ENCODING_DELTA == def->data_encoding) {
+        JLS_LOGW("ring mode requires fixed-size data chunks, not delta encoding");
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    if (self->core.head_defer_en) {
+        JLS_LOGW("ring mode rewrites in place, incompatible with JLS_APPEND_ONLY");
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    uint32_t per_index = (uint32_t) (((uint64_t) def->sample_decimate_factor * def->entries_per_summary)
+            / def->samples_per_data);
+    if (!per_index) {
+        JLS_LOGW("signal %d geometry unsupported for ring mode", (int) signal_id);
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    int64_t ring_chunks = (sample_count + def->samples_per_data - 1) / def->samples_per_data;
+    if (ring_chunks < per_index) {
+        ring_chunks = per_index;  // retain at least one full INDEX block of data chunks
+    }
+    info->track_fsr->ring_chunks = ring_chunks;
+    return 0;
+}
+
+int32_t jls_wr_fsr_summary_inject(struct jls_wr_s * self, uint16_t signal_id,
+                                  const double * entries, uint32_t entry_count) {
+    ROE(jls_core_signal_validate_typed(&self->core, signal_id, JLS_SIGNAL_TYPE_FSR));
+    struct jls_core_fsr_s * fsr = self->core.signal_info[signal_id].track_fsr;
+    free(fsr->inject_entries);
+    fsr->inject_entries = NULL;
+    fsr->inject_count = 0;
+    fsr->inject_offset = 0;
+    if (!entries || !entry_count) {
+        return 0;
+    }
+    if (fsr->parallel_en) {
+        JLS_LOGW("summary inject unsupported with parallel summarization");
+        return JLS_ERROR_NOT_SUPPORTED;
+    }
+    size_t sz = (size_t) entry_count * JLS_SUMMARY_FSR_COUNT * sizeof(double);
+    fsr->inject_entries = malloc(sz);
+    if (!fsr->inject_entries) {
+        return JLS_ERROR_NOT_ENOUGH_MEMORY;
+    }
+    memcpy(fsr->inject_entries, entries, sz);
+    fsr->inject_count = entry_count;
+    return 0;
+}
+
+// Serialize one annotation record, see jls_annotation_s.
+static int32_t anno_wr_record(struct jls_buf_s * buf, int64_t timestamp,
+                              float y,
+                              enum jls_annotation_type_e annotation_type,
+                              uint8_t group_id,
+                              enum jls_storage_type_e storage_type,
+                              const uint8_t * data, uint32_t data_size) {
     if ((annotation_type & 0xff) != annotation_type) {
         return JLS_ERROR_PARAMETER_INVALID;
     }
     if ((storage_type & 0xff) != storage_type) {
         return JLS_ERROR_PARAMETER_INVALID;
     }
-
-    // construct payload
-    jls_buf_reset(buf);
     ROE(jls_buf_wr_i64(buf, timestamp));
-    ROE(jls_buf_wr_u32(buf, 1));  // number of entries
+    ROE(jls_buf_wr_u32(buf, 1));  // number of entries, patched on commit for coalesced chunks
     ROE(jls_buf_wr_u16(buf, 0));  // unspecified entry length
     ROE(jls_buf_wr_u16(buf, 0));  // reserved
     ROE(jls_buf_wr_u8(buf, annotation_type));
@@ -393,38 +737,114 @@ int32_t jls_wr_annotation(struct jls_wr_s * self, uint16_t signal_id, int64_t ti
             ROE(jls_buf_wr_u32(buf, data_size));
             ROE(jls_buf_wr_bin(buf, data, data_size));
             break;
-        case JLS_STORAGE_TYPE_STRING:
-            ROE(jls_buf_wr_u32(buf, (uint32_t) (strlen((const char *) data) + 1)));
-            ROE(jls_buf_wr_str(buf, (const char *) data));
-            break;
-        case JLS_STORAGE_TYPE_JSON:
-            ROE(jls_buf_wr_u32(buf, (uint32_t) (strlen((const char *) data) + 1)));
-            ROE(jls_buf_wr_str(buf, (const char *) data));
+        case JLS_STORAGE_TYPE_STRING:  // intentional fall-through
+        case JLS_STORAGE_TYPE_JSON: {
+            // terminator included in data_size; no unit separator so that
+            // JLS_ANNOTATION_RECORD_SIZE gives the record stride
+            uint32_t sz = (uint32_t) (strlen((const char *) data) + 1);
+            ROE(jls_buf_wr_u32(buf, sz));
+            ROE(jls_buf_wr_bin(buf, data, sz));
             break;
+        }
         default:
             return JLS_ERROR_PARAMETER_INVALID;
     }
+    return 0;
+}
+
+// Write the buffered annotation records as one DATA chunk and index each record.
+static int32_t anno_wr_chunk(struct jls_wr_s * self, uint16_t signal_id,
+                             struct jls_buf_s * buf, uint32_t count) {
+    struct jls_core_s * core = &self->core;
+    struct jls_core_signal_s * signal_info = &core->signal_info[signal_id];
+    struct jls_core_track_s * track = &signal_info->tracks[JLS_TRACK_TYPE_ANNOTATION];
     uint32_t payload_length = (uint32_t) jls_buf_length(buf);
 
+    // the payload starts with jls_payload_header_s: record the count
+    ((struct jls_payload_header_s *) buf->start)->entry_count = count;
+
     // construct header
     struct jls_core_chunk_s chunk;
     uint64_t offset = jls_raw_chunk_tell(core->raw);
     chunk.hdr.item_next = 0;  // update later
-    chunk.hdr.item_prev = signal_info->tracks[JLS_TRACK_TYPE_ANNOTATION].data_head.offset;
+    chunk.hdr.item_prev = track->data_head.offset;
     chunk.hdr.tag = JLS_TAG_TRACK_ANNOTATION_DATA;
-    chunk.hdr.rsv0_u8 = 0;
+    chunk.hdr.compression = JLS_COMPRESSION_NONE;
     chunk.hdr.chunk_meta = signal_id;
     chunk.hdr.payload_length = payload_length;
     chunk.offset = offset;
 
     // write
     ROE(jls_raw_wr(core->raw, &chunk.hdr, buf->start));
-    ROE(jls_core_update_item_head(core, &signal_info->tracks[JLS_TRACK_TYPE_ANNOTATION].data_head, &chunk));
+    ROE(jls_core_update_item_head(core, &track->data_head, &chunk));
     ROE(jls_track_update(track, 0, offset));
-    ROE(jls_wr_ts_anno(signal_info->track_anno, timestamp, offset, annotation_type, group_id, y));
+
+    // every record gets its own index and summary entry
+    uint8_t * p = buf->start;
+    for (uint32_t k = 0; k < count; ++k) {
+        struct jls_annotation_s * annotation = (struct jls_annotation_s *) p;
+        ROE(jls_wr_ts_anno(signal_info->track_anno, annotation->timestamp, offset,
+                           annotation->annotation_type, annotation->group_id, annotation->y));
+        p += JLS_ANNOTATION_RECORD_SIZE(annotation->data_size);
+    }
     return 0;
 }
 
+int32_t jls_wr_annotation_append(struct jls_wr_s * self, uint16_t signal_id, int64_t timestamp,
+                                 float y,
+                                 enum jls_annotation_type_e annotation_type,
+                                 uint8_t group_id,
+                                 enum jls_storage_type_e storage_type,
+                                 const uint8_t * data, uint32_t data_size) {
+    ROE(jls_core_signal_validate(&self->core, signal_id));
+    if (self->anno_batch_count && (signal_id != self->anno_batch_signal_id)) {
+        ROE(jls_wr_annotation_commit(self));
+    }
+    if (NULL == self->anno_batch) {
+        self->anno_batch = jls_buf_alloc();
+        if (NULL == self->anno_batch) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+    }
+    struct jls_buf_s * buf = self->anno_batch;
+    if (0 == self->anno_batch_count) {
+        jls_buf_reset(buf);
+        self->anno_batch_signal_id = signal_id;
+    } else {
+        // records after the first start on 8-byte boundaries
+        uint32_t pad = (uint32_t) ((8 - (jls_buf_length(buf) & 7)) & 7);
+        if (pad) {
+            ROE(jls_buf_wr_zero(buf, pad));
+        }
+    }
+    ROE(anno_wr_record(buf, timestamp, y, annotation_type, group_id, storage_type, data, data_size));
+    ++self->anno_batch_count;
+    if (jls_buf_length(buf) >= ANNO_BATCH_BYTES_MAX) {
+        ROE(jls_wr_annotation_commit(self));
+    }
+    return 0;
+}
+
+int32_t jls_wr_annotation_commit(struct jls_wr_s * self) {
+    if (0 == self->anno_batch_count) {
+        return 0;
+    }
+    uint32_t count = self->anno_batch_count;
+    self->anno_batch_count = 0;
+    return anno_wr_chunk(self, self->anno_batch_signal_id, self->anno_batch, count);
+}
+
+int32_t jls_wr_annotation(struct jls_wr_s * self, uint16_t signal_id, int64_t timestamp,
+                          float y,
+                          enum jls_annotation_type_e annotation_type,
+                          uint8_t group_id,
+                          enum jls_storage_type_e storage_type,
+                          const uint8_t * data, uint32_t data_size) {
+    ROE(jls_wr_annotation_append(self, signal_id, timestamp, y, annotation_type,
+                                 group_id, storage_type, data, data_size));
+    return jls_wr_annotation_commit(self);
+}
+
 int32_t jls_wr_utc(struct jls_wr_s * self, uint16_t signal_id, int64_t sample_id, int64_t utc) {
     ROE(jls_core_signal_validate_typed(&self->core, signal_id, JLS_SIGNAL_TYPE_FSR));
     struct jls_core_signal_s * signal_info = &self->core.signal_info[signal_id];
@@ -448,7 +868,7 @@ int32_t jls_wr_utc(struct jls_wr_s * self, uint16_t signal_id, int64_t sample_id
     chunk.hdr.item_next = 0;  // update later
     chunk.hdr.item_prev = signal_info->tracks[JLS_TRACK_TYPE_UTC].data_head.offset;
     chunk.hdr.tag = JLS_TAG_TRACK_UTC_DATA;
-    chunk.hdr.rsv0_u8 = 0;
+    chunk.hdr.compression = JLS_COMPRESSION_NONE;
     chunk.hdr.chunk_meta = signal_id;
     chunk.hdr.payload_length = payload_length;
     chunk.offset = offset;
@@ -459,5 +879,6 @@ int32_t jls_wr_utc(struct jls_wr_s * self, uint16_t signal_id, int64_t sample_id
     ROE(jls_track_update(track, 0, offset));
 
     ROE(jls_wr_ts_utc(signal_info->track_utc, sample_id, offset, utc));
+    ROE(jls_core_tmap_append(&self->core, signal_id, sample_id, utc));
     return 0;
 }
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jls/xxh64.h"
+#include <string.h>
+
+// XXH64 with seed 0, bit-exact to the public specification:
+// https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+// The core loop is four independent multiply-rotate chains over
+// 32-byte stripes, which stays compute bound on scalar integer
+// units and needs no special instructions.
+
+#define PRIME64_1 (0x9E3779B185EBCA87ULL)
+#define PRIME64_2 (0xC2B2AE3D27D4EB4FULL)
+#define PRIME64_3 (0x165667B19E3779F9ULL)
+#define PRIME64_4 (0x85EBCA77C2B2AE63ULL)
+#define PRIME64_5 (0x27D4EB2F165667C5ULL)
+
+static inline uint64_t rotl64(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+}
+
+// The JLS format and this hash are both little-endian; the memcpy
+// compiles to a single unaligned load on the supported platforms.
+static inline uint64_t rd64(const uint8_t * p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t rd32(const uint8_t * p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t xxh64_round(uint64_t acc, uint64_t input) {
+    acc += input * PRIME64_2;
+    acc = rotl64(acc, 31);
+    acc *= PRIME64_1;
+    return acc;
+}
+
+static inline uint64_t xxh64_merge_round(uint64_t acc, uint64_t val) {
+    acc ^= xxh64_round(0, val);
+    acc = acc * PRIME64_1 + PRIME64_4;
+    return acc;
+}
+
+uint64_t jls_xxh64(const uint8_t * data, size_t length) {
+    const uint8_t * p = data;
+    const uint8_t * end = data + length;
+    uint64_t h;
+
+    if (length >= 32) {
+        uint64_t v1 = PRIME64_1 + PRIME64_2;
+        uint64_t v2 = PRIME64_2;
+        uint64_t v3 = 0;
+        uint64_t v4 = (uint64_t) 0 - PRIME64_1;
+        do {
+            v1 = xxh64_round(v1, rd64(p));
+            v2 = xxh64_round(v2, rd64(p + 8));
+            v3 = xxh64_round(v3, rd64(p + 16));
+            v4 = xxh64_round(v4, rd64(p + 24));
+            p += 32;
+        } while (p <= (end - 32));
+        h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+        h = xxh64_merge_round(h, v1);
+        h = xxh64_merge_round(h, v2);
+        h = xxh64_merge_round(h, v3);
+        h = xxh64_merge_round(h, v4);
+    } else {
+        h = PRIME64_5;
+    }
+
+    h += (uint64_t) length;
+    while ((end - p) >= 8) {
+        h ^= xxh64_round(0, rd64(p));
+        h = rotl64(h, 27) * PRIME64_1 + PRIME64_4;
+        p += 8;
+    }
+    if ((end - p) >= 4) {
+        h ^= ((uint64_t) rd32(p)) * PRIME64_1;
+        h = rotl64(h, 23) * PRIME64_2 + PRIME64_3;
+        p += 4;
+    }
+    while (p < end) {
+        h ^= (*p) * PRIME64_5;
+        h = rotl64(h, 11) * PRIME64_1;
+        ++p;
+    }
+
+    h ^= h >> 33;
+    h *= PRIME64_2;
+    h ^= h >> 29;
+    h *= PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright 2014-2022 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "jls/backend.h"
+#include "jls/ec.h"
+#include "jls/format.h"
+#include "jls/raw.h"
+#include "jls/reader.h"
+#include "jls/writer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+const struct jls_source_def_s SOURCE_1 = {
+        .source_id = 1,
+        .name = "source 1",
+        .vendor = "vendor 1",
+        .model = "model 1",
+        .version = "version 1",
+        .serial_number = "serial_number 1",
+};
+
+const struct jls_signal_def_s SIGNAL_1 = {
+        .signal_id = 1,
+        .source_id = 1,
+        .signal_type = JLS_SIGNAL_TYPE_FSR,
+        .data_type = JLS_DATATYPE_F32,
+        .sample_rate = 100000,
+        .samples_per_data = 1000,
+        .sample_decimate_factor = 100,
+        .entries_per_summary = 200,
+        .summary_decimate_factor = 100,
+        .annotation_decimate_factor = 100,
+        .utc_decimate_factor = 100,
+        .name = "current",
+        .units = "A",
+};
+
+#define SAMPLE_COUNT (10000)
+
+
+// The single in-memory "file", which persists across close and reopen
+// so that a read can follow a write, like the registered S3 use case.
+static struct mem_file_s {
+    uint8_t * data;
+    int64_t size;
+    int64_t alloc;
+} mem_file_;
+
+static void mem_file_reset(void) {
+    if (mem_file_.data) {
+        free(mem_file_.data);
+    }
+    memset(&mem_file_, 0, sizeof(mem_file_));
+}
+
+static int32_t mem_open(struct jls_bkf_s * self, const char * path, const char * mode) {
+    (void) path;
+    switch (mode[0]) {
+        case 'w':
+            mem_file_.size = 0;
+            break;
+        case 'r':  // intentional fall-through
+        case 'a':
+            if (NULL == mem_file_.data) {
+                return JLS_ERROR_IO;
+            }
+            break;
+        default:
+            return JLS_ERROR_PARAMETER_INVALID;
+    }
+    self->user_data = &mem_file_;
+    self->fend = mem_file_.size;
+    return 0;
+}
+
+static int32_t mem_read(struct jls_bkf_s * self, void * buffer, unsigned int count) {
+    struct mem_file_s * f = (struct mem_file_s *) self->user_data;
+    if ((self->fpos + count) > f->size) {
+        return JLS_ERROR_IO;
+    }
+    memcpy(buffer, f->data + self->fpos, count);
+    return 0;
+}
+
+static int32_t mem_write(struct jls_bkf_s * self, const void * buffer, unsigned int count) {
+    struct mem_file_s * f = (struct mem_file_s *) self->user_data;
+    int64_t end = self->fpos + count;
+    if (end > f->alloc) {
+        int64_t alloc = (f->alloc < 4096) ? 4096 : f->alloc;
+        while (alloc < end) {
+            alloc *= 2;
+        }
+        uint8_t * data = realloc(f->data, (size_t) alloc);
+        if (NULL == data) {
+            return JLS_ERROR_NOT_ENOUGH_MEMORY;
+        }
+        f->data = data;
+        f->alloc = alloc;
+    }
+    memcpy(f->data + self->fpos, buffer, count);
+    if (end > f->size) {
+        f->size = end;
+    }
+    return 0;
+}
+
+static int32_t mem_truncate(struct jls_bkf_s * self) {
+    struct mem_file_s * f = (struct mem_file_s *) self->user_data;
+    if (self->fpos < f->size) {
+        f->size = self->fpos;
+    }
+    return 0;
+}
+
+static const struct jls_bk_ops_s mem_ops = {
+        .prefix = "mem://",
+        .open = mem_open,
+        .close = NULL,
+        .read = mem_read,
+        .write = mem_write,
+        .flush = NULL,
+        .truncate = mem_truncate,
+        .readahead = NULL,
+};
+
+static const struct jls_bk_ops_s mem_ops_read_only = {
+        .prefix = "memro://",
+        .open = mem_open,
+        .read = mem_read,
+};
+
+static void test_register(void ** state) {
+    (void) state;
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_bk_register(NULL));
+    assert_int_equal(0, jls_bk_register(&mem_ops));
+    assert_int_equal(JLS_ERROR_ALREADY_EXISTS, jls_bk_register(&mem_ops));
+    assert_ptr_equal(&mem_ops, jls_bk_ops_match("mem://whatever.jls"));
+    assert_null(jls_bk_ops_match("native.jls"));
+    assert_null(jls_bk_ops_match("memo.jls"));
+    assert_int_equal(0, jls_bk_unregister(&mem_ops));
+    assert_int_equal(JLS_ERROR_NOT_FOUND, jls_bk_unregister(&mem_ops));
+    assert_null(jls_bk_ops_match("mem://whatever.jls"));
+}
+
+static void test_write_read(void ** state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    struct jls_rd_s * rd = NULL;
+    float * samples = malloc(sizeof(float) * SAMPLE_COUNT);
+    float * samples_rd = malloc(sizeof(float) * SAMPLE_COUNT);
+    assert_non_null(samples);
+    assert_non_null(samples_rd);
+    for (int i = 0; i < SAMPLE_COUNT; ++i) {
+        samples[i] = (float) i;
+    }
+
+    assert_int_equal(0, jls_bk_register(&mem_ops));
+    assert_int_equal(0, jls_wr_open(&wr, "mem://test.jls"));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_1));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_1));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 1, 0, samples, SAMPLE_COUNT));
+    assert_int_equal(0, jls_wr_close(wr));
+    assert_true(mem_file_.size > 0);
+
+    assert_int_equal(0, jls_rd_open(&rd, "mem://test.jls"));
+    int64_t sample_count = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 1, &sample_count));
+    assert_int_equal(SAMPLE_COUNT, sample_count);
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 1, 0, samples_rd, SAMPLE_COUNT));
+    assert_memory_equal(samples, samples_rd, sizeof(float) * SAMPLE_COUNT);
+    jls_rd_close(rd);
+
+    assert_int_equal(0, jls_bk_unregister(&mem_ops));
+    mem_file_reset();
+    free(samples);
+    free(samples_rd);
+}
+
+static void test_mem_arena(void ** state) {
+    (void) state;
+    const uint8_t payload[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    struct jls_mem_s * mem = NULL;
+    struct jls_raw_s * raw = NULL;
+    struct jls_chunk_header_s hdr;
+    uint8_t data[sizeof(payload) + 16];
+
+    assert_int_equal(0, jls_mem_alloc(&mem));
+    assert_int_equal(0, jls_raw_open_mem(&raw, mem, "w"));
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.tag = JLS_TAG_USER_DATA;
+    hdr.payload_length = sizeof(payload);
+    assert_int_equal(0, jls_raw_wr(raw, &hdr, payload));
+    assert_int_equal(0, jls_raw_close(raw));
+
+    int64_t size = 0;
+    const uint8_t * contents = jls_mem_data(mem, &size);
+    assert_non_null(contents);
+    assert_true(size > (int64_t) (sizeof(struct jls_file_header_s) + sizeof(payload)));
+
+    assert_int_equal(0, jls_raw_open_mem(&raw, mem, "r"));
+    assert_int_equal(0, jls_raw_rd(raw, &hdr, sizeof(data), data));
+    assert_int_equal(JLS_TAG_USER_DATA, hdr.tag);
+    assert_memory_equal(payload, data, sizeof(payload));
+    assert_int_equal(0, jls_raw_close(raw));
+    jls_mem_free(mem);
+}
+
+static void test_read_only_backend(void ** state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    assert_int_equal(0, jls_bk_register(&mem_ops_read_only));
+    assert_int_equal(JLS_ERROR_NOT_SUPPORTED, jls_wr_open(&wr, "memro://test.jls"));
+    assert_int_equal(0, jls_bk_unregister(&mem_ops_read_only));
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(test_register),
+            cmocka_unit_test(test_write_read),
+            cmocka_unit_test(test_mem_arena),
+            cmocka_unit_test(test_read_only_backend),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -50,11 +50,38 @@ static void test_8(void **state) {
     assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_bit_shift_array_right(8, data_u32, sizeof(data_u32)));
 }
 
+static void shift_right_ref(uint8_t bits, uint8_t * u8, size_t size) {
+    uint8_t carry = u8[0] >> bits;
+    for (size_t i = 1; i < size; ++i) {
+        u8[i - 1] = (u8[i] << (8 - bits)) | carry;
+        carry = u8[i] >> bits;
+    }
+}
+
+static void test_large(void **state) {
+    // exercise the SIMD path and its scalar tail at every size remainder
+    (void) state;
+    uint8_t data[257];
+    uint8_t expect[sizeof(data)];
+    for (size_t size = 2; size <= sizeof(data); size += 5) {
+        for (int bits = 1; bits < 8; ++bits) {
+            for (size_t i = 0; i < size; ++i) {
+                data[i] = (uint8_t) (i * 17 + bits);
+                expect[i] = data[i];
+            }
+            shift_right_ref((uint8_t) bits, expect, size);
+            assert_int_equal(0, jls_bit_shift_array_right((uint8_t) bits, data, size));
+            assert_memory_equal(expect, data, size);
+        }
+    }
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(test_0),
             cmocka_unit_test(test_n),
             cmocka_unit_test(test_8),
+            cmocka_unit_test(test_large),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
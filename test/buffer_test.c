@@ -20,6 +20,7 @@
 #include <cmocka.h>
 #include "jls/buffer.h"
 #include "jls/ec.h"
+#include <inttypes.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -51,6 +52,8 @@ static void test_string_save(void **state) {
     (void) state;
     const char * str1 = "abcdefghijklmnopqrstuvwxyz0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
     char * str2 = NULL;
+    char str[80];
+    jls_buf_pool_clear();  // ensure a fresh instance, not a pooled one
     struct jls_buf_s * b = jls_buf_alloc();
     assert_non_null(b);
     assert_null(b->strings_tail);
@@ -58,13 +61,86 @@ static void test_string_save(void **state) {
     assert_non_null(b->strings_tail);
     assert_non_null(b->strings_head);
     struct jls_buf_strings_s * s = b->strings_tail;
+    uint32_t idx = 0;
     while (s == b->strings_tail) {
-        assert_int_equal(0, jls_buf_string_save(b, str1, &str2));
-        assert_string_equal(str1, str2);
+        snprintf(str, sizeof(str), "%s_%" PRIu32, str1, idx++);
+        assert_int_equal(0, jls_buf_string_save(b, str, &str2));
+        assert_string_equal(str, str2);
     }
     jls_buf_free(b);
 }
 
+static void test_string_save_intern(void **state) {
+    (void) state;
+    const char * str1 = "interned string";
+    char str[64];
+    char * save1 = NULL;
+    char * save2 = NULL;
+    struct jls_buf_s * b = jls_buf_alloc();
+    assert_non_null(b);
+    assert_int_equal(0, jls_buf_string_save(b, str1, &save1));
+
+    // repeated saves return the shared copy without consuming storage
+    char * arena_cur = b->strings_tail->cur;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        assert_int_equal(0, jls_buf_string_save(b, str1, &save2));
+        assert_ptr_equal(save1, save2);
+    }
+    assert_ptr_equal(arena_cur, b->strings_tail->cur);
+
+    // distinct strings get distinct copies, found again on re-save
+    for (uint32_t i = 0; i < 200; ++i) {
+        snprintf(str, sizeof(str), "string_%" PRIu32, i);
+        assert_int_equal(0, jls_buf_string_save(b, str, &save1));
+        assert_int_equal(0, jls_buf_string_save(b, str, &save2));
+        assert_ptr_equal(save1, save2);
+        assert_string_equal(str, save1);
+        assert_ptr_not_equal(save1, str);
+    }
+    jls_buf_free(b);
+}
+
+static void test_pool_reuse(void **state) {
+    (void) state;
+    char * saved = NULL;
+    jls_buf_pool_clear();
+    struct jls_buf_s * a = jls_buf_alloc();
+    assert_non_null(a);
+    uint8_t * start = a->start;
+    assert_int_equal(0, jls_buf_wr_u32(a, 42));
+    assert_int_equal(0, jls_buf_string_save(a, "pooled", &saved));
+    jls_buf_free(a);
+
+    // the freed instance is recycled, fully reset
+    struct jls_buf_s * b = jls_buf_alloc();
+    assert_ptr_equal(a, b);
+    assert_ptr_equal(start, b->start);
+    assert_int_equal(0, jls_buf_length(b));
+    assert_int_equal(0, b->intern_count);
+    assert_ptr_equal(b->strings_tail->cur, b->strings_tail->buffer);
+    assert_int_equal(0, jls_buf_string_save(b, "pooled", &saved));
+    assert_string_equal("pooled", saved);
+    jls_buf_free(b);
+    jls_buf_pool_clear();
+}
+
+static void test_rd_str_intern(void **state) {
+    (void) state;
+    const char * stra = "annotation text";
+    const char * strb = NULL;
+    const char * strc = NULL;
+    struct jls_buf_s * b = jls_buf_alloc();
+    assert_non_null(b);
+    assert_int_equal(0, jls_buf_wr_str(b, stra));
+    assert_int_equal(0, jls_buf_wr_str(b, stra));
+    b->cur = b->start;
+    assert_int_equal(0, jls_buf_rd_str(b, &strb));
+    assert_int_equal(0, jls_buf_rd_str(b, &strc));
+    assert_string_equal(stra, strb);
+    assert_ptr_equal(strb, strc);  // second read returns the interned copy
+    jls_buf_free(b);
+}
+
 static void test_wr_rd(void **state) {
     (void) state;
     const char * stra = "hello world!";
@@ -115,6 +191,9 @@ int main(void) {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(test_empty),
             cmocka_unit_test(test_string_save),
+            cmocka_unit_test(test_string_save_intern),
+            cmocka_unit_test(test_rd_str_intern),
+            cmocka_unit_test(test_pool_reuse),
             cmocka_unit_test(test_wr_rd),
     };
 
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2023 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "jls/chunk_cache.h"
+#include "jls/ec.h"
+#include <stdio.h>
+#include <string.h>
+
+
+static struct jls_chunk_header_s hdr_new(uint32_t payload_length) {
+    struct jls_chunk_header_s hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.tag = JLS_TAG_TRACK_FSR_DATA;
+    hdr.payload_length = payload_length;
+    return hdr;
+}
+
+static void test_alloc_invalid(void **state) {
+    (void) state;
+    struct jls_chunk_cache_s * c = NULL;
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_chunk_cache_alloc(NULL, 4096));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_chunk_cache_alloc(&c, 0));
+    jls_chunk_cache_free(NULL);
+}
+
+static void test_put_get(void **state) {
+    (void) state;
+    struct jls_chunk_cache_s * c = NULL;
+    assert_int_equal(0, jls_chunk_cache_alloc(&c, 1 << 20));
+
+    uint8_t payload[256];
+    for (size_t i = 0; i < sizeof(payload); ++i) {
+        payload[i] = (uint8_t) i;
+    }
+    struct jls_chunk_header_s hdr = hdr_new(sizeof(payload));
+    struct jls_chunk_header_s hdr_rd;
+    const uint8_t * payload_rd = NULL;
+
+    assert_int_equal(JLS_ERROR_NOT_FOUND, jls_chunk_cache_get(c, 32, &hdr_rd, &payload_rd));
+    assert_int_equal(0, jls_chunk_cache_put(c, 32, &hdr, payload));
+    assert_int_equal(0, jls_chunk_cache_get(c, 32, &hdr_rd, &payload_rd));
+    assert_int_equal(sizeof(payload), hdr_rd.payload_length);
+    assert_memory_equal(payload, payload_rd, sizeof(payload));
+    assert_int_equal(JLS_ERROR_NOT_FOUND, jls_chunk_cache_get(c, 64, &hdr_rd, &payload_rd));
+
+    jls_chunk_cache_free(c);
+}
+
+static void test_evict_lru(void **state) {
+    (void) state;
+    struct jls_chunk_cache_s * c = NULL;
+    uint8_t payload[1024];
+    memset(payload, 0xA5, sizeof(payload));
+    struct jls_chunk_header_s hdr = hdr_new(sizeof(payload));
+    struct jls_chunk_header_s hdr_rd;
+    const uint8_t * payload_rd = NULL;
+
+    // room for roughly 4 entries
+    assert_int_equal(0, jls_chunk_cache_alloc(&c, 4 * 1200));
+    for (int64_t i = 0; i < 4; ++i) {
+        assert_int_equal(0, jls_chunk_cache_put(c, i * 2048, &hdr, payload));
+    }
+    // touch the oldest entry so that it survives the next eviction
+    assert_int_equal(0, jls_chunk_cache_get(c, 0, &hdr_rd, &payload_rd));
+    assert_int_equal(0, jls_chunk_cache_put(c, 4 * 2048, &hdr, payload));
+    assert_int_equal(0, jls_chunk_cache_get(c, 0, &hdr_rd, &payload_rd));
+    assert_int_equal(JLS_ERROR_NOT_FOUND, jls_chunk_cache_get(c, 1 * 2048, &hdr_rd, &payload_rd));
+    assert_int_equal(0, jls_chunk_cache_get(c, 4 * 2048, &hdr_rd, &payload_rd));
+
+    jls_chunk_cache_free(c);
+}
+
+static void test_put_too_big(void **state) {
+    (void) state;
+    struct jls_chunk_cache_s * c = NULL;
+    uint8_t payload[1024];
+    memset(payload, 0x5A, sizeof(payload));
+    struct jls_chunk_header_s hdr = hdr_new(sizeof(payload));
+    struct jls_chunk_header_s hdr_rd;
+    const uint8_t * payload_rd = NULL;
+
+    assert_int_equal(0, jls_chunk_cache_alloc(&c, 2048));
+    assert_int_equal(0, jls_chunk_cache_put(c, 32, &hdr, payload));  // > size_max / 4, ignored
+    assert_int_equal(JLS_ERROR_NOT_FOUND, jls_chunk_cache_get(c, 32, &hdr_rd, &payload_rd));
+
+    jls_chunk_cache_free(c);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(test_alloc_invalid),
+            cmocka_unit_test(test_put_get),
+            cmocka_unit_test(test_evict_lru),
+            cmocka_unit_test(test_put_too_big),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
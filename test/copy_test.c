@@ -0,0 +1,379 @@
+/*
+ * Copyright 2023 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "jls/copy.h"
+#include "jls/ec.h"
+#include "jls/format.h"
+#include "jls/raw.h"
+#include "jls/reader.h"
+#include "jls/verify.h"
+#include "jls/writer.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+
+static const char * src_filename = "jls_copy_test_src_tmp.jls";
+static const char * dst_filename = "jls_copy_test_dst_tmp.jls";
+
+static const struct jls_source_def_s SOURCE_1 = {
+        .source_id = 1,
+        .name = "source 1",
+        .vendor = "vendor",
+        .model = "model",
+        .version = "version",
+        .serial_number = "serial_number",
+};
+
+static const struct jls_signal_def_s SIGNAL_1 = {
+        .signal_id = 1,
+        .source_id = 1,
+        .signal_type = JLS_SIGNAL_TYPE_FSR,
+        .data_type = JLS_DATATYPE_F32,
+        .sample_rate = 100000,
+        .samples_per_data = 1000,
+        .sample_decimate_factor = 100,
+        .entries_per_summary = 200,
+        .summary_decimate_factor = 100,
+        .annotation_decimate_factor = 100,
+        .utc_decimate_factor = 100,
+        .name = "current",
+        .units = "A",
+};
+
+#define SAMPLE_COUNT (100000)
+
+static void gen_src(float * signal) {
+    for (int64_t i = 0; i < SAMPLE_COUNT; ++i) {
+        signal[i] = (float) (i % 1000) * 0.001f;
+    }
+    struct jls_wr_s * wr = NULL;
+    assert_int_equal(0, jls_wr_open(&wr, src_filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_1));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_1));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 1, 0, signal, SAMPLE_COUNT));
+    assert_int_equal(0, jls_wr_close(wr));
+}
+
+static int64_t file_size(const char * path) {
+    FILE * f = fopen(path, "rb");
+    assert_non_null(f);
+    assert_int_equal(0, fseek(f, 0, SEEK_END));
+    int64_t sz = ftell(f);
+    fclose(f);
+    return sz;
+}
+
+static void test_copy(void **state) {
+    (void) state;
+    float * signal = malloc(sizeof(float) * SAMPLE_COUNT);
+    assert_non_null(signal);
+    gen_src(signal);
+
+    assert_int_equal(0, jls_copy(src_filename, dst_filename, NULL, NULL, NULL, NULL));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, dst_filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 1, &samples));
+    assert_int_equal(SAMPLE_COUNT, samples);
+    float * y = malloc(sizeof(float) * SAMPLE_COUNT);
+    assert_non_null(y);
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 1, 0, y, SAMPLE_COUNT));
+    assert_memory_equal(signal, y, SAMPLE_COUNT * sizeof(float));
+    jls_rd_close(rd);
+
+    free(y);
+    free(signal);
+    remove(src_filename);
+    remove(dst_filename);
+}
+
+static void test_copy_downsample(void **state) {
+    (void) state;
+    float * signal = malloc(sizeof(float) * SAMPLE_COUNT);
+    assert_non_null(signal);
+    gen_src(signal);
+
+    assert_int_equal(0, jls_copy_downsample(src_filename, dst_filename, NULL, NULL, NULL, NULL));
+    assert_true(file_size(dst_filename) < (file_size(src_filename) / 4));
+
+    struct jls_rd_s * rd_src = NULL;
+    struct jls_rd_s * rd_dst = NULL;
+    assert_int_equal(0, jls_rd_open(&rd_src, src_filename));
+    assert_int_equal(0, jls_rd_open(&rd_dst, dst_filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd_dst, 1, &samples));
+    // the trailing samples not covered by a complete level-1 summary
+    // entry cannot be retained without level 0 data
+    struct jls_signal_def_s def;
+    assert_int_equal(0, jls_rd_signal(rd_dst, 1, &def));
+    assert_true(samples > (SAMPLE_COUNT - (int64_t) def.sample_decimate_factor));
+    assert_true(samples <= SAMPLE_COUNT);
+
+    // summaries are computed from the same samples: min/max match
+    // exactly, while the mean varies in the last bits with the
+    // writer's summation order
+    const int64_t incr = 30 * (int64_t) def.sample_decimate_factor;
+    double stats_src[30][JLS_SUMMARY_FSR_COUNT];
+    double stats_dst[30][JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd_src, 1, 0, incr, stats_src[0], 30));
+    assert_int_equal(0, jls_rd_fsr_statistics(rd_dst, 1, 0, incr, stats_dst[0], 30));
+    for (int i = 0; i < 30; ++i) {
+        assert_float_equal(stats_src[i][JLS_SUMMARY_FSR_MEAN], stats_dst[i][JLS_SUMMARY_FSR_MEAN], 1e-4);
+        assert_float_equal(stats_src[i][JLS_SUMMARY_FSR_MIN], stats_dst[i][JLS_SUMMARY_FSR_MIN], 1e-9);
+        assert_float_equal(stats_src[i][JLS_SUMMARY_FSR_MAX], stats_dst[i][JLS_SUMMARY_FSR_MAX], 1e-9);
+    }
+
+    // sample reads reconstruct synthetic data from the summaries:
+    // individual samples are noise, but the window mean is preserved
+    float * y = malloc(sizeof(float) * 1000);
+    assert_non_null(y);
+    assert_int_equal(0, jls_rd_fsr_f32(rd_dst, 1, 50000, y, 1000));
+    double mean = 0.0;
+    for (int i = 0; i < 1000; ++i) {
+        mean += y[i];
+    }
+    mean /= 1000.0;
+    assert_float_equal(0.5, mean, 0.05);
+
+    jls_rd_close(rd_src);
+    jls_rd_close(rd_dst);
+    free(y);
+    free(signal);
+    remove(src_filename);
+    remove(dst_filename);
+}
+
+static void test_transcode(void **state) {
+    (void) state;
+    float * signal = malloc(sizeof(float) * SAMPLE_COUNT);
+    assert_non_null(signal);
+    gen_src(signal);
+
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_transcode(src_filename, dst_filename, JLS_DATATYPE_U16,
+                                   NULL, NULL, NULL, NULL));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_transcode(src_filename, dst_filename, JLS_DATATYPE_DEF(INT, 16, 4),
+                                   NULL, NULL, NULL, NULL));
+    assert_int_equal(0, jls_transcode(src_filename, dst_filename, JLS_DATATYPE_I16,
+                                      NULL, NULL, NULL, NULL));
+    assert_true(file_size(dst_filename) < ((3 * file_size(src_filename)) / 4));
+
+    struct jls_rd_s * rd_src = NULL;
+    struct jls_rd_s * rd_dst = NULL;
+    assert_int_equal(0, jls_rd_open(&rd_src, src_filename));
+    assert_int_equal(0, jls_rd_open(&rd_dst, dst_filename));
+
+    // max|x| is just below 1.0, so the computed q keeps 15 fraction bits
+    struct jls_signal_def_s def;
+    assert_int_equal(0, jls_rd_signal(rd_dst, 1, &def));
+    assert_int_equal(JLS_DATATYPE_BASETYPE_INT, jls_datatype_parse_basetype(def.data_type));
+    assert_int_equal(16, jls_datatype_parse_size(def.data_type));
+    assert_int_equal(15, jls_datatype_parse_q(def.data_type));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd_dst, 1, &samples));
+    assert_int_equal(SAMPLE_COUNT, samples);
+
+    // each sample rounds to the nearest 2**-15 step
+    int16_t * y = malloc(sizeof(int16_t) * 1000);
+    assert_non_null(y);
+    assert_int_equal(0, jls_rd_fsr(rd_dst, 1, 1500, y, 1000));
+    for (int i = 0; i < 1000; ++i) {
+        double v = y[i] / 32768.0;
+        assert_float_equal(signal[1500 + i], v, 1.0 / 32768.0);
+    }
+
+    // small increments compute from level 0 exactly: only the
+    // quantization separates the statistics (coarse increments
+    // approximate from each file's own summary tree, whose chunk
+    // geometry differs between f32 and i16)
+    double stats_src[10][JLS_SUMMARY_FSR_COUNT];
+    double stats_dst[10][JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd_src, 1, 0, 64, stats_src[0], 10));
+    assert_int_equal(0, jls_rd_fsr_statistics(rd_dst, 1, 0, 64, stats_dst[0], 10));
+    for (int i = 0; i < 10; ++i) {
+        assert_float_equal(stats_src[i][JLS_SUMMARY_FSR_MEAN], stats_dst[i][JLS_SUMMARY_FSR_MEAN], 1e-4);
+        assert_float_equal(stats_src[i][JLS_SUMMARY_FSR_MIN], stats_dst[i][JLS_SUMMARY_FSR_MIN], 1e-4);
+        assert_float_equal(stats_src[i][JLS_SUMMARY_FSR_MAX], stats_dst[i][JLS_SUMMARY_FSR_MAX], 1e-4);
+    }
+
+    jls_rd_close(rd_src);
+    jls_rd_close(rd_dst);
+    free(y);
+    free(signal);
+    remove(src_filename);
+    remove(dst_filename);
+}
+
+static void test_fsr_erase(void **state) {
+    (void) state;
+    float * signal = malloc(sizeof(float) * SAMPLE_COUNT);
+    assert_non_null(signal);
+    gen_src(signal);
+
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_fsr_erase(src_filename, 1, 100, 100, NULL, NULL));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_fsr_erase(src_filename, 1, -1, 100, NULL, NULL));
+    assert_int_equal(JLS_ERROR_NOT_FOUND, jls_fsr_erase(src_filename, 2, 0, 100, NULL, NULL));
+
+    // erase mid-chunk to mid-file: chunk 20 is zeroed partially in
+    // place, chunks 21 through 49 become omitted
+    assert_int_equal(0, jls_fsr_erase(src_filename, 1, 20500, 50000, NULL, NULL));
+    assert_int_equal(0, jls_verify(src_filename, 0, NULL, NULL));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, src_filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 1, &samples));
+    assert_int_equal(SAMPLE_COUNT, samples);
+
+    float * y = malloc(sizeof(float) * SAMPLE_COUNT);
+    assert_non_null(y);
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 1, 0, y, SAMPLE_COUNT));
+    assert_memory_equal(signal, y, 20500 * sizeof(float));
+    assert_memory_equal(signal + 50000, y + 50000, (SAMPLE_COUNT - 50000) * sizeof(float));
+    for (int64_t i = 20500; i < 50000; ++i) {
+        assert_float_equal(0.0f, y[i], 0.0);
+    }
+
+    // the patched summaries report the erased region as zero
+    double stats[JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 1, 21000, 29000, stats, 1));
+    assert_float_equal(0.0, stats[JLS_SUMMARY_FSR_MEAN], 1e-9);
+    assert_float_equal(0.0, stats[JLS_SUMMARY_FSR_MIN], 1e-9);
+    assert_float_equal(0.0, stats[JLS_SUMMARY_FSR_MAX], 1e-9);
+    assert_float_equal(0.0, stats[JLS_SUMMARY_FSR_STD], 1e-9);
+    jls_rd_close(rd);
+
+    free(y);
+    free(signal);
+    remove(src_filename);
+}
+
+// overwrite every summary chunk payload for signal 1 with garbage
+static void corrupt_summaries(void) {
+    struct jls_raw_s * raw = NULL;
+    struct jls_chunk_header_s hdr;
+    uint8_t * payload = NULL;
+    size_t payload_alloc = 0;
+    int corrupted = 0;
+    assert_int_equal(0, jls_raw_open(&raw, src_filename, "a"));
+    assert_int_equal(0, jls_raw_chunk_seek(raw, sizeof(struct jls_file_header_s)));
+    while (1) {
+        int64_t offset = jls_raw_chunk_tell(raw);
+        int32_t rc = jls_raw_rd_header(raw, &hdr);
+        if ((JLS_ERROR_EMPTY == rc) || ((0 == rc) && (JLS_TAG_END == hdr.tag))) {
+            break;
+        }
+        assert_int_equal(0, rc);
+        if ((JLS_TAG_TRACK_FSR_SUMMARY == hdr.tag) && (1 == (hdr.chunk_meta & 0x0fff))) {
+            // the read buffer must also hold the pad and CRC32 footer
+            size_t sz = (hdr.payload_length + 4 + 7) & ~((size_t) 7);
+            if (payload_alloc < sz) {
+                free(payload);
+                payload = malloc(sz);
+                assert_non_null(payload);
+                payload_alloc = sz;
+            }
+            assert_int_equal(0, jls_raw_rd_payload(raw, (uint32_t) sz, payload));
+            struct jls_fsr_f32_summary_s * s = (struct jls_fsr_f32_summary_s *) payload;
+            for (uint32_t i = 0; i < s->header.entry_count; ++i) {
+                for (int k = 0; k < JLS_SUMMARY_FSR_COUNT; ++k) {
+                    s->data[i][k] = 1234.5f;
+                }
+            }
+            assert_int_equal(0, jls_raw_chunk_seek(raw, offset));
+            assert_int_equal(0, jls_raw_wr_header(raw, &hdr));
+            assert_int_equal(0, jls_raw_wr_payload(raw, hdr.payload_length, payload));
+            ++corrupted;
+            int64_t next = offset + sizeof(struct jls_chunk_header_s)
+                    + ((hdr.payload_length + 4 + 7) & ~((int64_t) 7));
+            assert_int_equal(0, jls_raw_chunk_seek(raw, next));
+        } else {
+            rc = jls_raw_chunk_next(raw);
+            if (JLS_ERROR_EMPTY == rc) {
+                break;
+            }
+            assert_int_equal(0, rc);
+        }
+    }
+    assert_true(corrupted > 0);
+    free(payload);
+    jls_raw_close(raw);
+}
+
+static void test_fsr_resummarize(void **state) {
+    (void) state;
+    float * signal = malloc(sizeof(float) * SAMPLE_COUNT);
+    assert_non_null(signal);
+    gen_src(signal);
+
+    const int64_t incr = 30 * (int64_t) SIGNAL_1.sample_decimate_factor;
+    double stats_orig[30][JLS_SUMMARY_FSR_COUNT];
+    double stats[30][JLS_SUMMARY_FSR_COUNT];
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, src_filename));
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 1, 0, incr, stats_orig[0], 30));
+    jls_rd_close(rd);
+
+    corrupt_summaries();
+
+    // the corrupted summaries report garbage statistics
+    assert_int_equal(0, jls_rd_open(&rd, src_filename));
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 1, 0, incr, stats[0], 30));
+    jls_rd_close(rd);
+    assert_true(fabs(stats[0][JLS_SUMMARY_FSR_MEAN] - stats_orig[0][JLS_SUMMARY_FSR_MEAN]) > 1.0);
+
+    assert_int_equal(0, jls_fsr_resummarize(src_filename, NULL, NULL, NULL, NULL));
+    assert_int_equal(0, jls_verify(src_filename, 0, NULL, NULL));
+
+    // the rebuilt summaries match the writer's originals
+    assert_int_equal(0, jls_rd_open(&rd, src_filename));
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 1, 0, incr, stats[0], 30));
+    for (int i = 0; i < 30; ++i) {
+        assert_float_equal(stats_orig[i][JLS_SUMMARY_FSR_MEAN], stats[i][JLS_SUMMARY_FSR_MEAN], 1e-4);
+        assert_float_equal(stats_orig[i][JLS_SUMMARY_FSR_MIN], stats[i][JLS_SUMMARY_FSR_MIN], 1e-9);
+        assert_float_equal(stats_orig[i][JLS_SUMMARY_FSR_MAX], stats[i][JLS_SUMMARY_FSR_MAX], 1e-9);
+        assert_float_equal(stats_orig[i][JLS_SUMMARY_FSR_STD], stats[i][JLS_SUMMARY_FSR_STD], 1e-4);
+    }
+
+    // the level 0 data chunks are untouched
+    float * y = malloc(sizeof(float) * SAMPLE_COUNT);
+    assert_non_null(y);
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 1, 0, y, SAMPLE_COUNT));
+    assert_memory_equal(signal, y, SAMPLE_COUNT * sizeof(float));
+    jls_rd_close(rd);
+
+    free(y);
+    free(signal);
+    remove(src_filename);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(test_copy),
+            cmocka_unit_test(test_copy_downsample),
+            cmocka_unit_test(test_transcode),
+            cmocka_unit_test(test_fsr_erase),
+            cmocka_unit_test(test_fsr_resummarize),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
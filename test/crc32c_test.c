@@ -38,7 +38,7 @@ static void test_hdr(void **state) {
             .item_next = 1,
             .item_prev = 2,
             .tag = 3,
-            .rsv0_u8 = 0,
+            .compression = JLS_COMPRESSION_NONE,
             .chunk_meta = 4,
             .payload_length = 5,
             .payload_prev_length = 6,
@@ -48,10 +48,40 @@ static void test_hdr(void **state) {
     assert_int_equal(c, jls_crc32c_hdr(&hdr));
 }
 
+static uint32_t crc32c_ref(const uint8_t * data, uint32_t length) {
+    // bitwise reference, CRC-32C reflected polynomial
+    uint32_t crc = 0xFFFFFFFFU;
+    for (uint32_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; ++b) {
+            crc = (crc >> 1) ^ (0x82f63b78U & (0 - (crc & 1)));
+        }
+    }
+    return crc ^ 0xFFFFFFFFU;
+}
+
+static void test_large(void **state) {
+    (void) state;
+    // cover the interleaved multi-stream paths and their merge
+    static uint8_t data[3 * 8192 * 2 + 129];
+    uint32_t x = 0x12345678;
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        x = x * 134775813U + 1U;
+        data[i] = (uint8_t) (x >> 24);
+    }
+    uint32_t lengths[] = {9, 255, 768, 769, 4096, 24576, 24577, sizeof(data)};
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); ++i) {
+        assert_int_equal(crc32c_ref(data, lengths[i]), jls_crc32c(data, lengths[i]));
+        // unaligned start exercises the alignment preamble
+        assert_int_equal(crc32c_ref(data + 1, lengths[i] - 1), jls_crc32c(data + 1, lengths[i] - 1));
+    }
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(test_bytes),
             cmocka_unit_test(test_hdr),
+            cmocka_unit_test(test_large),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
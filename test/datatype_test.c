@@ -156,6 +156,31 @@ static void test_f64(void **state) {
     VALIDATE(src, JLS_DATATYPE_F64);
 }
 
+static void test_i16_large(void **state) {
+    // exercise the SIMD path and its scalar tail
+    (void) state;
+    int16_t src[67];
+    for (size_t i = 0; i < ARRAY_SIZE(src); ++i) {
+        src[i] = (int16_t) (i * 1021 - 32768);
+    }
+    VALIDATE(src, JLS_DATATYPE_I16);
+}
+
+static void test_fixed_point(void **state) {
+    (void) state;
+    int16_t src[] = {0, 1, -1, 256, -256, 32767, -32768};
+    double dst[ARRAY_SIZE(src)];
+    assert_int_equal(0, jls_dt_buffer_to_f64(src, JLS_DATATYPE_DEF(INT, 16, 8), dst, ARRAY_SIZE(src)));
+    for (size_t i = 0; i < ARRAY_SIZE(src); ++i) {
+        assert_float_equal(((double) src[i]) / 256.0, dst[i], 1e-15);
+    }
+    uint16_t usrc[] = {0, 1, 16, 65535};
+    assert_int_equal(0, jls_dt_buffer_to_f64(usrc, JLS_DATATYPE_DEF(UINT, 16, 4), dst, ARRAY_SIZE(usrc)));
+    for (size_t i = 0; i < ARRAY_SIZE(usrc); ++i) {
+        assert_float_equal(((double) usrc[i]) / 16.0, dst[i], 1e-15);
+    }
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(test_u1),
@@ -173,6 +198,9 @@ int main(void) {
 
             cmocka_unit_test(test_f32),
             cmocka_unit_test(test_f64),
+
+            cmocka_unit_test(test_i16_large),
+            cmocka_unit_test(test_fixed_point),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -79,6 +79,17 @@ const struct jls_signal_def_s SIGNAL_3 = {
 #define WINDOW_SIZE (937)
 
 
+static int64_t file_size(const char * path) {
+    FILE * f = fopen(path, "rb");
+    if (!f) {
+        return 0;
+    }
+    fseek(f, 0, SEEK_END);
+    int64_t sz = ftell(f);
+    fclose(f);
+    return sz;
+}
+
 static uint64_t random_next(uint64_t random) {
     return ((random ^ (random >> 8)) + 1) * 2654435761ULL;
 }
@@ -194,6 +205,51 @@ static void test_summary(void **state) {
     // remove(filename);
 }
 
+static void test_omit_mode_mean_and_cache(void **state) {
+    (void) state;
+    int64_t sample_count = 4 * ((int64_t) SIGNAL_1.sample_rate);
+    float * signal = gen_jls(sample_count);
+    assert_non_null(signal);
+
+    float * y = malloc(sizeof(float) * 1000);
+    assert_non_null(y);
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_cache(rd, 1 << 20));
+    assert_int_equal(0, jls_rd_omit_mode(rd, JLS_RD_OMIT_MODE_MEAN));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_omit_mode(rd, (enum jls_rd_omit_mode_e) 2));
+
+    // omitted region: mean fill matches the signal and is constant
+    // within each summary entry (no per-sample noise synthesis)
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 1, 150000, y, 1000));
+    uint32_t transitions = 0;
+    for (int64_t i = 0; i < 1000; ++i) {
+        assert_float_equal(signal[150000 + i], y[i], 10e-6);
+        if (i && (y[i] != y[i - 1])) {
+            ++transitions;
+        }
+    }
+    assert_true(transitions <= (1000 / SIGNAL_1.sample_decimate_factor) + 1);
+
+    // a repeated read serves the reconstructed chunk from the cache
+    struct jls_rd_counters_s counters_before;
+    struct jls_rd_counters_s counters_after;
+    assert_int_equal(0, jls_rd_counters(rd, &counters_before));
+    float * y2 = malloc(sizeof(float) * 1000);
+    assert_non_null(y2);
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 1, 150000, y2, 1000));
+    assert_int_equal(0, jls_rd_counters(rd, &counters_after));
+    assert_true(counters_after.cache_hits > counters_before.cache_hits);
+    assert_memory_equal(y, y2, 1000 * sizeof(float));
+
+    jls_rd_close(rd);
+    free(signal);
+    free(y);
+    free(y2);
+    remove(filename);
+}
+
 static void test_u4(void **state) {
     (void) state;
     struct jls_wr_s * wr = NULL;
@@ -240,6 +296,131 @@ static void test_u4(void **state) {
     }
 }
 
+static void test_const_f32(void **state) {
+    // Constant-valued data chunks store one sample plus the count
+    // (JLS_FSR_DATA_ENCODING_CONST).  Unlike omitted data, which is
+    // reconstructed from the summaries, the round trip is bit exact.
+    (void) state;
+    const int64_t sample_count = 400000;
+    const int64_t varying_count = 10000;
+    float * y = malloc(sizeof(float) * (size_t) sample_count);
+    assert_non_null(y);
+    for (int64_t i = 0; i < sample_count; ++i) {
+        y[i] = (i < varying_count) ? sinf((float) i * 0.01f) : 1.25f;
+    }
+
+    struct jls_wr_s * wr = NULL;
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_1));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_1));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 1, 0, y, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+    int64_t sz_const = file_size(filename);
+
+    float * y_rd = malloc(sizeof(float) * (size_t) sample_count);
+    assert_non_null(y_rd);
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 1, &samples));
+    assert_int_equal(sample_count, samples);
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 1, 0, y_rd, (uint32_t) sample_count));
+    assert_memory_equal(y, y_rd, sizeof(float) * (size_t) sample_count);
+    jls_rd_close(rd);
+    remove(filename);
+
+    // the same recording without the constant run is much larger
+    for (int64_t i = varying_count; i < sample_count; ++i) {
+        y[i] = sinf((float) i * 0.01f);
+    }
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_1));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_1));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 1, 0, y, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+    int64_t sz_full = file_size(filename);
+    assert_true(sz_const < (sz_full / 2));
+
+    free(y);
+    free(y_rd);
+    remove(filename);
+}
+
+static void test_mirror(void **state) {
+    (void) state;
+    const char * mirror_filename = "jls_test_fsr_mirror_tmp.jls";
+    int64_t sample_count = 4 * ((int64_t) SIGNAL_1.sample_rate);
+    float * y = malloc(sizeof(float) * (size_t) sample_count);
+    assert_non_null(y);
+    for (int64_t i = 0; i < sample_count; ++i) {
+        y[i] = (i % 1000) * 0.001f;
+    }
+
+    struct jls_wr_s * wr = NULL;
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_1));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_1));
+    assert_int_equal(0, jls_wr_mirror_open(wr, mirror_filename));
+    assert_int_equal(JLS_ERROR_ALREADY_EXISTS, jls_wr_mirror_open(wr, mirror_filename));
+    for (int64_t sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        int64_t k = sample_count - sample_id;
+        k = (k < WINDOW_SIZE) ? k : WINDOW_SIZE;
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 1, sample_id, y + sample_id, (uint32_t) k));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    struct jls_rd_s * rd_mirror = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_open(&rd_mirror, mirror_filename));
+
+    // mirror omits level 0 data, so it is much smaller than the primary
+    assert_true(file_size(mirror_filename) < (file_size(filename) / 4));
+
+    // the writer may round up the sample_decimate_factor
+    struct jls_signal_def_s def;
+    assert_int_equal(0, jls_rd_signal(rd, 1, &def));
+    int64_t incr = def.sample_decimate_factor;
+
+    // mirror may drop the trailing partial summary block
+    int64_t samples = 0;
+    int64_t samples_mirror = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 1, &samples));
+    assert_int_equal(0, jls_rd_fsr_length(rd_mirror, 1, &samples_mirror));
+    assert_true(samples_mirror <= samples);
+    assert_true((samples_mirror + incr) >= samples);
+
+    // the injected summaries match the primary's statistics exactly,
+    // excluding the final queried entry, which the reader always
+    // computes from the sample data (reconstructed in the mirror)
+    int64_t len = samples_mirror / incr;
+    double * s1 = malloc(len * 4 * sizeof(double));
+    double * s2 = malloc(len * 4 * sizeof(double));
+    assert_non_null(s1);
+    assert_non_null(s2);
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 1, 0, incr, s1, len));
+    assert_int_equal(0, jls_rd_fsr_statistics(rd_mirror, 1, 0, incr, s2, len));
+    for (int64_t i = 0; i < (len - 1) * 4; ++i) {
+        assert_float_equal(s1[i], s2[i], 1e-9);
+    }
+
+    // sample reads reconstruct the summary mean
+    float y2[100];
+    assert_int_equal(0, jls_rd_omit_mode(rd_mirror, JLS_RD_OMIT_MODE_MEAN));
+    assert_int_equal(0, jls_rd_fsr_f32(rd_mirror, 1, 150300, y2, 100));
+    for (int64_t i = 0; i < 100; ++i) {
+        assert_float_equal(y[150300 + i], y2[i], incr * 0.001);
+    }
+
+    jls_rd_close(rd);
+    jls_rd_close(rd_mirror);
+    free(s1);
+    free(s2);
+    free(y);
+    remove(filename);
+    remove(mirror_filename);
+}
+
 static void on_log_recv(const char * msg) {
     printf("%s", msg);
 }
@@ -248,7 +429,10 @@ int main(void) {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(test_samples),
             cmocka_unit_test(test_summary),
+            cmocka_unit_test(test_omit_mode_mean_and_cache),
             cmocka_unit_test(test_u4),
+            cmocka_unit_test(test_const_f32),
+            cmocka_unit_test(test_mirror),
     };
 
     jls_log_register(on_log_recv);
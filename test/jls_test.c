@@ -20,6 +20,8 @@
 #include <cmocka.h>
 #include "jls.h"
 #include "jls/writer.h"
+#include "jls/raw.h"
+#include "jls/backend.h"
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -146,6 +148,12 @@ static void test_source(void **state) {
     assert_string_equal(SOURCE_1.version, sources[1].version);
     assert_string_equal(SOURCE_1.serial_number, sources[1].serial_number);
     assert_string_equal(SOURCE_3.name, sources[2].name);
+
+    struct jls_rd_open_profile_s profile;
+    assert_int_equal(0, jls_rd_open_profile_get(rd, &profile));
+    assert_true(profile.bytes_read[JLS_RD_OPEN_PHASE_SIDECAR] > 0);
+    assert_int_equal(0, profile.duration_us[JLS_RD_OPEN_PHASE_REPAIR]);
+
     jls_rd_close(rd);
     remove(filename);
 }
@@ -195,6 +203,47 @@ static void test_wr_source_duplicate(void **state) {
     remove(filename);
 }
 
+static void test_signal_def_auto(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    struct jls_rd_s * rd = NULL;
+    struct jls_signal_def_s def;
+    struct jls_signal_def_s signal = SIGNAL_5;
+    signal.samples_per_data = JLS_SIGNAL_DEF_AUTO;
+    signal.sample_decimate_factor = 0;
+    signal.entries_per_summary = 0;
+    signal.summary_decimate_factor = 0;
+
+    // f32 at 100 kHz: data chunks target 32 kB
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &signal));
+    assert_int_equal(0, jls_wr_close(wr));
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_signal(rd, 5, &def));
+    assert_int_equal(8192, def.samples_per_data);
+    assert_int_equal(128, def.sample_decimate_factor);
+    assert_int_equal(1280, def.entries_per_summary);
+    assert_int_equal(20, def.summary_decimate_factor);
+    jls_rd_close(rd);
+    remove(filename);
+
+    // u8 at 2 Hz: capped at 10 seconds of samples, not 32768 samples
+    signal.data_type = JLS_DATATYPE_U8;
+    signal.sample_rate = 2;
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &signal));
+    assert_int_equal(0, jls_wr_close(wr));
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_signal(rd, 5, &def));
+    assert_true(def.samples_per_data <= 64);  // 20 samples, aligned up
+    assert_true(def.samples_per_data >= 20);
+    assert_int_equal(0, def.samples_per_data % def.sample_decimate_factor);
+    jls_rd_close(rd);
+    remove(filename);
+}
+
 static int32_t on_annotation(void * user_data, const struct jls_annotation_s * annotation) {
     (void) user_data;
     int64_t timestamp = annotation->timestamp;
@@ -305,6 +354,152 @@ static void test_annotation_seek(void **state) {
     remove(filename);
 }
 
+static void test_annotation_range(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    struct jls_rd_s * rd = NULL;
+    int64_t count = -1;
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    for (int64_t i = 0; i < 10; ++i) {
+        assert_int_equal(0, jls_wr_annotation(wr, 0, i * JLS_TIME_MILLISECOND, NAN,
+                                              JLS_ANNOTATION_TYPE_TEXT, 0, JLS_STORAGE_TYPE_STRING,
+                                              (const uint8_t *) STRING_1, 0));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+
+    // counts answer from the index with no chunk reads
+    assert_int_equal(0, jls_rd_annotations_count(rd, 0, 0, 10 * JLS_TIME_MILLISECOND, &count));
+    assert_int_equal(10, count);
+    assert_int_equal(0, jls_rd_annotations_count(rd, 0, 2 * JLS_TIME_MILLISECOND,
+                                                 5 * JLS_TIME_MILLISECOND, &count));
+    assert_int_equal(3, count);  // end is exclusive
+    assert_int_equal(0, jls_rd_annotations_count(rd, 0, 20 * JLS_TIME_MILLISECOND,
+                                                 30 * JLS_TIME_MILLISECOND, &count));
+    assert_int_equal(0, count);
+
+    // range iteration yields exactly the annotations in [start, end)
+    for (int64_t i = 3; i < 7; ++i) {
+        expect_annotation(i * JLS_TIME_MILLISECOND, NAN,
+                          JLS_ANNOTATION_TYPE_TEXT, 0, JLS_STORAGE_TYPE_STRING,
+                          (const uint8_t *) STRING_1, sizeof(STRING_1));
+    }
+    assert_int_equal(0, jls_rd_annotations_range(rd, 0, 3 * JLS_TIME_MILLISECOND,
+                                                 7 * JLS_TIME_MILLISECOND, on_annotation, NULL));
+    assert_int_equal(0, jls_rd_annotations_range(rd, 0, 20 * JLS_TIME_MILLISECOND,
+                                                 30 * JLS_TIME_MILLISECOND, on_annotation, NULL));
+
+    jls_rd_close(rd);
+    remove(filename);
+}
+
+static void test_annotation_append(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    struct jls_rd_s * rd = NULL;
+    int64_t count = -1;
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    for (int64_t i = 0; i < 4; ++i) {
+        assert_int_equal(0, jls_wr_annotation_append(wr, 0, i * JLS_TIME_MILLISECOND, (float) i,
+                                                     JLS_ANNOTATION_TYPE_TEXT, 0, JLS_STORAGE_TYPE_STRING,
+                                                     (const uint8_t *) STRING_1, 0));
+    }
+    assert_int_equal(0, jls_wr_annotation_commit(wr));
+    assert_int_equal(0, jls_wr_annotation_commit(wr));  // empty commit is a no-op
+    // the single-chunk write interleaves with coalesced chunks
+    assert_int_equal(0, jls_wr_annotation(wr, 0, 4 * JLS_TIME_MILLISECOND, 4.0f,
+                                          JLS_ANNOTATION_TYPE_TEXT, 0, JLS_STORAGE_TYPE_STRING,
+                                          (const uint8_t *) STRING_1, 0));
+    for (int64_t i = 5; i < 10; ++i) {
+        assert_int_equal(0, jls_wr_annotation_append(wr, 0, i * JLS_TIME_MILLISECOND, (float) i,
+                                                     JLS_ANNOTATION_TYPE_TEXT, 0, JLS_STORAGE_TYPE_STRING,
+                                                     (const uint8_t *) STRING_1, 0));
+    }
+    assert_int_equal(0, jls_wr_close(wr));  // commits the pending records
+
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_annotations_count(rd, 0, 0, 10 * JLS_TIME_MILLISECOND, &count));
+    assert_int_equal(10, count);
+    for (int64_t i = 0; i < 10; ++i) {
+        expect_annotation(i * JLS_TIME_MILLISECOND, (float) i,
+                          JLS_ANNOTATION_TYPE_TEXT, 0, JLS_STORAGE_TYPE_STRING,
+                          (const uint8_t *) STRING_1, sizeof(STRING_1));
+    }
+    assert_int_equal(0, jls_rd_annotations(rd, 0, 0, on_annotation, NULL));
+
+    // the range crosses the coalesced chunk boundaries
+    for (int64_t i = 3; i < 7; ++i) {
+        expect_annotation(i * JLS_TIME_MILLISECOND, (float) i,
+                          JLS_ANNOTATION_TYPE_TEXT, 0, JLS_STORAGE_TYPE_STRING,
+                          (const uint8_t *) STRING_1, sizeof(STRING_1));
+    }
+    assert_int_equal(0, jls_rd_annotations_range(rd, 0, 3 * JLS_TIME_MILLISECOND,
+                                                 7 * JLS_TIME_MILLISECOND, on_annotation, NULL));
+
+    jls_rd_close(rd);
+    remove(filename);
+}
+
+static void test_annotation_find(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    struct jls_rd_s * rd = NULL;
+    const char marker[] = "OVERCURRENT limit exceeded";
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    for (int64_t i = 0; i < 20; ++i) {
+        const char * s = ((4 == i) || (13 == i)) ? marker : STRING_1;
+        assert_int_equal(0, jls_wr_annotation_append(wr, 0, i * JLS_TIME_MILLISECOND, NAN,
+                                                     JLS_ANNOTATION_TYPE_TEXT, 0, JLS_STORAGE_TYPE_STRING,
+                                                     (const uint8_t *) s, 0));
+        if (9 == i) {  // split the records across coalesced chunks
+            assert_int_equal(0, jls_wr_annotation_commit(wr));
+        }
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+
+    // a rare term yields only the matching annotations, skipping clean chunks
+    expect_annotation(4 * JLS_TIME_MILLISECOND, NAN,
+                      JLS_ANNOTATION_TYPE_TEXT, 0, JLS_STORAGE_TYPE_STRING,
+                      (const uint8_t *) marker, sizeof(marker));
+    expect_annotation(13 * JLS_TIME_MILLISECOND, NAN,
+                      JLS_ANNOTATION_TYPE_TEXT, 0, JLS_STORAGE_TYPE_STRING,
+                      (const uint8_t *) marker, sizeof(marker));
+    assert_int_equal(0, jls_rd_annotations_find(rd, 0, 0, 20 * JLS_TIME_MILLISECOND,
+                                                (const uint8_t *) "OVERCURRENT", 11,
+                                                on_annotation, NULL));
+
+    // the range bounds still apply
+    expect_annotation(13 * JLS_TIME_MILLISECOND, NAN,
+                      JLS_ANNOTATION_TYPE_TEXT, 0, JLS_STORAGE_TYPE_STRING,
+                      (const uint8_t *) marker, sizeof(marker));
+    assert_int_equal(0, jls_rd_annotations_find(rd, 0, 10 * JLS_TIME_MILLISECOND,
+                                                20 * JLS_TIME_MILLISECOND,
+                                                (const uint8_t *) "OVERCURRENT", 11,
+                                                on_annotation, NULL));
+
+    // a query shorter than the digest window scans but still matches exactly
+    expect_annotation(4 * JLS_TIME_MILLISECOND, NAN,
+                      JLS_ANNOTATION_TYPE_TEXT, 0, JLS_STORAGE_TYPE_STRING,
+                      (const uint8_t *) marker, sizeof(marker));
+    expect_annotation(13 * JLS_TIME_MILLISECOND, NAN,
+                      JLS_ANNOTATION_TYPE_TEXT, 0, JLS_STORAGE_TYPE_STRING,
+                      (const uint8_t *) marker, sizeof(marker));
+    assert_int_equal(0, jls_rd_annotations_find(rd, 0, 0, 20 * JLS_TIME_MILLISECOND,
+                                                (const uint8_t *) "OV", 2,
+                                                on_annotation, NULL));
+
+    // an absent term yields no callbacks
+    assert_int_equal(0, jls_rd_annotations_find(rd, 0, 0, 20 * JLS_TIME_MILLISECOND,
+                                                (const uint8_t *) "UNDERVOLTAGE", 12,
+                                                on_annotation, NULL));
+
+    jls_rd_close(rd);
+    remove(filename);
+}
+
 static void test_hmarker(void **state) {
     (void) state;
     struct jls_wr_s * wr = NULL;
@@ -439,6 +634,147 @@ static void test_utc_seek_second_block_middle(void **state) {
     utc_check(1500);
 }
 
+static void test_utc_range(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    struct jls_rd_s * rd = NULL;
+    const int64_t count = SIGNAL_5.utc_decimate_factor * 5 + 10;
+    struct jls_utc_summary_entry_s entries[16];
+    int64_t entries_count = -1;
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int64_t i = 0; i < count; ++i) {
+        assert_int_equal(0, jls_wr_utc(wr, 5, i * 10, i * JLS_TIME_SECOND));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+
+    // fill from the middle of the range, end exclusive
+    assert_int_equal(0, jls_rd_utc_range(rd, 5, 500, 600, entries, 16, &entries_count));
+    assert_int_equal(10, entries_count);
+    for (int64_t i = 0; i < entries_count; ++i) {
+        assert_int_equal(500 + i * 10, entries[i].sample_id);
+        assert_int_equal((50 + i) * JLS_TIME_SECOND, entries[i].timestamp);
+    }
+
+    // capacity-limited fill with resume
+    assert_int_equal(0, jls_rd_utc_range(rd, 5, 0, count * 10, entries, 16, &entries_count));
+    assert_int_equal(16, entries_count);
+    assert_int_equal(0, entries[0].sample_id);
+    assert_int_equal(150, entries[15].sample_id);
+    assert_int_equal(0, jls_rd_utc_range(rd, 5, entries[15].sample_id + 1, count * 10,
+                                         entries, 16, &entries_count));
+    assert_int_equal(16, entries_count);
+    assert_int_equal(160, entries[0].sample_id);
+
+    // an empty range past the data
+    assert_int_equal(0, jls_rd_utc_range(rd, 5, count * 10, count * 20, entries, 16, &entries_count));
+    assert_int_equal(0, entries_count);
+
+    jls_rd_close(rd);
+    remove(filename);
+}
+
+static void test_utc_tmap_sidecar(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t count = SIGNAL_5.utc_decimate_factor * 5 + 10;
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int64_t i = 0; i < count; ++i) {
+        assert_int_equal(0, jls_wr_utc(wr, 5, i * 10, i * JLS_TIME_SECOND));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    // the close wrote the UTC time map sidecar chunk
+    struct jls_raw_s * raw = NULL;
+    struct jls_chunk_header_s hdr;
+    int found = 0;
+    assert_int_equal(0, jls_raw_open(&raw, filename, "r"));
+    while (0 == jls_raw_rd_header(raw, &hdr)) {
+        if (JLS_TAG_UTC_TMAP == hdr.tag) {
+            found = 1;
+            break;
+        }
+        if (jls_raw_chunk_next(raw)) {
+            break;
+        }
+    }
+    assert_true(found);
+    assert_int_equal(0, jls_raw_close(raw));
+
+    // the time map loads from the sidecar without walking the UTC track
+    struct jls_rd_s * rd = NULL;
+    int64_t v = 0;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_sample_id_to_timestamp(rd, 5, 100, &v));
+    assert_int_equal(10 * JLS_TIME_SECOND, v);
+    assert_int_equal(0, jls_rd_sample_id_to_timestamp(rd, 5, 55, &v));
+    assert_int_equal(JLS_TIME_SECOND * 11 / 2, v);
+    assert_int_equal(0, jls_rd_timestamp_to_sample_id(rd, 5, 20 * JLS_TIME_SECOND, &v));
+    assert_int_equal(200, v);
+    jls_rd_close(rd);
+    remove(filename);
+}
+
+static void test_fsr_by_utc(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    float src[1000];
+    for (int i = 0; i < 1000; ++i) {
+        src[i] = (float) i;
+    }
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 0, src, 1000));
+    for (int64_t i = 0; i <= 100; ++i) {
+        assert_int_equal(0, jls_wr_utc(wr, 5, i * 10, i * JLS_TIME_SECOND));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    float data[1000];
+    int64_t s0 = -1;
+    int64_t length = -1;
+
+    // interior range: one call resolves, clamps, and reads
+    assert_int_equal(0, jls_rd_fsr_by_utc(rd, 5, 2 * JLS_TIME_SECOND, 5 * JLS_TIME_SECOND,
+                                          data, 1000, &s0, &length));
+    assert_int_equal(20, s0);
+    assert_int_equal(30, length);
+    assert_memory_equal(src + 20, data, 30 * sizeof(float));
+
+    // the end clamps to the recorded range
+    assert_int_equal(0, jls_rd_fsr_by_utc(rd, 5, 90 * JLS_TIME_SECOND, 200 * JLS_TIME_SECOND,
+                                          data, 1000, &s0, &length));
+    assert_int_equal(900, s0);
+    assert_int_equal(100, length);
+    assert_memory_equal(src + 900, data, 100 * sizeof(float));
+
+    // a range after the recording reads nothing
+    assert_int_equal(0, jls_rd_fsr_by_utc(rd, 5, 300 * JLS_TIME_SECOND, 400 * JLS_TIME_SECOND,
+                                          data, 1000, &s0, &length));
+    assert_int_equal(0, length);
+
+    // the buffer capacity caps the read
+    assert_int_equal(0, jls_rd_fsr_by_utc(rd, 5, 0, 100 * JLS_TIME_SECOND,
+                                          data, 25, &s0, &length));
+    assert_int_equal(0, s0);
+    assert_int_equal(25, length);
+    assert_memory_equal(src, data, 25 * sizeof(float));
+
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_rd_fsr_by_utc(rd, 5, JLS_TIME_SECOND, 0, data, 1000, &s0, &length));
+
+    jls_rd_close(rd);
+    remove(filename);
+}
+
 static void test_signal(void **state) {
     (void) state;
     struct jls_wr_s * wr = NULL;
@@ -519,6 +855,63 @@ float * gen_triangle(uint32_t period_samples, int64_t length_samples) {
     return y;
 }
 
+static void test_directory(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    struct jls_rd_s * rd = NULL;
+    const int64_t sample_id_offset = 1000000;
+    float * data = gen_triangle(1, WINDOW_SIZE);
+    assert_non_null(data);
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_user_data(wr, CHUNK_META_1, JLS_STORAGE_TYPE_BINARY, USER_DATA_1, sizeof(USER_DATA_1)));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id_offset, data, WINDOW_SIZE));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    // the close wrote the footer directory chunk
+    struct jls_raw_s * raw = NULL;
+    struct jls_chunk_header_s hdr;
+    int found = 0;
+    assert_int_equal(0, jls_raw_open(&raw, filename, "r"));
+    while (0 == jls_raw_rd_header(raw, &hdr)) {
+        if (JLS_TAG_DIRECTORY == hdr.tag) {
+            found = 1;
+            break;
+        }
+        if (jls_raw_chunk_next(raw)) {
+            break;
+        }
+    }
+    assert_true(found);
+    assert_int_equal(0, jls_raw_close(raw));
+
+    // the open populates defs and heads from the directory, no scan
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    struct jls_signal_def_s * signals = NULL;
+    uint16_t count = 0;
+    assert_int_equal(0, jls_rd_signals(rd, &signals, &count));
+    assert_int_equal(2, count);
+    assert_int_equal(5, signals[1].signal_id);
+    assert_int_equal(SIGNAL_5.sample_rate, signals[1].sample_rate);
+    assert_string_equal(SIGNAL_5.name, signals[1].name);
+    assert_string_equal(SIGNAL_5.units, signals[1].units);
+
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(WINDOW_SIZE, samples);
+    float data_rd[100];
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data_rd, 100));
+    assert_memory_equal(data, data_rd, 100 * sizeof(float));
+
+    expect_user_data(CHUNK_META_1, JLS_STORAGE_TYPE_BINARY, USER_DATA_1, sizeof(USER_DATA_1));
+    assert_int_equal(0, jls_rd_user_data(rd, on_user_data, NULL));
+
+    jls_rd_close(rd);
+    free(data);
+    remove(filename);
+}
+
 static void test_fsr_f32(void **state) {
     (void) state;
     struct jls_wr_s * wr = NULL;
@@ -575,127 +968,2030 @@ static void test_fsr_f32(void **state) {
     remove(filename);
 }
 
-static void test_fsr_f32_sample_id_offset(void **state) {
+static void test_shared_cache(void **state) {
     (void) state;
     struct jls_wr_s * wr = NULL;
-    const int64_t sample_count = WINDOW_SIZE * 1000;
+    const int64_t sample_count = WINDOW_SIZE * 100;
     float * signal = gen_triangle(1000, sample_count);
     assert_non_null(signal);
-
     assert_int_equal(0, jls_wr_open(&wr, filename));
     assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
     assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
-    int64_t sample_id_offset = 100000000;
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
 
-    const int64_t utc = JLS_TIME_YEAR;   // one year after start of epoch
+    // unique name per run: stale entries keyed by the same path would
+    // otherwise leak in from a previous run's segment
+    char cache_name[64];
+    snprintf(cache_name, sizeof(cache_name), "jls_test_shm_%016llx", (unsigned long long) jls_now());
+
+    float * data = malloc(sample_count * sizeof(float));
+    assert_non_null(data);
+
+    // reader 1 populates the shared cache
+    struct jls_rd_s * rd1 = NULL;
+    assert_int_equal(0, jls_rd_open(&rd1, filename));
+    assert_int_equal(0, jls_rd_cache_shared(rd1, cache_name, 4 * 1024 * 1024));
+    assert_int_equal(0, jls_rd_fsr_f32(rd1, 5, 0, data, sample_count));
+    assert_memory_equal(signal, data, sample_count * sizeof(float));
+
+    // reader 2 attaches to the same cache and reads identical data
+    struct jls_rd_s * rd2 = NULL;
+    assert_int_equal(0, jls_rd_open(&rd2, filename));
+    assert_int_equal(0, jls_rd_cache_shared(rd2, cache_name, 4 * 1024 * 1024));
+    memset(data, 0, sample_count * sizeof(float));
+    assert_int_equal(0, jls_rd_fsr_f32(rd2, 5, 0, data, sample_count));
+    assert_memory_equal(signal, data, sample_count * sizeof(float));
+
+    // detach and read again from the file
+    assert_int_equal(0, jls_rd_cache_shared(rd2, NULL, 0));
+    memset(data, 0, sample_count * sizeof(float));
+    assert_int_equal(0, jls_rd_fsr_f32(rd2, 5, 0, data, sample_count));
+    assert_memory_equal(signal, data, sample_count * sizeof(float));
+
+    jls_rd_close(rd2);
+    jls_rd_close(rd1);
+    free(data);
+    free(signal);
+    remove(filename);
+}
 
+static void test_prefetch(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
     for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
-        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id_offset + sample_id, signal + sample_id, WINDOW_SIZE));
-        assert_int_equal(0, jls_wr_utc(wr, 5, sample_id_offset + sample_id, utc + JLS_COUNTER_TO_TIME(sample_id, SIGNAL_5.sample_rate)));
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
     }
     assert_int_equal(0, jls_wr_close(wr));
 
+    float * data = malloc(sample_count * sizeof(float));
+    assert_non_null(data);
+
     struct jls_rd_s * rd = NULL;
     assert_int_equal(0, jls_rd_open(&rd, filename));
-    struct jls_signal_def_s * signals = NULL;
-    uint16_t count = 0;
-    assert_int_equal(0, jls_rd_signals(rd, &signals, &count));
-    assert_int_equal(2, count);
-    assert_int_equal(5, signals[1].signal_id);
-    int64_t samples = 0;
-    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
-    assert_int_equal(sample_count, samples);
-
-    // get entire first data chunk.
-    float data[2000];
-    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, 1000));
-    assert_memory_equal(signal, data, 1000 * sizeof(float));
 
-    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
-        expect_utc(sample_id, utc + JLS_COUNTER_TO_TIME(sample_id, SIGNAL_5.sample_rate));
+    // prefetch needs a chunk cache to stage into
+    assert_int_equal(JLS_ERROR_NOT_SUPPORTED, jls_rd_prefetch(rd, 5, 0, sample_count, 0));
+    assert_int_equal(0, jls_rd_cache(rd, 16 * 1024 * 1024));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_prefetch(rd, 5, 0, 0, 0));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_rd_prefetch(rd, 5, 0, sample_count, JLS_SUMMARY_LEVEL_COUNT));
+
+    // a cold read of the full range costs physical file reads
+    struct jls_rd_query_profile_s qp;
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, sample_count));
+    assert_memory_equal(signal, data, sample_count * sizeof(float));
+    assert_int_equal(0, jls_rd_query_profile_get(rd, &qp));
+    uint64_t physical_cold = qp.physical_bytes;
+    assert_true(physical_cold > 0);
+
+    // prefetch the full range, reconfiguring the cache first to discard
+    // the chunks staged by the cold read above
+    assert_int_equal(0, jls_rd_cache(rd, 16 * 1024 * 1024));
+    assert_int_equal(0, jls_rd_prefetch(rd, 5, 0, sample_count, 0));
+    assert_int_equal(0, jls_rd_prefetch(rd, 5, 0, sample_count, 1));
+    for (int i = 0; i < 2000; ++i) {  // allow the worker to drain
+        jls_bkt_sleep_ms(1);
     }
-    assert_int_equal(0, jls_rd_utc(rd, 5, 0, on_utc, NULL));
-
-    // check sample_id -> timestamp mapping
-    int64_t v = 0;
-    assert_int_equal(0, jls_rd_sample_id_to_timestamp(rd, 5, 0, &v));
-    assert_int_equal(utc, v);
-    assert_int_equal(0, jls_rd_sample_id_to_timestamp(rd, 5, 100000, &v));
-    assert_int_equal(utc + JLS_TIME_SECOND, v);
-
-    // check timestamp -> sample_id mapping
-    assert_int_equal(0, jls_rd_timestamp_to_sample_id(rd, 5, utc, &v));
-    assert_int_equal(0, v);
-    assert_int_equal(0, jls_rd_timestamp_to_sample_id(rd, 5, utc + JLS_TIME_SECOND, &v));
-    assert_int_equal(100000, v);
 
+    // the prefetched read is a memory operation
+    memset(data, 0, sample_count * sizeof(float));
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, sample_count));
+    assert_memory_equal(signal, data, sample_count * sizeof(float));
+    assert_int_equal(0, jls_rd_query_profile_get(rd, &qp));
+    assert_true(qp.physical_bytes < physical_cold);
+
+    // cancel drops the queue, close with outstanding work tears down cleanly
+    assert_int_equal(0, jls_rd_prefetch(rd, 5, 0, sample_count, 0));
+    assert_int_equal(0, jls_rd_prefetch_cancel(rd));
+    assert_int_equal(0, jls_rd_prefetch(rd, 5, 0, sample_count, 2));
     jls_rd_close(rd);
+
+    free(data);
     free(signal);
     remove(filename);
 }
 
-static void compare_stats_f32(double * data, float * src, size_t src_length) {
-    struct jls_statistics_s s1;
-    jls_statistics_reset(&s1);
-    jls_statistics_compute_f32(&s1, src, src_length);
-    assert_float_equal(s1.mean, data[JLS_SUMMARY_FSR_MEAN], 1e-7);
-    assert_float_equal(s1.min, data[JLS_SUMMARY_FSR_MIN], 1e-7);
-    assert_float_equal(s1.max, data[JLS_SUMMARY_FSR_MAX], 1e-7);
-    float v_std = (float) sqrt(jls_statistics_var(&s1));
-    assert_float_equal(v_std, data[JLS_SUMMARY_FSR_STD], 1e-7f + 0.0005f * v_std);
+struct fsr_async_ctx_s {
+    volatile int32_t completions;
+    volatile int32_t failures;
+    volatile int32_t aborts;
+};
+
+static void on_fsr_async(void * user_data, int32_t return_code) {
+    struct fsr_async_ctx_s * ctx = (struct fsr_async_ctx_s *) user_data;
+    if (0 == return_code) {
+        ++ctx->completions;
+    } else if (JLS_ERROR_ABORTED == return_code) {
+        ++ctx->aborts;
+    } else {
+        ++ctx->failures;
+    }
 }
 
-static void test_fsr_f32_statistics(void **state) {
+static void test_fsr_async(void **state) {
     (void) state;
     struct jls_wr_s * wr = NULL;
-    const int64_t sample_count = WINDOW_SIZE * 1000;
+    const int64_t sample_count = WINDOW_SIZE * 100;
     float * signal = gen_triangle(1000, sample_count);
     assert_non_null(signal);
-
     assert_int_equal(0, jls_wr_open(&wr, filename));
     assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
     assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
-    assert_true(sample_count <= UINT32_MAX);
-    assert_int_equal(0, jls_wr_fsr(wr, 5, 0, signal, (uint32_t) sample_count));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
     assert_int_equal(0, jls_wr_close(wr));
 
     struct jls_rd_s * rd = NULL;
     assert_int_equal(0, jls_rd_open(&rd, filename));
+    struct fsr_async_ctx_s ctx = {0, 0, 0};
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_fsr_async(rd, 5, 0, NULL, 1000, on_fsr_async, &ctx));
 
-    double data[2000][JLS_SUMMARY_FSR_COUNT];
-    // within a single data chunk
-    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, 10, data[0], 100));
-    compare_stats_f32(data[0], signal, 10);
-    compare_stats_f32(data[1], signal + 10, 10);
+    #define ASYNC_COUNT (8)
+    float data[ASYNC_COUNT][1000];
+    for (int i = 0; i < ASYNC_COUNT; ++i) {
+        assert_int_equal(0, jls_rd_fsr_async(rd, 5, i * 1000, data[i], 1000, on_fsr_async, &ctx));
+    }
+    for (int i = 0; (i < 5000) && ((ctx.completions + ctx.failures) < ASYNC_COUNT); ++i) {
+        jls_bkt_sleep_ms(1);
+    }
+    assert_int_equal(ASYNC_COUNT, ctx.completions);
+    assert_int_equal(0, ctx.failures);
+    for (int i = 0; i < ASYNC_COUNT; ++i) {
+        assert_memory_equal(signal + i * 1000, data[i], 1000 * sizeof(float));
+    }
 
-    // offset from start of chunk
-    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 15, 10, data[0], 2));
-    compare_stats_f32(data[0], signal + 15, 10);
-    compare_stats_f32(data[1], signal + 25, 10);
+    // close completes outstanding requests exactly once
+    for (int i = 0; i < ASYNC_COUNT; ++i) {
+        assert_int_equal(0, jls_rd_fsr_async(rd, 5, i * 1000, data[i], 1000, on_fsr_async, &ctx));
+    }
+    jls_rd_close(rd);
+    assert_int_equal(2 * ASYNC_COUNT, ctx.completions + ctx.failures + ctx.aborts);
+    #undef ASYNC_COUNT
 
-    // span chunk 2 to 3
-    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 1999, 2, data[0], 2));
-    compare_stats_f32(data[0], signal + 1999, 2);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_cancel_budget(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    float * data = malloc(sample_count * sizeof(float));
+    assert_non_null(data);
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+
+    // a pending cancellation stops the next operation, then is consumed
+    assert_int_equal(0, jls_rd_cancel(rd));
+    assert_int_equal(JLS_ERROR_ABORTED, jls_rd_fsr_f32(rd, 5, 0, data, sample_count));
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, sample_count));
+    assert_memory_equal(signal, data, sample_count * sizeof(float));
+
+    // an exhausted budget fails this and later operations until topped up
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_budget(rd, -1));
+    assert_int_equal(0, jls_rd_budget(rd, 4096));
+    assert_int_equal(JLS_ERROR_BUDGET, jls_rd_fsr_f32(rd, 5, 0, data, sample_count));
+    assert_int_equal(JLS_ERROR_BUDGET, jls_rd_fsr_f32(rd, 5, 0, data, 16));
+    assert_int_equal(0, jls_rd_budget(rd, 0));
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, sample_count));
+    assert_memory_equal(signal, data, sample_count * sizeof(float));
+
+    jls_rd_close(rd);
+    free(data);
+    free(signal);
+    remove(filename);
+}
+
+struct chunk_clock_s {
+    uint32_t count;
+    int64_t offset_prev;
+    int64_t time_prev;
+    int64_t time_min;
+    int64_t time_max;
+};
+
+static int32_t on_chunk_clock(void * user_data, const struct jls_chunk_clock_entry_s * entries, uint32_t count) {
+    struct chunk_clock_s * c = (struct chunk_clock_s *) user_data;
+    for (uint32_t i = 0; i < count; ++i) {
+        assert_true(entries[i].offset > c->offset_prev);
+        assert_true(entries[i].timestamp >= c->time_prev);
+        assert_true(entries[i].timestamp >= c->time_min);
+        assert_true(entries[i].timestamp <= c->time_max);
+        c->offset_prev = entries[i].offset;
+        c->time_prev = entries[i].timestamp;
+        ++c->count;
+    }
+    return 0;
+}
+
+static void test_chunk_clock(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    struct jls_rd_s * rd = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    // not enabled: no chunk clock chain
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 0, signal, WINDOW_SIZE));
+    assert_int_equal(0, jls_wr_close(wr));
+    struct chunk_clock_s c = {.count = 0, .offset_prev = 0, .time_prev = 0};
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(JLS_ERROR_NOT_FOUND, jls_rd_chunk_clock(rd, on_chunk_clock, &c));
+    jls_rd_close(rd);
+    remove(filename);
+
+    // enabled: one entry per FSR data chunk
+    c.time_min = jls_now();
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_chunk_clock_en(wr, 1));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+    c.time_max = jls_now();
+
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    struct jls_signal_def_s * signals = NULL;
+    uint16_t count = 0;
+    assert_int_equal(0, jls_rd_signals(rd, &signals, &count));
+    const int64_t spd = signals[1].samples_per_data;
+    assert_int_equal(0, jls_rd_chunk_clock(rd, on_chunk_clock, &c));
+    assert_int_equal((sample_count + spd - 1) / spd, c.count);
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_data_map(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+    free(signal);
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    struct jls_signal_def_s * signals = NULL;
+    uint16_t signal_count = 0;
+    assert_int_equal(0, jls_rd_signals(rd, &signals, &signal_count));
+    const int64_t spd = signals[1].samples_per_data;
+
+    // one entry per data chunk, contiguous sample coverage
+    const struct jls_fsr_data_map_entry_s * entries = NULL;
+    uint32_t count = 0;
+    assert_int_equal(0, jls_rd_fsr_data_map(rd, 5, &entries, &count));
+    assert_non_null(entries);
+    assert_int_equal((sample_count + spd - 1) / spd, count);
+    int64_t next = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        assert_int_equal(next, entries[i].timestamp);
+        assert_true(entries[i].entry_count > 0);
+        next += entries[i].entry_count;
+    }
+    assert_int_equal(sample_count, next);
+
+    // repeated calls return the same loaded map
+    const struct jls_fsr_data_map_entry_s * entries2 = NULL;
+    uint32_t count2 = 0;
+    assert_int_equal(0, jls_rd_fsr_data_map(rd, 5, &entries2, &count2));
+    assert_ptr_equal(entries, entries2);
+    assert_int_equal(count, count2);
+
+    assert_int_equal(JLS_ERROR_NOT_SUPPORTED, jls_rd_fsr_data_map(rd, 0, &entries, &count));  // signal 0 is VSR
+    jls_rd_close(rd);
+    remove(filename);
+}
+
+static int32_t transform_negate(void * user_data, uint16_t signal_id,
+                                int64_t sample_id, void * data, uint32_t data_length) {
+    (void) sample_id;
+    int * calls = (int *) user_data;
+    assert_int_equal(5, signal_id);
+    float * f = (float *) data;
+    for (uint32_t i = 0; i < data_length; ++i) {
+        f[i] = -f[i];
+    }
+    ++(*calls);
+    return 0;
+}
+
+static void test_fsr_write_scale_transform(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 10;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+    int transform_calls = 0;
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_9_U1));
+    assert_int_equal(JLS_ERROR_NOT_SUPPORTED, jls_wr_fsr_scale(wr, 9, 2.0, 0.0));
+    assert_int_equal(0, jls_wr_fsr_scale(wr, 5, 2.0, 1.0));
+    assert_int_equal(0, jls_wr_fsr_transform(wr, 5, transform_negate, &transform_calls));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+    assert_int_equal(10, transform_calls);
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    float data[WINDOW_SIZE];
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, WINDOW_SIZE));
+    for (int i = 0; i < WINDOW_SIZE; ++i) {
+        // scale applies first, then the transform
+        assert_float_equal(-(signal[i] * 2.0f + 1.0f), data[i], 1e-7);
+    }
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+struct open_async_s {
+    volatile int done;
+    volatile int32_t rc;
+};
+
+static void on_open_async(void * user_data, int32_t rc) {
+    struct open_async_s * a = (struct open_async_s *) user_data;
+    a->rc = rc;
+    a->done = 1;
+}
+
+static void test_fsr_f32_open_async(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    struct open_async_s async = {0, 0};
+    assert_int_equal(JLS_ERROR_IO, jls_rd_open_async(&rd, "does_not_exist.jls", on_open_async, &async));
+    assert_int_equal(0, async.done);  // sync failure: no callback
+
+    assert_int_equal(0, jls_rd_open_async(&rd, filename, on_open_async, &async));
+
+    // defs available without waiting for the full open
+    struct jls_signal_def_s * signals = NULL;
+    uint16_t count = 0;
+    assert_int_equal(0, jls_rd_signals(rd, &signals, &count));
+    assert_int_equal(2, count);
+    assert_int_equal(5, signals[1].signal_id);
+
+    // data queries block until the background open completes
+    float data[2000];
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, 1000));
+    assert_memory_equal(signal, data, 1000 * sizeof(float));
+    assert_int_equal(1, async.done);
+    assert_int_equal(0, async.rc);
+
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_suspend_resume(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 400;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+
+    // suspend before any samples: nothing staged yet, no-op
+    assert_int_equal(0, jls_wr_fsr_suspend(wr, 5));
+    assert_int_equal(0, jls_wr_fsr_resume(wr, 5));
+
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+        if (sample_id == WINDOW_SIZE * 50) {
+            // mid data chunk and mid summary block
+            assert_int_equal(0, jls_wr_fsr_suspend(wr, 5));
+            assert_int_equal(0, jls_wr_fsr_suspend(wr, 5));  // idempotent
+            assert_int_equal(0, jls_wr_fsr_resume(wr, 5));   // explicit resume
+        } else if (sample_id == WINDOW_SIZE * 200) {
+            // implicit resume: the next jls_wr_fsr_f32() restores
+            assert_int_equal(0, jls_wr_fsr_suspend(wr, 5));
+        }
+    }
+    assert_int_equal(0, jls_wr_fsr_suspend(wr, 5));  // resumed by close
+    assert_int_equal(0, jls_wr_close(wr));
+
+    // the recorded samples and summaries match an uninterrupted write
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+
+    float * data = malloc(sizeof(float) * (size_t) sample_count);
+    assert_non_null(data);
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, sample_count));
+    assert_memory_equal(signal, data, sample_count * sizeof(float));
+    free(data);
+
+    const int64_t increment = SIGNAL_5.sample_decimate_factor;
+    const int64_t entries = sample_count / increment;
+    double * stats = malloc(sizeof(double) * 4 * (size_t) entries);
+    assert_non_null(stats);
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, increment, stats, entries));
+    for (int64_t entry = 0; entry < entries; ++entry) {
+        double mean = 0.0;
+        for (int64_t i = 0; i < increment; ++i) {
+            mean += signal[entry * increment + i];
+        }
+        mean /= increment;
+        assert_float_equal(mean, stats[entry * 4 + JLS_SUMMARY_FSR_MEAN], 1e-6);
+    }
+    free(stats);
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_f32_mmap(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 1000;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open_mmap(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+
+    float data[2000];
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, 1000));
+    assert_memory_equal(signal, data, 1000 * sizeof(float));
+
+    // get span over 2nd - 4th data chunk.
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 1999, data, 1002));
+    assert_memory_equal(signal + 1999, data, 1002 * sizeof(float));
+
+    // get last few samples
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, sample_count - 5, data, 5));
+    assert_memory_equal(signal + sample_count - 5, data, 5 * sizeof(float));
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_f32_batch(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+
+    #define BATCH_COUNT (12)
+    float data[BATCH_COUNT][1000];
+    struct jls_rd_fsr_req_s requests[BATCH_COUNT];
+    for (int i = 0; i < BATCH_COUNT; ++i) {
+        requests[i].signal_id = 5;
+        requests[i].start_sample_id = i * (sample_count / BATCH_COUNT);
+        requests[i].data_length = 1000;
+        requests[i].data = data[i];
+        requests[i].return_code = -1;
+    }
+    assert_int_equal(0, jls_rd_cache(rd, 1 << 20));
+    for (int pass = 0; pass < 2; ++pass) {  // second pass reads from the chunk cache
+        assert_int_equal(0, jls_rd_fsr_batch(rd, requests, BATCH_COUNT));
+        for (int i = 0; i < BATCH_COUNT; ++i) {
+            assert_int_equal(0, requests[i].return_code);
+            assert_memory_equal(signal + requests[i].start_sample_id, data[i], 1000 * sizeof(float));
+        }
+    }
+
+    // reverse request order: elevator scheduling re-sorts by offset,
+    // results still land in the caller's entries
+    for (int i = 0; i < BATCH_COUNT; ++i) {
+        requests[i].start_sample_id = (BATCH_COUNT - 1 - i) * (sample_count / BATCH_COUNT);
+        requests[i].return_code = -1;
+        memset(data[i], 0, sizeof(data[i]));
+    }
+    assert_int_equal(0, jls_rd_fsr_batch(rd, requests, BATCH_COUNT));
+    for (int i = 0; i < BATCH_COUNT; ++i) {
+        assert_int_equal(0, requests[i].return_code);
+        assert_memory_equal(signal + requests[i].start_sample_id, data[i], 1000 * sizeof(float));
+    }
+    #undef BATCH_COUNT
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_f32_io_uring(void **state) {
+    // exercises the asynchronous write queue where available, otherwise the synchronous fallback
+    (void) state;
+#ifdef _WIN32
+    _putenv("JLS_IO_URING=1");
+#else
+    setenv("JLS_IO_URING", "1", 1);
+#endif
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+#ifdef _WIN32
+    _putenv("JLS_IO_URING=");
+#else
+    unsetenv("JLS_IO_URING");
+#endif
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+
+    float data[1000];
+    for (int64_t sample_id = 0; sample_id < sample_count; sample_id += sample_count / 10) {
+        assert_int_equal(0, jls_rd_fsr_f32(rd, 5, sample_id, data, 1000));
+        assert_memory_equal(signal + sample_id, data, 1000 * sizeof(float));
+    }
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_f32_double_buffer(void **state) {
+    // exercises the double-buffered overlapped chunk writes
+    (void) state;
+#ifdef _WIN32
+    _putenv("JLS_DOUBLE_BUFFER=1");
+#else
+    setenv("JLS_DOUBLE_BUFFER", "1", 1);
+#endif
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+#ifdef _WIN32
+    _putenv("JLS_DOUBLE_BUFFER=");
+#else
+    unsetenv("JLS_DOUBLE_BUFFER");
+#endif
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+
+    float data[1000];
+    for (int64_t sample_id = 0; sample_id < sample_count; sample_id += sample_count / 10) {
+        assert_int_equal(0, jls_rd_fsr_f32(rd, 5, sample_id, data, 1000));
+        assert_memory_equal(signal + sample_id, data, 1000 * sizeof(float));
+    }
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static int32_t on_annotation_count(void * user_data, const struct jls_annotation_s * annotation) {
+    (void) annotation;
+    int64_t * count = (int64_t *) user_data;
+    *count += 1;
+    return 0;
+}
+
+static void test_fsr_f32_append_only_strict(void **state) {
+    // JLS_APPEND_ONLY=2: no header rewrites ever, links in the footer link table
+    (void) state;
+#ifdef _WIN32
+    _putenv("JLS_APPEND_ONLY=2");
+#else
+    setenv("JLS_APPEND_ONLY", "2", 1);
+#endif
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+        if (sample_id == (WINDOW_SIZE * 50)) {
+            assert_int_equal(0, jls_wr_flush(wr));  // must not rewrite headers
+        }
+    }
+    for (int64_t i = 0; i < 10; ++i) {
+        assert_int_equal(0, jls_wr_annotation(wr, 5, i * 1000, NAN,
+                                              JLS_ANNOTATION_TYPE_TEXT, 0, JLS_STORAGE_TYPE_STRING,
+                                              (const uint8_t *) "strict", 0));
+        assert_int_equal(0, jls_wr_utc(wr, 5, i * 1000, i * JLS_TIME_SECOND));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+#ifdef _WIN32
+    _putenv("JLS_APPEND_ONLY=");
+#else
+    unsetenv("JLS_APPEND_ONLY");
+#endif
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+
+    float data[1000];
+    for (int64_t sample_id = 0; sample_id < sample_count; sample_id += sample_count / 10) {
+        assert_int_equal(0, jls_rd_fsr_f32(rd, 5, sample_id, data, 1000));
+        assert_memory_equal(signal + sample_id, data, 1000 * sizeof(float));
+    }
+
+    // statistics walk the index/summary chains through the link table
+    double stats[4][JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, sample_count / 4, &stats[0][0], 4));
+
+    int64_t annotation_count = 0;
+    assert_int_equal(0, jls_rd_annotations(rd, 5, 0, on_annotation_count, &annotation_count));
+    assert_int_equal(10, annotation_count);
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_f32_append_only(void **state) {
+    // exercises the deferred head-pointer updates applied on flush and close
+    (void) state;
+#ifdef _WIN32
+    _putenv("JLS_APPEND_ONLY=1");
+#else
+    setenv("JLS_APPEND_ONLY", "1", 1);
+#endif
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+        if (sample_id == (WINDOW_SIZE * 50)) {
+            assert_int_equal(0, jls_wr_flush(wr));  // mid-capture batch apply
+        }
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+#ifdef _WIN32
+    _putenv("JLS_APPEND_ONLY=");
+#else
+    unsetenv("JLS_APPEND_ONLY");
+#endif
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+
+    float data[1000];
+    for (int64_t sample_id = 0; sample_id < sample_count; sample_id += sample_count / 10) {
+        assert_int_equal(0, jls_rd_fsr_f32(rd, 5, sample_id, data, 1000));
+        assert_memory_equal(signal + sample_id, data, 1000 * sizeof(float));
+    }
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_f32_summary_preview(void **state) {
+    // live followers see buffered summary entries through preview chunks
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 25;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_wr_fsr_summary_watermark(wr, 5, 0, 100));
+    assert_int_equal(0, jls_wr_fsr_summary_watermark(wr, 5, 1, 100));
+
+    const int64_t first = WINDOW_SIZE * 10;  // well short of a full level-1 summary buffer
+    for (int sample_id = 0; sample_id < first; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open_follow(&rd, filename));
+    // use the written geometry: jls_wr_signal_def() normalizes the requested values
+    struct jls_signal_def_s def;
+    assert_int_equal(0, jls_rd_signal(rd, 5, &def));
+    const int64_t spd = def.samples_per_data;
+    const int64_t sdf = def.sample_decimate_factor;
+    int64_t sample_id_out = -1;
+    int64_t entries = 128;
+    double preview[128][JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(JLS_ERROR_NOT_FOUND,
+                     jls_rd_fsr_summary_preview(rd, 5, 1, &sample_id_out, &preview[0][0], &entries));
+
+    assert_int_equal(0, jls_wr_fsr_summary_preview(wr, 5, 1));
+    assert_int_equal(0, jls_wr_flush(wr));
+    assert_int_equal(0, jls_rd_refresh(rd));
+    entries = 128;
+    assert_int_equal(0, jls_rd_fsr_summary_preview(rd, 5, 1, &sample_id_out, &preview[0][0], &entries));
+    assert_int_equal(0, sample_id_out);
+    // entries complete per finished data chunk; the partial chunk is still staged
+    assert_int_equal(((first / spd) * spd) / sdf, entries);
+    for (int64_t i = 0; i < entries; ++i) {
+        double mean = 0.0;
+        for (int64_t k = 0; k < sdf; ++k) {
+            mean += signal[i * sdf + k];
+        }
+        mean /= (double) sdf;
+        assert_float_equal(mean, preview[i][JLS_SUMMARY_FSR_MEAN], 1e-6);
+    }
+
+    // past the first full summary chunk: the preview restarts with the new buffer
+    for (int sample_id = (int) first; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_fsr_summary_preview(wr, 5, 1));
+    assert_int_equal(0, jls_wr_flush(wr));
+    assert_int_equal(0, jls_rd_refresh(rd));
+    entries = 128;
+    assert_int_equal(0, jls_rd_fsr_summary_preview(rd, 5, 1, &sample_id_out, &preview[0][0], &entries));
+    const int64_t chunk_samples = sdf * def.entries_per_summary;
+    assert_int_equal(chunk_samples, sample_id_out);
+    assert_int_equal(((sample_count / spd) * spd - chunk_samples) / sdf, entries);
+    jls_rd_close(rd);
+    assert_int_equal(0, jls_wr_close(wr));
+
+    // normal readers skip the preview chunks entirely
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+    double stats[4][JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, sample_count / 4, &stats[0][0], 4));
+    entries = 128;
+    assert_int_equal(JLS_ERROR_NOT_FOUND,
+                     jls_rd_fsr_summary_preview(rd, 5, 1, &sample_id_out, &preview[0][0], &entries));
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_f32_follow(void **state) {
+    // read a live capture while the writer still owns the file
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    const int64_t half = WINDOW_SIZE * 50;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < half; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+
+    // open in follow mode mid-capture: no repair, on-disk data visible
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open_follow(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    // only whole data chunks are on disk; the remainder is still writer-buffered
+    const int64_t initial = samples;
+    assert_true((initial > 0) && (initial <= half));
+
+    float data[1000];
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, 1000));
+    assert_memory_equal(signal, data, 1000 * sizeof(float));
+
+    // append more samples, then discover them through refresh
+    for (int sample_id = (int) half; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_rd_refresh(rd));
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_true(samples > initial);
+    const int64_t sample_id = initial;  // first sample appended after open
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, sample_id, data, 1000));
+    assert_memory_equal(signal + sample_id, data, 1000 * sizeof(float));
+
+    // writer close flushes the remainder and the end chunk
+    assert_int_equal(0, jls_wr_close(wr));
+    assert_int_equal(0, jls_rd_refresh(rd));
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, sample_count - 1000, data, 1000));
+    assert_memory_equal(signal + sample_count - 1000, data, 1000 * sizeof(float));
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_f32_ring(void **state) {
+    // ring mode bounds level 0 data growth while retaining the summaries
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    const int64_t ring_samples = WINDOW_SIZE * 20;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_fsr_ring(wr, 5, ring_samples));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    // recycling keeps the file smaller than the raw sample data alone
+    FILE * f = fopen(filename, "rb");
+    assert_non_null(f);
+    fseek(f, 0, SEEK_END);
+    int64_t file_sz = ftell(f);
+    fclose(f);
+    assert_true(file_sz < sample_count * (int64_t) sizeof(float));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+
+    float data[1000];
+    // the first data chunk anchors sample_id_offset and is never recycled
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, 1000));
+    assert_memory_equal(signal, data, 1000 * sizeof(float));
+
+    // the most recent samples read back exactly
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, sample_count - 1000, data, 1000));
+    assert_memory_equal(signal + sample_count - 1000, data, 1000 * sizeof(float));
+
+    // overwritten history reads back reconstructed from the summaries
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, sample_count / 2, data, 1000));
+    for (int i = 0; i < 1000; ++i) {
+        assert_true(isfinite(data[i]));
+    }
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_f32_multi(void **state) {
+    // two segment files present as one continuous timeline
+    (void) state;
+    const char * filename2 = "jls_test_tmp2.jls";
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    const int64_t half = WINDOW_SIZE * 50;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    // segment 1: samples [0, half)
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < half; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    // segment 2: samples [half, sample_count), a manual split restarting at 0
+    assert_int_equal(0, jls_wr_open(&wr, filename2));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < (sample_count - half); sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + half + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    const char * paths[] = {filename, filename2};
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open_multi(&rd, paths, 2));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+
+    // reads within each segment and across the boundary
+    float data[1000];
+    for (int64_t sample_id = 0; sample_id < sample_count; sample_id += sample_count / 10) {
+        assert_int_equal(0, jls_rd_fsr_f32(rd, 5, sample_id, data, 1000));
+        assert_memory_equal(signal + sample_id, data, 1000 * sizeof(float));
+    }
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, half - 500, data, 1000));
+    assert_memory_equal(signal + half - 500, data, 1000 * sizeof(float));
+
+    // a statistics entry straddling the boundary combines exactly
+    double stats[4];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, half - 500, 1000, stats, 1));
+    double mean = 0.0;
+    for (int64_t i = half - 500; i < (half + 500); ++i) {
+        mean += signal[i];
+    }
+    mean /= 1000.0;
+    assert_float_equal(mean, stats[JLS_SUMMARY_FSR_MEAN], 1e-3);
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+    remove(filename2);
+}
+
+static void test_fsr_f32_extract(void **state) {
+    // copy a trigger window into a new file, reusing the level 1 summaries
+    (void) state;
+    const char * filename2 = "jls_test_tmp2.jls";
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    struct jls_signal_def_s def;
+    assert_int_equal(0, jls_rd_signal(rd, 5, &def));
+    const int64_t sdf = def.sample_decimate_factor;
+    const int64_t s0 = ((sample_count / 4) / sdf) * sdf;  // summary-aligned window start
+    const int64_t s1 = s0 + sample_count / 2;
+    const uint16_t signal_ids[] = {5};
+    assert_int_equal(0, jls_rd_extract(rd, filename2, signal_ids, 1, s0, s1));
+
+    struct jls_rd_s * rd2 = NULL;
+    assert_int_equal(0, jls_rd_open(&rd2, filename2));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd2, 5, &samples));
+    assert_int_equal(s1 - s0, samples);
+
+    float data[1000];
+    for (int64_t sample_id = 0; sample_id < samples; sample_id += samples / 10) {
+        int64_t n = samples - sample_id;
+        n = (n < 1000) ? n : 1000;
+        assert_int_equal(0, jls_rd_fsr_f32(rd2, 5, sample_id, data, n));
+        assert_memory_equal(signal + s0 + sample_id, data, n * sizeof(float));
+    }
+
+    // the reused summaries match the source summaries
+    double src_stats[8][4];
+    double dst_stats[8][4];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, s0, sdf, &src_stats[0][0], 8));
+    assert_int_equal(0, jls_rd_fsr_statistics(rd2, 5, 0, sdf, &dst_stats[0][0], 8));
+    for (int k = 0; k < 8 * 4; ++k) {
+        assert_float_equal((&src_stats[0][0])[k], (&dst_stats[0][0])[k], 1e-9);
+    }
+
+    jls_rd_close(rd2);
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+    remove(filename2);
+}
+
+static void test_fsr_f32_iter(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+
+    // full-signal iteration, starting mid-chunk
+    const int64_t start = 100;
+    struct jls_rd_fsr_iter_s * iter = NULL;
+    assert_int_equal(0, jls_rd_fsr_iter_open(rd, 5, start, sample_count - start, &iter));
+    const void * data = NULL;
+    int64_t sample_id = 0;
+    int64_t count = 0;
+    int64_t expect_sample_id = start;
+    while (0 == jls_rd_fsr_iter_next(iter, &data, &sample_id, &count)) {
+        assert_int_equal(expect_sample_id, sample_id);
+        assert_true(count > 0);
+        assert_memory_equal(signal + sample_id, data, count * sizeof(float));
+        expect_sample_id = sample_id + count;
+    }
+    assert_int_equal(sample_count, expect_sample_id);
+    assert_int_equal(JLS_ERROR_EMPTY, jls_rd_fsr_iter_next(iter, &data, &sample_id, &count));
+    jls_rd_fsr_iter_close(iter);
+
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_rd_fsr_iter_open(rd, 5, 0, sample_count + 1, &iter));
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+struct export_state_s {
+    float * dst;
+    int64_t expect_sample_id;
+    int64_t batch_size;
+    int64_t batches;
+    int64_t abort_after;
+};
+
+static int32_t on_export(void * user_data, const void * data,
+                         int64_t sample_id, int64_t sample_count) {
+    struct export_state_s * s = (struct export_state_s *) user_data;
+    assert_int_equal(s->expect_sample_id, sample_id);
+    assert_true(sample_count <= s->batch_size);
+    memcpy(s->dst + sample_id, data, sample_count * sizeof(float));
+    s->expect_sample_id = sample_id + sample_count;
+    ++s->batches;
+    return (s->abort_after && (s->batches >= s->abort_after)) ? 1 : 0;
+}
+
+static void test_fsr_f32_export(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+    float * dst = calloc(1, sizeof(float) * (size_t) sample_count);
+    assert_non_null(dst);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+
+    // fixed-size batches starting mid-chunk, bounded by one batch buffer
+    const int64_t start = 100;
+    struct export_state_s s = {
+            .dst = dst,
+            .expect_sample_id = start,
+            .batch_size = 1500,  // unaligned to the 1000-sample chunks
+            .batches = 0,
+            .abort_after = 0,
+    };
+    assert_int_equal(0, jls_rd_fsr_export(rd, 5, start, sample_count - start,
+                                          s.batch_size, 2, on_export, &s));
+    assert_int_equal(sample_count, s.expect_sample_id);
+    assert_int_equal((sample_count - start + 1499) / 1500, s.batches);
+    assert_memory_equal(signal + start, dst + start,
+                        (size_t) (sample_count - start) * sizeof(float));
+
+    // a nonzero callback return aborts the export
+    s.expect_sample_id = 0;
+    s.batches = 0;
+    s.abort_after = 3;
+    assert_int_equal(JLS_ERROR_ABORTED,
+                     jls_rd_fsr_export(rd, 5, 0, sample_count, 1500, 0, on_export, &s));
+    assert_int_equal(3, s.batches);
+
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_rd_fsr_export(rd, 5, 0, sample_count + 1, 0, 0, on_export, &s));
+
+    jls_rd_close(rd);
+    free(dst);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_f32_fork(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    struct jls_rd_s * fork = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_fork(rd, &fork));
+
+    // copied definitions
+    struct jls_signal_def_s signal_def;
+    assert_int_equal(0, jls_rd_signal(fork, 5, &signal_def));
+    assert_string_equal(SIGNAL_5.name, signal_def.name);
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(fork, 5, &samples));
+    assert_int_equal(sample_count, samples);
+
+    // independent cursors: interleaved reads from both handles
+    float data[1000];
+    float data_fork[1000];
+    for (int64_t sample_id = 0; sample_id < sample_count; sample_id += sample_count / 10) {
+        assert_int_equal(0, jls_rd_fsr_f32(rd, 5, sample_id, data, 1000));
+        assert_int_equal(0, jls_rd_fsr_f32(fork, 5, sample_count - 1000 - sample_id, data_fork, 1000));
+        assert_memory_equal(signal + sample_id, data, 1000 * sizeof(float));
+        assert_memory_equal(signal + sample_count - 1000 - sample_id, data_fork, 1000 * sizeof(float));
+    }
+
+    // fork remains valid after the parent closes
+    jls_rd_close(rd);
+    assert_int_equal(0, jls_rd_fsr_f32(fork, 5, 0, data_fork, 1000));
+    assert_memory_equal(signal, data_fork, 1000 * sizeof(float));
+    jls_rd_close(fork);
+
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_f32_sample_id_offset(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 1000;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    int64_t sample_id_offset = 100000000;
+
+    const int64_t utc = JLS_TIME_YEAR;   // one year after start of epoch
+
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id_offset + sample_id, signal + sample_id, WINDOW_SIZE));
+        assert_int_equal(0, jls_wr_utc(wr, 5, sample_id_offset + sample_id, utc + JLS_COUNTER_TO_TIME(sample_id, SIGNAL_5.sample_rate)));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    struct jls_signal_def_s * signals = NULL;
+    uint16_t count = 0;
+    assert_int_equal(0, jls_rd_signals(rd, &signals, &count));
+    assert_int_equal(2, count);
+    assert_int_equal(5, signals[1].signal_id);
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+
+    // get entire first data chunk.
+    float data[2000];
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, 1000));
+    assert_memory_equal(signal, data, 1000 * sizeof(float));
+
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        expect_utc(sample_id, utc + JLS_COUNTER_TO_TIME(sample_id, SIGNAL_5.sample_rate));
+    }
+    assert_int_equal(0, jls_rd_utc(rd, 5, 0, on_utc, NULL));
+
+    // check sample_id -> timestamp mapping
+    int64_t v = 0;
+    assert_int_equal(0, jls_rd_sample_id_to_timestamp(rd, 5, 0, &v));
+    assert_int_equal(utc, v);
+    assert_int_equal(0, jls_rd_sample_id_to_timestamp(rd, 5, 100000, &v));
+    assert_int_equal(utc + JLS_TIME_SECOND, v);
+
+    // check timestamp -> sample_id mapping
+    assert_int_equal(0, jls_rd_timestamp_to_sample_id(rd, 5, utc, &v));
+    assert_int_equal(0, v);
+    assert_int_equal(0, jls_rd_timestamp_to_sample_id(rd, 5, utc + JLS_TIME_SECOND, &v));
+    assert_int_equal(100000, v);
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void compare_stats_f32(double * data, float * src, size_t src_length) {
+    struct jls_statistics_s s1;
+    jls_statistics_reset(&s1);
+    jls_statistics_compute_f32(&s1, src, src_length);
+    assert_float_equal(s1.mean, data[JLS_SUMMARY_FSR_MEAN], 1e-7);
+    assert_float_equal(s1.min, data[JLS_SUMMARY_FSR_MIN], 1e-7);
+    assert_float_equal(s1.max, data[JLS_SUMMARY_FSR_MAX], 1e-7);
+    float v_std = (float) sqrt(jls_statistics_var(&s1));
+    assert_float_equal(v_std, data[JLS_SUMMARY_FSR_STD], 1e-7f + 0.0005f * v_std);
+}
+
+static void test_fsr_f32_statistics(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 1000;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_true(sample_count <= UINT32_MAX);
+    assert_int_equal(0, jls_wr_fsr(wr, 5, 0, signal, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+
+    double data[2000][JLS_SUMMARY_FSR_COUNT];
+    // within a single data chunk
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, 10, data[0], 100));
+    compare_stats_f32(data[0], signal, 10);
+    compare_stats_f32(data[1], signal + 10, 10);
+
+    // offset from start of chunk
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 15, 10, data[0], 2));
+    compare_stats_f32(data[0], signal + 15, 10);
+    compare_stats_f32(data[1], signal + 25, 10);
+
+    // span chunk 2 to 3
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 1999, 2, data[0], 2));
+    compare_stats_f32(data[0], signal + 1999, 2);
     compare_stats_f32(data[1], signal + 2001, 2);
 
-    // Span chunk 2 through 4
-    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 1999, 1002, data[0], 2));
-    compare_stats_f32(data[0], signal + 1999, 1002);
-    compare_stats_f32(data[1], signal + 3001, 1002);
+    // Span chunk 2 through 4
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 1999, 1002, data[0], 2));
+    compare_stats_f32(data[0], signal + 1999, 1002);
+    compare_stats_f32(data[1], signal + 3001, 1002);
+
+    // Span chunk 2 through 12
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 1999, 10002, data[0], 1));
+    compare_stats_f32(data[0], signal + 1999, 10002);
+
+    // Using summaries needing raw samples before and after
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 750, 10000, data[0], 1));
+    compare_stats_f32(data[0], signal + 750, 10000);
+
+    // wide unaligned interval straddling multiple summary levels
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 777, sample_count - 1500, data[0], 1));
+    compare_stats_f32(data[0], signal + 777, (size_t) (sample_count - 1500));
+
+    // get out of range statistics
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_fsr_statistics(rd, 5, -25, 10, data[0], 1));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_fsr_statistics(rd, 5, -5, 10, data[0], 1));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_fsr_statistics(rd, 5, sample_count - 5, 10, data[0], 1));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_fsr_statistics(rd, 5, sample_count + 5, 10, data[0], 1));
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_statistics_multi(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * current = gen_triangle(1000, sample_count);
+    assert_non_null(current);
+    float * voltage = malloc(sizeof(float) * (size_t) sample_count);
+    assert_non_null(voltage);
+    for (int64_t i = 0; i < sample_count; ++i) {
+        voltage[i] = 3.3f + 0.1f * current[i];
+    }
+    struct jls_signal_def_s voltage_def = SIGNAL_5;
+    voltage_def.signal_id = 4;
+    voltage_def.name = "signal 4";
+    voltage_def.units = "V";
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_signal_def(wr, &voltage_def));
+    assert_int_equal(0, jls_wr_fsr(wr, 5, 0, current, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_fsr(wr, 4, 0, voltage, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+
+    // entries match per-signal queries exactly, in signal_ids order
+    const uint16_t signal_ids[] = {5, 4};
+    const int64_t entries = 600;  // spans multiple scatter blocks
+    const int64_t increment = 100;  // one summary per entry: walk is exact
+    double * multi = malloc(sizeof(double) * entries * 2 * JLS_SUMMARY_FSR_COUNT);
+    double * single = malloc(sizeof(double) * entries * JLS_SUMMARY_FSR_COUNT);
+    assert_non_null(multi);
+    assert_non_null(single);
+    assert_int_equal(0, jls_rd_fsr_statistics_multi(rd, signal_ids, 2, 0, increment,
+                                                    multi, entries));
+    for (uint16_t k = 0; k < 2; ++k) {
+        assert_int_equal(0, jls_rd_fsr_statistics(rd, signal_ids[k], 0, increment,
+                                                  single, entries));
+        for (int64_t i = 0; i < entries; ++i) {
+            double * s = &single[i * JLS_SUMMARY_FSR_COUNT];
+            double * m = &multi[(i * 2 + k) * JLS_SUMMARY_FSR_COUNT];
+            assert_float_equal(s[JLS_SUMMARY_FSR_MEAN], m[JLS_SUMMARY_FSR_MEAN], 1e-7);
+            assert_float_equal(s[JLS_SUMMARY_FSR_STD], m[JLS_SUMMARY_FSR_STD], 1e-6);
+            assert_float_equal(s[JLS_SUMMARY_FSR_MIN], m[JLS_SUMMARY_FSR_MIN], 1e-7);
+            assert_float_equal(s[JLS_SUMMARY_FSR_MAX], m[JLS_SUMMARY_FSR_MAX], 1e-7);
+        }
+    }
+
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_rd_fsr_statistics_multi(rd, signal_ids, 0, 0, increment, multi, 1));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_rd_fsr_statistics_multi(rd, NULL, 2, 0, increment, multi, 1));
+
+    jls_rd_close(rd);
+    free(multi);
+    free(single);
+    free(voltage);
+    free(current);
+    remove(filename);
+}
+
+static void test_fsr_f32_statistics_resample(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 1000;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_fsr(wr, 5, 0, signal, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+
+    double data[1000][JLS_SUMMARY_FSR_COUNT];
+    double expect[JLS_SUMMARY_FSR_COUNT];
+
+    // output entries finer than level-1 summaries: exact per-entry computation
+    assert_int_equal(0, jls_rd_fsr_statistics_resample(rd, 5, 0, 46850, data[0], 937));
+    for (int64_t k = 0; k < 937; ++k) {
+        compare_stats_f32(data[k], signal + k * 50, 50);
+    }
+
+    // unaligned span with a width that does not divide it: summary composition
+    const int64_t start = 777;
+    const int64_t end = sample_count - 321;
+    const int64_t span = end - start;
+    const int64_t length = 97;
+    assert_int_equal(0, jls_rd_fsr_statistics_resample(rd, 5, start, end, data[0], length));
+    for (int64_t k = 0; k < length; ++k) {
+        int64_t s0 = start + (k * span) / length;
+        int64_t s1 = start + ((k + 1) * span) / length;
+        assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, s0, s1 - s0, expect, 1));
+        // entries straddling output boundaries are split proportionally,
+        // so the mean is approximate; min/max cover full triangle periods.
+        assert_float_equal(expect[JLS_SUMMARY_FSR_MEAN], data[k][JLS_SUMMARY_FSR_MEAN], 0.01);
+        assert_float_equal(expect[JLS_SUMMARY_FSR_MIN], data[k][JLS_SUMMARY_FSR_MIN], 1e-6);
+        assert_float_equal(expect[JLS_SUMMARY_FSR_MAX], data[k][JLS_SUMMARY_FSR_MAX], 1e-6);
+    }
+
+    // invalid arguments
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_rd_fsr_statistics_resample(rd, 5, 0, 1000, data[0], 0));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_rd_fsr_statistics_resample(rd, 5, 1000, 1000, data[0], 1));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_rd_fsr_statistics_resample(rd, 5, 0, 10, data[0], 20));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_rd_fsr_statistics_resample(rd, 5, 0, sample_count + 1, data[0], 1));
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_f32_find(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 1000;
+    float * signal = calloc((size_t) sample_count, sizeof(float));
+    assert_non_null(signal);
+    // sparse events in an otherwise constant signal
+    for (int64_t i = 100000; i < 100010; ++i) {
+        signal[i] = 5.0f;
+    }
+    signal[500000] = -3.0f;
+    for (int64_t i = 800000; i < 800500; ++i) {
+        signal[i] = 5.0f;
+    }
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_fsr(wr, 5, 0, signal, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+
+    struct jls_rd_fsr_find_range_s ranges[16];
+    int64_t count = 0;
+
+    // "where did the value exceed 2": exact sample ranges
+    assert_int_equal(0, jls_rd_fsr_find(rd, 5, 0, sample_count, 2.0, INFINITY,
+                                        ranges, 16, &count));
+    assert_int_equal(2, count);
+    assert_int_equal(100000, ranges[0].start);
+    assert_int_equal(100010, ranges[0].end);
+    assert_int_equal(800000, ranges[1].start);
+    assert_int_equal(800500, ranges[1].end);
+
+    // negative-going event
+    assert_int_equal(0, jls_rd_fsr_find(rd, 5, 0, sample_count, -4.0, -2.0,
+                                        ranges, 16, &count));
+    assert_int_equal(1, count);
+    assert_int_equal(500000, ranges[0].start);
+    assert_int_equal(500001, ranges[0].end);
+
+    // restricted search window excludes events outside it
+    assert_int_equal(0, jls_rd_fsr_find(rd, 5, 200000, sample_count, 2.0, INFINITY,
+                                        ranges, 16, &count));
+    assert_int_equal(1, count);
+    assert_int_equal(800000, ranges[0].start);
+
+    // the baseline matches everywhere else: count exceeds the allocation
+    assert_int_equal(0, jls_rd_fsr_find(rd, 5, 0, sample_count, -1.0, 1.0,
+                                        ranges, 1, &count));
+    assert_int_equal(4, count);
+    assert_int_equal(0, ranges[0].start);
+    assert_int_equal(100000, ranges[0].end);
+
+    // no matches
+    assert_int_equal(0, jls_rd_fsr_find(rd, 5, 0, sample_count, 10.0, INFINITY,
+                                        ranges, 16, &count));
+    assert_int_equal(0, count);
+
+    // invalid arguments
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_rd_fsr_find(rd, 5, 0, sample_count, 2.0, 1.0, ranges, 16, &count));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_rd_fsr_find(rd, 5, 0, sample_count + 1, 2.0, INFINITY, ranges, 16, &count));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_rd_fsr_find(rd, 5, 0, sample_count, 2.0, INFINITY, NULL, 16, &count));
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_f32_envelope(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 1000;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_fsr(wr, 5, 0, signal, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+
+    // envelope matches the statistics min/max for identical arguments
+    double stats[2000][JLS_SUMMARY_FSR_COUNT];
+    float envelope[2000][2];
+    struct {
+        int64_t start;
+        int64_t increment;
+        int64_t length;
+    } cases[] = {
+            {0, 10, 100},           // within a single data chunk
+            {15, 10, 2},            // offset from start of chunk
+            {1999, 1002, 2},        // spans chunks
+            {1999, 10002, 1},       // single interval
+            {0, 1000, 900},         // level 1 summaries
+            {777, 50000, 18},       // level 2 summaries, unaligned
+    };
+    for (size_t c = 0; c < ARRAY_SIZE(cases); ++c) {
+        assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, cases[c].start, cases[c].increment,
+                                                  stats[0], cases[c].length));
+        assert_int_equal(0, jls_rd_fsr_envelope(rd, 5, cases[c].start, cases[c].increment,
+                                                envelope[0], cases[c].length));
+        for (int64_t i = 0; i < cases[c].length; ++i) {
+            assert_float_equal((float) stats[i][JLS_SUMMARY_FSR_MIN], envelope[i][0], 1e-7);
+            assert_float_equal((float) stats[i][JLS_SUMMARY_FSR_MAX], envelope[i][1], 1e-7);
+        }
+    }
+
+    // out of range
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_fsr_envelope(rd, 5, -1, 10, envelope[0], 1));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_rd_fsr_envelope(rd, 5, sample_count - 5, 10, envelope[0], 1));
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_fsr_statistics_cursor(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 200;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_fsr(wr, 5, 0, signal, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    struct jls_rd_fsr_stats_cursor_s * cursor = NULL;
+    assert_int_equal(0, jls_rd_fsr_statistics_cursor_open(rd, 5, &cursor));
+
+    // sliding window with unaligned start and advance, compare against direct computation
+    const int64_t window = 30011;
+    double data[JLS_SUMMARY_FSR_COUNT];
+    for (int64_t start = 17; (start + window) <= sample_count; start += 1501) {
+        assert_int_equal(0, jls_rd_fsr_statistics_cursor_query(cursor, start, window, data));
+        compare_stats_f32(data, signal + start, (size_t) window);
+    }
+
+    // window below the cursor block size
+    assert_int_equal(0, jls_rd_fsr_statistics_cursor_query(cursor, 123, 45, data));
+    compare_stats_f32(data, signal + 123, 45);
+
+    // window resize discards the cache, results stay correct
+    assert_int_equal(0, jls_rd_fsr_statistics_cursor_query(cursor, 5000, 60000, data));
+    compare_stats_f32(data, signal + 5000, 60000);
+
+    // backward jump
+    assert_int_equal(0, jls_rd_fsr_statistics_cursor_query(cursor, 100, 60000, data));
+    compare_stats_f32(data, signal + 100, 60000);
+
+    // out of range
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_rd_fsr_statistics_cursor_query(cursor, -1, window, data));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_rd_fsr_statistics_cursor_query(cursor, sample_count - 10, window, data));
+
+    jls_rd_fsr_statistics_cursor_close(cursor);
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+struct progress_state_s {
+    int64_t calls;
+    int64_t bytes;
+    int64_t chunks;
+    uint8_t phase_last;
+    int64_t abort_after;    // abort when calls reaches this, 0 to never abort
+};
+
+static int32_t on_progress(void * user_data, uint8_t phase, int64_t bytes, int64_t chunks) {
+    struct progress_state_s * p = (struct progress_state_s *) user_data;
+    ++p->calls;
+    p->bytes = bytes;
+    p->chunks = chunks;
+    p->phase_last = phase;
+    if (p->abort_after && (p->calls >= p->abort_after)) {
+        return 1;
+    }
+    return 0;
+}
+
+static void test_rd_progress(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 1000;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+    free(signal);
+
+    // the open scan reports progress
+    struct progress_state_s p = {0, 0, 0, 255, 0};
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open_progress(&rd, filename, on_progress, &p));
+    assert_true(p.calls > 0);
+    assert_int_equal(JLS_RD_PHASE_OPEN, p.phase_last);
+    assert_true(p.bytes > 0);
+    assert_true(p.chunks > 0);
+
+    // statistics queries report the query phase,
+    // re-registration reports on the next chunk read
+    int64_t calls_open = p.calls;
+    double stats[JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(0, jls_rd_progress_register(rd, on_progress, &p));
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, sample_count, stats, 1));
+    assert_true(p.calls > calls_open);
+    assert_int_equal(JLS_RD_PHASE_QUERY, p.phase_last);
+
+    // a nonzero callback return aborts the query
+    p.abort_after = 1;
+    assert_int_equal(0, jls_rd_progress_register(rd, on_progress, &p));
+    assert_int_equal(JLS_ERROR_ABORTED, jls_rd_fsr_statistics(rd, 5, 0, sample_count, stats, 1));
+
+    // unregister restores normal operation
+    assert_int_equal(0, jls_rd_progress_register(rd, NULL, NULL));
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, sample_count, stats, 1));
+
+    // the counters accumulate over all of the reads above
+    struct jls_rd_counters_s counters;
+    assert_int_equal(0, jls_rd_counters(rd, &counters));
+    assert_true(counters.seeks > 0);
+    assert_true(counters.bytes_read > 0);
+    assert_true(counters.chunks > 0);
+    assert_true(counters.crc_bytes > 0);
+
+    // a fresh handle shows the physical cost of a cold query
+    struct jls_rd_s * rd2 = NULL;
+    assert_int_equal(0, jls_rd_open(&rd2, filename));
+    struct jls_rd_query_profile_s qp;
+    float data_q[1000];
+    assert_int_equal(0, jls_rd_fsr(rd2, 5, 0, data_q, 1000));
+    assert_int_equal(0, jls_rd_query_profile_get(rd2, &qp));
+    assert_int_equal(1000 * sizeof(float), qp.logical_bytes);
+    assert_true(qp.physical_bytes > qp.logical_bytes);  // whole chunks plus headers
+
+    // a narrow statistics query returns far less than the fsr read
+    assert_int_equal(0, jls_rd_fsr_statistics(rd2, 5, 0, 100, stats, 1));
+    assert_int_equal(0, jls_rd_query_profile_get(rd2, &qp));
+    assert_int_equal(JLS_SUMMARY_FSR_COUNT * sizeof(double), qp.logical_bytes);
+    jls_rd_close(rd2);
+
+    jls_rd_close(rd);
+    remove(filename);
+}
+
+static void test_fsr_f32_parallel_summary(void **state) {
+    // summaries reduced on a per-signal worker thread, file layout unchanged
+    (void) state;
+#ifdef _WIN32
+    _putenv("JLS_PARALLEL_SUMMARY=1");
+#else
+    setenv("JLS_PARALLEL_SUMMARY", "1", 1);
+#endif
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+#ifdef _WIN32
+    _putenv("JLS_PARALLEL_SUMMARY=");
+#else
+    unsetenv("JLS_PARALLEL_SUMMARY");
+#endif
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+
+    float data[1000];
+    for (int64_t sample_id = 0; sample_id < sample_count; sample_id += sample_count / 10) {
+        assert_int_equal(0, jls_rd_fsr_f32(rd, 5, sample_id, data, 1000));
+        assert_memory_equal(signal + sample_id, data, 1000 * sizeof(float));
+    }
+
+    // summary-backed statistics must match the synchronous path
+    double stats[JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 750, 10000, stats, 1));
+    compare_stats_f32(stats, signal + 750, 10000);
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static int64_t file_size(const char * path) {
+    FILE * f = fopen(path, "rb");
+    assert_non_null(f);
+    fseek(f, 0, SEEK_END);
+    int64_t sz = ftell(f);
+    fclose(f);
+    return sz;
+}
+
+static void test_fsr_f32_compression(void **state) {
+    // chunk payloads compressed on write, decompressed transparently on read
+    (void) state;
+#ifdef _WIN32
+    _putenv("JLS_COMPRESSION=rle");
+#else
+    setenv("JLS_COMPRESSION", "rle", 1);
+#endif
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = calloc(sample_count, sizeof(float));
+    assert_non_null(signal);
+    for (int64_t i = 0; i < sample_count; i += 1000) {
+        signal[i] = 100.0f;  // sparse spikes so RLE shrinks the data chunks
+    }
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+#ifdef _WIN32
+    _putenv("JLS_COMPRESSION=");
+#else
+    unsetenv("JLS_COMPRESSION");
+#endif
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
 
-    // Span chunk 2 through 12
-    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 1999, 10002, data[0], 1));
-    compare_stats_f32(data[0], signal + 1999, 10002);
+    float data[1000];
+    for (int64_t sample_id = 0; sample_id < sample_count; sample_id += sample_count / 10) {
+        assert_int_equal(0, jls_rd_fsr_f32(rd, 5, sample_id, data, 1000));
+        assert_memory_equal(signal + sample_id, data, 1000 * sizeof(float));
+    }
 
-    // Using summaries needing raw samples before and after
-    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 750, 10000, data[0], 1));
-    compare_stats_f32(data[0], signal + 750, 10000);
+    // summary-backed statistics decompress the summary chunks
+    double stats_z[JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, 10000, stats_z, 1));
+    jls_rd_close(rd);
+    int64_t size_z = file_size(filename);
+    remove(filename);
 
-    // get out of range statistics
-    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_fsr_statistics(rd, 5, -25, 10, data[0], 1));
-    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_fsr_statistics(rd, 5, -5, 10, data[0], 1));
-    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_fsr_statistics(rd, 5, sample_count - 5, 10, data[0], 1));
-    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_fsr_statistics(rd, 5, sample_count + 5, 10, data[0], 1));
+    // the same signal uncompressed must produce identical statistics
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+    assert_true(size_z < file_size(filename));
+
+    double stats[JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, 10000, stats, 1));
+    assert_memory_equal(stats, stats_z, sizeof(stats));
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+struct crc_defer_ctx_s {
+    volatile int32_t failures;
+    volatile int32_t complete;
+    int64_t offset;
+};
+
+static void on_integrity(void * user_data, int64_t offset, uint8_t tag, int32_t error) {
+    struct crc_defer_ctx_s * ctx = (struct crc_defer_ctx_s *) user_data;
+    (void) tag;
+    if (offset < 0) {
+        ctx->complete = 1;
+    } else if (error) {
+        ++ctx->failures;
+        ctx->offset = offset;
+    }
+}
+
+static void crc_defer_wait(struct crc_defer_ctx_s * ctx) {
+    for (int i = 0; (i < 5000) && !ctx->complete; ++i) {
+        jls_bkt_sleep_ms(1);
+    }
+    assert_true(ctx->complete);
+}
+
+static void test_crc_defer(void **state) {
+    // deferred CRC verification: inline check skipped, background scan reports
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    // clean file: reads still correct, scan reports no failures
+    struct crc_defer_ctx_s ctx = {.failures = 0, .complete = 0, .offset = 0};
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_crc_defer(rd, on_integrity, &ctx));
+    float data[1000];
+    for (int64_t sample_id = 0; sample_id < sample_count; sample_id += sample_count / 10) {
+        assert_int_equal(0, jls_rd_fsr_f32(rd, 5, sample_id, data, 1000));
+        assert_memory_equal(signal + sample_id, data, 1000 * sizeof(float));
+    }
+    crc_defer_wait(&ctx);
+    assert_int_equal(0, ctx.failures);
+    jls_rd_close(rd);
+
+    // locate a data chunk payload and corrupt one byte.
+    // skip the first data chunks: jls_rd_open() reads those inline.
+    struct jls_raw_s * raw = NULL;
+    struct jls_chunk_header_s hdr;
+    int64_t corrupt_offset = 0;
+    int matches = 0;
+    assert_int_equal(0, jls_raw_open(&raw, filename, "r"));
+    while (0 == jls_raw_rd_header(raw, &hdr)) {
+        if ((JLS_TAG_TRACK_FSR_DATA == hdr.tag) && (hdr.payload_length > 64) && (++matches == 3)) {
+            corrupt_offset = jls_raw_chunk_tell(raw) + sizeof(hdr) + 40;
+            break;
+        }
+        if (jls_raw_chunk_next(raw)) {
+            break;
+        }
+    }
+    assert_int_equal(0, jls_raw_close(raw));
+    assert_true(corrupt_offset > 0);
+    FILE * f = fopen(filename, "rb+");
+    assert_non_null(f);
+    fseek(f, (long) corrupt_offset, SEEK_SET);
+    int b = fgetc(f);
+    fseek(f, (long) corrupt_offset, SEEK_SET);
+    fputc(b ^ 0xff, f);
+    fclose(f);
+
+    // the scan must report the corrupted payload
+    struct crc_defer_ctx_s ctx2 = {.failures = 0, .complete = 0, .offset = 0};
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_crc_defer(rd, on_integrity, &ctx2));
+    crc_defer_wait(&ctx2);
+    assert_int_equal(1, ctx2.failures);
+    free(signal);
+    jls_rd_close(rd);
+    remove(filename);
+}
+
+static void test_fsr_mem_config(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_fsr(wr, 5, 0, signal, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+
+    double data[JLS_SUMMARY_FSR_COUNT];
+    // budget too small for the f64 working buffers
+    assert_int_equal(0, jls_rd_mem_config(rd, 4096));
+    assert_int_equal(JLS_ERROR_NOT_ENOUGH_MEMORY, jls_rd_fsr_statistics(rd, 5, 750, 10000, data, 1));
+
+    // generous budget
+    assert_int_equal(0, jls_rd_mem_config(rd, 64 * 1024 * 1024));
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 750, 10000, data, 1));
+    compare_stats_f32(data, signal + 750, 10000);
+
+    // restore unlimited
+    assert_int_equal(0, jls_rd_mem_config(rd, 0));
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 750, 10000, data, 1));
+    compare_stats_f32(data, signal + 750, 10000);
+
+    // trim releases the retained buffers; queries still work afterwards
+    assert_int_equal(0, jls_rd_mem_trim(rd));
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 750, 10000, data, 1));
+    compare_stats_f32(data, signal + 750, 10000);
+    assert_int_equal(0, jls_rd_mem_trim(rd));
+    assert_int_equal(0, jls_rd_mem_trim(rd));  // idempotent
 
     jls_rd_close(rd);
     free(signal);
@@ -714,13 +3010,24 @@ static void test_fsr_f64(void **state) {
     assert_int_equal(0, jls_wr_open(&wr, filename));
     assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
     assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_8));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
     assert_true(sample_count <= UINT32_MAX);
-    assert_int_equal(0, jls_wr_fsr(wr, SIGNAL_8.signal_id, 0, signal, (uint32_t) sample_count));
+    assert_int_equal(0, jls_wr_fsr_f64(wr, SIGNAL_8.signal_id, 0, signal, (uint32_t) sample_count));
+    // typed write requires the f64 data type
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_wr_fsr_f64(wr, 5, 0, signal, 1000));
     assert_int_equal(0, jls_wr_close(wr));
 
     struct jls_rd_s * rd = NULL;
     assert_int_equal(0, jls_rd_open(&rd, filename));
 
+    double data_rd[2000];
+    assert_int_equal(0, jls_rd_fsr_f64(rd, SIGNAL_8.signal_id, 0, data_rd, 2000));
+    assert_memory_equal(signal, data_rd, 2000 * sizeof(double));
+    assert_int_equal(0, jls_rd_fsr_f64(rd, SIGNAL_8.signal_id, 1999, data_rd, 1002));
+    assert_memory_equal(signal + 1999, data_rd, 1002 * sizeof(double));
+    // typed read requires the f64 data type
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_rd_fsr_f64(rd, 5, 0, data_rd, 10));
+
     //double data[JLS_SUMMARY_FSR_COUNT];
     //assert_int_equal(0, jls_rd_fsr_f64_statistics(rd, SIGNAL_8.signal_id, 0, 1000, data[0], 1));
     //compare_stats(data, signal, 1000);
@@ -811,6 +3118,93 @@ static void test_fsr_samples_int_uint(void **state) {
     }
 }
 
+static void test_fsr_delta_encoding(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+
+    uint64_t src_data_u64[1024];
+    uint64_t dst_data_u64[1024];
+
+    uint32_t data_types[] = {
+            JLS_DATATYPE_U8, JLS_DATATYPE_U24, JLS_DATATYPE_U64,
+            JLS_DATATYPE_I16, JLS_DATATYPE_I32,
+    };
+
+    for (size_t idx = 0; idx < ARRAY_SIZE(src_data_u64); ++idx) {
+        src_data_u64[idx] = (uint64_t) idx;
+    }
+
+    struct jls_signal_def_s signal_7 = {
+            .signal_id = 7,
+            .source_id = 3,
+            .signal_type = JLS_SIGNAL_TYPE_FSR,
+            .data_encoding = JLS_FSR_DATA_ENCODING_DELTA,
+            .data_type = JLS_DATATYPE_I16,
+            .sample_rate = 100000,
+            .samples_per_data = 1000,
+            .sample_decimate_factor = 100,
+            .entries_per_summary = 200,
+            .summary_decimate_factor = 100,
+            .annotation_decimate_factor = 100,
+            .utc_decimate_factor = 100,
+            .name = "signal 7",
+            .units = "A",
+    };
+
+    // round trip for each integer data type, across multiple data chunks
+    for (uint32_t idx = 0; idx < ARRAY_SIZE(data_types); ++idx) {
+        signal_7.data_type = data_types[idx];
+        assert_int_equal(0, jls_wr_open(&wr, filename));
+        assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+        assert_int_equal(0, jls_wr_signal_def(wr, &signal_7));
+        uint32_t data_length = (sizeof(src_data_u64) * 8) / jls_datatype_parse_size(signal_7.data_type);
+        assert_int_equal(0, jls_wr_fsr(wr, signal_7.signal_id, 0, src_data_u64, data_length));
+        assert_int_equal(0, jls_wr_close(wr));
+
+        struct jls_rd_s * rd = NULL;
+        assert_int_equal(0, jls_rd_open(&rd, filename));
+        struct jls_signal_def_s * signals = NULL;
+        uint16_t count = 0;
+        assert_int_equal(0, jls_rd_signals(rd, &signals, &count));
+        assert_int_equal(2, count);
+        assert_int_equal(JLS_FSR_DATA_ENCODING_DELTA, signals[1].data_encoding);
+        int64_t samples = 0;
+        assert_int_equal(0, jls_rd_fsr_length(rd, signal_7.signal_id, &samples));
+        assert_int_equal(data_length, samples);
+        assert_int_equal(0, jls_rd_fsr(rd, signal_7.signal_id, 0, dst_data_u64, samples));
+        assert_memory_equal(src_data_u64, dst_data_u64, sizeof(src_data_u64));
+        jls_rd_close(rd);
+        remove(filename);
+    }
+
+    // delta encoding rejects floating-point signals
+    signal_7.data_type = JLS_DATATYPE_F32;
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_wr_signal_def(wr, &signal_7));
+    assert_int_equal(0, jls_wr_close(wr));
+    remove(filename);
+
+    // a slowly varying channel must pack smaller than verbatim storage
+    int16_t ramp[8192];
+    for (size_t i = 0; i < ARRAY_SIZE(ramp); ++i) {
+        ramp[i] = (int16_t) (1000 + (i & 0x3f));
+    }
+    signal_7.data_type = JLS_DATATYPE_I16;
+    int64_t sizes[2];
+    for (int pass = 0; pass < 2; ++pass) {
+        signal_7.data_encoding = pass ? JLS_FSR_DATA_ENCODING_RAW : JLS_FSR_DATA_ENCODING_DELTA;
+        assert_int_equal(0, jls_wr_open(&wr, filename));
+        assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+        assert_int_equal(0, jls_wr_signal_def(wr, &signal_7));
+        assert_int_equal(0, jls_wr_fsr(wr, signal_7.signal_id, 0, ramp, ARRAY_SIZE(ramp)));
+        assert_int_equal(0, jls_wr_close(wr));
+        sizes[pass] = file_size(filename);
+        remove(filename);
+    }
+    assert_true(sizes[0] < sizes[1]);
+}
+
 // todo static void test_fsr_uint_fp(void **state)
 // todo static void test_fsr_int_fp(void **state)
 
@@ -877,6 +3271,115 @@ static void test_fsr_statistics_u1(void **state) {
     remove(filename);
 }
 
+static void test_fsr_statistics_i16(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+
+    int16_t src_data_i16[1024];
+    for (size_t idx = 0; idx < ARRAY_SIZE(src_data_i16); ++idx) {
+        src_data_i16[idx] = (int16_t) (idx % 16);
+    }
+
+    struct jls_signal_def_s signal_8 = {
+            .signal_id = 8,
+            .source_id = 3,
+            .signal_type = JLS_SIGNAL_TYPE_FSR,
+            .data_type = JLS_DATATYPE_I16,
+            .sample_rate = 100000,
+            .samples_per_data = 1024,
+            .sample_decimate_factor = 1024,
+            .entries_per_summary = 256,
+            .summary_decimate_factor = 128,
+            .annotation_decimate_factor = 100,
+            .utc_decimate_factor = 100,
+            .name = "signal 8",
+            .units = "A",
+    };
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &signal_8));
+    for (int i = 0; i < 1024; ++i) {
+        assert_int_equal(0, jls_wr_fsr(wr, signal_8.signal_id, i * 1024, src_data_i16, 1024));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, signal_8.signal_id, &samples));
+    assert_int_equal(1024 * 1024, samples);
+
+    // values repeat 0..15: mean 7.5, var 21.25, min 0, max 15
+    double stats[JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, signal_8.signal_id, 0, 1024 * 1024, stats, 1));
+    assert_float_equal(7.5, stats[JLS_SUMMARY_FSR_MEAN], 1e-9);
+    assert_float_equal(sqrt(21.25), stats[JLS_SUMMARY_FSR_STD], 1e-4);  // summaries stored as f32
+    assert_float_equal(0.0, stats[JLS_SUMMARY_FSR_MIN], 1e-15);
+    assert_float_equal(15.0, stats[JLS_SUMMARY_FSR_MAX], 1e-15);
+
+    jls_rd_close(rd);
+    remove(filename);
+}
+
+static void test_fsr_statistics_parallel(void **state) {
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+
+    int16_t src_data_i16[1024];
+    for (size_t idx = 0; idx < ARRAY_SIZE(src_data_i16); ++idx) {
+        src_data_i16[idx] = (int16_t) (idx % 16);
+    }
+
+    struct jls_signal_def_s signal_8 = {
+            .signal_id = 8,
+            .source_id = 3,
+            .signal_type = JLS_SIGNAL_TYPE_FSR,
+            .data_type = JLS_DATATYPE_I16,
+            .sample_rate = 100000,
+            .samples_per_data = 1024,
+            .sample_decimate_factor = 1024,
+            .entries_per_summary = 256,
+            .summary_decimate_factor = 128,
+            .annotation_decimate_factor = 100,
+            .utc_decimate_factor = 100,
+            .name = "signal 8",
+            .units = "A",
+    };
+
+    // 16M samples: enough to engage the parallel single-interval reduction
+    const int64_t sample_count = 16 * 1024 * 1024;
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &signal_8));
+    for (int64_t i = 0; i < (sample_count / 1024); ++i) {
+        assert_int_equal(0, jls_wr_fsr(wr, signal_8.signal_id, i * 1024, src_data_i16, 1024));
+    }
+    assert_int_equal(0, jls_wr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+
+    // values repeat 0..15: mean 7.5, var 21.25, min 0, max 15
+    double stats[JLS_SUMMARY_FSR_COUNT];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, signal_8.signal_id, 0, sample_count, stats, 1));
+    assert_float_equal(7.5, stats[JLS_SUMMARY_FSR_MEAN], 1e-9);
+    assert_float_equal(sqrt(21.25), stats[JLS_SUMMARY_FSR_STD], 1e-4);  // summaries stored as f32
+    assert_float_equal(0.0, stats[JLS_SUMMARY_FSR_MIN], 1e-15);
+    assert_float_equal(15.0, stats[JLS_SUMMARY_FSR_MAX], 1e-15);
+
+    // unaligned interval: worker spans split mid-chunk
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, signal_8.signal_id, 1003,
+                                              sample_count - 2005, stats, 1));
+    assert_float_equal(7.5, stats[JLS_SUMMARY_FSR_MEAN], 1e-3);
+    assert_float_equal(sqrt(21.25), stats[JLS_SUMMARY_FSR_STD], 1e-3);
+    assert_float_equal(0.0, stats[JLS_SUMMARY_FSR_MIN], 1e-15);
+    assert_float_equal(15.0, stats[JLS_SUMMARY_FSR_MAX], 1e-15);
+
+    jls_rd_close(rd);
+    remove(filename);
+}
+
 static void test_fsr_f32_sample_skip(void **state) {
     (void) state;
     struct jls_wr_s * wr = NULL;
@@ -910,6 +3413,59 @@ static void test_fsr_f32_sample_skip(void **state) {
     remove(filename);
 }
 
+static void test_fsr_f32_gap(void **state) {
+    // a large skip writes constant-run gap markers, not staged filler
+    (void) state;
+    struct jls_wr_s * wr = NULL;
+    const int64_t gap_end = 500000;
+    float * signal = gen_triangle(1000, 3000);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, 0, &signal[0], 1500));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 5, gap_end, &signal[1500], 1500));
+    assert_int_equal(0, jls_wr_close(wr));
+
+    // far smaller than the ~2 MB the gap occupies as staged filler
+    assert_true(file_size(filename) < (256 * 1024));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(gap_end + 1500, samples);
+
+    float data[3000];
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, 3000));
+    assert_memory_equal(signal, data, 1500 * sizeof(float));
+    for (int idx = 1500; idx < 3000; ++idx) {
+        assert_true(isnan(data[idx]));
+    }
+    // spot check the middle of the gap and the unaligned tail
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 250123, data, 1000));
+    for (int idx = 0; idx < 1000; ++idx) {
+        assert_true(isnan(data[idx]));
+    }
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, gap_end - 500, data, 2000));
+    for (int idx = 0; idx < 500; ++idx) {
+        assert_true(isnan(data[idx]));
+    }
+    assert_memory_equal(signal + 1500, data + 500, 1500 * sizeof(float));
+
+    // summaries over the gap are NaN, real data statistics unaffected
+    double stats[4];
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 10000, 100000, stats, 1));
+    assert_true(isnan(stats[JLS_SUMMARY_FSR_MEAN]));
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, 1000, stats, 1));
+    assert_false(isnan(stats[JLS_SUMMARY_FSR_MEAN]));
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
 static void test_fsr_u1_sample_skip(void **state) {
     (void) state;
     struct jls_wr_s * wr = NULL;
@@ -1027,8 +3583,12 @@ int main(void) {
             cmocka_unit_test(test_source),
             cmocka_unit_test(test_source_with_null_and_empty_str),
             cmocka_unit_test(test_wr_source_duplicate),
+            cmocka_unit_test(test_signal_def_auto),
             cmocka_unit_test(test_annotation),
             cmocka_unit_test(test_annotation_seek),
+            cmocka_unit_test(test_annotation_range),
+            cmocka_unit_test(test_annotation_append),
+            cmocka_unit_test(test_annotation_find),
             cmocka_unit_test(test_hmarker),
             cmocka_unit_test(test_user_data),
             cmocka_unit_test(test_utc),
@@ -1036,20 +3596,61 @@ int main(void) {
             cmocka_unit_test(test_utc_seek_first_block),
             cmocka_unit_test(test_utc_seek_second_block_start),
             cmocka_unit_test(test_utc_seek_second_block_middle),
+            cmocka_unit_test(test_utc_range),
+            cmocka_unit_test(test_utc_tmap_sidecar),
+            cmocka_unit_test(test_fsr_by_utc),
 
             cmocka_unit_test(test_signal),
+            cmocka_unit_test(test_directory),
             cmocka_unit_test(test_wr_signal_without_source),
             cmocka_unit_test(test_wr_signal_duplicate),
 #endif
             cmocka_unit_test(test_fsr_f32),
+            cmocka_unit_test(test_shared_cache),
+            cmocka_unit_test(test_prefetch),
+            cmocka_unit_test(test_fsr_async),
+            cmocka_unit_test(test_fsr_cancel_budget),
+            cmocka_unit_test(test_chunk_clock),
+            cmocka_unit_test(test_fsr_data_map),
+            cmocka_unit_test(test_fsr_f32_open_async),
+            cmocka_unit_test(test_fsr_write_scale_transform),
+            cmocka_unit_test(test_fsr_suspend_resume),
+            cmocka_unit_test(test_fsr_f32_mmap),
+            cmocka_unit_test(test_fsr_f32_batch),
+            cmocka_unit_test(test_fsr_f32_io_uring),
+            cmocka_unit_test(test_fsr_f32_double_buffer),
+            cmocka_unit_test(test_fsr_f32_append_only),
+            cmocka_unit_test(test_fsr_f32_append_only_strict),
+            cmocka_unit_test(test_fsr_f32_follow),
+            cmocka_unit_test(test_fsr_f32_summary_preview),
+            cmocka_unit_test(test_fsr_f32_ring),
+            cmocka_unit_test(test_fsr_f32_multi),
+            cmocka_unit_test(test_fsr_f32_extract),
+            cmocka_unit_test(test_fsr_f32_iter),
+            cmocka_unit_test(test_fsr_f32_export),
+            cmocka_unit_test(test_fsr_f32_fork),
             cmocka_unit_test(test_fsr_f32_sample_id_offset),
             cmocka_unit_test(test_fsr_f32_statistics),
+            cmocka_unit_test(test_fsr_statistics_multi),
+            cmocka_unit_test(test_fsr_f32_statistics_resample),
+            cmocka_unit_test(test_fsr_f32_find),
+            cmocka_unit_test(test_fsr_f32_envelope),
+            cmocka_unit_test(test_fsr_statistics_cursor),
+            cmocka_unit_test(test_rd_progress),
+            cmocka_unit_test(test_fsr_mem_config),
+            cmocka_unit_test(test_fsr_f32_parallel_summary),
+            cmocka_unit_test(test_fsr_f32_compression),
+            cmocka_unit_test(test_crc_defer),
             cmocka_unit_test(test_fsr_f64),
 
             cmocka_unit_test(test_fsr_samples_int_uint),
+            cmocka_unit_test(test_fsr_delta_encoding),
             cmocka_unit_test(test_fsr_statistics_u1),
+            cmocka_unit_test(test_fsr_statistics_i16),
+            cmocka_unit_test(test_fsr_statistics_parallel),
 
             cmocka_unit_test(test_fsr_f32_sample_skip),
+            cmocka_unit_test(test_fsr_f32_gap),
             cmocka_unit_test(test_fsr_u1_sample_skip),
             cmocka_unit_test(test_fsr_u1_auto_def),
 
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "jls/log.h"
+#include "jls/ec.h"
+#include <stdio.h>
+#include <string.h>
+
+
+static volatile int msg_count_ = 0;
+static char msg_last_[1024];
+
+static void on_msg(const char * msg) {
+    snprintf(msg_last_, sizeof(msg_last_), "%s", msg);
+    ++msg_count_;
+}
+
+static void test_unregistered_is_silent(void **state) {
+    (void) state;
+    // before any handler registration, logging must be safe and free
+    msg_count_ = 0;
+    jls_log_printf("unheard message %d\n", 1);
+    assert_int_equal(0, msg_count_);
+}
+
+static void test_sync(void **state) {
+    (void) state;
+    msg_count_ = 0;
+    jls_log_register(on_msg);
+    jls_log_printf("hello %d\n", 42);
+    assert_int_equal(1, msg_count_);
+    assert_string_equal("hello 42\n", msg_last_);
+    jls_log_unregister();
+    jls_log_printf("after unregister %d\n", 1);
+    assert_int_equal(1, msg_count_);
+}
+
+static void test_async(void **state) {
+    (void) state;
+    msg_count_ = 0;
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_log_async_register(NULL));
+    assert_int_equal(0, jls_log_async_register(on_msg));
+    assert_int_equal(JLS_ERROR_BUSY, jls_log_async_register(on_msg));
+    jls_log_printf("async message %d\n", 1);
+    jls_log_async_unregister();  // drains before return
+    assert_true(msg_count_ >= 1);
+    jls_log_async_unregister();  // second unregister is a no-op
+}
+
+static void test_async_rate_limit(void **state) {
+    (void) state;
+    msg_count_ = 0;
+    assert_int_equal(0, jls_log_async_register(on_msg));
+    // a single-site burst well beyond the per-second limit
+    for (int i = 0; i < 1000; ++i) {
+        jls_log_printf("burst message %d\n", i);
+    }
+    jls_log_async_unregister();
+    assert_true(msg_count_ >= JLS_LOG_RATE_LIMIT_PER_SECOND);
+    assert_true(msg_count_ < 1000);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(test_unregistered_is_silent),
+            cmocka_unit_test(test_sync),
+            cmocka_unit_test(test_async),
+            cmocka_unit_test(test_async_rate_limit),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "jls/msg_ring_buffer.h"
+#include <stdio.h>
+#include <string.h>
+
+
+#define BUFFER_SIZE (256)
+static uint8_t buffer[BUFFER_SIZE];
+
+
+static int32_t msg_put(struct jls_mrb_s * mrb, uint32_t size, uint8_t value) {
+    uint8_t * msg = jls_mrb_alloc(mrb, size);
+    if (NULL == msg) {
+        return 1;
+    }
+    memset(msg, value, size);
+    jls_mrb_commit(mrb);
+    return 0;
+}
+
+static void msg_expect(struct jls_mrb_s * mrb, uint32_t size_expect, uint8_t value) {
+    uint32_t size = 0;
+    uint8_t * msg = jls_mrb_pop(mrb, &size);
+    assert_non_null(msg);
+    assert_int_equal(size_expect, size);
+    for (uint32_t i = 0; i < size; ++i) {
+        assert_int_equal(value, msg[i]);
+    }
+}
+
+static void test_basic(void **state) {
+    (void) state;
+    struct jls_mrb_s mrb;
+    jls_mrb_init(&mrb, buffer, BUFFER_SIZE);
+    assert_int_equal(0, jls_mrb_used_bytes(&mrb));
+
+    uint32_t size = 0;
+    assert_null(jls_mrb_pop(&mrb, &size));
+    assert_int_equal(0, msg_put(&mrb, 16, 0xa5));
+    assert_int_equal(20, jls_mrb_used_bytes(&mrb));
+    assert_int_equal(1, mrb.count);
+    msg_expect(&mrb, 16, 0xa5);
+    assert_int_equal(0, jls_mrb_used_bytes(&mrb));
+    assert_int_equal(0, mrb.count);
+}
+
+static void test_wrap(void **state) {
+    (void) state;
+    struct jls_mrb_s mrb;
+    jls_mrb_init(&mrb, buffer, BUFFER_SIZE);
+    // many iterations to exercise the wrap path repeatedly
+    for (uint8_t i = 0; i < 100; ++i) {
+        assert_int_equal(0, msg_put(&mrb, 60, i));
+        assert_int_equal(0, msg_put(&mrb, 60, i + 100));
+        msg_expect(&mrb, 60, i);
+        msg_expect(&mrb, 60, i + 100);
+    }
+}
+
+static void test_full_without_overflow(void **state) {
+    (void) state;
+    struct jls_mrb_s mrb;
+    jls_mrb_init(&mrb, buffer, BUFFER_SIZE);
+    uint8_t value = 0;
+    while (0 == msg_put(&mrb, 60, value)) {
+        ++value;
+    }
+    assert_true(value >= 3);  // buffer held several messages, then filled
+    for (uint8_t i = 0; i < value; ++i) {
+        msg_expect(&mrb, 60, i);
+    }
+    uint32_t size = 0;
+    assert_null(jls_mrb_pop(&mrb, &size));
+}
+
+static void test_overflow_chain(void **state) {
+    (void) state;
+    struct jls_mrb_s mrb;
+    jls_mrb_init(&mrb, buffer, BUFFER_SIZE);
+    jls_mrb_overflow_set(&mrb, BUFFER_SIZE, 4096);
+
+    // a burst far beyond the primary buffer capacity, FIFO preserved
+    uint8_t count = 0;
+    while (0 == msg_put(&mrb, 60, count)) {
+        ++count;
+    }
+    assert_true(count > 10);  // chained well past the primary buffer
+    assert_true(mrb.overflow_bytes > 0);
+    for (uint8_t i = 0; i < count; ++i) {
+        msg_expect(&mrb, 60, i);
+    }
+    uint32_t size = 0;
+    assert_null(jls_mrb_pop(&mrb, &size));
+
+    // after the drain, the next message reuses the primary segment and
+    // the consumer frees the last heap segment as it advances
+    assert_int_equal(0, msg_put(&mrb, 60, 200));
+    msg_expect(&mrb, 60, 200);
+    assert_int_equal(0, mrb.overflow_bytes);
+}
+
+static void test_overflow_interleaved(void **state) {
+    (void) state;
+    struct jls_mrb_s mrb;
+    jls_mrb_init(&mrb, buffer, BUFFER_SIZE);
+    jls_mrb_overflow_set(&mrb, BUFFER_SIZE, 1 << 16);
+
+    // steady-state with intermittent bursts: pop 1 for every 3 pushed
+    uint8_t wr_value = 0;
+    uint8_t rd_value = 0;
+    for (int i = 0; i < 50; ++i) {
+        assert_int_equal(0, msg_put(&mrb, 30, wr_value++));
+        assert_int_equal(0, msg_put(&mrb, 30, wr_value++));
+        assert_int_equal(0, msg_put(&mrb, 30, wr_value++));
+        msg_expect(&mrb, 30, rd_value++);
+    }
+    while (rd_value != wr_value) {
+        msg_expect(&mrb, 30, rd_value++);
+    }
+    uint32_t size = 0;
+    assert_null(jls_mrb_pop(&mrb, &size));
+    assert_int_equal(0, jls_mrb_used_bytes(&mrb));
+
+    jls_mrb_clear(&mrb);
+    assert_int_equal(0, mrb.overflow_bytes);
+}
+
+static void test_clear_with_pending_overflow(void **state) {
+    (void) state;
+    struct jls_mrb_s mrb;
+    jls_mrb_init(&mrb, buffer, BUFFER_SIZE);
+    jls_mrb_overflow_set(&mrb, BUFFER_SIZE, 4096);
+    uint8_t value = 0;
+    while (0 == msg_put(&mrb, 60, value)) {
+        ++value;
+    }
+    jls_mrb_clear(&mrb);  // frees the chained segments
+    assert_int_equal(0, mrb.overflow_bytes);
+    assert_int_equal(0, mrb.count);
+    assert_int_equal(0, msg_put(&mrb, 60, 1));
+    msg_expect(&mrb, 60, 1);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(test_basic),
+            cmocka_unit_test(test_wrap),
+            cmocka_unit_test(test_full_without_overflow),
+            cmocka_unit_test(test_overflow_chain),
+            cmocka_unit_test(test_overflow_interleaved),
+            cmocka_unit_test(test_clear_with_pending_overflow),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
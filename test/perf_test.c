@@ -0,0 +1,317 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief Timed throughput regression suites for the known hot paths.
+ *
+ * Built by the JLS_PERF_TEST CMake option so that releases fail
+ * loudly on throughput regressions the same way they fail on
+ * correctness.  Each suite measures one hot path for a fixed window
+ * and compares against a stored per-platform baseline:
+ *
+ *     JLS_PERF_BASELINE=baseline_x64.txt ctest -R perf_test
+ *
+ * When the baseline file does not exist, the run records the
+ * measured values to it and passes.  Later runs on the same
+ * platform fail any suite that drops below the baseline times the
+ * tolerance (JLS_PERF_TOLERANCE, default 0.80).  Without
+ * JLS_PERF_BASELINE, the suites report measurements and pass.
+ * Baselines are wall-clock throughput: record and compare them on
+ * the same quiet machine.
+ *
+ * jls_core_fsr_summaryN() is exercised through the public FSR write
+ * path since its reduction kernels are static to src/wr_fsr.c.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "jls/backend.h"
+#include "jls/crc32c.h"
+#include "jls/ec.h"
+#include "jls/format.h"
+#include "jls/raw.h"
+#include "jls/statistics.h"
+#include "jls/time.h"
+#include "jls/writer.h"
+#include "jls/bit_shift.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define PERF_WINDOW (JLS_TIME_SECOND / 4)   // the measurement window per suite
+#define PERF_TOLERANCE_DEFAULT (0.80)       // fail below this fraction of baseline
+#define BUFFER_SIZE (65536)
+#define RAW_WR_PAYLOAD_SIZE (4096)
+#define RAW_WR_CHUNKS_PER_PASS (4096)       // bound the arena growth
+#define BASELINE_MAX (16)
+#define NAME_MAX (32)
+
+static const char * filename = "perf_test_tmp.jls";
+
+struct baseline_s {
+    char name[NAME_MAX];
+    double value;
+};
+
+static struct baseline_s baselines_[BASELINE_MAX];
+static int baseline_count_ = 0;
+static int baseline_record_ = 0;    // baseline path given but file absent
+static FILE * baseline_file_ = NULL;
+
+static double tolerance_(void) {
+    const char * env = getenv("JLS_PERF_TOLERANCE");
+    if (env) {
+        double v = atof(env);
+        if ((v > 0.0) && (v <= 1.0)) {
+            return v;
+        }
+        printf("perf: invalid JLS_PERF_TOLERANCE %s, using %g\n",
+               env, PERF_TOLERANCE_DEFAULT);
+    }
+    return PERF_TOLERANCE_DEFAULT;
+}
+
+static int setup(void ** state) {
+    (void) state;
+    const char * path = getenv("JLS_PERF_BASELINE");
+    if (NULL == path) {
+        printf("perf: JLS_PERF_BASELINE not set, report only\n");
+        return 0;
+    }
+    FILE * f = fopen(path, "rt");
+    if (NULL == f) {
+        baseline_file_ = fopen(path, "wt");
+        if (NULL == baseline_file_) {
+            printf("perf: cannot create baseline %s\n", path);
+            return 1;
+        }
+        baseline_record_ = 1;
+        printf("perf: recording baseline to %s\n", path);
+        return 0;
+    }
+    char line[128];
+    while (fgets(line, sizeof(line), f) && (baseline_count_ < BASELINE_MAX)) {
+        struct baseline_s * b = &baselines_[baseline_count_];
+        if (('#' == line[0]) || ('\n' == line[0])) {
+            continue;
+        }
+        if (2 == sscanf(line, "%31s %lf", b->name, &b->value)) {
+            ++baseline_count_;
+        }
+    }
+    fclose(f);
+    printf("perf: comparing against %s, tolerance %g\n", path, tolerance_());
+    return 0;
+}
+
+static int teardown(void ** state) {
+    (void) state;
+    if (baseline_file_) {
+        fclose(baseline_file_);
+        baseline_file_ = NULL;
+    }
+    return 0;
+}
+
+// Report one measurement and enforce the baseline when present.
+static void perf_check(const char * name, double value, const char * units) {
+    printf("perf: %s = %.4g %s\n", name, value, units);
+    if (baseline_record_) {
+        fprintf(baseline_file_, "%s %.6g\n", name, value);
+        return;
+    }
+    for (int i = 0; i < baseline_count_; ++i) {
+        if (0 == strcmp(baselines_[i].name, name)) {
+            double floor = baselines_[i].value * tolerance_();
+            if (value < floor) {
+                printf("perf: %s REGRESSION: %.4g < %.4g (baseline %.4g)\n",
+                       name, value, floor, baselines_[i].value);
+            }
+            assert_true(value >= floor);
+            return;
+        }
+    }
+    if (baseline_count_) {
+        printf("perf: %s has no baseline entry, skipping check\n", name);
+    }
+}
+
+static void fill_pattern(uint8_t * data, size_t size) {
+    uint32_t x = 0x12345678;
+    for (size_t i = 0; i < size; ++i) {
+        x = x * 1664525 + 1013904223;    // numerical recipes LCG
+        data[i] = (uint8_t) (x >> 24);
+    }
+}
+
+static void test_crc32c(void ** state) {
+    (void) state;
+    static uint8_t buffer[BUFFER_SIZE];
+    fill_pattern(buffer, sizeof(buffer));
+    volatile uint32_t crc = 0;
+    int64_t t_start = jls_now();
+    int64_t t_end = t_start;
+    uint64_t bytes = 0;
+    while ((t_end - t_start) < PERF_WINDOW) {
+        crc += jls_crc32c(buffer, sizeof(buffer));
+        bytes += sizeof(buffer);
+        t_end = jls_now();
+    }
+    (void) crc;
+    double duration = JLS_TIME_TO_F64(t_end - t_start);
+    perf_check("crc32c", (double) bytes / duration / 1e6, "MB/s");
+}
+
+static void test_bit_shift(void ** state) {
+    (void) state;
+    static uint8_t buffer[BUFFER_SIZE];
+    fill_pattern(buffer, sizeof(buffer));
+    int64_t t_start = jls_now();
+    int64_t t_end = t_start;
+    uint64_t bytes = 0;
+    while ((t_end - t_start) < PERF_WINDOW) {
+        assert_int_equal(0, jls_bit_shift_array_right(4, buffer, sizeof(buffer)));
+        bytes += sizeof(buffer);
+        t_end = jls_now();
+    }
+    double duration = JLS_TIME_TO_F64(t_end - t_start);
+    perf_check("bit_shift_array", (double) bytes / duration / 1e6, "MB/s");
+}
+
+static void test_statistics_f32(void ** state) {
+    (void) state;
+    static float buffer[BUFFER_SIZE / sizeof(float)];
+    const uint64_t length = sizeof(buffer) / sizeof(buffer[0]);
+    for (uint64_t i = 0; i < length; ++i) {
+        buffer[i] = (float) (i & 0x3ff);
+    }
+    struct jls_statistics_s s;
+    volatile double mean = 0.0;
+    int64_t t_start = jls_now();
+    int64_t t_end = t_start;
+    uint64_t samples = 0;
+    while ((t_end - t_start) < PERF_WINDOW) {
+        jls_statistics_compute_f32(&s, buffer, length);
+        mean += s.mean;
+        samples += length;
+        t_end = jls_now();
+    }
+    (void) mean;
+    double duration = JLS_TIME_TO_F64(t_end - t_start);
+    perf_check("statistics_f32", (double) samples / duration / 1e6, "Msps");
+}
+
+// The FSR write path: summary1/summaryN reduction, compression,
+// and chunk emission, measured as sustained samples per second.
+static void test_wr_fsr_f32(void ** state) {
+    (void) state;
+    const struct jls_source_def_s source = {
+            .source_id = 3,
+            .name = "perf_test",
+            .vendor = "jls",
+            .model = "synthetic",
+            .version = "1",
+            .serial_number = "-",
+    };
+    const struct jls_signal_def_s signal = {
+            .signal_id = 5,
+            .source_id = 3,
+            .signal_type = JLS_SIGNAL_TYPE_FSR,
+            .data_type = JLS_DATATYPE_F32,
+            .sample_rate = 1000000,
+            .samples_per_data = 8192,
+            .sample_decimate_factor = 128,
+            .entries_per_summary = 640,
+            .summary_decimate_factor = 20,
+            .annotation_decimate_factor = 100,
+            .utc_decimate_factor = 100,
+            .name = "signal 5",
+            .units = "A",
+    };
+    static float buffer[BUFFER_SIZE / sizeof(float)];
+    const uint32_t length = sizeof(buffer) / sizeof(buffer[0]);
+    for (uint32_t i = 0; i < length; ++i) {
+        buffer[i] = (float) (i & 0x3ff);
+    }
+    struct jls_wr_s * wr = NULL;
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &source));
+    assert_int_equal(0, jls_wr_signal_def(wr, &signal));
+    int64_t sample_id = 0;
+    int64_t t_start = jls_now();
+    int64_t t_end = t_start;
+    while ((t_end - t_start) < PERF_WINDOW) {
+        assert_int_equal(0, jls_wr_fsr_f32(wr, 5, sample_id, buffer, length));
+        sample_id += length;
+        t_end = jls_now();
+    }
+    double duration = JLS_TIME_TO_F64(t_end - t_start);
+    assert_int_equal(0, jls_wr_close(wr));
+    remove(filename);
+    perf_check("wr_fsr_f32", (double) sample_id / duration / 1e6, "Msps");
+}
+
+static void test_raw_wr_mem(void ** state) {
+    (void) state;
+    static uint8_t payload[RAW_WR_PAYLOAD_SIZE];
+    fill_pattern(payload, sizeof(payload));
+    struct jls_mem_s * mem = NULL;
+    assert_int_equal(0, jls_mem_alloc(&mem));
+    int64_t t_start = jls_now();
+    int64_t t_end = t_start;
+    uint64_t bytes = 0;
+    while ((t_end - t_start) < PERF_WINDOW) {
+        // reopen "w" each pass to reuse the arena and bound its growth
+        struct jls_raw_s * raw = NULL;
+        assert_int_equal(0, jls_raw_open_mem(&raw, mem, "w"));
+        for (int i = 0; i < RAW_WR_CHUNKS_PER_PASS; ++i) {
+            struct jls_chunk_header_s hdr = {
+                    .item_next = 0,
+                    .item_prev = 0,
+                    .tag = JLS_TAG_USER_DATA,
+                    .compression = JLS_COMPRESSION_NONE,
+                    .chunk_meta = 0,
+                    .payload_length = sizeof(payload),
+                    .payload_prev_length = 0,
+                    .crc32 = 0,
+            };
+            assert_int_equal(0, jls_raw_wr(raw, &hdr, payload));
+        }
+        assert_int_equal(0, jls_raw_close(raw));
+        bytes += ((uint64_t) RAW_WR_CHUNKS_PER_PASS) * sizeof(payload);
+        t_end = jls_now();
+    }
+    jls_mem_free(mem);
+    double duration = JLS_TIME_TO_F64(t_end - t_start);
+    perf_check("raw_wr_mem", (double) bytes / duration / 1e6, "MB/s");
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(test_crc32c),
+            cmocka_unit_test(test_bit_shift),
+            cmocka_unit_test(test_statistics_f32),
+            cmocka_unit_test(test_wr_fsr_f32),
+            cmocka_unit_test(test_raw_wr_mem),
+    };
+    return cmocka_run_group_tests(tests, setup, teardown);
+}
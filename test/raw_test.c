@@ -70,7 +70,7 @@ static struct jls_chunk_header_s * hdr_set(struct jls_chunk_header_s * hdr, enum
     hdr->payload_prev_length = 0;
     hdr->item_next = 0;
     hdr->item_prev = 0;
-    hdr->rsv0_u8 = 0;
+    hdr->compression = JLS_COMPRESSION_NONE;
     return hdr;
 }
 
@@ -247,6 +247,71 @@ static void test_chunks_scan(void **state) {
     remove(filename);
 }
 
+struct chunk_walk_s {
+    int64_t offsets[64];
+    uint32_t payload_lengths[64];
+    size_t count;
+    size_t stop_after;  // 0 for no early stop
+};
+
+static int32_t chunk_walk_fn(void * user_data, int64_t offset,
+                             const struct jls_chunk_header_s * hdr) {
+    struct chunk_walk_s * w = (struct chunk_walk_s *) user_data;
+    assert_int_equal(JLS_TAG_USER_DATA, hdr->tag);
+    assert_true(w->count < 64);
+    w->offsets[w->count] = offset;
+    w->payload_lengths[w->count] = hdr->payload_length;
+    ++w->count;
+    if (w->stop_after && (w->count >= w->stop_after)) {
+        return 42;
+    }
+    return 0;
+}
+
+static void test_chunk_walk(void **state) {
+    (void) state;
+    struct jls_raw_s * j = NULL;
+    struct chunk_walk_s w;
+    construct_n_chunks();
+
+    assert_int_equal(0, jls_raw_open(&j, filename, "r"));
+
+    // expected offsets via the one-chunk-at-a-time navigation
+    int64_t offsets[sizeof(PAYLOAD1)];
+    for (size_t i = 0; i < sizeof(PAYLOAD1); ++i) {
+        offsets[i] = jls_raw_chunk_tell(j);
+        if ((i + 1) < sizeof(PAYLOAD1)) {
+            assert_int_equal(0, jls_raw_chunk_next(j));
+        }
+    }
+
+    memset(&w, 0, sizeof(w));
+    assert_int_equal(0, jls_raw_chunk_walk(j, 0, chunk_walk_fn, &w));
+    assert_int_equal(sizeof(PAYLOAD1), w.count);
+    for (size_t i = 0; i < sizeof(PAYLOAD1); ++i) {
+        assert_int_equal(offsets[i], w.offsets[i]);
+        assert_int_equal(sizeof(PAYLOAD1) - i, w.payload_lengths[i]);
+    }
+
+    // start offset and early stop through the callback return value
+    memset(&w, 0, sizeof(w));
+    w.stop_after = 2;
+    assert_int_equal(42, jls_raw_chunk_walk(j, offsets[1], chunk_walk_fn, &w));
+    assert_int_equal(2, w.count);
+    assert_int_equal(offsets[1], w.offsets[0]);
+    assert_int_equal(offsets[2], w.offsets[1]);
+
+    // the walk leaves the position unspecified: seek before reading
+    struct jls_chunk_header_s hdr;
+    uint8_t data[sizeof(PAYLOAD1) + 16];
+    assert_int_equal(0, jls_raw_chunk_seek(j, offsets[1]));
+    assert_int_equal(0, jls_raw_rd(j, &hdr, sizeof(data), data));
+    assert_memory_equal(PAYLOAD1 + 1, data, sizeof(PAYLOAD1) - 1);
+
+    assert_int_equal(0, jls_raw_close(j));
+    remove(filename);
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(test_invalid_open),
@@ -258,6 +323,7 @@ int main(void) {
             cmocka_unit_test(test_items_nav),
             cmocka_unit_test(test_tag_to_name),
             cmocka_unit_test(test_chunks_scan),
+            cmocka_unit_test(test_chunk_walk),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
@@ -30,6 +30,16 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+#include <io.h>
+#define file_read_only(p) _chmod((p), _S_IREAD)
+#define file_read_write(p) _chmod((p), _S_IREAD | _S_IWRITE)
+#else
+#define file_read_only(p) chmod((p), S_IRUSR | S_IRGRP | S_IROTH)
+#define file_read_write(p) chmod((p), S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH)
+#endif
 
 
 #define SKIP_BASIC 0
@@ -141,12 +151,17 @@ float * gen_triangle(uint32_t period_samples, int64_t length_samples) {
     return y;
 }
 
+static uint64_t gen_checkpoint_interval = 0;  // bytes, 0 to disable
+
 static float * gen_truncate(int64_t sample_count, size_t truncate, enum gen_close_e gen_close) {
     struct jls_wr_s * wr = NULL;
     float * signal = gen_triangle(1000, sample_count);
     assert_non_null(signal);
 
     assert_int_equal(0, jls_wr_open(&wr, filename));
+    if (gen_checkpoint_interval) {
+        assert_int_equal(0, jls_wr_checkpoint_interval(wr, gen_checkpoint_interval));
+    }
     assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_3));
     assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_5));
 
@@ -216,7 +231,9 @@ static void test_truncate_summary(void **state) {
 static void test_truncate_samples(void **state) {
     (void) state;
     int64_t sample_count = WINDOW_SIZE * 1000;
-    int64_t sample_count_truncated = 127920;
+    // layout dependent: truncation removes 3500000 bytes before END,
+    // including the trailing UTC time map, seek index, and data map chunks
+    int64_t sample_count_truncated = 136240;
     double signal_mean = 0.0;
 
     float * signal = gen_truncate(sample_count, 3500000, GEN_CLOSE);
@@ -262,6 +279,131 @@ static void test_truncate_samples_unclosed(void **state) {
 }
 
 
+static void test_truncate_samples_unclosed_read_only(void **state) {
+    // Same recovery as test_truncate_samples_unclosed, but with the
+    // file marked read-only: without write access, the open skips the
+    // in-place repair and reconstructs the reachable state in memory.
+    // Processes that can still write the file (e.g. root) repair in
+    // place instead; both paths must produce the same data.
+    (void) state;
+    int64_t sample_count = WINDOW_SIZE * 1000;
+    int64_t sample_count_truncated = 0xe4840;
+    double signal_mean = 0.0;
+
+    float * signal = gen_truncate(sample_count, 0, GEN_SKIP_CLOSE);
+    for (int64_t i = 0; i < sample_count_truncated; ++i) {
+        signal_mean += signal[i];
+    }
+    signal_mean = signal_mean / sample_count_truncated;
+    assert_int_equal(0, file_read_only(filename));
+
+    struct jls_rd_s * rd = NULL;
+    double data[4];
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count_truncated, samples);
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, sample_count_truncated, data, 1));
+    assert_float_equal(signal_mean, data[0], 1e-9);
+    jls_rd_close(rd);
+    assert_int_equal(0, file_read_write(filename));
+    remove(filename);
+}
+
+
+static void test_checkpoint_unclosed(void **state) {
+    // Same recovery as test_truncate_samples_unclosed, but the writer
+    // emitted periodic checkpoint chunks: repair loads the most recent
+    // checkpoint and replays only the chunks written after it.
+    (void) state;
+    int64_t sample_count = WINDOW_SIZE * 1000;
+    int64_t sample_count_truncated = 0xe4840;
+    double signal_mean = 0.0;
+
+    gen_checkpoint_interval = 512 * 1024;
+    float * signal = gen_truncate(sample_count, 0, GEN_SKIP_CLOSE);
+    gen_checkpoint_interval = 0;
+    for (int64_t i = 0; i < sample_count_truncated; ++i) {
+        signal_mean += signal[i];
+    }
+    signal_mean = signal_mean / sample_count_truncated;
+
+    struct jls_rd_s * rd = NULL;
+    double data[4];
+    assert_int_equal(0, jls_rd_open(&rd, filename));  // automatically repaired
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count_truncated, samples);
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 5, 0, sample_count_truncated, data, 1));
+    assert_float_equal(signal_mean, data[0], 1e-9);
+    jls_rd_close(rd);
+    remove(filename);
+}
+
+
+static int64_t file_size(void) {
+    FILE * f = fopen(filename, "rb");
+    assert_non_null(f);
+    assert_int_equal(0, fseek(f, 0, SEEK_END));
+    int64_t sz = ftell(f);
+    fclose(f);
+    return sz;
+}
+
+static void test_metadata_open_closed(void **state) {
+    (void) state;
+    int64_t sample_count = WINDOW_SIZE * 1000;
+    float * signal = gen_truncate(sample_count, 0, GEN_CLOSE);
+    free(signal);
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open_metadata(&rd, filename));
+    struct jls_signal_def_s * signals = NULL;
+    uint16_t count = 0;
+    assert_int_equal(0, jls_rd_signals(rd, &signals, &count));
+    assert_int_equal(2, count);
+    assert_int_equal(5, signals[1].signal_id);
+    assert_string_equal(SIGNAL_5.name, signals[1].name);
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+    jls_rd_close(rd);
+    remove(filename);
+}
+
+static void test_metadata_open_unclosed(void **state) {
+    // Unlike jls_rd_open(), the metadata open never modifies the file
+    // and never builds the follow indexes over the unrepaired tail, so
+    // an unclosed file reports only the reachable state.
+    (void) state;
+    int64_t sample_count = WINDOW_SIZE * 1000;
+    int64_t sample_count_truncated = 0xe4840;
+    float * signal = gen_truncate(sample_count, 0, GEN_SKIP_CLOSE);
+    free(signal);
+    int64_t size_before = file_size();
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open_metadata(&rd, filename));
+    struct jls_signal_def_s * signals = NULL;
+    uint16_t count = 0;
+    assert_int_equal(0, jls_rd_signals(rd, &signals, &count));
+    assert_int_equal(2, count);
+    assert_int_equal(5, signals[1].signal_id);
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_true(samples > 0);
+    assert_true(samples <= sample_count_truncated);
+    jls_rd_close(rd);
+    assert_int_equal(size_before, file_size());  // untouched
+
+    // a normal open afterwards still repairs and recovers the tail
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count_truncated, samples);
+    jls_rd_close(rd);
+    remove(filename);
+}
+
 static void on_log_recv(const char * msg) {
     printf("%s", msg);
 }
@@ -272,6 +414,10 @@ int main(void) {
             cmocka_unit_test(test_truncate_summary),
             cmocka_unit_test(test_truncate_samples),
             cmocka_unit_test(test_truncate_samples_unclosed),
+            cmocka_unit_test(test_truncate_samples_unclosed_read_only),
+            cmocka_unit_test(test_checkpoint_unclosed),
+            cmocka_unit_test(test_metadata_open_closed),
+            cmocka_unit_test(test_metadata_open_unclosed),
     };
 
     jls_log_register(on_log_recv);
@@ -0,0 +1,185 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "jls/stat_cache.h"
+#include "jls/ec.h"
+#include "jls/format.h"
+#include "jls/reader.h"
+#include "jls/writer.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+static const char * jls_filename = "jls_stat_cache_test_tmp.jls";
+static const char * sidecar_filename = "jls_stat_cache_test_tmp.jls.stats";
+
+static const struct jls_source_def_s SOURCE_1 = {
+        .source_id = 1,
+        .name = "source 1",
+        .vendor = "vendor",
+        .model = "model",
+        .version = "version",
+        .serial_number = "serial_number",
+};
+
+static const struct jls_signal_def_s SIGNAL_1 = {
+        .signal_id = 1,
+        .source_id = 1,
+        .signal_type = JLS_SIGNAL_TYPE_FSR,
+        .data_type = JLS_DATATYPE_F32,
+        .sample_rate = 100000,
+        .samples_per_data = 1000,
+        .sample_decimate_factor = 100,
+        .entries_per_summary = 200,
+        .summary_decimate_factor = 100,
+        .annotation_decimate_factor = 100,
+        .utc_decimate_factor = 100,
+        .name = "current",
+        .units = "A",
+};
+
+#define SAMPLE_COUNT (100000)
+
+static void gen_jls(void) {
+    float * signal = malloc(sizeof(float) * SAMPLE_COUNT);
+    assert_non_null(signal);
+    for (int64_t i = 0; i < SAMPLE_COUNT; ++i) {
+        signal[i] = (float) (i % 1000) * 0.001f;
+    }
+    struct jls_wr_s * wr = NULL;
+    assert_int_equal(0, jls_wr_open(&wr, jls_filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_1));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_1));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 1, 0, signal, SAMPLE_COUNT));
+    assert_int_equal(0, jls_wr_close(wr));
+    free(signal);
+}
+
+static void fill(double * data, int64_t length, double seed) {
+    for (int64_t i = 0; i < length * JLS_SUMMARY_FSR_COUNT; ++i) {
+        data[i] = seed + i;
+    }
+}
+
+static void test_put_get_persist(void **state) {
+    (void) state;
+    gen_jls();
+    remove(sidecar_filename);
+    uint64_t file_id = 0;
+    assert_int_equal(0, jls_stat_cache_file_id(jls_filename, &file_id));
+    assert_int_not_equal(0, file_id);
+
+    struct jls_stat_cache_s * c = NULL;
+    assert_int_equal(0, jls_stat_cache_open(&c, sidecar_filename, file_id));
+    double wr_data[10 * JLS_SUMMARY_FSR_COUNT];
+    double rd_data[10 * JLS_SUMMARY_FSR_COUNT];
+    fill(wr_data, 10, 1.0);
+    assert_int_equal(JLS_ERROR_NOT_FOUND, jls_stat_cache_get(c, 1, 0, 100, rd_data, 10));
+    assert_int_equal(0, jls_stat_cache_put(c, 1, 0, 100, wr_data, 10));
+    assert_int_equal(0, jls_stat_cache_get(c, 1, 0, 100, rd_data, 10));
+    assert_memory_equal(wr_data, rd_data, sizeof(wr_data));
+    // key mismatches miss: signal, start, increment, length
+    assert_int_equal(JLS_ERROR_NOT_FOUND, jls_stat_cache_get(c, 2, 0, 100, rd_data, 10));
+    assert_int_equal(JLS_ERROR_NOT_FOUND, jls_stat_cache_get(c, 1, 1, 100, rd_data, 10));
+    assert_int_equal(JLS_ERROR_NOT_FOUND, jls_stat_cache_get(c, 1, 0, 101, rd_data, 10));
+    assert_int_equal(JLS_ERROR_NOT_FOUND, jls_stat_cache_get(c, 1, 0, 100, rd_data, 9));
+    jls_stat_cache_close(c);  // persists
+
+    // reload from the sidecar
+    c = NULL;
+    assert_int_equal(0, jls_stat_cache_open(&c, sidecar_filename, file_id));
+    memset(rd_data, 0, sizeof(rd_data));
+    assert_int_equal(0, jls_stat_cache_get(c, 1, 0, 100, rd_data, 10));
+    assert_memory_equal(wr_data, rd_data, sizeof(wr_data));
+    jls_stat_cache_close(c);
+
+    // a different file identity discards the sidecar contents
+    c = NULL;
+    assert_int_equal(0, jls_stat_cache_open(&c, sidecar_filename, file_id + 1));
+    assert_int_equal(JLS_ERROR_NOT_FOUND, jls_stat_cache_get(c, 1, 0, 100, rd_data, 10));
+    jls_stat_cache_close(c);
+
+    remove(jls_filename);
+    remove(sidecar_filename);
+}
+
+static void test_replace_and_limits(void **state) {
+    (void) state;
+    remove(sidecar_filename);
+    struct jls_stat_cache_s * c = NULL;
+    assert_int_equal(0, jls_stat_cache_open(&c, sidecar_filename, 42));
+    double wr_data[JLS_SUMMARY_FSR_COUNT];
+    double rd_data[JLS_SUMMARY_FSR_COUNT];
+    fill(wr_data, 1, 1.0);
+    assert_int_equal(0, jls_stat_cache_put(c, 1, 0, 100, wr_data, 1));
+    fill(wr_data, 1, 2.0);  // same key replaces
+    assert_int_equal(0, jls_stat_cache_put(c, 1, 0, 100, wr_data, 1));
+    assert_int_equal(0, jls_stat_cache_get(c, 1, 0, 100, rd_data, 1));
+    assert_memory_equal(wr_data, rd_data, sizeof(wr_data));
+
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID, jls_stat_cache_put(c, 1, 0, 100, wr_data, 0));
+    assert_int_equal(JLS_ERROR_PARAMETER_INVALID,
+                     jls_stat_cache_put(c, 1, 0, 100, wr_data, JLS_STAT_CACHE_ENTRY_LENGTH_MAX + 1));
+    jls_stat_cache_close(c);
+    remove(sidecar_filename);
+}
+
+static void test_reader_integration(void **state) {
+    (void) state;
+    gen_jls();
+    remove(sidecar_filename);
+
+    // first session computes from the file and persists on close
+    const int64_t incr = 30 * (int64_t) SIGNAL_1.sample_decimate_factor;
+    double stats1[30][JLS_SUMMARY_FSR_COUNT];
+    double stats2[30][JLS_SUMMARY_FSR_COUNT];
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, jls_filename));
+    assert_int_equal(0, jls_rd_stat_cache(rd, NULL));  // derives the sidecar path
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 1, 0, incr, stats1[0], 30));
+    jls_rd_close(rd);
+    FILE * f = fopen(sidecar_filename, "rb");
+    assert_non_null(f);
+    fclose(f);
+
+    // second session serves the identical query from the sidecar
+    rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, jls_filename));
+    assert_int_equal(0, jls_rd_stat_cache(rd, NULL));
+    assert_int_equal(0, jls_rd_fsr_statistics(rd, 1, 0, incr, stats2[0], 30));
+    assert_memory_equal(stats1, stats2, sizeof(stats1));
+    struct jls_rd_query_profile_s profile;
+    assert_int_equal(0, jls_rd_query_profile_get(rd, &profile));
+    assert_int_equal(0, profile.physical_bytes);  // hit: the JLS file was not touched
+    jls_rd_close(rd);
+
+    remove(jls_filename);
+    remove(sidecar_filename);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(test_put_get_persist),
+            cmocka_unit_test(test_replace_and_limits),
+            cmocka_unit_test(test_reader_integration),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -217,6 +217,137 @@ static void test_combine_in_place(void **state) {
     assert_stats_equal(ref, t2);
 }
 
+static void test_compute_f32_long(void **state) {
+    (void) state;
+    float data[1000];
+    struct jls_statistics_s s;
+    struct jls_statistics_s ref;
+    uint32_t r = 1;
+    for (size_t i = 0; i < 1000; ++i) {
+        r = r * 1103515245 + 12345;  // glibc LCG constants
+        data[i] = 1000.0f + (float) ((r >> 8) & 0xffff) / 65536.0f;  // large offset stresses conditioning
+    }
+    // lengths cover multiple blocks, partial blocks, SIMD remainders, and the scalar path
+    uint64_t lengths[] = {1, 3, 15, 63, 64, 67, 255, 256, 257, 1000};
+    for (size_t n = 0; n < sizeof(lengths) / sizeof(lengths[0]); ++n) {
+        uint64_t length = lengths[n];
+        jls_statistics_compute_f32(&s, data, length);
+        jls_statistics_reset(&ref);
+        for (uint64_t i = 0; i < length; ++i) {
+            jls_statistics_add(&ref, data[i]);
+        }
+        assert_int_equal(ref.k, s.k);
+        assert_float_equal(ref.mean, s.mean, 1e-9);
+        assert_float_equal(ref.min, s.min, 0.0);
+        assert_float_equal(ref.max, s.max, 0.0);
+        assert_float_equal(ref.s, s.s, 1e-6);
+    }
+}
+
+static void test_compute_f64_long(void **state) {
+    (void) state;
+    double data[1000];
+    struct jls_statistics_s s;
+    struct jls_statistics_s ref;
+    uint32_t r = 1;
+    for (size_t i = 0; i < 1000; ++i) {
+        r = r * 1103515245 + 12345;
+        data[i] = 1000.0 + (double) ((r >> 8) & 0xffff) / 65536.0;
+    }
+    uint64_t lengths[] = {1, 3, 15, 63, 64, 67, 255, 256, 257, 1000};
+    for (size_t n = 0; n < sizeof(lengths) / sizeof(lengths[0]); ++n) {
+        uint64_t length = lengths[n];
+        jls_statistics_compute_f64(&s, data, length);
+        jls_statistics_reset(&ref);
+        for (uint64_t i = 0; i < length; ++i) {
+            jls_statistics_add(&ref, data[i]);
+        }
+        assert_int_equal(ref.k, s.k);
+        assert_float_equal(ref.mean, s.mean, 1e-9);
+        assert_float_equal(ref.min, s.min, 0.0);
+        assert_float_equal(ref.max, s.max, 0.0);
+        assert_float_equal(ref.s, s.s, 1e-6);
+    }
+}
+
+static void entry_to_stats(struct jls_statistics_s * s, double mean, double std,
+                           double v_min, double v_max, uint64_t count) {
+    s->k = count;
+    s->mean = mean;
+    s->min = v_min;
+    s->max = v_max;
+    s->s = (count > 1) ? (std * std * (double) (count - 1)) : 0.0;
+}
+
+static void test_combine_summary(void **state) {
+    (void) state;
+    // entries layout per JLS_SUMMARY_FSR_e: mean, std, min, max
+    float f32[16][4];
+    double f64[16][4];
+    struct jls_statistics_s ref;
+    struct jls_statistics_s part;
+    struct jls_statistics_s t;
+    uint32_t r = 1;
+    for (size_t i = 0; i < 16; ++i) {
+        r = r * 1103515245 + 12345;
+        double mean = 1000.0 + (double) ((r >> 8) & 0xffff) / 65536.0;
+        double std = 0.5 + (double) ((r >> 4) & 0xff) / 256.0;
+        f64[i][0] = mean;
+        f64[i][1] = std;
+        f64[i][2] = mean - 2.0 * std;
+        f64[i][3] = mean + 2.0 * std;
+        for (size_t k = 0; k < 4; ++k) {
+            f32[i][k] = (float) f64[i][k];
+        }
+    }
+    uint64_t counts[] = {1, 2, 7, 16};
+    uint64_t samples_per_entry[] = {1, 2, 100};
+    for (size_t ci = 0; ci < sizeof(counts) / sizeof(counts[0]); ++ci) {
+        for (size_t ni = 0; ni < sizeof(samples_per_entry) / sizeof(samples_per_entry[0]); ++ni) {
+            uint64_t count = counts[ci];
+            uint64_t n = samples_per_entry[ni];
+
+            jls_statistics_reset(&ref);
+            for (uint64_t i = 0; i < count; ++i) {
+                entry_to_stats(&part, f64[i][0], f64[i][1], f64[i][2], f64[i][3], n);
+                jls_statistics_combine(&ref, &ref, &part);
+            }
+            jls_statistics_reset(&t);
+            jls_statistics_combine_summary_f64(&t, &f64[0][0], count, n);
+            assert_int_equal(ref.k, t.k);
+            assert_float_equal(ref.mean, t.mean, 1e-9);
+            assert_float_equal(ref.min, t.min, 0.0);
+            assert_float_equal(ref.max, t.max, 0.0);
+            assert_float_equal(ref.s, t.s, 1e-6 * (double) (ref.k + 1));
+
+            jls_statistics_reset(&ref);
+            for (uint64_t i = 0; i < count; ++i) {
+                entry_to_stats(&part, f32[i][0], f32[i][1], f32[i][2], f32[i][3], n);
+                jls_statistics_combine(&ref, &ref, &part);
+            }
+            jls_statistics_reset(&t);
+            jls_statistics_combine_summary_f32(&t, &f32[0][0], count, n);
+            assert_int_equal(ref.k, t.k);
+            assert_float_equal(ref.mean, t.mean, 1e-9);
+            assert_float_equal(ref.min, t.min, 0.0);
+            assert_float_equal(ref.max, t.max, 0.0);
+            assert_float_equal(ref.s, t.s, 1e-6 * (double) (ref.k + 1));
+        }
+    }
+
+    // non-empty accumulator and empty batch
+    jls_statistics_reset(&t);
+    jls_statistics_add(&t, 1.0);
+    jls_statistics_combine_summary_f32(&t, &f32[0][0], 0, 100);
+    assert_int_equal(1, t.k);
+    entry_to_stats(&part, f64[0][0], f64[0][1], f64[0][2], f64[0][3], 100);
+    jls_statistics_combine(&ref, &t, &part);
+    jls_statistics_combine_summary_f64(&t, &f64[0][0], 1, 100);
+    assert_int_equal(ref.k, t.k);
+    assert_float_equal(ref.mean, t.mean, 1e-9);
+    assert_float_equal(ref.s, t.s, 1e-6);
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(test_initialize),
@@ -230,6 +361,9 @@ int main(void) {
             cmocka_unit_test(test_combine_f32_in_two_parts),
             cmocka_unit_test(test_combine_f64_in_two_parts),
             cmocka_unit_test(test_combine_in_place),
+            cmocka_unit_test(test_combine_summary),
+            cmocka_unit_test(test_compute_f32_long),
+            cmocka_unit_test(test_compute_f64_long),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
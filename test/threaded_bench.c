@@ -0,0 +1,330 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file
+ *
+ * @brief Threaded writer throughput harness with a synthetic device model.
+ *
+ * Replays device timing traces (burst patterns and stall intervals)
+ * against jls_twr_s and reports sustained throughput, drop counts,
+ * and the message ring high-water mark.  Uniform-rate generation, as
+ * example/performance.c does, hides regressions that only manifest
+ * when the producer is bursty, so this harness drives the writer with
+ * the timing a real acquisition device produces.
+ */
+
+#include "jls/backend.h"
+#include "jls/ec.h"
+#include "jls/format.h"
+#include "jls/threaded_writer.h"
+#include "jls/time.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define ARRAY_SIZE(x) ( sizeof(x) / sizeof((x)[0]) )
+#define TMP_FILENAME "threaded_bench_tmp.jls"
+#define BURST_CHUNK_SAMPLES (65536)     // samples per jls_twr_fsr call for large bursts
+#define TRACE_SEGMENTS_MAX (256)
+
+
+static const char usage_str[] =
+"JLS threaded writer throughput harness with a synthetic device model.\n"
+"usage: threaded_bench [--<opt1> <value> ...]\n"
+"  --trace <name|path>   The timing trace to replay [bursty].\n"
+"                        Built-in traces: uniform, bursty, stall.\n"
+"                        A path loads a recorded trace: one CSV line\n"
+"                        'burst_samples,interval_us,count' per segment,\n"
+"                        replayed in a loop.  '#' starts a comment.\n"
+"  --duration <seconds>  The replay duration [10].\n"
+"  --rate <hz>           The signal sample rate [1000000].\n"
+"  --drop                Drop on ring overflow instead of blocking.\n"
+"  --overflow <bytes>    Spill to unbounded segments, see\n"
+"                        jls_twr_overflow_set().\n"
+"  --path <file>         The output JLS path [" TMP_FILENAME "].\n"
+"  --keep                Keep the output file.\n"
+"\n"
+"A burst of 0 samples is a pure stall: the producer sleeps for\n"
+"interval_us without writing.  The sample timeline advances with\n"
+"wall time regardless of drops, so dropped bursts leave gaps as a\n"
+"real device overrun would.\n"
+"\n"
+"Copyright 2026 Jetperch LLC, Apache 2.0 license\n"
+"\n";
+
+
+#define RPE(x)  do {                        \
+    int32_t rc__ = (x);                     \
+    if (rc__) {                             \
+        printf("error %d: " #x "\n", rc__); \
+        return rc__;                        \
+    }                                       \
+} while (0)
+
+static const struct jls_source_def_s SOURCE_3 = {
+        .source_id = 3,
+        .name = "threaded_bench",
+        .vendor = "jls",
+        .model = "synthetic",
+        .version = "1",
+        .serial_number = "-",
+};
+
+/// One segment of a device timing trace.
+struct trace_seg_s {
+    uint32_t burst_samples;     ///< The samples delivered per burst, 0 for a pure stall.
+    uint32_t interval_us;       ///< The time from one burst start to the next.
+    uint32_t count;             ///< The number of bursts in this segment.
+};
+
+// Steady delivery: the pattern example/performance.c generates.
+static const struct trace_seg_s TRACE_UNIFORM[] = {
+        {1000, 1000, 1000},
+};
+
+// USB-style bulk delivery: dense microbursts, then a quiet window
+// while the host services other endpoints.
+static const struct trace_seg_s TRACE_BURSTY[] = {
+        {8192, 250, 200},       // 32.8 Msps for 50 ms
+        {256, 1000, 300},       // trickle for 300 ms
+};
+
+// Device-side buffering: steady delivery, a 250 ms stall, then the
+// buffered backlog arrives in one burst at line rate.
+static const struct trace_seg_s TRACE_STALL[] = {
+        {1000, 1000, 400},
+        {0, 250000, 1},
+        {250000, 0, 1},
+};
+
+struct trace_s {
+    const char * name;
+    const struct trace_seg_s * segments;
+    uint32_t length;
+};
+
+static const struct trace_s TRACES[] = {
+        {"uniform", TRACE_UNIFORM, ARRAY_SIZE(TRACE_UNIFORM)},
+        {"bursty", TRACE_BURSTY, ARRAY_SIZE(TRACE_BURSTY)},
+        {"stall", TRACE_STALL, ARRAY_SIZE(TRACE_STALL)},
+};
+
+static int32_t trace_load(const char * path, struct trace_seg_s * segments, uint32_t * length) {
+    FILE * f = fopen(path, "rt");
+    if (NULL == f) {
+        printf("could not open trace %s\n", path);
+        return JLS_ERROR_IO;
+    }
+    char line[256];
+    uint32_t k = 0;
+    while (fgets(line, sizeof(line), f)) {
+        if (('#' == line[0]) || ('\n' == line[0]) || ('\r' == line[0])) {
+            continue;
+        }
+        if (k >= TRACE_SEGMENTS_MAX) {
+            printf("trace too long: %d segments max\n", TRACE_SEGMENTS_MAX);
+            fclose(f);
+            return JLS_ERROR_TOO_BIG;
+        }
+        if (3 != sscanf(line, "%" SCNu32 ",%" SCNu32 ",%" SCNu32,
+                        &segments[k].burst_samples, &segments[k].interval_us, &segments[k].count)) {
+            printf("invalid trace line: %s", line);
+            fclose(f);
+            return JLS_ERROR_PARAMETER_INVALID;
+        }
+        ++k;
+    }
+    fclose(f);
+    if (0 == k) {
+        printf("empty trace %s\n", path);
+        return JLS_ERROR_EMPTY;
+    }
+    *length = k;
+    return 0;
+}
+
+static void wait_until(int64_t t) {
+    while (1) {
+        int64_t remaining = t - jls_time_rel();
+        if (remaining <= 0) {
+            return;
+        }
+        if (remaining >= (2 * JLS_TIME_MILLISECOND)) {
+            jls_bkt_sleep_ms((uint32_t) ((remaining / JLS_TIME_MILLISECOND) - 1));
+        }
+        // spin out the final interval for sub-millisecond burst timing
+    }
+}
+
+static void latency_histogram_print(const char * name, const uint64_t * buckets) {
+    printf("  %s:", name);
+    for (int i = 0; i < JLS_TWR_LATENCY_BUCKET_COUNT; ++i) {
+        if (buckets[i]) {
+            printf(" %dus:%" PRIu64, (0 == i) ? 0 : (1 << (i - 1)), buckets[i]);
+        }
+    }
+    printf("\n");
+}
+
+int main(int argc, char * argv[]) {
+    const char * trace_name = "bursty";
+    const char * path = TMP_FILENAME;
+    struct trace_seg_s trace_file_segments[TRACE_SEGMENTS_MAX];
+    const struct trace_seg_s * segments = NULL;
+    uint32_t segments_length = 0;
+    int64_t duration_seconds = 10;
+    uint32_t sample_rate = 1000000;
+    uint64_t overflow_bytes = 0;
+    int drop = 0;
+    int keep = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if ((0 == strcmp(argv[i], "--trace")) && ((i + 1) < argc)) {
+            trace_name = argv[++i];
+        } else if ((0 == strcmp(argv[i], "--duration")) && ((i + 1) < argc)) {
+            duration_seconds = strtoll(argv[++i], NULL, 0);
+        } else if ((0 == strcmp(argv[i], "--rate")) && ((i + 1) < argc)) {
+            sample_rate = (uint32_t) strtoul(argv[++i], NULL, 0);
+        } else if ((0 == strcmp(argv[i], "--overflow")) && ((i + 1) < argc)) {
+            overflow_bytes = strtoull(argv[++i], NULL, 0);
+        } else if ((0 == strcmp(argv[i], "--path")) && ((i + 1) < argc)) {
+            path = argv[++i];
+        } else if (0 == strcmp(argv[i], "--drop")) {
+            drop = 1;
+        } else if (0 == strcmp(argv[i], "--keep")) {
+            keep = 1;
+        } else {
+            printf("%s", usage_str);
+            return 1;
+        }
+    }
+
+    for (size_t i = 0; i < ARRAY_SIZE(TRACES); ++i) {
+        if (0 == strcmp(TRACES[i].name, trace_name)) {
+            segments = TRACES[i].segments;
+            segments_length = TRACES[i].length;
+            break;
+        }
+    }
+    if (NULL == segments) {
+        RPE(trace_load(trace_name, trace_file_segments, &segments_length));
+        segments = trace_file_segments;
+    }
+
+    uint32_t burst_samples_max = BURST_CHUNK_SAMPLES;
+    for (uint32_t i = 0; i < segments_length; ++i) {
+        if (segments[i].burst_samples > burst_samples_max) {
+            burst_samples_max = segments[i].burst_samples;
+        }
+    }
+    float * data = malloc(sizeof(float) * burst_samples_max);
+    if (NULL == data) {
+        printf("could not allocate burst data\n");
+        return 1;
+    }
+    for (uint32_t i = 0; i < burst_samples_max; ++i) {
+        data[i] = (float) (i & 0x3ff);
+    }
+
+    struct jls_signal_def_s signal_def = {
+            .signal_id = 5,
+            .source_id = 3,
+            .signal_type = JLS_SIGNAL_TYPE_FSR,
+            .data_type = JLS_DATATYPE_F32,
+            .sample_rate = sample_rate,
+            .samples_per_data = JLS_SIGNAL_DEF_AUTO,
+            .name = "current",
+            .units = "A",
+    };
+
+    struct jls_twr_s * wr = NULL;
+    RPE(jls_twr_open(&wr, path));
+    if (drop) {
+        RPE(jls_twr_flags_set(wr, JLS_TWR_FLAG_DROP_ON_OVERFLOW));
+    }
+    if (overflow_bytes) {
+        RPE(jls_twr_overflow_set(wr, overflow_bytes));
+    }
+    RPE(jls_twr_source_def(wr, &SOURCE_3));
+    RPE(jls_twr_signal_def(wr, &signal_def));
+
+    printf("replay trace=%s rate=%" PRIu32 " duration=%" PRIi64 "s drop=%d\n",
+           trace_name, sample_rate, duration_seconds, drop);
+    int64_t sample_id = 0;
+    uint64_t samples_generated = 0;
+    uint64_t samples_dropped = 0;
+    uint64_t bursts_dropped = 0;
+    int64_t t_start = jls_time_rel();
+    int64_t t_end = t_start + duration_seconds * JLS_TIME_SECOND;
+    int64_t t_next = t_start;
+    while (jls_time_rel() < t_end) {
+        for (uint32_t s = 0; (s < segments_length) && (jls_time_rel() < t_end); ++s) {
+            const struct trace_seg_s * seg = &segments[s];
+            for (uint32_t b = 0; (b < seg->count) && (jls_time_rel() < t_end); ++b) {
+                wait_until(t_next);
+                t_next += seg->interval_us * JLS_TIME_MICROSECOND;
+                uint32_t remaining = seg->burst_samples;
+                int dropped = 0;
+                while (remaining) {
+                    uint32_t n = (remaining > BURST_CHUNK_SAMPLES) ? BURST_CHUNK_SAMPLES : remaining;
+                    if (jls_twr_fsr_f32(wr, signal_def.signal_id, sample_id, data, n)) {
+                        samples_dropped += n;
+                        dropped = 1;
+                    }
+                    // the device timeline advances even when the write drops
+                    sample_id += n;
+                    samples_generated += n;
+                    remaining -= n;
+                }
+                bursts_dropped += dropped;
+            }
+        }
+    }
+    double replay_seconds = JLS_TIME_TO_F64(jls_time_rel() - t_start);
+
+    struct jls_twr_counters_s counters;
+    struct jls_twr_latency_s latency;
+    RPE(jls_twr_counters(wr, &counters));
+    RPE(jls_twr_latency_get(wr, &latency));
+    int64_t t_close_start = jls_time_rel();
+    RPE(jls_twr_close(wr));
+    double close_seconds = JLS_TIME_TO_F64(jls_time_rel() - t_close_start);
+
+    printf("replay %.3f s, close %.3f s\n", replay_seconds, close_seconds);
+    printf("  samples: %" PRIu64 " generated, %" PRIu64 " dropped in %" PRIu64 " bursts\n",
+           samples_generated, samples_dropped, bursts_dropped);
+    printf("  throughput: %.3f Msps sustained, %.3f MB/s to disk\n",
+           samples_generated * 1e-6 / replay_seconds,
+           counters.bytes_written * 1e-6 / replay_seconds);
+    printf("  file: %" PRIu64 " bytes, %" PRIu64 " chunks, %" PRIu64 " seeks\n",
+           counters.bytes_written, counters.chunks, counters.seeks);
+    printf("  ring high-water: %" PRIu64 " bytes\n", counters.msg_bytes_max);
+    printf("  write %.3f s, flush %.3f s\n",
+           latency.write_duration_us * 1e-6, latency.flush_duration_us * 1e-6);
+    latency_histogram_print("enqueue", latency.enqueue);
+    latency_histogram_print("dwell", latency.dwell);
+    latency_histogram_print("service", latency.service);
+
+    free(data);
+    if (!keep) {
+        remove(path);
+    }
+    return 0;
+}
@@ -88,6 +88,7 @@ static void test_data(void **state) {
     assert_non_null(signal);
 
     assert_int_equal(0, jls_twr_open(&wr, filename));
+    assert_int_equal(0, jls_twr_overflow_set(wr, 16 * 1024 * 1024));
     assert_int_equal(0, jls_twr_source_def(wr, &SOURCE_3));
     assert_int_equal(0, jls_twr_signal_def(wr, &SIGNAL_5));
 
@@ -95,6 +96,27 @@ static void test_data(void **state) {
         assert_int_equal(0, jls_twr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
     }
 
+    struct jls_twr_counters_s counters;
+    assert_int_equal(0, jls_twr_flush(wr));
+    assert_int_equal(0, jls_twr_counters(wr, &counters));
+    assert_true(counters.bytes_written > 0);
+    assert_true(counters.chunks > 0);
+    assert_true(counters.msg_bytes_max > 0);
+
+    struct jls_twr_latency_s latency;
+    assert_int_equal(0, jls_twr_latency_get(wr, &latency));
+    uint64_t service_total = 0;
+    uint64_t enqueue_total = 0;
+    uint64_t dwell_total = 0;
+    for (uint32_t idx = 0; idx < JLS_TWR_LATENCY_BUCKET_COUNT; ++idx) {
+        service_total += latency.service[idx];
+        enqueue_total += latency.enqueue[idx];
+        dwell_total += latency.dwell[idx];
+    }
+    assert_true(service_total > 0);
+    assert_true(enqueue_total > 0);
+    assert_true(dwell_total > 0);
+    assert_true(latency.write_duration_us > 0);
     assert_int_equal(0, jls_twr_close(wr));
 
     struct jls_rd_s * rd = NULL;
@@ -127,9 +149,378 @@ static void test_data(void **state) {
     remove(filename);
 }
 
+static void test_data_tiny_appends(void **state) {
+    // 10-sample producer blocks: the writer thread coalesces the queued
+    // appends into single dispatches, results identical to large blocks
+    (void) state;
+    struct jls_twr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 10;
+    const int64_t block_size = 10;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_twr_open(&wr, filename));
+    assert_int_equal(0, jls_twr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_twr_signal_def(wr, &SIGNAL_5));
+    for (int64_t sample_id = 0; sample_id < sample_count; sample_id += block_size) {
+        int64_t n = sample_count - sample_id;
+        if (n > block_size) {
+            n = block_size;
+        }
+        assert_int_equal(0, jls_twr_fsr_f32(wr, 5, sample_id, signal + sample_id, (uint32_t) n));
+    }
+    assert_int_equal(0, jls_twr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+    float * data = malloc(sample_count * sizeof(float));
+    assert_non_null(data);
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, sample_count));
+    assert_memory_equal(signal, data, sample_count * sizeof(float));
+    jls_rd_close(rd);
+    free(data);
+    free(signal);
+    remove(filename);
+}
+
+static void test_data_suspend(void **state) {
+    (void) state;
+    struct jls_twr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_twr_open(&wr, filename));
+    assert_int_equal(0, jls_twr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_twr_signal_def(wr, &SIGNAL_5));
+
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_twr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+        if (sample_id == WINDOW_SIZE * 25) {
+            assert_int_equal(0, jls_twr_signal_suspend(wr, 5));
+            assert_int_equal(0, jls_twr_signal_resume(wr, 5));
+        } else if (sample_id == WINDOW_SIZE * 50) {
+            assert_int_equal(0, jls_twr_signal_suspend(wr, 5));  // resumed by the next samples
+        }
+    }
+    assert_int_equal(0, jls_twr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+    float * data = malloc(sizeof(float) * (size_t) sample_count);
+    assert_non_null(data);
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, sample_count));
+    assert_memory_equal(signal, data, sample_count * sizeof(float));
+    free(data);
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_data_durability(void **state) {
+    (void) state;
+    struct jls_twr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_twr_open(&wr, filename));
+    assert_int_equal(0, jls_twr_durability_set(wr, 256 * 1024, 10));
+    assert_int_equal(0, jls_twr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_twr_signal_def(wr, &SIGNAL_5));
+
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_twr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_twr_flush(wr));  // checkpoint barrier
+    assert_int_equal(0, jls_twr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+
+    float data[1000];
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, 1000));
+    assert_memory_equal(signal, data, 1000 * sizeof(float));
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_data_finalize(void **state) {
+    (void) state;
+    struct jls_twr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_twr_open(&wr, filename));
+    assert_int_equal(0, jls_twr_finalize_set(wr, 1));
+    assert_int_equal(0, jls_twr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_twr_signal_def(wr, &SIGNAL_5));
+
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_twr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_twr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+
+    float data[1000];
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, 1000));
+    assert_memory_equal(signal, data, 1000 * sizeof(float));
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_data_sched(void **state) {
+    (void) state;
+    const char * filename2 = "threaded_test_tmp2.jls";
+    struct jls_twr_sched_s * sched = NULL;
+    struct jls_twr_s * wr1 = NULL;
+    struct jls_twr_s * wr2 = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_twr_sched_open(&sched));
+    assert_int_equal(0, jls_twr_open(&wr1, filename));
+    assert_int_equal(0, jls_twr_open(&wr2, filename2));
+    assert_int_equal(0, jls_twr_sched_join(wr1, sched));
+    assert_int_equal(0, jls_twr_sched_join(wr2, sched));
+    assert_int_equal(0, jls_twr_source_def(wr1, &SOURCE_3));
+    assert_int_equal(0, jls_twr_signal_def(wr1, &SIGNAL_5));
+    assert_int_equal(0, jls_twr_source_def(wr2, &SOURCE_3));
+    assert_int_equal(0, jls_twr_signal_def(wr2, &SIGNAL_5));
+
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        assert_int_equal(0, jls_twr_fsr_f32(wr1, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+        assert_int_equal(0, jls_twr_fsr_f32(wr2, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_twr_flush(wr1));
+    assert_int_equal(0, jls_twr_flush(wr2));
+    assert_int_equal(0, jls_twr_close(wr1));
+    assert_int_equal(0, jls_twr_close(wr2));
+    assert_int_equal(0, jls_twr_sched_close(sched));
+
+    const char * filenames[] = {filename, filename2};
+    for (int idx = 0; idx < 2; ++idx) {
+        struct jls_rd_s * rd = NULL;
+        assert_int_equal(0, jls_rd_open(&rd, filenames[idx]));
+        int64_t samples = 0;
+        assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+        assert_int_equal(sample_count, samples);
+        float data[1000];
+        assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, 1000));
+        assert_memory_equal(signal, data, 1000 * sizeof(float));
+        jls_rd_close(rd);
+    }
+    free(signal);
+    remove(filename);
+    remove(filename2);
+}
+
+static void test_data_reserve_commit(void **state) {
+    (void) state;
+    struct jls_twr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_twr_open(&wr, filename));
+    assert_int_equal(0, jls_twr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_twr_signal_def(wr, &SIGNAL_5));
+
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        void * buffer = NULL;
+        int32_t rc = jls_twr_fsr_reserve(wr, 5, WINDOW_SIZE, &buffer);
+        while (JLS_ERROR_BUSY == rc) {
+            rc = jls_twr_fsr_reserve(wr, 5, WINDOW_SIZE, &buffer);
+        }
+        assert_int_equal(0, rc);
+        assert_non_null(buffer);
+        memcpy(buffer, signal + sample_id, WINDOW_SIZE * sizeof(float));
+        assert_int_equal(0, jls_twr_fsr_commit(wr, 5, sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(JLS_ERROR_SEQUENCE, jls_twr_fsr_commit(wr, 5, 0, WINDOW_SIZE));
+    assert_int_equal(0, jls_twr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count, samples);
+
+    float data[1000];
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, 1000));
+    assert_memory_equal(signal, data, 1000 * sizeof(float));
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, sample_count - 1000, data, 1000));
+    assert_memory_equal(signal + sample_count - 1000, data, 1000 * sizeof(float));
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_data_multi(void **state) {
+    (void) state;
+    struct jls_twr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+    struct jls_signal_def_s signal_6 = SIGNAL_5;
+    signal_6.signal_id = 6;
+    signal_6.name = "signal 6";
+
+    assert_int_equal(0, jls_twr_open(&wr, filename));
+    assert_int_equal(0, jls_twr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_twr_signal_def(wr, &SIGNAL_5));
+    assert_int_equal(0, jls_twr_signal_def(wr, &signal_6));
+
+    // one batch per "hardware frame", both signals per batch
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        struct jls_twr_fsr_block_s blocks[] = {
+                {.signal_id = 5, .sample_id = sample_id,
+                 .data = signal + sample_id, .data_length = WINDOW_SIZE},
+                {.signal_id = 6, .sample_id = sample_id,
+                 .data = signal + sample_id, .data_length = WINDOW_SIZE},
+        };
+        assert_int_equal(0, jls_twr_fsr_multi(wr, blocks, 2));
+    }
+    assert_int_equal(0, jls_twr_fsr_multi(wr, NULL, 0));  // empty batch ok
+    assert_int_equal(0, jls_twr_close(wr));
+
+    struct jls_rd_s * rd = NULL;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    float data[1000];
+    for (uint16_t signal_id = 5; signal_id <= 6; ++signal_id) {
+        int64_t samples = 0;
+        assert_int_equal(0, jls_rd_fsr_length(rd, signal_id, &samples));
+        assert_int_equal(sample_count, samples);
+        assert_int_equal(0, jls_rd_fsr_f32(rd, signal_id, 0, data, 1000));
+        assert_memory_equal(signal, data, 1000 * sizeof(float));
+        assert_int_equal(0, jls_rd_fsr_f32(rd, signal_id, sample_count - 1000, data, 1000));
+        assert_memory_equal(signal + sample_count - 1000, data, 1000 * sizeof(float));
+    }
+
+    jls_rd_close(rd);
+    free(signal);
+    remove(filename);
+}
+
+static void test_data_rollover(void **state) {
+    (void) state;
+    const char * filename2 = "threaded_test_tmp2.jls";
+    struct jls_twr_s * wr = NULL;
+    const int64_t sample_count = WINDOW_SIZE * 100;
+    const int64_t half = WINDOW_SIZE * 50;
+    float * signal = gen_triangle(1000, sample_count);
+    assert_non_null(signal);
+
+    assert_int_equal(0, jls_twr_open(&wr, filename));
+    assert_int_equal(0, jls_twr_source_def(wr, &SOURCE_3));
+    assert_int_equal(0, jls_twr_signal_def(wr, &SIGNAL_5));
+
+    // producers keep streaming across the segment handoff
+    for (int sample_id = 0; sample_id < sample_count; sample_id += WINDOW_SIZE) {
+        if (sample_id == half) {
+            assert_int_equal(0, jls_twr_rollover(wr, filename2));
+        }
+        assert_int_equal(0, jls_twr_fsr_f32(wr, 5, sample_id, signal + sample_id, WINDOW_SIZE));
+    }
+    assert_int_equal(0, jls_twr_close(wr));
+
+    // first segment: samples [0, half)
+    struct jls_rd_s * rd = NULL;
+    float data[1000];
+    int64_t samples = 0;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(half, samples);
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, 1000));
+    assert_memory_equal(signal, data, 1000 * sizeof(float));
+    jls_rd_close(rd);
+
+    // second segment: samples [half, sample_count), defs carried over
+    assert_int_equal(0, jls_rd_open(&rd, filename2));
+    struct jls_signal_def_s signal_def;
+    assert_int_equal(0, jls_rd_signal(rd, 5, &signal_def));
+    assert_string_equal(SIGNAL_5.name, signal_def.name);
+    assert_int_equal(half, signal_def.sample_id_offset);
+    assert_int_equal(0, jls_rd_fsr_length(rd, 5, &samples));
+    assert_int_equal(sample_count - half, samples);
+    assert_int_equal(0, jls_rd_fsr_f32(rd, 5, 0, data, 1000));
+    assert_memory_equal(signal + half, data, 1000 * sizeof(float));
+    jls_rd_close(rd);
+
+    free(signal);
+    remove(filename);
+    remove(filename2);
+}
+
+static int32_t on_annotation_burst(void * user_data, const struct jls_annotation_s * annotation) {
+    int64_t * count = (int64_t *) user_data;
+    assert_int_equal(*count, annotation->timestamp);
+    assert_int_equal(JLS_ANNOTATION_TYPE_TEXT, annotation->annotation_type);
+    assert_int_equal(JLS_STORAGE_TYPE_STRING, annotation->storage_type);
+    assert_string_equal("anno", (const char *) annotation->data);
+    *count += 1;
+    return 0;
+}
+
+static void test_annotation_burst(void **state) {
+    (void) state;
+    struct jls_twr_s * wr = NULL;
+    struct jls_rd_s * rd = NULL;
+    const char * text = "anno";
+    const int64_t burst_count = 1000;
+
+    assert_int_equal(0, jls_twr_open(&wr, filename));
+    // the burst coalesces into shared annotation chunks in the writer thread
+    for (int64_t i = 0; i < burst_count; ++i) {
+        assert_int_equal(0, jls_twr_annotation(wr, 0, i, NAN,
+                                               JLS_ANNOTATION_TYPE_TEXT, 0, JLS_STORAGE_TYPE_STRING,
+                                               (const uint8_t *) text,
+                                               (uint32_t) strlen(text) + 1));
+    }
+    assert_int_equal(0, jls_twr_flush(wr));
+    assert_int_equal(0, jls_twr_close(wr));
+
+    int64_t count = 0;
+    assert_int_equal(0, jls_rd_open(&rd, filename));
+    assert_int_equal(0, jls_rd_annotations(rd, 0, 0, on_annotation_burst, &count));
+    assert_int_equal(burst_count, count);
+    jls_rd_close(rd);
+    remove(filename);
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(test_data),
+            cmocka_unit_test(test_data_tiny_appends),
+            cmocka_unit_test(test_data_suspend),
+            cmocka_unit_test(test_data_durability),
+            cmocka_unit_test(test_data_finalize),
+            cmocka_unit_test(test_data_sched),
+            cmocka_unit_test(test_data_reserve_commit),
+            cmocka_unit_test(test_data_multi),
+            cmocka_unit_test(test_data_rollover),
+            cmocka_unit_test(test_annotation_burst),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
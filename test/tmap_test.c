@@ -92,12 +92,58 @@ static void test_interpN(void **state) {
     assert_int_equal(0, jls_tmap_sample_id_to_timestamp(s, 4150, &v)); assert_int_equal(YEAR + 7 * SECOND / 2, v);  // below range
 }
 
+static void test_batch(void **state) {
+    (void) state;
+    int64_t v;
+    struct jls_tmap_s *s = jls_tmap_alloc(20.0);  // inaccurate
+    jls_tmap_add(s, 1000, YEAR);
+    jls_tmap_add(s, 2000, YEAR + SECOND);  // 1000 samples/second
+    jls_tmap_add(s, 4000, YEAR + 2 * SECOND);  // 2000 samples/second
+    jls_tmap_add(s, 4100, YEAR + 3 * SECOND);  // 100 samples/second
+
+    // ordered runs, out-of-order entry, both extrapolation ends
+    int64_t sample_ids[] = {500, 1000, 1500, 2000, 3000, 4000, 4050, 1750, 4100, 4150};
+    const size_t count = sizeof(sample_ids) / sizeof(sample_ids[0]);
+    int64_t timestamps[sizeof(sample_ids) / sizeof(sample_ids[0])];
+    assert_int_equal(0, jls_tmap_sample_id_to_timestamp_batch(s, sample_ids, timestamps, count));
+    for (size_t i = 0; i < count; ++i) {
+        assert_int_equal(0, jls_tmap_sample_id_to_timestamp(s, sample_ids[i], &v));
+        assert_int_equal(v, timestamps[i]);
+    }
+
+    int64_t sample_ids_rt[sizeof(sample_ids) / sizeof(sample_ids[0])];
+    assert_int_equal(0, jls_tmap_timestamp_to_sample_id_batch(s, timestamps, sample_ids_rt, count));
+    for (size_t i = 0; i < count; ++i) {
+        assert_int_equal(0, jls_tmap_timestamp_to_sample_id(s, timestamps[i], &v));
+        assert_int_equal(v, sample_ids_rt[i]);
+    }
+    jls_tmap_free(s);
+}
+
+static void test_batch_single_entry(void **state) {
+    (void) state;
+    int64_t v;
+    struct jls_tmap_s * s = jls_tmap_alloc(1000.0);
+    int64_t sample_ids[] = {1000, 2000};
+    int64_t timestamps[2];
+    assert_int_equal(JLS_ERROR_UNAVAILABLE, jls_tmap_sample_id_to_timestamp_batch(s, sample_ids, timestamps, 2));
+    jls_tmap_add(s, 1000, YEAR);
+    assert_int_equal(0, jls_tmap_sample_id_to_timestamp_batch(s, sample_ids, timestamps, 2));
+    for (size_t i = 0; i < 2; ++i) {
+        assert_int_equal(0, jls_tmap_sample_id_to_timestamp(s, sample_ids[i], &v));
+        assert_int_equal(v, timestamps[i]);
+    }
+    jls_tmap_free(s);
+}
+
 int main(void) {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(test_empty),
             cmocka_unit_test(test_single),
             cmocka_unit_test(test_interp2),
             cmocka_unit_test(test_interpN),
+            cmocka_unit_test(test_batch),
+            cmocka_unit_test(test_batch_single_entry),
     };
 
     return cmocka_run_group_tests(tests, NULL, NULL);
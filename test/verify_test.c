@@ -0,0 +1,232 @@
+/*
+ * Copyright 2023 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "jls/verify.h"
+#include "jls/crc32c.h"
+#include "jls/ec.h"
+#include "jls/format.h"
+#include "jls/raw.h"
+#include "jls/writer.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+
+static const char * filename = "jls_verify_test_tmp.jls";
+
+static const struct jls_source_def_s SOURCE_1 = {
+        .source_id = 1,
+        .name = "source 1",
+        .vendor = "vendor",
+        .model = "model",
+        .version = "version",
+        .serial_number = "serial_number",
+};
+
+static const struct jls_signal_def_s SIGNAL_1 = {
+        .signal_id = 1,
+        .source_id = 1,
+        .signal_type = JLS_SIGNAL_TYPE_FSR,
+        .data_type = JLS_DATATYPE_F32,
+        .sample_rate = 100000,
+        .samples_per_data = 1000,
+        .sample_decimate_factor = 100,
+        .entries_per_summary = 200,
+        .summary_decimate_factor = 100,
+        .annotation_decimate_factor = 100,
+        .utc_decimate_factor = 100,
+        .name = "current",
+        .units = "A",
+};
+
+#define SAMPLE_COUNT (100000)
+
+static void gen_file(void) {
+    float * signal = malloc(sizeof(float) * SAMPLE_COUNT);
+    assert_non_null(signal);
+    for (int64_t i = 0; i < SAMPLE_COUNT; ++i) {
+        signal[i] = (float) i;
+    }
+    struct jls_wr_s * wr = NULL;
+    assert_int_equal(0, jls_wr_open(&wr, filename));
+    assert_int_equal(0, jls_wr_source_def(wr, &SOURCE_1));
+    assert_int_equal(0, jls_wr_signal_def(wr, &SIGNAL_1));
+    assert_int_equal(0, jls_wr_fsr_f32(wr, 1, 0, signal, SAMPLE_COUNT));
+    assert_int_equal(0, jls_wr_close(wr));
+    free(signal);
+}
+
+// find the offset and header of the first TRACK_FSR_DATA chunk
+static void find_data_chunk(int64_t * offset, struct jls_chunk_header_s * hdr) {
+    struct jls_raw_s * raw = NULL;
+    assert_int_equal(0, jls_raw_open(&raw, filename, "r"));
+    while (1) {
+        assert_int_equal(0, jls_raw_rd_header(raw, hdr));
+        if (JLS_TAG_TRACK_FSR_DATA == hdr->tag) {
+            *offset = jls_raw_chunk_tell(raw);
+            break;
+        }
+        assert_int_equal(0, jls_raw_chunk_next(raw));
+    }
+    jls_raw_close(raw);
+}
+
+static void patch_file(int64_t offset, const void * data, size_t size) {
+    FILE * f = fopen(filename, "r+b");
+    assert_non_null(f);
+    assert_int_equal(0, fseek(f, (long) offset, SEEK_SET));
+    assert_int_equal(size, fwrite(data, 1, size, f));
+    fclose(f);
+}
+
+struct error_acc_s {
+    uint32_t count;
+    int32_t last_error;
+};
+
+static void on_error(void * user_data, int64_t offset, uint8_t tag, int32_t error) {
+    (void) offset;
+    (void) tag;
+    struct error_acc_s * acc = (struct error_acc_s *) user_data;
+    ++acc->count;
+    acc->last_error = error;
+}
+
+static void test_verify_ok(void **state) {
+    (void) state;
+    gen_file();
+    struct error_acc_s acc = {0, 0};
+    assert_int_equal(0, jls_verify(filename, 0, on_error, &acc));
+    assert_int_equal(0, acc.count);
+    assert_int_equal(0, jls_verify(filename, 1, NULL, NULL));  // single-threaded
+    remove(filename);
+}
+
+static void test_verify_corrupt_payload(void **state) {
+    (void) state;
+    gen_file();
+    int64_t offset = 0;
+    struct jls_chunk_header_s hdr;
+    find_data_chunk(&offset, &hdr);
+
+    uint8_t bad = 0x5A;
+    patch_file(offset + sizeof(hdr) + 4, &bad, sizeof(bad));
+
+    struct error_acc_s acc = {0, 0};
+    assert_int_equal(JLS_ERROR_MESSAGE_INTEGRITY, jls_verify(filename, 0, on_error, &acc));
+    assert_true(acc.count >= 1);
+    assert_int_equal(JLS_ERROR_MESSAGE_INTEGRITY, acc.last_error);
+    remove(filename);
+}
+
+static void test_verify_bad_link(void **state) {
+    (void) state;
+    gen_file();
+    int64_t offset = 0;
+    struct jls_chunk_header_s hdr;
+    find_data_chunk(&offset, &hdr);
+
+    // repoint item_next between chunk boundaries with a valid header CRC
+    hdr.item_next += 8;
+    hdr.crc32 = jls_crc32c_hdr(&hdr);
+    patch_file(offset, &hdr, sizeof(hdr));
+
+    struct error_acc_s acc = {0, 0};
+    assert_int_equal(JLS_ERROR_MESSAGE_INTEGRITY, jls_verify(filename, 0, on_error, &acc));
+    assert_true(acc.count >= 1);
+    assert_int_equal(JLS_ERROR_NOT_FOUND, acc.last_error);
+    remove(filename);
+}
+
+struct manifest_acc_s {
+    uint32_t count;
+    int64_t next_offset;      // expected offset of the next entry
+    int64_t data_offset;      // first TRACK_FSR_DATA chunk
+    uint32_t data_crc32c;
+    uint32_t data_payload_length;
+    uint32_t abort_after;
+};
+
+static int32_t on_manifest(void * user_data,
+                           const struct jls_manifest_entry_s * entries, uint32_t count) {
+    struct manifest_acc_s * acc = (struct manifest_acc_s *) user_data;
+    for (uint32_t i = 0; i < count; ++i) {
+        const struct jls_manifest_entry_s * e = &entries[i];
+        assert_int_equal(acc->next_offset, e->offset);
+        assert_true(e->length >= (int64_t) sizeof(struct jls_chunk_header_s));
+        acc->next_offset = e->offset + e->length;
+        if ((JLS_TAG_TRACK_FSR_DATA == e->tag) && (0 == acc->data_offset)) {
+            acc->data_offset = e->offset;
+            acc->data_crc32c = e->payload_crc32c;
+        }
+        ++acc->count;
+    }
+    return (acc->abort_after && (acc->count >= acc->abort_after)) ? 1 : 0;
+}
+
+static void test_manifest(void **state) {
+    (void) state;
+    gen_file();
+
+    // the entries tile the file from the first chunk to the end
+    struct manifest_acc_s acc = {
+            .count = 0,
+            .next_offset = sizeof(struct jls_file_header_s),
+            .data_offset = 0,
+            .data_crc32c = 0,
+            .abort_after = 0,
+    };
+    assert_int_equal(0, jls_manifest(filename, on_manifest, &acc));
+    assert_true(acc.count > 10);
+    assert_true(acc.data_offset > 0);
+    FILE * f = fopen(filename, "rb");
+    assert_non_null(f);
+    assert_int_equal(0, fseek(f, 0, SEEK_END));
+    assert_int_equal(acc.next_offset, ftell(f));
+
+    // the reported payload CRC matches the stored payload bytes
+    struct jls_chunk_header_s hdr;
+    assert_int_equal(0, fseek(f, (long) acc.data_offset, SEEK_SET));
+    assert_int_equal(1, fread(&hdr, sizeof(hdr), 1, f));
+    uint8_t * payload = malloc(hdr.payload_length);
+    assert_non_null(payload);
+    assert_int_equal(1, fread(payload, hdr.payload_length, 1, f));
+    assert_int_equal(acc.data_crc32c, jls_crc32c(payload, hdr.payload_length));
+    free(payload);
+    fclose(f);
+
+    // a nonzero callback return aborts the scan
+    acc.count = 0;
+    acc.next_offset = sizeof(struct jls_file_header_s);
+    acc.data_offset = 0;
+    acc.abort_after = 5;
+    assert_int_equal(JLS_ERROR_ABORTED, jls_manifest(filename, on_manifest, &acc));
+
+    remove(filename);
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(test_verify_ok),
+            cmocka_unit_test(test_verify_corrupt_payload),
+            cmocka_unit_test(test_verify_bad_link),
+            cmocka_unit_test(test_manifest),
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
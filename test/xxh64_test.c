@@ -0,0 +1,62 @@
+/*
+ * Copyright 2026 Jetperch LLC
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "jls/xxh64.h"
+#include <string.h>
+
+
+static void test_vectors(void **state) {
+    (void) state;
+    // reference values from the public xxHash implementation, seed 0
+    const uint8_t * s1 = (const uint8_t *) "a";
+    const uint8_t * s3 = (const uint8_t *) "abc";
+    const char * s39 = "Nobody inspects the spammish repetition";
+    assert_int_equal(0xef46db3751d8e999ULL, jls_xxh64((const uint8_t *) "", 0));
+    assert_int_equal(0xd24ec4f1a98c6e5bULL, jls_xxh64(s1, 1));
+    assert_int_equal(0x44bc2cf5ad770999ULL, jls_xxh64(s3, 3));
+    assert_int_equal(0xfbcea83c8a378bf1ULL, jls_xxh64((const uint8_t *) s39, strlen(s39)));
+}
+
+static void test_lengths(void **state) {
+    (void) state;
+    // every tail combination: stripe remainder, 8, 4, and byte loops
+    static uint8_t data[257];
+    uint32_t x = 0x12345678;
+    for (size_t i = 0; i < sizeof(data); ++i) {
+        x = x * 134775813U + 1U;
+        data[i] = (uint8_t) (x >> 24);
+    }
+    uint64_t prev = 0;
+    for (size_t length = 0; length <= sizeof(data); ++length) {
+        uint64_t h = jls_xxh64(data, length);
+        assert_true(h != prev);  // adjacent lengths must not collide
+        assert_int_equal(h, jls_xxh64(data, length));
+        prev = h;
+    }
+}
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+            cmocka_unit_test(test_vectors),
+            cmocka_unit_test(test_lengths),
+    };
+
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}